@@ -13,6 +13,12 @@ namespace Kmplete
             static constexpr auto JsonConfigurationTypeStr = "Type";
             static constexpr auto JsonConfigurationSubTypeMaskStr = "SubTypeMask";
             static constexpr auto JsonConfigurationNameStr = "Name";
+            static constexpr auto JsonConfigurationEncodingStr = "Encoding";
+            static constexpr auto JsonConfigurationFormatStr = "Format";
+            static constexpr auto JsonConfigurationCompressionStr = "Compression";
+            static constexpr auto JsonConfigurationLocalesStr = "Locales";
+            static constexpr auto JsonConfigurationPixelSizeStr = "PixelSize";
+            static constexpr auto JsonConfigurationPageSizeStr = "PageSize";
 
             static constexpr auto CompilerArgumentLogging = "logging";
             static constexpr auto CompilerArgumentLoggingShort = "L";
@@ -5,6 +5,10 @@
 #include "Kmplete/Base/macro.h"
 #include "Kmplete/Base/string_id.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
 
 namespace Kmplete
 {
@@ -15,17 +19,46 @@ namespace Kmplete
             Texture,
             Font,
             Sound,
+            FontAtlas,
             Error = 255
         };
         //--------------------------------------------------------------------------
 
         using AssetSubTypeMask = UInt32;
 
+        //! Compressed, NormalMap and SingleChannel bits are only used by AssetsCompiler to pick
+        //! the TexturePayloadFormat of a raw texture if it is not set explicitly
+        //! @see GetDefaultTexturePayloadFormat
         enum TextureSubTypeMaskBits : AssetSubTypeMask
         {
-            RGB =       0x0,
-            SRGB =      0x1,
-            NoMipmap =  0x2
+            RGB =           0x0,
+            SRGB =          0x1,
+            NoMipmap =      0x2,
+            Compressed =    0x4,
+            NormalMap =     0x8,
+            SingleChannel = 0x10
+        };
+        //--------------------------------------------------------------------------
+
+        //! Representation of an asset binary stored in .kmpdata file:
+        //! Source - the binary is a copy of the source file (png, ttf, etc.) and is decoded at runtime
+        //! Raw - the binary is an already processed payload ready to be handed to the consumer as is,
+        //! for textures it is the TexturePayloadHeader followed by all mip levels, font atlases are always
+        //! raw and laid out as described by FontAtlasPayloadHeader
+        enum class AssetEncoding : UByte
+        {
+            Source = 0,
+            Raw = 1
+        };
+        //--------------------------------------------------------------------------
+
+        //! Compression of an asset binary stored in .kmpdata file, applied on top of the AssetEncoding:
+        //! None - the binary is stored as is
+        //! LZ - the binary is compressed by Utils::CompressLZ, "uncompressedSize" of the header holds its original size
+        enum class AssetCompression : UByte
+        {
+            None = 0,
+            LZ = 1
         };
         //--------------------------------------------------------------------------
 
@@ -38,13 +71,17 @@ namespace Kmplete
 
         //! Exact representation of an asset metadata (or "header") stored in .kmpdata file
         //! These metadata stored contiguously and located in the beginning of the
-        //! .kmpdata file right after the asset count field
+        //! .kmpdata file right after the asset count field. "bufferSize" is the size of the stored
+        //! (possibly compressed) binary, "uncompressedSize" is the size of the binary after decompression
         KMP_BEGIN_PACKED_STRUCT(AssetEntryHeader)
         {
             UByte type;
+            UByte encoding;
+            UByte compression;
             AssetSubTypeMask subTypeMask;
             StringID sid;
             UInt64 bufferSize;
+            UInt64 uncompressedSize;
             UInt64 bufferOffset;
         };
         KMP_END_PACKED_STRUCT
@@ -52,19 +89,352 @@ namespace Kmplete
         using AssetCount = UInt32;
 
         static constexpr auto AssetEntryHeaderStructSize = sizeof(AssetEntryHeader);
-        static constexpr auto AssetEntryHeaderOffsetOfBufferSize = offsetof(AssetEntryHeader, bufferSize);
-        static constexpr auto AssetEntryHeaderOffsetOfBufferOffset = offsetof(AssetEntryHeader, bufferOffset);
+        //--------------------------------------------------------------------------
+
+
+        //! Exact representation of an entry of the SID index stored in .kmpdata file. The index holds one entry
+        //! per asset sorted by "sid" in ascending order, so an asset header is found by a binary search directly
+        //! in the file memory without building any lookup structures. "headerIndex" is the position of the
+        //! asset's AssetEntryHeader among the headers in the beginning of the file
+        KMP_BEGIN_PACKED_STRUCT(AssetIndexEntry)
+        {
+            StringID sid;
+            AssetCount headerIndex;
+        };
+        KMP_END_PACKED_STRUCT
+
+        //! Exact representation of the last bytes of .kmpdata file, points to the SID index which
+        //! is placed after all asset binaries and contains exactly "asset count" entries
+        KMP_BEGIN_PACKED_STRUCT(AssetIndexFooter)
+        {
+            UInt64 indexOffset;
+            UInt32 signature;
+        };
+        KMP_END_PACKED_STRUCT
+
+        static constexpr auto AssetIndexEntryStructSize = sizeof(AssetIndexEntry);
+        static constexpr auto AssetIndexFooterStructSize = sizeof(AssetIndexFooter);
+        static constexpr UInt32 AssetIndexFooterSignature = 0x49504D4B; // "KMPI"
+        //--------------------------------------------------------------------------
+
+
+        //! Pixel format of a raw texture payload, the color space (linear or sRGB) is defined by the
+        //! TextureSubTypeMaskBits of the asset (BC4 and BC5 are always linear). Block-compressed formats
+        //! store every mip level as rows of 4x4 blocks, partial blocks at the edges are padded
+        enum class TexturePayloadFormat : UByte
+        {
+            RGBA8 = 0,
+            R8 = 1,
+            RG8 = 2,
+            BC1 = 3,
+            BC3 = 4,
+            BC4 = 5,
+            BC5 = 6,
+            BC7 = 7,
+            Error = 255
+        };
+        //--------------------------------------------------------------------------
+
+        //! Exact representation of the header of a raw texture payload (AssetEncoding::Raw). The header is followed by
+        //! "mipLevels" tightly packed levels starting from the full resolution one, every level starts at the offset
+        //! aligned to TexturePayloadAlignment relative to the payload beginning, so the whole payload after the header
+        //! can be copied into a staging buffer with a single memcpy
+        KMP_BEGIN_PACKED_STRUCT(TexturePayloadHeader)
+        {
+            UByte format;
+            UByte mipLevels;
+            UInt16 reserved;
+            UInt32 width;
+            UInt32 height;
+        };
+        KMP_END_PACKED_STRUCT
+
+        static constexpr auto TexturePayloadHeaderStructSize = sizeof(TexturePayloadHeader);
+        static constexpr UInt64 TexturePayloadAlignment = 16;
+
+        KMP_NODISCARD constexpr UInt64 AlignTexturePayloadOffset(UInt64 offset) noexcept
+        {
+            return (offset + TexturePayloadAlignment - 1) & ~(TexturePayloadAlignment - 1);
+        }
+
+        //! Number of meaningful color channels of the format, 0 for unknown formats
+        KMP_NODISCARD constexpr UInt32 GetTexturePayloadChannelsCount(TexturePayloadFormat format) noexcept
+        {
+            switch (format)
+            {
+            case TexturePayloadFormat::RGBA8:
+            case TexturePayloadFormat::BC1:
+            case TexturePayloadFormat::BC3:
+            case TexturePayloadFormat::BC7:
+                return 4;
+            case TexturePayloadFormat::RG8:
+            case TexturePayloadFormat::BC5:
+                return 2;
+            case TexturePayloadFormat::R8:
+            case TexturePayloadFormat::BC4:
+                return 1;
+            default:
+                return 0;
+            }
+        }
+
+        KMP_NODISCARD constexpr bool IsTexturePayloadFormatCompressed(TexturePayloadFormat format) noexcept
+        {
+            return format >= TexturePayloadFormat::BC1 && format <= TexturePayloadFormat::BC7;
+        }
+
+        KMP_NODISCARD constexpr bool IsTexturePayloadFormatSRGBCompatible(TexturePayloadFormat format) noexcept
+        {
+            return format != TexturePayloadFormat::BC4 && format != TexturePayloadFormat::BC5;
+        }
+
+        //! Uncompressed format with the same channels as the given one, used when the device
+        //! does not support sampling of a block-compressed format
+        KMP_NODISCARD constexpr TexturePayloadFormat GetTexturePayloadUncompressedFormat(TexturePayloadFormat format) noexcept
+        {
+            switch (GetTexturePayloadChannelsCount(format))
+            {
+            case 4:
+                return TexturePayloadFormat::RGBA8;
+            case 2:
+                return TexturePayloadFormat::RG8;
+            case 1:
+                return TexturePayloadFormat::R8;
+            default:
+                return TexturePayloadFormat::Error;
+            }
+        }
+
+        KMP_NODISCARD constexpr TexturePayloadFormat GetDefaultTexturePayloadFormat(AssetSubTypeMask subTypeMask) noexcept
+        {
+            const auto compressed = (subTypeMask & TextureSubTypeMaskBits::Compressed) != 0;
+
+            if (subTypeMask & TextureSubTypeMaskBits::NormalMap)
+            {
+                return compressed ? TexturePayloadFormat::BC5 : TexturePayloadFormat::RG8;
+            }
+
+            if (subTypeMask & TextureSubTypeMaskBits::SingleChannel)
+            {
+                return compressed ? TexturePayloadFormat::BC4 : TexturePayloadFormat::R8;
+            }
+
+            return compressed ? TexturePayloadFormat::BC7 : TexturePayloadFormat::RGBA8;
+        }
+
+        //! Width and height of a single block in pixels (1 for uncompressed formats)
+        KMP_NODISCARD constexpr UInt32 GetTexturePayloadBlockExtent(TexturePayloadFormat format) noexcept
+        {
+            return IsTexturePayloadFormatCompressed(format) ? 4 : 1;
+        }
+
+        //! Size of a single block (or a single pixel for uncompressed formats) in bytes, 0 for unknown formats
+        KMP_NODISCARD constexpr UInt32 GetTexturePayloadBlockSize(TexturePayloadFormat format) noexcept
+        {
+            switch (format)
+            {
+            case TexturePayloadFormat::BC1:
+            case TexturePayloadFormat::BC4:
+                return 8;
+            case TexturePayloadFormat::BC3:
+            case TexturePayloadFormat::BC5:
+            case TexturePayloadFormat::BC7:
+                return 16;
+            default:
+                return GetTexturePayloadChannelsCount(format);
+            }
+        }
+
+        KMP_NODISCARD constexpr UInt32 GetTexturePayloadMaxMipLevels(UInt32 width, UInt32 height) noexcept
+        {
+            return static_cast<UInt32>(std::bit_width(std::max(std::max(width, height), 1U)));
+        }
+
+        KMP_NODISCARD constexpr UInt32 GetTexturePayloadMipDimension(UInt32 dimension, UInt32 mipLevel) noexcept
+        {
+            return std::max(dimension >> mipLevel, 1U);
+        }
+
+        KMP_NODISCARD constexpr UInt64 GetTexturePayloadMipLevelSize(TexturePayloadFormat format, UInt32 width, UInt32 height, UInt32 mipLevel) noexcept
+        {
+            const auto blockExtent = GetTexturePayloadBlockExtent(format);
+            const auto blocksX = (GetTexturePayloadMipDimension(width, mipLevel) + blockExtent - 1) / blockExtent;
+            const auto blocksY = (GetTexturePayloadMipDimension(height, mipLevel) + blockExtent - 1) / blockExtent;
+
+            return UInt64(blocksX) * blocksY * GetTexturePayloadBlockSize(format);
+        }
+
+        //! Offset of the given mip level relative to the payload beginning (i.e. including the payload header)
+        KMP_NODISCARD constexpr UInt64 GetTexturePayloadMipLevelOffset(TexturePayloadFormat format, UInt32 width, UInt32 height, UInt32 mipLevel) noexcept
+        {
+            auto offset = AlignTexturePayloadOffset(TexturePayloadHeaderStructSize);
+            for (UInt32 level = 0; level < mipLevel; level++)
+            {
+                offset = AlignTexturePayloadOffset(offset + GetTexturePayloadMipLevelSize(format, width, height, level));
+            }
+
+            return offset;
+        }
+
+        KMP_NODISCARD constexpr UInt64 GetTexturePayloadSize(TexturePayloadFormat format, UInt32 width, UInt32 height, UInt32 mipLevels) noexcept
+        {
+            if (mipLevels == 0)
+            {
+                return 0;
+            }
+
+            return GetTexturePayloadMipLevelOffset(format, width, height, mipLevels - 1) + GetTexturePayloadMipLevelSize(format, width, height, mipLevels - 1);
+        }
+
+        //! Reads the header of a raw texture payload and checks it against the payload size
+        //! @return false if the header is malformed or the payload is too small to hold all the mip levels
+        KMP_NODISCARD inline bool ReadTexturePayloadHeader(BinaryView payload, TexturePayloadHeader& header) noexcept
+        {
+            if (payload.size() < TexturePayloadHeaderStructSize)
+            {
+                return false;
+            }
+
+            std::memcpy(&header, payload.data(), TexturePayloadHeaderStructSize);
+
+            const auto format = static_cast<TexturePayloadFormat>(header.format);
+            if (GetTexturePayloadBlockSize(format) == 0 || header.width == 0 || header.height == 0 ||
+                header.mipLevels == 0 || header.mipLevels > GetTexturePayloadMaxMipLevels(header.width, header.height))
+            {
+                return false;
+            }
+
+            return payload.size() >= GetTexturePayloadSize(format, header.width, header.height, header.mipLevels);
+        }
+        //--------------------------------------------------------------------------
+
+
+        //! Exact representation of the header of a font atlas payload (AssetType::FontAtlas) baked by AssetsCompiler.
+        //! Glyphs of a single font are rasterized as signed distance fields of "pixelSize" and packed into "pagesCount"
+        //! square single-channel pages of "pageSize" texels. The header is followed by "glyphsCount" FontAtlasGlyphEntry
+        //! sorted by codepoint in ascending order, then by the pages starting at the offset aligned to TexturePayloadAlignment
+        KMP_BEGIN_PACKED_STRUCT(FontAtlasPayloadHeader)
+        {
+            UInt32 pageSize;
+            UInt32 pagesCount;
+            UInt32 glyphsCount;
+            UByte pixelSize;
+            UByte reserved1;
+            UInt16 reserved2;
+        };
+        KMP_END_PACKED_STRUCT
+
+        //! Exact representation of a glyph of a font atlas payload, "x", "y", "width" and "height" are the glyph
+        //! rectangle within its page in texels, bearing is in pixels and "advance" is in 26.6 fixed point.
+        //! Whitespaces have zero width and height and take no room in the pages
+        KMP_BEGIN_PACKED_STRUCT(FontAtlasGlyphEntry)
+        {
+            UInt32 codepoint;
+            UInt32 page;
+            UInt16 x;
+            UInt16 y;
+            UInt16 width;
+            UInt16 height;
+            Int16 bearingX;
+            Int16 bearingY;
+            UInt32 advance;
+        };
+        KMP_END_PACKED_STRUCT
+
+        static constexpr auto FontAtlasPayloadHeaderStructSize = sizeof(FontAtlasPayloadHeader);
+        static constexpr auto FontAtlasGlyphEntryStructSize = sizeof(FontAtlasGlyphEntry);
+        static constexpr UInt32 FontAtlasPayloadMaxPageSize = 4096;
+
+        KMP_NODISCARD constexpr UInt64 GetFontAtlasPayloadPageSize(UInt32 pageSize) noexcept
+        {
+            return UInt64(pageSize) * pageSize;
+        }
+
+        //! Offset of the given page relative to the payload beginning (i.e. including the payload header)
+        KMP_NODISCARD constexpr UInt64 GetFontAtlasPayloadPageOffset(UInt32 pageSize, UInt32 glyphsCount, UInt32 page) noexcept
+        {
+            const auto firstPageOffset = AlignTexturePayloadOffset(FontAtlasPayloadHeaderStructSize + UInt64(glyphsCount) * FontAtlasGlyphEntryStructSize);
+            return firstPageOffset + UInt64(page) * AlignTexturePayloadOffset(GetFontAtlasPayloadPageSize(pageSize));
+        }
+
+        KMP_NODISCARD constexpr UInt64 GetFontAtlasPayloadSize(UInt32 pageSize, UInt32 pagesCount, UInt32 glyphsCount) noexcept
+        {
+            return GetFontAtlasPayloadPageOffset(pageSize, glyphsCount, pagesCount);
+        }
+
+        //! Reads the header of a font atlas payload and checks it against the payload size
+        //! @return false if the header is malformed or the payload is too small to hold all the glyphs and pages
+        KMP_NODISCARD inline bool ReadFontAtlasPayloadHeader(BinaryView payload, FontAtlasPayloadHeader& header) noexcept
+        {
+            if (payload.size() < FontAtlasPayloadHeaderStructSize)
+            {
+                return false;
+            }
+
+            std::memcpy(&header, payload.data(), FontAtlasPayloadHeaderStructSize);
+
+            if (not std::has_single_bit(header.pageSize) || header.pageSize > FontAtlasPayloadMaxPageSize || header.pixelSize == 0)
+            {
+                return false;
+            }
+
+            return payload.size() >= GetFontAtlasPayloadSize(header.pageSize, header.pagesCount, header.glyphsCount);
+        }
+        //--------------------------------------------------------------------------
+
+
+        //! Inclusive range of Unicode codepoints
+        struct CodepointRange
+        {
+            UInt32 first;
+            UInt32 last;
+        };
+
+        //! Codepoints required by the locales supported by the engine, the tables are shared by Localization::UnicodeMap
+        //! and AssetsCompiler, which bakes font atlases of the locales listed in "Locales" of a FontAtlas asset
+        static constexpr Array<CodepointRange, 5> LocaleEnCodepointRanges = {{
+            { 0x0041, 0x005A },     // basic latin capital letters
+            { 0x0061, 0x007A },     // basic latin small letters
+            { 0x0020, 0x0040 },     // basic latin symbols
+            { 0x005B, 0x0060 },
+            { 0x007B, 0x007E }
+        }};
+
+        static constexpr Array<CodepointRange, 6> LocaleRuCodepointRanges = {{
+            { 0x0410, 0x044F },     // cyrillic letters
+            { 0x0401, 0x0401 },     // cyrillic capital Io
+            { 0x0451, 0x0451 },     // cyrillic small Io
+            { 0x0020, 0x0040 },     // basic latin symbols
+            { 0x005B, 0x0060 },
+            { 0x007B, 0x007E }
+        }};
+
+        //! @return codepoint ranges of the locale ("en_US.UTF-8" or "ru_RU.UTF-8"), empty span for unknown locales
+        KMP_NODISCARD inline Span<const CodepointRange> GetLocaleCodepointRanges(const String& locale) noexcept
+        {
+            if (locale == "en_US.UTF-8")
+            {
+                return Span<const CodepointRange>(LocaleEnCodepointRanges);
+            }
+
+            if (locale == "ru_RU.UTF-8")
+            {
+                return Span<const CodepointRange>(LocaleRuCodepointRanges);
+            }
+
+            return Span<const CodepointRange>();
+        }
         //--------------------------------------------------------------------------
 
 
         //! Helper struct to keep mapping between which asset is stored in which file.
         //! During assets loading multiple assets might be spread between
-        //! multiple files - sorting them by filepath gives an opportunity to check
+        //! multiple files - sorting them by the index of the registered file gives an opportunity to check
         //! every asset file only once as opposed to reopening same files back and forth
         //! @see Assets::AssetsManager
         struct AssetLookupInfo
         {
-            Filepath filepath;
+            UInt32 fileIndex;
             AssetEntryHeader header;
         };
         //--------------------------------------------------------------------------
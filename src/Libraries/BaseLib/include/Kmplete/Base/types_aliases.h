@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include <array>
+#include <span>
 #include <queue>
 #include <initializer_list>
 #include <utility>
@@ -39,6 +40,9 @@ namespace Kmplete
     template<typename Value>
     using PriorityQueue = std::priority_queue<Value>;
 
+    template<typename Value>
+    using Span = std::span<Value>;
+
     using String = std::string;
     using WString = std::wstring;
     using StringVector = Vector<String>;
@@ -59,6 +63,7 @@ namespace Kmplete
 
     using BinaryBuffer = Vector<UByte>;
     using BinaryBuffer32 = Vector<UInt32>;
+    using BinaryView = Span<const UByte>;
 
     template<typename Value>
     using InitializerList = std::initializer_list<Value>;
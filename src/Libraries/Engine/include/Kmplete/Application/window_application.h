@@ -36,7 +36,9 @@ namespace Kmplete
     //! than there exists the window named "Main".
     //! Client code may redefine behaviour when the application is about to close by reimplementing
     //! "ConfirmExit" function (e.g. some editor apps may show additional dialog window if
-    //! some data is not saved). This class is responsible for connecting low-level events (KeyPressed, WindowMoved etc.),
+    //! some data is not saved). Assets streamed by AssetsManager::LoadAssetsAsync are created once per frame
+    //! within the upload budget loaded from settings, cold textures are evicted according to the residency policy
+    //! from settings as well. This class is responsible for connecting low-level events (KeyPressed, WindowMoved etc.),
     //! provided by the underlying window, to the subsystems responsible of delegating or/and further processing these events.
     //! By default graphics API is set to Vulkan
     //! @see Application
@@ -83,6 +85,8 @@ namespace Kmplete
     private:
         Time::Clock _frameClock;
         UInt32 _iconifiedFPS;
+        Assets::AssetUploadBudget _assetUploadBudget;
+        Assets::AssetResidencyPolicy _assetResidencyPolicy;
         Graphics::GraphicsBackendType _graphicsBackendType;
         bool _resizing;
     };
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/string_id.h"
+#include "Kmplete/Base/nullability.h"
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        class AssetsManager;
+        class TextureAsset;
+
+
+        //! Conditions of evicting textures that have not been used recently, see AssetsManager::UpdateResidency.
+        //! Eviction starts once the GPU memory usage exceeds "memoryUsageFraction" of the budget reported by
+        //! the graphics backend, at most "maxEvictionsPerFrame" least recently used textures are evicted per frame.
+        //! Textures used within the last "minUnusedFrames" frames are never evicted (the value is raised to cover
+        //! all the frames that may still be in flight)
+        struct AssetResidencyPolicy
+        {
+            float memoryUsageFraction = 0.9f;
+            UInt32 minUnusedFrames = 120;
+            UInt32 maxEvictionsPerFrame = 16;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Reference-counted handle to an asset of AssetsManager, the asset is never evicted while
+        //! at least one handle to it exists. Acquiring a handle to an asset that is not resident schedules its
+        //! streaming. Handles must not outlive the manager and are supposed to be used on the thread that
+        //! updates the manager. An empty (default-constructed) handle refers to no asset
+        //! @see AssetsManager::AcquireAsset
+        class KMP_API AssetHandle
+        {
+        public:
+            AssetHandle() noexcept;
+            AssetHandle(const AssetHandle& other);
+            AssetHandle(AssetHandle&& other) noexcept;
+            ~AssetHandle();
+
+            AssetHandle& operator=(const AssetHandle& other);
+            AssetHandle& operator=(AssetHandle&& other) noexcept;
+
+            KMP_NODISCARD bool IsValid() const noexcept;
+            KMP_NODISCARD StringID GetStringID() const noexcept;
+            KMP_NODISCARD bool IsResident() const;
+
+            //! @return texture asset if it is resident, error texture while it is loading
+            KMP_NODISCARD const TextureAsset& GetTextureAsset() const;
+
+            void Reset() noexcept;
+
+        private:
+            friend class AssetsManager;
+
+            AssetHandle(AssetsManager& assetsManager, StringID sid);
+
+        private:
+            Nullable<AssetsManager*> _assetsManager;
+            StringID _sid;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <atomic>
+#include <future>
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        class AssetsManager;
+
+
+        //! Order in which asynchronously requested assets are decoded and uploaded,
+        //! assets of the same priority are processed in the order of request
+        //! @see AssetsManager::LoadAssetsAsync
+        enum class AssetLoadPriority : UByte
+        {
+            Low = 0,
+            Normal,
+            High,
+            Critical
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Limits of the work AssetsManager::ProcessUploads is allowed to do per call (normally once per frame),
+        //! "bytes" bounds the estimated size of GPU data recorded into the upload context, "milliseconds" bounds
+        //! the time spent creating assets. At least one asset is processed per call regardless of the budget
+        struct AssetUploadBudget
+        {
+            UInt64 bytes = 8ULL * 1024 * 1024;
+            float milliseconds = 2.0f;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Shared state of a single AssetsManager::LoadAssetsAsync call. Counters are updated by the manager on
+        //! the thread calling ProcessUploads, the future gets its value once every requested asset is either
+        //! resident or failed (true if all of them are resident). Waiting for the future on the thread that calls
+        //! ProcessUploads never returns, polling IsFinished is supposed to be used there instead
+        //! @see AssetsManager
+        class KMP_API AssetLoadRequest
+        {
+            KMP_DISABLE_COPY_MOVE(AssetLoadRequest)
+
+        public:
+            explicit AssetLoadRequest(UInt64 assetsCount);
+            ~AssetLoadRequest() = default;
+
+            KMP_NODISCARD UInt64 GetAssetsCount() const noexcept;
+            KMP_NODISCARD UInt64 GetLoadedCount() const noexcept;
+            KMP_NODISCARD UInt64 GetFailedCount() const noexcept;
+            KMP_NODISCARD bool IsFinished() const noexcept;
+
+            KMP_NODISCARD std::shared_future<bool> GetFuture() const;
+
+        private:
+            friend class AssetsManager;
+
+            void _FinishAsset(bool loaded);
+
+        private:
+            const UInt64 _assetsCount;
+            std::atomic<UInt64> _loadedCount;
+            std::atomic<UInt64> _failedCount;
+            std::promise<bool> _promise;
+            std::shared_future<bool> _future;
+        };
+        //--------------------------------------------------------------------------
+
+
+        using AssetLoadHandle = Ptr<AssetLoadRequest>;
+    }
+}
\ No newline at end of file
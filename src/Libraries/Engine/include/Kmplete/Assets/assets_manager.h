@@ -2,14 +2,22 @@
 
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/nullability.h"
 #include "Kmplete/Graphics/graphics_backend.h"
 #include "Kmplete/Localization/localization_base.h"
 #include "Kmplete/Assets/texture_asset_manager.h"
 #include "Kmplete/Assets/font_asset_manager.h"
 #include "Kmplete/Assets/assets_interface.h"
+#include "Kmplete/Assets/asset_load_request.h"
+#include "Kmplete/Assets/asset_handle.h"
+#include "Kmplete/Filesystem/mapped_file.h"
+#include "Kmplete/Core/thread_pool.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 #include "Kmplete/Log/log_class_macro.h"
 
+#include <mutex>
+
 
 namespace Kmplete
 {
@@ -17,7 +25,27 @@ namespace Kmplete
     {
         //! Manager for application assets. Responsible for managing lifetime of asset submanagers, handling
         //! assets loading and unloading, loading assets files. All asset files are supposed to be placed in
-        //! the Data directory relative to the application executable directory
+        //! the Data directory relative to the application executable directory. Asset files are memory mapped
+        //! once and kept mapped until the manager is destroyed, so (re)loading a single asset only touches
+        //! the pages of its own entry instead of re-reading the whole file. Registering a file only validates its
+        //! layout, assets are found by a binary search in the SID index of every registered file (in the order of
+        //! registration, so the first file containing a SID wins) without building any per-asset lookup structures.
+        //! The index order is checked around every binary search result, a file whose unsorted index is noticed
+        //! by a lookup is ignored from then on. Entries are decoded (images by stb_image,
+        //! fonts by FreeType) on a pool of worker threads in batches, the decoded batch is then turned into assets
+        //! on the calling thread, so the GPU textures get recorded into the upload context one batch at a time.
+        //! Raw texture payloads (AssetEncoding::Raw) skip the decoding entirely and are copied from the mapped file
+        //! straight into the staging memory, baked font atlases (AssetType::FontAtlas) are kept by FontAssetManager
+        //! as they are stored. Compressed entries (AssetCompression::LZ) are decompressed on the same
+        //! worker threads right before decoding.
+        //! Assets may also be streamed with LoadAssetsAsync: entries are decoded in the background in the order of
+        //! their priority and wait in memory until ProcessUploads (called once per frame by WindowApplication) turns
+        //! them into assets within the given upload budget. Until then GetTextureAssetOrPlaceholder returns the error
+        //! texture for pending textures, unloading a pending asset cancels its streaming.
+        //! Textures accessed through AssetHandle or GetTextureAssetOrPlaceholder take part in the residency tracking:
+        //! UpdateResidency (called once per frame by WindowApplication) evicts the least recently used of them that
+        //! have no handles when the GPU memory usage exceeds the policy limit, an evicted texture is streamed again
+        //! from its archive on the next use. Textures bound to long-living descriptor sets have to be held by handles
         //! @see assets_interface.h
         class KMP_API AssetsManager
         {
@@ -26,7 +54,8 @@ namespace Kmplete
             KMP_DISABLE_COPY_MOVE(AssetsManager)
 
         public:
-            AssetsManager(const Filepath& dataPath, Graphics::GraphicsBackend& graphicsBackend, const LocaleStr& currentLocale);
+            //! @param decodeThreadsCount number of asset decoding threads, 0 means "choose by hardware concurrency"
+            AssetsManager(const Filepath& dataPath, Graphics::GraphicsBackend& graphicsBackend, const LocaleStr& currentLocale, UInt32 decodeThreadsCount = 0);
             ~AssetsManager();
 
             KMP_NODISCARD const TextureAssetManager& GetTextureAssetManager() const noexcept;
@@ -40,24 +69,128 @@ namespace Kmplete
             KMP_NODISCARD bool LoadAssets(const Vector<StringID>& assetsSids);
             KMP_NODISCARD bool UnloadAssets(const Vector<StringID>& assetsSids);
 
+            //! Schedules assets for background decoding, sids that are not found count as failed, already resident
+            //! ones count as loaded right away. Requesting an asset that is already pending does not decode it twice
+            KMP_NODISCARD AssetLoadHandle LoadAssetsAsync(const Vector<StringID>& assetsSids, AssetLoadPriority priority = AssetLoadPriority::Normal);
+            //! Creates decoded pending assets in the order of priority until the budget is spent
+            //! @return number of processed pending assets (both created and failed)
+            UInt64 ProcessUploads(const AssetUploadBudget& budget);
+
+            KMP_NODISCARD bool IsAssetPending(StringID sid) const;
+            KMP_NODISCARD UInt64 GetPendingAssetsCount() const noexcept;
+            KMP_NODISCARD bool IsAssetResident(StringID sid) const;
+
+            //! @return texture asset if it is resident, error texture without warnings if it is still pending.
+            //! Marks the texture as used in the current frame, an evicted texture is scheduled for streaming again
+            KMP_NODISCARD const TextureAsset& GetTextureAssetOrPlaceholder(StringID sid);
+
+            //! @return handle keeping the asset from eviction, the asset is scheduled for streaming if it is not resident
+            KMP_NODISCARD AssetHandle AcquireAsset(StringID sid, AssetLoadPriority priority = AssetLoadPriority::Normal);
+
+            //! Advances the frame counter and evicts cold textures according to the policy
+            //! @return number of evicted textures
+            UInt64 UpdateResidency(const AssetResidencyPolicy& policy);
+
+        private:
+            //! Registered asset file, "headers" and "index" point into the mapped file, "indexRejected" is set
+            //! by the lookup that finds the index unsorted
+            struct AssetFile
+            {
+                Filepath filepath;
+                UPtr<Filesystem::MappedFile> mappedFile;
+                AssetCount assetCount;
+                BinaryView headers;
+                BinaryView index;
+                mutable bool indexRejected = false;
+            };
+
+            //! Asset entry scheduled for loading, "binary" points into the mapped asset file
+            struct AssetEntry
+            {
+                AssetEntryHeader header;
+                BinaryView binary;
+            };
+
+            //! Result of decoding an asset entry on a worker thread, only the member matching the entry type is set,
+            //! "binary" holds the decompressed data of a compressed entry if it is still needed to create the asset
+            struct DecodedAssetEntry
+            {
+                BinaryBuffer binary;
+                UPtr<Graphics::Image> image;
+                UPtr<FontAsset> font;
+            };
+
+            //! Asset entry of LoadAssetsAsync waiting for decoding or creation, "sequence" keeps the request order
+            //! within a priority, "decoded" is set once the entry has been decoded
+            struct StreamingEntry
+            {
+                AssetEntry entry;
+                AssetLoadPriority priority;
+                UInt64 sequence;
+                DecodedAssetEntry decoded;
+            };
+
+            //! Usage of an asset taking part in the residency tracking, "evicted" is set for textures
+            //! evicted by UpdateResidency until they are requested again
+            struct AssetResidency
+            {
+                UInt32 referenceCount = 0;
+                UInt64 lastUsedFrame = 0;
+                bool evicted = false;
+            };
+
+            //! Number of entries decoded before they are turned into assets, bounds the memory held by decoded images
+            static constexpr UInt64 DecodeBatchSize = 64;
+
         private:
             void _Initialize();
             void _Finalize();
 
-            void _LoadAssetFileHeaders(const BinaryBuffer& fileBuffer, AssetCount assetCount, const Filepath& filepath);
-            KMP_NODISCARD bool _LoadAssetFileBinaries(const BinaryBuffer& fileBuffer, AssetCount assetCount);
+            KMP_NODISCARD Nullable<const AssetFile*> _RegisterAssetFile(const Filepath& filepath);
+            KMP_NODISCARD bool _LoadAssetFileBinaries(const AssetFile& assetFile);
+            KMP_NODISCARD bool _FindAsset(StringID sid, AssetLookupInfo& lookupInfo) const;
 
             Vector<AssetLookupInfo> _GetSortedByFileAssetsInfos(const Vector<StringID>& assetsSids) const;
             KMP_NODISCARD bool _LoadAssetsEntriesBinaries(const Vector<AssetLookupInfo>& sortedLookupVector);
-            KMP_NODISCARD bool _LoadAssetEntryBinary(const BinaryBuffer& fileBuffer, const AssetEntryHeader& assetHeader);
+            KMP_NODISCARD bool _AddAssetEntry(BinaryView fileView, const AssetEntryHeader& assetHeader, Vector<AssetEntry>& entries) const;
+            KMP_NODISCARD bool _LoadAssetEntries(const Vector<AssetEntry>& entries);
+            KMP_NODISCARD DecodedAssetEntry _DecodeAssetEntry(const AssetEntry& entry);
+            KMP_NODISCARD bool _CreateAsset(const AssetEntry& entry, DecodedAssetEntry&& decodedEntry);
+            void _DiscardDecodedEntry(DecodedAssetEntry& decodedEntry);
+            KMP_NODISCARD bool _IsAssetResident(const AssetEntryHeader& assetHeader) const;
+
+            void _DecodeNextStreamingEntry();
+            void _FinishStreamingAsset(StringID sid, bool loaded);
+            void _CancelStreaming();
+
+            friend class AssetHandle;
+
+            void _RetainAsset(StringID sid);
+            void _ReleaseAsset(StringID sid) noexcept;
+            void _TouchAsset(StringID sid);
+            void _ForgetUnloadedAsset(StringID sid);
+
+            KMP_NODISCARD static bool _StreamingEntryLess(const StreamingEntry& entry1, const StreamingEntry& entry2) noexcept;
+            KMP_NODISCARD static UInt64 _EstimateUploadSize(const StreamingEntry& streamingEntry) noexcept;
 
         private:
             const Filepath& _dataPath;
             const LocaleStr& _currentLocale;
             Graphics::GraphicsBackend& _graphicsBackend;
+            const UInt32 _decodeThreadsCount;
+            UPtr<ThreadPool> _decodePool;
             UPtr<TextureAssetManager> _textureAssetManager;
             UPtr<FontAssetManager> _fontAssetManager;
-            StringIDHashMap<AssetLookupInfo> _lookupMap;
+            Vector<AssetFile> _assetFiles;
+
+            std::mutex _streamingMutex;
+            Vector<StreamingEntry> _streamingDecodeQueue;
+            Vector<StreamingEntry> _streamingUploadQueue;
+            StringIDHashMap<Vector<AssetLoadHandle>> _streamingRequests;
+            UInt64 _streamingSequence;
+
+            StringIDHashMap<AssetResidency> _residency;
+            UInt64 _frameIndex;
         };
         //--------------------------------------------------------------------------
     }
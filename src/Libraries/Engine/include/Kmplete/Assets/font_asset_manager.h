@@ -4,10 +4,14 @@
 #include "Kmplete/Base/types_aliases.h"
 #include "Kmplete/Base/pointers.h"
 #include "Kmplete/Base/string_id.h"
+#include "Kmplete/Base/nullability.h"
 #include "Kmplete/Assets/font_asset.h"
+#include "Kmplete/Assets/font_atlas_asset.h"
 #include "Kmplete/Log/log_class_macro.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 
+#include <mutex>
+
 
 struct FT_LibraryRec_;
 
@@ -19,8 +23,11 @@ namespace Kmplete
         //! Manager of font assets, responsible for initializing FreeType for font-related routines,
         //! managing lifetime of contained asset objects, adding/deleting font assets. 
         //! If this manager has been successfully created - then there is the asset with StringID = 0 that holds
-        //! the "default" font (which font is used depends on the platform - Arial or Ubuntu with size 18)
+        //! the "default" font (which font is used depends on the platform - Arial or Ubuntu with size 18).
+        //! Font atlases baked by AssetsCompiler are kept by this manager as well, they share the StringID space
+        //! with fonts, so RemoveAssets removes both
         //! @see Assets::FontAsset
+        //! @see Assets::FontAtlasAsset
         class KMP_API FontAssetManager
         {
             KMP_LOG_CLASSNAME(FontAssetManager)
@@ -36,14 +43,30 @@ namespace Kmplete
             bool CreateAsset(StringID fontSid, BinaryBuffer&& fontData, FontSubTypeMaskBits subTypeMask);
             bool CreateAsset(StringID fontSid, const Filepath& filepath, FontSubTypeMaskBits subTypeMask);
 
+            //! Thread-safe creation of a font asset that is not yet owned by the manager, FreeType requires face creation
+            //! on a shared library instance to be serialized. Returns nullptr if the font data cannot be parsed
+            //! @see AddAsset
+            KMP_NODISCARD UPtr<Assets::FontAsset> ParseAsset(StringID fontSid, BinaryBuffer&& fontData, FontSubTypeMaskBits subTypeMask);
+            bool AddAsset(UPtr<Assets::FontAsset>&& fontAsset);
+            //! Thread-safe destruction of a parsed font asset that is not going to be added, the face is destroyed
+            //! under the same lock as ParseAsset creates it
+            void DiscardAsset(UPtr<Assets::FontAsset>&& fontAsset);
+
             KMP_NODISCARD const Assets::FontAsset& GetAsset(StringID fontSid) const;
             KMP_NODISCARD Assets::FontAsset& GetAsset(StringID fontSid);
 
             void RemoveAssets(const Vector<StringID>& sids);
             KMP_NODISCARD bool RemoveAsset(StringID sid);
 
+            KMP_NODISCARD bool ContainsAsset(StringID sid) const noexcept;
             KMP_NODISCARD UInt64 GetAssetsCount() const noexcept;
 
+            //! Validates the baked payload and keeps a copy of it
+            bool CreateAtlasAsset(StringID atlasSid, BinaryView payload);
+            //! @return atlas asset or nullptr if there is no atlas with the given sid
+            KMP_NODISCARD Nullable<const Assets::FontAtlasAsset*> GetAtlasAsset(StringID atlasSid) const;
+            KMP_NODISCARD bool ContainsAtlasAsset(StringID sid) const noexcept;
+
         private:
             void _Initialize();
             void _Finalize();
@@ -54,6 +77,8 @@ namespace Kmplete
         private:
             FT_LibraryRec_* _freetypeLibInstance;
             StringIDHashMap<UPtr<Assets::FontAsset>> _fonts;
+            StringIDHashMap<UPtr<Assets::FontAtlasAsset>> _fontAtlases;
+            std::mutex _freetypeMutex;
         };
         //--------------------------------------------------------------------------
     }
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/string_id.h"
+#include "Kmplete/Assets/asset.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        //! Asset of a font atlas type containing the payload baked by AssetsCompiler: glyph metrics
+        //! and pages of signed distance fields, the payload is validated before the asset is created.
+        //! The payload is handed to Graphics::GlyphAtlas::LoadBaked as is
+        //! @see FontAtlasPayloadHeader
+        //! @see Assets::Asset
+        class KMP_API FontAtlasAsset : public Asset
+        {
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+
+        public:
+            FontAtlasAsset(StringID sid, BinaryBuffer&& payload, const FontAtlasPayloadHeader& header);
+            ~FontAtlasAsset() = default;
+
+            KMP_NODISCARD BinaryView GetPayload() const noexcept;
+            KMP_NODISCARD const FontAtlasPayloadHeader& GetHeader() const noexcept;
+
+        private:
+            BinaryBuffer _payload;
+            FontAtlasPayloadHeader _header;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
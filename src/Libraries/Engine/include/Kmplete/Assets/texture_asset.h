@@ -14,22 +14,25 @@ namespace Kmplete
 {
     namespace Assets
     {
-        //! Asset of a texture type containing single Texture object
+        //! Asset of a texture type containing single Texture object and its slot in the bindless textures array
         //! @see Texture
+        //! @see TextureAssetManager
         //! @see Assets::Asset
         class KMP_API TextureAsset : public Asset
         {
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            TextureAsset(StringID sid, NonNull<Graphics::Texture*> texture, TextureSubTypeMaskBits subTypeMask) noexcept;
+            TextureAsset(StringID sid, NonNull<Graphics::Texture*> texture, TextureSubTypeMaskBits subTypeMask, UInt32 bindlessIndex) noexcept;
             ~TextureAsset() = default;
 
             KMP_NODISCARD const Graphics::Texture& GetTexture() const noexcept;
             KMP_NODISCARD Graphics::Texture& GetTexture() noexcept;
+            KMP_NODISCARD UInt32 GetBindlessIndex() const noexcept;
 
         private:
             UPtr<Graphics::Texture> _texture;
+            const UInt32 _bindlessIndex;
         };
         //--------------------------------------------------------------------------
     }
@@ -2,6 +2,7 @@
 
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/nullability.h"
 #include "Kmplete/Base/types_aliases.h"
 #include "Kmplete/Base/string_id.h"
 #include "Kmplete/Assets/texture_asset.h"
@@ -25,6 +26,11 @@ namespace Kmplete
         //! adding/deleting texture assets.
         //! If this manager has successfully been created - then there is the asset with StringID = 0 that holds
         //! "Error" texture (little pink/black square)
+        //! If the graphics backend has the bindless mode enabled, every texture gets a slot in the bindless textures array
+        //! that stays the same while the texture lives, the slot of a removed texture is reset to the error texture
+        //! and is reused by the next created one.
+        //! The error texture always takes the slot ErrorTextureBindlessIndex, which is also given to every texture
+        //! when the bindless mode is disabled or the array is full, so any index is safe for shaders to sample
         //! @see Assets::TextureAsset
         class KMP_API TextureAssetManager
         {
@@ -34,12 +40,15 @@ namespace Kmplete
 
         public:
             static constexpr StringID ErrorTextureSID = 0;
+            static constexpr UInt32 ErrorTextureBindlessIndex = 0;
 
             explicit TextureAssetManager(Graphics::GraphicsBackend& graphicsBackend);
             ~TextureAssetManager() = default;
 
             bool CreateAsset(StringID textureSid, const Filepath& filepath, TextureSubTypeMaskBits subTypeMask, bool flipVertically = false);
             bool CreateAsset(StringID textureSid, const Graphics::Image& image, TextureSubTypeMaskBits subTypeMask);
+            //! @param texturePayload raw texture payload produced by AssetsCompiler, see Assets::TexturePayloadHeader
+            bool CreateAsset(StringID textureSid, BinaryView texturePayload, TextureSubTypeMaskBits subTypeMask);
 
             KMP_NODISCARD const Assets::TextureAsset& GetAsset(StringID textureSid) const;
             KMP_NODISCARD Assets::TextureAsset& GetAsset(StringID textureSid);
@@ -47,15 +56,24 @@ namespace Kmplete
             void RemoveAssets(const Vector<StringID>& sids);
             KMP_NODISCARD bool RemoveAsset(StringID sid);
 
+            KMP_NODISCARD bool ContainsAsset(StringID sid) const noexcept;
             KMP_NODISCARD UInt64 GetAssetsCount() const noexcept;
 
         private:
             KMP_NODISCARD bool _CreateErrorTextureAsset();
             KMP_NODISCARD bool _TextureSidIsValid(StringID textureSid);
+            KMP_NODISCARD bool _EmplaceAsset(StringID textureSid, NonNull<Graphics::Texture*> texture, TextureSubTypeMaskBits subTypeMask);
+
+            KMP_NODISCARD UInt32 _AcquireBindlessIndex(const Graphics::Texture& texture);
+            void _ReleaseBindlessIndex(UInt32 bindlessIndex);
 
         private:
             Graphics::GraphicsBackend& _graphicsBackend;
             StringIDHashMap<UPtr<Assets::TextureAsset>> _textures;
+
+            const UInt32 _bindlessTexturesCount;
+            UInt32 _nextBindlessIndex;
+            Vector<UInt32> _freeBindlessIndices;
         };
         //--------------------------------------------------------------------------
     }
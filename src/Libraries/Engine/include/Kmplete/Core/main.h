@@ -90,7 +90,7 @@ int Main(const Kmplete::ProgramOptions& programOptions)
 #endif
 
     KMP_MB_UNUSED const auto startupSessionCapacity = 600;
-    KMP_PROFILE_BEGIN_SESSION("Startup", Kmplete::Utils::Concatenate(Kmplete::ApplicationProfileSessionPrefix(), "-Profile-Startup.json"), startupSessionCapacity);
+    KMP_PROFILE_BEGIN_SESSION("Startup", Kmplete::Utils::Concatenate(Kmplete::ApplicationProfileSessionPrefix(), "-Profile-Startup.kmptrace"), startupSessionCapacity);
     auto app = Kmplete::CreateApplication(programOptions);
     KMP_PROFILE_END_SESSION();
 
@@ -100,12 +100,12 @@ int Main(const Kmplete::ProgramOptions& programOptions)
     }
 
     KMP_MB_UNUSED const auto runtimeSessionCapacity = 10'000;
-    KMP_PROFILE_BEGIN_SESSION("Runtime", Kmplete::Utils::Concatenate(Kmplete::ApplicationProfileSessionPrefix(), "-Profile-Runtime.json"), runtimeSessionCapacity);
+    KMP_PROFILE_BEGIN_SESSION("Runtime", Kmplete::Utils::Concatenate(Kmplete::ApplicationProfileSessionPrefix(), "-Profile-Runtime.kmptrace"), runtimeSessionCapacity);
     app->Run();
     KMP_PROFILE_END_SESSION();
 
     KMP_MB_UNUSED const auto shutdownSessionCapacity = 200;
-    KMP_PROFILE_BEGIN_SESSION("Shutdown", Kmplete::Utils::Concatenate(Kmplete::ApplicationProfileSessionPrefix(), "-Profile-Shutdown.json"), shutdownSessionCapacity);
+    KMP_PROFILE_BEGIN_SESSION("Shutdown", Kmplete::Utils::Concatenate(Kmplete::ApplicationProfileSessionPrefix(), "-Profile-Shutdown.kmptrace"), shutdownSessionCapacity);
     app.reset();
     KMP_PROFILE_END_SESSION();
 
@@ -28,7 +28,7 @@ namespace Kmplete
         KMP_NODISCARD OptionalRef<SettingsDocument> PutSettingsDocument(const String& name);
         KMP_NODISCARD OptionalRef<SettingsDocument> GetSettingsDocument(const String& name) const;
 
-        bool LoadSettings();
+        bool LoadSettings(JsonLoadMode loadMode = JsonLoadMode::InSitu);
         bool SaveSettings() const;
 
         void SetFilepath(const Filepath& filepath) noexcept;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/functional.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+#include "Kmplete/Log/log_class_macro.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+namespace Kmplete
+{
+    //! Fixed-size pool of worker threads executing submitted tasks in FIFO order.
+    //! ParallelFor splits an index range between the workers and the calling thread
+    //! and returns once every index has been processed. Exceptions thrown by tasks are
+    //! caught and logged, they never leave a worker thread
+    class KMP_API ThreadPool
+    {
+        KMP_LOG_CLASSNAME(ThreadPool)
+        KMP_PROFILE_CONSTRUCTOR_DECLARE()
+        KMP_DISABLE_COPY_MOVE(ThreadPool)
+
+    public:
+        using Task = Function<void()>;
+        using IndexedTask = Function<void(UInt64)>;
+
+    public:
+        //! @param threadsCount number of worker threads, 0 means "one less than the hardware concurrency" (but at least one)
+        explicit ThreadPool(UInt32 threadsCount = 0);
+        ~ThreadPool();
+
+        void Submit(Task&& task);
+        void WaitIdle();
+        void ParallelFor(UInt64 count, const IndexedTask& task);
+
+        KMP_NODISCARD UInt32 GetThreadsCount() const noexcept;
+
+    private:
+        void _Initialize();
+        void _Finalize();
+
+        void _WorkerLoop();
+        void _ExecuteTask(const Task& task) const;
+
+    private:
+        const UInt32 _threadsCount;
+        Vector<std::thread> _workers;
+        std::queue<Task> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _taskAvailableCondition;
+        std::condition_variable _idleCondition;
+        UInt64 _activeTasksCount;
+        bool _stopping;
+    };
+    //--------------------------------------------------------------------------
+}
\ No newline at end of file
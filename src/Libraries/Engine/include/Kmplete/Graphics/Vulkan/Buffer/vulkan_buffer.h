@@ -3,6 +3,8 @@
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/types_aliases.h"
 #include "Kmplete/Base/type_traits.h"
+#include "Kmplete/Base/nullability.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 
 #include <vulkan/vulkan.h>
@@ -12,9 +14,6 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        class VulkanMemoryTypeDelegate;
-
-
         //! Helper struct for storing Vulkan buffer creation parameters
         //! @see VulkanBuffer
         struct VulkanBufferParameters
@@ -22,6 +21,7 @@ namespace Kmplete
             VkBufferUsageFlags usageFlags;
             VkMemoryPropertyFlags memoryPropertyFlags;
             VkDeviceSize size;
+            VulkanMemoryStrategy memoryStrategy = VulkanMemoryStrategy::FreeList;
         };
         //--------------------------------------------------------------------------
 
@@ -35,7 +35,7 @@ namespace Kmplete
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            VulkanBuffer(const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkDevice device, const VulkanBufferParameters& parameters);
+            VulkanBuffer(VulkanMemoryAllocator& memoryAllocator, VkDevice device, const VulkanBufferParameters& parameters);
             VulkanBuffer(VulkanBuffer&& other) noexcept;
             VulkanBuffer& operator=(VulkanBuffer&& other) noexcept;
             virtual ~VulkanBuffer();
@@ -63,7 +63,7 @@ namespace Kmplete
             KMP_NODISCARD bool IsShaderDeviceAddressBuffer() const noexcept;
 
         private:
-            void _Initialize(const VulkanMemoryTypeDelegate& memoryTypeDelegate, const VulkanBufferParameters& parameters);
+            void _Initialize(const VulkanBufferParameters& parameters);
             void _Finalize();
 
         protected:
@@ -71,7 +71,8 @@ namespace Kmplete
             VkBuffer _buffer;
 
         private:
-            VkDeviceMemory _memory;
+            Nullable<VulkanMemoryAllocator*> _memoryAllocator;
+            VulkanMemoryAllocation _allocation;
             VkDeviceSize _size;
             void* _mapped;
             VkBufferUsageFlags _usageFlags;
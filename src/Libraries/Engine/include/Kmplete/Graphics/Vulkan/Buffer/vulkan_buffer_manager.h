@@ -18,7 +18,7 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        class VulkanMemoryTypeDelegate;
+        class VulkanMemoryAllocator;
 
 
         //! Manager class for creating and storing Vulkan buffer objects.
@@ -35,7 +35,7 @@ namespace Kmplete
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            VulkanBufferManager(VkDevice device, const VulkanMemoryTypeDelegate& memoryTypeDelegate);
+            VulkanBufferManager(VkDevice device, VulkanMemoryAllocator& memoryAllocator);
             ~VulkanBufferManager() = default;
 
             KMP_NODISCARD VulkanBuffer CreateBuffer(const VulkanBufferParameters& parameters) const;
@@ -82,7 +82,7 @@ namespace Kmplete
 
         private:
             VkDevice _device;
-            const VulkanMemoryTypeDelegate& _memoryTypeDelegate;
+            VulkanMemoryAllocator& _memoryAllocator;
 
             StringIDHashMap<UPtr<VulkanBuffer>> _buffers;
             StringIDHashMap<UPtr<VulkanVertexBuffer>> _vertexBuffers;
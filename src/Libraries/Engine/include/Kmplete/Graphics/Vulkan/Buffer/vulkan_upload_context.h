@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/functional.h"
+#include "Kmplete/Base/nullability.h"
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer.h"
+#include "Kmplete/Graphics/Vulkan/Command/vulkan_command_pool.h"
+#include "Kmplete/Graphics/Vulkan/Command/vulkan_command_buffer.h"
+#include "Kmplete/Log/log_class_macro.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+
+#include <vulkan/vulkan.h>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        class VulkanQueue;
+        class VulkanMemoryAllocator;
+
+
+        //! Value of the upload timeline semaphore that gets signaled once the batch
+        //! containing the corresponding upload is finished on the GPU
+        //! @see VulkanUploadContext
+        struct VulkanUploadTicket
+        {
+            UInt64 value = 0ULL;
+
+            KMP_NODISCARD bool IsValid() const noexcept { return value != 0ULL; }
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Staging memory region handed out by VulkanUploadContext, "mapped" points to the
+        //! host-visible memory at "offset" within "buffer"
+        //! @see VulkanUploadContext
+        struct VulkanStagingRegion
+        {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0ULL;
+            VkDeviceSize size = 0ULL;
+            Nullable<UByte*> mapped = nullptr;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Batched uploader backed by a persistently mapped staging ring buffer. Every upload copies its data into the ring
+        //! and records transfer commands into the command buffer of the current batch, batches are submitted at once
+        //! (normally by the renderer right before the frame submission) and signal a timeline semaphore value, which is
+        //! returned as a ticket instead of waiting for the queue. Ring regions are reclaimed as soon as the timeline semaphore
+        //! passes the value of the batch that used them, uploads larger than the ring get a temporary staging buffer.
+        //! Not thread-safe, supposed to be used from the rendering thread only.
+        //! @see VulkanUploadTicket, VulkanRenderer
+        class KMP_API VulkanUploadContext
+        {
+            KMP_DISABLE_COPY_MOVE(VulkanUploadContext)
+            KMP_LOG_CLASSNAME(VulkanUploadContext)
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+
+        public:
+            using RecordFunction = Function<void(VkCommandBuffer, const VulkanStagingRegion&)>;
+
+            static constexpr VkDeviceSize MaxAlignment = 256ULL;
+
+        public:
+            VulkanUploadContext(VkDevice device, VulkanMemoryAllocator& memoryAllocator, const VulkanQueue& queue, UInt32 queueFamilyIndex, VkDeviceSize ringSize);
+            ~VulkanUploadContext();
+
+            VulkanUploadTicket Upload(const void* data, VkDeviceSize size, VkDeviceSize alignment, const RecordFunction& recordFunction);
+            VulkanUploadTicket UploadBuffer(const VulkanBuffer& destinationBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+            VulkanUploadTicket Record(const Function<void(VkCommandBuffer)>& recordFunction);
+
+            VulkanUploadTicket Flush();
+            void Wait(VulkanUploadTicket ticket);
+            KMP_NODISCARD bool IsComplete(VulkanUploadTicket ticket) const;
+
+            KMP_NODISCARD VkSemaphore GetTimelineSemaphore() const noexcept;
+            KMP_NODISCARD VkDeviceSize GetRingSize() const noexcept;
+            KMP_NODISCARD UInt64 GetSubmittedBatchesCount() const noexcept;
+
+        private:
+            //! Set of commands submitted at once, owns the temporary staging buffers that did not fit into the ring
+            struct UploadBatch
+            {
+                VulkanCommandBuffer commandBuffer;
+                UInt64 value = 0ULL;
+                UInt64 ringEnd = 0ULL;
+                Vector<VulkanBuffer> temporaryBuffers;
+            };
+
+        private:
+            void _Initialize();
+            void _Finalize();
+
+            KMP_NODISCARD VulkanStagingRegion _AllocateStaging(VkDeviceSize size, VkDeviceSize alignment);
+            KMP_NODISCARD VulkanStagingRegion _AllocateTemporaryStaging(VkDeviceSize size);
+            KMP_NODISCARD UploadBatch& _GetRecordingBatch();
+            void _SubmitRecordingBatch();
+            void _RetireCompletedBatches();
+            void _WaitValue(UInt64 value) const;
+            KMP_NODISCARD UInt64 _GetCompletedValue() const;
+
+        private:
+            VkDevice _device;
+            VulkanMemoryAllocator& _memoryAllocator;
+            const VulkanQueue& _queue;
+            const VkDeviceSize _ringSize;
+
+            UPtr<VulkanCommandPool> _commandPool;
+            UPtr<VulkanBuffer> _ringBuffer;
+            Nullable<UByte*> _ringMapped;
+            VkSemaphore _timelineSemaphore;
+
+            UInt64 _ringHead;
+            UInt64 _ringTail;
+            UInt64 _lastSubmittedValue;
+            UPtr<UploadBatch> _recordingBatch;
+            Vector<UPtr<UploadBatch>> _inFlightBatches;
+            Vector<VulkanCommandBuffer> _freeCommandBuffers;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
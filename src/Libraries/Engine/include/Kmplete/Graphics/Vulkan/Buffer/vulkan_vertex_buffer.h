@@ -14,9 +14,6 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        class VulkanMemoryTypeDelegate;
-
-
         //! Vulkan vertex buffer implementation class that additionally supports
         //! storing one or more BufferLayout-s which are used for calculating 
         //! bindings and attributes descriptions for rendering
@@ -27,7 +24,7 @@ namespace Kmplete
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            VulkanVertexBuffer(const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkDevice device, const VulkanBufferParameters& parameters);
+            VulkanVertexBuffer(VulkanMemoryAllocator& memoryAllocator, VkDevice device, const VulkanBufferParameters& parameters);
             VulkanVertexBuffer(VulkanVertexBuffer&& other) noexcept;
             VulkanVertexBuffer& operator=(VulkanVertexBuffer&& other) noexcept;
             ~VulkanVertexBuffer() = default;
@@ -11,26 +11,27 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        //! Simple Vulkan command buffer object wrapper
+        //! Simple Vulkan command buffer object wrapper, either primary or secondary one
         class KMP_API VulkanCommandBuffer
         {
             KMP_DISABLE_COPY(VulkanCommandBuffer)
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            VulkanCommandBuffer(VkDevice device, VkCommandPool commandPool);
+            VulkanCommandBuffer(VkDevice device, VkCommandPool commandPool, bool primary = true);
             VulkanCommandBuffer(VulkanCommandBuffer&& other) noexcept;
             VulkanCommandBuffer& operator=(VulkanCommandBuffer&& other) noexcept;
             ~VulkanCommandBuffer();
 
             void Begin(VkCommandBufferUsageFlags flags = 0) const;
+            void Begin(VkCommandBufferUsageFlags flags, const VkCommandBufferInheritanceInfo& inheritanceInfo) const;
             void End() const;
             void Reset() const;
 
             KMP_NODISCARD VkCommandBuffer GetVkCommandBuffer() const noexcept;
 
         private:
-            void _Initialize();
+            void _Initialize(bool primary);
             void _Finalize();
 
         private:
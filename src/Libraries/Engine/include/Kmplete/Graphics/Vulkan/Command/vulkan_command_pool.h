@@ -24,6 +24,9 @@ namespace Kmplete
             VulkanCommandPool(VkDevice device, UInt32 graphicsQueueIndex);
             ~VulkanCommandPool();
 
+            //! Resets all the command buffers allocated from the pool at once, none of them should be pending
+            void Reset() const;
+
             KMP_NODISCARD VkCommandPool GetVkCommandPool() const noexcept;
 
         private:
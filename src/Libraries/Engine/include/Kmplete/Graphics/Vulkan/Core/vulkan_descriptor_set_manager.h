@@ -4,6 +4,7 @@
 #include "Kmplete/Base/types_aliases.h"
 #include "Kmplete/Base/string_id.h"
 #include "Kmplete/Graphics/graphics_base.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_descriptor_writer.h"
 #include "Kmplete/Log/log_class_macro.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 
@@ -23,6 +24,16 @@ namespace Kmplete
         //! Descriptor sets, layouts and auxiliary pools stored in hashmaps (by StringID as a key). Similar to VulkanBufferManager
         //! this manager separates descriptor sets by per-frame usage and plain descriptor sets.
         //! A set may be updated using either it's StringID or just a VkDescriptorSet handle.
+        //! Optionally (bindless mode, when the bindless textures count is not zero) a single set with a large partially bound array
+        //! of combined image samplers is allocated once from a separate UPDATE_AFTER_BIND pool. Its layout is registered
+        //! as BindlessTexturesLayoutSID, so pipeline layouts can reference it, and shaders index the array (e.g. by push constant),
+        //! so a textured draw needs no descriptor set of its own. Slots of the array may be written while the set is bound
+        //! as long as frames in flight do not use them.
+        //! Every Set*Descriptor call updates a single descriptor with its own vkUpdateDescriptorSets call, so many writes
+        //! (e.g. per frame loops) should rather be batched with a VulkanDescriptorWriter. For sets that are rewritten
+        //! every frame with the same shape, descriptor update templates (stored by StringID) write the whole set
+        //! from a plain user struct in one call.
+        //! @see VulkanDescriptorWriter
         //! @see VulkanBufferManager
         //! @see StringID
         class KMP_API VulkanDescriptorSetManager
@@ -35,8 +46,11 @@ namespace Kmplete
             //! Shortcut alias for a collection of descriptor sets objects
             using DescriptorSetStorage = StringIDHashMap<Vector<VkDescriptorSet>>;
 
+            static constexpr auto BindlessTexturesLayoutSID = "BindlessTexturesLayout"_sid;
+            static constexpr UInt32 BindlessTexturesBinding = 0;
+
         public:
-            VulkanDescriptorSetManager(VkDevice device, const UInt32& currentBufferIndex, UInt32 maxDescriptorSets, const Vector<VkDescriptorPoolSize>& descriptorPoolSizes);
+            VulkanDescriptorSetManager(VkDevice device, const UInt32& currentBufferIndex, UInt32 maxDescriptorSets, const Vector<VkDescriptorPoolSize>& descriptorPoolSizes, UInt32 bindlessTexturesCount = 0);
             ~VulkanDescriptorSetManager();
 
             KMP_NODISCARD VkDescriptorPool GetVkDescriptorPool() const noexcept;
@@ -81,8 +95,24 @@ namespace Kmplete
             bool SetSamplerDescriptor(StringID setSid, UInt32 setIndex, bool perFrame, UInt32 frameIndex, VkSampler sampler, UInt32 binding) const;
             bool SetSamplerDescriptor(VkDescriptorSet descriptorSet, VkSampler sampler, UInt32 binding) const;
 
+            KMP_NODISCARD VulkanDescriptorWriter CreateDescriptorWriter() const;
+
+            //! Entries' offsets and strides refer to the user data passed to UpdateDescriptorSetWithTemplate
+            bool AddDescriptorUpdateTemplate(StringID templateSid, StringID layoutSid, const Vector<VkDescriptorUpdateTemplateEntry>& entries);
+            KMP_NODISCARD VkDescriptorUpdateTemplate GetDescriptorUpdateTemplate(StringID templateSid) const noexcept;
+            bool UpdateDescriptorSetWithTemplate(StringID setSid, UInt32 setIndex, bool perFrame, UInt32 frameIndex, StringID templateSid, const void* data) const;
+            bool UpdateDescriptorSetWithTemplate(VkDescriptorSet descriptorSet, StringID templateSid, const void* data) const;
+
+            //! @return size of the bindless textures array, zero if the bindless mode is disabled
+            KMP_NODISCARD UInt32 GetBindlessTexturesCount() const noexcept;
+            KMP_NODISCARD VkDescriptorSet GetBindlessDescriptorSet() const noexcept;
+            bool SetBindlessTextureDescriptor(UInt32 index, VkImageView imageView, VkSampler sampler) const;
+            //! @return image view last written to the bindless textures array slot, null if the slot has never been written
+            KMP_NODISCARD VkImageView GetBindlessTextureImageView(UInt32 index) const noexcept;
+
         private:
             void _Initialize(UInt32 maxDescriptorSets, const Vector<VkDescriptorPoolSize>& descriptorPoolSizes);
+            void _InitializeBindlessTextures(UInt32 bindlessTexturesCount);
             void _Finalize();
 
             KMP_NODISCARD bool _AllocateDescriptorSets(const Vector<VkDescriptorSetLayout>& layouts, StringID setSid, UInt32 setsCount, DescriptorSetStorage& storage) const;
@@ -98,9 +128,15 @@ namespace Kmplete
             VkDescriptorPool _descriptorPool;
             StringIDHashMap<VkDescriptorPool> _auxDescriptorPools;
             StringIDHashMap<VkDescriptorSetLayout> _descriptorSetLayouts;
+            StringIDHashMap<VkDescriptorUpdateTemplate> _descriptorUpdateTemplates;
 
             Array<DescriptorSetStorage, NumConcurrentFrames> _descriptorsPerFrame;
             DescriptorSetStorage _descriptors;
+
+            UInt32 _bindlessTexturesCount;
+            VkDescriptorPool _bindlessDescriptorPool;
+            VkDescriptorSet _bindlessDescriptorSet;
+            mutable Vector<VkImageView> _bindlessImageViews;
         };
         //--------------------------------------------------------------------------
     }
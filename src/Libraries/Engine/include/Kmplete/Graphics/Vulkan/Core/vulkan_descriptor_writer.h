@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/type_traits.h"
+#include "Kmplete/Log/log_class_macro.h"
+
+#include <vulkan/vulkan.h>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        //! Builder of batched descriptor sets updates. Buffer and image writes (to any number of descriptor sets) are
+        //! accumulated by the writer and then flushed to the device with a single vkUpdateDescriptorSets call,
+        //! instead of a separate call per descriptor. Flush keeps the allocated storage, so a writer may be kept
+        //! and reused every frame without allocations. Handles passed to the writer must stay valid until Flush.
+        //! @see VulkanDescriptorSetManager::CreateDescriptorWriter
+        class KMP_API VulkanDescriptorWriter
+        {
+            KMP_DISABLE_COPY(VulkanDescriptorWriter)
+            KMP_LOG_CLASSNAME(VulkanDescriptorWriter)
+
+        public:
+            explicit VulkanDescriptorWriter(VkDevice device) noexcept;
+            VulkanDescriptorWriter(VulkanDescriptorWriter&& other) noexcept = default;
+            VulkanDescriptorWriter& operator=(VulkanDescriptorWriter&& other) noexcept = default;
+            ~VulkanDescriptorWriter() = default;
+
+            void Reserve(UInt32 writesCount);
+
+            bool WriteBuffer(VkDescriptorSet descriptorSet, UInt32 binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize range, VkDeviceSize offset = 0, UInt32 arrayElement = 0);
+            bool WriteImage(VkDescriptorSet descriptorSet, UInt32 binding, VkDescriptorType type, VkImageView imageView, VkSampler sampler, UInt32 arrayElement = 0);
+
+            //! @return number of descriptors written to the device
+            UInt32 Flush();
+            void Clear() noexcept;
+
+            KMP_NODISCARD UInt32 GetWritesCount() const noexcept;
+            KMP_NODISCARD bool IsEmpty() const noexcept;
+
+        private:
+            KMP_NODISCARD VkWriteDescriptorSet _CreateWrite(VkDescriptorSet descriptorSet, UInt32 binding, VkDescriptorType type, UInt32 arrayElement) const noexcept;
+            KMP_NODISCARD static bool _IsBufferType(VkDescriptorType type) noexcept;
+            KMP_NODISCARD static bool _IsImageType(VkDescriptorType type) noexcept;
+
+        private:
+            VkDevice _device;
+            Vector<VkWriteDescriptorSet> _writes;
+            Vector<VkDescriptorBufferInfo> _bufferInfos;
+            Vector<VkDescriptorImageInfo> _imageInfos;
+
+            //! Index of the write's info in either buffer or image infos, pointers are fixed up at Flush
+            //! since the infos storages may be reallocated while writes are accumulated
+            Vector<UInt32> _infoIndices;
+        };
+        //--------------------------------------------------------------------------
+
+        static_assert(IsMoveConstructible<VulkanDescriptorWriter>::value);
+        static_assert(IsMoveAssignable<VulkanDescriptorWriter>::value);
+    }
+}
\ No newline at end of file
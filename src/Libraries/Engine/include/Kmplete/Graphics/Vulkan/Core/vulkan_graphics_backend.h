@@ -39,6 +39,13 @@ namespace Kmplete
             void RecreateResources() override;
 
             KMP_NODISCARD Nullable<Texture*> CreateTexture(const Image& image, Assets::TextureSubTypeMaskBits subTypeMask) override;
+            KMP_NODISCARD Nullable<Texture*> CreateTexture(BinaryView texturePayload, Assets::TextureSubTypeMaskBits subTypeMask) override;
+            bool UpdateTexture(Texture& texture, BinaryView pixels, const TextureRegion& region) override;
+
+            KMP_NODISCARD UInt32 GetBindlessTexturesCount() const override;
+            bool SetBindlessTexture(UInt32 index, const Texture& texture) override;
+
+            KMP_NODISCARD GraphicsMemoryUsage QueryMemoryUsage() override;
 
             KMP_NODISCARD UInt32 GetMultisampling() const override;
             void SetMultisampling(UInt32 samples) override;
@@ -3,6 +3,7 @@
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/string_id.h"
 #include "Kmplete/Graphics/graphics_base.h"
+#include "Kmplete/Assets/assets_interface.h"
 
 #include <vulkan/vulkan.h>
 
@@ -12,6 +13,7 @@ namespace Kmplete
     namespace Graphics
     {
         KMP_NODISCARD KMP_API VkFormat ImageChannelsToVkFormat(ImageChannels channels, bool srgb) noexcept;
+        KMP_NODISCARD KMP_API VkFormat TexturePayloadFormatToVkFormat(Assets::TexturePayloadFormat format, bool srgb) noexcept;
         KMP_NODISCARD KMP_API VkFormat ShaderDataTypeToVkFormat(ShaderDataType type) noexcept;
 
         static constexpr auto SamplerDefaultNearestSid = "DefaultNearest"_sid;
@@ -17,6 +17,9 @@ namespace Kmplete
         {
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
+        public:
+            static constexpr VkDeviceSize DefaultStagingBufferSize = 64ULL * 1024 * 1024;
+
         public:
             VulkanGraphicsParameters()
                 : GraphicsParameters(GraphicsBackendType::Vulkan)
@@ -30,10 +33,13 @@ namespace Kmplete
                 , depthClipEnableFeatures(VKUtils::InitVkPhysicalDeviceDepthClipEnableFeaturesEXT())
                 , dynamicStateFeatures3(VKUtils::InitVkPhysicalDeviceExtendedDynamicState3FeaturesEXT())
                 , features({})
+                , features12(VKUtils::InitVkPhysicalDeviceVulkan12Features())
                 , features13(VKUtils::InitVkPhysicalDeviceVulkan13Features())
                 , features2(VKUtils::InitVkPhysicalDeviceFeatures2())
                 , maxDescriptorSets(0)
                 , descriptorPoolSizes()
+                , bindlessTexturesCount(0)
+                , stagingBufferSize(DefaultStagingBufferSize)
             {
                 lineRasterizationFeatures.pNext = &vertexAttributeDivisorFeatures;
                 shaderObjectFeatures.pNext = &lineRasterizationFeatures;
@@ -43,7 +49,8 @@ namespace Kmplete
                 depthClipEnableFeatures.pNext = &colorWriteEnableFeatures;
                 dynamicStateFeatures3.pNext = &depthClipEnableFeatures;
                 features13.pNext = &dynamicStateFeatures3;
-                features2.pNext = &features13;
+                features12.pNext = &features13;
+                features2.pNext = &features12;
 
                 KMP_PROFILE_CONSTRUCTOR_END()
             }
@@ -57,11 +64,19 @@ namespace Kmplete
             VkPhysicalDeviceDepthClipEnableFeaturesEXT depthClipEnableFeatures;
             VkPhysicalDeviceExtendedDynamicState3FeaturesEXT dynamicStateFeatures3;
             VkPhysicalDeviceFeatures features;
+            VkPhysicalDeviceVulkan12Features features12;
             VkPhysicalDeviceVulkan13Features features13;
             VkPhysicalDeviceFeatures2 features2;
 
             UInt32 maxDescriptorSets;
             Vector<VkDescriptorPoolSize> descriptorPoolSizes;
+
+            //! Size of the bindless textures array (see VulkanDescriptorSetManager), zero disables the bindless mode.
+            //! Descriptor indexing features are enabled by the logical device if this is not zero and the device supports them
+            UInt32 bindlessTexturesCount;
+
+            //! Size of the persistently mapped staging ring used by VulkanUploadContext
+            VkDeviceSize stagingBufferSize;
         };
         //--------------------------------------------------------------------------
     }
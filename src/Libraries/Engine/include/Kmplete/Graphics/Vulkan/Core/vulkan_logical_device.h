@@ -11,12 +11,14 @@
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_descriptor_set_manager.h"
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_metrics_manager.h"
 #include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer_manager.h"
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_upload_context.h"
 #include "Kmplete/Graphics/Vulkan/Texture/vulkan_texture.h"
 #include "Kmplete/Graphics/Vulkan/Texture/vulkan_texture_attachment_manager.h"
 #include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_graphics_pipeline.h"
 #include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_graphics_pipeline_parameters.h"
 #include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_pipeline_manager.h"
 #include "Kmplete/Graphics/Vulkan/Shader/vulkan_shader_manager.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
 #include "Kmplete/Graphics/Vulkan/Delegates/vulkan_memory_type_delegate.h"
 #include "Kmplete/Graphics/Vulkan/Delegates/vulkan_image_creator_delegate.h"
 #include "Kmplete/Graphics/Vulkan/Delegates/vulkan_format_delegate.h"
@@ -70,6 +72,8 @@ namespace Kmplete
             KMP_NODISCARD const VulkanQueue& GetGraphicsQueue() const noexcept;
             KMP_NODISCARD const VulkanQueue& GetPresentationQueue() const noexcept;
             KMP_NODISCARD const VulkanImageCreatorDelegate& GetVulkanImageCreatorDelegate() const noexcept;
+            KMP_NODISCARD const VulkanMemoryAllocator& GetMemoryAllocator() const noexcept;
+            KMP_NODISCARD VulkanMemoryAllocator& GetMemoryAllocator() noexcept;
             KMP_NODISCARD const VulkanRenderer& GetRenderer() const noexcept;
             KMP_NODISCARD const VkExtent2D& GetCurrentExtent() const noexcept;
             KMP_NODISCARD const VulkanSamplersStorage& GetSamplersStorage() const noexcept;
@@ -83,18 +87,29 @@ namespace Kmplete
             KMP_NODISCARD VulkanShaderManager& GetShaderManager() noexcept;
             KMP_NODISCARD const VulkanBufferManager& GetBufferManager() const noexcept;
             KMP_NODISCARD VulkanBufferManager& GetBufferManager() noexcept;
+            KMP_NODISCARD const VulkanUploadContext& GetUploadContext() const noexcept;
+            KMP_NODISCARD VulkanUploadContext& GetUploadContext() noexcept;
             KMP_NODISCARD const VulkanMetricsManager& GetMetricsManager() const noexcept;
             KMP_NODISCARD VulkanMetricsManager& GetMetricsManager() noexcept;
 
             KMP_NODISCARD Nullable<VulkanTexture*> CreateTexture(const Image& image, Assets::TextureSubTypeMaskBits subTypeMask) const override;
+            KMP_NODISCARD Nullable<VulkanTexture*> CreateTexture(BinaryView texturePayload, Assets::TextureSubTypeMaskBits subTypeMask) const override;
+            bool UpdateTexture(Texture& texture, BinaryView pixels, const TextureRegion& region) const override;
+
+            KMP_NODISCARD UInt32 GetBindlessTexturesCount() const override;
+            bool SetBindlessTexture(UInt32 index, const Texture& texture) const override;
 
         private:
             void _CreateLogicalDeviceObject();
             void _DeleteLogicalDeviceObject();
+            void _EnableDescriptorIndexingFeatures();
 
             void _CreateDeviceQueues();
             void _DeleteDeviceQueues();
 
+            void _CreateMemoryAllocator();
+            void _DeleteMemoryAllocator();
+
             void _CreateImageCreatorDelegate();
             void _DeleteImageCreatorDelegate();
 
@@ -110,6 +125,9 @@ namespace Kmplete
             void _CreateBufferManager();
             void _DeleteBufferManager();
 
+            void _CreateUploadContext();
+            void _DeleteUploadContext();
+
             void _CreateSamplersStorage();
             void _DeleteSamplersStorage();
 
@@ -149,6 +167,7 @@ namespace Kmplete
             VkDevice _device;
             UPtr<VulkanQueue> _graphicsQueue;
             UPtr<VulkanQueue> _presentQueue;
+            UPtr<VulkanMemoryAllocator> _memoryAllocator;
             UPtr<VulkanImageCreatorDelegate> _imageCreatorDelegate;
             Array<VkSemaphore, NumConcurrentFrames> _presentCompleteSemaphores;
             Array<VkSemaphore, NumConcurrentFrames> _renderCompleteSemaphores;
@@ -156,6 +175,7 @@ namespace Kmplete
             UPtr<VulkanSwapchain> _swapchain;
             UPtr<VulkanDescriptorSetManager> _descriptorSetManager;
             UPtr<VulkanBufferManager> _bufferManager;
+            UPtr<VulkanUploadContext> _uploadContext;
             VkExtent2D _currentExtent;
             VkSampleCountFlagBits _msaaSamples;
             bool _vSync;
@@ -2,6 +2,7 @@
 
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 
 #include <vulkan/vulkan.h>
@@ -11,7 +12,7 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        //! Utility class for tracking memory usage by Vulkan API
+        //! Utility class for tracking memory usage by Vulkan API and by the engine's memory allocator
         class KMP_API VulkanMetricsManager
         {
             KMP_DISABLE_COPY_MOVE(VulkanMetricsManager)
@@ -26,10 +27,11 @@ namespace Kmplete
                 UInt64 totalBudget = 0ULL;
                 UInt64 totalUsage = 0ULL;
                 float usagePercent = 0.0f;
+                Vector<VulkanMemoryAllocator::HeapStatistics> allocatorHeapStatistics;
             };
 
         public:
-            explicit VulkanMetricsManager(VkPhysicalDevice physicalDevice);
+            VulkanMetricsManager(VkPhysicalDevice physicalDevice, const VulkanMemoryAllocator& memoryAllocator);
             ~VulkanMetricsManager() = default;
 
             const Metrics& QueryMetrics();
@@ -40,6 +42,7 @@ namespace Kmplete
 
         private:
             VkPhysicalDevice _physicalDevice;
+            const VulkanMemoryAllocator& _memoryAllocator;
             VkPhysicalDeviceMemoryProperties _memoryProperties;
             VkPhysicalDeviceMemoryProperties2 _memoryProperties2;
             VkPhysicalDeviceMemoryBudgetPropertiesEXT _memoryBudgetProperties;
@@ -5,6 +5,7 @@
 #include "Kmplete/Base/pointers.h"
 #include "Kmplete/Base/string_id.h"
 #include "Kmplete/Graphics/renderer.h"
+#include "Kmplete/Graphics/graphics_base.h"
 #include "Kmplete/Graphics/Vulkan/Command/vulkan_command_pool.h"
 #include "Kmplete/Graphics/Vulkan/Command/vulkan_command_buffer.h"
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_queue.h"
@@ -12,6 +13,7 @@
 #include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_graphics_pipeline.h"
 #include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_pipeline_manager.h"
 #include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer.h"
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_upload_context.h"
 #include "Kmplete/Graphics/Vulkan/Shader/vulkan_shader_manager.h"
 #include "Kmplete/Graphics/Vulkan/Texture/vulkan_texture_attachment.h"
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
@@ -26,9 +28,29 @@ namespace Kmplete
 {
     namespace Graphics
     {
+        //! Formats of the attachments the secondary command buffers of a parallel recording render to,
+        //! they must match the attachments of the rendering begun (with secondary contents) by the primary command buffer
+        struct VulkanSecondaryRenderingParameters
+        {
+            Vector<VkFormat> colorAttachmentFormats;
+            VkFormat depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+            VkFormat stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+            VkSampleCountFlagBits rasterizationSamples = VKBits::VK_SampleCount_1;
+        };
+        //--------------------------------------------------------------------------
+
+
         //! Vulkan API renderer that is responsible for all the rendering-related commands, such as:
         //! beginning/ending rendering (dynamic), drawing, queue submission, 
-        //! settings rendering dynamic states values, binding objects, copying buffers
+        //! settings rendering dynamic states values, binding objects, copying buffers.
+        //! Pending uploads of the upload context are submitted before the frame and the frame waits for them on the GPU.
+        //! Commands are recorded to the primary command buffer of the frame, unless the calling thread records a secondary one
+        //! of a parallel recording: BeginParallelRecording prepares N secondary command buffers (each one allocated from its own
+        //! per-frame command pool, so N threads may record at once without locking), every worker thread wraps its commands with
+        //! BeginSecondaryRecording(index)/EndSecondaryRecording, and once all of them are done, the main thread executes
+        //! the secondaries inside the rendering begun with secondary contents. Secondary command buffers do not inherit
+        //! any state, so every one of them should bind its pipeline, descriptor sets and set dynamic states (viewport, scissor etc.)
+        //! @see VulkanSecondaryRenderingParameters
         class KMP_API VulkanRenderer : public Renderer
         {
             KMP_DISABLE_COPY_MOVE(VulkanRenderer)
@@ -37,11 +59,11 @@ namespace Kmplete
 
         public:
             VulkanRenderer(GraphicsChainHandler& chainHandler, VkDevice device, const UInt32& currentBufferIndex, const VulkanPipelineManager& pipelineManager,
-                           const VulkanShaderManager& shaderManager, UInt32 graphicsFamilyIndex, const VulkanSwapchain& swapchain);
+                           const VulkanShaderManager& shaderManager, VulkanUploadContext& uploadContext, UInt32 graphicsFamilyIndex, const VulkanSwapchain& swapchain);
             ~VulkanRenderer();
 
-            void BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments) const;
-            void BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments, const VkRenderingAttachmentInfo& depthStencilAttachment) const;
+            void BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments, bool secondaryContents = false) const;
+            void BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments, const VkRenderingAttachmentInfo& depthStencilAttachment, bool secondaryContents = false) const;
             void BeginRendering(const VkRenderingInfo& renderingInfo) const;
             void EndRendering() const;
             void SubmitToQueue(const VulkanQueue& queue, const Vector<VkSemaphore>& waitSemaphores, const Vector<VkSemaphore>& signalSemaphores, VkFence fence);
@@ -93,6 +115,7 @@ namespace Kmplete
             void SetProvokingVertexMode(VkProvokingVertexModeEXT mode) const;
             void SetVertexInput(const Vector<VkVertexInputBindingDescription2EXT>& vertexBindingsDescriptions, const Vector<VkVertexInputAttributeDescription2EXT>& vertexAttributeDescriptions) const;
 
+            //! Skips the bind if the same pipeline is already bound to the command buffer the calling thread records to
             bool BindGraphicsPipeline(StringID pipelineSid) const;
             bool BindDescriptorSets(StringID layoutSid, UInt32 firstSetIndex, const Vector<VkDescriptorSet>& descriptorSets, const Vector<UInt32>& dynamicOffsets = Vector<UInt32>()) const;
             void PushConstants(StringID layoutSid, VkShaderStageFlags shaderStagesFlags, UInt32 offset, UInt32 size, const void* data) const;
@@ -112,15 +135,38 @@ namespace Kmplete
             void CopyBuffer(const VulkanCommandBuffer& commandBuffer, const VulkanBuffer& sourceBuffer, const VulkanBuffer& destinationBuffer, VkDeviceSize srcOffset, VkDeviceSize dstOffset, VkDeviceSize size) const;
             void CopyBuffer(const VulkanCommandBuffer& commandBuffer, const VulkanBuffer& sourceBuffer, const VulkanBuffer& destinationBuffer, const VkBufferCopy& copyRegion) const;
             void CopyBuffer(const VulkanCommandBuffer& commandBuffer, const VulkanBuffer& sourceBuffer, const VulkanBuffer& destinationBuffer, const Vector<VkBufferCopy>& copyRegions) const;
-            void CopyBuffers(const VulkanBuffer& stagingBuffer, const Vector<VKUtils::BufferCopyParameters>& copyParameters, const VulkanQueue& queue) const;
+            void CopyBuffers(const VulkanBuffer& stagingBuffer, const Vector<VKUtils::BufferCopyParameters>& copyParameters) const;
 
             KMP_NODISCARD VulkanCommandBuffer CreateCommandBuffer() const;
+            //! @return command buffer the calling thread records to - either a secondary one or the primary one of the frame
             KMP_NODISCARD VkCommandBuffer GetCurrentCommandBuffer() const noexcept;
+            //! Should be called after pipelines are bound to the current command buffer directly (e.g. by ImGui),
+            //! so BindGraphicsPipeline does not skip a bind it considers redundant
+            void InvalidateBoundPipeline() const noexcept;
+
+            //! Main thread only, the secondaries of several parallel recordings may be executed within a single frame
+            void BeginParallelRecording(UInt32 secondariesCount, const VulkanSecondaryRenderingParameters& parameters) const;
+            //! Worker thread, each secondary index should be recorded by a single thread
+            void BeginSecondaryRecording(UInt32 secondaryIndex) const;
+            void EndSecondaryRecording() const;
+            //! Main thread only, after all the secondaries have been recorded
+            void ExecuteSecondaries() const;
+            KMP_NODISCARD UInt32 GetParallelRecordingCount() const noexcept;
+
+        private:
+            struct SecondaryCommandBuffer
+            {
+                UPtr<VulkanCommandPool> commandPool;
+                VulkanCommandBuffer commandBuffer;
+            };
 
         private:
             void _Initialize(UInt32 graphicsFamilyIndex);
             void _Finalize();
 
+            KMP_NODISCARD VkCommandBuffer _GetRecordingCommandBuffer() const noexcept;
+            KMP_NODISCARD VkPipeline& _GetBoundPipeline() const noexcept;
+
             KMP_NODISCARD bool _StartFrame(float frameTimestep) override;
             void _EndFrame() override;
 
@@ -128,12 +174,22 @@ namespace Kmplete
             const UInt32& _currentBufferIndex;
             const VulkanPipelineManager& _pipelineManager;
             const VulkanShaderManager& _shaderManager;
+            VulkanUploadContext& _uploadContext;
             const VulkanSwapchain& _swapchain;
 
             VkDevice _device;
+            UInt32 _graphicsFamilyIndex;
             UPtr<VulkanCommandPool> _commandPool;
             Vector<VulkanCommandBuffer> _drawCommandBuffers;
             VkCommandBuffer _currentCommandBuffer;
+            mutable VkPipeline _boundPipeline;
+
+            // parallel recording state is changed by the const recording interface, same as the command buffers themselves
+            mutable Array<Vector<SecondaryCommandBuffer>, NumConcurrentFrames> _secondaryCommandBuffers;
+            mutable Array<UInt32, NumConcurrentFrames> _usedSecondariesCount;
+            mutable UInt32 _parallelRecordingFirstIndex;
+            mutable UInt32 _parallelRecordingCount;
+            mutable VulkanSecondaryRenderingParameters _secondaryRenderingParameters;
         };
         //--------------------------------------------------------------------------
     }
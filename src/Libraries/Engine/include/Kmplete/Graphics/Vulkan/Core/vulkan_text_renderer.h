@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/functional.h"
+#include "Kmplete/Graphics/graphics_base.h"
+#include "Kmplete/Graphics/text_renderer.h"
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_vertex_buffer.h"
+#include "Kmplete/Log/log_class_macro.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+
+#include <vulkan/vulkan.h>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        class VulkanGraphicsBackend;
+        class VulkanLogicalDevice;
+
+
+        //! Vulkan implementation of TextRenderer. Every frame in flight owns a host-visible vertex buffer that stays
+        //! mapped for the whole lifetime of the renderer, vertices of the frame are written directly into it,
+        //! the buffer grows (it is recreated) once the text of a frame does not fit into it anymore.
+        //! The vertex layout is Float2 position followed by Float2 UV (FontCharacterVertex)
+        //! @see TextRenderer, GlyphAtlas
+        class KMP_API VulkanTextRenderer : public TextRenderer
+        {
+            KMP_LOG_CLASSNAME(VulkanTextRenderer)
+            KMP_DISABLE_COPY_MOVE(VulkanTextRenderer)
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+
+        public:
+            static constexpr UInt64 DefaultVerticesCapacity = 4096 * VerticesPerGlyph;
+            static constexpr UInt32 VertexPositionLocation = 0;
+            static constexpr UInt32 VertexUVLocation = 1;
+
+        public:
+            VulkanTextRenderer(VulkanGraphicsBackend& graphicsBackend, GlyphAtlas& glyphAtlas, UInt64 verticesCapacity = DefaultVerticesCapacity);
+            ~VulkanTextRenderer() = default;
+
+            //! Uploads the pages of the glyph atlas modified during the frame and writes the vertices of the frame,
+            //! supposed to be called once all the text of the frame is added, outside of the rendering scope
+            bool Prepare();
+            //! Records one draw call per atlas page used in the frame, "bindPage" is called before each of them
+            //! to bind the descriptors of the page. The graphics pipeline should be bound already
+            void Render(UInt32 vertexBufferBinding, const Function<void(UInt32 page)>& bindPage) const;
+
+            //! @return vertex buffer of the current frame, its layout may be used for the pipeline creation
+            KMP_NODISCARD const VulkanVertexBuffer& GetVertexBuffer() const;
+
+        private:
+            KMP_NODISCARD UPtr<VulkanVertexBuffer> _CreateVertexBuffer(UInt64 verticesCapacity) const;
+
+        private:
+            VulkanGraphicsBackend& _graphicsBackend;
+            VulkanLogicalDevice& _logicalDevice;
+            Array<UPtr<VulkanVertexBuffer>, NumConcurrentFrames> _vertexBuffers;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -27,6 +27,7 @@ namespace Kmplete
             KMP_NODISCARD VkFormatProperties GetFormatProperties(VkFormat format) const;
             KMP_NODISCARD VkFormat FindImageFormat(const Vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features) const;
             KMP_NODISCARD bool IsMipmapCompatible(VkFormat format) const;
+            KMP_NODISCARD bool IsSampledImageCompatible(VkFormat format) const;
 
         private:
             VkPhysicalDevice _physicalDevice;
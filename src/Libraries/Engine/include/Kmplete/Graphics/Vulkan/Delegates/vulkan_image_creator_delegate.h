@@ -2,7 +2,7 @@
 
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/nullability.h"
-#include "Kmplete/Graphics/Vulkan/Delegates/vulkan_memory_type_delegate.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
 #include "Kmplete/Graphics/Vulkan/Texture/vulkan_image.h"
 #include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer.h"
 #include "Kmplete/Profile/profiler_fwd.h"
@@ -18,17 +18,17 @@ namespace Kmplete
 
 
         //! Helper delegate class for creating Vulkan images (raw VkImage or VulkanImage wrappers), 
-        //! image views and staging Vulkan buffers for texture creation, uses VulkanMemoryTypeDelegate object
-        //! for delegating memory properties requirements during staging buffer creation.
+        //! image views and staging Vulkan buffers for texture creation, uses VulkanMemoryAllocator object
+        //! for obtaining images and staging buffers memory.
         //! @see VulkanImage
-        //! @see VulkanMemoryTypeDelegate
+        //! @see VulkanMemoryAllocator
         class KMP_API VulkanImageCreatorDelegate
         {
             KMP_DISABLE_COPY_MOVE(VulkanImageCreatorDelegate)
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            VulkanImageCreatorDelegate(VkDevice device, const VulkanMemoryTypeDelegate& memoryTypeDelegate);
+            VulkanImageCreatorDelegate(VkDevice device, VulkanMemoryAllocator& memoryAllocator);
             ~VulkanImageCreatorDelegate() = default;
 
             KMP_NODISCARD VkImage CreateVkImage(const VkImageCreateInfo& creationParameters) const;
@@ -56,7 +56,7 @@ namespace Kmplete
             KMP_NODISCARD VulkanBuffer CreateStagingImageBuffer(const Image& image) const;
 
         private:
-            const VulkanMemoryTypeDelegate& _memoryTypeDelegate;
+            VulkanMemoryAllocator& _memoryAllocator;
 
             VkDevice _device;
         };
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/nullability.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_block.h"
+#include "Kmplete/Log/log_class_macro.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+
+#include <vulkan/vulkan.h>
+
+#include <mutex>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        struct VulkanContext;
+        class VulkanMemoryTypeDelegate;
+
+
+        //! Memory region handed out by VulkanMemoryAllocator, "block" is null for dedicated allocations
+        //! @see VulkanMemoryAllocator
+        struct VulkanMemoryAllocation
+        {
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0ULL;
+            VkDeviceSize size = 0ULL;
+            UInt32 memoryTypeIndex = 0;
+            Nullable<VulkanMemoryBlock*> block = nullptr;
+
+            KMP_NODISCARD bool IsValid() const noexcept { return memory != VK_NULL_HANDLE; }
+            KMP_NODISCARD bool IsDedicated() const noexcept { return block == nullptr; }
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Pooled device memory allocator, keeps a list of memory blocks per (memory type, strategy, resource kind)
+        //! and sub-allocates buffers and images from them instead of calling vkAllocateMemory per resource.
+        //! Buffers and images are kept in separate pools so that bufferImageGranularity never has to be respected.
+        //! Allocations larger than a half of a block, dedicated strategy requests and device address buffers
+        //! get their own VkDeviceMemory. All functions are thread-safe.
+        //! @see VulkanMemoryBlock, VulkanMemoryBlockStrategy
+        class KMP_API VulkanMemoryAllocator
+        {
+            KMP_DISABLE_COPY_MOVE(VulkanMemoryAllocator)
+            KMP_LOG_CLASSNAME(VulkanMemoryAllocator)
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+
+        public:
+            static constexpr VkDeviceSize DefaultBlockSize = 64ULL * 1024 * 1024;
+            static constexpr VkDeviceSize MinBlockSize = 1ULL * 1024 * 1024;
+
+            //! Per memory heap allocation statistics
+            struct HeapStatistics
+            {
+                UInt64 blocksCount = 0ULL;
+                UInt64 blocksBytes = 0ULL;
+                UInt64 subAllocationsCount = 0ULL;
+                UInt64 subAllocationsBytes = 0ULL;
+                UInt64 dedicatedAllocationsCount = 0ULL;
+                UInt64 dedicatedAllocationsBytes = 0ULL;
+            };
+
+        public:
+            VulkanMemoryAllocator(VkDevice device, const VulkanContext& vulkanContext, const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkDeviceSize preferredBlockSize = DefaultBlockSize);
+            ~VulkanMemoryAllocator();
+
+            KMP_NODISCARD VulkanMemoryAllocation AllocateBufferMemory(VkBuffer buffer, VkMemoryPropertyFlags properties, VulkanMemoryStrategy strategy, bool deviceAddress = false);
+            KMP_NODISCARD VulkanMemoryAllocation AllocateImageMemory(VkImage image, VkMemoryPropertyFlags properties, VulkanMemoryStrategy strategy);
+            void Free(VulkanMemoryAllocation& allocation);
+
+            VkResult Map(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset, void** data);
+            void Unmap(const VulkanMemoryAllocation& allocation);
+            VkResult Flush(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+            VkResult Invalidate(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+
+            KMP_NODISCARD Vector<HeapStatistics> GetHeapStatistics() const;
+            KMP_NODISCARD VkDeviceSize GetBlockSize(UInt32 memoryTypeIndex) const;
+
+        private:
+            using BlockList = Vector<UPtr<VulkanMemoryBlock>>;
+
+            KMP_NODISCARD VulkanMemoryAllocation _Allocate(const VkMemoryRequirements& requirements, UInt32 memoryTypeIndex, VulkanMemoryStrategy strategy, bool isImage, bool deviceAddress);
+            KMP_NODISCARD VulkanMemoryAllocation _AllocateDedicated(VkDeviceSize size, UInt32 memoryTypeIndex, bool deviceAddress);
+            KMP_NODISCARD bool _IsHostVisible(UInt32 memoryTypeIndex) const noexcept;
+            KMP_NODISCARD VkMappedMemoryRange _GetMappedRange(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const;
+            void _ReleaseEmptyBlock(const VulkanMemoryBlock* block);
+
+            KMP_NODISCARD static UInt64 _GetPoolKey(UInt32 memoryTypeIndex, VulkanMemoryStrategy strategy, bool isImage) noexcept;
+
+        private:
+            VkDevice _device;
+            const VulkanContext& _vulkanContext;
+            const VulkanMemoryTypeDelegate& _memoryTypeDelegate;
+            Vector<VkDeviceSize> _heapBlockSizes;
+
+            mutable std::mutex _mutex;
+            HashMap<UInt64, BlockList> _pools;
+            Vector<HeapStatistics> _dedicatedStatistics;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
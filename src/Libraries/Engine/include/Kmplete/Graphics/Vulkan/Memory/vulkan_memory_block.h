@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/optional.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_block_strategy.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+
+#include <vulkan/vulkan.h>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        //! Single VkDeviceMemory object shared by several resources, offsets within the block are
+        //! managed by the sub-allocation strategy. Host visible blocks are mapped once on first request
+        //! and stay mapped until destruction.
+        //! @see VulkanMemoryAllocator
+        class KMP_API VulkanMemoryBlock
+        {
+            KMP_DISABLE_COPY_MOVE(VulkanMemoryBlock)
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+
+        public:
+            VulkanMemoryBlock(VkDevice device, UInt32 memoryTypeIndex, VkDeviceSize size, VulkanMemoryStrategy strategy);
+            ~VulkanMemoryBlock();
+
+            KMP_NODISCARD Optional<VkDeviceSize> Allocate(VkDeviceSize size, VkDeviceSize alignment);
+            bool Free(VkDeviceSize offset);
+
+            KMP_NODISCARD void* Map();
+
+            KMP_NODISCARD VkDeviceMemory GetVkDeviceMemory() const noexcept;
+            KMP_NODISCARD UInt32 GetMemoryTypeIndex() const noexcept;
+            KMP_NODISCARD VkDeviceSize GetSize() const noexcept;
+            KMP_NODISCARD VkDeviceSize GetUsedSize() const noexcept;
+            KMP_NODISCARD UInt32 GetAllocationsCount() const noexcept;
+            KMP_NODISCARD VulkanMemoryStrategy GetStrategy() const noexcept;
+            KMP_NODISCARD bool IsEmpty() const noexcept;
+
+        private:
+            VkDevice _device;
+            VkDeviceMemory _memory;
+            UInt32 _memoryTypeIndex;
+            VulkanMemoryStrategy _strategyType;
+            UPtr<VulkanMemoryBlockStrategy> _strategy;
+            void* _mapped;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
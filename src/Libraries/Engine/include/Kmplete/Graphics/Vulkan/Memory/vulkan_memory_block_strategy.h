@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/optional.h"
+
+#include <vulkan/vulkan.h>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        //! Enumeration of the ways a resource's memory may be obtained from VulkanMemoryAllocator:
+        //! 1) "Dedicated" - separate vkAllocateMemory call for the resource
+        //! 2) "Linear" - bump-pointer sub-allocation, the block is reset when all of its allocations are freed
+        //! (best for short-living resources e.g. staging buffers)
+        //! 3) "Buddy" - power-of-two sub-allocation with buddy merging (best for power-of-two sized resources e.g. textures)
+        //! 4) "FreeList" - best-fit sub-allocation with free ranges coalescing (general purpose)
+        //! @see VulkanMemoryAllocator
+        enum class VulkanMemoryStrategy : UInt8
+        {
+            Dedicated = 0,
+            Linear,
+            Buddy,
+            FreeList
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Base class of a sub-allocation strategy, only deals with offsets within a memory block
+        //! of a given size, has no Vulkan memory objects by itself
+        //! @see VulkanMemoryBlock
+        class KMP_API VulkanMemoryBlockStrategy
+        {
+            KMP_DISABLE_COPY_MOVE(VulkanMemoryBlockStrategy)
+
+        public:
+            KMP_NODISCARD static UPtr<VulkanMemoryBlockStrategy> Create(VulkanMemoryStrategy strategy, VkDeviceSize blockSize);
+
+        public:
+            explicit VulkanMemoryBlockStrategy(VkDeviceSize blockSize) noexcept;
+            virtual ~VulkanMemoryBlockStrategy() = default;
+
+            KMP_NODISCARD virtual Optional<VkDeviceSize> Allocate(VkDeviceSize size, VkDeviceSize alignment) = 0;
+            virtual bool Free(VkDeviceSize offset) = 0;
+
+            KMP_NODISCARD VkDeviceSize GetBlockSize() const noexcept;
+            KMP_NODISCARD VkDeviceSize GetUsedSize() const noexcept;
+            KMP_NODISCARD UInt32 GetAllocationsCount() const noexcept;
+            KMP_NODISCARD bool IsEmpty() const noexcept;
+
+        protected:
+            const VkDeviceSize _blockSize;
+            VkDeviceSize _usedSize;
+            UInt32 _allocationsCount;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Bump-pointer strategy, the head is rolled back when the most recent allocation is freed
+        //! and reset completely when the block becomes empty
+        class KMP_API VulkanMemoryLinearStrategy : public VulkanMemoryBlockStrategy
+        {
+        public:
+            explicit VulkanMemoryLinearStrategy(VkDeviceSize blockSize);
+
+            KMP_NODISCARD Optional<VkDeviceSize> Allocate(VkDeviceSize size, VkDeviceSize alignment) override;
+            bool Free(VkDeviceSize offset) override;
+
+        private:
+            struct Allocation
+            {
+                VkDeviceSize previousHead;
+                VkDeviceSize size;
+            };
+
+        private:
+            VkDeviceSize _head;
+            HashMap<VkDeviceSize, Allocation> _allocations;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Binary buddy strategy, block size must be a power of 2 and not less than MinAllocationSize
+        class KMP_API VulkanMemoryBuddyStrategy : public VulkanMemoryBlockStrategy
+        {
+        public:
+            static constexpr VkDeviceSize MinAllocationSize = 256;
+
+        public:
+            explicit VulkanMemoryBuddyStrategy(VkDeviceSize blockSize);
+
+            KMP_NODISCARD Optional<VkDeviceSize> Allocate(VkDeviceSize size, VkDeviceSize alignment) override;
+            bool Free(VkDeviceSize offset) override;
+
+        private:
+            KMP_NODISCARD VkDeviceSize _GetOrderSize(UInt32 order) const noexcept;
+
+        private:
+            UInt32 _maxOrder;
+            Vector<Set<VkDeviceSize>> _freeLists;
+            HashMap<VkDeviceSize, UInt32> _allocations;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Best-fit free list strategy, alignment padding is attributed to the allocation
+        //! and adjacent free ranges are merged on deallocation
+        class KMP_API VulkanMemoryFreeListStrategy : public VulkanMemoryBlockStrategy
+        {
+        public:
+            explicit VulkanMemoryFreeListStrategy(VkDeviceSize blockSize);
+
+            KMP_NODISCARD Optional<VkDeviceSize> Allocate(VkDeviceSize size, VkDeviceSize alignment) override;
+            bool Free(VkDeviceSize offset) override;
+
+            KMP_NODISCARD size_t GetFreeRangesCount() const noexcept;
+
+        private:
+            struct Range
+            {
+                VkDeviceSize offset;
+                VkDeviceSize size;
+            };
+
+        private:
+            Map<VkDeviceSize, VkDeviceSize> _freeRanges;
+            HashMap<VkDeviceSize, Range> _allocations;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Graphics/Vulkan/Shader/vulkan_shader_module.h"
 #include "Kmplete/Log/log_class_macro.h"
 
 #include <vulkan/vulkan.h>
@@ -69,10 +70,17 @@ namespace Kmplete
             VulkanGraphicsPipelineParameters& AddVertexInputBindingsDivisors(const Vector<VkVertexInputBindingDivisorDescription>& inputBindingDivisorsDescriptions);
             VulkanGraphicsPipelineParameters& AddVertexAttributesDescriptions(const Vector<VkVertexInputAttributeDescription>& attributesDescriptions);
             VulkanGraphicsPipelineParameters& AddVertexBufferAttributesBindings(const VulkanVertexBuffer& vertexBuffer, UInt32 baseBinding);
-            VulkanGraphicsPipelineParameters& AddShaderStages(const Vector<VkPipelineShaderStageCreateInfo>& shaderStages);
+            VulkanGraphicsPipelineParameters& AddShaderStages(const Vector<VulkanShaderStage>& shaderStages);
 
             KMP_NODISCARD UInt32 GetColorAttachmentsCount() const noexcept;
 
+            //! Canonical byte representation of the whole pipeline state (shader stages, vertex input, blending, rasterization,
+            //! attachments formats etc.), parameters describe the same pipeline if and only if their keys are equal.
+            //! Shaders are represented by their SPIR-V code hashes instead of module handles, so the key is stable between runs
+            KMP_NODISCARD BinaryBuffer GetStateKey() const;
+            //! 64-bit hash of the state key
+            KMP_NODISCARD UInt64 GetHash() const;
+
         private:
             VulkanGraphicsPipelineParameters(const VulkanGraphicsPipelineParameters&) = default;
 
@@ -97,6 +105,7 @@ namespace Kmplete
             Vector<VkVertexInputBindingDivisorDescription> _vertexInputBindingsDivisors;
             Vector<VkVertexInputAttributeDescription> _vertexAttributesDescriptions;
             Vector<VkPipelineShaderStageCreateInfo> _shadersStages;
+            Vector<UInt64> _shadersCodeHashes;
             VkPipelineRenderingCreateInfoKHR _renderingCreateInfo;
             Vector<VkFormat> _renderingColorAttachmentsFormats;
         };
@@ -8,12 +8,17 @@
 
 #include <vulkan/vulkan.h>
 
+#include <mutex>
+
 
 namespace Kmplete
 {
     namespace Graphics
     {
-        //! Vulkan pipeline cache object wrapper
+        //! Vulkan pipeline cache object wrapper. The cache is loaded from the binary file at construction and
+        //! saved back to it at destruction, unless it is read-only or has an empty binary path (in-memory cache).
+        //! Saving writes a temporary file that is then renamed over the binary file, so an interrupted save
+        //! never leaves a truncated cache behind
         class KMP_API VulkanPipelineCache
         {
             KMP_DISABLE_COPY_MOVE(VulkanPipelineCache)
@@ -21,10 +26,18 @@ namespace Kmplete
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            VulkanPipelineCache(VkDevice device, const VulkanContext& context, const Filepath& binaryPath);
+            VulkanPipelineCache(VkDevice device, const VulkanContext& context, const Filepath& binaryPath, bool readOnly = false);
             ~VulkanPipelineCache();
 
+            //! Merges contents of the source caches into this cache, must not be called
+            //! while this cache is used by other threads
+            bool Merge(const Vector<VkPipelineCache>& sourceCaches);
+
+            //! May be called from a background thread, including while pipelines are being created with this cache
+            bool Save();
+
             KMP_NODISCARD VkPipelineCache GetVkPipelineCache() const noexcept;
+            KMP_NODISCARD const Filepath& GetBinaryPath() const noexcept;
 
         private:
             //! Vulkan cache header wrapper struct
@@ -41,7 +54,8 @@ namespace Kmplete
             void _Initialize();
             void _Finalize();
 
-            void _SerializeCache();
+            KMP_NODISCARD BinaryBuffer _LoadCacheBuffer() const;
+            KMP_NODISCARD BinaryBuffer _GetCacheData() const;
             void _DestroyCache();
 
             KMP_NODISCARD bool _LoadedCacheIsValid(const BinaryBuffer& cacheBuffer) const;
@@ -51,6 +65,8 @@ namespace Kmplete
             const VulkanContext& _context;
             VkPipelineCache _cache;
             Filepath _binaryPath;
+            const bool _readOnly;
+            std::mutex _saveMutex;
         };
         //--------------------------------------------------------------------------
     }
@@ -9,11 +9,14 @@
 #include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_graphics_pipeline_parameters.h"
 #include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_pipeline_cache.h"
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_context.h"
+#include "Kmplete/Core/thread_pool.h"
 #include "Kmplete/Log/log_class_macro.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 
 #include <vulkan/vulkan.h>
 
+#include <mutex>
+
 
 namespace Kmplete
 {
@@ -23,6 +26,14 @@ namespace Kmplete
 
 
         //! Manager of Vulkan pipeline objects, pipeline caches and pipeline layouts.
+        //! All pipelines are created with a single device-wide pipeline cache, which is saved to the file set by
+        //! SetDevicePipelineCachePath (in the background after every asynchronous compilation and at destruction).
+        //! Pipelines may be compiled asynchronously on worker threads, they are swapped in by ProcessCompiledPipelines
+        //! (called by the logical device at the start of every frame) and are not available until then.
+        //! Pipelines are content-addressed by the full state key of their parameters and layout sid (compared byte by byte
+        //! on hash match, so hash collisions never alias pipelines): sids registered with identical state share a single
+        //! VkPipeline object. Pipelines with caller-owned layouts (not added to the manager) are never shared, since such
+        //! a layout might be destroyed and its handle reused for another layout.
         //! @see VulkanGraphicsPipeline
         //! @see VulkanPipelineCache
         class KMP_API VulkanPipelineManager
@@ -31,6 +42,16 @@ namespace Kmplete
             KMP_LOG_CLASSNAME(VulkanPipelineManager)
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
+        public:
+            //! Description of a graphics pipeline for asynchronous compilation, the parameters are copied, but shader
+            //! modules and entry point names they refer to must stay valid until the pipeline is compiled
+            struct GraphicsPipelineCompileInfo
+            {
+                StringID pipelineSid;
+                StringID layoutSid;
+                const VulkanGraphicsPipelineParameters& parameters;
+            };
+
         public:
             VulkanPipelineManager(VkDevice device, const VulkanContext& context, const VulkanDescriptorSetManager& descriptorSetManager);
             ~VulkanPipelineManager();
@@ -39,6 +60,13 @@ namespace Kmplete
             bool AddPipelineLayout(StringID layoutSid, const Vector<VkDescriptorSetLayout>& descriptorSetLayouts, const Vector<VkPushConstantRange>& pushConstantRanges = {});
             KMP_NODISCARD VkPipelineLayout GetPipelineLayout(StringID layoutSid) const noexcept;
 
+            //! Loads the device-wide pipeline cache from the file (and keeps the contents of the current one),
+            //! the cache is saved to the same file afterwards
+            bool SetDevicePipelineCachePath(const Filepath& binaryPath);
+            bool SaveDevicePipelineCacheAsync();
+            KMP_NODISCARD VkPipelineCache GetDevicePipelineCache() const noexcept;
+
+            //! Merges a (legacy) per-pipeline cache file into the device-wide pipeline cache, the file is left untouched
             bool AddPipelineCache(StringID pipelineSid, const Filepath& binaryPath);
 
             bool AddGraphicsPipeline(StringID pipelineSid, StringID layoutSid, const VulkanGraphicsPipelineParameters& parameters, const Filepath& cacheBinaryPath);
@@ -47,13 +75,56 @@ namespace Kmplete
             bool AddGraphicsPipeline(StringID pipelineSid, VkPipelineLayout layout, const VulkanGraphicsPipelineParameters& parameters);
             KMP_NODISCARD OptionalRef<VulkanGraphicsPipeline> GetGraphicsPipeline(StringID pipelineSid) const;
 
+            //! Pipelines with the state of an already compiled pipeline are ready at once, pipelines with the state of
+            //! a pending one are swapped in together with it
+            //! @return number of pipelines accepted for compilation
+            UInt32 CompileGraphicsPipelinesAsync(const Vector<GraphicsPipelineCompileInfo>& compileInfos);
+            //! Swaps compiled pipelines in, must be called from the thread that uses the pipelines
+            //! @return number of pipelines swapped in
+            UInt32 ProcessCompiledPipelines();
+            //! Blocks until every submitted pipeline is compiled and swaps them in
+            //! @return number of pipelines swapped in
+            UInt32 WaitCompiledPipelines();
+            KMP_NODISCARD bool IsGraphicsPipelineReady(StringID pipelineSid) const noexcept;
+            KMP_NODISCARD UInt32 GetPendingPipelinesCount() const noexcept;
+
+        private:
+            //! Result of an asynchronous compilation, the pipeline is null if compilation failed
+            struct CompiledPipeline
+            {
+                BinaryBuffer stateKey;
+                UPtr<VulkanGraphicsPipeline> pipeline;
+            };
+
+            //! Hasher struct to store pipeline state keys in hash maps
+            struct StateKeyHash
+            {
+                std::size_t operator()(const BinaryBuffer& stateKey) const noexcept;
+            };
+
+        private:
+            void _CompileGraphicsPipeline(StringID pipelineSid, BinaryBuffer stateKey, VkPipelineLayout layout, const VulkanGraphicsPipelineParameters& parameters);
+            void _WaitCompilation();
+
+            KMP_NODISCARD Optional<StringID> _GetPipelineLayoutSid(VkPipelineLayout layout) const noexcept;
+            KMP_NODISCARD static BinaryBuffer _GetPipelineStateKey(StringID layoutSid, const VulkanGraphicsPipelineParameters& parameters);
+
         private:
             VkDevice _device;
             const VulkanContext& _context;
             const VulkanDescriptorSetManager& _descriptorSetManager;
             StringIDHashMap<VkPipelineLayout> _layouts;
-            StringIDHashMap<UPtr<VulkanGraphicsPipeline>> _pipelines;
-            StringIDHashMap<UPtr<VulkanPipelineCache>> _pipelineCaches;
+            HashMap<BinaryBuffer, UPtr<VulkanGraphicsPipeline>, StateKeyHash> _pipelineStates;
+            StringIDHashMap<UPtr<VulkanGraphicsPipeline>> _externalLayoutPipelines;
+            StringIDHashMap<VulkanGraphicsPipeline*> _pipelines;
+            UPtr<VulkanPipelineCache> _deviceCache;
+            HashSet<StringID> _mergedPipelineCaches;
+
+            UPtr<ThreadPool> _compilePool;
+            std::mutex _compileMutex;
+            Vector<CompiledPipeline> _compiledPipelines;
+            HashSet<StringID> _pendingPipelines;
+            HashMap<BinaryBuffer, Vector<StringID>, StateKeyHash> _pendingStates;
         };
         //--------------------------------------------------------------------------
     }
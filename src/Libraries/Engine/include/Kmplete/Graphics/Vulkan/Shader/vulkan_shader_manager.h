@@ -49,7 +49,7 @@ namespace Kmplete
             OptionalRef<VulkanShaderModule> AddShaderModuleFromBinaryCode(StringID moduleSid, const BinaryBuffer32& shaderBinary);
 
             KMP_NODISCARD OptionalRef<VulkanShaderModule> GetShaderModule(StringID moduleSid) const noexcept;
-            KMP_NODISCARD Vector<VkPipelineShaderStageCreateInfo> GetShaderStageCreateInfos(const Vector<ShaderStageInfoParameters>& shaderModulesParameters) const noexcept;
+            KMP_NODISCARD Vector<VulkanShaderStage> GetShaderStages(const Vector<ShaderStageInfoParameters>& shaderModulesParameters) const noexcept;
 
             bool AddShaderObject(const ShaderLoadParameters& parameters, VkShaderStageFlagBits stage, VkShaderStageFlags nextStage, bool linked,
                                  const Vector<StringID>& descriptorSetsLayouts, const char* name = "main");
@@ -13,6 +13,16 @@ namespace Kmplete
 {
     namespace Graphics
     {
+        //! Shader stage description for pipeline creation, the code hash identifies the shader
+        //! by its SPIR-V content (module handles may be reused by the driver after destruction)
+        struct VulkanShaderStage
+        {
+            VkPipelineShaderStageCreateInfo createInfo;
+            UInt64 codeHash;
+        };
+        //--------------------------------------------------------------------------
+
+
         //! Simple Vulkan API shader module wrapper
         class KMP_API VulkanShaderModule
         {
@@ -28,6 +38,8 @@ namespace Kmplete
             ~VulkanShaderModule();
 
             KMP_NODISCARD VkPipelineShaderStageCreateInfo GetShaderStageCreateInfo(VkShaderStageFlagBits stage, const char* entryPointName = "main") const noexcept;
+            KMP_NODISCARD VulkanShaderStage GetShaderStage(VkShaderStageFlagBits stage, const char* entryPointName = "main") const noexcept;
+            KMP_NODISCARD UInt64 GetCodeHash() const noexcept;
 
         private:
             void _Initialize(const Filepath& filepathBinary);
@@ -37,6 +49,7 @@ namespace Kmplete
         private:
             VkDevice _device;
             VkShaderModule _shaderModule;
+            UInt64 _codeHash;
         };
         //--------------------------------------------------------------------------
 
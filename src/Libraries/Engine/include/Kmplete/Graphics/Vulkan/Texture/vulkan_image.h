@@ -3,6 +3,8 @@
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/types_aliases.h"
 #include "Kmplete/Base/type_traits.h"
+#include "Kmplete/Base/nullability.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
 #include "Kmplete/Log/log_class_macro.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 
@@ -13,10 +15,8 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        class VulkanMemoryTypeDelegate;
-
-
-        //! Vulkan API image object wrapper
+        //! Vulkan API image object wrapper, image memory is obtained from VulkanMemoryAllocator
+        //! @see VulkanMemoryAllocator
         class KMP_API VulkanImage
         {
             KMP_DISABLE_COPY(VulkanImage)
@@ -24,7 +24,8 @@ namespace Kmplete
             KMP_PROFILE_CONSTRUCTOR_DECLARE()
 
         public:
-            VulkanImage(VkDevice device, const VkImageCreateInfo& creationParameters, const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkMemoryPropertyFlags memoryProperties);
+            VulkanImage(VkDevice device, const VkImageCreateInfo& creationParameters, VulkanMemoryAllocator& memoryAllocator, VkMemoryPropertyFlags memoryProperties,
+                        VulkanMemoryStrategy memoryStrategy = VulkanMemoryStrategy::FreeList);
             VulkanImage(VulkanImage&& other) noexcept;
             VulkanImage& operator=(VulkanImage&& other) noexcept;
             ~VulkanImage();
@@ -35,13 +36,14 @@ namespace Kmplete
             KMP_NODISCARD VkSampleCountFlagBits GetSamples() const noexcept;
 
         private:
-            void _Initialize(const VkImageCreateInfo& creationParameters, const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkMemoryPropertyFlags memoryProperties);
+            void _Initialize(const VkImageCreateInfo& creationParameters, VkMemoryPropertyFlags memoryProperties, VulkanMemoryStrategy memoryStrategy);
             void _Finalize();
 
         private:
             VkDevice _device;
             VkImage _image;
-            VkDeviceMemory _imageMemory;
+            Nullable<VulkanMemoryAllocator*> _memoryAllocator;
+            VulkanMemoryAllocation _allocation;
             VkDeviceSize _memorySize;
             VkFormat _format;
             VkSampleCountFlagBits _samples;
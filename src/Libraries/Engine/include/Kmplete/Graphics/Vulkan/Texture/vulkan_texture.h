@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/nullability.h"
 #include "Kmplete/Graphics/texture.h"
 #include "Kmplete/Graphics/Vulkan/Texture/vulkan_texture_base.h"
 #include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer.h"
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_upload_context.h"
 #include "Kmplete/Log/log_class_macro.h"
 #include "Kmplete/Profile/profiler_fwd.h"
 
@@ -20,6 +23,10 @@ namespace Kmplete
         //! Vulkan plain texture implementation. Such textures intended to be
         //! used in shaders, i.e. everything that user sees directly (albedo texture)
         //! or indirectly (normal maps, height maps, etc.)
+        //! Mip levels are either generated on the GPU from the base level by blits or, if every level
+        //! is already present in the staging buffer (see Assets::TexturePayloadHeader), copied as is.
+        //! Since the upload commands are only recorded into a batch of VulkanUploadContext, the texture keeps the ticket
+        //! of the last batch that uses it and waits for that batch at destruction
         class KMP_API VulkanTexture : public Texture, public VulkanTextureBase
         {
             KMP_DISABLE_COPY_MOVE(VulkanTexture)
@@ -28,14 +35,30 @@ namespace Kmplete
 
         public:
             VulkanTexture(VkImageType imageType, VkFormat format, UInt32 mipLevels, VkDevice device, VkCommandBuffer commandBuffer, 
-                          const VulkanBuffer& stagingBuffer, const VkExtent3D& extent, const VulkanImageCreatorDelegate& imageCreatorDelegate);
-            ~VulkanTexture() = default;
+                          VkBuffer stagingBuffer, VkDeviceSize stagingOffset, const VkExtent3D& extent, const VulkanImageCreatorDelegate& imageCreatorDelegate);
+            //! @param mipRegions copy regions of every mip level within the staging buffer, starting from the base level
+            VulkanTexture(VkImageType imageType, VkFormat format, VkDevice device, VkCommandBuffer commandBuffer,
+                          VkBuffer stagingBuffer, const Vector<VkBufferImageCopy>& mipRegions, const VulkanImageCreatorDelegate& imageCreatorDelegate);
+            ~VulkanTexture();
+
+            //! Tickets are expected to be set in the order of the uploads, so the last one covers all the previous
+            void SetUploadTicket(VulkanUploadContext& uploadContext, VulkanUploadTicket uploadTicket) noexcept;
+
+            //! Records the copy of a staging buffer region into the base level, the texture is expected
+            //! to be in the shader read layout and is returned to it afterwards
+            void UpdateRegion(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset, const VkOffset3D& offset, const VkExtent3D& extent);
 
         private:
             void _TransitionImageLayout(UInt32 mipLevels, VkCommandBuffer commandBuffer);
-            void _CopyStagingBufferToImage(const VulkanBuffer& stagingBuffer, const VkExtent3D& extent, VkCommandBuffer commandBuffer);
+            void _CopyStagingBufferToImage(VkBuffer stagingBuffer, VkDeviceSize stagingOffset, const VkExtent3D& extent, VkCommandBuffer commandBuffer);
+            void _CopyStagingBufferToImage(VkBuffer stagingBuffer, const Vector<VkBufferImageCopy>& mipRegions, VkCommandBuffer commandBuffer);
+            void _TransitionToShaderReadLayout(UInt32 mipLevels, VkCommandBuffer commandBuffer);
             void _GenerateMipmaps(const VkExtent3D& extent, UInt32 mipLevels, VkCommandBuffer commandBuffer);
             void _GenerateMipmapLevel(VkImageMemoryBarrier& imageBarrier, UInt32 mipLevel, Int32& mipWidth, Int32& mipHeight, VkImage image, VkCommandBuffer commandBuffer);
+
+        private:
+            Nullable<VulkanUploadContext*> _uploadContext;
+            VulkanUploadTicket _uploadTicket;
         };
         //--------------------------------------------------------------------------
     }
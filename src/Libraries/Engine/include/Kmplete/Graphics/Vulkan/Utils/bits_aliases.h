@@ -151,6 +151,14 @@ namespace Kmplete
             static constexpr auto VK_DescriptorPoolCreate_FreeDescriptorSet = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
             static constexpr auto VK_DescriptorPoolCreate_UpdateAfterBind = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
 
+            static constexpr auto VK_DescriptorSetLayoutCreate_UpdateAfterBindPool = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+
+            static constexpr auto VK_DescriptorBinding_UpdateAfterBind = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+            static constexpr auto VK_DescriptorBinding_UpdateUnusedWhilePending = VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+            static constexpr auto VK_DescriptorBinding_PartiallyBound = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+            static constexpr auto VK_DescriptorUpdateTemplate_DescriptorSet = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+
             static constexpr auto VK_Color_R = VK_COLOR_COMPONENT_R_BIT;
             static constexpr auto VK_Color_G = VK_COLOR_COMPONENT_G_BIT;
             static constexpr auto VK_Color_B = VK_COLOR_COMPONENT_B_BIT;
@@ -227,6 +235,8 @@ namespace Kmplete
             static constexpr auto VK_CommandBufferUsage_RenderPassContinue = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
             static constexpr auto VK_CommandBufferUsage_SimultaneousUse = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
 
+            static constexpr auto VK_RenderingContents_SecondaryCommandBuffers = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT;
+
             static constexpr auto VK_SampleCount_1 = VK_SAMPLE_COUNT_1_BIT;
             static constexpr auto VK_SampleCount_2 = VK_SAMPLE_COUNT_2_BIT;
             static constexpr auto VK_SampleCount_4 = VK_SAMPLE_COUNT_4_BIT;
@@ -379,6 +389,14 @@ namespace Kmplete
             static constexpr auto VK_Format_D16_UNorm_S8_UInt = VK_FORMAT_D16_UNORM_S8_UINT;
             static constexpr auto VK_Format_D24_UNorm_S8_UInt = VK_FORMAT_D24_UNORM_S8_UINT;
             static constexpr auto VK_Format_D32_SFloat_S8_UInt = VK_FORMAT_D32_SFLOAT_S8_UINT;
+            static constexpr auto VK_Format_BC1_RGBA_UNorm_Block = VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+            static constexpr auto VK_Format_BC1_RGBA_SRGB_Block = VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+            static constexpr auto VK_Format_BC3_UNorm_Block = VK_FORMAT_BC3_UNORM_BLOCK;
+            static constexpr auto VK_Format_BC3_SRGB_Block = VK_FORMAT_BC3_SRGB_BLOCK;
+            static constexpr auto VK_Format_BC4_UNorm_Block = VK_FORMAT_BC4_UNORM_BLOCK;
+            static constexpr auto VK_Format_BC5_UNorm_Block = VK_FORMAT_BC5_UNORM_BLOCK;
+            static constexpr auto VK_Format_BC7_UNorm_Block = VK_FORMAT_BC7_UNORM_BLOCK;
+            static constexpr auto VK_Format_BC7_SRGB_Block = VK_FORMAT_BC7_SRGB_BLOCK;
 
             static constexpr auto VK_DebugUtilsMessageSeverity_Verbose = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
             static constexpr auto VK_DebugUtilsMessageSeverity_Info = VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
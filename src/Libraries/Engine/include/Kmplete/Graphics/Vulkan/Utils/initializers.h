@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
 
 #include <vulkan/vulkan.h>
 
@@ -21,6 +22,7 @@ namespace Kmplete
             KMP_NODISCARD KMP_API VkPhysicalDeviceVulkan11Properties InitVkPhysicalDeviceVulkan11Properties();
             KMP_NODISCARD KMP_API VkPhysicalDeviceVulkan12Properties InitVkPhysicalDeviceVulkan12Properties();
             KMP_NODISCARD KMP_API VkPhysicalDeviceFeatures2 InitVkPhysicalDeviceFeatures2();
+            KMP_NODISCARD KMP_API VkPhysicalDeviceVulkan12Features InitVkPhysicalDeviceVulkan12Features();
             KMP_NODISCARD KMP_API VkPhysicalDeviceVulkan13Features InitVkPhysicalDeviceVulkan13Features();
             KMP_NODISCARD KMP_API VkPhysicalDeviceExtendedDynamicState2FeaturesEXT InitVkPhysicalDeviceExtendedDynamicState2FeaturesEXT();
             KMP_NODISCARD KMP_API VkPhysicalDeviceExtendedDynamicState3FeaturesEXT InitVkPhysicalDeviceExtendedDynamicState3FeaturesEXT();
@@ -35,8 +37,13 @@ namespace Kmplete
 
             KMP_NODISCARD KMP_API VkDeviceCreateInfo InitVkDeviceCreateInfo();
             KMP_NODISCARD KMP_API VkSemaphoreCreateInfo InitVkSemaphoreCreateInfo();
+            KMP_NODISCARD KMP_API VkSemaphoreTypeCreateInfo InitVkSemaphoreTypeCreateInfo(VkSemaphoreType type, UInt64 initialValue);
+            KMP_NODISCARD KMP_API VkSemaphoreWaitInfo InitVkSemaphoreWaitInfo();
+            KMP_NODISCARD KMP_API VkTimelineSemaphoreSubmitInfo InitVkTimelineSemaphoreSubmitInfo();
             KMP_NODISCARD KMP_API VkCommandBufferAllocateInfo InitVkCommandBufferAllocateInfo(bool primary = true);
             KMP_NODISCARD KMP_API VkCommandBufferBeginInfo InitVkCommandBufferBeginInfo();
+            KMP_NODISCARD KMP_API VkCommandBufferInheritanceInfo InitVkCommandBufferInheritanceInfo();
+            KMP_NODISCARD KMP_API VkCommandBufferInheritanceRenderingInfo InitVkCommandBufferInheritanceRenderingInfo();
             KMP_NODISCARD KMP_API VkFenceCreateInfo InitVkFenceCreateInfo(bool signaled = true);
             KMP_NODISCARD KMP_API VkDescriptorPoolCreateInfo InitVkDescriptorPoolCreateInfo();
             KMP_NODISCARD KMP_API VkDeviceQueueCreateInfo InitVkDeviceQueueCreateInfo();
@@ -47,8 +54,10 @@ namespace Kmplete
             KMP_NODISCARD KMP_API VkRenderingAttachmentInfo InitVkRenderingAttachmentInfo();
             KMP_NODISCARD KMP_API VkRenderingInfo InitVkRenderingInfo();
             KMP_NODISCARD KMP_API VkDescriptorSetLayoutCreateInfo InitVkDescriptorSetLayoutCreateInfo();
+            KMP_NODISCARD KMP_API VkDescriptorSetLayoutBindingFlagsCreateInfo InitVkDescriptorSetLayoutBindingFlagsCreateInfo();
             KMP_NODISCARD KMP_API VkDescriptorSetAllocateInfo InitVkDescriptorSetAllocateInfo();
             KMP_NODISCARD KMP_API VkWriteDescriptorSet InitVkWriteDescriptorSet();
+            KMP_NODISCARD KMP_API VkDescriptorUpdateTemplateCreateInfo InitVkDescriptorUpdateTemplateCreateInfo();
 
             KMP_NODISCARD KMP_API VkPipelineLayoutCreateInfo InitVkPipelineLayoutCreateInfo();
             KMP_NODISCARD KMP_API VkPipelineCacheCreateInfo InitVkPipelineCacheCreateInfo();
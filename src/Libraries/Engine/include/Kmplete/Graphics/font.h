@@ -69,6 +69,8 @@ namespace Kmplete
             KMP_NODISCARD const BinaryBuffer& GetBuffer() const noexcept;
             KMP_NODISCARD const Parameters& GetParameters() const noexcept;
             KMP_NODISCARD bool HasStyle(Parameters::Style flag) const noexcept;
+            //! @return horizontal kerning of the pair at the current size in 26.6 fixed point, zero if the font has no kerning
+            KMP_NODISCARD Int32 GetKerning(UInt32 leftCodepoint, UInt32 rightCodepoint) const;
 
             //TODO: remove
             KMP_NODISCARD FT_FaceRec_* GetFtFace() const { return _freetypeFace; }
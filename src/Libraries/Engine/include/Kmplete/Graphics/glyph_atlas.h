@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/nullability.h"
+#include "Kmplete/Graphics/graphics_base.h"
+#include "Kmplete/Graphics/font_character.h"
+#include "Kmplete/Log/log_class_macro.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        class Font;
+        class Texture;
+        class GraphicsBackend;
+
+
+        //! Dynamic atlas of glyphs rasterized from a single font. Every glyph is rasterized once, on its first request for
+        //! the given pixel size, and packed by a shelf packer into square power-of-two pages of single-channel texels,
+        //! a new page is started once the glyph fits none of the existing ones. Pages track the region modified since
+        //! the last upload, so only the glyphs added meanwhile are copied to the GPU.
+        //! Glyphs of codepoints below FlatLookupSize are found through a flat table, the others through a hash map.
+        //! UV coordinates of FontCharacter are relative to the page of the glyph. An empty atlas may instead be filled
+        //! with glyphs baked offline by AssetsCompiler (see LoadBaked), then no glyph of the baked set is rasterized. Not thread-safe
+        //! @see Font, FontCharacter
+        class KMP_API GlyphAtlas
+        {
+            KMP_LOG_CLASSNAME(GlyphAtlas)
+            KMP_DISABLE_COPY_MOVE(GlyphAtlas)
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+
+        public:
+            //! Covers Basic Latin, Latin-1, Latin Extended, Greek and Cyrillic
+            static constexpr UInt32 FlatLookupSize = 0x0530;
+
+            struct Parameters
+            {
+                UInt32 pageSize = 1024;
+                UInt32 maxPages = 8;
+                UInt32 padding = 1;
+                bool sdf = true;
+            };
+
+            struct Glyph
+            {
+                FontCharacter character = {};
+                UInt32 page = 0;
+            };
+
+        public:
+            GlyphAtlas(Font& font, const Parameters& parameters);
+            ~GlyphAtlas();
+
+            //! @return glyph of the codepoint rasterizing it on the first request, nullptr if the font can not
+            //! render the codepoint or there is no room left for it. The pointer is valid until the next glyph is added
+            KMP_NODISCARD Nullable<const Glyph*> GetGlyph(UInt32 codepoint, UInt8 pixelSize);
+            //! @return number of the codepoints available in the atlas afterwards
+            UInt64 AddGlyphs(Span<const UInt32> codepoints, UInt8 pixelSize);
+            //! Fills an empty atlas with the pages and glyphs of a baked font atlas payload (AssetType::FontAtlas).
+            //! The page size is taken from the payload and the SDF mode is enabled, baked pages are considered full,
+            //! so glyphs requested later are rasterized into new pages. Baked glyphs are available for the pixel size
+            //! of the payload only, other sizes are reached by scaling the distance fields
+            //! @return false if the atlas is not empty or the payload is malformed
+            //! @see Assets::FontAtlasPayloadHeader
+            KMP_NODISCARD bool LoadBaked(BinaryView payload);
+
+            //! @return horizontal kerning of the pair in 26.6 fixed point, the same units as FontCharacter::advance
+            KMP_NODISCARD Int32 GetKerning(UInt32 leftCodepoint, UInt32 rightCodepoint, UInt8 pixelSize);
+            //! @return distance between baselines of two consecutive lines in pixels
+            KMP_NODISCARD Int32 GetLineHeight(UInt8 pixelSize);
+
+            KMP_NODISCARD const Font& GetFont() const noexcept;
+            KMP_NODISCARD const Parameters& GetParameters() const noexcept;
+            KMP_NODISCARD UInt64 GetGlyphsCount() const noexcept;
+
+            KMP_NODISCARD UInt32 GetPagesCount() const noexcept;
+            KMP_NODISCARD BinaryView GetPagePixels(UInt32 page) const;
+            KMP_NODISCARD bool IsPageDirty(UInt32 page) const;
+            KMP_NODISCARD const TextureRegion& GetPageDirtyRegion(UInt32 page) const;
+
+            //! Creates textures of the pages added since the last call and copies dirty regions into the existing ones
+            //! @return false if any of the pages failed to upload, such pages stay dirty
+            bool Upload(GraphicsBackend& graphicsBackend);
+            KMP_NODISCARD Nullable<Texture*> GetPageTexture(UInt32 page) const;
+
+        private:
+            static constexpr UInt32 FailedGlyphSlot = UInt32(-1);
+            static constexpr UInt32 ShelfHeightGranularity = 4;
+
+            //! Row of glyphs of similar height, glyphs are appended to the right until the page width is exhausted
+            struct Shelf
+            {
+                UInt32 y = 0;
+                UInt32 height = 0;
+                UInt32 width = 0;
+            };
+
+            struct Page
+            {
+                BinaryBuffer pixels;
+                Vector<Shelf> shelves;
+                TextureRegion dirtyRegion;
+                UPtr<Texture> texture;
+            };
+
+            //! Values are glyph indices incremented by one, so zero marks a codepoint that has not been requested yet
+            struct SizeLookup
+            {
+                Vector<UInt32> flat;
+                HashMap<UInt32, UInt32> extended;
+            };
+
+        private:
+            KMP_NODISCARD UInt32& _GetLookupSlot(UInt32 codepoint, UInt8 pixelSize);
+            KMP_NODISCARD bool _SetPixelSize(UInt8 pixelSize);
+            KMP_NODISCARD bool _RasterizeGlyph(UInt32 codepoint, UInt8 pixelSize, Glyph& glyph);
+            KMP_NODISCARD bool _PackRectangle(UInt32 width, UInt32 height, UInt32& page, UInt32& x, UInt32& y);
+            KMP_NODISCARD bool _PackRectangleIntoPage(Page& page, UInt32 width, UInt32 height, UInt32& x, UInt32& y) const;
+            void _AddPage();
+            KMP_NODISCARD bool _UploadDirtyRegion(Page& page, GraphicsBackend& graphicsBackend);
+
+        private:
+            Font& _font;
+            Parameters _parameters;
+            Vector<Glyph> _glyphs;
+            Vector<Page> _pages;
+            Vector<SizeLookup> _sizeLookups;
+            BinaryBuffer _regionBuffer;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
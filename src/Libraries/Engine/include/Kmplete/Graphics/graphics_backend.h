@@ -55,6 +55,17 @@ namespace Kmplete
 
             KMP_NODISCARD virtual Nullable<Texture*> CreateTexture(const Filepath& filepath, Assets::TextureSubTypeMaskBits subTypeMask, bool flipVertically = false);
             KMP_NODISCARD virtual Nullable<Texture*> CreateTexture(const Image& image, Assets::TextureSubTypeMaskBits subTypeMask) = 0;
+            KMP_NODISCARD virtual Nullable<Texture*> CreateTexture(BinaryView texturePayload, Assets::TextureSubTypeMaskBits subTypeMask) = 0;
+            //! Overwrites a region of the texture's base level, "pixels" are tightly packed rows of the region in the texture's format.
+            //! Other mip levels are not regenerated, so the function is intended for textures created without mipmaps
+            virtual bool UpdateTexture(Texture& texture, BinaryView pixels, const TextureRegion& region) = 0;
+
+            //! @return size of the bindless textures array that shaders index into, zero if the backend has the bindless mode disabled
+            KMP_NODISCARD virtual UInt32 GetBindlessTexturesCount() const = 0;
+            //! Points the slot "index" of the bindless textures array to the texture. The slot must not be used by frames in flight
+            virtual bool SetBindlessTexture(UInt32 index, const Texture& texture) = 0;
+
+            KMP_NODISCARD virtual GraphicsMemoryUsage QueryMemoryUsage() = 0;
 
             KMP_NODISCARD virtual UInt32 GetMultisampling() const = 0;
             virtual void SetMultisampling(UInt32 samples) = 0;
@@ -38,6 +38,27 @@ namespace Kmplete
         //--------------------------------------------------------------------------
 
 
+        //! Memory usage reported by the graphics API for all memory heaps together, "budget" is the amount
+        //! the application can use without a performance penalty (may change over time)
+        struct GraphicsMemoryUsage
+        {
+            UInt64 budget = 0ULL;
+            UInt64 usage = 0ULL;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Rectangular area of a texture's base level in texels, "x" and "y" are the offsets of its top-left corner
+        struct TextureRegion
+        {
+            UInt32 x = 0;
+            UInt32 y = 0;
+            UInt32 width = 0;
+            UInt32 height = 0;
+        };
+        //--------------------------------------------------------------------------
+
+
         //! Global constant value for number of buffers (or concurrent frames) used
         //! during rendering (1 buffer/frame is used for presentation and other(s) are used
         //! for rendering)
@@ -3,6 +3,7 @@
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/pointers.h"
 #include "Kmplete/Base/nullability.h"
+#include "Kmplete/Graphics/graphics_base.h"
 #include "Kmplete/Graphics/command_pool.h"
 #include "Kmplete/Graphics/swapchain.h"
 #include "Kmplete/Graphics/graphics_chain_unit.h"
@@ -32,6 +33,11 @@ namespace Kmplete
             KMP_NODISCARD virtual const Swapchain& GetSwapchain() const noexcept = 0;
 
             KMP_NODISCARD virtual Nullable<Texture*> CreateTexture(const Image& image, Assets::TextureSubTypeMaskBits subTypeMask) const = 0;
+            KMP_NODISCARD virtual Nullable<Texture*> CreateTexture(BinaryView texturePayload, Assets::TextureSubTypeMaskBits subTypeMask) const = 0;
+            virtual bool UpdateTexture(Texture& texture, BinaryView pixels, const TextureRegion& region) const = 0;
+
+            KMP_NODISCARD virtual UInt32 GetBindlessTexturesCount() const = 0;
+            virtual bool SetBindlessTexture(UInt32 index, const Texture& texture) const = 0;
         };
         //--------------------------------------------------------------------------
     }
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/string_id.h"
+#include "Kmplete/Graphics/font_character.h"
+#include "Kmplete/Math/geometry.h"
+#include "Kmplete/Log/log_class_macro.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        class GlyphAtlas;
+
+
+        //! Range of vertices of a frame that are sampled from the same glyph atlas page,
+        //! so the whole range is rendered by a single draw call
+        struct TextDrawBatch
+        {
+            UInt32 page = 0;
+            UInt32 firstVertex = 0;
+            UInt32 vertexCount = 0;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Backend-agnostic batcher of the text rendered in a frame. UTF-8 strings are laid out with advances and kerning
+        //! provided by the font of the glyph atlas, layouts are cached by the string and its pixel size, so only the strings
+        //! that were not rendered recently are laid out again. Glyph quads of the whole frame are grouped by atlas page,
+        //! which makes the number of draw calls equal to the number of pages used in the frame.
+        //! Positions are given in pixels from the top-left corner of the viewport with the Y axis pointing down and refer
+        //! to the baseline of the first line, vertices are produced in normalized device coordinates
+        //! @see GlyphAtlas, TextDrawBatch
+        class KMP_API TextRenderer
+        {
+            KMP_LOG_CLASSNAME(TextRenderer)
+            KMP_DISABLE_COPY_MOVE(TextRenderer)
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+
+        public:
+            static constexpr UInt32 VerticesPerGlyph = 6;
+            //! Layouts that were not used for this number of frames are evicted from the cache
+            static constexpr UInt64 DefaultLayoutLifetimeFrames = 120;
+
+        public:
+            explicit TextRenderer(GlyphAtlas& glyphAtlas);
+            virtual ~TextRenderer() = default;
+
+            //! Discards the text of the previous frame, viewport size is used for the conversion to NDC
+            void BeginFrame(const Math::Size2I& viewportSize);
+            void AddText(const String& text, const Math::Vec2F& position, UInt8 pixelSize, float scale = 1.0f);
+
+            KMP_NODISCARD UInt64 GetVerticesCount() const noexcept;
+            //! Writes vertices of the frame grouped by atlas page and fills the batches accordingly
+            //! @return number of vertices written, zero if the destination is smaller than GetVerticesCount()
+            UInt64 WriteVertices(Span<FontCharacterVertex> vertices);
+            KMP_NODISCARD const Vector<TextDrawBatch>& GetBatches() const noexcept;
+
+            KMP_NODISCARD GlyphAtlas& GetGlyphAtlas() noexcept;
+            KMP_NODISCARD UInt64 GetCachedLayoutsCount() const noexcept;
+
+        protected:
+            GlyphAtlas& _glyphAtlas;
+
+        private:
+            //! Glyph rectangle relative to the pen position at the start of the text, in pixels
+            struct LayoutQuad
+            {
+                Math::Vec2F min;
+                Math::Vec2F max;
+                Math::Vec2F uvMin;
+                Math::Vec2F uvMax;
+                UInt32 page = 0;
+            };
+
+            struct Layout
+            {
+                String text;
+                UInt8 pixelSize = 0;
+                UInt64 lastUsedFrame = 0;
+                Vector<LayoutQuad> quads;
+            };
+
+        private:
+            KMP_NODISCARD const Layout& _GetLayout(const String& text, UInt8 pixelSize);
+            void _BuildLayout(Layout& layout);
+            void _EvictUnusedLayouts();
+
+        private:
+            Math::Vec2F _viewportSize;
+            UInt64 _frameIndex;
+            UInt64 _verticesCount;
+            StringIDHashMap<Layout> _layouts;
+            Vector<Vector<FontCharacterVertex>> _pageVertices;
+            Vector<TextDrawBatch> _batches;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
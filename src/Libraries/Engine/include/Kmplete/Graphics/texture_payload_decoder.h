@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Assets/assets_interface.h"
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        static constexpr UInt32 TextureBlockPixelsCount = 16;
+
+        //! Decodes a single 4x4 block of the block-compressed format into 16 pixels of GetTexturePayloadUncompressedFormat(format)
+        //! stored row by row. BC7 blocks are supported in mode 6 only (the one produced by AssetsCompiler)
+        //! @return false if the format is not block-compressed or the block uses an unsupported mode
+        KMP_NODISCARD KMP_API bool DecodeTextureBlock(Assets::TexturePayloadFormat format, const UByte* block, UByte* pixels) noexcept;
+
+        //! Converts raw texture payload of a block-compressed format into the uncompressed payload with the same channels
+        //! and mip levels, used as a fallback when the device is not able to sample the compressed format
+        //! @return empty buffer if the payload is malformed
+        KMP_NODISCARD KMP_API BinaryBuffer DecompressTexturePayload(BinaryView texturePayload);
+    }
+}
\ No newline at end of file
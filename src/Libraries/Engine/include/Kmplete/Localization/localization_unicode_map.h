@@ -24,6 +24,9 @@ namespace Kmplete
         private:
             KMP_NODISCARD static bool _InitializeEn();
             KMP_NODISCARD static bool _InitializeRu();
+            //! Fills codepoints of the locale from the ranges shared with AssetsCompiler
+            //! @see Assets::GetLocaleCodepointRanges
+            KMP_NODISCARD static bool _InitializeLocale(const LocaleStr& locale);
             
         private:
             static bool _initialized;
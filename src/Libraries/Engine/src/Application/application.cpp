@@ -132,6 +132,8 @@ namespace Kmplete
         settings->get().SaveBool(Log::OutputStringBufferStr, logSettings.outputStringBuffer);
         settings->get().SaveInt(Log::LevelStr, logSettings.level);
         settings->get().SaveInt(Log::LevelFlushStr, logSettings.levelFlush);
+        settings->get().SaveInt(Log::QueueSizeStr, logSettings.queueSize);
+        settings->get().SaveInt(Log::OverflowPolicyStr, logSettings.overflowPolicy);
         settings->get().EndSaveObject();
 #endif
 
@@ -166,6 +168,8 @@ namespace Kmplete
         logSettings.outputStringBuffer = settings->get().GetBool(Log::OutputStringBufferStr, false);
         logSettings.level = settings->get().GetInt(Log::LevelStr, spdlog::level::trace);
         logSettings.levelFlush = settings->get().GetInt(Log::LevelFlushStr, spdlog::level::trace);
+        logSettings.queueSize = settings->get().GetInt(Log::QueueSizeStr, 8192);
+        logSettings.overflowPolicy = settings->get().GetInt(Log::OverflowPolicyStr, Log::OverflowPolicyBlock);
         Log::SetSettings(logSettings);
 
         settings->get().EndLoadObject();
@@ -18,6 +18,9 @@ namespace Kmplete
     static constexpr auto SettingsEntryName = "WindowApplication";
     static constexpr auto IconifiedFPSStr = "IconifiedFPS";
     static constexpr auto GraphicsBackendTypeStr = "GraphicsBackendType";
+    static constexpr auto AssetUploadBudgetKiBStr = "AssetUploadBudgetKiB";
+    static constexpr auto AssetUploadBudgetMsStr = "AssetUploadBudgetMs";
+    static constexpr auto AssetMemoryUsageFractionStr = "AssetMemoryUsageFraction";
     static constexpr auto IconifiedFPSMin = UInt32(10);
     static constexpr auto IconifiedFPSMax = UInt32(60);
 
@@ -32,6 +35,8 @@ namespace Kmplete
         , _frameListenerManager(nullptr)
         , _frameClock()
         , _iconifiedFPS(IconifiedFPSMin)
+        , _assetUploadBudget()
+        , _assetResidencyPolicy()
         , _graphicsBackendType(Graphics::GraphicsBackendType::Vulkan)
         , _resizing(false)
     {
@@ -157,7 +162,9 @@ namespace Kmplete
 
     bool WindowApplication::_RunFrameIteration(Window& window) KMP_PROFILING(ProfileLevelAlways)
     {
-        KMP_ASSERT(_frameListenerManager && _graphicsBackend);
+        KMP_ASSERT(_frameListenerManager && _graphicsBackend && _assetsManager);
+
+        KMP_PROFILE_FRAME_MARK();
 
         const auto frameTimestep = Math::Clamp(_frameClock.Mark(), 0.0f, 100.0f);
 
@@ -200,6 +207,9 @@ namespace Kmplete
                 return true;
             }
 
+            _assetsManager->UpdateResidency(_assetResidencyPolicy);
+            _assetsManager->ProcessUploads(_assetUploadBudget);
+
             _frameListenerManager->_RenderFrameListeners();
             _frameListenerManager->_ProcessFrameListenersCommands();
             _graphicsBackend->EndFrame();
@@ -250,6 +260,9 @@ namespace Kmplete
 
         settings.value().get().SaveUInt(IconifiedFPSStr, _iconifiedFPS);
         settings.value().get().SaveString(GraphicsBackendTypeStr, Graphics::GraphicsBackendTypeToString(_graphicsBackendType));
+        settings.value().get().SaveUInt(AssetUploadBudgetKiBStr, UInt32(_assetUploadBudget.bytes / 1024));
+        settings.value().get().SaveDouble(AssetUploadBudgetMsStr, _assetUploadBudget.milliseconds);
+        settings.value().get().SaveDouble(AssetMemoryUsageFractionStr, _assetResidencyPolicy.memoryUsageFraction);
         
         _windowBackend->SaveSettings(*settings);
         _graphicsBackend->SaveSettings(*settings);
@@ -282,6 +295,13 @@ namespace Kmplete
         }
 
         _graphicsBackendType = Graphics::StringToGraphicsBackendType(settingsDocument.GetString(GraphicsBackendTypeStr, Graphics::DefaultAPIStr));
+
+        const auto defaultUploadBudget = Assets::AssetUploadBudget();
+        _assetUploadBudget.bytes = UInt64(settingsDocument.GetUInt(AssetUploadBudgetKiBStr, UInt32(defaultUploadBudget.bytes / 1024))) * 1024;
+        _assetUploadBudget.milliseconds = float(settingsDocument.GetDouble(AssetUploadBudgetMsStr, defaultUploadBudget.milliseconds));
+
+        const auto defaultResidencyPolicy = Assets::AssetResidencyPolicy();
+        _assetResidencyPolicy.memoryUsageFraction = float(settingsDocument.GetDouble(AssetMemoryUsageFractionStr, defaultResidencyPolicy.memoryUsageFraction));
     }}
     //--------------------------------------------------------------------------
 }
@@ -0,0 +1,120 @@
+#include "Kmplete/Assets/asset_handle.h"
+#include "Kmplete/Assets/assets_manager.h"
+#include "Kmplete/Core/assertion.h"
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        AssetHandle::AssetHandle() noexcept
+            : _assetsManager(nullptr)
+            , _sid(0)
+        {}
+        //--------------------------------------------------------------------------
+
+        AssetHandle::AssetHandle(AssetsManager& assetsManager, StringID sid)
+            : _assetsManager(&assetsManager)
+            , _sid(sid)
+        {
+            _assetsManager->_RetainAsset(_sid);
+        }
+        //--------------------------------------------------------------------------
+
+        AssetHandle::AssetHandle(const AssetHandle& other)
+            : _assetsManager(other._assetsManager)
+            , _sid(other._sid)
+        {
+            if (_assetsManager)
+            {
+                _assetsManager->_RetainAsset(_sid);
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        AssetHandle::AssetHandle(AssetHandle&& other) noexcept
+            : _assetsManager(other._assetsManager)
+            , _sid(other._sid)
+        {
+            other._assetsManager = nullptr;
+            other._sid = 0;
+        }
+        //--------------------------------------------------------------------------
+
+        AssetHandle::~AssetHandle()
+        {
+            Reset();
+        }
+        //--------------------------------------------------------------------------
+
+        AssetHandle& AssetHandle::operator=(const AssetHandle& other)
+        {
+            if (this != &other)
+            {
+                if (other._assetsManager)
+                {
+                    other._assetsManager->_RetainAsset(other._sid);
+                }
+
+                Reset();
+                _assetsManager = other._assetsManager;
+                _sid = other._sid;
+            }
+
+            return *this;
+        }
+        //--------------------------------------------------------------------------
+
+        AssetHandle& AssetHandle::operator=(AssetHandle&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                _assetsManager = other._assetsManager;
+                _sid = other._sid;
+                other._assetsManager = nullptr;
+                other._sid = 0;
+            }
+
+            return *this;
+        }
+        //--------------------------------------------------------------------------
+
+        bool AssetHandle::IsValid() const noexcept
+        {
+            return _assetsManager != nullptr;
+        }
+        //--------------------------------------------------------------------------
+
+        StringID AssetHandle::GetStringID() const noexcept
+        {
+            return _sid;
+        }
+        //--------------------------------------------------------------------------
+
+        bool AssetHandle::IsResident() const
+        {
+            return _assetsManager && _assetsManager->IsAssetResident(_sid);
+        }
+        //--------------------------------------------------------------------------
+
+        const TextureAsset& AssetHandle::GetTextureAsset() const
+        {
+            KMP_ASSERT(_assetsManager);
+
+            return _assetsManager->GetTextureAssetOrPlaceholder(_sid);
+        }
+        //--------------------------------------------------------------------------
+
+        void AssetHandle::Reset() noexcept
+        {
+            if (_assetsManager)
+            {
+                _assetsManager->_ReleaseAsset(_sid);
+                _assetsManager = nullptr;
+                _sid = 0;
+            }
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "Kmplete/Assets/asset_load_request.h"
+#include "Kmplete/Core/assertion.h"
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        AssetLoadRequest::AssetLoadRequest(UInt64 assetsCount)
+            : _assetsCount(assetsCount)
+            , _loadedCount(0)
+            , _failedCount(0)
+            , _promise()
+            , _future(_promise.get_future().share())
+        {
+            if (_assetsCount == 0)
+            {
+                _promise.set_value(true);
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 AssetLoadRequest::GetAssetsCount() const noexcept
+        {
+            return _assetsCount;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 AssetLoadRequest::GetLoadedCount() const noexcept
+        {
+            return _loadedCount.load();
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 AssetLoadRequest::GetFailedCount() const noexcept
+        {
+            return _failedCount.load();
+        }
+        //--------------------------------------------------------------------------
+
+        bool AssetLoadRequest::IsFinished() const noexcept
+        {
+            return _loadedCount.load() + _failedCount.load() == _assetsCount;
+        }
+        //--------------------------------------------------------------------------
+
+        std::shared_future<bool> AssetLoadRequest::GetFuture() const
+        {
+            return _future;
+        }
+        //--------------------------------------------------------------------------
+
+        void AssetLoadRequest::_FinishAsset(bool loaded)
+        {
+            KMP_ASSERT(not IsFinished());
+
+            if (loaded)
+            {
+                _loadedCount++;
+            }
+            else
+            {
+                _failedCount++;
+            }
+
+            if (IsFinished())
+            {
+                _promise.set_value(_failedCount.load() == 0);
+            }
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -3,22 +3,30 @@
 #include "Kmplete/Graphics/image.h"
 #include "Kmplete/Core/assertion.h"
 #include "Kmplete/Filesystem/filesystem.h"
+#include "Kmplete/Utils/compression_utils.h"
+#include "Kmplete/Time/clock.h"
 #include "Kmplete/Base/exception.h"
 #include "Kmplete/Log/log.h"
 #include "Kmplete/Profile/profiler.h"
 
+#include <algorithm>
+
 
 namespace Kmplete
 {
     namespace Assets
     {
-        AssetsManager::AssetsManager(const Filepath& dataPath, Graphics::GraphicsBackend& graphicsBackend, const LocaleStr& currentLocale)
+        AssetsManager::AssetsManager(const Filepath& dataPath, Graphics::GraphicsBackend& graphicsBackend, const LocaleStr& currentLocale, UInt32 decodeThreadsCount /*= 0*/)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _dataPath(dataPath)
             , _currentLocale(currentLocale)
             , _graphicsBackend(graphicsBackend)
+            , _decodeThreadsCount(decodeThreadsCount)
+            , _decodePool(nullptr)
             , _textureAssetManager(nullptr)
             , _fontAssetManager(nullptr)
+            , _streamingSequence(0)
+            , _frameIndex(0)
         {
             _Initialize();
 
@@ -66,29 +74,16 @@ namespace Kmplete
 
         bool AssetsManager::LoadAssetFile(const Filepath& filepath, bool loadBinaries /*= true*/) KMP_PROFILING(ProfileLevelImportant)
         {
-            const auto fullPath = _dataPath / filepath;
-            if (not Filesystem::FilepathExists(fullPath))
-            {
-                KMP_LOG_ERROR("cannot load asset file from '{}' - file not found", filepath);
-                return false;
-            }
-
-            const auto fileBuffer = Filesystem::ReadFileAsBinary(fullPath);
-            if (fileBuffer.size() < sizeof(AssetCount))
+            const auto assetFile = _RegisterAssetFile(filepath);
+            if (not assetFile)
             {
-                KMP_LOG_ERROR("asset file '{}' buffer is too small", filepath);
                 return false;
             }
 
-            const auto assetCount = *reinterpret_cast<const AssetCount*>(fileBuffer.data());
-
-            KMP_LOG_INFO("start loading {} assets headers from '{}'", assetCount, filepath);
-            _LoadAssetFileHeaders(fileBuffer, assetCount, filepath);
-
             if (loadBinaries)
             {
-                KMP_LOG_INFO("start loading {} assets binaries from '{}'", assetCount, filepath);
-                return _LoadAssetFileBinaries(fileBuffer, assetCount);
+                KMP_LOG_INFO("start loading {} assets binaries from '{}'", assetFile->assetCount, filepath);
+                return _LoadAssetFileBinaries(*assetFile);
             }
 
             return true;
@@ -117,18 +112,29 @@ namespace Kmplete
 
             for (const auto& sid : assetsSids)
             {
-                if (not _lookupMap.contains(sid))
+                auto lookupInfo = AssetLookupInfo();
+                if (not _FindAsset(sid, lookupInfo))
                 {
                     KMP_LOG_WARN("cannot unload asset with sid '{}' - not found", sid);
                     continue;
                 }
 
-                const auto assetType = _lookupMap[sid].header.type;
+                if (IsAssetPending(sid))
+                {
+                    _FinishStreamingAsset(sid, false);
+
+                    if (not _IsAssetResident(lookupInfo.header))
+                    {
+                        continue;
+                    }
+                }
+
+                const auto assetType = lookupInfo.header.type;
                 if (assetType == static_cast<UByte>(AssetType::Texture))
                 {
                     textureSidsToRemove.push_back(sid);
                 }
-                else if (assetType == static_cast<UByte>(AssetType::Font))
+                else if (assetType == static_cast<UByte>(AssetType::Font) || assetType == static_cast<UByte>(AssetType::FontAtlas))
                 {
                     fontsSidsToRemove.push_back(sid);
                 }
@@ -144,12 +150,235 @@ namespace Kmplete
                 _fontAssetManager->RemoveAssets(fontsSidsToRemove);
             }
 
+            for (const auto& sid : assetsSids)
+            {
+                _ForgetUnloadedAsset(sid);
+            }
+
             return true;
         }}
         //--------------------------------------------------------------------------
 
+        AssetLoadHandle AssetsManager::LoadAssetsAsync(const Vector<StringID>& assetsSids, AssetLoadPriority priority /*= AssetLoadPriority::Normal*/) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_decodePool);
+
+            auto request = CreatePtr<AssetLoadRequest>(assetsSids.size());
+
+            Vector<AssetEntry> entries;
+            for (const auto& sid : assetsSids)
+            {
+                auto lookupInfo = AssetLookupInfo();
+                if (not _FindAsset(sid, lookupInfo))
+                {
+                    KMP_LOG_WARN("cannot stream asset with sid '{}' - not found", sid);
+                    request->_FinishAsset(false);
+                    continue;
+                }
+
+                if (_IsAssetResident(lookupInfo.header))
+                {
+                    request->_FinishAsset(true);
+                    continue;
+                }
+
+                auto& sidRequests = _streamingRequests[sid];
+                const auto isPending = not sidRequests.empty();
+                sidRequests.push_back(request);
+                if (isPending)
+                {
+                    continue;
+                }
+
+                const auto& assetFile = _assetFiles[lookupInfo.fileIndex];
+                if (not _AddAssetEntry(assetFile.mappedFile->GetView(), lookupInfo.header, entries))
+                {
+                    _FinishStreamingAsset(sid, false);
+                }
+            }
+
+            {
+                std::lock_guard lock(_streamingMutex);
+
+                for (const auto& entry : entries)
+                {
+                    _streamingDecodeQueue.push_back(StreamingEntry{
+                        .entry = entry,
+                        .priority = priority,
+                        .sequence = _streamingSequence++,
+                        .decoded = DecodedAssetEntry()
+                    });
+                    std::push_heap(_streamingDecodeQueue.begin(), _streamingDecodeQueue.end(), _StreamingEntryLess);
+                }
+            }
+
+            // every task decodes the most important entry queued at the moment it starts, not the one it was submitted for
+            for (UInt64 i = 0; i < entries.size(); i++)
+            {
+                _decodePool->Submit([this]() { _DecodeNextStreamingEntry(); });
+            }
+
+            return request;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt64 AssetsManager::ProcessUploads(const AssetUploadBudget& budget) KMP_PROFILING(ProfileLevelImportant)
+        {
+            const auto clock = Time::Clock();
+            auto uploadedBytes = UInt64(0);
+            auto processedCount = UInt64(0);
+
+            while (true)
+            {
+                auto streamingEntry = StreamingEntry();
+                {
+                    std::lock_guard lock(_streamingMutex);
+
+                    if (_streamingUploadQueue.empty())
+                    {
+                        break;
+                    }
+
+                    const auto uploadSize = _EstimateUploadSize(_streamingUploadQueue.front());
+                    if (processedCount > 0 && (uploadedBytes + uploadSize > budget.bytes || clock.Peek() >= budget.milliseconds))
+                    {
+                        break;
+                    }
+
+                    std::pop_heap(_streamingUploadQueue.begin(), _streamingUploadQueue.end(), _StreamingEntryLess);
+                    streamingEntry = std::move(_streamingUploadQueue.back());
+                    _streamingUploadQueue.pop_back();
+
+                    uploadedBytes += uploadSize;
+                }
+
+                processedCount++;
+
+                // the asset has been unloaded (and so cancelled) while it was decoding
+                const auto sid = StringID(streamingEntry.entry.header.sid);
+                if (not IsAssetPending(sid))
+                {
+                    _DiscardDecodedEntry(streamingEntry.decoded);
+                    continue;
+                }
+
+                const auto loaded = _IsAssetResident(streamingEntry.entry.header) || _CreateAsset(streamingEntry.entry, std::move(streamingEntry.decoded));
+                _DiscardDecodedEntry(streamingEntry.decoded);
+                _FinishStreamingAsset(sid, loaded);
+            }
+
+            KMP_PROFILE_COUNTER("Pending assets", _streamingRequests.size());
+
+            return processedCount;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool AssetsManager::IsAssetPending(StringID sid) const
+        {
+            return _streamingRequests.contains(sid);
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 AssetsManager::GetPendingAssetsCount() const noexcept
+        {
+            return _streamingRequests.size();
+        }
+        //--------------------------------------------------------------------------
+
+        bool AssetsManager::IsAssetResident(StringID sid) const
+        {
+            KMP_ASSERT(_textureAssetManager && _fontAssetManager);
+
+            return _textureAssetManager->ContainsAsset(sid) || _fontAssetManager->ContainsAsset(sid) || _fontAssetManager->ContainsAtlasAsset(sid);
+        }
+        //--------------------------------------------------------------------------
+
+        const TextureAsset& AssetsManager::GetTextureAssetOrPlaceholder(StringID sid)
+        {
+            KMP_ASSERT(_textureAssetManager);
+
+            _TouchAsset(sid);
+
+            if (not _textureAssetManager->ContainsAsset(sid) && IsAssetPending(sid))
+            {
+                return _textureAssetManager->GetAsset(TextureAssetManager::ErrorTextureSID);
+            }
+
+            return _textureAssetManager->GetAsset(sid);
+        }
+        //--------------------------------------------------------------------------
+
+        AssetHandle AssetsManager::AcquireAsset(StringID sid, AssetLoadPriority priority /*= AssetLoadPriority::Normal*/) KMP_PROFILING(ProfileLevelMinor)
+        {
+            auto handle = AssetHandle(*this, sid);
+
+            if (not IsAssetResident(sid) && not IsAssetPending(sid))
+            {
+                KMP_MB_UNUSED const auto request = LoadAssetsAsync({ sid }, priority);
+            }
+
+            return handle;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt64 AssetsManager::UpdateResidency(const AssetResidencyPolicy& policy) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_textureAssetManager);
+
+            _frameIndex++;
+
+            const auto memoryUsage = _graphicsBackend.QueryMemoryUsage();
+            if (memoryUsage.budget == 0 || double(memoryUsage.usage) <= double(memoryUsage.budget) * double(policy.memoryUsageFraction))
+            {
+                return 0;
+            }
+
+            // a texture used by a frame that is still in flight must not be destroyed
+            const auto minUnusedFrames = std::max(UInt64(policy.minUnusedFrames), UInt64(Graphics::NumConcurrentFrames) + 1);
+
+            Vector<std::pair<UInt64, StringID>> candidates;
+            for (const auto& [sid, residency] : _residency)
+            {
+                auto lookupInfo = AssetLookupInfo();
+                if (residency.referenceCount > 0 ||
+                    residency.lastUsedFrame + minUnusedFrames > _frameIndex ||
+                    not _textureAssetManager->ContainsAsset(sid) ||
+                    not _FindAsset(sid, lookupInfo))
+                {
+                    continue;
+                }
+
+                candidates.emplace_back(residency.lastUsedFrame, sid);
+            }
+
+            const auto evictionsCount = std::min(UInt64(candidates.size()), UInt64(policy.maxEvictionsPerFrame));
+            std::partial_sort(candidates.begin(), candidates.begin() + evictionsCount, candidates.end());
+
+            auto evictedCount = UInt64(0);
+            for (UInt64 i = 0; i < evictionsCount; i++)
+            {
+                const auto sid = candidates[i].second;
+                if (_textureAssetManager->RemoveAsset(sid))
+                {
+                    _residency[sid].evicted = true;
+                    evictedCount++;
+                }
+            }
+
+            if (evictedCount > 0)
+            {
+                KMP_LOG_DEBUG("evicted {} textures, GPU memory usage {} of {} budget", evictedCount, memoryUsage.usage, memoryUsage.budget);
+            }
+
+            return evictedCount;
+        }}
+        //--------------------------------------------------------------------------
+
         void AssetsManager::_Initialize()
         {
+            _decodePool.reset(new ThreadPool(_decodeThreadsCount));
+            KMP_ASSERT(_decodePool);
+
             _textureAssetManager.reset(new TextureAssetManager(_graphicsBackend));
             KMP_ASSERT(_textureAssetManager);
 
@@ -162,50 +391,142 @@ namespace Kmplete
         {
             KMP_ASSERT(_fontAssetManager && _textureAssetManager);
 
+            _CancelStreaming();
+
             _fontAssetManager.reset();
             _textureAssetManager.reset();
+            _assetFiles.clear();
+            _decodePool.reset();
         }
         //--------------------------------------------------------------------------
 
-        void AssetsManager::_LoadAssetFileHeaders(const BinaryBuffer& fileBuffer, AssetCount assetCount, const Filepath& filepath) KMP_PROFILING(ProfileLevelImportant)
+        Nullable<const AssetsManager::AssetFile*> AssetsManager::_RegisterAssetFile(const Filepath& filepath) KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(not fileBuffer.empty());
+            const auto registeredFile = std::find_if(_assetFiles.begin(), _assetFiles.end(), [&](const AssetFile& assetFile) { return assetFile.filepath == filepath; });
+            if (registeredFile != _assetFiles.end())
+            {
+                return &(*registeredFile);
+            }
 
-            for (AssetCount i = 0; i < assetCount; i++)
+            const auto fullPath = _dataPath / filepath;
+            if (not Filesystem::FilepathExists(fullPath))
             {
-                const auto headerStructBufferOffset = sizeof(assetCount) + i * AssetEntryHeaderStructSize;
-                const auto assetHeader = *reinterpret_cast<const AssetEntryHeader*>(fileBuffer.data() + headerStructBufferOffset);
+                KMP_LOG_ERROR("cannot load asset file from '{}' - file not found", filepath);
+                return nullptr;
+            }
 
-                const auto [iterator, hasEmplaced] = _lookupMap.emplace(assetHeader.sid, AssetLookupInfo{ 
-                    .filepath = filepath, 
-                    .header = assetHeader
-                });
+            auto mappedFile = UPtr<Filesystem::MappedFile>();
+            try
+            {
+                mappedFile.reset(new Filesystem::MappedFile(fullPath));
+            }
+            catch (KMP_MB_UNUSED const Exception& e)
+            {
+                KMP_LOG_ERROR("failed to map asset file '{}': {}", filepath, e.what());
+                return nullptr;
+            }
 
-                if (not hasEmplaced)
-                {
-                    KMP_LOG_ERROR("Asset SID duplication detected - file '{}' already registered asset with SID '{}' as currently processed file '{}'", _lookupMap[assetHeader.sid].filepath, assetHeader.sid, filepath);
-                }
+            const auto fileView = mappedFile->GetView();
+            if (fileView.size() < sizeof(AssetCount) + AssetIndexFooterStructSize)
+            {
+                KMP_LOG_ERROR("asset file '{}' buffer is too small", filepath);
+                return nullptr;
             }
+
+            const auto assetCount = *reinterpret_cast<const AssetCount*>(fileView.data());
+            const auto headersSize = UInt64(assetCount) * AssetEntryHeaderStructSize;
+            const auto indexSize = UInt64(assetCount) * AssetIndexEntryStructSize;
+            const auto footer = *reinterpret_cast<const AssetIndexFooter*>(fileView.data() + fileView.size() - AssetIndexFooterStructSize);
+
+            const auto indexEndOffset = fileView.size() - AssetIndexFooterStructSize;
+            if (footer.signature != AssetIndexFooterSignature ||
+                footer.indexOffset < sizeof(AssetCount) + headersSize ||
+                footer.indexOffset > indexEndOffset ||
+                indexEndOffset - footer.indexOffset != indexSize)
+            {
+                KMP_LOG_ERROR("asset file '{}' has malformed layout for {} assets", filepath, assetCount);
+                return nullptr;
+            }
+
+            KMP_LOG_INFO("registered asset file '{}' with {} assets", filepath, assetCount);
+
+            auto& assetFile = _assetFiles.emplace_back();
+            assetFile.filepath = filepath;
+            assetFile.assetCount = assetCount;
+            assetFile.headers = fileView.subspan(sizeof(AssetCount), headersSize);
+            assetFile.index = fileView.subspan(footer.indexOffset, indexSize);
+            assetFile.mappedFile = std::move(mappedFile);
+
+            return &assetFile;
         }}
         //--------------------------------------------------------------------------
 
-        bool AssetsManager::_LoadAssetFileBinaries(const BinaryBuffer& fileBuffer, AssetCount assetCount) KMP_PROFILING(ProfileLevelImportant)
+        bool AssetsManager::_LoadAssetFileBinaries(const AssetFile& assetFile) KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(not fileBuffer.empty());
+            const auto fileView = assetFile.mappedFile->GetView();
+
+            Vector<AssetEntry> entries;
+            entries.reserve(assetFile.assetCount);
 
             auto loadedOk = true;
-            for (AssetCount i = 0; i < assetCount; i++)
+            for (AssetCount i = 0; i < assetFile.assetCount; i++)
             {
-                const auto headerStructBufferOffset = sizeof(assetCount) + i * AssetEntryHeaderStructSize;
-                const auto assetHeader = *reinterpret_cast<const AssetEntryHeader*>(fileBuffer.data() + headerStructBufferOffset);
+                const auto assetHeader = *reinterpret_cast<const AssetEntryHeader*>(assetFile.headers.data() + i * AssetEntryHeaderStructSize);
 
-                loadedOk &= _LoadAssetEntryBinary(fileBuffer, assetHeader);
+                loadedOk &= _AddAssetEntry(fileView, assetHeader, entries);
             }
 
+            loadedOk &= _LoadAssetEntries(entries);
+
             return loadedOk;
         }}
         //--------------------------------------------------------------------------
 
+        bool AssetsManager::_FindAsset(StringID sid, AssetLookupInfo& lookupInfo) const KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            for (UInt32 fileIndex = 0; fileIndex < UInt32(_assetFiles.size()); fileIndex++)
+            {
+                const auto& assetFile = _assetFiles[fileIndex];
+                if (assetFile.indexRejected)
+                {
+                    continue;
+                }
+
+                const auto* indexBegin = reinterpret_cast<const AssetIndexEntry*>(assetFile.index.data());
+                const auto* indexEnd = indexBegin + assetFile.assetCount;
+                const auto* indexEntry = std::lower_bound(indexBegin, indexEnd, sid, [](const AssetIndexEntry& entry, StringID value) { return entry.sid < value; });
+
+                // the index is not validated on registration to keep it O(1), instead the entries around the binary
+                // search result must be strictly increasing, otherwise the result is meaningless and the file is rejected
+                const auto* neighboursBegin = indexEntry == indexBegin ? indexBegin : indexEntry - 1;
+                const auto* neighboursEnd = indexEnd - indexEntry < 2 ? indexEnd : indexEntry + 2;
+                if (std::adjacent_find(neighboursBegin, neighboursEnd, [](const AssetIndexEntry& left, const AssetIndexEntry& right) { return left.sid >= right.sid; }) != neighboursEnd)
+                {
+                    KMP_LOG_ERROR("asset file '{}' has unsorted or duplicated index entries, the file is ignored", assetFile.filepath);
+                    assetFile.indexRejected = true;
+                    continue;
+                }
+
+                if (indexEntry == indexEnd || indexEntry->sid != sid)
+                {
+                    continue;
+                }
+
+                if (indexEntry->headerIndex >= assetFile.assetCount)
+                {
+                    KMP_LOG_ERROR("asset file '{}' index entry of sid '{}' is out of headers range", assetFile.filepath, sid);
+                    return false;
+                }
+
+                lookupInfo.fileIndex = fileIndex;
+                lookupInfo.header = *reinterpret_cast<const AssetEntryHeader*>(assetFile.headers.data() + UInt64(indexEntry->headerIndex) * AssetEntryHeaderStructSize);
+                return true;
+            }
+
+            return false;
+        }}
+        //--------------------------------------------------------------------------
+
         Vector<AssetLookupInfo> AssetsManager::_GetSortedByFileAssetsInfos(const Vector<StringID>& assetsSids) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
             Vector<AssetLookupInfo> lookupVector;
@@ -213,16 +534,22 @@ namespace Kmplete
 
             for (const auto& sid : assetsSids)
             {
-                if (not _lookupMap.contains(sid))
+                auto lookupInfo = AssetLookupInfo();
+                if (not _FindAsset(sid, lookupInfo))
                 {
                     KMP_LOG_WARN("cannot load asset with sid '{}' - not found", sid);
                     continue;
                 }
 
-                lookupVector.push_back(_lookupMap.at(sid));
+                lookupVector.push_back(lookupInfo);
             }
 
-            std::sort(lookupVector.begin(), lookupVector.end(), [](const AssetLookupInfo& info1, const AssetLookupInfo& info2) { return info1.filepath < info2.filepath; });
+            // entries of the same file are read in the order of their placement in the file
+            std::sort(lookupVector.begin(), lookupVector.end(), [](const AssetLookupInfo& info1, const AssetLookupInfo& info2) {
+                return info1.fileIndex != info2.fileIndex
+                    ? info1.fileIndex < info2.fileIndex
+                    : info1.header.bufferOffset < info2.header.bufferOffset;
+            });
 
             return lookupVector;
         }}
@@ -230,56 +557,161 @@ namespace Kmplete
 
         bool AssetsManager::_LoadAssetsEntriesBinaries(const Vector<AssetLookupInfo>& sortedLookupVector) KMP_PROFILING(ProfileLevelImportant)
         {
-            auto currentFilepath = Filepath();
-            auto fileBuffer = BinaryBuffer();
             auto loadedOk = true;
 
+            Vector<AssetEntry> entries;
+            entries.reserve(sortedLookupVector.size());
+
             for (const auto& info : sortedLookupVector)
             {
-                if (currentFilepath != _dataPath / info.filepath)
-                {
-                    currentFilepath = _dataPath / info.filepath;
+                const auto& assetFile = _assetFiles[info.fileIndex];
+                loadedOk &= _AddAssetEntry(assetFile.mappedFile->GetView(), info.header, entries);
+            }
 
-                    fileBuffer = Filesystem::ReadFileAsBinary(currentFilepath);
-                    if (fileBuffer.empty())
-                    {
-                        KMP_LOG_ERROR("failed to load assets from '{}' - buffer is empty or file not found", info.filepath);
-                        return false;
-                    }
-                }
+            loadedOk &= _LoadAssetEntries(entries);
+
+            return loadedOk;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool AssetsManager::_AddAssetEntry(BinaryView fileView, const AssetEntryHeader& assetHeader, Vector<AssetEntry>& entries) const
+        {
+            if (assetHeader.bufferOffset > fileView.size() || assetHeader.bufferSize > fileView.size() - assetHeader.bufferOffset) {
+                KMP_LOG_ERROR("asset buffer overflow - file too small for asset data");
+                return false;
+            }
 
-                loadedOk &= _LoadAssetEntryBinary(fileBuffer, info.header);
+            if (assetHeader.compression != static_cast<UByte>(AssetCompression::None) && assetHeader.compression != static_cast<UByte>(AssetCompression::LZ))
+            {
+                KMP_LOG_ERROR("asset with sid '{}' has unknown compression '{}'", StringID(assetHeader.sid), assetHeader.compression);
+                return false;
+            }
+
+            entries.push_back(AssetEntry{
+                .header = assetHeader,
+                .binary = fileView.subspan(assetHeader.bufferOffset, assetHeader.bufferSize)
+            });
+
+            return true;
+        }
+        //--------------------------------------------------------------------------
+
+        bool AssetsManager::_LoadAssetEntries(const Vector<AssetEntry>& entries) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_decodePool);
+
+            auto loadedOk = true;
+            Vector<DecodedAssetEntry> decodedEntries;
+
+            for (UInt64 batchStart = 0; batchStart < entries.size(); batchStart += DecodeBatchSize)
+            {
+                const auto batchSize = std::min(DecodeBatchSize, entries.size() - batchStart);
+
+                decodedEntries.clear();
+                decodedEntries.resize(batchSize);
+                _decodePool->ParallelFor(batchSize, [&](UInt64 index) {
+                    decodedEntries[index] = _DecodeAssetEntry(entries[batchStart + index]);
+                });
+
+                for (UInt64 index = 0; index < batchSize; index++)
+                {
+                    loadedOk &= _CreateAsset(entries[batchStart + index], std::move(decodedEntries[index]));
+                }
             }
 
             return loadedOk;
         }}
         //--------------------------------------------------------------------------
 
-        bool AssetsManager::_LoadAssetEntryBinary(const BinaryBuffer& fileBuffer, const AssetEntryHeader& assetHeader) KMP_PROFILING(ProfileLevelImportantVerbose)
+        AssetsManager::DecodedAssetEntry AssetsManager::_DecodeAssetEntry(const AssetEntry& entry) KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_textureAssetManager && _fontAssetManager && not fileBuffer.empty());
+            KMP_ASSERT(_fontAssetManager);
 
-            if (fileBuffer.size() < assetHeader.bufferOffset + assetHeader.bufferSize) {
-                KMP_LOG_ERROR("asset buffer overflow - file too small for asset data");
-                return false;
+            const auto& assetHeader = entry.header;
+            auto decodedEntry = DecodedAssetEntry();
+
+            const auto isCompressed = assetHeader.compression != static_cast<UByte>(AssetCompression::None);
+            auto binary = entry.binary;
+            if (isCompressed)
+            {
+                decodedEntry.binary = Utils::DecompressLZ(entry.binary, assetHeader.uncompressedSize);
+                if (decodedEntry.binary.empty())
+                {
+                    KMP_LOG_ERROR("failed to decompress asset with sid '{}'", StringID(assetHeader.sid));
+                    return decodedEntry;
+                }
+
+                binary = decodedEntry.binary;
             }
 
-            if (assetHeader.type == static_cast<UByte>(AssetType::Texture))
+            if (assetHeader.type == static_cast<UByte>(AssetType::Texture) && assetHeader.encoding == static_cast<UByte>(AssetEncoding::Source))
             {
                 try
                 {
-                    const auto assetImage = Graphics::Image(fileBuffer.data() + assetHeader.bufferOffset, static_cast<int>(assetHeader.bufferSize), Graphics::ImageChannels::RGBAlpha);
-                    return _textureAssetManager->CreateAsset(assetHeader.sid, assetImage, TextureSubTypeMaskBits(assetHeader.subTypeMask));
+                    decodedEntry.image = CreateUPtr<Graphics::Image>(binary.data(), static_cast<int>(binary.size()), Graphics::ImageChannels::RGBAlpha);
                 }
                 catch (KMP_MB_UNUSED const Exception& e)
                 {
-                    KMP_LOG_ERROR("failed to create texture: {}", e.what());
+                    KMP_LOG_ERROR("failed to decode texture: {}", e.what());
+                }
+
+                // the decompressed source file is not needed once the image is decoded
+                decodedEntry.binary = BinaryBuffer();
+            }
+            else if (assetHeader.type == static_cast<UByte>(AssetType::Font))
+            {
+                auto fontBuffer = isCompressed ? std::move(decodedEntry.binary) : BinaryBuffer(binary.begin(), binary.end());
+                decodedEntry.font = _fontAssetManager->ParseAsset(assetHeader.sid, std::move(fontBuffer), FontSubTypeMaskBits(assetHeader.subTypeMask));
+            }
+
+            return decodedEntry;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool AssetsManager::_CreateAsset(const AssetEntry& entry, DecodedAssetEntry&& decodedEntry) KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            KMP_ASSERT(_textureAssetManager && _fontAssetManager);
+
+            const auto& assetHeader = entry.header;
+
+            if (assetHeader.type == static_cast<UByte>(AssetType::Texture))
+            {
+                if (assetHeader.encoding == static_cast<UByte>(AssetEncoding::Raw))
+                {
+                    const auto binary = assetHeader.compression == static_cast<UByte>(AssetCompression::None) ? entry.binary : BinaryView(decodedEntry.binary);
+                    if (binary.empty())
+                    {
+                        return false;
+                    }
+
+                    return _textureAssetManager->CreateAsset(assetHeader.sid, binary, TextureSubTypeMaskBits(assetHeader.subTypeMask));
+                }
+
+                if (not decodedEntry.image)
+                {
                     return false;
                 }
+
+                return _textureAssetManager->CreateAsset(assetHeader.sid, *decodedEntry.image, TextureSubTypeMaskBits(assetHeader.subTypeMask));
             }
             else if (assetHeader.type == static_cast<UByte>(AssetType::Font))
             {
-                return _fontAssetManager->CreateAsset(assetHeader.sid, BinaryBuffer(fileBuffer.data() + assetHeader.bufferOffset, fileBuffer.data() + assetHeader.bufferOffset + assetHeader.bufferSize), FontSubTypeMaskBits(assetHeader.subTypeMask));
+                if (not decodedEntry.font)
+                {
+                    return false;
+                }
+
+                return _fontAssetManager->AddAsset(std::move(decodedEntry.font));
+            }
+            else if (assetHeader.type == static_cast<UByte>(AssetType::FontAtlas))
+            {
+                const auto binary = assetHeader.compression == static_cast<UByte>(AssetCompression::None) ? entry.binary : BinaryView(decodedEntry.binary);
+                if (binary.empty())
+                {
+                    return false;
+                }
+
+                return _fontAssetManager->CreateAtlasAsset(assetHeader.sid, binary);
             }
 
             KMP_LOG_ERROR("unknown asset type '{}'", assetHeader.type);
@@ -287,5 +719,185 @@ namespace Kmplete
             return false;
         }}
         //--------------------------------------------------------------------------
+
+        void AssetsManager::_DiscardDecodedEntry(DecodedAssetEntry& decodedEntry)
+        {
+            KMP_ASSERT(_fontAssetManager);
+
+            // font faces share the FreeType library with the faces being parsed by the decoding workers
+            _fontAssetManager->DiscardAsset(std::move(decodedEntry.font));
+        }
+        //--------------------------------------------------------------------------
+
+        bool AssetsManager::_IsAssetResident(const AssetEntryHeader& assetHeader) const
+        {
+            KMP_ASSERT(_textureAssetManager && _fontAssetManager);
+
+            if (assetHeader.type == static_cast<UByte>(AssetType::Texture))
+            {
+                return _textureAssetManager->ContainsAsset(assetHeader.sid);
+            }
+            else if (assetHeader.type == static_cast<UByte>(AssetType::Font))
+            {
+                return _fontAssetManager->ContainsAsset(assetHeader.sid);
+            }
+            else if (assetHeader.type == static_cast<UByte>(AssetType::FontAtlas))
+            {
+                return _fontAssetManager->ContainsAtlasAsset(assetHeader.sid);
+            }
+
+            return false;
+        }
+        //--------------------------------------------------------------------------
+
+        void AssetsManager::_DecodeNextStreamingEntry() KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            auto streamingEntry = StreamingEntry();
+            {
+                std::lock_guard lock(_streamingMutex);
+
+                // the queue has been cleared by the cancellation
+                if (_streamingDecodeQueue.empty())
+                {
+                    return;
+                }
+
+                std::pop_heap(_streamingDecodeQueue.begin(), _streamingDecodeQueue.end(), _StreamingEntryLess);
+                streamingEntry = std::move(_streamingDecodeQueue.back());
+                _streamingDecodeQueue.pop_back();
+            }
+
+            streamingEntry.decoded = _DecodeAssetEntry(streamingEntry.entry);
+
+            std::lock_guard lock(_streamingMutex);
+
+            _streamingUploadQueue.push_back(std::move(streamingEntry));
+            std::push_heap(_streamingUploadQueue.begin(), _streamingUploadQueue.end(), _StreamingEntryLess);
+        }}
+        //--------------------------------------------------------------------------
+
+        void AssetsManager::_FinishStreamingAsset(StringID sid, bool loaded)
+        {
+            const auto requestsIterator = _streamingRequests.find(sid);
+            if (requestsIterator == _streamingRequests.end())
+            {
+                return;
+            }
+
+            const auto requests = std::move(requestsIterator->second);
+            _streamingRequests.erase(requestsIterator);
+
+            for (const auto& request : requests)
+            {
+                request->_FinishAsset(loaded);
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        void AssetsManager::_CancelStreaming() KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_decodePool);
+
+            {
+                std::lock_guard lock(_streamingMutex);
+                _streamingDecodeQueue.clear();
+            }
+
+            _decodePool->WaitIdle();
+            for (auto& streamingEntry : _streamingUploadQueue)
+            {
+                _DiscardDecodedEntry(streamingEntry.decoded);
+            }
+            _streamingUploadQueue.clear();
+
+            // futures of unfinished requests get their value instead of being abandoned
+            while (not _streamingRequests.empty())
+            {
+                _FinishStreamingAsset(_streamingRequests.begin()->first, false);
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        void AssetsManager::_RetainAsset(StringID sid)
+        {
+            auto& residency = _residency[sid];
+            residency.referenceCount++;
+            residency.lastUsedFrame = _frameIndex;
+        }
+        //--------------------------------------------------------------------------
+
+        void AssetsManager::_ReleaseAsset(StringID sid) noexcept
+        {
+            const auto residencyIterator = _residency.find(sid);
+            KMP_ASSERT(residencyIterator != _residency.end() && residencyIterator->second.referenceCount > 0);
+
+            // the asset might be used by the frames still in flight, so releasing counts as the last use
+            residencyIterator->second.referenceCount--;
+            residencyIterator->second.lastUsedFrame = _frameIndex;
+        }
+        //--------------------------------------------------------------------------
+
+        void AssetsManager::_TouchAsset(StringID sid)
+        {
+            auto& residency = _residency[sid];
+            residency.lastUsedFrame = _frameIndex;
+
+            if (residency.evicted)
+            {
+                residency.evicted = false;
+
+                if (not IsAssetPending(sid))
+                {
+                    KMP_MB_UNUSED const auto request = LoadAssetsAsync({ sid });
+                }
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        void AssetsManager::_ForgetUnloadedAsset(StringID sid)
+        {
+            const auto residencyIterator = _residency.find(sid);
+            if (residencyIterator == _residency.end())
+            {
+                return;
+            }
+
+            // explicitly unloaded assets are not reloaded on use, handles keep their counters valid though
+            if (residencyIterator->second.referenceCount == 0)
+            {
+                _residency.erase(residencyIterator);
+            }
+            else
+            {
+                residencyIterator->second.evicted = false;
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        bool AssetsManager::_StreamingEntryLess(const StreamingEntry& entry1, const StreamingEntry& entry2) noexcept
+        {
+            // the heap top is the entry of the highest priority requested first
+            return entry1.priority != entry2.priority
+                ? entry1.priority < entry2.priority
+                : entry1.sequence > entry2.sequence;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 AssetsManager::_EstimateUploadSize(const StreamingEntry& streamingEntry) noexcept
+        {
+            const auto& assetHeader = streamingEntry.entry.header;
+            if (assetHeader.type != static_cast<UByte>(AssetType::Texture))
+            {
+                return 0;
+            }
+
+            if (streamingEntry.decoded.image)
+            {
+                return streamingEntry.decoded.image->GetDataSize();
+            }
+
+            return assetHeader.encoding == static_cast<UByte>(AssetEncoding::Raw) ? UInt64(assetHeader.uncompressedSize) : 0;
+        }
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
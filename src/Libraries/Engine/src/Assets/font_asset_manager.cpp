@@ -23,6 +23,8 @@ namespace Kmplete
         FontAssetManager::FontAssetManager()
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _freetypeLibInstance(nullptr)
+            , _fonts()
+            , _fontAtlases()
         {
             _Initialize();
 
@@ -60,6 +62,62 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        UPtr<Assets::FontAsset> FontAssetManager::ParseAsset(StringID fontSid, BinaryBuffer&& fontData, FontSubTypeMaskBits subTypeMask) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_freetypeLibInstance);
+
+            try
+            {
+                std::lock_guard lock(_freetypeMutex);
+                return CreateUPtr<Assets::FontAsset>(fontSid, *_freetypeLibInstance, std::move(fontData), subTypeMask);
+            }
+            catch (KMP_MB_UNUSED const Exception& e)
+            {
+                KMP_LOG_ERROR("failed to parse font with sid '{}': {}", fontSid, e.what());
+                return nullptr;
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        bool FontAssetManager::AddAsset(UPtr<Assets::FontAsset>&& fontAsset) KMP_PROFILING(ProfileLevelImportant)
+        {
+            if (not fontAsset)
+            {
+                KMP_LOG_ERROR("cannot add empty font asset");
+                return false;
+            }
+
+            const auto fontSid = fontAsset->GetStringID();
+            if (fontSid == DefaultFontSID)
+            {
+                KMP_LOG_ERROR("cannot create font with zero id");
+                return false;
+            }
+
+            // the asset is destroyed right away if it is not emplaced
+            std::lock_guard lock(_freetypeMutex);
+            const auto [iterator, hasEmplaced] = _fonts.emplace(fontSid, std::move(fontAsset));
+            if (not hasEmplaced)
+            {
+                KMP_LOG_ERROR("already contains font with sid '{}'", fontSid);
+            }
+
+            return hasEmplaced;
+        }}
+        //--------------------------------------------------------------------------
+
+        void FontAssetManager::DiscardAsset(UPtr<Assets::FontAsset>&& fontAsset) KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            if (not fontAsset)
+            {
+                return;
+            }
+
+            std::lock_guard lock(_freetypeMutex);
+            fontAsset.reset();
+        }}
+        //--------------------------------------------------------------------------
+
         const Assets::FontAsset& FontAssetManager::GetAsset(StringID fontSid) const KMP_PROFILING(ProfileLevelMinor)
         {
             if (not _fonts.contains(fontSid))
@@ -107,7 +165,9 @@ namespace Kmplete
                 return false;
             }
 
-            if (_fonts.erase(sid) == 0)
+            // font faces might be created by ParseAsset on worker threads meanwhile
+            std::lock_guard lock(_freetypeMutex);
+            if (_fonts.erase(sid) == 0 && _fontAtlases.erase(sid) == 0)
             {
                 KMP_LOG_WARN("not found or failed to remove font with sid '{}'", sid);
                 return false;
@@ -117,12 +177,57 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
+        bool FontAssetManager::ContainsAsset(StringID sid) const noexcept
+        {
+            return _fonts.contains(sid);
+        }
+        //--------------------------------------------------------------------------
+
         UInt64 FontAssetManager::GetAssetsCount() const noexcept
         {
             return _fonts.size();
         }
         //--------------------------------------------------------------------------
 
+        bool FontAssetManager::CreateAtlasAsset(StringID atlasSid, BinaryView payload) KMP_PROFILING(ProfileLevelImportant)
+        {
+            if (_fontAtlases.contains(atlasSid) || _fonts.contains(atlasSid))
+            {
+                KMP_LOG_ERROR("already contains font or font atlas with sid '{}'", atlasSid);
+                return false;
+            }
+
+            auto header = FontAtlasPayloadHeader();
+            if (not ReadFontAtlasPayloadHeader(payload, header))
+            {
+                KMP_LOG_ERROR("font atlas with sid '{}' has malformed payload of {} bytes", atlasSid, payload.size());
+                return false;
+            }
+
+            const auto [iterator, hasEmplaced] = _fontAtlases.emplace(atlasSid, CreateUPtr<Assets::FontAtlasAsset>(atlasSid, BinaryBuffer(payload.begin(), payload.end()), header));
+            return hasEmplaced;
+        }}
+        //--------------------------------------------------------------------------
+
+        Nullable<const Assets::FontAtlasAsset*> FontAssetManager::GetAtlasAsset(StringID atlasSid) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            const auto iterator = _fontAtlases.find(atlasSid);
+            if (iterator == _fontAtlases.end())
+            {
+                KMP_LOG_ERROR("font atlas '{}' not found", atlasSid);
+                return nullptr;
+            }
+
+            return iterator->second.get();
+        }}
+        //--------------------------------------------------------------------------
+
+        bool FontAssetManager::ContainsAtlasAsset(StringID sid) const noexcept
+        {
+            return _fontAtlases.contains(sid);
+        }
+        //--------------------------------------------------------------------------
+
         void FontAssetManager::_Initialize()
         {
             const auto freetypeInitError = FT_Init_FreeType(&_freetypeLibInstance);
@@ -153,7 +258,11 @@ namespace Kmplete
         {
             KMP_ASSERT(_freetypeLibInstance);
 
-            _fonts.clear();
+            {
+                std::lock_guard lock(_freetypeMutex);
+                _fontAtlases.clear();
+                _fonts.clear();
+            }
 
             const auto freetypeDoneError = FT_Done_FreeType(_freetypeLibInstance);
             if (freetypeDoneError)
@@ -279,6 +388,7 @@ namespace Kmplete
         {
             KMP_ASSERT(_freetypeLibInstance);
 
+            std::lock_guard lock(_freetypeMutex);
             const auto [iterator, hasEmplaced] = _fonts.emplace(sid, CreateUPtr<Assets::FontAsset>(sid, *_freetypeLibInstance, std::move(fontData), subTypeMask));
             return hasEmplaced;
         }}
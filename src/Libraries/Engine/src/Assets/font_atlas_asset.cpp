@@ -0,0 +1,31 @@
+#include "Kmplete/Assets/font_atlas_asset.h"
+#include "Kmplete/Profile/profiler.h"
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        FontAtlasAsset::FontAtlasAsset(StringID sid, BinaryBuffer&& payload, const FontAtlasPayloadHeader& header)
+            : Asset(AssetType::FontAtlas, sid, FontSubTypeMaskBits::None)
+              KMP_PROFILE_CONSTRUCTOR_START_DERIVED_CLASS()
+            , _payload(std::move(payload))
+            , _header(header)
+        {
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        BinaryView FontAtlasAsset::GetPayload() const noexcept
+        {
+            return BinaryView(_payload);
+        }
+        //--------------------------------------------------------------------------
+
+        const FontAtlasPayloadHeader& FontAtlasAsset::GetHeader() const noexcept
+        {
+            return _header;
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
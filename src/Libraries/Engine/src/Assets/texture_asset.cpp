@@ -7,10 +7,11 @@ namespace Kmplete
 {
     namespace Assets
     {
-        TextureAsset::TextureAsset(StringID sid, NonNull<Graphics::Texture*> texture, TextureSubTypeMaskBits subTypeMask) noexcept
+        TextureAsset::TextureAsset(StringID sid, NonNull<Graphics::Texture*> texture, TextureSubTypeMaskBits subTypeMask, UInt32 bindlessIndex) noexcept
             : Asset(AssetType::Texture, sid, subTypeMask)
               KMP_PROFILE_CONSTRUCTOR_START_DERIVED_CLASS()
             , _texture(texture)
+            , _bindlessIndex(bindlessIndex)
         {
             KMP_ASSERT(_texture);
             KMP_PROFILE_CONSTRUCTOR_END()
@@ -32,5 +33,11 @@ namespace Kmplete
             return *_texture;
         }
         //--------------------------------------------------------------------------
+
+        UInt32 TextureAsset::GetBindlessIndex() const noexcept
+        {
+            return _bindlessIndex;
+        }
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
@@ -15,6 +15,10 @@ namespace Kmplete
         TextureAssetManager::TextureAssetManager(Graphics::GraphicsBackend& graphicsBackend)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _graphicsBackend(graphicsBackend)
+            , _textures()
+            , _bindlessTexturesCount(graphicsBackend.GetBindlessTexturesCount())
+            , _nextBindlessIndex(ErrorTextureBindlessIndex)
+            , _freeBindlessIndices()
         {
             if (not _CreateErrorTextureAsset())
             {
@@ -40,8 +44,7 @@ namespace Kmplete
                 return false;
             }
 
-            const auto [iterator, hasEmplaced] = _textures.emplace(textureSid, CreateUPtr<Assets::TextureAsset>(textureSid, texture, subTypeMask));
-            return hasEmplaced;
+            return _EmplaceAsset(textureSid, texture, subTypeMask);
         }}
         //--------------------------------------------------------------------------
 
@@ -61,8 +64,25 @@ namespace Kmplete
                 return false;
             }
 
-            const auto [iterator, hasEmplaced] = _textures.emplace(textureSid, CreateUPtr<Assets::TextureAsset>(textureSid, texture, subTypeMask));
-            return hasEmplaced;
+            return _EmplaceAsset(textureSid, texture, subTypeMask);
+        }}
+        //--------------------------------------------------------------------------
+
+        bool TextureAssetManager::CreateAsset(StringID textureSid, BinaryView texturePayload, TextureSubTypeMaskBits subTypeMask) KMP_PROFILING(ProfileLevelAlways)
+        {
+            if (not _TextureSidIsValid(textureSid))
+            {
+                return false;
+            }
+
+            auto* texture = _graphicsBackend.CreateTexture(texturePayload, subTypeMask);
+            if (texture == nullptr)
+            {
+                KMP_LOG_ERROR("failed to create texture from payload");
+                return false;
+            }
+
+            return _EmplaceAsset(textureSid, texture, subTypeMask);
         }}
         //--------------------------------------------------------------------------
 
@@ -113,16 +133,26 @@ namespace Kmplete
                 return false;
             }
 
-            if (_textures.erase(sid) == 0)
+            const auto iterator = _textures.find(sid);
+            if (iterator == _textures.end())
             {
                 KMP_LOG_WARN("not found or failed to remove texture with sid '{}'", sid);
                 return false;
             }
 
+            _ReleaseBindlessIndex(iterator->second->GetBindlessIndex());
+            _textures.erase(iterator);
+
             return true;
         }}
         //--------------------------------------------------------------------------
 
+        bool TextureAssetManager::ContainsAsset(StringID sid) const noexcept
+        {
+            return _textures.contains(sid);
+        }
+        //--------------------------------------------------------------------------
+
         UInt64 TextureAssetManager::GetAssetsCount() const noexcept
         {
             return _textures.size();
@@ -144,8 +174,7 @@ namespace Kmplete
                 return false;
             }
 
-            const auto [iterator, hasEmplaced] = _textures.emplace(ErrorTextureSID, CreateUPtr<Assets::TextureAsset>(ErrorTextureSID, texture, TextureSubTypeMaskBits::SRGB));
-            return hasEmplaced;
+            return _EmplaceAsset(ErrorTextureSID, texture, TextureSubTypeMaskBits::SRGB);
         }}
         //--------------------------------------------------------------------------
 
@@ -166,5 +195,72 @@ namespace Kmplete
             return true;
         }
         //--------------------------------------------------------------------------
+
+        bool TextureAssetManager::_EmplaceAsset(StringID textureSid, NonNull<Graphics::Texture*> texture, TextureSubTypeMaskBits subTypeMask)
+        {
+            const auto bindlessIndex = _AcquireBindlessIndex(*texture);
+
+            const auto [iterator, hasEmplaced] = _textures.emplace(textureSid, CreateUPtr<Assets::TextureAsset>(textureSid, texture, subTypeMask, bindlessIndex));
+            if (not hasEmplaced)
+            {
+                _ReleaseBindlessIndex(bindlessIndex);
+            }
+
+            return hasEmplaced;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 TextureAssetManager::_AcquireBindlessIndex(const Graphics::Texture& texture) KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            if (_bindlessTexturesCount == 0)
+            {
+                return ErrorTextureBindlessIndex;
+            }
+
+            UInt32 bindlessIndex = ErrorTextureBindlessIndex;
+            if (not _freeBindlessIndices.empty())
+            {
+                bindlessIndex = _freeBindlessIndices.back();
+                _freeBindlessIndices.pop_back();
+            }
+            else if (_nextBindlessIndex < _bindlessTexturesCount)
+            {
+                bindlessIndex = _nextBindlessIndex++;
+            }
+            else
+            {
+                KMP_LOG_WARN("bindless textures array of '{}' slots is full, error texture slot is used instead", _bindlessTexturesCount);
+                return ErrorTextureBindlessIndex;
+            }
+
+            if (not _graphicsBackend.SetBindlessTexture(bindlessIndex, texture))
+            {
+                KMP_LOG_ERROR("failed to set bindless texture slot '{}', error texture slot is used instead", bindlessIndex);
+                _ReleaseBindlessIndex(bindlessIndex);
+                return ErrorTextureBindlessIndex;
+            }
+
+            return bindlessIndex;
+        }}
+        //--------------------------------------------------------------------------
+
+        void TextureAssetManager::_ReleaseBindlessIndex(UInt32 bindlessIndex) KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            // the error texture slot is shared by the textures that have no slot of their own, and the error texture is never removed
+            if (bindlessIndex == ErrorTextureBindlessIndex)
+            {
+                return;
+            }
+
+            // a stale index might still be sampled, so the slot must not keep the view of the texture being destroyed
+            const auto errorTextureIterator = _textures.find(ErrorTextureSID);
+            if (errorTextureIterator != _textures.end() && not _graphicsBackend.SetBindlessTexture(bindlessIndex, errorTextureIterator->second->GetTexture()))
+            {
+                KMP_LOG_ERROR("failed to reset bindless texture slot '{}' to the error texture", bindlessIndex);
+            }
+
+            _freeBindlessIndices.push_back(bindlessIndex);
+        }}
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
@@ -38,16 +38,17 @@ namespace Kmplete
     }}
     //--------------------------------------------------------------------------
 
-    bool SettingsManager::LoadSettings() KMP_PROFILING(ProfileLevelImportant)
+    bool SettingsManager::LoadSettings(JsonLoadMode loadMode /*= JsonLoadMode::InSitu*/) KMP_PROFILING(ProfileLevelImportant)
     {
-        JsonDocument document(_filepath);
+        JsonDocument document(_filepath, loadMode);
         if (document.HasError())
         {
             KMP_LOG_WARN("failed to load settings from '{}' - {}", _filepath, document.ErrorDescription());
             return false;
         }
 
-        const auto documentChildren = document.GetChildren();
+        // children are moved out of the loaded document (sharing its memory) instead of being deep copied
+        const auto documentChildren = document.ExtractChildren();
         for (const auto& [name, childDocument] : documentChildren)
         {
             if (_namedSettingsDocuments.contains(name))
@@ -66,7 +67,9 @@ namespace Kmplete
 
     bool SettingsManager::SaveSettings() const KMP_PROFILING(ProfileLevelImportant)
     {
-        JsonDocument summaryDocument;
+        // settings entries are serialized in place, without being merged into an intermediate document
+        Vector<Pair<String, JsonView>> summaryChildren;
+        summaryChildren.reserve(_namedSettingsDocuments.size());
 
         for (const auto& [settingsEntryName, settingsEntry] : _namedSettingsDocuments)
         {
@@ -76,11 +79,19 @@ namespace Kmplete
             }
             else
             {
-                summaryDocument.AddChildDocument(settingsEntryName, settingsEntry->GetDocument());
+                const auto view = settingsEntry->GetDocument().GetView();
+                if (view.IsObject())
+                {
+                    summaryChildren.emplace_back(settingsEntryName, view);
+                }
+                else
+                {
+                    KMP_LOG_ERROR("settings entry named '{}' is not an object - save settings will be incompleted", settingsEntryName);
+                }
             }
         }
 
-        const auto ok = summaryDocument.Save(_filepath);
+        const auto ok = JsonDocument::SaveComposite(_filepath, summaryChildren);
         if (ok)
         {
             KMP_LOG_INFO("settings successfully saved to '{}'", _filepath);
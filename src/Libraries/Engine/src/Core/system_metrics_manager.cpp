@@ -56,6 +56,8 @@ namespace Kmplete
             {
                 return false;
             }
+
+            KMP_PROFILE_COUNTER("Threads count", _systemMetrics.numThreads);
         }
 
         if (updateMode & SystemMetricsManager::SystemMetricsUpdateMode::MemoryUsed)
@@ -64,6 +66,9 @@ namespace Kmplete
             {
                 return false;
             }
+
+            KMP_PROFILE_COUNTER("Physical memory used (MiB)", _systemMetrics.physicalMemoryUsedMib);
+            KMP_PROFILE_COUNTER("Virtual memory used (MiB)", _systemMetrics.virtualMemoryUsedMib);
         }
 
         if (updateMode & SystemMetricsManager::SystemMetricsUpdateMode::CPUUsed)
@@ -72,6 +77,8 @@ namespace Kmplete
             {
                 return false;
             }
+
+            KMP_PROFILE_COUNTER("CPU usage (%)", _systemMetrics.cpuUsagePercent);
         }
 
         if (updateMode & SystemMetricsManager::SystemMetricsUpdateMode::StackUsed)
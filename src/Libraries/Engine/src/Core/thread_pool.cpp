@@ -0,0 +1,178 @@
+#include "Kmplete/Core/thread_pool.h"
+#include "Kmplete/Base/exception.h"
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <atomic>
+#include <latch>
+
+
+namespace Kmplete
+{
+    namespace
+    {
+        KMP_NODISCARD UInt32 GetDefaultThreadsCount() noexcept
+        {
+            const auto hardwareConcurrency = std::thread::hardware_concurrency();
+            return hardwareConcurrency > 1 ? UInt32(hardwareConcurrency - 1) : 1U;
+        }
+        //--------------------------------------------------------------------------
+    }
+
+
+    ThreadPool::ThreadPool(UInt32 threadsCount /*= 0*/)
+        : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+          _threadsCount(threadsCount == 0 ? GetDefaultThreadsCount() : threadsCount)
+        , _activeTasksCount(0)
+        , _stopping(false)
+    {
+        _Initialize();
+
+        KMP_PROFILE_CONSTRUCTOR_END()
+    }
+    //--------------------------------------------------------------------------
+
+    ThreadPool::~ThreadPool() KMP_PROFILING(ProfileLevelAlways)
+    {
+        _Finalize();
+    }}
+    //--------------------------------------------------------------------------
+
+    void ThreadPool::Submit(Task&& task)
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _tasks.push(std::move(task));
+        }
+
+        _taskAvailableCondition.notify_one();
+    }
+    //--------------------------------------------------------------------------
+
+    void ThreadPool::WaitIdle() KMP_PROFILING(ProfileLevelImportantVerbose)
+    {
+        std::unique_lock lock(_mutex);
+        _idleCondition.wait(lock, [this]() { return _tasks.empty() && _activeTasksCount == 0; });
+    }}
+    //--------------------------------------------------------------------------
+
+    void ThreadPool::ParallelFor(UInt64 count, const IndexedTask& task) KMP_PROFILING(ProfileLevelImportantVerbose)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // indices are handed out one by one, so uneven tasks (e.g. images of different size) balance out naturally;
+        // the calling thread takes part as well, which means this function must not be called from a task of this pool
+        std::atomic<UInt64> nextIndex = 0;
+        const auto processIndices = [&]() {
+            for (auto index = nextIndex++; index < count; index = nextIndex++)
+            {
+                _ExecuteTask([&]() { task(index); });
+            }
+        };
+
+        const auto helpersCount = static_cast<std::ptrdiff_t>(std::min(UInt64(_threadsCount), count - 1));
+        std::latch helpersDone(helpersCount);
+        for (auto i = 0; i < helpersCount; i++)
+        {
+            Submit([&]() {
+                processIndices();
+                helpersDone.count_down();
+            });
+        }
+
+        processIndices();
+        helpersDone.wait();
+    }}
+    //--------------------------------------------------------------------------
+
+    UInt32 ThreadPool::GetThreadsCount() const noexcept
+    {
+        return _threadsCount;
+    }
+    //--------------------------------------------------------------------------
+
+    void ThreadPool::_Initialize()
+    {
+        _workers.reserve(_threadsCount);
+        for (UInt32 i = 0; i < _threadsCount; i++)
+        {
+            _workers.emplace_back(&ThreadPool::_WorkerLoop, this);
+        }
+
+        KMP_LOG_INFO("started {} worker threads", _threadsCount);
+    }
+    //--------------------------------------------------------------------------
+
+    void ThreadPool::_Finalize()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+
+        _taskAvailableCondition.notify_all();
+
+        for (auto& worker : _workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+
+        _workers.clear();
+    }
+    //--------------------------------------------------------------------------
+
+    void ThreadPool::_WorkerLoop()
+    {
+        while (true)
+        {
+            Task task;
+            {
+                std::unique_lock lock(_mutex);
+                _taskAvailableCondition.wait(lock, [this]() { return _stopping || not _tasks.empty(); });
+
+                // remaining tasks are still executed on shutdown, so nobody waits forever for a dropped task
+                if (_tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(_tasks.front());
+                _tasks.pop();
+                _activeTasksCount++;
+            }
+
+            _ExecuteTask(task);
+
+            {
+                std::lock_guard lock(_mutex);
+                _activeTasksCount--;
+            }
+
+            _idleCondition.notify_all();
+        }
+    }
+    //--------------------------------------------------------------------------
+
+    void ThreadPool::_ExecuteTask(const Task& task) const
+    {
+        try
+        {
+            task();
+        }
+        catch (KMP_MB_UNUSED const Exception& e)
+        {
+            KMP_LOG_ERROR("task failed with exception: {}", e.what());
+        }
+        catch (...)
+        {
+            KMP_LOG_ERROR("task failed with unknown exception");
+        }
+    }
+    //--------------------------------------------------------------------------
+}
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer.h"
-#include "Kmplete/Graphics/Vulkan/Delegates/vulkan_memory_type_delegate.h"
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
 #include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
@@ -16,16 +15,17 @@ namespace Kmplete
         using namespace VKBits;
 
 
-        VulkanBuffer::VulkanBuffer(const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkDevice device, const VulkanBufferParameters& parameters)
+        VulkanBuffer::VulkanBuffer(VulkanMemoryAllocator& memoryAllocator, VkDevice device, const VulkanBufferParameters& parameters)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(device)
             , _buffer(VK_NULL_HANDLE)
-            , _memory(VK_NULL_HANDLE)
+            , _memoryAllocator(&memoryAllocator)
+            , _allocation()
             , _size(parameters.size)
             , _mapped(nullptr)
             , _usageFlags(parameters.usageFlags)
         {
-            _Initialize(memoryTypeDelegate, parameters);
+            _Initialize(parameters);
 
             KMP_PROFILE_CONSTRUCTOR_END()
         }
@@ -35,18 +35,20 @@ namespace Kmplete
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(other._device)
             , _buffer(other._buffer)
-            , _memory(other._memory)
+            , _memoryAllocator(other._memoryAllocator)
+            , _allocation(other._allocation)
             , _size(other._size)
             , _mapped(other._mapped)
             , _usageFlags(other._usageFlags)
         {
             other._device = VK_NULL_HANDLE;
             other._buffer = VK_NULL_HANDLE;
-            other._memory = VK_NULL_HANDLE;
+            other._memoryAllocator = nullptr;
+            other._allocation = VulkanMemoryAllocation{};
             other._size = 0ULL;
             other._mapped = nullptr;
 
-            KMP_ASSERT(_device && _buffer && _memory);
+            KMP_ASSERT(_device && _buffer && _memoryAllocator && _allocation.IsValid());
             KMP_PROFILE_CONSTRUCTOR_END()
         }
         //--------------------------------------------------------------------------
@@ -63,7 +65,8 @@ namespace Kmplete
 
             _device = other._device;
             _buffer = other._buffer;
-            _memory = other._memory;
+            _memoryAllocator = other._memoryAllocator;
+            _allocation = other._allocation;
             _size = other._size;
             _mapped = other._mapped;
             _usageFlags = other._usageFlags;
@@ -71,11 +74,12 @@ namespace Kmplete
             other.Unmap();
             other._device = VK_NULL_HANDLE;
             other._buffer = VK_NULL_HANDLE;
-            other._memory = VK_NULL_HANDLE;
+            other._memoryAllocator = nullptr;
+            other._allocation = VulkanMemoryAllocation{};
             other._size = 0ULL;
             other._mapped = nullptr;
 
-            KMP_ASSERT(_device && _buffer && _memory);
+            KMP_ASSERT(_device && _buffer && _memoryAllocator && _allocation.IsValid());
 
             return *this;
         }}
@@ -89,15 +93,15 @@ namespace Kmplete
 
         VkResult VulkanBuffer::Map(VkDeviceSize size /*= VK_WHOLE_SIZE*/, VkDeviceSize offset /*= 0*/) KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_device && _memory);
+            KMP_ASSERT(_memoryAllocator && _allocation.IsValid());
 
-            return vkMapMemory(_device, _memory, offset, size, 0, &_mapped);
+            return _memoryAllocator->Map(_allocation, size, offset, &_mapped);
         }}
         //--------------------------------------------------------------------------
 
         VkResult VulkanBuffer::Unmap(bool flush /*= false*/, VkDeviceSize size/* = VK_WHOLE_SIZE*/, VkDeviceSize offset /*= 0*/) KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_device && _memory);
+            KMP_ASSERT(_memoryAllocator && _allocation.IsValid());
 
             auto result = VK_SUCCESS;
             if (flush)
@@ -107,7 +111,7 @@ namespace Kmplete
 
             if (_mapped)
             {
-                vkUnmapMemory(_device, _memory);
+                _memoryAllocator->Unmap(_allocation);
                 _mapped = nullptr;
             }
 
@@ -117,23 +121,17 @@ namespace Kmplete
 
         VkResult VulkanBuffer::Flush(VkDeviceSize size /*= VK_WHOLE_SIZE*/, VkDeviceSize offset /*= 0*/) KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_device && _memory);
+            KMP_ASSERT(_memoryAllocator && _allocation.IsValid());
 
-            auto mappedRange = VKUtils::InitVkMappedMemoryRange(size, offset);
-            mappedRange.memory = _memory;
-
-            return vkFlushMappedMemoryRanges(_device, 1, &mappedRange);
+            return _memoryAllocator->Flush(_allocation, size, offset);
         }}
         //--------------------------------------------------------------------------
 
         VkResult VulkanBuffer::Invalidate(VkDeviceSize size /*= VK_WHOLE_SIZE*/, VkDeviceSize offset /*= 0*/) KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_device && _memory);
-
-            auto mappedRange = VKUtils::InitVkMappedMemoryRange(size, offset);
-            mappedRange.memory = _memory;
+            KMP_ASSERT(_memoryAllocator && _allocation.IsValid());
 
-            return vkInvalidateMappedMemoryRanges(_device, 1, &mappedRange);
+            return _memoryAllocator->Invalidate(_allocation, size, offset);
         }}
         //--------------------------------------------------------------------------
 
@@ -231,9 +229,9 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
-        void VulkanBuffer::_Initialize(const VulkanMemoryTypeDelegate& memoryTypeDelegate, const VulkanBufferParameters& parameters)
+        void VulkanBuffer::_Initialize(const VulkanBufferParameters& parameters)
         {
-            KMP_ASSERT(_device);
+            KMP_ASSERT(_device && _memoryAllocator);
 
             auto bufferCreateInfo = VKUtils::InitVkBufferCreateInfo(_size, _usageFlags);
 
@@ -241,19 +239,10 @@ namespace Kmplete
             VKUtils::CheckResult(result, "VulkanBuffer: failed to create buffer object");
             KMP_ASSERT(_buffer);
 
-            auto bufferMemoryContext = memoryTypeDelegate.GetBufferMemoryContext(_device, _buffer, parameters.memoryPropertyFlags);
-            VkMemoryAllocateFlagsInfoKHR allocateFlagsInfo = VKUtils::InitVkMemoryAllocateFlagsInfoKHR();
-            if (IsShaderDeviceAddressBuffer())
-            {
-                allocateFlagsInfo.flags = VK_MemoryAllocate_DeviceAddress;
-                bufferMemoryContext.allocateInfo.pNext = &allocateFlagsInfo;
-            }
-
-            result = vkAllocateMemory(_device, &bufferMemoryContext.allocateInfo, nullptr, &_memory);
-            VKUtils::CheckResult(result, "VulkanBuffer: failed to allocate buffer memory");
-            KMP_ASSERT(_memory);
+            _allocation = _memoryAllocator->AllocateBufferMemory(_buffer, parameters.memoryPropertyFlags, parameters.memoryStrategy, IsShaderDeviceAddressBuffer());
+            KMP_ASSERT(_allocation.IsValid());
 
-            result = vkBindBufferMemory(_device, _buffer, _memory, 0);
+            result = vkBindBufferMemory(_device, _buffer, _allocation.memory, _allocation.offset);
             VKUtils::CheckResult(result, "VulkanBuffer: failed to bind buffer");
         }
         //--------------------------------------------------------------------------
@@ -265,9 +254,15 @@ namespace Kmplete
                 vkDestroyBuffer(_device, _buffer, nullptr);
             }
 
-            if (_memory && _device)
+            if (_memoryAllocator && _allocation.IsValid())
             {
-                vkFreeMemory(_device, _memory, nullptr);
+                if (_mapped)
+                {
+                    _memoryAllocator->Unmap(_allocation);
+                    _mapped = nullptr;
+                }
+
+                _memoryAllocator->Free(_allocation);
             }
         }
         //--------------------------------------------------------------------------
@@ -1,5 +1,5 @@
 #include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer_manager.h"
-#include "Kmplete/Graphics/Vulkan/Delegates/vulkan_memory_type_delegate.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
 #include "Kmplete/Core/assertion.h"
 #include "Kmplete/Profile/profiler.h"
@@ -13,10 +13,10 @@ namespace Kmplete
         using namespace VKBits;
 
 
-        VulkanBufferManager::VulkanBufferManager(VkDevice device, const VulkanMemoryTypeDelegate& memoryTypeDelegate)
+        VulkanBufferManager::VulkanBufferManager(VkDevice device, VulkanMemoryAllocator& memoryAllocator)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(device)
-            , _memoryTypeDelegate(memoryTypeDelegate)
+            , _memoryAllocator(memoryAllocator)
             , _buffers()
             , _vertexBuffers()
             , _perFrameBuffers()
@@ -361,33 +361,35 @@ namespace Kmplete
 
         VulkanBuffer VulkanBufferManager::_CreateBuffer(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return VulkanBuffer(_memoryTypeDelegate, _device, parameters);
+            return VulkanBuffer(_memoryAllocator, _device, parameters);
         }}
         //--------------------------------------------------------------------------
 
         Nullable<VulkanBuffer*> VulkanBufferManager::_CreateBufferPtr(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return new VulkanBuffer(_memoryTypeDelegate, _device, parameters);
+            return new VulkanBuffer(_memoryAllocator, _device, parameters);
         }}
         //--------------------------------------------------------------------------
 
 
         VulkanVertexBuffer VulkanBufferManager::_CreateVertexBuffer(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return VulkanVertexBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return VulkanVertexBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Vertex | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
 
         Nullable<VulkanVertexBuffer*> VulkanBufferManager::_CreateVertexBufferPtr(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return new VulkanVertexBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return new VulkanVertexBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Vertex | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
@@ -395,20 +397,22 @@ namespace Kmplete
 
         VulkanBuffer VulkanBufferManager::_CreateIndexBuffer(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Index | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
 
         Nullable<VulkanBuffer*> VulkanBufferManager::_CreateIndexBufferPtr(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return new VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return new VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Index | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
@@ -416,20 +420,22 @@ namespace Kmplete
 
         VulkanBuffer VulkanBufferManager::_CreateUniformBuffer(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Uniform | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
 
         Nullable<VulkanBuffer*> VulkanBufferManager::_CreateUniformBufferPtr(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return new VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return new VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Uniform | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
@@ -437,20 +443,22 @@ namespace Kmplete
 
         VulkanBuffer VulkanBufferManager::_CreateStorageBuffer(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Storage | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
 
         Nullable<VulkanBuffer*> VulkanBufferManager::_CreateStorageBufferPtr(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return new VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return new VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Storage | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
@@ -458,20 +466,22 @@ namespace Kmplete
 
         VulkanBuffer VulkanBufferManager::_CreateIndirectBuffer(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Indirect | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
 
         Nullable<VulkanBuffer*> VulkanBufferManager::_CreateIndirectBufferPtr(const VulkanBufferParameters& parameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            return new VulkanBuffer(_memoryTypeDelegate, _device, VulkanBufferParameters{
+            return new VulkanBuffer(_memoryAllocator, _device, VulkanBufferParameters{
                 .usageFlags = VK_BufferUsage_Indirect | parameters.usageFlags,
                 .memoryPropertyFlags = parameters.memoryPropertyFlags,
-                .size = parameters.size
+                .size = parameters.size,
+                .memoryStrategy = parameters.memoryStrategy
             });
         }}
         //--------------------------------------------------------------------------
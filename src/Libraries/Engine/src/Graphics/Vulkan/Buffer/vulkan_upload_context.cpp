@@ -0,0 +1,405 @@
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_upload_context.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_queue.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
+#include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
+#include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Math/math.h"
+#include "Kmplete/Profile/profiler.h"
+#include "Kmplete/Log/log.h"
+
+#include <cstring>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        using namespace VKBits;
+
+
+        VulkanUploadContext::VulkanUploadContext(VkDevice device, VulkanMemoryAllocator& memoryAllocator, const VulkanQueue& queue, UInt32 queueFamilyIndex, VkDeviceSize ringSize)
+            : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+              _device(device)
+            , _memoryAllocator(memoryAllocator)
+            , _queue(queue)
+            , _ringSize(Math::AlignUp(ringSize, MaxAlignment))
+            , _commandPool(nullptr)
+            , _ringBuffer(nullptr)
+            , _ringMapped(nullptr)
+            , _timelineSemaphore(VK_NULL_HANDLE)
+            , _ringHead(0ULL)
+            , _ringTail(0ULL)
+            , _lastSubmittedValue(0ULL)
+            , _recordingBatch(nullptr)
+            , _inFlightBatches()
+            , _freeCommandBuffers()
+        {
+            KMP_ASSERT(_device);
+
+            _commandPool.reset(new VulkanCommandPool(_device, queueFamilyIndex));
+            KMP_ASSERT(_commandPool);
+
+            _Initialize();
+
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanUploadContext::~VulkanUploadContext() KMP_PROFILING(ProfileLevelAlways)
+        {
+            _Finalize();
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanUploadTicket VulkanUploadContext::Upload(const void* data, VkDeviceSize size, VkDeviceSize alignment, const RecordFunction& recordFunction) KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(size > 0 && alignment <= MaxAlignment);
+
+            const auto region = size > _ringSize
+                ? _AllocateTemporaryStaging(size)
+                : _AllocateStaging(size, alignment);
+
+            if (data)
+            {
+                std::memcpy(region.mapped, data, size);
+            }
+
+            auto& batch = _GetRecordingBatch();
+            recordFunction(batch.commandBuffer.GetVkCommandBuffer(), region);
+
+            return VulkanUploadTicket{ batch.value };
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanUploadTicket VulkanUploadContext::UploadBuffer(const VulkanBuffer& destinationBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset /*= 0*/)
+        {
+            KMP_ASSERT(destinationBuffer.IsTransferDestinationBuffer());
+
+            return Upload(data, size, 16, [&destinationBuffer, size, dstOffset](VkCommandBuffer commandBuffer, const VulkanStagingRegion& region) {
+                const VkBufferCopy copyRegion{
+                    .srcOffset = region.offset,
+                    .dstOffset = dstOffset,
+                    .size = size
+                };
+                vkCmdCopyBuffer(commandBuffer, region.buffer, destinationBuffer.GetVkBuffer(), 1, &copyRegion);
+            });
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanUploadTicket VulkanUploadContext::Record(const Function<void(VkCommandBuffer)>& recordFunction) KMP_PROFILING(ProfileLevelMinor)
+        {
+            auto& batch = _GetRecordingBatch();
+            recordFunction(batch.commandBuffer.GetVkCommandBuffer());
+
+            return VulkanUploadTicket{ batch.value };
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanUploadTicket VulkanUploadContext::Flush() KMP_PROFILING(ProfileLevelMinor)
+        {
+            if (_recordingBatch)
+            {
+                _SubmitRecordingBatch();
+            }
+
+            _RetireCompletedBatches();
+
+            return VulkanUploadTicket{ _lastSubmittedValue };
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanUploadContext::Wait(VulkanUploadTicket ticket) KMP_PROFILING(ProfileLevelImportant)
+        {
+            if (not ticket.IsValid())
+            {
+                return;
+            }
+
+            if (ticket.value > _lastSubmittedValue)
+            {
+                KMP_ASSERT(_recordingBatch && _recordingBatch->value == ticket.value);
+                _SubmitRecordingBatch();
+            }
+
+            _WaitValue(ticket.value);
+            _RetireCompletedBatches();
+        }}
+        //--------------------------------------------------------------------------
+
+        bool VulkanUploadContext::IsComplete(VulkanUploadTicket ticket) const
+        {
+            if (not ticket.IsValid())
+            {
+                return true;
+            }
+
+            if (ticket.value > _lastSubmittedValue)
+            {
+                return false;
+            }
+
+            return _GetCompletedValue() >= ticket.value;
+        }
+        //--------------------------------------------------------------------------
+
+        VkSemaphore VulkanUploadContext::GetTimelineSemaphore() const noexcept
+        {
+            KMP_ASSERT(_timelineSemaphore);
+
+            return _timelineSemaphore;
+        }
+        //--------------------------------------------------------------------------
+
+        VkDeviceSize VulkanUploadContext::GetRingSize() const noexcept
+        {
+            return _ringSize;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 VulkanUploadContext::GetSubmittedBatchesCount() const noexcept
+        {
+            return _lastSubmittedValue;
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanUploadContext::_Initialize()
+        {
+            _ringBuffer.reset(new VulkanBuffer(_memoryAllocator, _device, { VK_BufferUsage_TransferSrc, VK_Memory_HostVisible | VK_Memory_HostCoherent, _ringSize, VulkanMemoryStrategy::Dedicated }));
+            KMP_ASSERT(_ringBuffer);
+
+            const auto mapResult = _ringBuffer->Map();
+            VKUtils::CheckResult(mapResult, "VulkanUploadContext: failed to map staging ring buffer");
+
+            _ringMapped = static_cast<UByte*>(_ringBuffer->GetMappedPtr());
+            KMP_ASSERT(_ringMapped);
+
+            auto semaphoreTypeCreateInfo = VKUtils::InitVkSemaphoreTypeCreateInfo(VK_SEMAPHORE_TYPE_TIMELINE, 0ULL);
+            auto semaphoreCreateInfo = VKUtils::InitVkSemaphoreCreateInfo();
+            semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+
+            const auto result = vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &_timelineSemaphore);
+            VKUtils::CheckResult(result, "VulkanUploadContext: failed to create timeline semaphore");
+            KMP_ASSERT(_timelineSemaphore);
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanUploadContext::_Finalize()
+        {
+            if (_recordingBatch)
+            {
+                _SubmitRecordingBatch();
+            }
+
+            if (_lastSubmittedValue > 0)
+            {
+                _WaitValue(_lastSubmittedValue);
+            }
+
+            _inFlightBatches.clear();
+            _freeCommandBuffers.clear();
+
+            if (_ringBuffer)
+            {
+                _ringBuffer->Unmap();
+                _ringBuffer.reset();
+            }
+
+            if (_timelineSemaphore)
+            {
+                vkDestroySemaphore(_device, _timelineSemaphore, nullptr);
+            }
+
+            _commandPool.reset();
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanStagingRegion VulkanUploadContext::_AllocateStaging(VkDeviceSize size, VkDeviceSize alignment) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            KMP_ASSERT(size <= _ringSize);
+
+            _RetireCompletedBatches();
+
+            while (true)
+            {
+                // ring offsets grow monotonically, physical offset is taken modulo ring size;
+                // an allocation never straddles the end of the ring, instead it is moved to the next lap
+                auto offset = Math::AlignUp(_ringHead, alignment);
+                if ((offset % _ringSize) + size > _ringSize)
+                {
+                    offset = (offset / _ringSize + 1) * _ringSize;
+                }
+
+                if (offset + size - _ringTail <= _ringSize)
+                {
+                    _ringHead = offset + size;
+
+                    const auto physicalOffset = offset % _ringSize;
+                    return VulkanStagingRegion{
+                        .buffer = _ringBuffer->GetVkBuffer(),
+                        .offset = physicalOffset,
+                        .size = size,
+                        .mapped = _ringMapped + physicalOffset
+                    };
+                }
+
+                if (_inFlightBatches.empty())
+                {
+                    KMP_ASSERT(_recordingBatch);
+                    _SubmitRecordingBatch();
+                }
+
+                KMP_LOG_DEBUG("staging ring is full, waiting for upload batch {}", _inFlightBatches.front()->value);
+                _WaitValue(_inFlightBatches.front()->value);
+                _RetireCompletedBatches();
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanStagingRegion VulkanUploadContext::_AllocateTemporaryStaging(VkDeviceSize size) KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_LOG_DEBUG("upload of {} bytes exceeds staging ring size {}, using a temporary staging buffer", size, _ringSize);
+
+            auto& batch = _GetRecordingBatch();
+            auto& buffer = batch.temporaryBuffers.emplace_back(_memoryAllocator, _device, VulkanBufferParameters{ VK_BufferUsage_TransferSrc, VK_Memory_HostVisible | VK_Memory_HostCoherent, size, VulkanMemoryStrategy::Dedicated });
+
+            const auto result = buffer.Map();
+            VKUtils::CheckResult(result, "VulkanUploadContext: failed to map temporary staging buffer");
+
+            return VulkanStagingRegion{
+                .buffer = buffer.GetVkBuffer(),
+                .offset = 0ULL,
+                .size = size,
+                .mapped = static_cast<UByte*>(buffer.GetMappedPtr())
+            };
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanUploadContext::UploadBatch& VulkanUploadContext::_GetRecordingBatch() KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            if (_recordingBatch)
+            {
+                return *_recordingBatch.get();
+            }
+
+            if (_freeCommandBuffers.empty())
+            {
+                _freeCommandBuffers.emplace_back(_device, _commandPool->GetVkCommandPool());
+            }
+
+            _recordingBatch.reset(new UploadBatch{
+                .commandBuffer = std::move(_freeCommandBuffers.back()),
+                .value = _lastSubmittedValue + 1,
+                .ringEnd = 0ULL,
+                .temporaryBuffers = {}
+            });
+            _freeCommandBuffers.pop_back();
+
+            _recordingBatch->commandBuffer.Reset();
+            _recordingBatch->commandBuffer.Begin(VK_CommandBufferUsage_OneTimeSubmit);
+
+            return *_recordingBatch.get();
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanUploadContext::_SubmitRecordingBatch() KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_recordingBatch);
+
+            _recordingBatch->commandBuffer.End();
+            _recordingBatch->ringEnd = _ringHead;
+
+            const auto commandBuffer = _recordingBatch->commandBuffer.GetVkCommandBuffer();
+            const auto signalValue = _recordingBatch->value;
+
+            auto timelineSubmitInfo = VKUtils::InitVkTimelineSemaphoreSubmitInfo();
+            timelineSubmitInfo.signalSemaphoreValueCount = 1;
+            timelineSubmitInfo.pSignalSemaphoreValues = &signalValue;
+
+            auto submitInfo = VKUtils::InitVkSubmitInfo();
+            submitInfo.pNext = &timelineSubmitInfo;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &_timelineSemaphore;
+
+            _queue.Submit({ submitInfo }, VK_NULL_HANDLE);
+
+            _lastSubmittedValue = signalValue;
+            _inFlightBatches.push_back(std::move(_recordingBatch));
+
+            KMP_PROFILE_ASYNC_BEGIN("Upload batch", signalValue);
+            KMP_PROFILE_COUNTER("Upload batches in flight", _inFlightBatches.size());
+            KMP_PROFILE_COUNTER("Upload ring used (KiB)", double(_ringHead - _ringTail) / 1024.0);
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanUploadContext::_RetireCompletedBatches() KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            if (_inFlightBatches.empty())
+            {
+                if (not _recordingBatch)
+                {
+                    _ringHead = 0ULL;
+                    _ringTail = 0ULL;
+                }
+
+                return;
+            }
+
+            const auto completedValue = _GetCompletedValue();
+
+            size_t retiredCount = 0;
+            for (auto& batch : _inFlightBatches)
+            {
+                if (batch->value > completedValue)
+                {
+                    break;
+                }
+
+                _ringTail = batch->ringEnd;
+                _freeCommandBuffers.push_back(std::move(batch->commandBuffer));
+                retiredCount++;
+
+                KMP_PROFILE_ASYNC_END("Upload batch", batch->value);
+            }
+
+            _inFlightBatches.erase(_inFlightBatches.begin(), _inFlightBatches.begin() + retiredCount);
+
+            // nothing references the ring anymore, so the next allocation may start from its beginning
+            if (_inFlightBatches.empty() && not _recordingBatch)
+            {
+                _ringHead = 0ULL;
+                _ringTail = 0ULL;
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanUploadContext::_WaitValue(UInt64 value) const KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_timelineSemaphore && value <= _lastSubmittedValue);
+
+            auto waitInfo = VKUtils::InitVkSemaphoreWaitInfo();
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &_timelineSemaphore;
+            waitInfo.pValues = &value;
+
+            const auto result = vkWaitSemaphores(_device, &waitInfo, UINT64_MAX);
+            VKUtils::CheckResult(result, "VulkanUploadContext: failed to wait for timeline semaphore");
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt64 VulkanUploadContext::_GetCompletedValue() const
+        {
+            KMP_ASSERT(_timelineSemaphore);
+
+            UInt64 value = 0ULL;
+            const auto result = vkGetSemaphoreCounterValue(_device, _timelineSemaphore, &value);
+            VKUtils::CheckResult(result, "VulkanUploadContext: failed to get timeline semaphore value");
+
+            return value;
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
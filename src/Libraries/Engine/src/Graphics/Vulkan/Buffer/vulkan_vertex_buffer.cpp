@@ -1,6 +1,5 @@
 #include "Kmplete/Graphics/Vulkan/Buffer/vulkan_vertex_buffer.h"
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_graphics_base.h"
-#include "Kmplete/Graphics/Vulkan/Delegates/vulkan_memory_type_delegate.h"
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
 #include "Kmplete/Profile/profiler.h"
@@ -13,8 +12,8 @@ namespace Kmplete
         using namespace VKBits;
 
 
-        VulkanVertexBuffer::VulkanVertexBuffer(const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkDevice device, const VulkanBufferParameters& parameters)
-            : VulkanBuffer(memoryTypeDelegate, device, parameters)
+        VulkanVertexBuffer::VulkanVertexBuffer(VulkanMemoryAllocator& memoryAllocator, VkDevice device, const VulkanBufferParameters& parameters)
+            : VulkanBuffer(memoryAllocator, device, parameters)
               KMP_PROFILE_CONSTRUCTOR_START_DERIVED_CLASS()
             , _layouts()
             , _cache()
@@ -9,13 +9,13 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        VulkanCommandBuffer::VulkanCommandBuffer(VkDevice device, VkCommandPool commandPool)
+        VulkanCommandBuffer::VulkanCommandBuffer(VkDevice device, VkCommandPool commandPool, bool primary /*= true*/)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(device)
             , _commandPool(commandPool)
             , _commandBuffer(VK_NULL_HANDLE)
         {
-            _Initialize();
+            _Initialize(primary);
 
             KMP_PROFILE_CONSTRUCTOR_END()
         }
@@ -77,6 +77,19 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
+        void VulkanCommandBuffer::Begin(VkCommandBufferUsageFlags flags, const VkCommandBufferInheritanceInfo& inheritanceInfo) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(_commandBuffer);
+
+            auto commandBufferBeginInfo = VKUtils::InitVkCommandBufferBeginInfo();
+            commandBufferBeginInfo.flags |= flags;
+            commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+            const auto result = vkBeginCommandBuffer(_commandBuffer, &commandBufferBeginInfo);
+            VKUtils::CheckResult(result, "VulkanCommandBuffer: failed to begin command buffer");
+        }}
+        //--------------------------------------------------------------------------
+
         void VulkanCommandBuffer::End() const KMP_PROFILING(ProfileLevelMinor)
         {
             KMP_ASSERT(_commandBuffer);
@@ -103,11 +116,11 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
-        void VulkanCommandBuffer::_Initialize()
+        void VulkanCommandBuffer::_Initialize(bool primary)
         {
             KMP_ASSERT(_device && _commandPool);
 
-            auto commandBufferAllocateInfo = VKUtils::InitVkCommandBufferAllocateInfo();
+            auto commandBufferAllocateInfo = VKUtils::InitVkCommandBufferAllocateInfo(primary);
             commandBufferAllocateInfo.commandPool = _commandPool;
             commandBufferAllocateInfo.commandBufferCount = 1;
 
@@ -40,6 +40,15 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
+        void VulkanCommandPool::Reset() const KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(_device && _commandPool);
+
+            const auto result = vkResetCommandPool(_device, _commandPool, 0);
+            VKUtils::CheckResult(result, "VulkanCommandPool: failed to reset command pool");
+        }}
+        //--------------------------------------------------------------------------
+
         VkCommandPool VulkanCommandPool::GetVkCommandPool() const noexcept
         {
             KMP_ASSERT(_commandPool);
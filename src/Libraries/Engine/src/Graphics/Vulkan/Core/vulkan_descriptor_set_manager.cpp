@@ -18,16 +18,26 @@ namespace Kmplete
         using namespace VKBits;
 
 
-        VulkanDescriptorSetManager::VulkanDescriptorSetManager(VkDevice device, const UInt32& currentBufferIndex, UInt32 maxDescriptorSets, const Vector<VkDescriptorPoolSize>& descriptorPoolSizes)
+        VulkanDescriptorSetManager::VulkanDescriptorSetManager(VkDevice device, const UInt32& currentBufferIndex, UInt32 maxDescriptorSets, const Vector<VkDescriptorPoolSize>& descriptorPoolSizes, UInt32 bindlessTexturesCount /*= 0*/)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _currentBufferIndex(currentBufferIndex)
             , _device(device)
             , _descriptorPool(VK_NULL_HANDLE)
             , _auxDescriptorPools()
             , _descriptorSetLayouts()
+            , _descriptorUpdateTemplates()
+            , _bindlessTexturesCount(0)
+            , _bindlessDescriptorPool(VK_NULL_HANDLE)
+            , _bindlessDescriptorSet(VK_NULL_HANDLE)
+            , _bindlessImageViews()
         {
             _Initialize(maxDescriptorSets, descriptorPoolSizes);
 
+            if (bindlessTexturesCount > 0)
+            {
+                _InitializeBindlessTextures(bindlessTexturesCount);
+            }
+
             KMP_PROFILE_CONSTRUCTOR_END()
         }
         //--------------------------------------------------------------------------
@@ -360,15 +370,18 @@ namespace Kmplete
         {
             if (perFrame)
             {
+                auto writer = CreateDescriptorWriter();
+                writer.Reserve(UInt32(_descriptorsPerFrame.size()));
                 for (auto& descriptors : _descriptorsPerFrame)
                 {
                     const auto descriptorSet = _GetDescriptorSet(descriptors, setSid, setIndex);
-                    if (not SetCombinedImageSamplerDescriptor(descriptorSet, imageView, sampler, binding))
+                    if (not writer.WriteImage(descriptorSet, binding, VK_DescriptorType_CombinedImageSampler, imageView, sampler))
                     {
                         return false;
                     }
                 }
 
+                writer.Flush();
                 return true;
             }
             else
@@ -419,15 +432,18 @@ namespace Kmplete
         {
             if (perFrame)
             {
+                auto writer = CreateDescriptorWriter();
+                writer.Reserve(UInt32(_descriptorsPerFrame.size()));
                 for (auto& descriptors : _descriptorsPerFrame)
                 {
                     const auto descriptorSet = _GetDescriptorSet(descriptors, setSid, setIndex);
-                    if (not SetSampledImageDescriptor(descriptorSet, imageView, binding))
+                    if (not writer.WriteImage(descriptorSet, binding, VK_DescriptorType_SampledImage, imageView, VK_NULL_HANDLE))
                     {
                         return false;
                     }
                 }
 
+                writer.Flush();
                 return true;
             }
             else
@@ -472,15 +488,18 @@ namespace Kmplete
         {
             if (perFrame)
             {
+                auto writer = CreateDescriptorWriter();
+                writer.Reserve(UInt32(_descriptorsPerFrame.size()));
                 for (auto& descriptors : _descriptorsPerFrame)
                 {
                     const auto descriptorSet = _GetDescriptorSet(descriptors, setSid, setIndex);
-                    if (not SetSamplerDescriptor(descriptorSet, sampler, binding))
+                    if (not writer.WriteImage(descriptorSet, binding, VK_DescriptorType_Sampler, VK_NULL_HANDLE, sampler))
                     {
                         return false;
                     }
                 }
 
+                writer.Flush();
                 return true;
             }
             else
@@ -520,6 +539,160 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
+        VulkanDescriptorWriter VulkanDescriptorSetManager::CreateDescriptorWriter() const
+        {
+            KMP_ASSERT(_device);
+
+            return VulkanDescriptorWriter(_device);
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorSetManager::AddDescriptorUpdateTemplate(StringID templateSid, StringID layoutSid, const Vector<VkDescriptorUpdateTemplateEntry>& entries) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_device);
+
+            if (_descriptorUpdateTemplates.contains(templateSid))
+            {
+                KMP_LOG_WARN("descriptor update template with sid '{}' has already been created", templateSid);
+                return true;
+            }
+            if (entries.empty())
+            {
+                KMP_LOG_ERROR("cannot create descriptor update template '{}' - entries are empty", templateSid);
+                return false;
+            }
+
+            const auto layout = GetDescriptorSetLayout(layoutSid);
+            if (layout == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("cannot create descriptor update template '{}' - layout '{}' not found", templateSid, layoutSid);
+                return false;
+            }
+
+            auto templateCreateInfo = VKUtils::InitVkDescriptorUpdateTemplateCreateInfo();
+            templateCreateInfo.descriptorUpdateEntryCount = UInt32(entries.size());
+            templateCreateInfo.pDescriptorUpdateEntries = entries.data();
+            templateCreateInfo.templateType = VK_DescriptorUpdateTemplate_DescriptorSet;
+            templateCreateInfo.descriptorSetLayout = layout;
+
+            VkDescriptorUpdateTemplate updateTemplate = VK_NULL_HANDLE;
+            const auto result = vkCreateDescriptorUpdateTemplate(_device, &templateCreateInfo, nullptr, &updateTemplate);
+            if (result != VK_SUCCESS)
+            {
+                VKUtils::CheckResult(result, "VulkanDescriptorSetManager: failed to create descriptor update template", "throw exception"_false);
+                return false;
+            }
+
+            _descriptorUpdateTemplates.emplace(templateSid, updateTemplate);
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        VkDescriptorUpdateTemplate VulkanDescriptorSetManager::GetDescriptorUpdateTemplate(StringID templateSid) const noexcept
+        {
+            if (_descriptorUpdateTemplates.contains(templateSid))
+            {
+                return _descriptorUpdateTemplates.at(templateSid);
+            }
+
+            KMP_LOG_ERROR("descriptor update template with sid '{}' not found", templateSid);
+            return VK_NULL_HANDLE;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorSetManager::UpdateDescriptorSetWithTemplate(StringID setSid, UInt32 setIndex, bool perFrame, UInt32 frameIndex, StringID templateSid, const void* data) const KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            auto descriptorSet = GetDescriptorSet(setSid, setIndex, perFrame, frameIndex);
+            return UpdateDescriptorSetWithTemplate(descriptorSet, templateSid, data);
+        }}
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorSetManager::UpdateDescriptorSetWithTemplate(VkDescriptorSet descriptorSet, StringID templateSid, const void* data) const KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            KMP_ASSERT(_device);
+
+            if (descriptorSet == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to update descriptor set with template - set is null");
+                return false;
+            }
+            if (data == nullptr)
+            {
+                KMP_LOG_ERROR("failed to update descriptor set with template - data is null");
+                return false;
+            }
+
+            const auto updateTemplate = GetDescriptorUpdateTemplate(templateSid);
+            if (updateTemplate == VK_NULL_HANDLE)
+            {
+                return false;
+            }
+
+            vkUpdateDescriptorSetWithTemplate(_device, descriptorSet, updateTemplate, data);
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanDescriptorSetManager::GetBindlessTexturesCount() const noexcept
+        {
+            return _bindlessTexturesCount;
+        }
+        //--------------------------------------------------------------------------
+
+        VkDescriptorSet VulkanDescriptorSetManager::GetBindlessDescriptorSet() const noexcept
+        {
+            return _bindlessDescriptorSet;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorSetManager::SetBindlessTextureDescriptor(UInt32 index, VkImageView imageView, VkSampler sampler) const KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_device);
+
+            if (_bindlessDescriptorSet == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to set bindless texture descriptor - bindless mode is disabled");
+                return false;
+            }
+            if (index >= _bindlessTexturesCount)
+            {
+                KMP_LOG_ERROR("failed to set bindless texture descriptor - index '{}' is out of range '{}'", index, _bindlessTexturesCount);
+                return false;
+            }
+            if (imageView == VK_NULL_HANDLE || sampler == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to set bindless texture descriptor - imageView or sampler is null");
+                return false;
+            }
+
+            VkDescriptorImageInfo descriptorInfo{};
+            descriptorInfo.imageView = imageView;
+            descriptorInfo.sampler = sampler;
+            descriptorInfo.imageLayout = VK_ImageLayout_ShaderReadOnlyOptimal;
+
+            auto writeDescriptorSet = _GetWriteDescriptorSetTemplate(_bindlessDescriptorSet, VK_DescriptorType_CombinedImageSampler, BindlessTexturesBinding);
+            writeDescriptorSet.dstArrayElement = index;
+            writeDescriptorSet.pImageInfo = &descriptorInfo;
+            vkUpdateDescriptorSets(_device, 1, &writeDescriptorSet, 0, nullptr);
+            _bindlessImageViews[index] = imageView;
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        VkImageView VulkanDescriptorSetManager::GetBindlessTextureImageView(UInt32 index) const noexcept
+        {
+            if (index >= _bindlessImageViews.size())
+            {
+                return VK_NULL_HANDLE;
+            }
+
+            return _bindlessImageViews[index];
+        }
+        //--------------------------------------------------------------------------
+
         void VulkanDescriptorSetManager::_Initialize(UInt32 maxDescriptorSets, const Vector<VkDescriptorPoolSize>& descriptorPoolSizes)
         {
             KMP_ASSERT(_device);
@@ -536,10 +709,71 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        void VulkanDescriptorSetManager::_InitializeBindlessTextures(UInt32 bindlessTexturesCount)
+        {
+            KMP_ASSERT(_device);
+
+            const auto poolSize = VkDescriptorPoolSize{ VK_DescriptorType_CombinedImageSampler, bindlessTexturesCount };
+
+            auto poolInfo = VKUtils::InitVkDescriptorPoolCreateInfo();
+            poolInfo.flags = VK_DescriptorPoolCreate_UpdateAfterBind;
+            poolInfo.maxSets = 1;
+            poolInfo.poolSizeCount = 1;
+            poolInfo.pPoolSizes = &poolSize;
+
+            auto result = vkCreateDescriptorPool(_device, &poolInfo, nullptr, &_bindlessDescriptorPool);
+            VKUtils::CheckResult(result, "VulkanDescriptorSetManager: failed to create bindless descriptor pool");
+
+            const auto binding = VkDescriptorSetLayoutBinding{ BindlessTexturesBinding, VK_DescriptorType_CombinedImageSampler, bindlessTexturesCount, VK_ShaderStage_AllGraphics };
+            const VkDescriptorBindingFlags bindingFlags = VK_DescriptorBinding_PartiallyBound | VK_DescriptorBinding_UpdateAfterBind | VK_DescriptorBinding_UpdateUnusedWhilePending;
+
+            auto bindingFlagsCreateInfo = VKUtils::InitVkDescriptorSetLayoutBindingFlagsCreateInfo();
+            bindingFlagsCreateInfo.bindingCount = 1;
+            bindingFlagsCreateInfo.pBindingFlags = &bindingFlags;
+
+            auto layoutCreateInfo = VKUtils::InitVkDescriptorSetLayoutCreateInfo();
+            layoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+            layoutCreateInfo.flags = VK_DescriptorSetLayoutCreate_UpdateAfterBindPool;
+            layoutCreateInfo.bindingCount = 1;
+            layoutCreateInfo.pBindings = &binding;
+
+            VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+            result = vkCreateDescriptorSetLayout(_device, &layoutCreateInfo, nullptr, &layout);
+            VKUtils::CheckResult(result, "VulkanDescriptorSetManager: failed to create bindless descriptor set layout");
+            _descriptorSetLayouts.emplace(BindlessTexturesLayoutSID, layout);
+
+            auto descriptorSetAllocateInfo = VKUtils::InitVkDescriptorSetAllocateInfo();
+            descriptorSetAllocateInfo.descriptorPool = _bindlessDescriptorPool;
+            descriptorSetAllocateInfo.descriptorSetCount = 1;
+            descriptorSetAllocateInfo.pSetLayouts = &layout;
+
+            result = vkAllocateDescriptorSets(_device, &descriptorSetAllocateInfo, &_bindlessDescriptorSet);
+            VKUtils::CheckResult(result, "VulkanDescriptorSetManager: failed to allocate bindless descriptor set");
+
+            _bindlessTexturesCount = bindlessTexturesCount;
+            _bindlessImageViews.resize(bindlessTexturesCount, VK_NULL_HANDLE);
+            KMP_LOG_INFO("bindless mode enabled with '{}' textures", bindlessTexturesCount);
+        }
+        //--------------------------------------------------------------------------
+
         void VulkanDescriptorSetManager::_Finalize()
         {
             KMP_ASSERT(_device && _descriptorPool);
 
+            if (_bindlessDescriptorPool != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorPool(_device, _bindlessDescriptorPool, nullptr);
+                _bindlessDescriptorPool = VK_NULL_HANDLE;
+                _bindlessDescriptorSet = VK_NULL_HANDLE;
+                _bindlessImageViews.clear();
+            }
+
+            for (const auto& [sid, descriptorUpdateTemplate] : _descriptorUpdateTemplates)
+            {
+                vkDestroyDescriptorUpdateTemplate(_device, descriptorUpdateTemplate, nullptr);
+            }
+            _descriptorUpdateTemplates.clear();
+
             for (const auto& [sid, descriptorSetLayout] : _descriptorSetLayouts)
             {
                 vkDestroyDescriptorSetLayout(_device, descriptorSetLayout, nullptr);
@@ -0,0 +1,180 @@
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_descriptor_writer.h"
+#include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Profile/profiler.h"
+#include "Kmplete/Log/log.h"
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        using namespace VKBits;
+
+
+        VulkanDescriptorWriter::VulkanDescriptorWriter(VkDevice device) noexcept
+            : _device(device)
+            , _writes()
+            , _bufferInfos()
+            , _imageInfos()
+            , _infoIndices()
+        {}
+        //--------------------------------------------------------------------------
+
+        void VulkanDescriptorWriter::Reserve(UInt32 writesCount)
+        {
+            _writes.reserve(writesCount);
+            _infoIndices.reserve(writesCount);
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorWriter::WriteBuffer(VkDescriptorSet descriptorSet, UInt32 binding, VkDescriptorType type, VkBuffer buffer, VkDeviceSize range, VkDeviceSize offset /*= 0*/, UInt32 arrayElement /*= 0*/)
+        {
+            if (descriptorSet == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to write buffer descriptor - set is null");
+                return false;
+            }
+            if (buffer == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to write buffer descriptor - buffer is null");
+                return false;
+            }
+            if (not _IsBufferType(type))
+            {
+                KMP_LOG_ERROR("failed to write buffer descriptor - descriptor type '{}' is not a buffer type", static_cast<int>(type));
+                return false;
+            }
+
+            VkDescriptorBufferInfo bufferInfo{};
+            bufferInfo.buffer = buffer;
+            bufferInfo.range = range;
+            bufferInfo.offset = offset;
+
+            _infoIndices.push_back(UInt32(_bufferInfos.size()));
+            _bufferInfos.push_back(bufferInfo);
+            _writes.push_back(_CreateWrite(descriptorSet, binding, type, arrayElement));
+
+            return true;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorWriter::WriteImage(VkDescriptorSet descriptorSet, UInt32 binding, VkDescriptorType type, VkImageView imageView, VkSampler sampler, UInt32 arrayElement /*= 0*/)
+        {
+            if (descriptorSet == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to write image descriptor - set is null");
+                return false;
+            }
+            if (not _IsImageType(type))
+            {
+                KMP_LOG_ERROR("failed to write image descriptor - descriptor type '{}' is not an image type", static_cast<int>(type));
+                return false;
+            }
+            if (type != VK_DescriptorType_Sampler && imageView == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to write image descriptor - imageView is null");
+                return false;
+            }
+            if ((type == VK_DescriptorType_Sampler || type == VK_DescriptorType_CombinedImageSampler) && sampler == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("failed to write image descriptor - sampler is null");
+                return false;
+            }
+
+            VkDescriptorImageInfo imageInfo{};
+            imageInfo.sampler = sampler;
+            if (type != VK_DescriptorType_Sampler)
+            {
+                imageInfo.imageView = imageView;
+                imageInfo.imageLayout = (type == VK_DescriptorType_StorageImage) ? VK_ImageLayout_General : VK_ImageLayout_ShaderReadOnlyOptimal;
+            }
+
+            _infoIndices.push_back(UInt32(_imageInfos.size()));
+            _imageInfos.push_back(imageInfo);
+            _writes.push_back(_CreateWrite(descriptorSet, binding, type, arrayElement));
+
+            return true;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanDescriptorWriter::Flush() KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            KMP_ASSERT(_device);
+
+            if (_writes.empty())
+            {
+                return 0;
+            }
+
+            for (UInt32 i = 0; i < UInt32(_writes.size()); i++)
+            {
+                auto& write = _writes[i];
+                if (_IsBufferType(write.descriptorType))
+                {
+                    write.pBufferInfo = &_bufferInfos[_infoIndices[i]];
+                }
+                else
+                {
+                    write.pImageInfo = &_imageInfos[_infoIndices[i]];
+                }
+            }
+
+            const auto writesCount = UInt32(_writes.size());
+            vkUpdateDescriptorSets(_device, writesCount, _writes.data(), 0, nullptr);
+            Clear();
+
+            return writesCount;
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanDescriptorWriter::Clear() noexcept
+        {
+            _writes.clear();
+            _bufferInfos.clear();
+            _imageInfos.clear();
+            _infoIndices.clear();
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanDescriptorWriter::GetWritesCount() const noexcept
+        {
+            return UInt32(_writes.size());
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorWriter::IsEmpty() const noexcept
+        {
+            return _writes.empty();
+        }
+        //--------------------------------------------------------------------------
+
+        VkWriteDescriptorSet VulkanDescriptorWriter::_CreateWrite(VkDescriptorSet descriptorSet, UInt32 binding, VkDescriptorType type, UInt32 arrayElement) const noexcept
+        {
+            auto writeDescriptorSet = VKUtils::InitVkWriteDescriptorSet();
+            writeDescriptorSet.dstSet = descriptorSet;
+            writeDescriptorSet.dstBinding = binding;
+            writeDescriptorSet.dstArrayElement = arrayElement;
+            writeDescriptorSet.descriptorCount = 1;
+            writeDescriptorSet.descriptorType = type;
+
+            return writeDescriptorSet;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorWriter::_IsBufferType(VkDescriptorType type) noexcept
+        {
+            return type == VK_DescriptorType_UniformBuffer || type == VK_DescriptorType_StorageBuffer ||
+                   type == VK_DescriptorType_UniformBufferDynamic || type == VK_DescriptorType_StorageBufferDynamic;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanDescriptorWriter::_IsImageType(VkDescriptorType type) noexcept
+        {
+            return type == VK_DescriptorType_Sampler || type == VK_DescriptorType_CombinedImageSampler || type == VK_DescriptorType_SampledImage ||
+                   type == VK_DescriptorType_StorageImage || type == VK_DescriptorType_InputAttachment;
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_metrics_manager.h"
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
 #include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
 #include "Kmplete/Graphics/Vulkan/Utils/extension_functions.h"
@@ -155,6 +156,50 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        Nullable<Texture*> VulkanGraphicsBackend::CreateTexture(BinaryView texturePayload, Assets::TextureSubTypeMaskBits subTypeMask)
+        {
+            KMP_ASSERT(_physicalDevice);
+
+            return _physicalDevice->GetLogicalDevice().CreateTexture(texturePayload, subTypeMask);
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanGraphicsBackend::UpdateTexture(Texture& texture, BinaryView pixels, const TextureRegion& region)
+        {
+            KMP_ASSERT(_physicalDevice);
+
+            return _physicalDevice->GetLogicalDevice().UpdateTexture(texture, pixels, region);
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanGraphicsBackend::GetBindlessTexturesCount() const
+        {
+            KMP_ASSERT(_physicalDevice);
+
+            return _physicalDevice->GetLogicalDevice().GetBindlessTexturesCount();
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanGraphicsBackend::SetBindlessTexture(UInt32 index, const Texture& texture)
+        {
+            KMP_ASSERT(_physicalDevice);
+
+            return _physicalDevice->GetLogicalDevice().SetBindlessTexture(index, texture);
+        }
+        //--------------------------------------------------------------------------
+
+        GraphicsMemoryUsage VulkanGraphicsBackend::QueryMemoryUsage()
+        {
+            KMP_ASSERT(_physicalDevice);
+
+            const auto& metrics = _physicalDevice->GetLogicalDevice().GetMetricsManager().QueryMetrics();
+            return GraphicsMemoryUsage{
+                .budget = metrics.totalBudget,
+                .usage = metrics.totalUsage
+            };
+        }
+        //--------------------------------------------------------------------------
+
         UInt32 VulkanGraphicsBackend::GetMultisampling() const
         {
             KMP_ASSERT(_physicalDevice);
@@ -31,6 +31,34 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        VkFormat TexturePayloadFormatToVkFormat(Assets::TexturePayloadFormat format, bool srgb) noexcept
+        {
+            switch (format)
+            {
+            case Assets::TexturePayloadFormat::RGBA8:
+                return srgb ? VK_Format_RGBA8_SRGB : VK_Format_RGBA8_UNorm;
+            case Assets::TexturePayloadFormat::R8:
+                return srgb ? VK_Format_R8_SRGB : VK_Format_R8_UNorm;
+            case Assets::TexturePayloadFormat::RG8:
+                return srgb ? VK_Format_RG8_SRGB : VK_Format_RG8_UNorm;
+            case Assets::TexturePayloadFormat::BC1:
+                return srgb ? VK_Format_BC1_RGBA_SRGB_Block : VK_Format_BC1_RGBA_UNorm_Block;
+            case Assets::TexturePayloadFormat::BC3:
+                return srgb ? VK_Format_BC3_SRGB_Block : VK_Format_BC3_UNorm_Block;
+            case Assets::TexturePayloadFormat::BC4:
+                return VK_Format_BC4_UNorm_Block;
+            case Assets::TexturePayloadFormat::BC5:
+                return VK_Format_BC5_UNorm_Block;
+            case Assets::TexturePayloadFormat::BC7:
+                return srgb ? VK_Format_BC7_SRGB_Block : VK_Format_BC7_UNorm_Block;
+            default:
+                break;
+            }
+
+            return VK_Format_Undefined;
+        }
+        //--------------------------------------------------------------------------
+
         VkFormat ShaderDataTypeToVkFormat(ShaderDataType type) noexcept
         {
             switch (type)
@@ -9,6 +9,7 @@
 #include "Kmplete/Graphics/Vulkan/Utils/presets.h"
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
 #include "Kmplete/Graphics/image.h"
+#include "Kmplete/Graphics/texture_payload_decoder.h"
 #include "Kmplete/Base/named_bool.h"
 #include "Kmplete/Base/exception.h"
 #include "Kmplete/Core/assertion.h"
@@ -19,6 +20,8 @@
 #include "Kmplete/Log/log.h"
 
 #include <limits>
+#include <cstring>
+#include <algorithm>
 
 
 namespace Kmplete
@@ -43,6 +46,7 @@ namespace Kmplete
             , _device(nullptr)
             , _graphicsQueue(nullptr)
             , _presentQueue(nullptr)
+            , _memoryAllocator(nullptr)
             , _imageCreatorDelegate(nullptr)
             , _presentCompleteSemaphores()
             , _renderCompleteSemaphores()
@@ -50,6 +54,7 @@ namespace Kmplete
             , _swapchain(nullptr)
             , _descriptorSetManager(nullptr)
             , _bufferManager(nullptr)
+            , _uploadContext(nullptr)
             , _currentExtent(_UpdateExtent())
             , _msaaSamples(VK_SampleCount_1)
             , _vSync(true)
@@ -62,11 +67,13 @@ namespace Kmplete
         {
             _CreateLogicalDeviceObject();
             _CreateDeviceQueues();
+            _CreateMemoryAllocator();
             _CreateImageCreatorDelegate();
             _CreateSynchronizationObjects();
             _CreateSwapchain();
             _CreateDescriptorSetManager();
             _CreateBufferManager();
+            _CreateUploadContext();
             _CreateSamplersStorage();
             _CreatePipelineManager();
             _CreateTextureAttachmentManager();
@@ -88,11 +95,13 @@ namespace Kmplete
             _DeleteTextureAttachmentManager();
             _DeletePipelineManager();
             _DeleteSamplersStorage();
+            _DeleteUploadContext();
             _DeleteBufferManager();
             _DeleteDescriptorSetManager();
             _DeleteSwapchain();
             _DeleteSyncronizationObjects();
             _DeleteImageCreatorDelegate();
+            _DeleteMemoryAllocator();
             _DeleteDeviceQueues();
             _DeleteLogicalDeviceObject();
         }}
@@ -191,6 +200,22 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        const VulkanMemoryAllocator& VulkanLogicalDevice::GetMemoryAllocator() const noexcept
+        {
+            KMP_ASSERT(_memoryAllocator);
+
+            return *_memoryAllocator.get();
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryAllocator& VulkanLogicalDevice::GetMemoryAllocator() noexcept
+        {
+            KMP_ASSERT(_memoryAllocator);
+
+            return *_memoryAllocator.get();
+        }
+        //--------------------------------------------------------------------------
+
         const VulkanRenderer& VulkanLogicalDevice::GetRenderer() const noexcept
         {
             KMP_ASSERT(_renderer);
@@ -293,6 +318,22 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        const VulkanUploadContext& VulkanLogicalDevice::GetUploadContext() const noexcept
+        {
+            KMP_ASSERT(_uploadContext);
+
+            return *_uploadContext.get();
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanUploadContext& VulkanLogicalDevice::GetUploadContext() noexcept
+        {
+            KMP_ASSERT(_uploadContext);
+
+            return *_uploadContext.get();
+        }
+        //--------------------------------------------------------------------------
+
         const VulkanMetricsManager& VulkanLogicalDevice::GetMetricsManager() const noexcept
         {
             KMP_ASSERT(_metricsManager);
@@ -321,6 +362,14 @@ namespace Kmplete
                 ClientInitializeGraphicsParametersFn(*_graphicsParameters);
             }
 
+            // upload context relies on timeline semaphores regardless of client parameters
+            _graphicsParameters->features12.timelineSemaphore = VK_TRUE;
+
+            if (_graphicsParameters->bindlessTexturesCount > 0)
+            {
+                _EnableDescriptorIndexingFeatures();
+            }
+
             const auto queueCreateInfos = _CreateQueueCreateInfos();
 
             const auto& enabledDeviceExtensions = VulkanPhysicalDevice::GetEnabledDeviceExtensions();
@@ -341,6 +390,49 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
+        void VulkanLogicalDevice::_EnableDescriptorIndexingFeatures() KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_physicalDevice && _graphicsParameters);
+
+            auto supportedFeatures12 = VKUtils::InitVkPhysicalDeviceVulkan12Features();
+            auto supportedFeatures2 = VKUtils::InitVkPhysicalDeviceFeatures2();
+            supportedFeatures2.pNext = &supportedFeatures12;
+            vkGetPhysicalDeviceFeatures2(_physicalDevice, &supportedFeatures2);
+
+            if (not supportedFeatures12.descriptorIndexing ||
+                not supportedFeatures12.runtimeDescriptorArray ||
+                not supportedFeatures12.descriptorBindingPartiallyBound ||
+                not supportedFeatures12.descriptorBindingSampledImageUpdateAfterBind ||
+                not supportedFeatures12.descriptorBindingUpdateUnusedWhilePending ||
+                not supportedFeatures12.shaderSampledImageArrayNonUniformIndexing)
+            {
+                KMP_LOG_WARN("descriptor indexing features are not supported, bindless mode is disabled");
+                _graphicsParameters->bindlessTexturesCount = 0;
+                return;
+            }
+
+            auto properties12 = VKUtils::InitVkPhysicalDeviceVulkan12Properties();
+            auto properties2 = VKUtils::InitVkPhysicalDeviceProperties2();
+            properties2.pNext = &properties12;
+            vkGetPhysicalDeviceProperties2(_physicalDevice, &properties2);
+
+            // every graphics stage sees the whole array, so the per-stage limits are the ones to respect
+            const auto maxBindlessTextures = std::min(properties12.maxPerStageDescriptorUpdateAfterBindSampledImages, properties12.maxPerStageDescriptorUpdateAfterBindSamplers);
+            if (_graphicsParameters->bindlessTexturesCount > maxBindlessTextures)
+            {
+                KMP_LOG_WARN("bindless textures count '{}' exceeds device limit, clamped to '{}'", _graphicsParameters->bindlessTexturesCount, maxBindlessTextures);
+                _graphicsParameters->bindlessTexturesCount = maxBindlessTextures;
+            }
+
+            _graphicsParameters->features12.descriptorIndexing = VK_TRUE;
+            _graphicsParameters->features12.runtimeDescriptorArray = VK_TRUE;
+            _graphicsParameters->features12.descriptorBindingPartiallyBound = VK_TRUE;
+            _graphicsParameters->features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            _graphicsParameters->features12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+            _graphicsParameters->features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        }}
+        //--------------------------------------------------------------------------
+
         void VulkanLogicalDevice::_DeleteLogicalDeviceObject() KMP_PROFILING(ProfileLevelImportant)
         {
             KMP_ASSERT(_device && _graphicsParameters);
@@ -370,11 +462,27 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
-        void VulkanLogicalDevice::_CreateImageCreatorDelegate() KMP_PROFILING(ProfileLevelImportant)
+        void VulkanLogicalDevice::_CreateMemoryAllocator() KMP_PROFILING(ProfileLevelImportant)
         {
             KMP_ASSERT(_device);
 
-            _imageCreatorDelegate.reset(new VulkanImageCreatorDelegate(_device, _memoryTypeDelegate));
+            _memoryAllocator.reset(new VulkanMemoryAllocator(_device, _vulkanContext, _memoryTypeDelegate));
+            KMP_ASSERT(_memoryAllocator);
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanLogicalDevice::_DeleteMemoryAllocator() KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_memoryAllocator);
+            _memoryAllocator.reset();
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanLogicalDevice::_CreateImageCreatorDelegate() KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_device && _memoryAllocator);
+
+            _imageCreatorDelegate.reset(new VulkanImageCreatorDelegate(_device, *_memoryAllocator.get()));
             KMP_ASSERT(_imageCreatorDelegate);
         }}
         //--------------------------------------------------------------------------
@@ -440,7 +548,7 @@ namespace Kmplete
         {
             KMP_ASSERT(_device);
 
-            _descriptorSetManager.reset(new VulkanDescriptorSetManager(_device, _currentBufferIndex, _graphicsParameters->maxDescriptorSets, _graphicsParameters->descriptorPoolSizes));
+            _descriptorSetManager.reset(new VulkanDescriptorSetManager(_device, _currentBufferIndex, _graphicsParameters->maxDescriptorSets, _graphicsParameters->descriptorPoolSizes, _graphicsParameters->bindlessTexturesCount));
             KMP_ASSERT(_descriptorSetManager);
         }}
         //--------------------------------------------------------------------------
@@ -457,7 +565,7 @@ namespace Kmplete
         {
             KMP_ASSERT(_device);
 
-            _bufferManager.reset(new VulkanBufferManager(_device, _memoryTypeDelegate));
+            _bufferManager.reset(new VulkanBufferManager(_device, *_memoryAllocator.get()));
             KMP_ASSERT(_bufferManager);
         }}
         //--------------------------------------------------------------------------
@@ -470,6 +578,23 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
+        void VulkanLogicalDevice::_CreateUploadContext() KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_device && _memoryAllocator && _graphicsQueue);
+
+            _uploadContext.reset(new VulkanUploadContext(_device, *_memoryAllocator.get(), *_graphicsQueue.get(), _vulkanContext.graphicsFamilyIndex, _graphicsParameters->stagingBufferSize));
+            KMP_ASSERT(_uploadContext);
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanLogicalDevice::_DeleteUploadContext() KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_uploadContext);
+
+            _uploadContext.reset();
+        }}
+        //--------------------------------------------------------------------------
+
         void VulkanLogicalDevice::_CreateSamplersStorage() KMP_PROFILING(ProfileLevelImportant)
         {
             KMP_ASSERT(_device);
@@ -554,9 +679,9 @@ namespace Kmplete
 
         void VulkanLogicalDevice::_CreateRenderer() KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(_device && _swapchain);
+            KMP_ASSERT(_device && _swapchain && _uploadContext);
 
-            _renderer.reset(new VulkanRenderer(_chainHandler, _device, _currentBufferIndex, *_pipelineManager.get(), *_shaderManager.get(), _vulkanContext.graphicsFamilyIndex, *_swapchain.get()));
+            _renderer.reset(new VulkanRenderer(_chainHandler, _device, _currentBufferIndex, *_pipelineManager.get(), *_shaderManager.get(), *_uploadContext.get(), _vulkanContext.graphicsFamilyIndex, *_swapchain.get()));
             KMP_ASSERT(_renderer);
         }}
         //--------------------------------------------------------------------------
@@ -571,9 +696,9 @@ namespace Kmplete
 
         void VulkanLogicalDevice::_CreateMetricsManager()
         {
-            KMP_ASSERT(_physicalDevice);
+            KMP_ASSERT(_physicalDevice && _memoryAllocator);
 
-            _metricsManager.reset(new VulkanMetricsManager(_physicalDevice));
+            _metricsManager.reset(new VulkanMetricsManager(_physicalDevice, *_memoryAllocator.get()));
             KMP_ASSERT(_metricsManager);
         }
         //--------------------------------------------------------------------------
@@ -641,12 +766,14 @@ namespace Kmplete
 
         bool VulkanLogicalDevice::_StartFrame(float frameTimestep) KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(_swapchain && _renderer);
+            KMP_ASSERT(_swapchain && _renderer && _pipelineManager);
             KMP_ASSERT(_currentBufferIndex < _waitFences.size());
 
             _waitFences[_currentBufferIndex].Wait();
             _waitFences[_currentBufferIndex].Reset();
 
+            _pipelineManager->ProcessCompiledPipelines();
+
             const auto swapchainReady = _chainHandler.HandleStartFrame(GraphicsChainHandler::SwapchainUnitSID, frameTimestep);
             if (not swapchainReady)
             {
@@ -702,7 +829,7 @@ namespace Kmplete
 
         Nullable<VulkanTexture*> VulkanLogicalDevice::CreateTexture(const Image& image, Assets::TextureSubTypeMaskBits subTypeMask) const KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(_device && _imageCreatorDelegate && _graphicsQueue);
+            KMP_ASSERT(_device && _imageCreatorDelegate && _uploadContext);
 
             try
             {
@@ -710,7 +837,6 @@ namespace Kmplete
                 const auto isSRGB = subTypeMask & Assets::TextureSubTypeMaskBits::SRGB;
                 const auto textureVkFormat = ImageChannelsToVkFormat(ImageChannels(image.GetChannels()), isSRGB);
                 const auto mipLevels = (_formatDelegate.IsMipmapCompatible(textureVkFormat) && not noMipmap) ? image.GetMipLevels() : 1;
-                auto imageBuffer = _imageCreatorDelegate->CreateStagingImageBuffer(image);
                 const auto extent = VkExtent3D{
                     .width = UInt32(image.GetWidth()),
                     .height = UInt32(image.GetHeight()),
@@ -718,13 +844,91 @@ namespace Kmplete
                 };
                 const auto imageType = extent.height > 1 ? VK_Image_2D : VK_Image_1D;
 
-                auto commandBuffer = _renderer->CreateCommandBuffer();
-                commandBuffer.Begin(VK_CommandBufferUsage_OneTimeSubmit);
-                auto* texture = new VulkanTexture(imageType, textureVkFormat, mipLevels, _device, commandBuffer.GetVkCommandBuffer(), imageBuffer, extent, *_imageCreatorDelegate.get());
-                commandBuffer.End();
+                // pixels go through the staging ring, the copy and mip generation are recorded into the current upload batch
+                // which is submitted together with the next frame (or earlier if the ring runs out of space)
+                Nullable<VulkanTexture*> texture = nullptr;
+                const auto uploadTicket = _uploadContext->Upload(image.GetPixels(), image.GetDataSize(), 16,
+                    [&](VkCommandBuffer commandBuffer, const VulkanStagingRegion& region) {
+                        texture = new VulkanTexture(imageType, textureVkFormat, mipLevels, _device, commandBuffer, region.buffer, region.offset, extent, *_imageCreatorDelegate.get());
+                    });
 
-                _graphicsQueue->SyncSubmit(commandBuffer);
+                // the texture may be destroyed before the batch is submitted, so it has to know what to wait for
+                texture->SetUploadTicket(*_uploadContext.get(), uploadTicket);
+                return texture;
+            }
+            catch (KMP_MB_UNUSED const RuntimeError& e)
+            {
+                KMP_LOG_ERROR("failed to create a texture - {}", e.what());
+            }
 
+            return nullptr;
+        }}
+        //--------------------------------------------------------------------------
+
+        Nullable<VulkanTexture*> VulkanLogicalDevice::CreateTexture(BinaryView texturePayload, Assets::TextureSubTypeMaskBits subTypeMask) const KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_device && _imageCreatorDelegate && _uploadContext);
+
+            Assets::TexturePayloadHeader header{};
+            if (not Assets::ReadTexturePayloadHeader(texturePayload, header))
+            {
+                KMP_LOG_ERROR("failed to create a texture - malformed payload of size {}", texturePayload.size());
+                return nullptr;
+            }
+
+            auto format = static_cast<Assets::TexturePayloadFormat>(header.format);
+            const auto isSRGB = (subTypeMask & Assets::TextureSubTypeMaskBits::SRGB) && Assets::IsTexturePayloadFormatSRGBCompatible(format);
+
+            // block-compressed payloads are uploaded as is when the device can sample them,
+            // otherwise they are decoded on the CPU into the matching uncompressed format
+            BinaryBuffer decompressedPayload;
+            if (Assets::IsTexturePayloadFormatCompressed(format) && not _formatDelegate.IsSampledImageCompatible(TexturePayloadFormatToVkFormat(format, isSRGB)))
+            {
+                KMP_LOG_WARN("block-compressed texture format {} is not supported by the device, falling back to CPU decoding", UInt32(header.format));
+
+                decompressedPayload = DecompressTexturePayload(texturePayload);
+                if (decompressedPayload.empty())
+                {
+                    KMP_LOG_ERROR("failed to create a texture - payload decompression failed");
+                    return nullptr;
+                }
+
+                texturePayload = BinaryView(decompressedPayload);
+                format = Assets::GetTexturePayloadUncompressedFormat(format);
+            }
+
+            const auto payloadSize = Assets::GetTexturePayloadSize(format, header.width, header.height, header.mipLevels);
+
+            try
+            {
+                const auto textureVkFormat = TexturePayloadFormatToVkFormat(format, isSRGB);
+                const auto imageType = header.height > 1 ? VK_Image_2D : VK_Image_1D;
+                const auto baseLevelOffset = Assets::GetTexturePayloadMipLevelOffset(format, header.width, header.height, 0);
+
+                // every mip level is already laid out in the payload with the staging-compatible alignment,
+                // so the whole payload goes into the staging ring at once and each level is copied by its own region
+                Nullable<VulkanTexture*> texture = nullptr;
+                const auto uploadTicket = _uploadContext->Upload(texturePayload.data() + baseLevelOffset, payloadSize - baseLevelOffset, Assets::TexturePayloadAlignment,
+                    [&](VkCommandBuffer commandBuffer, const VulkanStagingRegion& region) {
+                        Vector<VkBufferImageCopy> mipRegions(header.mipLevels);
+                        for (UInt32 mipLevel = 0; mipLevel < header.mipLevels; mipLevel++)
+                        {
+                            auto& mipRegion = mipRegions[mipLevel];
+                            mipRegion.bufferOffset = region.offset + Assets::GetTexturePayloadMipLevelOffset(format, header.width, header.height, mipLevel) - baseLevelOffset;
+                            mipRegion.imageSubresource.aspectMask = VK_ImageAspect_Color;
+                            mipRegion.imageSubresource.mipLevel = mipLevel;
+                            mipRegion.imageSubresource.layerCount = 1;
+                            mipRegion.imageExtent = VkExtent3D{
+                                .width = Assets::GetTexturePayloadMipDimension(header.width, mipLevel),
+                                .height = Assets::GetTexturePayloadMipDimension(header.height, mipLevel),
+                                .depth = 1
+                            };
+                        }
+
+                        texture = new VulkanTexture(imageType, textureVkFormat, _device, commandBuffer, region.buffer, mipRegions, *_imageCreatorDelegate.get());
+                    });
+
+                texture->SetUploadTicket(*_uploadContext.get(), uploadTicket);
                 return texture;
             }
             catch (KMP_MB_UNUSED const RuntimeError& e)
@@ -735,5 +939,66 @@ namespace Kmplete
             return nullptr;
         }}
         //--------------------------------------------------------------------------
+
+        bool VulkanLogicalDevice::UpdateTexture(Texture& texture, BinaryView pixels, const TextureRegion& region) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(_uploadContext);
+
+            auto vulkanTexture = dynamic_cast<VulkanTexture*>(&texture);
+            if (not vulkanTexture)
+            {
+                KMP_LOG_ERROR("failed to update a texture - texture was not created by Vulkan backend");
+                return false;
+            }
+
+            if (region.width == 0 || region.height == 0 || pixels.empty())
+            {
+                KMP_LOG_ERROR("failed to update a texture - empty region");
+                return false;
+            }
+
+            const auto offset = VkOffset3D{
+                .x = Int32(region.x),
+                .y = Int32(region.y),
+                .z = 0
+            };
+            const auto extent = VkExtent3D{
+                .width = region.width,
+                .height = region.height,
+                .depth = 1
+            };
+
+            const auto uploadTicket = _uploadContext->Upload(pixels.data(), pixels.size(), 16,
+                [&](VkCommandBuffer commandBuffer, const VulkanStagingRegion& stagingRegion) {
+                    vulkanTexture->UpdateRegion(commandBuffer, stagingRegion.buffer, stagingRegion.offset, offset, extent);
+                });
+            vulkanTexture->SetUploadTicket(*_uploadContext.get(), uploadTicket);
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanLogicalDevice::GetBindlessTexturesCount() const
+        {
+            KMP_ASSERT(_descriptorSetManager);
+
+            return _descriptorSetManager->GetBindlessTexturesCount();
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanLogicalDevice::SetBindlessTexture(UInt32 index, const Texture& texture) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(_descriptorSetManager && _samplersStorage);
+
+            const auto vulkanTexture = dynamic_cast<const VulkanTexture*>(&texture);
+            if (not vulkanTexture)
+            {
+                KMP_LOG_ERROR("failed to set a bindless texture - texture was not created by Vulkan backend");
+                return false;
+            }
+
+            return _descriptorSetManager->SetBindlessTextureDescriptor(index, vulkanTexture->GetVkImageView(), _samplersStorage->GetSampler(SamplerDefaultLinearSid));
+        }}
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
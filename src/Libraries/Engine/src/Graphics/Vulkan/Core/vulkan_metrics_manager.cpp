@@ -8,9 +8,13 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        VulkanMetricsManager::VulkanMetricsManager(VkPhysicalDevice physicalDevice)
+        static constexpr auto MibDivisor = 1024.0 * 1024.0;
+
+
+        VulkanMetricsManager::VulkanMetricsManager(VkPhysicalDevice physicalDevice, const VulkanMemoryAllocator& memoryAllocator)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _physicalDevice(physicalDevice)
+            , _memoryAllocator(memoryAllocator)
             , _memoryProperties()
             , _memoryProperties2(VKUtils::InitVkPhysicalDeviceMemoryProperties2())
             , _memoryBudgetProperties(VKUtils::InitVkPhysicalDeviceMemoryBudgetPropertiesEXT())
@@ -42,6 +46,11 @@ namespace Kmplete
                 _metrics.usagePercent = float(double(_metrics.totalUsage) / double(_metrics.totalBudget) * 100.0);
             }
 
+            _metrics.allocatorHeapStatistics = _memoryAllocator.GetHeapStatistics();
+
+            KMP_PROFILE_COUNTER("GPU memory usage (MiB)", double(_metrics.totalUsage) / MibDivisor);
+            KMP_PROFILE_COUNTER("GPU memory budget (MiB)", double(_metrics.totalBudget) / MibDivisor);
+
             return _metrics;
         }}
         //--------------------------------------------------------------------------
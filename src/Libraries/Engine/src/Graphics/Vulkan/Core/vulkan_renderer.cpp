@@ -2,7 +2,8 @@
 #include "Kmplete/Graphics/Vulkan/Utils/extension_functions.h"
 #include "Kmplete/Graphics/Vulkan/Utils/presets.h"
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
-#include "Kmplete/Graphics/graphics_base.h"
+#include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
+#include "Kmplete/Base/named_bool.h"
 #include "Kmplete/Core/assertion.h"
 #include "Kmplete/Profile/profiler.h"
 #include "Kmplete/Log/log.h"
@@ -15,18 +16,34 @@ namespace Kmplete
         using namespace VKBits;
 
 
+        namespace
+        {
+            // secondary command buffer the calling thread records to between Begin/EndSecondaryRecording
+            thread_local VkCommandBuffer RecordingSecondaryCommandBuffer = VK_NULL_HANDLE;
+            // pipeline bound to that secondary command buffer
+            thread_local VkPipeline RecordingSecondaryBoundPipeline = VK_NULL_HANDLE;
+        }
+
         VulkanRenderer::VulkanRenderer(GraphicsChainHandler& chainHandler, VkDevice device, const UInt32& currentBufferIndex, const VulkanPipelineManager& pipelineManager,
-                                       const VulkanShaderManager& shaderManager, UInt32 graphicsFamilyIndex, const VulkanSwapchain& swapchain)
+                                       const VulkanShaderManager& shaderManager, VulkanUploadContext& uploadContext, UInt32 graphicsFamilyIndex, const VulkanSwapchain& swapchain)
             : Renderer(chainHandler)
               KMP_PROFILE_CONSTRUCTOR_START_DERIVED_CLASS()
             , _currentBufferIndex(currentBufferIndex)
             , _pipelineManager(pipelineManager)
             , _shaderManager(shaderManager)
+            , _uploadContext(uploadContext)
             , _swapchain(swapchain)
             , _device(device)
+            , _graphicsFamilyIndex(graphicsFamilyIndex)
             , _commandPool(nullptr)
             , _drawCommandBuffers()
             , _currentCommandBuffer(VK_NULL_HANDLE)
+            , _boundPipeline(VK_NULL_HANDLE)
+            , _secondaryCommandBuffers()
+            , _usedSecondariesCount()
+            , _parallelRecordingFirstIndex(0)
+            , _parallelRecordingCount(0)
+            , _secondaryRenderingParameters()
         {
             _Initialize(graphicsFamilyIndex);
 
@@ -40,9 +57,10 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
-        void VulkanRenderer::BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments) const
+        void VulkanRenderer::BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments, bool secondaryContents /*= false*/) const
         {
             auto renderingInfo = VKUtils::InitVkRenderingInfo();
+            renderingInfo.flags = secondaryContents ? VK_RenderingContents_SecondaryCommandBuffers : 0;
             renderingInfo.renderArea = renderArea;
             renderingInfo.layerCount = 1;
             renderingInfo.colorAttachmentCount = UInt32(colorAttachments.size());
@@ -54,9 +72,10 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
-        void VulkanRenderer::BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments, const VkRenderingAttachmentInfo& depthStencilAttachment) const
+        void VulkanRenderer::BeginRendering(const VkRect2D& renderArea, const Vector<VkRenderingAttachmentInfo>& colorAttachments, const VkRenderingAttachmentInfo& depthStencilAttachment, bool secondaryContents /*= false*/) const
         {
             auto renderingInfo = VKUtils::InitVkRenderingInfo();
+            renderingInfo.flags = secondaryContents ? VK_RenderingContents_SecondaryCommandBuffers : 0;
             renderingInfo.renderArea = renderArea;
             renderingInfo.layerCount = 1;
             renderingInfo.colorAttachmentCount = UInt32(colorAttachments.size());
@@ -70,17 +89,19 @@ namespace Kmplete
 
         void VulkanRenderer::BeginRendering(const VkRenderingInfo& renderingInfo) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdBeginRendering(_currentCommandBuffer, &renderingInfo);
+            vkCmdBeginRendering(commandBuffer, &renderingInfo);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::EndRendering() const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdEndRendering(_currentCommandBuffer);
+            vkCmdEndRendering(commandBuffer);
         }}
         //--------------------------------------------------------------------------
 
@@ -88,13 +109,33 @@ namespace Kmplete
         {
             KMP_ASSERT(_currentCommandBuffer);
 
-            VkPipelineStageFlags waitStageMask = VK_PipelineStage_ColorAttachmentOutput;
+            const auto uploadTicket = _uploadContext.Flush();
+
+            auto waitSemaphoresWithUpload = waitSemaphores;
+            Vector<VkPipelineStageFlags> waitStageMasks(waitSemaphores.size(), VK_PipelineStage_ColorAttachmentOutput);
+            Vector<UInt64> waitValues(waitSemaphores.size(), 0ULL);
+            if (uploadTicket.IsValid())
+            {
+                waitSemaphoresWithUpload.push_back(_uploadContext.GetTimelineSemaphore());
+                waitStageMasks.push_back(VK_PipelineStage_AllCommands);
+                waitValues.push_back(uploadTicket.value);
+            }
+
+            // binary semaphores ignore their values, but the counts must match once a timeline semaphore is involved
+            const Vector<UInt64> signalValues(signalSemaphores.size(), 0ULL);
+            auto timelineSubmitInfo = VKUtils::InitVkTimelineSemaphoreSubmitInfo();
+            timelineSubmitInfo.waitSemaphoreValueCount = UInt32(waitValues.size());
+            timelineSubmitInfo.pWaitSemaphoreValues = waitValues.data();
+            timelineSubmitInfo.signalSemaphoreValueCount = UInt32(signalValues.size());
+            timelineSubmitInfo.pSignalSemaphoreValues = signalValues.data();
+
             auto submitInfo = VKUtils::InitVkSubmitInfo();
-            submitInfo.pWaitDstStageMask = &waitStageMask;
+            submitInfo.pNext = &timelineSubmitInfo;
+            submitInfo.pWaitDstStageMask = waitStageMasks.data();
             submitInfo.commandBufferCount = 1;
             submitInfo.pCommandBuffers = &_currentCommandBuffer;
-            submitInfo.waitSemaphoreCount = UInt32(waitSemaphores.size());
-            submitInfo.pWaitSemaphores = waitSemaphores.data();
+            submitInfo.waitSemaphoreCount = UInt32(waitSemaphoresWithUpload.size());
+            submitInfo.pWaitSemaphores = waitSemaphoresWithUpload.data();
             submitInfo.signalSemaphoreCount = UInt32(signalSemaphores.size());
             submitInfo.pSignalSemaphores = signalSemaphores.data();
 
@@ -116,9 +157,10 @@ namespace Kmplete
 
         void VulkanRenderer::InsertImageMemoryBarrier(VkImage image, VKUtils::MemoryBarrierParameters& memoryBarrierParameters) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            memoryBarrierParameters.cmdbuffer = _currentCommandBuffer;
+            memoryBarrierParameters.cmdbuffer = commandBuffer;
             memoryBarrierParameters.image = image;
             VKUtils::InsertImageMemoryBarrier(memoryBarrierParameters);
         }}
@@ -126,351 +168,395 @@ namespace Kmplete
 
         void VulkanRenderer::SetDepthTestEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetDepthTestEnable(_currentCommandBuffer, enabled);
+            vkCmdSetDepthTestEnable(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetDepthWriteEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetDepthWriteEnable(_currentCommandBuffer, enabled);
+            vkCmdSetDepthWriteEnable(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetDepthCompareOp(VkCompareOp comparison) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetDepthCompareOp(_currentCommandBuffer, comparison);
+            vkCmdSetDepthCompareOp(commandBuffer, comparison);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetDepthBiasEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetDepthBiasEnable(_currentCommandBuffer, enabled);
+            vkCmdSetDepthBiasEnable(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetDepthBias(float constantFactor, float clamp, float slopeFactor) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetDepthBias(_currentCommandBuffer, constantFactor, clamp, slopeFactor);
+            vkCmdSetDepthBias(commandBuffer, constantFactor, clamp, slopeFactor);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetDepthBoundsEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetDepthBoundsTestEnable(_currentCommandBuffer, enabled);
+            vkCmdSetDepthBoundsTestEnable(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetDepthBounds(float min, float max) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetDepthBounds(_currentCommandBuffer, min, max);
+            vkCmdSetDepthBounds(commandBuffer, min, max);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetDepthClipEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetDepthClipEnableEXT(_currentCommandBuffer, enabled);
+            VKCommands::CmdSetDepthClipEnableEXT(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetStencilTestEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetStencilTestEnable(_currentCommandBuffer, enabled);
+            vkCmdSetStencilTestEnable(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetStencilOp(VkStencilFaceFlags faceMask, VkStencilOp failOp, VkStencilOp passOp, VkStencilOp depthFailOp, VkCompareOp comparison) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetStencilOp(_currentCommandBuffer, faceMask, failOp, passOp, depthFailOp, comparison);
+            vkCmdSetStencilOp(commandBuffer, faceMask, failOp, passOp, depthFailOp, comparison);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetStencilCompareMask(VkStencilFaceFlags faceMask, UInt32 compareMask) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetStencilCompareMask(_currentCommandBuffer, faceMask, compareMask);
+            vkCmdSetStencilCompareMask(commandBuffer, faceMask, compareMask);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetStencilWriteMask(VkStencilFaceFlags faceMask, UInt32 writeMask) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetStencilWriteMask(_currentCommandBuffer, faceMask, writeMask);
+            vkCmdSetStencilWriteMask(commandBuffer, faceMask, writeMask);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetStencilReference(VkStencilFaceFlags faceMask, UInt32 reference) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetStencilReference(_currentCommandBuffer, faceMask, reference);
+            vkCmdSetStencilReference(commandBuffer, faceMask, reference);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetViewport(const VkViewport& viewport) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetViewport(_currentCommandBuffer, 0, 1, &viewport);
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetScissor(const VkRect2D& scissorRect) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetScissor(_currentCommandBuffer, 0, 1, &scissorRect);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissorRect);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetViewportWithCount(const Vector<VkViewport>& viewports) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetViewportWithCount(_currentCommandBuffer, UInt32(viewports.size()), viewports.data());
+            vkCmdSetViewportWithCount(commandBuffer, UInt32(viewports.size()), viewports.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetScissorWithCount(const Vector<VkRect2D>& scissors) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetScissorWithCount(_currentCommandBuffer, UInt32(scissors.size()), scissors.data());
+            vkCmdSetScissorWithCount(commandBuffer, UInt32(scissors.size()), scissors.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetRasterizationSamples(VkSampleCountFlagBits samples) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetRasterizationSamplesEXT(_currentCommandBuffer, samples);
+            VKCommands::CmdSetRasterizationSamplesEXT(commandBuffer, samples);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetPrimitiveTopology(VkPrimitiveTopology topology) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetPrimitiveTopology(_currentCommandBuffer, topology);
+            vkCmdSetPrimitiveTopology(commandBuffer, topology);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetPrimitiveRestartEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetPrimitiveRestartEnable(_currentCommandBuffer, enabled);
+            vkCmdSetPrimitiveRestartEnable(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetLineWidth(float lineWidth) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetLineWidth(_currentCommandBuffer, lineWidth);
+            vkCmdSetLineWidth(commandBuffer, lineWidth);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetLineStippleEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetLineStippleEnableEXT(_currentCommandBuffer, enabled);
+            VKCommands::CmdSetLineStippleEnableEXT(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetLineStipple(UInt32 lineStippleFactor, UInt16 lineStipplePattern) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetLineStipple(_currentCommandBuffer, lineStippleFactor, lineStipplePattern);
+            vkCmdSetLineStipple(commandBuffer, lineStippleFactor, lineStipplePattern);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetLineRasterizationMode(VkLineRasterizationModeEXT lineRasterizationMode) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetLineRasterizationModeEXT(_currentCommandBuffer, lineRasterizationMode);
+            VKCommands::CmdSetLineRasterizationModeEXT(commandBuffer, lineRasterizationMode);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetCullMode(VkCullModeFlags cullMode) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetCullMode(_currentCommandBuffer, cullMode);
+            vkCmdSetCullMode(commandBuffer, cullMode);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetFrontFace(VkFrontFace frontFace) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetFrontFace(_currentCommandBuffer, frontFace);
+            vkCmdSetFrontFace(commandBuffer, frontFace);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetBlendConstants(const Array<float, 4> constants) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetBlendConstants(_currentCommandBuffer, constants.data());
+            vkCmdSetBlendConstants(commandBuffer, constants.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetRasterizerDiscardEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdSetRasterizerDiscardEnable(_currentCommandBuffer, enabled);
+            vkCmdSetRasterizerDiscardEnable(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetSampleLocationsEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetSampleLocationsEnableEXT(_currentCommandBuffer, enabled);
+            VKCommands::CmdSetSampleLocationsEnableEXT(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetSampleLocations(const Vector<VkSampleLocationsInfoEXT>& sampleLocationInfos) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetSampleLocationsEXT(_currentCommandBuffer, sampleLocationInfos.data());
+            VKCommands::CmdSetSampleLocationsEXT(commandBuffer, sampleLocationInfos.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetSampleMask(VkSampleCountFlagBits samples, const Vector<VkSampleMask>& sampleMasks) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetSampleMaskEXT(_currentCommandBuffer, samples, sampleMasks.data());
+            VKCommands::CmdSetSampleMaskEXT(commandBuffer, samples, sampleMasks.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetFragmentShadingRate(const VkExtent2D& fragmentSize, const Array<VkFragmentShadingRateCombinerOpKHR, 2>& combinerOps) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetFragmentShadingRateKHR(_currentCommandBuffer, &fragmentSize, combinerOps.data());
+            VKCommands::CmdSetFragmentShadingRateKHR(commandBuffer, &fragmentSize, combinerOps.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetColorWriteEnabled(UInt32 attachmentCount, const Vector<VkBool32>& colorWritesEnables) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetColorWriteEnableEXT(_currentCommandBuffer, attachmentCount, colorWritesEnables.data());
+            VKCommands::CmdSetColorWriteEnableEXT(commandBuffer, attachmentCount, colorWritesEnables.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetColorWriteMask(UInt32 firstAttachment, UInt32 attachmentCount, const Vector<VkColorComponentFlags>& colorWritesMasks) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetColorWriteMaskEXT(_currentCommandBuffer, firstAttachment, attachmentCount, colorWritesMasks.data());
+            VKCommands::CmdSetColorWriteMaskEXT(commandBuffer, firstAttachment, attachmentCount, colorWritesMasks.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetColorBlendEnabled(UInt32 firstAttachment, UInt32 attachmentCount, const Vector<VkBool32>& colorBlendsEnables) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetColorBlendEnableEXT(_currentCommandBuffer, firstAttachment, attachmentCount, colorBlendsEnables.data());
+            VKCommands::CmdSetColorBlendEnableEXT(commandBuffer, firstAttachment, attachmentCount, colorBlendsEnables.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetColorBlendEquation(UInt32 firstAttachment, UInt32 attachmentCount, const Vector<VkColorBlendEquationEXT>& colorBlendsEquations) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetColorBlendEquationEXT(_currentCommandBuffer, firstAttachment, attachmentCount, colorBlendsEquations.data());
+            VKCommands::CmdSetColorBlendEquationEXT(commandBuffer, firstAttachment, attachmentCount, colorBlendsEquations.data());
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetPolygonMode(VkPolygonMode polygonMode) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetPolygonModeEXT(_currentCommandBuffer, polygonMode);
+            VKCommands::CmdSetPolygonModeEXT(commandBuffer, polygonMode);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetAlphaToCoverageEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetAlphaToCoverageEnableEXT(_currentCommandBuffer, enabled);
+            VKCommands::CmdSetAlphaToCoverageEnableEXT(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetAlphaToOneEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetAlphaToOneEnableEXT(_currentCommandBuffer, enabled);
+            VKCommands::CmdSetAlphaToOneEnableEXT(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetLogicOpEnabled(bool enabled) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetLogicOpEnableEXT(_currentCommandBuffer, enabled);
+            VKCommands::CmdSetLogicOpEnableEXT(commandBuffer, enabled);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetLogicOp(VkLogicOp logicOp) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetLogicOpEXT(_currentCommandBuffer, logicOp);
+            VKCommands::CmdSetLogicOpEXT(commandBuffer, logicOp);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetProvokingVertexMode(VkProvokingVertexModeEXT mode) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetProvokingVertexModeEXT(_currentCommandBuffer, mode);
+            VKCommands::CmdSetProvokingVertexModeEXT(commandBuffer, mode);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::SetVertexInput(const Vector<VkVertexInputBindingDescription2EXT>& vertexBindingsDescriptions, const Vector<VkVertexInputAttributeDescription2EXT>& vertexAttributeDescriptions) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            VKCommands::CmdSetVertexInputEXT(_currentCommandBuffer, UInt32(vertexBindingsDescriptions.size()), vertexBindingsDescriptions.data(), UInt32(vertexAttributeDescriptions.size()), vertexAttributeDescriptions.data());
+            VKCommands::CmdSetVertexInputEXT(commandBuffer, UInt32(vertexBindingsDescriptions.size()), vertexBindingsDescriptions.data(), UInt32(vertexAttributeDescriptions.size()), vertexAttributeDescriptions.data());
         }}
         //--------------------------------------------------------------------------
 
         bool VulkanRenderer::BindGraphicsPipeline(StringID pipelineSid) const KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
             const auto pipeline = _pipelineManager.GetGraphicsPipeline(pipelineSid);
             if (not pipeline.has_value())
@@ -479,14 +565,24 @@ namespace Kmplete
                 return false;
             }
 
-            vkCmdBindPipeline(_currentCommandBuffer, VK_PipelineBindPoint_Graphics, pipeline.value().get().GetVkPipeline());
+            // pipelines sharing the same state are the same object, so switching between them is skipped as well
+            const auto vkPipeline = pipeline.value().get().GetVkPipeline();
+            auto& boundPipeline = _GetBoundPipeline();
+            if (boundPipeline == vkPipeline)
+            {
+                return true;
+            }
+
+            vkCmdBindPipeline(commandBuffer, VK_PipelineBindPoint_Graphics, vkPipeline);
+            boundPipeline = vkPipeline;
             return true;
         }}
         //--------------------------------------------------------------------------
 
         bool VulkanRenderer::BindDescriptorSets(StringID layoutSid, UInt32 firstSetIndex, const Vector<VkDescriptorSet>& descriptorSets, const Vector<UInt32>& dynamicOffsets /*= Vector<UInt32>()*/) const KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
             const auto pipelineLayout = _pipelineManager.GetPipelineLayout(layoutSid);
             if (pipelineLayout == VK_NULL_HANDLE)
@@ -496,7 +592,7 @@ namespace Kmplete
             }
 
             vkCmdBindDescriptorSets(
-                _currentCommandBuffer, 
+                commandBuffer, 
                 VK_PipelineBindPoint_Graphics,
                 pipelineLayout,
                 firstSetIndex, 
@@ -509,7 +605,8 @@ namespace Kmplete
 
         void VulkanRenderer::PushConstants(StringID layoutSid, VkShaderStageFlags shaderStagesFlags, UInt32 offset, UInt32 size, const void* data) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
             const auto pipelineLayout = _pipelineManager.GetPipelineLayout(layoutSid);
             if (pipelineLayout == VK_NULL_HANDLE)
@@ -518,13 +615,14 @@ namespace Kmplete
                 return;
             }
 
-            vkCmdPushConstants(_currentCommandBuffer, pipelineLayout, shaderStagesFlags, offset, size, data);
+            vkCmdPushConstants(commandBuffer, pipelineLayout, shaderStagesFlags, offset, size, data);
         }}
         //--------------------------------------------------------------------------
 
         bool VulkanRenderer::BindVertexBuffers(UInt32 firstBinding, const Vector<VkBuffer>& vertexBuffers, const Vector<VkDeviceSize>& offsets) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
             if (vertexBuffers.size() != offsets.size() || vertexBuffers.empty())
             {
@@ -532,14 +630,15 @@ namespace Kmplete
                 return false;
             }
 
-            vkCmdBindVertexBuffers(_currentCommandBuffer, firstBinding, UInt32(vertexBuffers.size()), vertexBuffers.data(), offsets.data());
+            vkCmdBindVertexBuffers(commandBuffer, firstBinding, UInt32(vertexBuffers.size()), vertexBuffers.data(), offsets.data());
             return true;
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::BindVertexBuffers2(UInt32 firstBinding, const Vector<VkBuffer>& buffers, const Vector<VkDeviceSize>& offsets, const Vector<VkDeviceSize>& sizes, const Vector<VkDeviceSize>& strides) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
             if (buffers.size() != offsets.size() ||
                 ((buffers.size() != sizes.size()) && not sizes.empty()) ||
@@ -550,7 +649,7 @@ namespace Kmplete
                 return;
             }
 
-            vkCmdBindVertexBuffers2(_currentCommandBuffer, firstBinding, UInt32(buffers.size()), buffers.data(), offsets.data(), sizes.data(), strides.data());
+            vkCmdBindVertexBuffers2(commandBuffer, firstBinding, UInt32(buffers.size()), buffers.data(), offsets.data(), sizes.data(), strides.data());
         }}
         //--------------------------------------------------------------------------
 
@@ -562,15 +661,17 @@ namespace Kmplete
 
         void VulkanRenderer::BindIndexBuffer(VkBuffer indexBuffer, VkDeviceSize offset /*= 0*/, VkIndexType indexType /*= VK_Index_UInt32*/) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdBindIndexBuffer(_currentCommandBuffer, indexBuffer, offset, indexType);
+            vkCmdBindIndexBuffer(commandBuffer, indexBuffer, offset, indexType);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::BindShaderObjects(const Vector<VkShaderStageFlagBits>& stages, const Vector<StringID>& shadersSids) const KMP_PROFILING(ProfileLevelMinor)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
             Vector<VkShaderEXT> shaders;
             shaders.reserve(shadersSids.size());
@@ -586,23 +687,26 @@ namespace Kmplete
                 KMP_LOG_ERROR("cannot bind shader with sid '{}' - not found", shaderSid);
             }
 
-            VKCommands::CmdBindShadersEXT(_currentCommandBuffer, UInt32(stages.size()), stages.data(), shaders.data());
+            VKCommands::CmdBindShadersEXT(commandBuffer, UInt32(stages.size()), stages.data(), shaders.data());
+            _GetBoundPipeline() = VK_NULL_HANDLE;
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::Draw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdDraw(_currentCommandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+            vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
         }}
         //--------------------------------------------------------------------------
 
         void VulkanRenderer::DrawIndexed(UInt32 indexCount, UInt32 instanceCount, UInt32 firstIndex, Int32 vertexOffset, UInt32 firstInstance) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdDrawIndexed(_currentCommandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+            vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
         }}
         //--------------------------------------------------------------------------
 
@@ -614,9 +718,10 @@ namespace Kmplete
 
         void VulkanRenderer::DrawIndirect(VkBuffer indirectBuffer, VkDeviceSize offset, UInt32 drawCount, UInt32 stride /*= sizeof(VkDrawIndirectCommand)*/) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdDrawIndirect(_currentCommandBuffer, indirectBuffer, offset, drawCount, stride);
+            vkCmdDrawIndirect(commandBuffer, indirectBuffer, offset, drawCount, stride);
         }}
         //--------------------------------------------------------------------------
 
@@ -628,9 +733,10 @@ namespace Kmplete
 
         void VulkanRenderer::DrawIndexedIndirect(VkBuffer indirectBuffer, VkDeviceSize offset, UInt32 drawCount, UInt32 stride /*= sizeof(VkDrawIndexedIndirectCommand)*/) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            KMP_ASSERT(_currentCommandBuffer);
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
 
-            vkCmdDrawIndexedIndirect(_currentCommandBuffer, indirectBuffer, offset, drawCount, stride);
+            vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer, offset, drawCount, stride);
         }}
         //--------------------------------------------------------------------------
 
@@ -657,17 +763,23 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
-        void VulkanRenderer::CopyBuffers(const VulkanBuffer& stagingBuffer, const Vector<VKUtils::BufferCopyParameters>& copyParameters, const VulkanQueue& queue) const KMP_PROFILING(ProfileLevelImportantVerbose)
+        void VulkanRenderer::CopyBuffers(const VulkanBuffer& stagingBuffer, const Vector<VKUtils::BufferCopyParameters>& copyParameters) const KMP_PROFILING(ProfileLevelImportantVerbose)
         {
-            const auto copyCommandBuffer = CreateCommandBuffer();
-            copyCommandBuffer.Begin();
-            for (const auto& singleCopyParameters : copyParameters)
-            {
-                CopyBuffer(copyCommandBuffer, stagingBuffer, singleCopyParameters.destinationBuffer, singleCopyParameters.srcOfset, singleCopyParameters.dstOfset, singleCopyParameters.size);
-            }
-            copyCommandBuffer.End();
+            // copies join the current upload batch, but the staging buffer is owned by the caller
+            // and may be destroyed right after return, so wait for the batch to finish
+            const auto ticket = _uploadContext.Record([&](VkCommandBuffer commandBuffer) {
+                for (const auto& singleCopyParameters : copyParameters)
+                {
+                    const VkBufferCopy copyRegion{
+                        .srcOffset = singleCopyParameters.srcOfset,
+                        .dstOffset = singleCopyParameters.dstOfset,
+                        .size = singleCopyParameters.size
+                    };
+                    vkCmdCopyBuffer(commandBuffer, stagingBuffer.GetVkBuffer(), singleCopyParameters.destinationBuffer.GetVkBuffer(), 1, &copyRegion);
+                }
+            });
 
-            queue.SyncSubmit(copyCommandBuffer);
+            _uploadContext.Wait(ticket);
         }}
         //--------------------------------------------------------------------------
 
@@ -680,10 +792,127 @@ namespace Kmplete
         //--------------------------------------------------------------------------
 
         VkCommandBuffer VulkanRenderer::GetCurrentCommandBuffer() const noexcept
+        {
+            const auto commandBuffer = _GetRecordingCommandBuffer();
+            KMP_ASSERT(commandBuffer);
+
+            return commandBuffer;
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanRenderer::InvalidateBoundPipeline() const noexcept
+        {
+            _GetBoundPipeline() = VK_NULL_HANDLE;
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanRenderer::BeginParallelRecording(UInt32 secondariesCount, const VulkanSecondaryRenderingParameters& parameters) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(_device);
+            KMP_ASSERT(_currentBufferIndex < NumConcurrentFrames);
+
+            if (_parallelRecordingCount > 0)
+            {
+                KMP_LOG_ERROR("cannot begin parallel recording - previous one has not been executed");
+                return;
+            }
+            if (secondariesCount == 0)
+            {
+                KMP_LOG_ERROR("cannot begin parallel recording of zero secondary command buffers");
+                return;
+            }
+
+            auto& secondaries = _secondaryCommandBuffers[_currentBufferIndex];
+            auto& usedCount = _usedSecondariesCount[_currentBufferIndex];
+            while (secondaries.size() < usedCount + secondariesCount)
+            {
+                auto commandPool = CreateUPtr<VulkanCommandPool>(_device, _graphicsFamilyIndex);
+                auto commandBuffer = VulkanCommandBuffer(_device, commandPool->GetVkCommandPool(), "primary"_false);
+                secondaries.push_back(SecondaryCommandBuffer{ std::move(commandPool), std::move(commandBuffer) });
+            }
+
+            _parallelRecordingFirstIndex = usedCount;
+            _parallelRecordingCount = secondariesCount;
+            _secondaryRenderingParameters = parameters;
+            usedCount += secondariesCount;
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanRenderer::BeginSecondaryRecording(UInt32 secondaryIndex) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            if (secondaryIndex >= _parallelRecordingCount)
+            {
+                KMP_LOG_ERROR("cannot begin secondary recording - index '{}' is out of parallel recording range '{}'", secondaryIndex, _parallelRecordingCount);
+                return;
+            }
+            if (RecordingSecondaryCommandBuffer != VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("cannot begin secondary recording - the thread is already recording another secondary command buffer");
+                return;
+            }
+
+            const auto& commandBuffer = _secondaryCommandBuffers[_currentBufferIndex][_parallelRecordingFirstIndex + secondaryIndex].commandBuffer;
+
+            auto inheritanceRenderingInfo = VKUtils::InitVkCommandBufferInheritanceRenderingInfo();
+            inheritanceRenderingInfo.colorAttachmentCount = UInt32(_secondaryRenderingParameters.colorAttachmentFormats.size());
+            inheritanceRenderingInfo.pColorAttachmentFormats = _secondaryRenderingParameters.colorAttachmentFormats.data();
+            inheritanceRenderingInfo.depthAttachmentFormat = _secondaryRenderingParameters.depthAttachmentFormat;
+            inheritanceRenderingInfo.stencilAttachmentFormat = _secondaryRenderingParameters.stencilAttachmentFormat;
+            inheritanceRenderingInfo.rasterizationSamples = _secondaryRenderingParameters.rasterizationSamples;
+
+            auto inheritanceInfo = VKUtils::InitVkCommandBufferInheritanceInfo();
+            inheritanceInfo.pNext = &inheritanceRenderingInfo;
+
+            commandBuffer.Begin(VK_CommandBufferUsage_OneTimeSubmit | VK_CommandBufferUsage_RenderPassContinue, inheritanceInfo);
+            RecordingSecondaryCommandBuffer = commandBuffer.GetVkCommandBuffer();
+            RecordingSecondaryBoundPipeline = VK_NULL_HANDLE;
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanRenderer::EndSecondaryRecording() const KMP_PROFILING(ProfileLevelMinor)
+        {
+            if (RecordingSecondaryCommandBuffer == VK_NULL_HANDLE)
+            {
+                KMP_LOG_ERROR("cannot end secondary recording - the thread is not recording any secondary command buffer");
+                return;
+            }
+
+            const auto result = vkEndCommandBuffer(RecordingSecondaryCommandBuffer);
+            RecordingSecondaryCommandBuffer = VK_NULL_HANDLE;
+            RecordingSecondaryBoundPipeline = VK_NULL_HANDLE;
+            VKUtils::CheckResult(result, "VulkanRenderer: failed to end secondary command buffer");
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanRenderer::ExecuteSecondaries() const KMP_PROFILING(ProfileLevelMinor)
         {
             KMP_ASSERT(_currentCommandBuffer);
 
-            return _currentCommandBuffer;
+            if (_parallelRecordingCount == 0)
+            {
+                KMP_LOG_ERROR("cannot execute secondary command buffers - parallel recording has not been started");
+                return;
+            }
+
+            const auto& secondaries = _secondaryCommandBuffers[_currentBufferIndex];
+            Vector<VkCommandBuffer> commandBuffers;
+            commandBuffers.reserve(_parallelRecordingCount);
+            for (UInt32 i = 0; i < _parallelRecordingCount; i++)
+            {
+                commandBuffers.push_back(secondaries[_parallelRecordingFirstIndex + i].commandBuffer.GetVkCommandBuffer());
+            }
+
+            vkCmdExecuteCommands(_currentCommandBuffer, UInt32(commandBuffers.size()), commandBuffers.data());
+            _parallelRecordingCount = 0;
+
+            // the state of the primary command buffer is undefined after the secondaries
+            _boundPipeline = VK_NULL_HANDLE;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanRenderer::GetParallelRecordingCount() const noexcept
+        {
+            return _parallelRecordingCount;
         }
         //--------------------------------------------------------------------------
 
@@ -705,10 +934,27 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        VkCommandBuffer VulkanRenderer::_GetRecordingCommandBuffer() const noexcept
+        {
+            return RecordingSecondaryCommandBuffer != VK_NULL_HANDLE ? RecordingSecondaryCommandBuffer : _currentCommandBuffer;
+        }
+        //--------------------------------------------------------------------------
+
+        VkPipeline& VulkanRenderer::_GetBoundPipeline() const noexcept
+        {
+            return RecordingSecondaryCommandBuffer != VK_NULL_HANDLE ? RecordingSecondaryBoundPipeline : _boundPipeline;
+        }
+        //--------------------------------------------------------------------------
+
         void VulkanRenderer::_Finalize()
         {
             KMP_ASSERT(_commandPool && not _drawCommandBuffers.empty());
 
+            for (auto& secondaries : _secondaryCommandBuffers)
+            {
+                secondaries.clear();
+            }
+
             _drawCommandBuffers.clear();
             _commandPool.reset();
         }
@@ -722,6 +968,16 @@ namespace Kmplete
             _drawCommandBuffers[_currentBufferIndex].Begin();
             _currentCommandBuffer = _drawCommandBuffers[_currentBufferIndex].GetVkCommandBuffer();
             KMP_ASSERT(_currentCommandBuffer);
+            _boundPipeline = VK_NULL_HANDLE;
+
+            // the frame's fence has been waited, so the secondaries recorded the last time this frame index was used are not pending
+            auto& secondaries = _secondaryCommandBuffers[_currentBufferIndex];
+            for (UInt32 i = 0; i < _usedSecondariesCount[_currentBufferIndex]; i++)
+            {
+                secondaries[i].commandPool->Reset();
+            }
+            _usedSecondariesCount[_currentBufferIndex] = 0;
+            _parallelRecordingCount = 0;
 
             return true;
         }}
@@ -0,0 +1,107 @@
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_text_renderer.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_renderer.h"
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_buffer_manager.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Graphics/glyph_atlas.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Profile/profiler.h"
+#include "Kmplete/Log/log.h"
+
+#include <algorithm>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        using namespace VKBits;
+
+
+        VulkanTextRenderer::VulkanTextRenderer(VulkanGraphicsBackend& graphicsBackend, GlyphAtlas& glyphAtlas, UInt64 verticesCapacity /*= DefaultVerticesCapacity*/)
+            : TextRenderer(glyphAtlas)
+              KMP_PROFILE_CONSTRUCTOR_START_DERIVED_CLASS()
+            , _graphicsBackend(graphicsBackend)
+            , _logicalDevice(graphicsBackend.GetPhysicalDevice().GetLogicalDevice())
+            , _vertexBuffers()
+        {
+            for (auto& vertexBuffer : _vertexBuffers)
+            {
+                vertexBuffer = _CreateVertexBuffer(std::max(verticesCapacity, UInt64(VerticesPerGlyph)));
+            }
+
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanTextRenderer::Prepare() KMP_PROFILING(ProfileLevelMinor)
+        {
+            auto prepared = _glyphAtlas.Upload(_graphicsBackend);
+
+            auto& vertexBuffer = _vertexBuffers[_graphicsBackend.GetCurrentBufferIndex()];
+            const auto verticesCount = GetVerticesCount();
+            const auto verticesCapacity = UInt64(vertexBuffer->GetSize() / sizeof(FontCharacterVertex));
+            if (verticesCount > verticesCapacity)
+            {
+                // the previous frame that used this buffer has finished already, so it may be replaced right away
+                vertexBuffer = _CreateVertexBuffer(std::max(verticesCount, verticesCapacity * 2));
+            }
+
+            const auto mappedVertices = static_cast<FontCharacterVertex*>(vertexBuffer->GetMappedPtr());
+            const auto capacity = vertexBuffer->GetSize() / sizeof(FontCharacterVertex);
+            if (WriteVertices(Span<FontCharacterVertex>(mappedVertices, capacity)) != verticesCount)
+            {
+                prepared = false;
+            }
+
+            return prepared;
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanTextRenderer::Render(UInt32 vertexBufferBinding, const Function<void(UInt32 page)>& bindPage) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            const auto& batches = GetBatches();
+            if (batches.empty())
+            {
+                return;
+            }
+
+            const auto& renderer = _logicalDevice.GetRenderer();
+            renderer.BindVertexBuffers(vertexBufferBinding, { GetVertexBuffer().GetVkBuffer() }, { 0 });
+
+            for (const auto& batch : batches)
+            {
+                bindPage(batch.page);
+                renderer.Draw(batch.vertexCount, 1, batch.firstVertex, 0);
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        const VulkanVertexBuffer& VulkanTextRenderer::GetVertexBuffer() const
+        {
+            return *_vertexBuffers[_graphicsBackend.GetCurrentBufferIndex()];
+        }
+        //--------------------------------------------------------------------------
+
+        UPtr<VulkanVertexBuffer> VulkanTextRenderer::_CreateVertexBuffer(UInt64 verticesCapacity) const KMP_PROFILING(ProfileLevelImportant)
+        {
+            auto vertexBuffer = CreateUPtr<VulkanVertexBuffer>(_logicalDevice.GetBufferManager().CreateVertexBuffer({
+                VK_BufferUsage_Vertex, VK_Memory_HostVisible | VK_Memory_HostCoherent, verticesCapacity * sizeof(FontCharacterVertex)
+            }));
+
+            vertexBuffer->AddLayout(BufferLayout{
+                BufferElement{ ShaderDataType::Float2, VertexPositionLocation },
+                BufferElement{ ShaderDataType::Float2, VertexUVLocation }
+            });
+
+            // host-coherent memory stays mapped, so the vertices of a frame are written without map/flush calls
+            KMP_MB_UNUSED const auto result = vertexBuffer->Map();
+            KMP_ASSERT(result == VK_SUCCESS && vertexBuffer->GetMappedPtr());
+
+            return vertexBuffer;
+        }}
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -55,5 +55,12 @@ namespace Kmplete
             return formatProperties.optimalTilingFeatures & VK_FormatFeature_SampledImageFilterLinear;
         }
         //--------------------------------------------------------------------------
+
+        bool VulkanFormatDelegate::IsSampledImageCompatible(VkFormat format) const
+        {
+            const auto formatProperties = GetFormatProperties(format);
+            return formatProperties.optimalTilingFeatures & VK_FormatFeature_SampledImage;
+        }
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
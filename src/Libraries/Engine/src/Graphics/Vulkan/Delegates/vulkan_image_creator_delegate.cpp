@@ -14,9 +14,9 @@ namespace Kmplete
         using namespace VKBits;
 
 
-        VulkanImageCreatorDelegate::VulkanImageCreatorDelegate(VkDevice device, const VulkanMemoryTypeDelegate& memoryTypeDelegate)
+        VulkanImageCreatorDelegate::VulkanImageCreatorDelegate(VkDevice device, VulkanMemoryAllocator& memoryAllocator)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
-              _memoryTypeDelegate(memoryTypeDelegate)
+              _memoryAllocator(memoryAllocator)
             , _device(device)
         {
             KMP_PROFILE_CONSTRUCTOR_END()
@@ -68,7 +68,7 @@ namespace Kmplete
 
         VulkanImage VulkanImageCreatorDelegate::CreateVulkanImage(const VkImageCreateInfo& creationParameters, VkMemoryPropertyFlags memoryProperties) const KMP_PROFILING(ProfileLevelMinor)
         {
-            return VulkanImage(_device, creationParameters, _memoryTypeDelegate, memoryProperties);
+            return VulkanImage(_device, creationParameters, _memoryAllocator, memoryProperties);
         }}
         //--------------------------------------------------------------------------
 
@@ -106,7 +106,7 @@ namespace Kmplete
 
         Nullable<VulkanImage*> VulkanImageCreatorDelegate::CreateVulkanImagePtr(const VkImageCreateInfo& creationParameters, VkMemoryPropertyFlags memoryProperties) const KMP_PROFILING(ProfileLevelMinor)
         {
-            return new VulkanImage(_device, creationParameters, _memoryTypeDelegate, memoryProperties);
+            return new VulkanImage(_device, creationParameters, _memoryAllocator, memoryProperties);
         }}
         //--------------------------------------------------------------------------
 
@@ -142,7 +142,7 @@ namespace Kmplete
 
         VulkanBuffer VulkanImageCreatorDelegate::CreateStagingImageBuffer(const Image& image) const KMP_PROFILING(ProfileLevelMinor)
         {
-            auto buffer = VulkanBuffer(_memoryTypeDelegate, _device, { VK_BufferUsage_TransferSrc, VK_Memory_HostVisible, image.GetDataSize() });
+            auto buffer = VulkanBuffer(_memoryAllocator, _device, { VK_BufferUsage_TransferSrc, VK_Memory_HostVisible, image.GetDataSize(), VulkanMemoryStrategy::Linear });
 
             auto result = buffer.Map();
             VKUtils::CheckResult(result, "VulkanImageCreatorDelegate: failed to map texture buffer");
@@ -0,0 +1,340 @@
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_context.h"
+#include "Kmplete/Graphics/Vulkan/Delegates/vulkan_memory_type_delegate.h"
+#include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
+#include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Math/math.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <bit>
+#include <algorithm>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        using namespace VKBits;
+
+
+        VulkanMemoryAllocator::VulkanMemoryAllocator(VkDevice device, const VulkanContext& vulkanContext, const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkDeviceSize preferredBlockSize /*= DefaultBlockSize*/)
+            : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+              _device(device)
+            , _vulkanContext(vulkanContext)
+            , _memoryTypeDelegate(memoryTypeDelegate)
+            , _heapBlockSizes()
+            , _pools()
+            , _dedicatedStatistics(vulkanContext.memoryProperties.memoryHeapCount)
+        {
+            KMP_ASSERT(_device);
+
+            // blocks are power of 2 sized (required by the buddy strategy) and take no more than 1/8 of a heap
+            preferredBlockSize = std::bit_floor(std::max(preferredBlockSize, MinBlockSize));
+            const auto& memoryProperties = _vulkanContext.memoryProperties;
+            _heapBlockSizes.reserve(memoryProperties.memoryHeapCount);
+            for (UInt32 i = 0; i < memoryProperties.memoryHeapCount; i++)
+            {
+                const auto heapLimit = std::bit_floor(std::max(memoryProperties.memoryHeaps[i].size / 8, MinBlockSize));
+                _heapBlockSizes.push_back(std::min(preferredBlockSize, heapLimit));
+            }
+
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryAllocator::~VulkanMemoryAllocator() KMP_PROFILING(ProfileLevelAlways)
+        {
+            for (UInt32 i = 0; i < _dedicatedStatistics.size(); i++)
+            {
+                if (_dedicatedStatistics[i].dedicatedAllocationsCount != 0)
+                {
+                    KMP_LOG_WARN("{} dedicated allocation(s) of heap {} have not been freed", _dedicatedStatistics[i].dedicatedAllocationsCount, i);
+                }
+            }
+
+            for (const auto& [key, blocks] : _pools)
+            {
+                for (const auto& block : blocks)
+                {
+                    if (not block->IsEmpty())
+                    {
+                        KMP_LOG_WARN("{} sub-allocation(s) of memory type {} have not been freed", block->GetAllocationsCount(), block->GetMemoryTypeIndex());
+                    }
+                }
+            }
+
+            _pools.clear();
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryAllocation VulkanMemoryAllocator::AllocateBufferMemory(VkBuffer buffer, VkMemoryPropertyFlags properties, VulkanMemoryStrategy strategy, bool deviceAddress /*= false*/) KMP_PROFILING(ProfileLevelMinor)
+        {
+            const auto memoryContext = _memoryTypeDelegate.GetBufferMemoryContext(_device, buffer, properties);
+            return _Allocate(memoryContext.requirements, memoryContext.allocateInfo.memoryTypeIndex, strategy, false, deviceAddress);
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryAllocation VulkanMemoryAllocator::AllocateImageMemory(VkImage image, VkMemoryPropertyFlags properties, VulkanMemoryStrategy strategy) KMP_PROFILING(ProfileLevelMinor)
+        {
+            const auto memoryContext = _memoryTypeDelegate.GetImageMemoryContext(_device, image, properties);
+            return _Allocate(memoryContext.requirements, memoryContext.allocateInfo.memoryTypeIndex, strategy, true, false);
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanMemoryAllocator::Free(VulkanMemoryAllocation& allocation) KMP_PROFILING(ProfileLevelMinor)
+        {
+            if (not allocation.IsValid())
+            {
+                return;
+            }
+
+            std::lock_guard lock(_mutex);
+
+            if (allocation.IsDedicated())
+            {
+                vkFreeMemory(_device, allocation.memory, nullptr);
+
+                const auto heapIndex = _vulkanContext.memoryProperties.memoryTypes[allocation.memoryTypeIndex].heapIndex;
+                auto& statistics = _dedicatedStatistics[heapIndex];
+                statistics.dedicatedAllocationsCount--;
+                statistics.dedicatedAllocationsBytes -= allocation.size;
+            }
+            else
+            {
+                auto block = allocation.block;
+                if (not block->Free(allocation.offset))
+                {
+                    KMP_LOG_ERROR("failed to free sub-allocation at offset {}", allocation.offset);
+                }
+                else if (block->IsEmpty())
+                {
+                    _ReleaseEmptyBlock(block);
+                }
+            }
+
+            allocation = VulkanMemoryAllocation{};
+        }}
+        //--------------------------------------------------------------------------
+
+        VkResult VulkanMemoryAllocator::Map(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset, void** data) KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(allocation.IsValid() && data);
+
+            if (allocation.IsDedicated())
+            {
+                return vkMapMemory(_device, allocation.memory, offset, size, 0, data);
+            }
+
+            std::lock_guard lock(_mutex);
+
+            auto blockData = static_cast<char*>(allocation.block->Map());
+            *data = blockData + allocation.offset + offset;
+
+            return VK_SUCCESS;
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanMemoryAllocator::Unmap(const VulkanMemoryAllocation& allocation) KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(allocation.IsValid());
+
+            // sub-allocated blocks stay persistently mapped
+            if (allocation.IsDedicated())
+            {
+                vkUnmapMemory(_device, allocation.memory);
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        VkResult VulkanMemoryAllocator::Flush(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(allocation.IsValid());
+
+            const auto mappedRange = _GetMappedRange(allocation, size, offset);
+            return vkFlushMappedMemoryRanges(_device, 1, &mappedRange);
+        }}
+        //--------------------------------------------------------------------------
+
+        VkResult VulkanMemoryAllocator::Invalidate(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(allocation.IsValid());
+
+            const auto mappedRange = _GetMappedRange(allocation, size, offset);
+            return vkInvalidateMappedMemoryRanges(_device, 1, &mappedRange);
+        }}
+        //--------------------------------------------------------------------------
+
+        Vector<VulkanMemoryAllocator::HeapStatistics> VulkanMemoryAllocator::GetHeapStatistics() const KMP_PROFILING(ProfileLevelMinor)
+        {
+            std::lock_guard lock(_mutex);
+
+            auto heapStatistics = _dedicatedStatistics;
+            for (const auto& [key, blocks] : _pools)
+            {
+                for (const auto& block : blocks)
+                {
+                    const auto heapIndex = _vulkanContext.memoryProperties.memoryTypes[block->GetMemoryTypeIndex()].heapIndex;
+                    auto& statistics = heapStatistics[heapIndex];
+                    statistics.blocksCount++;
+                    statistics.blocksBytes += block->GetSize();
+                    statistics.subAllocationsCount += block->GetAllocationsCount();
+                    statistics.subAllocationsBytes += block->GetUsedSize();
+                }
+            }
+
+            return heapStatistics;
+        }}
+        //--------------------------------------------------------------------------
+
+        VkDeviceSize VulkanMemoryAllocator::GetBlockSize(UInt32 memoryTypeIndex) const
+        {
+            KMP_ASSERT(memoryTypeIndex < _vulkanContext.memoryProperties.memoryTypeCount);
+
+            return _heapBlockSizes[_vulkanContext.memoryProperties.memoryTypes[memoryTypeIndex].heapIndex];
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryAllocation VulkanMemoryAllocator::_Allocate(const VkMemoryRequirements& requirements, UInt32 memoryTypeIndex, VulkanMemoryStrategy strategy, bool isImage, bool deviceAddress) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            auto size = requirements.size;
+            auto alignment = requirements.alignment;
+
+            // keep mapped ranges of sub-allocations flushable without touching neighbours
+            if (_IsHostVisible(memoryTypeIndex))
+            {
+                const auto atomSize = _vulkanContext.deviceProperties.limits.nonCoherentAtomSize;
+                alignment = std::max(alignment, atomSize);
+                size = Math::AlignUp(size, atomSize);
+            }
+
+            const auto blockSize = GetBlockSize(memoryTypeIndex);
+
+            std::lock_guard lock(_mutex);
+
+            if (strategy == VulkanMemoryStrategy::Dedicated || deviceAddress || size > blockSize / 2)
+            {
+                return _AllocateDedicated(size, memoryTypeIndex, deviceAddress);
+            }
+
+            auto& blocks = _pools[_GetPoolKey(memoryTypeIndex, strategy, isImage)];
+            for (auto& block : blocks)
+            {
+                const auto offset = block->Allocate(size, alignment);
+                if (offset)
+                {
+                    return VulkanMemoryAllocation{ block->GetVkDeviceMemory(), offset.value(), size, memoryTypeIndex, block.get() };
+                }
+            }
+
+            auto& block = blocks.emplace_back(CreateUPtr<VulkanMemoryBlock>(_device, memoryTypeIndex, blockSize, strategy));
+            const auto offset = block->Allocate(size, alignment);
+            if (not offset)
+            {
+                return _AllocateDedicated(size, memoryTypeIndex, deviceAddress);
+            }
+
+            return VulkanMemoryAllocation{ block->GetVkDeviceMemory(), offset.value(), size, memoryTypeIndex, block.get() };
+        }}
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryAllocation VulkanMemoryAllocator::_AllocateDedicated(VkDeviceSize size, UInt32 memoryTypeIndex, bool deviceAddress)
+        {
+            auto allocateInfo = VKUtils::InitVkMemoryAllocateInfo();
+            allocateInfo.allocationSize = size;
+            allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+            VkMemoryAllocateFlagsInfoKHR allocateFlagsInfo = VKUtils::InitVkMemoryAllocateFlagsInfoKHR();
+            if (deviceAddress)
+            {
+                allocateFlagsInfo.flags = VK_MemoryAllocate_DeviceAddress;
+                allocateInfo.pNext = &allocateFlagsInfo;
+            }
+
+            VulkanMemoryAllocation allocation{};
+            const auto result = vkAllocateMemory(_device, &allocateInfo, nullptr, &allocation.memory);
+            VKUtils::CheckResult(result, "VulkanMemoryAllocator: failed to allocate dedicated memory");
+            KMP_ASSERT(allocation.memory);
+
+            allocation.size = size;
+            allocation.memoryTypeIndex = memoryTypeIndex;
+
+            const auto heapIndex = _vulkanContext.memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+            auto& statistics = _dedicatedStatistics[heapIndex];
+            statistics.dedicatedAllocationsCount++;
+            statistics.dedicatedAllocationsBytes += size;
+
+            return allocation;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanMemoryAllocator::_IsHostVisible(UInt32 memoryTypeIndex) const noexcept
+        {
+            return _vulkanContext.memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_Memory_HostVisible;
+        }
+        //--------------------------------------------------------------------------
+
+        VkMappedMemoryRange VulkanMemoryAllocator::_GetMappedRange(const VulkanMemoryAllocation& allocation, VkDeviceSize size, VkDeviceSize offset) const
+        {
+            if (allocation.IsDedicated())
+            {
+                auto mappedRange = VKUtils::InitVkMappedMemoryRange(size, offset);
+                mappedRange.memory = allocation.memory;
+                return mappedRange;
+            }
+
+            KMP_ASSERT(offset <= allocation.size);
+
+            // sub-allocation offset and size are both multiples of nonCoherentAtomSize,
+            // so the whole size rounding can't spill into the neighbouring allocation
+            const auto rangeSize = size == VK_WHOLE_SIZE ? allocation.size - offset : size;
+            auto mappedRange = VKUtils::InitVkMappedMemoryRange(rangeSize, allocation.offset + offset);
+            mappedRange.memory = allocation.memory;
+            return mappedRange;
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanMemoryAllocator::_ReleaseEmptyBlock(const VulkanMemoryBlock* block)
+        {
+            for (const auto isImage : { false, true })
+            {
+                const auto poolIt = _pools.find(_GetPoolKey(block->GetMemoryTypeIndex(), block->GetStrategy(), isImage));
+                if (poolIt == _pools.end())
+                {
+                    continue;
+                }
+
+                auto& blocks = poolIt->second;
+                const auto blockIt = std::find_if(blocks.begin(), blocks.end(), [block](const UPtr<VulkanMemoryBlock>& poolBlock) {
+                    return poolBlock.get() == block;
+                });
+
+                if (blockIt == blocks.end())
+                {
+                    continue;
+                }
+
+                // one empty block per pool is kept to avoid allocation churn of create/destroy patterns
+                const auto hasOtherEmptyBlock = std::any_of(blocks.begin(), blocks.end(), [block](const UPtr<VulkanMemoryBlock>& poolBlock) {
+                    return poolBlock.get() != block && poolBlock->IsEmpty();
+                });
+
+                if (hasOtherEmptyBlock)
+                {
+                    blocks.erase(blockIt);
+                }
+
+                return;
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 VulkanMemoryAllocator::_GetPoolKey(UInt32 memoryTypeIndex, VulkanMemoryStrategy strategy, bool isImage) noexcept
+        {
+            return (static_cast<UInt64>(memoryTypeIndex) << 16) | (static_cast<UInt64>(strategy) << 8) | static_cast<UInt64>(isImage);
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_block.h"
+#include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
+#include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Profile/profiler.h"
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        VulkanMemoryBlock::VulkanMemoryBlock(VkDevice device, UInt32 memoryTypeIndex, VkDeviceSize size, VulkanMemoryStrategy strategy)
+            : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+              _device(device)
+            , _memory(VK_NULL_HANDLE)
+            , _memoryTypeIndex(memoryTypeIndex)
+            , _strategyType(strategy)
+            , _strategy(VulkanMemoryBlockStrategy::Create(strategy, size))
+            , _mapped(nullptr)
+        {
+            KMP_ASSERT(_device && _strategy);
+
+            auto allocateInfo = VKUtils::InitVkMemoryAllocateInfo();
+            allocateInfo.allocationSize = size;
+            allocateInfo.memoryTypeIndex = _memoryTypeIndex;
+
+            const auto result = vkAllocateMemory(_device, &allocateInfo, nullptr, &_memory);
+            VKUtils::CheckResult(result, "VulkanMemoryBlock: failed to allocate memory block");
+            KMP_ASSERT(_memory);
+
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryBlock::~VulkanMemoryBlock() KMP_PROFILING(ProfileLevelAlways)
+        {
+            if (_device && _memory)
+            {
+                if (_mapped)
+                {
+                    vkUnmapMemory(_device, _memory);
+                }
+
+                vkFreeMemory(_device, _memory, nullptr);
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        Optional<VkDeviceSize> VulkanMemoryBlock::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+        {
+            return _strategy->Allocate(size, alignment);
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanMemoryBlock::Free(VkDeviceSize offset)
+        {
+            return _strategy->Free(offset);
+        }
+        //--------------------------------------------------------------------------
+
+        void* VulkanMemoryBlock::Map() KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(_device && _memory);
+
+            if (not _mapped)
+            {
+                const auto result = vkMapMemory(_device, _memory, 0, VK_WHOLE_SIZE, 0, &_mapped);
+                VKUtils::CheckResult(result, "VulkanMemoryBlock: failed to map memory block");
+            }
+
+            return _mapped;
+        }}
+        //--------------------------------------------------------------------------
+
+        VkDeviceMemory VulkanMemoryBlock::GetVkDeviceMemory() const noexcept
+        {
+            return _memory;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanMemoryBlock::GetMemoryTypeIndex() const noexcept
+        {
+            return _memoryTypeIndex;
+        }
+        //--------------------------------------------------------------------------
+
+        VkDeviceSize VulkanMemoryBlock::GetSize() const noexcept
+        {
+            return _strategy->GetBlockSize();
+        }
+        //--------------------------------------------------------------------------
+
+        VkDeviceSize VulkanMemoryBlock::GetUsedSize() const noexcept
+        {
+            return _strategy->GetUsedSize();
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanMemoryBlock::GetAllocationsCount() const noexcept
+        {
+            return _strategy->GetAllocationsCount();
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryStrategy VulkanMemoryBlock::GetStrategy() const noexcept
+        {
+            return _strategyType;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanMemoryBlock::IsEmpty() const noexcept
+        {
+            return _strategy->IsEmpty();
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_block_strategy.h"
+#include "Kmplete/Math/math.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <bit>
+#include <algorithm>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        UPtr<VulkanMemoryBlockStrategy> VulkanMemoryBlockStrategy::Create(VulkanMemoryStrategy strategy, VkDeviceSize blockSize)
+        {
+            switch (strategy)
+            {
+            case VulkanMemoryStrategy::Linear:
+                return CreateUPtr<VulkanMemoryLinearStrategy>(blockSize);
+
+            case VulkanMemoryStrategy::Buddy:
+                return CreateUPtr<VulkanMemoryBuddyStrategy>(blockSize);
+
+            case VulkanMemoryStrategy::FreeList:
+                return CreateUPtr<VulkanMemoryFreeListStrategy>(blockSize);
+
+            case VulkanMemoryStrategy::Dedicated:
+            default:
+                return nullptr;
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanMemoryBlockStrategy::VulkanMemoryBlockStrategy(VkDeviceSize blockSize) noexcept
+            : _blockSize(blockSize)
+            , _usedSize(0ULL)
+            , _allocationsCount(0)
+        {}
+        //--------------------------------------------------------------------------
+
+        VkDeviceSize VulkanMemoryBlockStrategy::GetBlockSize() const noexcept
+        {
+            return _blockSize;
+        }
+        //--------------------------------------------------------------------------
+
+        VkDeviceSize VulkanMemoryBlockStrategy::GetUsedSize() const noexcept
+        {
+            return _usedSize;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanMemoryBlockStrategy::GetAllocationsCount() const noexcept
+        {
+            return _allocationsCount;
+        }
+        //--------------------------------------------------------------------------
+
+        bool VulkanMemoryBlockStrategy::IsEmpty() const noexcept
+        {
+            return _allocationsCount == 0;
+        }
+        //--------------------------------------------------------------------------
+
+
+        VulkanMemoryLinearStrategy::VulkanMemoryLinearStrategy(VkDeviceSize blockSize)
+            : VulkanMemoryBlockStrategy(blockSize)
+            , _head(0ULL)
+            , _allocations()
+        {}
+        //--------------------------------------------------------------------------
+
+        Optional<VkDeviceSize> VulkanMemoryLinearStrategy::Allocate(VkDeviceSize size, VkDeviceSize alignment) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            const auto offset = Math::AlignUp(_head, alignment);
+            if (size == 0 || offset + size > _blockSize)
+            {
+                return std::nullopt;
+            }
+
+            _allocations.emplace(offset, Allocation{ _head, size });
+            _head = offset + size;
+            _usedSize += size;
+            _allocationsCount++;
+
+            return offset;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool VulkanMemoryLinearStrategy::Free(VkDeviceSize offset) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            const auto it = _allocations.find(offset);
+            if (it == _allocations.end())
+            {
+                return false;
+            }
+
+            const auto allocation = it->second;
+            _allocations.erase(it);
+            _usedSize -= allocation.size;
+            _allocationsCount--;
+
+            if (_allocationsCount == 0)
+            {
+                _head = 0ULL;
+            }
+            else if (offset + allocation.size == _head)
+            {
+                _head = allocation.previousHead;
+            }
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+
+        VulkanMemoryBuddyStrategy::VulkanMemoryBuddyStrategy(VkDeviceSize blockSize)
+            : VulkanMemoryBlockStrategy(blockSize)
+            , _maxOrder(0)
+            , _freeLists()
+            , _allocations()
+        {
+            KMP_ASSERT(std::has_single_bit(blockSize) && blockSize >= MinAllocationSize);
+
+            _maxOrder = static_cast<UInt32>(std::countr_zero(blockSize) - std::countr_zero(MinAllocationSize));
+            _freeLists.resize(_maxOrder + 1);
+            _freeLists[_maxOrder].insert(0ULL);
+        }
+        //--------------------------------------------------------------------------
+
+        Optional<VkDeviceSize> VulkanMemoryBuddyStrategy::Allocate(VkDeviceSize size, VkDeviceSize alignment) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            if (size == 0)
+            {
+                return std::nullopt;
+            }
+
+            // every buddy node is aligned to its own size, so the alignment is satisfied by the node size
+            const auto nodeSize = std::bit_ceil(std::max({ size, alignment, MinAllocationSize }));
+            if (nodeSize > _blockSize)
+            {
+                return std::nullopt;
+            }
+
+            const auto order = static_cast<UInt32>(std::countr_zero(nodeSize) - std::countr_zero(MinAllocationSize));
+
+            auto freeOrder = order;
+            while (freeOrder <= _maxOrder && _freeLists[freeOrder].empty())
+            {
+                freeOrder++;
+            }
+
+            if (freeOrder > _maxOrder)
+            {
+                return std::nullopt;
+            }
+
+            const auto offset = *_freeLists[freeOrder].begin();
+            _freeLists[freeOrder].erase(_freeLists[freeOrder].begin());
+
+            while (freeOrder > order)
+            {
+                freeOrder--;
+                _freeLists[freeOrder].insert(offset + _GetOrderSize(freeOrder));
+            }
+
+            _allocations.emplace(offset, order);
+            _usedSize += nodeSize;
+            _allocationsCount++;
+
+            return offset;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool VulkanMemoryBuddyStrategy::Free(VkDeviceSize offset) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            const auto it = _allocations.find(offset);
+            if (it == _allocations.end())
+            {
+                return false;
+            }
+
+            auto order = it->second;
+            _allocations.erase(it);
+            _usedSize -= _GetOrderSize(order);
+            _allocationsCount--;
+
+            while (order < _maxOrder)
+            {
+                const auto buddyOffset = offset ^ _GetOrderSize(order);
+                const auto buddyIt = _freeLists[order].find(buddyOffset);
+                if (buddyIt == _freeLists[order].end())
+                {
+                    break;
+                }
+
+                _freeLists[order].erase(buddyIt);
+                offset = std::min(offset, buddyOffset);
+                order++;
+            }
+
+            _freeLists[order].insert(offset);
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        VkDeviceSize VulkanMemoryBuddyStrategy::_GetOrderSize(UInt32 order) const noexcept
+        {
+            return MinAllocationSize << order;
+        }
+        //--------------------------------------------------------------------------
+
+
+        VulkanMemoryFreeListStrategy::VulkanMemoryFreeListStrategy(VkDeviceSize blockSize)
+            : VulkanMemoryBlockStrategy(blockSize)
+            , _freeRanges()
+            , _allocations()
+        {
+            _freeRanges.emplace(0ULL, blockSize);
+        }
+        //--------------------------------------------------------------------------
+
+        Optional<VkDeviceSize> VulkanMemoryFreeListStrategy::Allocate(VkDeviceSize size, VkDeviceSize alignment) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            if (size == 0)
+            {
+                return std::nullopt;
+            }
+
+            auto bestIt = _freeRanges.end();
+            auto bestLeftover = _blockSize;
+            for (auto it = _freeRanges.begin(); it != _freeRanges.end(); ++it)
+            {
+                const auto& [rangeOffset, rangeSize] = *it;
+                const auto padding = Math::AlignUp(rangeOffset, alignment) - rangeOffset;
+                if (padding + size > rangeSize)
+                {
+                    continue;
+                }
+
+                const auto leftover = rangeSize - padding - size;
+                if (bestIt == _freeRanges.end() || leftover < bestLeftover)
+                {
+                    bestIt = it;
+                    bestLeftover = leftover;
+
+                    if (leftover == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (bestIt == _freeRanges.end())
+            {
+                return std::nullopt;
+            }
+
+            const auto rangeOffset = bestIt->first;
+            const auto alignedOffset = Math::AlignUp(rangeOffset, alignment);
+            const auto allocatedSize = alignedOffset - rangeOffset + size;
+            _freeRanges.erase(bestIt);
+
+            if (bestLeftover > 0)
+            {
+                _freeRanges.emplace(rangeOffset + allocatedSize, bestLeftover);
+            }
+
+            _allocations.emplace(alignedOffset, Range{ rangeOffset, allocatedSize });
+            _usedSize += allocatedSize;
+            _allocationsCount++;
+
+            return alignedOffset;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool VulkanMemoryFreeListStrategy::Free(VkDeviceSize offset) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            const auto it = _allocations.find(offset);
+            if (it == _allocations.end())
+            {
+                return false;
+            }
+
+            auto range = it->second;
+            _allocations.erase(it);
+            _usedSize -= range.size;
+            _allocationsCount--;
+
+            auto nextIt = _freeRanges.lower_bound(range.offset);
+            if (nextIt != _freeRanges.end() && range.offset + range.size == nextIt->first)
+            {
+                range.size += nextIt->second;
+                nextIt = _freeRanges.erase(nextIt);
+            }
+
+            if (nextIt != _freeRanges.begin())
+            {
+                const auto prevIt = std::prev(nextIt);
+                if (prevIt->first + prevIt->second == range.offset)
+                {
+                    prevIt->second += range.size;
+                    return true;
+                }
+            }
+
+            _freeRanges.emplace_hint(nextIt, range.offset, range.size);
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        size_t VulkanMemoryFreeListStrategy::GetFreeRangesCount() const noexcept
+        {
+            return _freeRanges.size();
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
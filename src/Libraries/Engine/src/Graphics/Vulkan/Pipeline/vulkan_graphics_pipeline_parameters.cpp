@@ -4,9 +4,14 @@
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
 #include "Kmplete/Graphics/Vulkan/Utils/presets.h"
 #include "Kmplete/Utils/vector_utils.h"
+#include "Kmplete/Utils/memory_utils.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Base/type_traits.h"
 #include "Kmplete/Profile/profiler.h"
 #include "Kmplete/Log/log.h"
 
+#include <cstring>
+
 
 namespace Kmplete
 {
@@ -15,6 +20,54 @@ namespace Kmplete
         using namespace VKBits;
 
 
+        namespace
+        {
+            //! Pipeline state key builder. Vulkan structs are added field by field, so neither their padding
+            //! nor their pNext pointers get into the key
+            class StateKeyWriter
+            {
+            public:
+                template<typename T>
+                void Add(const T& value)
+                {
+                    static_assert(IsTriviallyCopyable<T>::value);
+                    AddBytes(&value, sizeof(T));
+                }
+
+                //! Only for vectors of structs without padding (consisting of 32-bit fields)
+                template<typename T>
+                void AddRange(const Vector<T>& values)
+                {
+                    static_assert(IsTriviallyCopyable<T>::value && sizeof(T) % sizeof(UInt32) == 0);
+                    Add(UInt64(values.size()));
+                    AddBytes(values.data(), values.size() * sizeof(T));
+                }
+
+                void AddString(const char* str)
+                {
+                    const auto length = str ? strlen(str) : 0;
+                    Add(UInt64(length));
+                    AddBytes(str, length);
+                }
+
+                void AddBytes(const void* data, size_t size)
+                {
+                    const auto bytes = static_cast<const UByte*>(data);
+                    _key.insert(_key.end(), bytes, bytes + size);
+                }
+
+                KMP_NODISCARD BinaryBuffer GetKey() noexcept
+                {
+                    return std::move(_key);
+                }
+
+            private:
+                BinaryBuffer _key;
+            };
+            //--------------------------------------------------------------------------
+        }
+
+
         VulkanGraphicsPipelineParameters VulkanGraphicsPipelineParameters::CopyFrom(const VulkanGraphicsPipelineParameters& source, int copyParametersMask /*= OnlyParameters*/) noexcept
         {
             VulkanGraphicsPipelineParameters copy{};
@@ -48,6 +101,7 @@ namespace Kmplete
             if (copyParametersMask & ShaderStages)
             {
                 copy._shadersStages = source._shadersStages;
+                copy._shadersCodeHashes = source._shadersCodeHashes;
             }
 
             return copy;
@@ -71,6 +125,7 @@ namespace Kmplete
             , _vertexInputBindingsDivisors()
             , _vertexAttributesDescriptions()
             , _shadersStages()
+            , _shadersCodeHashes()
             , _renderingCreateInfo()
             , _renderingColorAttachmentsFormats()
         {
@@ -311,9 +366,14 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
-        VulkanGraphicsPipelineParameters& VulkanGraphicsPipelineParameters::AddShaderStages(const Vector<VkPipelineShaderStageCreateInfo>& shaderStages)
+        VulkanGraphicsPipelineParameters& VulkanGraphicsPipelineParameters::AddShaderStages(const Vector<VulkanShaderStage>& shaderStages)
         {
-            Utils::AppendVectors(shaderStages, _shadersStages);
+            for (const auto& shaderStage : shaderStages)
+            {
+                _shadersStages.push_back(shaderStage.createInfo);
+                _shadersCodeHashes.push_back(shaderStage.codeHash);
+            }
+
             return *this;
         }
         //--------------------------------------------------------------------------
@@ -324,6 +384,101 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        BinaryBuffer VulkanGraphicsPipelineParameters::GetStateKey() const KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            KMP_ASSERT(_shadersStages.size() == _shadersCodeHashes.size());
+
+            StateKeyWriter writer;
+
+            writer.Add(_inputAssemblyCreateInfo.topology);
+            writer.Add(_inputAssemblyCreateInfo.primitiveRestartEnable);
+
+            writer.Add(_rasterizationStateCreateInfo.depthClampEnable);
+            writer.Add(_rasterizationStateCreateInfo.rasterizerDiscardEnable);
+            writer.Add(_rasterizationStateCreateInfo.polygonMode);
+            writer.Add(_rasterizationStateCreateInfo.cullMode);
+            writer.Add(_rasterizationStateCreateInfo.frontFace);
+            writer.Add(_rasterizationStateCreateInfo.depthBiasEnable);
+            writer.Add(_rasterizationStateCreateInfo.depthBiasConstantFactor);
+            writer.Add(_rasterizationStateCreateInfo.depthBiasClamp);
+            writer.Add(_rasterizationStateCreateInfo.depthBiasSlopeFactor);
+            writer.Add(_rasterizationStateCreateInfo.lineWidth);
+            writer.Add(_rasterizationLineStateCreateInfo.lineRasterizationMode);
+            writer.Add(_rasterizationLineStateCreateInfo.stippledLineEnable);
+            writer.Add(_rasterizationLineStateCreateInfo.lineStippleFactor);
+            writer.Add(_rasterizationLineStateCreateInfo.lineStipplePattern);
+
+            writer.Add(_colorBlendStateCreateInfo.logicOpEnable);
+            writer.Add(_colorBlendStateCreateInfo.logicOp);
+            writer.Add(_colorBlendStateCreateInfo.blendConstants);
+            writer.AddRange(_colorBlendAttachments);
+
+            writer.Add(_viewportStateCreateInfo.viewportCount);
+            writer.Add(_viewportStateCreateInfo.scissorCount);
+            writer.AddRange(_dynamicStates);
+
+            writer.Add(_depthStencilStateCreateInfo.depthTestEnable);
+            writer.Add(_depthStencilStateCreateInfo.depthWriteEnable);
+            writer.Add(_depthStencilStateCreateInfo.depthCompareOp);
+            writer.Add(_depthStencilStateCreateInfo.depthBoundsTestEnable);
+            writer.Add(_depthStencilStateCreateInfo.stencilTestEnable);
+            writer.Add(_depthStencilStateCreateInfo.front);
+            writer.Add(_depthStencilStateCreateInfo.back);
+            writer.Add(_depthStencilStateCreateInfo.minDepthBounds);
+            writer.Add(_depthStencilStateCreateInfo.maxDepthBounds);
+
+            writer.Add(_multisamplingStateCreateInfo.rasterizationSamples);
+            writer.Add(_multisamplingStateCreateInfo.sampleShadingEnable);
+            writer.Add(_multisamplingStateCreateInfo.minSampleShading);
+            writer.Add(_multisamplingStateCreateInfo.alphaToCoverageEnable);
+            writer.Add(_multisamplingStateCreateInfo.alphaToOneEnable);
+
+            writer.AddRange(_vertexInputBindings);
+            writer.AddRange(_vertexInputBindingsDivisors);
+            writer.AddRange(_vertexAttributesDescriptions);
+
+            writer.Add(UInt64(_shadersStages.size()));
+            for (size_t i = 0; i < _shadersStages.size(); i++)
+            {
+                const auto& shaderStage = _shadersStages[i];
+                writer.Add(shaderStage.flags);
+                writer.Add(shaderStage.stage);
+                writer.Add(_shadersCodeHashes[i]);
+                writer.AddString(shaderStage.pName);
+
+                const auto specializationInfo = shaderStage.pSpecializationInfo;
+                writer.Add(specializationInfo != nullptr);
+                if (specializationInfo)
+                {
+                    writer.Add(specializationInfo->mapEntryCount);
+                    for (UInt32 entryIndex = 0; entryIndex < specializationInfo->mapEntryCount; entryIndex++)
+                    {
+                        const auto& mapEntry = specializationInfo->pMapEntries[entryIndex];
+                        writer.Add(mapEntry.constantID);
+                        writer.Add(mapEntry.offset);
+                        writer.Add(UInt64(mapEntry.size));
+                    }
+                    writer.Add(UInt64(specializationInfo->dataSize));
+                    writer.AddBytes(specializationInfo->pData, specializationInfo->dataSize);
+                }
+            }
+
+            writer.Add(_renderingCreateInfo.viewMask);
+            writer.Add(_renderingCreateInfo.depthAttachmentFormat);
+            writer.Add(_renderingCreateInfo.stencilAttachmentFormat);
+            writer.AddRange(_renderingColorAttachmentsFormats);
+
+            return writer.GetKey();
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt64 VulkanGraphicsPipelineParameters::GetHash() const
+        {
+            const auto stateKey = GetStateKey();
+            return Utils::HashBytes(stateKey.data(), stateKey.size());
+        }
+        //--------------------------------------------------------------------------
+
         void VulkanGraphicsPipelineParameters::_SetDefaults() noexcept
         {
             _inputAssemblyCreateInfo.topology = VK_Primitive_TriangleList;
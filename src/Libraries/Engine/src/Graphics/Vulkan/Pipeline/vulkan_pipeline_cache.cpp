@@ -12,12 +12,14 @@ namespace Kmplete
 {
     namespace Graphics
     {
-        VulkanPipelineCache::VulkanPipelineCache(VkDevice device, const VulkanContext& context, const Filepath& binaryPath)
+        VulkanPipelineCache::VulkanPipelineCache(VkDevice device, const VulkanContext& context, const Filepath& binaryPath, bool readOnly /*= false*/)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(device)
             , _context(context)
             , _cache(VK_NULL_HANDLE)
             , _binaryPath(binaryPath)
+            , _readOnly(readOnly)
+            , _saveMutex()
         {
             _Initialize();
 
@@ -31,45 +33,75 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
-        VkPipelineCache VulkanPipelineCache::GetVkPipelineCache() const noexcept
+        bool VulkanPipelineCache::Merge(const Vector<VkPipelineCache>& sourceCaches) KMP_PROFILING(ProfileLevelImportant)
         {
-            return _cache;
-        }
+            KMP_ASSERT(_device && _cache);
+
+            if (sourceCaches.empty())
+            {
+                return true;
+            }
+
+            const auto result = vkMergePipelineCaches(_device, _cache, UInt32(sourceCaches.size()), sourceCaches.data());
+            return VKUtils::CheckResult(result, "VulkanPipelineCache: failed to merge pipeline caches", "throw exception"_false) == VK_SUCCESS;
+        }}
         //--------------------------------------------------------------------------
 
-        void VulkanPipelineCache::_Initialize()
+        bool VulkanPipelineCache::Save() KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(_device);
+            KMP_ASSERT(_device && _cache);
 
-            bool emptyCache = false;
-            if (not Filesystem::FilepathExists(_binaryPath))
+            if (_readOnly || _binaryPath.empty())
             {
-                KMP_LOG_WARN("cannot load pipeline cache from '{}' - file not found", _binaryPath);
-                emptyCache = true;
+                KMP_LOG_WARN("cannot save pipeline cache - cache is read-only or has no binary path");
+                return false;
             }
 
-            const auto cacheBuffer = Filesystem::ReadFileAsBinary(_binaryPath);
-            emptyCache |= cacheBuffer.empty();
+            // concurrent saves would write the same temporary file
+            std::lock_guard lock(_saveMutex);
 
-            auto pipelineCacheCreateInfo = VKUtils::InitVkPipelineCacheCreateInfo();
-            if (emptyCache)
-            {
-                KMP_LOG_WARN("cannot load pipeline cache from '{}' - file is empty", _binaryPath);
-                pipelineCacheCreateInfo.initialDataSize = 0;
-                pipelineCacheCreateInfo.pInitialData = nullptr;
-            }
-            else if (not _LoadedCacheIsValid(cacheBuffer))
+            const auto cacheData = _GetCacheData();
+            auto temporaryPath = _binaryPath;
+            temporaryPath += ".tmp";
+
+            if (not Filesystem::WriteFile(temporaryPath, cacheData, "append"_false))
             {
-                KMP_LOG_WARN("pipeline cache loaded from '{}' is not compatible", _binaryPath);
-                pipelineCacheCreateInfo.initialDataSize = 0;
-                pipelineCacheCreateInfo.pInitialData = nullptr;
+                KMP_LOG_WARN("cache serialization to '{}' failed", temporaryPath);
+                return false;
             }
-            else
+
+            if (not Filesystem::Rename(temporaryPath, _binaryPath, "overwrite"_true))
             {
-                pipelineCacheCreateInfo.initialDataSize = cacheBuffer.size();
-                pipelineCacheCreateInfo.pInitialData = cacheBuffer.data();
+                KMP_LOG_WARN("cache serialization to '{}' failed - cannot replace the file", _binaryPath);
+                return false;
             }
 
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        VkPipelineCache VulkanPipelineCache::GetVkPipelineCache() const noexcept
+        {
+            return _cache;
+        }
+        //--------------------------------------------------------------------------
+
+        const Filepath& VulkanPipelineCache::GetBinaryPath() const noexcept
+        {
+            return _binaryPath;
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanPipelineCache::_Initialize()
+        {
+            KMP_ASSERT(_device);
+
+            const auto cacheBuffer = _binaryPath.empty() ? BinaryBuffer() : _LoadCacheBuffer();
+
+            auto pipelineCacheCreateInfo = VKUtils::InitVkPipelineCacheCreateInfo();
+            pipelineCacheCreateInfo.initialDataSize = cacheBuffer.size();
+            pipelineCacheCreateInfo.pInitialData = cacheBuffer.empty() ? nullptr : cacheBuffer.data();
+
             const auto result = vkCreatePipelineCache(_device, &pipelineCacheCreateInfo, nullptr, &_cache);
             VKUtils::CheckResult(result, "VulkanGraphicsPipeline: failed to create pipeline cache", "throw exception"_false);
         }
@@ -85,23 +117,58 @@ namespace Kmplete
                 return;
             }
 
-            _SerializeCache();
+            if (not _readOnly && not _binaryPath.empty())
+            {
+                Save();
+            }
+
             _DestroyCache();
         }
         //--------------------------------------------------------------------------
 
-        void VulkanPipelineCache::_SerializeCache() KMP_PROFILING(ProfileLevelImportant)
+        BinaryBuffer VulkanPipelineCache::_LoadCacheBuffer() const KMP_PROFILING(ProfileLevelImportant)
         {
-            size_t cacheSize = 0ULL;
-            vkGetPipelineCacheData(_device, _cache, &cacheSize, nullptr);
+            if (not Filesystem::FilepathExists(_binaryPath))
+            {
+                KMP_LOG_WARN("cannot load pipeline cache from '{}' - file not found", _binaryPath);
+                return BinaryBuffer();
+            }
 
-            BinaryBuffer cacheData(cacheSize);
-            vkGetPipelineCacheData(_device, _cache, &cacheSize, cacheData.data());
+            auto cacheBuffer = Filesystem::ReadFileAsBinary(_binaryPath);
+            if (cacheBuffer.empty())
+            {
+                KMP_LOG_WARN("cannot load pipeline cache from '{}' - file is empty", _binaryPath);
+                return BinaryBuffer();
+            }
 
-            if (not Filesystem::WriteFile(_binaryPath, cacheData, "append"_false))
+            if (not _LoadedCacheIsValid(cacheBuffer))
             {
-                KMP_LOG_WARN("cache serialization to '{}' failed", _binaryPath);
+                KMP_LOG_WARN("pipeline cache loaded from '{}' is not compatible", _binaryPath);
+                return BinaryBuffer();
             }
+
+            return cacheBuffer;
+        }}
+        //--------------------------------------------------------------------------
+
+        BinaryBuffer VulkanPipelineCache::_GetCacheData() const KMP_PROFILING(ProfileLevelImportant)
+        {
+            // the cache may grow between the size query and the data query when pipelines
+            // are being created on other threads, so the query is repeated until everything fits
+            BinaryBuffer cacheData;
+            VkResult result = VK_INCOMPLETE;
+            while (result == VK_INCOMPLETE)
+            {
+                size_t cacheSize = 0ULL;
+                vkGetPipelineCacheData(_device, _cache, &cacheSize, nullptr);
+
+                cacheData.resize(cacheSize);
+                result = vkGetPipelineCacheData(_device, _cache, &cacheSize, cacheData.data());
+                cacheData.resize(cacheSize);
+            }
+
+            VKUtils::CheckResult(result, "VulkanPipelineCache: failed to get pipeline cache data", "throw exception"_false);
+            return cacheData;
         }}
         //--------------------------------------------------------------------------
 
@@ -113,11 +180,16 @@ namespace Kmplete
 
         bool VulkanPipelineCache::_LoadedCacheIsValid(const BinaryBuffer& cacheBuffer) const KMP_PROFILING(ProfileLevelImportant)
         {
+            if (cacheBuffer.size() < sizeof(PipelineCacheHeader))
+            {
+                return false;
+            }
+
             const PipelineCacheHeader* cacheHeader = reinterpret_cast<const PipelineCacheHeader*>(cacheBuffer.data());
             
-            return cacheHeader->headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
-                   cacheHeader->vendorID == _context.deviceProperties.vendorID ||
-                   cacheHeader->deviceID == _context.deviceProperties.deviceID ||
+            return cacheHeader->headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                   cacheHeader->vendorID == _context.deviceProperties.vendorID &&
+                   cacheHeader->deviceID == _context.deviceProperties.deviceID &&
                    memcmp(cacheHeader->pipelineCacheUUID, _context.deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
         }}
         //--------------------------------------------------------------------------
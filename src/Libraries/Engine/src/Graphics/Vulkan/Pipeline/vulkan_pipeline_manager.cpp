@@ -2,7 +2,10 @@
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_descriptor_set_manager.h"
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
 #include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
+#include "Kmplete/Utils/memory_utils.h"
 #include "Kmplete/Core/assertion.h"
+#include "Kmplete/Base/exception.h"
+#include "Kmplete/Base/named_bool.h"
 #include "Kmplete/Log/log.h"
 #include "Kmplete/Profile/profiler.h"
 
@@ -16,8 +19,16 @@ namespace Kmplete
               _device(device)
             , _context(context)
             , _descriptorSetManager(descriptorSetManager)
+            , _pipelineStates()
+            , _externalLayoutPipelines()
             , _pipelines()
-            , _pipelineCaches()
+            , _deviceCache(CreateUPtr<VulkanPipelineCache>(_device, _context, Filepath()))
+            , _mergedPipelineCaches()
+            , _compilePool(CreateUPtr<ThreadPool>())
+            , _compileMutex()
+            , _compiledPipelines()
+            , _pendingPipelines()
+            , _pendingStates()
         {
             KMP_ASSERT(_device);
             KMP_PROFILE_CONSTRUCTOR_END()
@@ -28,8 +39,16 @@ namespace Kmplete
         {
             KMP_ASSERT(_device);
 
-            _pipelineCaches.clear();
+            // remaining compilations and saves are finished before the pipelines and the cache are destroyed
+            _compilePool.reset();
+            _compiledPipelines.clear();
+            _pendingPipelines.clear();
+            _pendingStates.clear();
+
             _pipelines.clear();
+            _pipelineStates.clear();
+            _externalLayoutPipelines.clear();
+            _deviceCache.reset();
 
             for (const auto& [sid, layout] : _layouts)
             {
@@ -89,16 +108,74 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        bool VulkanPipelineManager::SetDevicePipelineCachePath(const Filepath& binaryPath) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_deviceCache);
+
+            if (binaryPath.empty())
+            {
+                KMP_LOG_ERROR("cannot set device pipeline cache path - path is empty");
+                return false;
+            }
+
+            _WaitCompilation();
+
+            auto deviceCache = CreateUPtr<VulkanPipelineCache>(_device, _context, binaryPath);
+            if (not deviceCache->GetVkPipelineCache() || not deviceCache->Merge({ _deviceCache->GetVkPipelineCache() }))
+            {
+                KMP_LOG_ERROR("cannot set device pipeline cache path to '{}'", binaryPath);
+                return false;
+            }
+
+            _deviceCache = std::move(deviceCache);
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool VulkanPipelineManager::SaveDevicePipelineCacheAsync()
+        {
+            KMP_ASSERT(_deviceCache && _compilePool);
+
+            if (_deviceCache->GetBinaryPath().empty())
+            {
+                return false;
+            }
+
+            _compilePool->Submit([this]() { _deviceCache->Save(); });
+            return true;
+        }
+        //--------------------------------------------------------------------------
+
+        VkPipelineCache VulkanPipelineManager::GetDevicePipelineCache() const noexcept
+        {
+            KMP_ASSERT(_deviceCache);
+
+            return _deviceCache->GetVkPipelineCache();
+        }
+        //--------------------------------------------------------------------------
+
         bool VulkanPipelineManager::AddPipelineCache(StringID pipelineSid, const Filepath& binaryPath) KMP_PROFILING(ProfileLevelImportant)
         {
-            if (_pipelineCaches.contains(pipelineSid))
+            KMP_ASSERT(_deviceCache);
+
+            if (_mergedPipelineCaches.contains(pipelineSid))
             {
                 KMP_LOG_WARN("pipeline cache with sid '{}' has already been added", pipelineSid);
                 return true;
             }
 
-            const auto [iterator, hasEmplaced] = _pipelineCaches.emplace(pipelineSid, CreateUPtr<VulkanPipelineCache>(_device, _context, binaryPath));
-            return hasEmplaced;
+            // merging requires exclusive access to the device cache
+            _WaitCompilation();
+
+            const VulkanPipelineCache pipelineCache(_device, _context, binaryPath, "read only"_true);
+            if (not pipelineCache.GetVkPipelineCache() || not _deviceCache->Merge({ pipelineCache.GetVkPipelineCache() }))
+            {
+                KMP_LOG_WARN("pipeline cache with sid '{}' cannot be merged into the device cache", pipelineSid);
+                return false;
+            }
+
+            _mergedPipelineCaches.insert(pipelineSid);
+            return true;
         }}
         //--------------------------------------------------------------------------
 
@@ -132,19 +209,40 @@ namespace Kmplete
                 return true;
             }
 
+            if (_pendingPipelines.contains(pipelineSid))
+            {
+                KMP_LOG_ERROR("cannot create pipeline with sid '{}' - pipeline is being compiled asynchronously", pipelineSid);
+                return false;
+            }
+
             if (layout == VK_NULL_HANDLE)
             {
                 KMP_LOG_ERROR("cannot create pipeline with sid '{}' - pipeline layout is null", pipelineSid);
                 return false;
             }
 
-            VkPipelineCache pipelineCache = VK_NULL_HANDLE;
-            if (_pipelineCaches.contains(pipelineSid))
+            // a caller-owned layout might be destroyed and its handle reused for another layout, so its pipelines are not shared
+            const auto layoutSid = _GetPipelineLayoutSid(layout);
+            if (not layoutSid.has_value())
+            {
+                const auto [pipelineIterator, hasEmplaced] = _externalLayoutPipelines.emplace(pipelineSid, CreateUPtr<VulkanGraphicsPipeline>(_device, pipelineSid, layout, GetDevicePipelineCache(), parameters));
+                _pipelines.emplace(pipelineSid, pipelineIterator->second.get());
+                return hasEmplaced;
+            }
+
+            // an identical pending state is not waited for, the asynchronous result is dropped when it arrives
+            const auto stateKey = _GetPipelineStateKey(layoutSid.value(), parameters);
+            auto stateIterator = _pipelineStates.find(stateKey);
+            if (stateIterator == _pipelineStates.end())
             {
-                pipelineCache = _pipelineCaches.at(pipelineSid)->GetVkPipelineCache();
+                stateIterator = _pipelineStates.emplace(stateKey, CreateUPtr<VulkanGraphicsPipeline>(_device, pipelineSid, layout, GetDevicePipelineCache(), parameters)).first;
+            }
+            else
+            {
+                KMP_LOG_DEBUG("pipeline with sid '{}' shares the state of an existing pipeline", pipelineSid);
             }
 
-            const auto [iterator, hasEmplaced] = _pipelines.emplace(pipelineSid, CreateUPtr<VulkanGraphicsPipeline>(_device, pipelineSid, layout, pipelineCache, parameters));
+            const auto [iterator, hasEmplaced] = _pipelines.emplace(pipelineSid, stateIterator->second.get());
             return hasEmplaced;
         }}
         //--------------------------------------------------------------------------
@@ -153,12 +251,196 @@ namespace Kmplete
         {
             if (_pipelines.contains(pipelineSid))
             {
-                return *_pipelines.at(pipelineSid).get();
+                return *_pipelines.at(pipelineSid);
+            }
+
+            // not an error, the pipeline is just not compiled yet
+            if (_pendingPipelines.contains(pipelineSid))
+            {
+                return std::nullopt;
             }
             
             KMP_LOG_ERROR("graphics pipeline with sid '{}' not found", pipelineSid);
             return std::nullopt;
         }
         //--------------------------------------------------------------------------
+
+        UInt32 VulkanPipelineManager::CompileGraphicsPipelinesAsync(const Vector<GraphicsPipelineCompileInfo>& compileInfos) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_device && _compilePool);
+
+            UInt32 acceptedCount = 0;
+            for (const auto& compileInfo : compileInfos)
+            {
+                const auto pipelineSid = compileInfo.pipelineSid;
+                if (_pipelines.contains(pipelineSid) || _pendingPipelines.contains(pipelineSid))
+                {
+                    KMP_LOG_WARN("pipeline with sid '{}' has already been created or is being compiled", pipelineSid);
+                    continue;
+                }
+
+                const auto layout = GetPipelineLayout(compileInfo.layoutSid);
+                if (layout == VK_NULL_HANDLE)
+                {
+                    KMP_LOG_ERROR("cannot compile pipeline with sid '{}' - pipeline layout is null", pipelineSid);
+                    continue;
+                }
+
+                auto stateKey = _GetPipelineStateKey(compileInfo.layoutSid, compileInfo.parameters);
+                const auto stateIterator = _pipelineStates.find(stateKey);
+                if (stateIterator != _pipelineStates.end())
+                {
+                    _pipelines.emplace(pipelineSid, stateIterator->second.get());
+                    acceptedCount++;
+                    continue;
+                }
+
+                _pendingPipelines.insert(pipelineSid);
+                acceptedCount++;
+
+                auto& stateSids = _pendingStates[stateKey];
+                stateSids.push_back(pipelineSid);
+                if (stateSids.size() > 1)
+                {
+                    continue;
+                }
+
+                // parameters are shared by pointer since their copy constructor is not public
+                const auto parameters = Ptr<VulkanGraphicsPipelineParameters>(new VulkanGraphicsPipelineParameters(
+                    VulkanGraphicsPipelineParameters::CopyFrom(compileInfo.parameters, VulkanGraphicsPipelineParameters::All)
+                ));
+
+                _compilePool->Submit([this, pipelineSid, stateKey, layout, parameters]() mutable { _CompileGraphicsPipeline(pipelineSid, std::move(stateKey), layout, *parameters); });
+            }
+
+            return acceptedCount;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanPipelineManager::ProcessCompiledPipelines() KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            if (_pendingPipelines.empty())
+            {
+                return 0;
+            }
+
+            Vector<CompiledPipeline> compiledPipelines;
+            {
+                std::lock_guard lock(_compileMutex);
+                compiledPipelines.swap(_compiledPipelines);
+            }
+
+            UInt32 swappedCount = 0;
+            for (auto& compiledPipeline : compiledPipelines)
+            {
+                const auto stateIterator = _pendingStates.find(compiledPipeline.stateKey);
+                KMP_ASSERT(stateIterator != _pendingStates.end());
+                const auto stateSids = std::move(stateIterator->second);
+                _pendingStates.erase(stateIterator);
+
+                // an identical pipeline might have been created synchronously meanwhile, then the compiled one is dropped
+                VulkanGraphicsPipeline* pipeline = nullptr;
+                if (compiledPipeline.pipeline)
+                {
+                    pipeline = _pipelineStates.emplace(std::move(compiledPipeline.stateKey), std::move(compiledPipeline.pipeline)).first->second.get();
+                }
+
+                for (const auto sid : stateSids)
+                {
+                    _pendingPipelines.erase(sid);
+                    if (pipeline)
+                    {
+                        _pipelines.emplace(sid, pipeline);
+                        swappedCount++;
+                    }
+                }
+            }
+
+            // the whole batch is done, the cache now holds everything it compiled
+            if (swappedCount > 0 && _pendingPipelines.empty())
+            {
+                SaveDevicePipelineCacheAsync();
+            }
+
+            return swappedCount;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanPipelineManager::WaitCompiledPipelines() KMP_PROFILING(ProfileLevelImportant)
+        {
+            _WaitCompilation();
+            return ProcessCompiledPipelines();
+        }}
+        //--------------------------------------------------------------------------
+
+        bool VulkanPipelineManager::IsGraphicsPipelineReady(StringID pipelineSid) const noexcept
+        {
+            return _pipelines.contains(pipelineSid);
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 VulkanPipelineManager::GetPendingPipelinesCount() const noexcept
+        {
+            return UInt32(_pendingPipelines.size());
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanPipelineManager::_CompileGraphicsPipeline(StringID pipelineSid, BinaryBuffer stateKey, VkPipelineLayout layout, const VulkanGraphicsPipelineParameters& parameters) KMP_PROFILING(ProfileLevelImportant)
+        {
+            auto compiledPipeline = CompiledPipeline{ .stateKey = std::move(stateKey), .pipeline = nullptr };
+            try
+            {
+                // pipeline cache objects are internally synchronized, so every worker compiles with the device cache
+                compiledPipeline.pipeline = CreateUPtr<VulkanGraphicsPipeline>(_device, pipelineSid, layout, GetDevicePipelineCache(), parameters);
+            }
+            catch (KMP_MB_UNUSED const Exception& e)
+            {
+                KMP_LOG_ERROR("asynchronous compilation of pipeline with sid '{}' failed: {}", pipelineSid, e.what());
+            }
+
+            std::lock_guard lock(_compileMutex);
+            _compiledPipelines.push_back(std::move(compiledPipeline));
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanPipelineManager::_WaitCompilation() KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            KMP_ASSERT(_compilePool);
+
+            _compilePool->WaitIdle();
+        }}
+        //--------------------------------------------------------------------------
+
+        Optional<StringID> VulkanPipelineManager::_GetPipelineLayoutSid(VkPipelineLayout layout) const noexcept
+        {
+            for (const auto& [sid, ownLayout] : _layouts)
+            {
+                if (ownLayout == layout)
+                {
+                    return sid;
+                }
+            }
+
+            return std::nullopt;
+        }
+        //--------------------------------------------------------------------------
+
+        BinaryBuffer VulkanPipelineManager::_GetPipelineStateKey(StringID layoutSid, const VulkanGraphicsPipelineParameters& parameters)
+        {
+            // identical parameters with different layouts are different pipelines, the manager's layouts are never
+            // removed or replaced, so a layout sid always refers to the same layout
+            auto stateKey = parameters.GetStateKey();
+            const auto layoutSidBytes = reinterpret_cast<const UByte*>(&layoutSid);
+            stateKey.insert(stateKey.end(), layoutSidBytes, layoutSidBytes + sizeof(layoutSid));
+
+            return stateKey;
+        }
+        //--------------------------------------------------------------------------
+
+        std::size_t VulkanPipelineManager::StateKeyHash::operator()(const BinaryBuffer& stateKey) const noexcept
+        {
+            return std::size_t(Utils::HashBytes(stateKey.data(), stateKey.size()));
+        }
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
@@ -98,10 +98,10 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
-        Vector<VkPipelineShaderStageCreateInfo> VulkanShaderManager::GetShaderStageCreateInfos(const Vector<ShaderStageInfoParameters>& shaderModulesParameters) const noexcept KMP_PROFILING(ProfileLevelImportant)
+        Vector<VulkanShaderStage> VulkanShaderManager::GetShaderStages(const Vector<ShaderStageInfoParameters>& shaderModulesParameters) const noexcept KMP_PROFILING(ProfileLevelImportant)
         {
-            Vector<VkPipelineShaderStageCreateInfo> stagesCreateInfos;
-            stagesCreateInfos.reserve(shaderModulesParameters.size());
+            Vector<VulkanShaderStage> shaderStages;
+            shaderStages.reserve(shaderModulesParameters.size());
 
             for (const auto& parameters : shaderModulesParameters)
             {
@@ -111,10 +111,10 @@ namespace Kmplete
                     continue;
                 }
 
-                stagesCreateInfos.push_back(shaderModule.value().get().GetShaderStageCreateInfo(parameters.shaderModuleStages, parameters.entryPointName));
+                shaderStages.push_back(shaderModule.value().get().GetShaderStage(parameters.shaderModuleStages, parameters.entryPointName));
             }
 
-            return stagesCreateInfos;
+            return shaderStages;
         }}
         //--------------------------------------------------------------------------
 
@@ -2,6 +2,7 @@
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
 #include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
 #include "Kmplete/Filesystem/filesystem.h"
+#include "Kmplete/Utils/memory_utils.h"
 #include "Kmplete/Base/exception.h"
 #include "Kmplete/Core/assertion.h"
 #include "Kmplete/Profile/profiler.h"
@@ -16,6 +17,7 @@ namespace Kmplete
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(device)
             , _shaderModule(VK_NULL_HANDLE)
+            , _codeHash(0)
         {
             KMP_ASSERT(_device);
 
@@ -29,6 +31,7 @@ namespace Kmplete
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(device)
             , _shaderModule(VK_NULL_HANDLE)
+            , _codeHash(0)
         {
             KMP_ASSERT(_device);
 
@@ -42,6 +45,7 @@ namespace Kmplete
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(other._device)
             , _shaderModule(other._shaderModule)
+            , _codeHash(other._codeHash)
         {
             other._device = VK_NULL_HANDLE;
             other._shaderModule = VK_NULL_HANDLE;
@@ -62,6 +66,7 @@ namespace Kmplete
 
             _device = other._device;
             _shaderModule = other._shaderModule;
+            _codeHash = other._codeHash;
 
             other._device = VK_NULL_HANDLE;
             other._shaderModule = VK_NULL_HANDLE;
@@ -90,6 +95,18 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
+        VulkanShaderStage VulkanShaderModule::GetShaderStage(VkShaderStageFlagBits stage, const char* entryPointName /*= "main"*/) const noexcept
+        {
+            return VulkanShaderStage{ .createInfo = GetShaderStageCreateInfo(stage, entryPointName), .codeHash = _codeHash };
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 VulkanShaderModule::GetCodeHash() const noexcept
+        {
+            return _codeHash;
+        }
+        //--------------------------------------------------------------------------
+
         void VulkanShaderModule::_Initialize(const Filepath& filepathBinary)
         {
             if (not Filesystem::FilepathExists(filepathBinary))
@@ -118,6 +135,8 @@ namespace Kmplete
             auto result = vkCreateShaderModule(_device, &shaderModuleCreateInfo, nullptr, &_shaderModule);
             VKUtils::CheckResult(result, "VulkanShaderModule: failed to create shader module");
             KMP_ASSERT(_shaderModule);
+
+            _codeHash = Utils::HashBytes(shaderBinary.data(), shaderBinary.size());
         }
         //--------------------------------------------------------------------------
 
@@ -136,6 +155,8 @@ namespace Kmplete
             auto result = vkCreateShaderModule(_device, &shaderModuleCreateInfo, nullptr, &_shaderModule);
             VKUtils::CheckResult(result, "VulkanShaderModule: failed to create shader module");
             KMP_ASSERT(_shaderModule);
+
+            _codeHash = Utils::HashBytes(shaderBinary.data(), shaderModuleCreateInfo.codeSize);
         }
         //--------------------------------------------------------------------------
 
@@ -1,5 +1,4 @@
 #include "Kmplete/Graphics/Vulkan/Texture/vulkan_image.h"
-#include "Kmplete/Graphics/Vulkan/Delegates/vulkan_memory_type_delegate.h"
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
 #include "Kmplete/Graphics/Vulkan/Utils/result_description.h"
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
@@ -15,16 +14,18 @@ namespace Kmplete
         using namespace VKBits;
 
 
-        VulkanImage::VulkanImage(VkDevice device, const VkImageCreateInfo& creationParameters, const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkMemoryPropertyFlags memoryProperties)
+        VulkanImage::VulkanImage(VkDevice device, const VkImageCreateInfo& creationParameters, VulkanMemoryAllocator& memoryAllocator, VkMemoryPropertyFlags memoryProperties,
+                                 VulkanMemoryStrategy memoryStrategy /*= VulkanMemoryStrategy::FreeList*/)
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(device)
             , _image(VK_NULL_HANDLE)
-            , _imageMemory(VK_NULL_HANDLE)
+            , _memoryAllocator(&memoryAllocator)
+            , _allocation()
             , _memorySize(0)
             , _format(creationParameters.format)
             , _samples(creationParameters.samples)
         {
-            _Initialize(creationParameters, memoryTypeDelegate, memoryProperties);
+            _Initialize(creationParameters, memoryProperties, memoryStrategy);
 
             KMP_PROFILE_CONSTRUCTOR_END()
         }
@@ -34,18 +35,20 @@ namespace Kmplete
             : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
               _device(other._device)
             , _image(other._image)
-            , _imageMemory(other._imageMemory)
+            , _memoryAllocator(other._memoryAllocator)
+            , _allocation(other._allocation)
             , _memorySize(other._memorySize)
             , _format(other._format)
             , _samples(other._samples)
         {
             other._device = VK_NULL_HANDLE;
             other._image = VK_NULL_HANDLE;
-            other._imageMemory = VK_NULL_HANDLE;
+            other._memoryAllocator = nullptr;
+            other._allocation = VulkanMemoryAllocation{};
             other._memorySize = 0ULL;
             other._format = VK_Format_Undefined;
 
-            KMP_ASSERT(_device && _image && _imageMemory);
+            KMP_ASSERT(_device && _image && _memoryAllocator && _allocation.IsValid());
             KMP_PROFILE_CONSTRUCTOR_END()
         }
         //--------------------------------------------------------------------------
@@ -61,17 +64,19 @@ namespace Kmplete
 
             _device = other._device;
             _image = other._image;
-            _imageMemory = other._imageMemory;
+            _memoryAllocator = other._memoryAllocator;
+            _allocation = other._allocation;
             _memorySize = other._memorySize;
             _format = other._format;
 
             other._device = VK_NULL_HANDLE;
             other._image = VK_NULL_HANDLE;
-            other._imageMemory = VK_NULL_HANDLE;
+            other._memoryAllocator = nullptr;
+            other._allocation = VulkanMemoryAllocation{};
             other._memorySize = 0ULL;
             other._format = VK_Format_Undefined;
 
-            KMP_ASSERT(_device && _image && _imageMemory);
+            KMP_ASSERT(_device && _image && _memoryAllocator && _allocation.IsValid());
 
             return *this;
         }}
@@ -109,33 +114,34 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
-        void VulkanImage::_Initialize(const VkImageCreateInfo& creationParameters, const VulkanMemoryTypeDelegate& memoryTypeDelegate, VkMemoryPropertyFlags memoryProperties)
+        void VulkanImage::_Initialize(const VkImageCreateInfo& creationParameters, VkMemoryPropertyFlags memoryProperties, VulkanMemoryStrategy memoryStrategy)
         {
-            KMP_ASSERT(_device);
+            KMP_ASSERT(_device && _memoryAllocator);
 
             auto result = vkCreateImage(_device, &creationParameters, nullptr, &_image);
             VKUtils::CheckResult(result, "VulkanImage: failed to create image");
 
-            const auto imageMemoryContext = memoryTypeDelegate.GetImageMemoryContext(_device, _image, memoryProperties);
-
-            result = vkAllocateMemory(_device, &imageMemoryContext.allocateInfo, nullptr, &_imageMemory);
-            if (result != VK_SUCCESS)
+            try
+            {
+                _allocation = _memoryAllocator->AllocateImageMemory(_image, memoryProperties, memoryStrategy);
+            }
+            catch (...)
             {
                 vkDestroyImage(_device, _image, nullptr);
-                VKUtils::CheckResult(result, "VulkanImage: failed to allocate image memory");
+                throw;
             }
 
-            result = vkBindImageMemory(_device, _image, _imageMemory, 0);
+            result = vkBindImageMemory(_device, _image, _allocation.memory, _allocation.offset);
             if (result != VK_SUCCESS)
             {
                 vkDestroyImage(_device, _image, nullptr);
-                vkFreeMemory(_device, _imageMemory, nullptr);
+                _memoryAllocator->Free(_allocation);
                 VKUtils::CheckResult(result, "VulkanImage: failed to bind image memory");
             }
 
-            _memorySize = imageMemoryContext.allocateInfo.allocationSize;
+            _memorySize = _allocation.size;
 
-            KMP_ASSERT(_image && _imageMemory && _memorySize != 0);
+            KMP_ASSERT(_image && _allocation.IsValid() && _memorySize != 0);
         }
         //--------------------------------------------------------------------------
 
@@ -145,9 +151,9 @@ namespace Kmplete
             {
                 vkDestroyImage(_device, _image, nullptr);
             }
-            if (_device && _imageMemory)
+            if (_memoryAllocator && _allocation.IsValid())
             {
-                vkFreeMemory(_device, _imageMemory, nullptr);
+                _memoryAllocator->Free(_allocation);
             }
         }
         //--------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
 #include "Kmplete/Graphics/Vulkan/Utils/presets.h"
 #include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Base/exception.h"
 #include "Kmplete/Core/assertion.h"
 #include "Kmplete/Log/log.h"
 #include "Kmplete/Profile/profiler.h"
@@ -18,22 +19,104 @@ namespace Kmplete
 
 
         VulkanTexture::VulkanTexture(VkImageType imageType, VkFormat format, UInt32 mipLevels, VkDevice device, VkCommandBuffer commandBuffer, 
-                                     const VulkanBuffer& stagingBuffer, const VkExtent3D& extent, const VulkanImageCreatorDelegate& imageCreatorDelegate)
+                                     VkBuffer stagingBuffer, VkDeviceSize stagingOffset, const VkExtent3D& extent, const VulkanImageCreatorDelegate& imageCreatorDelegate)
             : VulkanTextureBase(device, 
                 VKPresets::GetImageCI_OptimalTiling_QueueExclusive_Layer1_NoLayout(imageType, format, extent, mipLevels, VK_SampleCount_1, VK_ImageUsage_TransferSrcAndDst | VK_ImageUsage_Sampled),
                 VKPresets::GetImageViewCI_BaseMip0_BaseArray0_SingleLayer(VKUtils::ImageTypeToViewType(imageType), VK_ImageAspect_Color, mipLevels),
                 imageCreatorDelegate, 
                 VK_Memory_DeviceLocal)
               KMP_PROFILE_CONSTRUCTOR_START_DERIVED_CLASS()
+            , _uploadContext(nullptr)
+            , _uploadTicket()
         {
             _TransitionImageLayout(mipLevels, commandBuffer);
-            _CopyStagingBufferToImage(stagingBuffer, extent, commandBuffer);
+            _CopyStagingBufferToImage(stagingBuffer, stagingOffset, extent, commandBuffer);
             _GenerateMipmaps(extent, mipLevels, commandBuffer);
 
             KMP_PROFILE_CONSTRUCTOR_END()
         }
         //--------------------------------------------------------------------------
 
+        VulkanTexture::VulkanTexture(VkImageType imageType, VkFormat format, VkDevice device, VkCommandBuffer commandBuffer,
+                                     VkBuffer stagingBuffer, const Vector<VkBufferImageCopy>& mipRegions, const VulkanImageCreatorDelegate& imageCreatorDelegate)
+            : VulkanTextureBase(device, 
+                VKPresets::GetImageCI_OptimalTiling_QueueExclusive_Layer1_NoLayout(imageType, format, mipRegions.front().imageExtent, UInt32(mipRegions.size()), VK_SampleCount_1, VK_ImageUsage_TransferDst | VK_ImageUsage_Sampled),
+                VKPresets::GetImageViewCI_BaseMip0_BaseArray0_SingleLayer(VKUtils::ImageTypeToViewType(imageType), VK_ImageAspect_Color, UInt32(mipRegions.size())),
+                imageCreatorDelegate, 
+                VK_Memory_DeviceLocal)
+              KMP_PROFILE_CONSTRUCTOR_START_DERIVED_CLASS()
+            , _uploadContext(nullptr)
+            , _uploadTicket()
+        {
+            const auto mipLevels = UInt32(mipRegions.size());
+
+            _TransitionImageLayout(mipLevels, commandBuffer);
+            _CopyStagingBufferToImage(stagingBuffer, mipRegions, commandBuffer);
+            _TransitionToShaderReadLayout(mipLevels, commandBuffer);
+
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        VulkanTexture::~VulkanTexture() KMP_PROFILING(ProfileLevelMinor)
+        {
+            // the batch may not even be submitted yet, and its commands reference both the image and the staging memory
+            if (_uploadContext && not _uploadContext->IsComplete(_uploadTicket))
+            {
+                try
+                {
+                    _uploadContext->Wait(_uploadTicket);
+                }
+                catch (KMP_MB_UNUSED const RuntimeError& e)
+                {
+                    KMP_LOG_ERROR("failed to wait for the texture upload - {}", e.what());
+                }
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanTexture::SetUploadTicket(VulkanUploadContext& uploadContext, VulkanUploadTicket uploadTicket) noexcept
+        {
+            _uploadContext = &uploadContext;
+            _uploadTicket = uploadTicket;
+        }
+        //--------------------------------------------------------------------------
+
+        void VulkanTexture::UpdateRegion(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset, const VkOffset3D& offset, const VkExtent3D& extent) KMP_PROFILING(ProfileLevelMinor)
+        {
+            KMP_ASSERT(_image && commandBuffer && stagingBuffer);
+
+            VKUtils::MemoryBarrierParameters barrierParameters = {
+                .cmdbuffer = commandBuffer,
+                .image = _image->GetVkImage(),
+                .srcAccessMask = VK_Access_ShaderRead,
+                .dstAccessMask = VK_Access_TransferWrite,
+                .oldImageLayout = VK_ImageLayout_ShaderReadOnlyOptimal,
+                .newImageLayout = VK_ImageLayout_TransferDstOptimal,
+                .srcStageMask = VK_PipelineStage_FragmentShader,
+                .dstStageMask = VK_PipelineStage_Transfer,
+                .subresourceRange = VkImageSubresourceRange{ VK_ImageAspect_Color, 0, 1, 0, 1 }
+            };
+            VKUtils::InsertImageMemoryBarrier(barrierParameters);
+
+            VkBufferImageCopy region{};
+            region.bufferOffset = stagingOffset;
+            region.imageSubresource.aspectMask = VK_ImageAspect_Color;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = offset;
+            region.imageExtent = extent;
+            vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, _image->GetVkImage(), VK_ImageLayout_TransferDstOptimal, 1, &region);
+
+            barrierParameters.srcAccessMask = VK_Access_TransferWrite;
+            barrierParameters.dstAccessMask = VK_Access_ShaderRead;
+            barrierParameters.oldImageLayout = VK_ImageLayout_TransferDstOptimal;
+            barrierParameters.newImageLayout = VK_ImageLayout_ShaderReadOnlyOptimal;
+            barrierParameters.srcStageMask = VK_PipelineStage_Transfer;
+            barrierParameters.dstStageMask = VK_PipelineStage_FragmentShader;
+            VKUtils::InsertImageMemoryBarrier(barrierParameters);
+        }}
+        //--------------------------------------------------------------------------
+
         void VulkanTexture::_TransitionImageLayout(UInt32 mipLevels, VkCommandBuffer commandBuffer) KMP_PROFILING(ProfileLevelImportant)
         {
             KMP_ASSERT(_image && commandBuffer);
@@ -53,15 +136,43 @@ namespace Kmplete
         }}
         //--------------------------------------------------------------------------
 
-        void VulkanTexture::_CopyStagingBufferToImage(const VulkanBuffer& stagingBuffer, const VkExtent3D& extent, VkCommandBuffer commandBuffer) KMP_PROFILING(ProfileLevelImportant)
+        void VulkanTexture::_CopyStagingBufferToImage(VkBuffer stagingBuffer, VkDeviceSize stagingOffset, const VkExtent3D& extent, VkCommandBuffer commandBuffer) KMP_PROFILING(ProfileLevelImportant)
         {
-            KMP_ASSERT(_image && commandBuffer);
+            KMP_ASSERT(_image && commandBuffer && stagingBuffer);
 
             VkBufferImageCopy region{};
+            region.bufferOffset = stagingOffset;
             region.imageSubresource.aspectMask = VK_ImageAspect_Color;
             region.imageSubresource.layerCount = 1;
             region.imageExtent = extent;
-            vkCmdCopyBufferToImage(commandBuffer, stagingBuffer.GetVkBuffer(), _image->GetVkImage(), VK_ImageLayout_TransferDstOptimal, 1, &region);
+            vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, _image->GetVkImage(), VK_ImageLayout_TransferDstOptimal, 1, &region);
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanTexture::_CopyStagingBufferToImage(VkBuffer stagingBuffer, const Vector<VkBufferImageCopy>& mipRegions, VkCommandBuffer commandBuffer) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_image && commandBuffer && stagingBuffer && not mipRegions.empty());
+
+            vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, _image->GetVkImage(), VK_ImageLayout_TransferDstOptimal, UInt32(mipRegions.size()), mipRegions.data());
+        }}
+        //--------------------------------------------------------------------------
+
+        void VulkanTexture::_TransitionToShaderReadLayout(UInt32 mipLevels, VkCommandBuffer commandBuffer) KMP_PROFILING(ProfileLevelImportant)
+        {
+            KMP_ASSERT(_image && commandBuffer);
+
+            const VKUtils::MemoryBarrierParameters barrierParameters = {
+                .cmdbuffer = commandBuffer,
+                .image = _image->GetVkImage(),
+                .srcAccessMask = VK_Access_TransferWrite,
+                .dstAccessMask = VK_Access_ShaderRead,
+                .oldImageLayout = VK_ImageLayout_TransferDstOptimal,
+                .newImageLayout = VK_ImageLayout_ShaderReadOnlyOptimal,
+                .srcStageMask = VK_PipelineStage_Transfer,
+                .dstStageMask = VK_PipelineStage_FragmentShader,
+                .subresourceRange = VkImageSubresourceRange{ VK_ImageAspect_Color, 0, mipLevels, 0, 1 }
+            };
+            VKUtils::InsertImageMemoryBarrier(barrierParameters);
         }}
         //--------------------------------------------------------------------------
 
@@ -70,6 +70,14 @@ namespace Kmplete
             }
             //--------------------------------------------------------------------------
 
+            VkPhysicalDeviceVulkan12Features InitVkPhysicalDeviceVulkan12Features()
+            {
+                return VkPhysicalDeviceVulkan12Features{
+                    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES
+                };
+            }
+            //--------------------------------------------------------------------------
+
             VkPhysicalDeviceVulkan13Features InitVkPhysicalDeviceVulkan13Features()
             {
                 return VkPhysicalDeviceVulkan13Features{
@@ -175,6 +183,32 @@ namespace Kmplete
             }
             //--------------------------------------------------------------------------
 
+            VkSemaphoreTypeCreateInfo InitVkSemaphoreTypeCreateInfo(VkSemaphoreType type, UInt64 initialValue)
+            {
+                return VkSemaphoreTypeCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+                    .semaphoreType = type,
+                    .initialValue = initialValue
+                };
+            }
+            //--------------------------------------------------------------------------
+
+            VkSemaphoreWaitInfo InitVkSemaphoreWaitInfo()
+            {
+                return VkSemaphoreWaitInfo{
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO
+                };
+            }
+            //--------------------------------------------------------------------------
+
+            VkTimelineSemaphoreSubmitInfo InitVkTimelineSemaphoreSubmitInfo()
+            {
+                return VkTimelineSemaphoreSubmitInfo{
+                    .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO
+                };
+            }
+            //--------------------------------------------------------------------------
+
             VkCommandBufferAllocateInfo InitVkCommandBufferAllocateInfo(bool primary /*= true*/)
             {
                 return VkCommandBufferAllocateInfo{
@@ -192,6 +226,22 @@ namespace Kmplete
             }
             //--------------------------------------------------------------------------
 
+            VkCommandBufferInheritanceInfo InitVkCommandBufferInheritanceInfo()
+            {
+                return VkCommandBufferInheritanceInfo{
+                    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO
+                };
+            }
+            //--------------------------------------------------------------------------
+
+            VkCommandBufferInheritanceRenderingInfo InitVkCommandBufferInheritanceRenderingInfo()
+            {
+                return VkCommandBufferInheritanceRenderingInfo{
+                    .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO
+                };
+            }
+            //--------------------------------------------------------------------------
+
             VkFenceCreateInfo InitVkFenceCreateInfo(bool signaled /*= true*/)
             {
                 VkFenceCreateInfo fenceCreateInfo{};
@@ -277,6 +327,14 @@ namespace Kmplete
             }
             //--------------------------------------------------------------------------
 
+            VkDescriptorSetLayoutBindingFlagsCreateInfo InitVkDescriptorSetLayoutBindingFlagsCreateInfo()
+            {
+                return VkDescriptorSetLayoutBindingFlagsCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO
+                };
+            }
+            //--------------------------------------------------------------------------
+
             VkDescriptorSetAllocateInfo InitVkDescriptorSetAllocateInfo()
             {
                 return VkDescriptorSetAllocateInfo{
@@ -293,6 +351,14 @@ namespace Kmplete
             }
             //--------------------------------------------------------------------------
 
+            VkDescriptorUpdateTemplateCreateInfo InitVkDescriptorUpdateTemplateCreateInfo()
+            {
+                return VkDescriptorUpdateTemplateCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO
+                };
+            }
+            //--------------------------------------------------------------------------
+
 
             VkPipelineLayoutCreateInfo InitVkPipelineLayoutCreateInfo()
             {
@@ -99,6 +99,32 @@ namespace Kmplete
         }
         //--------------------------------------------------------------------------
 
+        Int32 Font::GetKerning(UInt32 leftCodepoint, UInt32 rightCodepoint) const
+        {
+            KMP_ASSERT(_freetypeFace);
+
+            if (not FT_HAS_KERNING(_freetypeFace))
+            {
+                return 0;
+            }
+
+            const auto leftIndex = FT_Get_Char_Index(_freetypeFace, leftCodepoint);
+            const auto rightIndex = FT_Get_Char_Index(_freetypeFace, rightCodepoint);
+            if (leftIndex == 0 || rightIndex == 0)
+            {
+                return 0;
+            }
+
+            FT_Vector kerning{};
+            if (FT_Get_Kerning(_freetypeFace, leftIndex, rightIndex, FT_KERNING_DEFAULT, &kerning) != FT_Err_Ok)
+            {
+                return 0;
+            }
+
+            return Int32(kerning.x);
+        }
+        //--------------------------------------------------------------------------
+
         void Font::_UpdateParameters() noexcept
         {
             KMP_ASSERT(_freetypeFace);
@@ -0,0 +1,450 @@
+#include "Kmplete/Graphics/glyph_atlas.h"
+#include "Kmplete/Graphics/font.h"
+#include "Kmplete/Graphics/image.h"
+#include "Kmplete/Graphics/texture.h"
+#include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Assets/assets_interface.h"
+#include "Kmplete/Math/math.h"
+#include "Kmplete/Core/assertion.h"
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <cstring>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        GlyphAtlas::GlyphAtlas(Font& font, const Parameters& parameters)
+            : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+              _font(font)
+            , _parameters(parameters)
+            , _glyphs()
+            , _pages()
+            , _sizeLookups(256)
+            , _regionBuffer()
+        {
+            if (not Math::IsPowerOf2(_parameters.pageSize) || _parameters.pageSize == 0)
+            {
+                KMP_LOG_WARN("page size (given {}) will be converted to nearest power of two", _parameters.pageSize);
+                _parameters.pageSize = std::max(Math::NearestPowerOf2(_parameters.pageSize), 64U);
+            }
+
+            if (_parameters.maxPages == 0)
+            {
+                KMP_LOG_WARN("maximum pages count should not be zero, using one page");
+                _parameters.maxPages = 1;
+            }
+
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        GlyphAtlas::~GlyphAtlas() = default;
+        //--------------------------------------------------------------------------
+
+        Nullable<const GlyphAtlas::Glyph*> GlyphAtlas::GetGlyph(UInt32 codepoint, UInt8 pixelSize)
+        {
+            auto& slot = _GetLookupSlot(codepoint, pixelSize);
+            if (slot == FailedGlyphSlot)
+            {
+                return nullptr;
+            }
+
+            if (slot != 0)
+            {
+                return &_glyphs[slot - 1];
+            }
+
+            Glyph glyph;
+            if (not _RasterizeGlyph(codepoint, pixelSize, glyph))
+            {
+                slot = FailedGlyphSlot;
+                return nullptr;
+            }
+
+            _glyphs.push_back(glyph);
+            slot = UInt32(_glyphs.size());
+
+            return &_glyphs.back();
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 GlyphAtlas::AddGlyphs(Span<const UInt32> codepoints, UInt8 pixelSize) KMP_PROFILING(ProfileLevelMinor)
+        {
+            UInt64 availableCount = 0;
+            for (const auto codepoint : codepoints)
+            {
+                if (GetGlyph(codepoint, pixelSize))
+                {
+                    availableCount++;
+                }
+            }
+
+            return availableCount;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::LoadBaked(BinaryView payload) KMP_PROFILING(ProfileLevelImportant)
+        {
+            if (not _glyphs.empty() || not _pages.empty())
+            {
+                KMP_LOG_ERROR("baked glyphs may only be loaded into an empty atlas");
+                return false;
+            }
+
+            auto header = Assets::FontAtlasPayloadHeader();
+            if (not Assets::ReadFontAtlasPayloadHeader(payload, header))
+            {
+                KMP_LOG_ERROR("malformed font atlas payload of {} bytes", payload.size());
+                return false;
+            }
+
+            const auto pageSize = header.pageSize;
+            Vector<Assets::FontAtlasGlyphEntry> entries(header.glyphsCount);
+            std::memcpy(entries.data(), payload.data() + Assets::FontAtlasPayloadHeaderStructSize, entries.size() * Assets::FontAtlasGlyphEntryStructSize);
+
+            for (const auto& entry : entries)
+            {
+                if (entry.page >= header.pagesCount || UInt32(entry.x) + entry.width > pageSize || UInt32(entry.y) + entry.height > pageSize)
+                {
+                    KMP_LOG_ERROR("glyph of codepoint {:#x} is out of the font atlas pages", UInt32(entry.codepoint));
+                    return false;
+                }
+            }
+
+            _parameters.pageSize = pageSize;
+            _parameters.maxPages = std::max(_parameters.maxPages, header.pagesCount);
+            _parameters.sdf = true;
+
+            // pages have no textures yet, so the next Upload copies them to the GPU as a whole
+            const auto pagePixelsSize = Assets::GetFontAtlasPayloadPageSize(pageSize);
+            _pages.resize(header.pagesCount);
+            for (UInt32 pageIndex = 0; pageIndex < header.pagesCount; pageIndex++)
+            {
+                auto& page = _pages[pageIndex];
+                const auto pageOffset = Assets::GetFontAtlasPayloadPageOffset(pageSize, header.glyphsCount, pageIndex);
+                page.pixels.assign(payload.begin() + pageOffset, payload.begin() + pageOffset + pagePixelsSize);
+                page.shelves.push_back(Shelf{ 0, pageSize, pageSize });
+            }
+
+            const auto pageSizeF = float(pageSize);
+            _glyphs.reserve(entries.size());
+            for (const auto& entry : entries)
+            {
+                Glyph glyph;
+                glyph.character.size = Math::Vec2I(Int32(entry.width), Int32(entry.height));
+                glyph.character.bearing = Math::Vec2I(Int32(entry.bearingX), Int32(entry.bearingY));
+                glyph.character.advance = entry.advance;
+                glyph.character.uvMin = Math::Vec2F(float(entry.x) / pageSizeF, float(entry.y) / pageSizeF);
+                glyph.character.uvMax = Math::Vec2F(float(entry.x + entry.width) / pageSizeF, float(entry.y + entry.height) / pageSizeF);
+                glyph.page = entry.page;
+
+                _glyphs.push_back(glyph);
+                _GetLookupSlot(entry.codepoint, header.pixelSize) = UInt32(_glyphs.size());
+            }
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        Int32 GlyphAtlas::GetKerning(UInt32 leftCodepoint, UInt32 rightCodepoint, UInt8 pixelSize)
+        {
+            if (not _SetPixelSize(pixelSize))
+            {
+                return 0;
+            }
+
+            return _font.GetKerning(leftCodepoint, rightCodepoint);
+        }
+        //--------------------------------------------------------------------------
+
+        Int32 GlyphAtlas::GetLineHeight(UInt8 pixelSize)
+        {
+            if (not _SetPixelSize(pixelSize))
+            {
+                return Int32(pixelSize);
+            }
+
+            return _font.GetParameters().sizeMetrics.height;
+        }
+        //--------------------------------------------------------------------------
+
+        const Font& GlyphAtlas::GetFont() const noexcept
+        {
+            return _font;
+        }
+        //--------------------------------------------------------------------------
+
+        const GlyphAtlas::Parameters& GlyphAtlas::GetParameters() const noexcept
+        {
+            return _parameters;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 GlyphAtlas::GetGlyphsCount() const noexcept
+        {
+            return UInt64(_glyphs.size());
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 GlyphAtlas::GetPagesCount() const noexcept
+        {
+            return UInt32(_pages.size());
+        }
+        //--------------------------------------------------------------------------
+
+        BinaryView GlyphAtlas::GetPagePixels(UInt32 page) const
+        {
+            KMP_ASSERT(page < _pages.size());
+
+            return BinaryView(_pages[page].pixels);
+        }
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::IsPageDirty(UInt32 page) const
+        {
+            KMP_ASSERT(page < _pages.size());
+
+            return _pages[page].dirtyRegion.width != 0 || not _pages[page].texture;
+        }
+        //--------------------------------------------------------------------------
+
+        const TextureRegion& GlyphAtlas::GetPageDirtyRegion(UInt32 page) const
+        {
+            KMP_ASSERT(page < _pages.size());
+
+            return _pages[page].dirtyRegion;
+        }
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::Upload(GraphicsBackend& graphicsBackend) KMP_PROFILING(ProfileLevelMinor)
+        {
+            auto uploaded = true;
+            for (auto& page : _pages)
+            {
+                if (page.texture)
+                {
+                    uploaded = _UploadDirtyRegion(page, graphicsBackend) && uploaded;
+                    continue;
+                }
+
+                // a new page goes to the GPU as a whole, so its dirty region is not needed anymore
+                const auto pageSize = Int32(_parameters.pageSize);
+                const Image image(page.pixels.data(), int(page.pixels.size()), Math::Size2I(pageSize, pageSize), ImageChannels::Grey);
+                page.texture.reset(graphicsBackend.CreateTexture(image, Assets::TextureSubTypeMaskBits::NoMipmap));
+                if (not page.texture)
+                {
+                    KMP_LOG_ERROR("failed to create a texture of {}x{} page", pageSize, pageSize);
+                    uploaded = false;
+                    continue;
+                }
+
+                page.dirtyRegion = TextureRegion{};
+            }
+
+            return uploaded;
+        }}
+        //--------------------------------------------------------------------------
+
+        Nullable<Texture*> GlyphAtlas::GetPageTexture(UInt32 page) const
+        {
+            KMP_ASSERT(page < _pages.size());
+
+            return _pages[page].texture.get();
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32& GlyphAtlas::_GetLookupSlot(UInt32 codepoint, UInt8 pixelSize)
+        {
+            auto& sizeLookup = _sizeLookups[pixelSize];
+            if (codepoint < FlatLookupSize)
+            {
+                if (sizeLookup.flat.empty())
+                {
+                    sizeLookup.flat.resize(FlatLookupSize, 0);
+                }
+
+                return sizeLookup.flat[codepoint];
+            }
+
+            return sizeLookup.extended[codepoint];
+        }
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::_SetPixelSize(UInt8 pixelSize)
+        {
+            // the font may be shared, so its current size is checked rather than remembered
+            return _font.GetParameters().sizeMetrics.yPixelsPerEM == pixelSize || _font.SetPixelSize(pixelSize);
+        }
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::_RasterizeGlyph(UInt32 codepoint, UInt8 pixelSize, Glyph& glyph) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            if (not _SetPixelSize(pixelSize))
+            {
+                return false;
+            }
+
+            // loading without FT_LOAD_RENDER, so the glyph is rasterized only once and with the requested mode
+            auto freetypeFace = _font.GetFtFace();
+            const auto renderMode = _parameters.sdf ? FT_RENDER_MODE_SDF : FT_RENDER_MODE_NORMAL;
+            if (FT_Load_Char(freetypeFace, codepoint, FT_LOAD_DEFAULT) != FT_Err_Ok || FT_Render_Glyph(freetypeFace->glyph, renderMode) != FT_Err_Ok)
+            {
+                KMP_LOG_WARN("failed to rasterize codepoint {:#x} of size {}", codepoint, pixelSize);
+                return false;
+            }
+
+            const auto& glyphSlot = *freetypeFace->glyph;
+            const auto& bitmap = glyphSlot.bitmap;
+
+            glyph.character.size = Math::Vec2I(Int32(bitmap.width), Int32(bitmap.rows));
+            glyph.character.bearing = Math::Vec2I(glyphSlot.bitmap_left, glyphSlot.bitmap_top);
+            glyph.character.advance = UInt32(glyphSlot.advance.x);
+
+            // whitespaces have metrics only and take no room in the atlas
+            if (bitmap.width == 0 || bitmap.rows == 0)
+            {
+                return true;
+            }
+
+            UInt32 page = 0;
+            UInt32 x = 0;
+            UInt32 y = 0;
+            if (not _PackRectangle(bitmap.width + _parameters.padding, bitmap.rows + _parameters.padding, page, x, y))
+            {
+                KMP_LOG_WARN("no room left for codepoint {:#x} of size {} ({}x{})", codepoint, pixelSize, bitmap.width, bitmap.rows);
+                return false;
+            }
+
+            auto& atlasPage = _pages[page];
+            const auto pageSize = _parameters.pageSize;
+            for (UInt32 row = 0; row < bitmap.rows; row++)
+            {
+                std::memcpy(atlasPage.pixels.data() + UInt64(y + row) * pageSize + x, bitmap.buffer + Int64(row) * bitmap.pitch, bitmap.width);
+            }
+
+            auto& dirtyRegion = atlasPage.dirtyRegion;
+            if (dirtyRegion.width == 0)
+            {
+                dirtyRegion = TextureRegion{ x, y, bitmap.width, bitmap.rows };
+            }
+            else
+            {
+                const auto right = std::max(dirtyRegion.x + dirtyRegion.width, x + bitmap.width);
+                const auto bottom = std::max(dirtyRegion.y + dirtyRegion.height, y + bitmap.rows);
+                dirtyRegion.x = std::min(dirtyRegion.x, x);
+                dirtyRegion.y = std::min(dirtyRegion.y, y);
+                dirtyRegion.width = right - dirtyRegion.x;
+                dirtyRegion.height = bottom - dirtyRegion.y;
+            }
+
+            const auto pageSizeF = float(pageSize);
+            glyph.character.uvMin = Math::Vec2F(float(x) / pageSizeF, float(y) / pageSizeF);
+            glyph.character.uvMax = Math::Vec2F(float(x + bitmap.width) / pageSizeF, float(y + bitmap.rows) / pageSizeF);
+            glyph.page = page;
+
+            return true;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::_PackRectangle(UInt32 width, UInt32 height, UInt32& page, UInt32& x, UInt32& y)
+        {
+            if (width > _parameters.pageSize || height > _parameters.pageSize)
+            {
+                return false;
+            }
+
+            for (page = 0; page < UInt32(_pages.size()); page++)
+            {
+                if (_PackRectangleIntoPage(_pages[page], width, height, x, y))
+                {
+                    return true;
+                }
+            }
+
+            if (_pages.size() >= _parameters.maxPages)
+            {
+                return false;
+            }
+
+            _AddPage();
+            page = UInt32(_pages.size() - 1);
+
+            return _PackRectangleIntoPage(_pages.back(), width, height, x, y);
+        }
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::_PackRectangleIntoPage(Page& page, UInt32 width, UInt32 height, UInt32& x, UInt32& y) const
+        {
+            const auto pageSize = _parameters.pageSize;
+
+            // the shelf wasting the least height wins, a new shelf is opened only if none of them fits
+            Nullable<Shelf*> bestShelf = nullptr;
+            for (auto& shelf : page.shelves)
+            {
+                if (shelf.height >= height && pageSize - shelf.width >= width && (not bestShelf || shelf.height < bestShelf->height))
+                {
+                    bestShelf = &shelf;
+                }
+            }
+
+            if (not bestShelf)
+            {
+                const auto shelfY = page.shelves.empty() ? 0 : page.shelves.back().y + page.shelves.back().height;
+                const auto shelfHeight = std::min(Math::AlignUp(height, ShelfHeightGranularity), pageSize - std::min(shelfY, pageSize));
+                if (shelfHeight < height)
+                {
+                    return false;
+                }
+
+                page.shelves.push_back(Shelf{ shelfY, shelfHeight, 0 });
+                bestShelf = &page.shelves.back();
+            }
+
+            x = bestShelf->width;
+            y = bestShelf->y;
+            bestShelf->width += width;
+
+            return true;
+        }
+        //--------------------------------------------------------------------------
+
+        void GlyphAtlas::_AddPage() KMP_PROFILING(ProfileLevelMinor)
+        {
+            auto& page = _pages.emplace_back();
+            page.pixels.resize(UInt64(_parameters.pageSize) * _parameters.pageSize, 0);
+        }}
+        //--------------------------------------------------------------------------
+
+        bool GlyphAtlas::_UploadDirtyRegion(Page& page, GraphicsBackend& graphicsBackend)
+        {
+            const auto& dirtyRegion = page.dirtyRegion;
+            if (dirtyRegion.width == 0)
+            {
+                return true;
+            }
+
+            _regionBuffer.resize(UInt64(dirtyRegion.width) * dirtyRegion.height);
+            for (UInt32 row = 0; row < dirtyRegion.height; row++)
+            {
+                const auto pageOffset = UInt64(dirtyRegion.y + row) * _parameters.pageSize + dirtyRegion.x;
+                std::memcpy(_regionBuffer.data() + UInt64(row) * dirtyRegion.width, page.pixels.data() + pageOffset, dirtyRegion.width);
+            }
+
+            if (not graphicsBackend.UpdateTexture(*page.texture, BinaryView(_regionBuffer), dirtyRegion))
+            {
+                KMP_LOG_ERROR("failed to upload {}x{} dirty region of a page", dirtyRegion.width, dirtyRegion.height);
+                return false;
+            }
+
+            page.dirtyRegion = TextureRegion{};
+            return true;
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
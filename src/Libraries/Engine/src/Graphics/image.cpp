@@ -29,7 +29,7 @@ namespace Kmplete
             , _pixels(nullptr)
             , _dataSize(0)
         {
-            stbi_set_flip_vertically_on_load(flipVertically);
+            stbi_set_flip_vertically_on_load_thread(flipVertically);
 
             auto channelsInFile = 0;
             _pixels = stbi_load(Filesystem::ToGenericString(filepath).c_str(), &_width, &_height, &channelsInFile, desiredChannels);
@@ -113,7 +113,7 @@ namespace Kmplete
                 throw RuntimeError("Image: file buffer size should not be negative");
             }
 
-            stbi_set_flip_vertically_on_load(flipVertically);
+            stbi_set_flip_vertically_on_load_thread(flipVertically);
 
             auto channelsInFile = 0;
             _pixels = stbi_load_from_memory(fileBuffer, bufferSize, &_width, &_height, &channelsInFile, desiredChannels);
@@ -0,0 +1,283 @@
+#include "Kmplete/Graphics/text_renderer.h"
+#include "Kmplete/Graphics/glyph_atlas.h"
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <algorithm>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        static constexpr UInt32 ReplacementCodepoint = 0xFFFD;
+
+
+        //! Decodes a codepoint starting at "offset" and moves the offset past it,
+        //! malformed sequences are decoded as U+FFFD one byte at a time
+        static UInt32 DecodeUtf8(const String& text, UInt64& offset)
+        {
+            const auto lead = UInt8(text[offset++]);
+            if (lead < 0x80)
+            {
+                return lead;
+            }
+
+            UInt32 codepoint = 0;
+            UInt32 continuationCount = 0;
+            UInt32 minCodepoint = 0;
+            if ((lead & 0xE0) == 0xC0)
+            {
+                codepoint = lead & 0x1F;
+                continuationCount = 1;
+                minCodepoint = 0x80;
+            }
+            else if ((lead & 0xF0) == 0xE0)
+            {
+                codepoint = lead & 0x0F;
+                continuationCount = 2;
+                minCodepoint = 0x800;
+            }
+            else if ((lead & 0xF8) == 0xF0)
+            {
+                codepoint = lead & 0x07;
+                continuationCount = 3;
+                minCodepoint = 0x10000;
+            }
+            else
+            {
+                return ReplacementCodepoint;
+            }
+
+            if (offset + continuationCount > text.size())
+            {
+                return ReplacementCodepoint;
+            }
+
+            for (UInt32 i = 0; i < continuationCount; i++)
+            {
+                const auto continuation = UInt8(text[offset + i]);
+                if ((continuation & 0xC0) != 0x80)
+                {
+                    return ReplacementCodepoint;
+                }
+
+                codepoint = (codepoint << 6) | (continuation & 0x3F);
+            }
+
+            if (codepoint < minCodepoint || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            {
+                return ReplacementCodepoint;
+            }
+
+            offset += continuationCount;
+            return codepoint;
+        }
+        //--------------------------------------------------------------------------
+
+        static StringID LayoutKey(const String& text, UInt8 pixelSize)
+        {
+            return ToStringID(KMP_SID_PARAM(text)) * 31 + pixelSize;
+        }
+        //--------------------------------------------------------------------------
+
+
+        TextRenderer::TextRenderer(GlyphAtlas& glyphAtlas)
+            : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+              _glyphAtlas(glyphAtlas)
+            , _viewportSize(1.0f, 1.0f)
+            , _frameIndex(0)
+            , _verticesCount(0)
+            , _layouts()
+            , _pageVertices()
+            , _batches()
+        {
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        void TextRenderer::BeginFrame(const Math::Size2I& viewportSize)
+        {
+            _viewportSize = Math::Vec2F(float(std::max(viewportSize.x, 1)), float(std::max(viewportSize.y, 1)));
+            _frameIndex++;
+            _verticesCount = 0;
+            _batches.clear();
+
+            // vectors are cleared rather than released, so their memory is reused by the next frames
+            for (auto& vertices : _pageVertices)
+            {
+                vertices.clear();
+            }
+
+            if (_frameIndex % DefaultLayoutLifetimeFrames == 0)
+            {
+                _EvictUnusedLayouts();
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        void TextRenderer::AddText(const String& text, const Math::Vec2F& position, UInt8 pixelSize, float scale /*= 1.0f*/) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            if (text.empty())
+            {
+                return;
+            }
+
+            const auto& layout = _GetLayout(text, pixelSize);
+            const auto toNDC = [this](float x, float y) {
+                return Math::Vec2F(x / _viewportSize.x * 2.0f - 1.0f, y / _viewportSize.y * 2.0f - 1.0f);
+            };
+
+            for (const auto& quad : layout.quads)
+            {
+                if (quad.page >= _pageVertices.size())
+                {
+                    _pageVertices.resize(quad.page + 1);
+                }
+
+                const auto topLeft = toNDC(position.x + quad.min.x * scale, position.y + quad.min.y * scale);
+                const auto bottomRight = toNDC(position.x + quad.max.x * scale, position.y + quad.max.y * scale);
+                const auto bottomLeft = Math::Vec2F(topLeft.x, bottomRight.y);
+                const auto topRight = Math::Vec2F(bottomRight.x, topLeft.y);
+
+                auto& vertices = _pageVertices[quad.page];
+                vertices.push_back({ topLeft, quad.uvMin });
+                vertices.push_back({ bottomLeft, Math::Vec2F(quad.uvMin.x, quad.uvMax.y) });
+                vertices.push_back({ bottomRight, quad.uvMax });
+
+                vertices.push_back({ topLeft, quad.uvMin });
+                vertices.push_back({ bottomRight, quad.uvMax });
+                vertices.push_back({ topRight, Math::Vec2F(quad.uvMax.x, quad.uvMin.y) });
+            }
+
+            _verticesCount += layout.quads.size() * VerticesPerGlyph;
+        }}
+        //--------------------------------------------------------------------------
+
+        UInt64 TextRenderer::GetVerticesCount() const noexcept
+        {
+            return _verticesCount;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 TextRenderer::WriteVertices(Span<FontCharacterVertex> vertices) KMP_PROFILING(ProfileLevelMinor)
+        {
+            _batches.clear();
+
+            if (vertices.size() < _verticesCount)
+            {
+                KMP_LOG_ERROR("destination of {} vertices can not hold {} vertices of the frame", vertices.size(), _verticesCount);
+                return 0;
+            }
+
+            UInt64 written = 0;
+            for (UInt32 page = 0; page < UInt32(_pageVertices.size()); page++)
+            {
+                const auto& pageVertices = _pageVertices[page];
+                if (pageVertices.empty())
+                {
+                    continue;
+                }
+
+                std::copy(pageVertices.begin(), pageVertices.end(), vertices.begin() + written);
+                _batches.push_back(TextDrawBatch{ page, UInt32(written), UInt32(pageVertices.size()) });
+                written += pageVertices.size();
+            }
+
+            return written;
+        }}
+        //--------------------------------------------------------------------------
+
+        const Vector<TextDrawBatch>& TextRenderer::GetBatches() const noexcept
+        {
+            return _batches;
+        }
+        //--------------------------------------------------------------------------
+
+        GlyphAtlas& TextRenderer::GetGlyphAtlas() noexcept
+        {
+            return _glyphAtlas;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 TextRenderer::GetCachedLayoutsCount() const noexcept
+        {
+            return UInt64(_layouts.size());
+        }
+        //--------------------------------------------------------------------------
+
+        const TextRenderer::Layout& TextRenderer::_GetLayout(const String& text, UInt8 pixelSize)
+        {
+            auto& layout = _layouts[LayoutKey(text, pixelSize)];
+
+            // a colliding key simply replaces the previous layout
+            if (layout.pixelSize != pixelSize || layout.text != text)
+            {
+                layout.text = text;
+                layout.pixelSize = pixelSize;
+                _BuildLayout(layout);
+            }
+
+            layout.lastUsedFrame = _frameIndex;
+            return layout;
+        }
+        //--------------------------------------------------------------------------
+
+        void TextRenderer::_BuildLayout(Layout& layout) KMP_PROFILING(ProfileLevelMinorVerbose)
+        {
+            layout.quads.clear();
+
+            const auto& text = layout.text;
+            const auto lineHeight = float(_glyphAtlas.GetLineHeight(layout.pixelSize));
+
+            // advances and kerning are in 26.6 fixed point
+            auto pen = Math::Vec2F(0.0f, 0.0f);
+            UInt32 previousCodepoint = 0;
+            UInt64 offset = 0;
+            while (offset < text.size())
+            {
+                const auto codepoint = DecodeUtf8(text, offset);
+                if (codepoint == '\n')
+                {
+                    pen = Math::Vec2F(0.0f, pen.y + lineHeight);
+                    previousCodepoint = 0;
+                    continue;
+                }
+
+                const auto glyph = _glyphAtlas.GetGlyph(codepoint, layout.pixelSize);
+                if (not glyph)
+                {
+                    previousCodepoint = 0;
+                    continue;
+                }
+
+                const auto character = glyph->character;
+                const auto page = glyph->page;
+
+                if (previousCodepoint != 0)
+                {
+                    pen.x += float(_glyphAtlas.GetKerning(previousCodepoint, codepoint, layout.pixelSize)) / 64.0f;
+                }
+
+                if (character.size.x > 0 && character.size.y > 0)
+                {
+                    const auto min = Math::Vec2F(pen.x + float(character.bearing.x), pen.y - float(character.bearing.y));
+                    const auto max = Math::Vec2F(min.x + float(character.size.x), min.y + float(character.size.y));
+                    layout.quads.push_back(LayoutQuad{ min, max, character.uvMin, character.uvMax, page });
+                }
+
+                pen.x += float(character.advance) / 64.0f;
+                previousCodepoint = codepoint;
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        void TextRenderer::_EvictUnusedLayouts()
+        {
+            std::erase_if(_layouts, [this](const auto& entry) {
+                return entry.second.lastUsedFrame + DefaultLayoutLifetimeFrames < _frameIndex;
+            });
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
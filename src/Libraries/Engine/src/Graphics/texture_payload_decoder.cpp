@@ -0,0 +1,258 @@
+#include "Kmplete/Graphics/texture_payload_decoder.h"
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <cstring>
+
+
+namespace Kmplete
+{
+    namespace Graphics
+    {
+        static constexpr Array<UInt32, 16> BC7Weights4 = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+
+        //! Sequential reader of the little-endian bit stream of a 128-bit block
+        class BlockBitReader
+        {
+        public:
+            explicit BlockBitReader(const UByte* block) noexcept
+                : _block(block)
+                , _position(0)
+            {}
+
+            KMP_NODISCARD UInt32 Read(UInt32 bitsCount) noexcept
+            {
+                auto value = 0U;
+                for (UInt32 bit = 0; bit < bitsCount; bit++, _position++)
+                {
+                    value |= UInt32((_block[_position / 8] >> (_position % 8)) & 1) << bit;
+                }
+
+                return value;
+            }
+
+        private:
+            const UByte* _block;
+            UInt32 _position;
+        };
+        //--------------------------------------------------------------------------
+
+
+        static void Expand565(UInt16 color, UByte* rgb) noexcept
+        {
+            const auto r = UInt32(color >> 11) & 31;
+            const auto g = UInt32(color >> 5) & 63;
+            const auto b = UInt32(color) & 31;
+
+            rgb[0] = UByte((r << 3) | (r >> 2));
+            rgb[1] = UByte((g << 2) | (g >> 4));
+            rgb[2] = UByte((b << 3) | (b >> 2));
+        }
+        //--------------------------------------------------------------------------
+
+        static void DecodeColorBlock(const UByte* block, UByte* rgbaPixels, bool alwaysFourColors) noexcept
+        {
+            UInt16 color0 = 0;
+            UInt16 color1 = 0;
+            UInt32 indices = 0;
+            std::memcpy(&color0, block, sizeof(color0));
+            std::memcpy(&color1, block + 2, sizeof(color1));
+            std::memcpy(&indices, block + 4, sizeof(indices));
+
+            Array<Array<UByte, 4>, 4> palette{};
+            Expand565(color0, palette[0].data());
+            Expand565(color1, palette[1].data());
+            palette[0][3] = palette[1][3] = 255;
+
+            for (UInt32 channel = 0; channel < 3; channel++)
+            {
+                const auto c0 = UInt32(palette[0][channel]);
+                const auto c1 = UInt32(palette[1][channel]);
+
+                if (alwaysFourColors || color0 > color1)
+                {
+                    palette[2][channel] = UByte((2 * c0 + c1 + 1) / 3);
+                    palette[3][channel] = UByte((c0 + 2 * c1 + 1) / 3);
+                }
+                else
+                {
+                    palette[2][channel] = UByte((c0 + c1 + 1) / 2);
+                    palette[3][channel] = 0;
+                }
+            }
+            palette[2][3] = 255;
+            palette[3][3] = (alwaysFourColors || color0 > color1) ? 255 : 0;
+
+            for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+            {
+                std::memcpy(rgbaPixels + pixel * 4, palette[(indices >> (pixel * 2)) & 3].data(), 4);
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        static void DecodeSingleChannelBlock(const UByte* block, UByte* pixels, UInt32 pixelStride) noexcept
+        {
+            const auto value0 = UInt32(block[0]);
+            const auto value1 = UInt32(block[1]);
+
+            UInt64 indices = 0;
+            std::memcpy(&indices, block + 2, 6);
+
+            Array<UByte, 8> palette{};
+            palette[0] = UByte(value0);
+            palette[1] = UByte(value1);
+
+            if (value0 > value1)
+            {
+                for (UInt32 i = 1; i < 7; i++)
+                {
+                    palette[i + 1] = UByte(((7 - i) * value0 + i * value1 + 3) / 7);
+                }
+            }
+            else
+            {
+                for (UInt32 i = 1; i < 5; i++)
+                {
+                    palette[i + 1] = UByte(((5 - i) * value0 + i * value1 + 2) / 5);
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+
+            for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+            {
+                pixels[pixel * pixelStride] = palette[(indices >> (pixel * 3)) & 7];
+            }
+        }
+        //--------------------------------------------------------------------------
+
+        static bool DecodeBC7Block(const UByte* block, UByte* rgbaPixels) noexcept
+        {
+            constexpr auto Mode6Bits = 0x40;
+            if ((block[0] & 0x7F) != Mode6Bits)
+            {
+                return false;
+            }
+
+            auto reader = BlockBitReader(block);
+            KMP_MB_UNUSED const auto mode = reader.Read(7);
+
+            Array<Array<UInt32, 4>, 2> endpoints{};
+            for (UInt32 channel = 0; channel < 4; channel++)
+            {
+                endpoints[0][channel] = reader.Read(7) << 1;
+                endpoints[1][channel] = reader.Read(7) << 1;
+            }
+
+            const auto pBit0 = reader.Read(1);
+            const auto pBit1 = reader.Read(1);
+            for (UInt32 channel = 0; channel < 4; channel++)
+            {
+                endpoints[0][channel] |= pBit0;
+                endpoints[1][channel] |= pBit1;
+            }
+
+            for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+            {
+                const auto weight = BC7Weights4[reader.Read(pixel == 0 ? 3 : 4)];
+                for (UInt32 channel = 0; channel < 4; channel++)
+                {
+                    rgbaPixels[pixel * 4 + channel] = UByte(((64 - weight) * endpoints[0][channel] + weight * endpoints[1][channel] + 32) >> 6);
+                }
+            }
+
+            return true;
+        }
+        //--------------------------------------------------------------------------
+
+
+        bool DecodeTextureBlock(Assets::TexturePayloadFormat format, const UByte* block, UByte* pixels) noexcept
+        {
+            switch (format)
+            {
+            case Assets::TexturePayloadFormat::BC1:
+                DecodeColorBlock(block, pixels, false);
+                return true;
+            case Assets::TexturePayloadFormat::BC3:
+                DecodeColorBlock(block + 8, pixels, true);
+                DecodeSingleChannelBlock(block, pixels + 3, 4);
+                return true;
+            case Assets::TexturePayloadFormat::BC4:
+                DecodeSingleChannelBlock(block, pixels, 1);
+                return true;
+            case Assets::TexturePayloadFormat::BC5:
+                DecodeSingleChannelBlock(block, pixels, 2);
+                DecodeSingleChannelBlock(block + 8, pixels + 1, 2);
+                return true;
+            case Assets::TexturePayloadFormat::BC7:
+                return DecodeBC7Block(block, pixels);
+            default:
+                break;
+            }
+
+            return false;
+        }
+        //--------------------------------------------------------------------------
+
+        BinaryBuffer DecompressTexturePayload(BinaryView texturePayload) KMP_PROFILING(ProfileLevelImportant)
+        {
+            Assets::TexturePayloadHeader header{};
+            if (not Assets::ReadTexturePayloadHeader(texturePayload, header))
+            {
+                KMP_LOG_ERROR_FN("TexturePayloadDecoder: malformed texture payload");
+                return BinaryBuffer();
+            }
+
+            const auto format = static_cast<Assets::TexturePayloadFormat>(header.format);
+            if (not Assets::IsTexturePayloadFormatCompressed(format))
+            {
+                return BinaryBuffer(texturePayload.begin(), texturePayload.end());
+            }
+
+            const auto width = UInt32(header.width);
+            const auto height = UInt32(header.height);
+            const auto mipLevels = UInt32(header.mipLevels);
+            const auto uncompressedFormat = Assets::GetTexturePayloadUncompressedFormat(format);
+            const auto channels = Assets::GetTexturePayloadChannelsCount(uncompressedFormat);
+            const auto blockSize = Assets::GetTexturePayloadBlockSize(format);
+
+            BinaryBuffer result(Assets::GetTexturePayloadSize(uncompressedFormat, width, height, mipLevels), 0);
+
+            header.format = static_cast<UByte>(uncompressedFormat);
+            std::memcpy(result.data(), &header, Assets::TexturePayloadHeaderStructSize);
+
+            Array<UByte, TextureBlockPixelsCount * 4> blockPixels{};
+
+            for (UInt32 mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+            {
+                const auto mipWidth = Assets::GetTexturePayloadMipDimension(width, mipLevel);
+                const auto mipHeight = Assets::GetTexturePayloadMipDimension(height, mipLevel);
+                const auto* source = texturePayload.data() + Assets::GetTexturePayloadMipLevelOffset(format, width, height, mipLevel);
+                auto* destination = result.data() + Assets::GetTexturePayloadMipLevelOffset(uncompressedFormat, width, height, mipLevel);
+
+                for (UInt32 blockY = 0; blockY < mipHeight; blockY += 4)
+                {
+                    for (UInt32 blockX = 0; blockX < mipWidth; blockX += 4, source += blockSize)
+                    {
+                        if (not DecodeTextureBlock(format, source, blockPixels.data()))
+                        {
+                            KMP_LOG_ERROR_FN("TexturePayloadDecoder: unsupported block encountered at mip level {}", mipLevel);
+                            return BinaryBuffer();
+                        }
+
+                        const auto columns = std::min(4U, mipWidth - blockX);
+                        const auto rows = std::min(4U, mipHeight - blockY);
+                        for (UInt32 row = 0; row < rows; row++)
+                        {
+                            std::memcpy(destination + (UInt64(blockY + row) * mipWidth + blockX) * channels, blockPixels.data() + row * 4 * channels, columns * channels);
+                        }
+                    }
+                }
+            }
+
+            return result;
+        }}
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -0,0 +1,629 @@
+#include "Kmplete/Assets/assets_manager.h"
+#include "Kmplete/Assets/assets_interface.h"
+#include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Window/window_backend.h"
+#include "Kmplete/Window/window.h"
+#include "Kmplete/Filesystem/filesystem.h"
+#include "Kmplete/Utils/compression_utils.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/named_bool.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+#include <algorithm>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Assets;
+using namespace Kmplete::Graphics;
+
+
+static constexpr StringID SyntheticTextureFirstSID = 100000;
+
+
+//! Builds a raw RGBA8 texture payload with the full mip chain, every level is filled with its own index
+static BinaryBuffer CreateSyntheticTexturePayload(UInt32 width, UInt32 height)
+{
+    const auto format = TexturePayloadFormat::RGBA8;
+    const auto mipLevels = GetTexturePayloadMaxMipLevels(width, height);
+
+    BinaryBuffer payload(GetTexturePayloadSize(format, width, height, mipLevels), 0);
+
+    const TexturePayloadHeader header{
+        .format = static_cast<UByte>(format),
+        .mipLevels = static_cast<UByte>(mipLevels),
+        .reserved = 0,
+        .width = width,
+        .height = height
+    };
+    std::memcpy(payload.data(), &header, TexturePayloadHeaderStructSize);
+
+    for (UInt32 mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+    {
+        std::memset(payload.data() + GetTexturePayloadMipLevelOffset(format, width, height, mipLevel), int(mipLevel), GetTexturePayloadMipLevelSize(format, width, height, mipLevel));
+    }
+
+    return payload;
+}
+//--------------------------------------------------------------------------
+
+//! Writes an asset archive of "count" textures, every entry holds its own copy of the test icon
+//! or of a synthetic raw payload depending on "encoding", compressed according to "compression".
+//! With "sharedEntryBuffer" all entries reference a single copy, which keeps huge archives small
+static void WriteSyntheticTextureArchive(const Filepath& archivePath, AssetCount count, AssetEncoding encoding = AssetEncoding::Source, AssetCompression compression = AssetCompression::None, bool sharedEntryBuffer = false)
+{
+    const auto sourceBuffer = encoding == AssetEncoding::Raw
+        ? CreateSyntheticTexturePayload(64, 64)
+        : Filesystem::ReadFileAsBinary(Filepath(KMP_TEST_ICON_PATH));
+    REQUIRE_FALSE(sourceBuffer.empty());
+
+    const auto entryBuffer = compression == AssetCompression::LZ ? Utils::CompressLZ(sourceBuffer) : sourceBuffer;
+    REQUIRE_FALSE(entryBuffer.empty());
+
+    const auto dataOffset = sizeof(AssetCount) + count * AssetEntryHeaderStructSize;
+    const auto entryBuffersCount = sharedEntryBuffer ? 1 : count;
+    const auto indexOffset = dataOffset + entryBuffersCount * entryBuffer.size();
+    BinaryBuffer archive(indexOffset + count * AssetIndexEntryStructSize + AssetIndexFooterStructSize);
+    std::memcpy(archive.data(), &count, sizeof(AssetCount));
+
+    for (AssetCount i = 0; i < count; i++)
+    {
+        AssetEntryHeader header{};
+        header.type = static_cast<UByte>(AssetType::Texture);
+        header.encoding = static_cast<UByte>(encoding);
+        header.compression = static_cast<UByte>(compression);
+        header.subTypeMask = TextureSubTypeMaskBits::SRGB;
+        header.sid = SyntheticTextureFirstSID + i;
+        header.bufferSize = entryBuffer.size();
+        header.uncompressedSize = sourceBuffer.size();
+        header.bufferOffset = dataOffset + (sharedEntryBuffer ? 0 : i) * entryBuffer.size();
+
+        std::memcpy(archive.data() + sizeof(AssetCount) + i * AssetEntryHeaderStructSize, &header, AssetEntryHeaderStructSize);
+        std::memcpy(archive.data() + header.bufferOffset, entryBuffer.data(), entryBuffer.size());
+
+        // sids grow together with the header index, so the index is sorted already
+        const AssetIndexEntry indexEntry{
+            .sid = header.sid,
+            .headerIndex = i
+        };
+        std::memcpy(archive.data() + indexOffset + i * AssetIndexEntryStructSize, &indexEntry, AssetIndexEntryStructSize);
+    }
+
+    const AssetIndexFooter footer{
+        .indexOffset = indexOffset,
+        .signature = AssetIndexFooterSignature
+    };
+    std::memcpy(archive.data() + archive.size() - AssetIndexFooterStructSize, &footer, AssetIndexFooterStructSize);
+
+    REQUIRE(Filesystem::CreateFile(archivePath));
+    REQUIRE(Filesystem::WriteFile(archivePath, archive, false));
+}
+//--------------------------------------------------------------------------
+
+static Vector<StringID> SyntheticTextureSids(AssetCount count)
+{
+    Vector<StringID> sids;
+    sids.reserve(count);
+    for (AssetCount i = 0; i < count; i++)
+    {
+        sids.push_back(SyntheticTextureFirstSID + i);
+    }
+
+    return sids;
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("AssetsManager load, unload and reload textures from archive", "[assets][assets_manager][texture][asset]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    constexpr AssetCount TexturesCount = 100;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_tests";
+    const auto archiveName = Filepath("textures.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / archiveName, TexturesCount);
+
+    const LocaleStr locale = "en_US";
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+
+        REQUIRE(assetsManager.LoadAssetFile(archiveName));
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1); // error texture included
+        REQUIRE(textureAssetManager.GetAsset(SyntheticTextureFirstSID + 42).GetStringID() == SyntheticTextureFirstSID + 42);
+
+        const auto sids = SyntheticTextureSids(TexturesCount);
+        REQUIRE(assetsManager.UnloadAssets(sids));
+        REQUIRE(textureAssetManager.GetAssetsCount() == 1);
+
+        REQUIRE(assetsManager.LoadAssets({ SyntheticTextureFirstSID + 7 }));
+        REQUIRE(textureAssetManager.GetAssetsCount() == 2);
+
+        REQUIRE_FALSE(assetsManager.LoadAssets(sids)); // already loaded sid is reported, the rest are loaded anyway
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1);
+    }
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("AssetsManager load raw texture payloads from archive", "[assets][assets_manager][texture][asset]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    constexpr AssetCount TexturesCount = 100;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_raw_tests";
+    const auto archiveName = Filepath("textures.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / archiveName, TexturesCount, AssetEncoding::Raw);
+
+    const LocaleStr locale = "en_US";
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+
+        REQUIRE(assetsManager.LoadAssetFile(archiveName));
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1); // error texture included
+        REQUIRE(textureAssetManager.GetAsset(SyntheticTextureFirstSID + 42).GetStringID() == SyntheticTextureFirstSID + 42);
+
+        const auto sids = SyntheticTextureSids(TexturesCount);
+        REQUIRE(assetsManager.UnloadAssets(sids));
+        REQUIRE(textureAssetManager.GetAssetsCount() == 1);
+
+        auto payload = CreateSyntheticTexturePayload(64, 64);
+        REQUIRE(textureAssetManager.CreateAsset(SyntheticTextureFirstSID, BinaryView(payload), TextureSubTypeMaskBits::RGB));
+        REQUIRE_FALSE(textureAssetManager.CreateAsset(SyntheticTextureFirstSID + 1, BinaryView(payload).first(payload.size() - 1), TextureSubTypeMaskBits::RGB));
+
+        payload[offsetof(TexturePayloadHeader, mipLevels)] = 8; // 64x64 texture has only 7 levels
+        REQUIRE_FALSE(textureAssetManager.CreateAsset(SyntheticTextureFirstSID + 2, BinaryView(payload), TextureSubTypeMaskBits::RGB));
+        REQUIRE(textureAssetManager.GetAssetsCount() == 2);
+    }
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("AssetsManager find assets by archive index", "[assets][assets_manager][texture][asset]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    constexpr AssetCount TexturesCount = 100;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_index_tests";
+    const auto archiveName = Filepath("textures.kmpdata");
+    const auto malformedArchiveName = Filepath("textures_malformed.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / archiveName, TexturesCount);
+
+    const LocaleStr locale = "en_US";
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+
+        REQUIRE(assetsManager.LoadAssetFile(archiveName, "load binaries"_false));
+        REQUIRE(assetsManager.LoadAssetFile(archiveName, "load binaries"_false)); // already registered file is reused
+        REQUIRE(textureAssetManager.GetAssetsCount() == 1);
+
+        REQUIRE(assetsManager.LoadAssets({ SyntheticTextureFirstSID + TexturesCount - 1, SyntheticTextureFirstSID }));
+        REQUIRE(textureAssetManager.GetAssetsCount() == 3);
+        REQUIRE(textureAssetManager.GetAsset(SyntheticTextureFirstSID + TexturesCount - 1).GetStringID() == SyntheticTextureFirstSID + TexturesCount - 1);
+
+        REQUIRE_FALSE(assetsManager.LoadAssets({ SyntheticTextureFirstSID - 1, SyntheticTextureFirstSID + TexturesCount }));
+        REQUIRE(textureAssetManager.GetAssetsCount() == 3);
+    }
+
+    const auto archive = Filesystem::ReadFileAsBinary(dataPath / archiveName);
+    {
+        auto truncatedArchive = archive;
+        truncatedArchive.pop_back();
+        REQUIRE(Filesystem::WriteFile(dataPath / malformedArchiveName, truncatedArchive, false));
+
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        REQUIRE_FALSE(assetsManager.LoadAssetFile(malformedArchiveName));
+    }
+    {
+        auto wrongIndexArchive = archive;
+        wrongIndexArchive[wrongIndexArchive.size() - AssetIndexFooterStructSize] ^= 0x1; // index offset points into the middle of an index entry
+        REQUIRE(Filesystem::WriteFile(dataPath / malformedArchiveName, wrongIndexArchive, false));
+
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        REQUIRE_FALSE(assetsManager.LoadAssetFile(malformedArchiveName));
+    }
+    {
+        // the first two index entries swapped
+        auto unsortedIndexArchive = archive;
+        const auto indexOffset = unsortedIndexArchive.size() - AssetIndexFooterStructSize - TexturesCount * AssetIndexEntryStructSize;
+        std::swap_ranges(unsortedIndexArchive.begin() + indexOffset, unsortedIndexArchive.begin() + indexOffset + AssetIndexEntryStructSize,
+                         unsortedIndexArchive.begin() + indexOffset + AssetIndexEntryStructSize);
+        REQUIRE(Filesystem::WriteFile(dataPath / malformedArchiveName, unsortedIndexArchive, false));
+
+        // registration does not scan the index, the first lookup around the swapped entries rejects the file
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        REQUIRE(assetsManager.LoadAssetFile(malformedArchiveName, "load binaries"_false));
+        REQUIRE_FALSE(assetsManager.LoadAssets({ SyntheticTextureFirstSID }));
+        REQUIRE_FALSE(assetsManager.LoadAssets({ SyntheticTextureFirstSID + TexturesCount / 2 }));
+        REQUIRE(assetsManager.GetTextureAssetManager().GetAssetsCount() == 1);
+    }
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("AssetsManager load compressed entries from archive", "[assets][assets_manager][texture][asset]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    constexpr AssetCount TexturesCount = 100;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_compressed_tests";
+    const auto sourceArchiveName = Filepath("textures_source.kmpdata");
+    const auto rawArchiveName = Filepath("textures_raw.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / sourceArchiveName, TexturesCount, AssetEncoding::Source, AssetCompression::LZ);
+
+    const LocaleStr locale = "en_US";
+    const auto sids = SyntheticTextureSids(TexturesCount);
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+
+        REQUIRE(assetsManager.LoadAssetFile(sourceArchiveName));
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1); // error texture included
+        REQUIRE(textureAssetManager.GetAsset(SyntheticTextureFirstSID + 42).GetStringID() == SyntheticTextureFirstSID + 42);
+        REQUIRE(assetsManager.UnloadAssets(sids));
+    }
+
+    WriteSyntheticTextureArchive(dataPath / rawArchiveName, TexturesCount, AssetEncoding::Raw, AssetCompression::LZ);
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+
+        REQUIRE(assetsManager.LoadAssetFile(rawArchiveName));
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1);
+        REQUIRE(assetsManager.UnloadAssets(sids));
+    }
+
+    // a compressed entry declaring the wrong uncompressed size is rejected, the rest of the archive is loaded
+    auto archive = Filesystem::ReadFileAsBinary(dataPath / rawArchiveName);
+    const auto uncompressedSizeOffset = sizeof(AssetCount) + offsetof(AssetEntryHeader, uncompressedSize);
+    UInt64 uncompressedSize = 0;
+    std::memcpy(&uncompressedSize, archive.data() + uncompressedSizeOffset, sizeof(uncompressedSize));
+    uncompressedSize++;
+    std::memcpy(archive.data() + uncompressedSizeOffset, &uncompressedSize, sizeof(uncompressedSize));
+    REQUIRE(Filesystem::WriteFile(dataPath / rawArchiveName, archive, false));
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+
+        REQUIRE_FALSE(assetsManager.LoadAssetFile(rawArchiveName));
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount);
+    }
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("AssetsManager stream textures with upload budget", "[assets][assets_manager][texture][asset]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    constexpr AssetCount TexturesCount = 100;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_streaming_tests";
+    const auto archiveName = Filepath("textures.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / archiveName, TexturesCount, AssetEncoding::Raw);
+
+    const LocaleStr locale = "en_US";
+    const auto sids = SyntheticTextureSids(TexturesCount);
+    const auto processUploadsUntilFinished = [](AssetsManager& assetsManager, const AssetLoadHandle& request, const AssetUploadBudget& budget) {
+        while (not request->IsFinished())
+        {
+            assetsManager.ProcessUploads(budget);
+        }
+    };
+
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+        REQUIRE(assetsManager.LoadAssetFile(archiveName, "load binaries"_false));
+
+        const auto request = assetsManager.LoadAssetsAsync(sids, AssetLoadPriority::Low);
+        REQUIRE(request->GetAssetsCount() == TexturesCount);
+        REQUIRE(assetsManager.IsAssetPending(SyntheticTextureFirstSID));
+        REQUIRE(assetsManager.GetTextureAssetOrPlaceholder(SyntheticTextureFirstSID).GetStringID() == TextureAssetManager::ErrorTextureSID);
+
+        // a single upload per call, every payload is bigger than one byte
+        const auto pendingCount = assetsManager.GetPendingAssetsCount();
+        while (assetsManager.ProcessUploads(AssetUploadBudget{ .bytes = 1, .milliseconds = 1000.0f }) == 0) {}
+        REQUIRE(assetsManager.GetPendingAssetsCount() == pendingCount - 1);
+
+        processUploadsUntilFinished(assetsManager, request, AssetUploadBudget());
+        REQUIRE(request->GetLoadedCount() == TexturesCount);
+        REQUIRE(request->GetFuture().get());
+        REQUIRE(assetsManager.GetPendingAssetsCount() == 0);
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1); // error texture included
+        REQUIRE(assetsManager.GetTextureAssetOrPlaceholder(SyntheticTextureFirstSID).GetStringID() == SyntheticTextureFirstSID);
+
+        // resident and unknown assets are finished right away
+        const auto finishedRequest = assetsManager.LoadAssetsAsync({ SyntheticTextureFirstSID, SyntheticTextureFirstSID + TexturesCount });
+        REQUIRE(finishedRequest->IsFinished());
+        REQUIRE(finishedRequest->GetLoadedCount() == 1);
+        REQUIRE(finishedRequest->GetFailedCount() == 1);
+        REQUIRE_FALSE(finishedRequest->GetFuture().get());
+
+        REQUIRE(assetsManager.UnloadAssets(sids));
+        REQUIRE(textureAssetManager.GetAssetsCount() == 1);
+    }
+
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+        REQUIRE(assetsManager.LoadAssetFile(archiveName, "load binaries"_false));
+
+        // sids requested again while pending are decoded and created once, every request gets them
+        const auto lowRequest = assetsManager.LoadAssetsAsync(sids, AssetLoadPriority::Low);
+        const auto criticalRequest = assetsManager.LoadAssetsAsync({ SyntheticTextureFirstSID + 7, SyntheticTextureFirstSID + 7 }, AssetLoadPriority::Critical);
+        REQUIRE(assetsManager.GetPendingAssetsCount() == TexturesCount);
+
+        processUploadsUntilFinished(assetsManager, lowRequest, AssetUploadBudget());
+        REQUIRE(criticalRequest->IsFinished());
+        REQUIRE(criticalRequest->GetLoadedCount() == 2);
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1);
+        REQUIRE(assetsManager.UnloadAssets(sids));
+
+        // unloading pending assets cancels them
+        const auto cancelledRequest = assetsManager.LoadAssetsAsync(sids);
+        REQUIRE(assetsManager.UnloadAssets({ SyntheticTextureFirstSID }));
+        REQUIRE(cancelledRequest->GetFailedCount() == 1);
+
+        processUploadsUntilFinished(assetsManager, cancelledRequest, AssetUploadBudget());
+        REQUIRE(cancelledRequest->GetLoadedCount() == TexturesCount - 1);
+        REQUIRE_FALSE(textureAssetManager.ContainsAsset(SyntheticTextureFirstSID));
+    }
+
+    // requests left pending get their future values on the manager destruction
+    auto abandonedRequest = AssetLoadHandle();
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        REQUIRE(assetsManager.LoadAssetFile(archiveName, "load binaries"_false));
+
+        abandonedRequest = assetsManager.LoadAssetsAsync(sids, AssetLoadPriority::High);
+    }
+    REQUIRE(abandonedRequest->IsFinished());
+    REQUIRE_FALSE(abandonedRequest->GetFuture().get());
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("AssetsManager evict least recently used textures", "[assets][assets_manager][texture][asset]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    constexpr AssetCount TexturesCount = 100;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_residency_tests";
+    const auto archiveName = Filepath("textures.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / archiveName, TexturesCount, AssetEncoding::Raw);
+
+    const LocaleStr locale = "en_US";
+    const auto sids = SyntheticTextureSids(TexturesCount);
+    const auto processUploadsUntilResident = [](AssetsManager& assetsManager, StringID sid) {
+        while (not assetsManager.IsAssetResident(sid))
+        {
+            assetsManager.ProcessUploads(AssetUploadBudget());
+        }
+    };
+
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        auto& textureAssetManager = assetsManager.GetTextureAssetManager();
+        REQUIRE(assetsManager.LoadAssetFile(archiveName));
+
+        auto handle = assetsManager.AcquireAsset(SyntheticTextureFirstSID);
+        REQUIRE(handle.IsResident());
+        REQUIRE(handle.GetTextureAsset().GetStringID() == SyntheticTextureFirstSID);
+
+        for (const auto& sid : sids)
+        {
+            REQUIRE(assetsManager.GetTextureAssetOrPlaceholder(sid).GetStringID() == sid);
+        }
+
+        // any memory usage exceeds the zero fraction, so only the recency and the handles protect textures
+        const auto policy = AssetResidencyPolicy{ .memoryUsageFraction = 0.0f, .minUnusedFrames = 0, .maxEvictionsPerFrame = 10 };
+        REQUIRE(assetsManager.UpdateResidency(policy) == 0);
+
+        for (auto i = TexturesCount / 2; i < TexturesCount; i++)
+        {
+            REQUIRE(assetsManager.GetTextureAssetOrPlaceholder(sids[i]).GetStringID() == sids[i]);
+        }
+
+        // textures used by the frames in flight are kept regardless of the policy
+        REQUIRE(assetsManager.UpdateResidency(policy) == 0);
+        REQUIRE(assetsManager.UpdateResidency(policy) == 10);
+        REQUIRE(assetsManager.UpdateResidency(policy) == 10);
+        REQUIRE(textureAssetManager.GetAssetsCount() == TexturesCount + 1 - 20);
+
+        // the least recently used textures are evicted first, the held one is never evicted
+        REQUIRE(handle.IsResident());
+        for (auto i = TexturesCount / 2; i < TexturesCount; i++)
+        {
+            REQUIRE(assetsManager.IsAssetResident(sids[i]));
+        }
+
+        // evicted texture is streamed again on use, the error texture stands in for it meanwhile
+        auto evictedSid = StringID(0);
+        for (const auto& sid : sids)
+        {
+            if (not assetsManager.IsAssetResident(sid))
+            {
+                evictedSid = sid;
+                break;
+            }
+        }
+        REQUIRE(evictedSid != 0);
+        REQUIRE(assetsManager.GetTextureAssetOrPlaceholder(evictedSid).GetStringID() == TextureAssetManager::ErrorTextureSID);
+        REQUIRE(assetsManager.IsAssetPending(evictedSid));
+        processUploadsUntilResident(assetsManager, evictedSid);
+        REQUIRE(assetsManager.GetTextureAssetOrPlaceholder(evictedSid).GetStringID() == evictedSid);
+
+        // explicitly unloaded textures are not streamed again
+        REQUIRE(assetsManager.UnloadAssets({ evictedSid }));
+        REQUIRE(assetsManager.GetTextureAssetOrPlaceholder(evictedSid).GetStringID() == TextureAssetManager::ErrorTextureSID);
+        REQUIRE_FALSE(assetsManager.IsAssetPending(evictedSid));
+
+        // copies keep the texture held until the last one is released
+        auto handleCopy = handle;
+        handle.Reset();
+        for (auto frame = 0; frame < 20; frame++)
+        {
+            KMP_MB_UNUSED const auto evictedCount = assetsManager.UpdateResidency(policy);
+        }
+        REQUIRE(handleCopy.IsResident());
+
+        handleCopy.Reset();
+        for (auto frame = 0; frame < 20; frame++)
+        {
+            KMP_MB_UNUSED const auto evictedCount = assetsManager.UpdateResidency(policy);
+        }
+        REQUIRE_FALSE(assetsManager.IsAssetResident(SyntheticTextureFirstSID));
+
+        // acquiring a handle streams the texture back
+        const auto reacquiredHandle = assetsManager.AcquireAsset(SyntheticTextureFirstSID, AssetLoadPriority::Critical);
+        processUploadsUntilResident(assetsManager, SyntheticTextureFirstSID);
+        REQUIRE(reacquiredHandle.GetTextureAsset().GetStringID() == SyntheticTextureFirstSID);
+    }
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
+
+
+// Hidden from the default run, e.g.: Kmplete_WindowApplicationTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("AssetsManager load 1000 textures archive", "[.][benchmark][assets][assets_manager][texture]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& uploadContext = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice().GetUploadContext();
+
+    constexpr AssetCount TexturesCount = 1000;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_benchmark";
+    const auto archiveName = Filepath("textures.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / archiveName, TexturesCount);
+
+    const LocaleStr locale = "en_US";
+    const auto sids = SyntheticTextureSids(TexturesCount);
+
+    const auto benchmarkLoading = [&](AssetsManager& assetsManager) {
+        const auto loadedOk = assetsManager.LoadAssets(sids);
+        uploadContext.Wait(uploadContext.Flush());
+        assetsManager.UnloadAssets(sids);
+        return loadedOk;
+    };
+
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale, 1);
+        REQUIRE(assetsManager.LoadAssetFile(archiveName, "load binaries"_false));
+
+        BENCHMARK("Single decode worker")
+        {
+            return benchmarkLoading(assetsManager);
+        };
+    }
+
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        REQUIRE(assetsManager.LoadAssetFile(archiveName, "load binaries"_false));
+
+        BENCHMARK("Decode workers by hardware concurrency")
+        {
+            return benchmarkLoading(assetsManager);
+        };
+    }
+
+    const auto rawArchiveName = Filepath("textures_raw.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / rawArchiveName, TexturesCount, AssetEncoding::Raw);
+
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        REQUIRE(assetsManager.LoadAssetFile(rawArchiveName, "load binaries"_false));
+
+        BENCHMARK("Raw payloads with precomputed mip levels")
+        {
+            return benchmarkLoading(assetsManager);
+        };
+    }
+
+    const auto compressedRawArchiveName = Filepath("textures_raw_lz.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / compressedRawArchiveName, TexturesCount, AssetEncoding::Raw, AssetCompression::LZ);
+
+    {
+        AssetsManager assetsManager(dataPath, *backend.get(), locale);
+        REQUIRE(assetsManager.LoadAssetFile(compressedRawArchiveName, "load binaries"_false));
+
+        BENCHMARK("LZ-compressed raw payloads decompressed by decode workers")
+        {
+            return benchmarkLoading(assetsManager);
+        };
+    }
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
+
+// Hidden from the default run, e.g.: Kmplete_WindowApplicationTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("AssetsManager register 100k entries archive", "[.][benchmark][assets][assets_manager]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    constexpr AssetCount TexturesCount = 100000;
+    const auto dataPath = Filesystem::GetCurrentFilepath() / "assets_manager_index_benchmark";
+    const auto archiveName = Filepath("textures.kmpdata");
+    WriteSyntheticTextureArchive(dataPath / archiveName, TexturesCount, AssetEncoding::Raw, AssetCompression::None, true);
+
+    const LocaleStr locale = "en_US";
+
+    BENCHMARK_ADVANCED("Register archive")(Catch::Benchmark::Chronometer meter)
+    {
+        // managers are created beforehand, so only the registration itself is measured
+        Vector<UPtr<AssetsManager>> assetsManagers;
+        for (auto run = 0; run < meter.runs(); run++)
+        {
+            assetsManagers.push_back(CreateUPtr<AssetsManager>(dataPath, *backend.get(), locale));
+        }
+
+        meter.measure([&](int run) {
+            return assetsManagers[run]->LoadAssetFile(archiveName, "load binaries"_false);
+        });
+    };
+
+    REQUIRE(Filesystem::RemoveDirectories(dataPath));
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
@@ -3,9 +3,12 @@
 #include "Kmplete/Base/pointers.h"
 #include "Kmplete/Base/string_id.h"
 #include "Kmplete/Utils/string_utils.h"
+#include "Kmplete/Filesystem/filesystem.h"
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <thread>
+
 
 using namespace Kmplete;
 using namespace Kmplete::Assets;
@@ -187,4 +190,47 @@ TEST_CASE("FontAssetManager font functions", "[graphics][font_asset_manager][ass
         REQUIRE(fontParams.sizeMetrics.yPixelsPerEM != defaultDpiYPixelsPerEM);
     }
 }
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("FontAssetManager fonts parsing while fonts are removed", "[graphics][font_asset_manager][asset][font]")
+{
+    UPtr<FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    const auto fontPath = Utils::Concatenate(KMP_FONTS_FOLDER, "OpenSans-Regular.ttf");
+    const auto fontData = Filesystem::ReadFileAsBinary(fontPath);
+    REQUIRE_FALSE(fontData.empty());
+
+    // workers parse and discard fonts like the streaming decoding does, while the fonts owned by the manager are created and removed
+    constexpr auto ThreadsCount = 4;
+    constexpr auto IterationsCount = 50;
+    Vector<std::thread> threads;
+    for (int threadIndex = 0; threadIndex < ThreadsCount; threadIndex++)
+    {
+        threads.emplace_back([&, threadIndex]() {
+            for (int i = 0; i < IterationsCount; i++)
+            {
+                auto fontAsset = fontAssetManager->ParseAsset(StringID(1000 + threadIndex), BinaryBuffer(fontData), FontSubTypeMaskBits::None);
+                fontAssetManager->DiscardAsset(std::move(fontAsset));
+            }
+        });
+    }
+
+    const auto fontSid = "OpenSans-Regular.ttf"_sid;
+    for (int i = 0; i < IterationsCount; i++)
+    {
+        REQUIRE(fontAssetManager->AddAsset(fontAssetManager->ParseAsset(fontSid, BinaryBuffer(fontData), FontSubTypeMaskBits::None)));
+        REQUIRE(fontAssetManager->RemoveAsset(fontSid));
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(fontAssetManager->GetAssetsCount() == 1UL);
+    REQUIRE_NOTHROW(fontAssetManager->DiscardAsset(nullptr));
+}
 //--------------------------------------------------------------------------
\ No newline at end of file
@@ -2,6 +2,11 @@
 #include "Kmplete/Graphics/texture.h"
 #include "Kmplete/Graphics/graphics_backend.h"
 #include "Kmplete/Graphics/image.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_graphics_parameters.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_descriptor_set_manager.h"
+#include "Kmplete/Graphics/Vulkan/Texture/vulkan_texture.h"
 #include "Kmplete/Window/window_backend.h"
 #include "Kmplete/Window/window.h"
 #include "Kmplete/Base/pointers.h"
@@ -27,6 +32,15 @@ static UPtr<GraphicsBackend> prepareBackend(GraphicsBackendType type)
 }
 //--------------------------------------------------------------------------
 
+static void InitializeBindlessGraphicsParameters(GraphicsParameters& parameters)
+{
+    if (parameters.type == GraphicsBackendType::Vulkan)
+    {
+        dynamic_cast<VulkanGraphicsParameters&>(parameters).bindlessTexturesCount = 4;
+    }
+}
+//--------------------------------------------------------------------------
+
 
 TEST_CASE("TextureAssetManager initialization Vulkan", "[graphics][texture_asset_manager][asset]")
 {
@@ -141,4 +155,61 @@ TEST_CASE("TextureAssetManager texture functions", "[graphics][texture_asset_man
     REQUIRE_FALSE(ok);
     REQUIRE(textureAssetManager->GetAssetsCount() == 1UL);
 }
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("TextureAssetManager bindless indices", "[graphics][texture_asset_manager][texture][asset]")
+{
+    ClientInitializeGraphicsParametersFn = InitializeBindlessGraphicsParameters;
+    const auto graphicsBackend = prepareBackend(GraphicsBackendType::Vulkan);
+    ClientInitializeGraphicsParametersFn = nullptr;
+    REQUIRE(graphicsBackend);
+
+    UPtr<TextureAssetManager> textureAssetManager;
+    REQUIRE_NOTHROW(textureAssetManager = CreateUPtr<TextureAssetManager>(*graphicsBackend.get()));
+    REQUIRE(textureAssetManager);
+    REQUIRE(textureAssetManager->GetAsset(TextureAssetManager::ErrorTextureSID).GetBindlessIndex() == TextureAssetManager::ErrorTextureBindlessIndex);
+
+    const auto image = Image(Filepath(KMP_TEST_ICON_PATH), ImageChannels::RGBAlpha);
+    const Vector<StringID> sids{ 101, 102, 103, 104 };
+    for (const auto sid : sids)
+    {
+        REQUIRE(textureAssetManager->CreateAsset(sid, image, TextureSubTypeMaskBits::SRGB));
+    }
+
+    if (graphicsBackend->GetBindlessTexturesCount() == 0)
+    {
+        // device without descriptor indexing support, every texture shares the error texture slot
+        for (const auto sid : sids)
+        {
+            REQUIRE(textureAssetManager->GetAsset(sid).GetBindlessIndex() == TextureAssetManager::ErrorTextureBindlessIndex);
+        }
+        return;
+    }
+
+    REQUIRE(graphicsBackend->GetBindlessTexturesCount() == 4);
+    REQUIRE(textureAssetManager->GetAsset(101).GetBindlessIndex() == 1);
+    REQUIRE(textureAssetManager->GetAsset(102).GetBindlessIndex() == 2);
+    REQUIRE(textureAssetManager->GetAsset(103).GetBindlessIndex() == 3);
+    REQUIRE(textureAssetManager->GetAsset(104).GetBindlessIndex() == TextureAssetManager::ErrorTextureBindlessIndex); // array is full
+
+    const auto& descriptorSetManager = dynamic_cast<VulkanPhysicalDevice&>(graphicsBackend->GetPhysicalDevice()).GetLogicalDevice().GetDescriptorSetManager();
+    const auto getImageView = [&](StringID sid) { return dynamic_cast<const VulkanTexture&>(textureAssetManager->GetAsset(sid).GetTexture()).GetVkImageView(); };
+    REQUIRE(descriptorSetManager.GetBindlessTextureImageView(2) == getImageView(102));
+
+    // slot of a removed texture holds the error texture until it is reused, slots of the others stay the same
+    REQUIRE(textureAssetManager->RemoveAsset(102));
+    REQUIRE(descriptorSetManager.GetBindlessTextureImageView(2) == getImageView(TextureAssetManager::ErrorTextureSID));
+    REQUIRE(textureAssetManager->CreateAsset(105, image, TextureSubTypeMaskBits::SRGB));
+    REQUIRE(textureAssetManager->GetAsset(105).GetBindlessIndex() == 2);
+    REQUIRE(descriptorSetManager.GetBindlessTextureImageView(2) == getImageView(105));
+    REQUIRE(textureAssetManager->GetAsset(101).GetBindlessIndex() == 1);
+    REQUIRE(textureAssetManager->GetAsset(103).GetBindlessIndex() == 3);
+
+    // removing a texture without a slot of its own keeps the error texture slot out of reuse
+    REQUIRE(textureAssetManager->RemoveAsset(104));
+    REQUIRE(textureAssetManager->RemoveAsset(101));
+    REQUIRE(textureAssetManager->CreateAsset(106, image, TextureSubTypeMaskBits::SRGB));
+    REQUIRE(textureAssetManager->GetAsset(106).GetBindlessIndex() == 1);
+}
 //--------------------------------------------------------------------------
\ No newline at end of file
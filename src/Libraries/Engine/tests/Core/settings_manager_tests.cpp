@@ -63,5 +63,10 @@ TEST_CASE("SettingsManager read/write and back", "[core][settings_document][mana
 
     settings = swapSettingsManager.GetSettingsDocument("ObjB");
     REQUIRE(settings); // didn't change ObjB but expect it to be in swapSettings json file
+
+    REQUIRE(swapSettingsManager.LoadSettings(Kmplete::JsonLoadMode::Stream));
+    settings = swapSettingsManager.GetSettingsDocument("ObjA");
+    REQUIRE(settings);
+    REQUIRE(settings->get().GetInt("PropA") == 999);
 }
 //--------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "Kmplete/Core/thread_pool.h"
+#include "Kmplete/Base/exception.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+
+
+TEST_CASE("ThreadPool threads count", "[core][thread_pool]")
+{
+    const Kmplete::ThreadPool defaultPool;
+    REQUIRE(defaultPool.GetThreadsCount() >= 1);
+
+    const Kmplete::ThreadPool explicitPool(3);
+    REQUIRE(explicitPool.GetThreadsCount() == 3);
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("ThreadPool submit and wait", "[core][thread_pool]")
+{
+    Kmplete::ThreadPool pool(4);
+    std::atomic<int> counter = 0;
+
+    for (auto i = 0; i < 1000; i++)
+    {
+        pool.Submit([&counter]() { counter++; });
+    }
+
+    pool.WaitIdle();
+    REQUIRE(counter == 1000);
+
+    SECTION("Throwing task does not break the pool")
+    {
+        pool.Submit([]() { throw Kmplete::RuntimeError("test exception"); });
+        pool.Submit([&counter]() { counter++; });
+        pool.WaitIdle();
+        REQUIRE(counter == 1001);
+    }
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("ThreadPool parallel for", "[core][thread_pool]")
+{
+    Kmplete::ThreadPool pool(4);
+
+    SECTION("Empty range")
+    {
+        auto called = false;
+        pool.ParallelFor(0, [&called](Kmplete::UInt64) { called = true; });
+        REQUIRE_FALSE(called);
+    }
+
+    SECTION("Every index is processed exactly once")
+    {
+        Kmplete::Vector<int> hits(10000, 0);
+        pool.ParallelFor(hits.size(), [&hits](Kmplete::UInt64 index) { hits[index]++; });
+
+        auto allOnce = true;
+        for (const auto hit : hits)
+        {
+            allOnce &= hit == 1;
+        }
+        REQUIRE(allOnce);
+    }
+
+    SECTION("Single index runs on the calling thread")
+    {
+        auto threadId = std::thread::id();
+        pool.ParallelFor(1, [&threadId](Kmplete::UInt64) { threadId = std::this_thread::get_id(); });
+        REQUIRE(threadId == std::this_thread::get_id());
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
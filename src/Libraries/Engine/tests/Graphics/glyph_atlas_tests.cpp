@@ -0,0 +1,337 @@
+#include "Kmplete/Graphics/glyph_atlas.h"
+#include "Kmplete/Graphics/font.h"
+#include "Kmplete/Assets/font_asset_manager.h"
+#include "Kmplete/Assets/assets_interface.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+
+
+static bool RegionContains(const TextureRegion& region, float pageSize, const FontCharacter& character)
+{
+    const auto x = UInt32(character.uvMin.x * pageSize + 0.5f);
+    const auto y = UInt32(character.uvMin.y * pageSize + 0.5f);
+
+    return x >= region.x && y >= region.y &&
+        x + UInt32(character.size.x) <= region.x + region.width &&
+        y + UInt32(character.size.y) <= region.y + region.height;
+}
+//--------------------------------------------------------------------------
+
+//! Codepoints of all the locales supported by the engine, the same set AssetsCompiler bakes for them
+static Vector<UInt32> LocalesCodepoints()
+{
+    Vector<UInt32> codepoints;
+    for (const auto& locale : { "en_US.UTF-8", "ru_RU.UTF-8" })
+    {
+        for (const auto& range : Assets::GetLocaleCodepointRanges(locale))
+        {
+            for (auto codepoint = range.first; codepoint <= range.last; codepoint++)
+            {
+                codepoints.push_back(codepoint);
+            }
+        }
+    }
+
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    return codepoints;
+}
+//--------------------------------------------------------------------------
+
+//! Lays out the glyphs of an atlas as a baked font atlas payload, the way AssetsCompiler stores them
+static BinaryBuffer CreateBakedPayload(GlyphAtlas& glyphAtlas, const Vector<UInt32>& sortedCodepoints, UInt8 pixelSize)
+{
+    const auto pageSize = glyphAtlas.GetParameters().pageSize;
+    const auto pagesCount = glyphAtlas.GetPagesCount();
+    const auto glyphsCount = UInt32(sortedCodepoints.size());
+
+    BinaryBuffer payload(Assets::GetFontAtlasPayloadSize(pageSize, pagesCount, glyphsCount), 0);
+
+    const Assets::FontAtlasPayloadHeader header{
+        .pageSize = pageSize,
+        .pagesCount = pagesCount,
+        .glyphsCount = glyphsCount,
+        .pixelSize = pixelSize,
+        .reserved1 = 0,
+        .reserved2 = 0
+    };
+    std::memcpy(payload.data(), &header, Assets::FontAtlasPayloadHeaderStructSize);
+
+    const auto pageSizeF = float(pageSize);
+    for (UInt32 i = 0; i < glyphsCount; i++)
+    {
+        const auto& glyph = *glyphAtlas.GetGlyph(sortedCodepoints[i], pixelSize);
+        const Assets::FontAtlasGlyphEntry entry{
+            .codepoint = sortedCodepoints[i],
+            .page = glyph.page,
+            .x = UInt16(glyph.character.uvMin.x * pageSizeF + 0.5f),
+            .y = UInt16(glyph.character.uvMin.y * pageSizeF + 0.5f),
+            .width = UInt16(glyph.character.size.x),
+            .height = UInt16(glyph.character.size.y),
+            .bearingX = Int16(glyph.character.bearing.x),
+            .bearingY = Int16(glyph.character.bearing.y),
+            .advance = glyph.character.advance
+        };
+        std::memcpy(payload.data() + Assets::FontAtlasPayloadHeaderStructSize + UInt64(i) * Assets::FontAtlasGlyphEntryStructSize, &entry, Assets::FontAtlasGlyphEntryStructSize);
+    }
+
+    for (UInt32 page = 0; page < pagesCount; page++)
+    {
+        const auto pixels = glyphAtlas.GetPagePixels(page);
+        std::memcpy(payload.data() + Assets::GetFontAtlasPayloadPageOffset(pageSize, glyphsCount, page), pixels.data(), pixels.size());
+    }
+
+    return payload;
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("GlyphAtlas rasterize glyphs on demand", "[graphics][glyph_atlas][font]")
+{
+    UPtr<Assets::FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new Assets::FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    auto& font = fontAssetManager->GetAsset(Assets::FontAssetManager::DefaultFontSID).GetFont();
+
+    UPtr<GlyphAtlas> glyphAtlas;
+    REQUIRE_NOTHROW(glyphAtlas.reset(new GlyphAtlas(font, GlyphAtlas::Parameters{ .pageSize = 500, .maxPages = 4 })));
+    REQUIRE(glyphAtlas->GetParameters().pageSize == 512);
+    REQUIRE(glyphAtlas->GetGlyphsCount() == 0);
+    REQUIRE(glyphAtlas->GetPagesCount() == 0);
+
+    const auto glyph = glyphAtlas->GetGlyph(UInt32('A'), 32);
+    REQUIRE(glyph);
+    REQUIRE(glyph->page == 0);
+    REQUIRE(glyph->character.size.x > 0);
+    REQUIRE(glyph->character.size.y > 0);
+    REQUIRE(glyph->character.advance > 0);
+    REQUIRE(glyphAtlas->GetGlyphsCount() == 1);
+    REQUIRE(glyphAtlas->GetPagesCount() == 1);
+    REQUIRE(glyphAtlas->GetPagePixels(0).size() == 512 * 512);
+    REQUIRE(glyphAtlas->IsPageDirty(0));
+    REQUIRE(RegionContains(glyphAtlas->GetPageDirtyRegion(0), 512.0f, glyph->character));
+
+    // repeated requests of the same glyph do not rasterize it again
+    REQUIRE(glyphAtlas->GetGlyph(UInt32('A'), 32) == glyph);
+    REQUIRE(glyphAtlas->GetGlyphsCount() == 1);
+
+    // another size is another glyph
+    const auto biggerGlyph = glyphAtlas->GetGlyph(UInt32('A'), 48);
+    REQUIRE(biggerGlyph);
+    REQUIRE(biggerGlyph->character.size.y > glyphAtlas->GetGlyph(UInt32('A'), 32)->character.size.y);
+    REQUIRE(glyphAtlas->GetGlyphsCount() == 2);
+
+    // whitespaces have metrics only
+    const auto space = glyphAtlas->GetGlyph(UInt32(' '), 32);
+    REQUIRE(space);
+    REQUIRE(space->character.size.x == 0);
+    REQUIRE(space->character.advance > 0);
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("GlyphAtlas pack glyphs into multiple pages", "[graphics][glyph_atlas][font]")
+{
+    UPtr<Assets::FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new Assets::FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    auto& font = fontAssetManager->GetAsset(Assets::FontAssetManager::DefaultFontSID).GetFont();
+
+    UPtr<GlyphAtlas> glyphAtlas;
+    REQUIRE_NOTHROW(glyphAtlas.reset(new GlyphAtlas(font, GlyphAtlas::Parameters{ .pageSize = 256, .maxPages = 16 })));
+
+    Vector<UInt32> codepoints;
+    for (UInt32 codepoint = 0x0021; codepoint <= 0x007E; codepoint++)
+    {
+        codepoints.push_back(codepoint);
+    }
+    for (UInt32 codepoint = 0x0410; codepoint <= 0x044F; codepoint++)
+    {
+        codepoints.push_back(codepoint);
+    }
+
+    const auto availableCount = glyphAtlas->AddGlyphs(Span<const UInt32>(codepoints), 48);
+    REQUIRE(availableCount == codepoints.size());
+    REQUIRE(glyphAtlas->GetGlyphsCount() == codepoints.size());
+    REQUIRE(glyphAtlas->GetPagesCount() > 1);
+
+    // every glyph lies within its page, glyphs of the same page never overlap
+    for (UInt64 i = 0; i < codepoints.size(); i++)
+    {
+        const auto glyph = *glyphAtlas->GetGlyph(codepoints[i], 48);
+        REQUIRE(glyph.page < glyphAtlas->GetPagesCount());
+        REQUIRE(glyph.character.uvMin.x >= 0.0f);
+        REQUIRE(glyph.character.uvMin.y >= 0.0f);
+        REQUIRE(glyph.character.uvMax.x <= 1.0f);
+        REQUIRE(glyph.character.uvMax.y <= 1.0f);
+        REQUIRE(RegionContains(glyphAtlas->GetPageDirtyRegion(glyph.page), 256.0f, glyph.character));
+
+        for (UInt64 j = i + 1; j < codepoints.size(); j++)
+        {
+            const auto other = *glyphAtlas->GetGlyph(codepoints[j], 48);
+            const auto overlaps = glyph.page == other.page &&
+                glyph.character.uvMin.x < other.character.uvMax.x && other.character.uvMin.x < glyph.character.uvMax.x &&
+                glyph.character.uvMin.y < other.character.uvMax.y && other.character.uvMin.y < glyph.character.uvMax.y;
+            REQUIRE_FALSE(overlaps);
+        }
+    }
+
+    // adding the same glyphs again rasterizes nothing
+    REQUIRE(glyphAtlas->AddGlyphs(Span<const UInt32>(codepoints), 48) == codepoints.size());
+    REQUIRE(glyphAtlas->GetGlyphsCount() == codepoints.size());
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("GlyphAtlas limited pages", "[graphics][glyph_atlas][font]")
+{
+    UPtr<Assets::FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new Assets::FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    auto& font = fontAssetManager->GetAsset(Assets::FontAssetManager::DefaultFontSID).GetFont();
+
+    UPtr<GlyphAtlas> glyphAtlas;
+    REQUIRE_NOTHROW(glyphAtlas.reset(new GlyphAtlas(font, GlyphAtlas::Parameters{ .pageSize = 128, .maxPages = 1 })));
+
+    Vector<UInt32> codepoints;
+    for (UInt32 codepoint = 0x0041; codepoint <= 0x005A; codepoint++)
+    {
+        codepoints.push_back(codepoint);
+    }
+
+    const auto availableCount = glyphAtlas->AddGlyphs(Span<const UInt32>(codepoints), 48);
+    REQUIRE(availableCount > 0);
+    REQUIRE(availableCount < codepoints.size());
+    REQUIRE(glyphAtlas->GetPagesCount() == 1);
+    REQUIRE_FALSE(glyphAtlas->GetGlyph(UInt32('Z'), 48));
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("GlyphAtlas load baked glyphs", "[graphics][glyph_atlas][font]")
+{
+    UPtr<Assets::FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new Assets::FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    auto& font = fontAssetManager->GetAsset(Assets::FontAssetManager::DefaultFontSID).GetFont();
+
+    // glyphs the font can not render are left out, as AssetsCompiler does
+    GlyphAtlas sourceAtlas(font, GlyphAtlas::Parameters{ .pageSize = 512, .maxPages = 16 });
+    Vector<UInt32> codepoints;
+    for (const auto codepoint : LocalesCodepoints())
+    {
+        if (sourceAtlas.GetGlyph(codepoint, 32))
+        {
+            codepoints.push_back(codepoint);
+        }
+    }
+    REQUIRE(codepoints.size() > 100);
+
+    const auto payload = CreateBakedPayload(sourceAtlas, codepoints, 32);
+
+    GlyphAtlas glyphAtlas(font, GlyphAtlas::Parameters{ .pageSize = 128, .maxPages = 16, .sdf = false });
+    REQUIRE(glyphAtlas.LoadBaked(BinaryView(payload)));
+    REQUIRE(glyphAtlas.GetParameters().pageSize == 512);
+    REQUIRE(glyphAtlas.GetParameters().sdf);
+    REQUIRE(glyphAtlas.GetPagesCount() == sourceAtlas.GetPagesCount());
+    REQUIRE(glyphAtlas.GetGlyphsCount() == codepoints.size());
+
+    for (UInt32 page = 0; page < glyphAtlas.GetPagesCount(); page++)
+    {
+        REQUIRE(glyphAtlas.IsPageDirty(page));
+        const auto pixels = glyphAtlas.GetPagePixels(page);
+        const auto sourcePixels = sourceAtlas.GetPagePixels(page);
+        REQUIRE(std::memcmp(pixels.data(), sourcePixels.data(), pixels.size()) == 0);
+    }
+
+    // baked glyphs are found without rasterization
+    for (const auto codepoint : codepoints)
+    {
+        const auto glyph = glyphAtlas.GetGlyph(codepoint, 32);
+        const auto sourceGlyph = sourceAtlas.GetGlyph(codepoint, 32);
+        REQUIRE(glyph);
+        REQUIRE(glyph->page == sourceGlyph->page);
+        REQUIRE(glyph->character.size == sourceGlyph->character.size);
+        REQUIRE(glyph->character.bearing == sourceGlyph->character.bearing);
+        REQUIRE(glyph->character.advance == sourceGlyph->character.advance);
+        REQUIRE(glyph->character.uvMin == sourceGlyph->character.uvMin);
+        REQUIRE(glyph->character.uvMax == sourceGlyph->character.uvMax);
+    }
+    REQUIRE(glyphAtlas.GetGlyphsCount() == codepoints.size());
+
+    // baked pages are full, glyphs of other sizes go to a new page
+    REQUIRE(glyphAtlas.GetGlyph(UInt32('A'), 48));
+    REQUIRE(glyphAtlas.GetGlyph(UInt32('A'), 48)->page == sourceAtlas.GetPagesCount());
+
+    // only an empty atlas accepts baked glyphs
+    REQUIRE_FALSE(glyphAtlas.LoadBaked(BinaryView(payload)));
+
+    GlyphAtlas truncatedAtlas(font, GlyphAtlas::Parameters{});
+    REQUIRE_FALSE(truncatedAtlas.LoadBaked(BinaryView(payload).first(payload.size() - 1)));
+    REQUIRE(truncatedAtlas.GetGlyphsCount() == 0);
+    REQUIRE(truncatedAtlas.GetPagesCount() == 0);
+
+    auto outOfPageGlyphPayload = payload;
+    Assets::FontAtlasGlyphEntry entry;
+    std::memcpy(&entry, outOfPageGlyphPayload.data() + Assets::FontAtlasPayloadHeaderStructSize, Assets::FontAtlasGlyphEntryStructSize);
+    entry.page = sourceAtlas.GetPagesCount();
+    std::memcpy(outOfPageGlyphPayload.data() + Assets::FontAtlasPayloadHeaderStructSize, &entry, Assets::FontAtlasGlyphEntryStructSize);
+
+    GlyphAtlas malformedAtlas(font, GlyphAtlas::Parameters{});
+    REQUIRE_FALSE(malformedAtlas.LoadBaked(BinaryView(outOfPageGlyphPayload)));
+    REQUIRE(malformedAtlas.GetGlyphsCount() == 0);
+    REQUIRE(malformedAtlas.GetPagesCount() == 0);
+}
+//--------------------------------------------------------------------------
+
+
+// Hidden from the default run, e.g.: Kmplete_WindowApplicationTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("GlyphAtlas runtime rasterization and baked load of locales glyphs", "[.][benchmark][graphics][glyph_atlas][font]")
+{
+    UPtr<Assets::FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new Assets::FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    auto& font = fontAssetManager->GetAsset(Assets::FontAssetManager::DefaultFontSID).GetFont();
+
+    const auto parameters = GlyphAtlas::Parameters{ .pageSize = 1024, .maxPages = 8 };
+    const auto codepoints = LocalesCodepoints();
+
+    Vector<UInt32> availableCodepoints;
+    GlyphAtlas sourceAtlas(font, parameters);
+    for (const auto codepoint : codepoints)
+    {
+        if (sourceAtlas.GetGlyph(codepoint, 48))
+        {
+            availableCodepoints.push_back(codepoint);
+        }
+    }
+    const auto payload = CreateBakedPayload(sourceAtlas, availableCodepoints, 48);
+
+    BENCHMARK("Rasterize locales glyphs")
+    {
+        GlyphAtlas glyphAtlas(font, parameters);
+        return glyphAtlas.AddGlyphs(Span<const UInt32>(codepoints), 48);
+    };
+
+    BENCHMARK("Load baked locales glyphs")
+    {
+        GlyphAtlas glyphAtlas(font, parameters);
+        return glyphAtlas.LoadBaked(BinaryView(payload));
+    };
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
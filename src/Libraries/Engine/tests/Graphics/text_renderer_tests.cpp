@@ -0,0 +1,103 @@
+#include "Kmplete/Graphics/text_renderer.h"
+#include "Kmplete/Graphics/glyph_atlas.h"
+#include "Kmplete/Graphics/font.h"
+#include "Kmplete/Assets/font_asset_manager.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+
+
+TEST_CASE("TextRenderer cache layouts of unchanged strings", "[graphics][text_renderer][font]")
+{
+    UPtr<Assets::FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new Assets::FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    auto& font = fontAssetManager->GetAsset(Assets::FontAssetManager::DefaultFontSID).GetFont();
+    GlyphAtlas glyphAtlas(font, GlyphAtlas::Parameters{ .pageSize = 512, .maxPages = 4 });
+    TextRenderer textRenderer(glyphAtlas);
+
+    textRenderer.BeginFrame(Math::Size2I(800, 600));
+    textRenderer.AddText("Hello world", Math::Vec2F(10.0f, 50.0f), 32);
+    textRenderer.AddText("Hello world", Math::Vec2F(10.0f, 100.0f), 32);
+    REQUIRE(textRenderer.GetCachedLayoutsCount() == 1);
+
+    // the space has no quad
+    REQUIRE(textRenderer.GetVerticesCount() == 2 * 10 * TextRenderer::VerticesPerGlyph);
+
+    const auto glyphsCount = glyphAtlas.GetGlyphsCount();
+
+    textRenderer.BeginFrame(Math::Size2I(800, 600));
+    textRenderer.AddText("Hello world", Math::Vec2F(10.0f, 50.0f), 32);
+    REQUIRE(textRenderer.GetCachedLayoutsCount() == 1);
+    REQUIRE(textRenderer.GetVerticesCount() == 10 * TextRenderer::VerticesPerGlyph);
+    REQUIRE(glyphAtlas.GetGlyphsCount() == glyphsCount);
+
+    // another size is another layout
+    textRenderer.AddText("Hello world", Math::Vec2F(10.0f, 50.0f), 48);
+    REQUIRE(textRenderer.GetCachedLayoutsCount() == 2);
+
+    // UTF-8 strings are decoded into codepoints
+    textRenderer.AddText("\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82", Math::Vec2F(10.0f, 150.0f), 32);
+    REQUIRE(textRenderer.GetCachedLayoutsCount() == 3);
+    REQUIRE(glyphAtlas.GetGlyph(0x041F, 32));
+
+    for (UInt64 i = 0; i < TextRenderer::DefaultLayoutLifetimeFrames * 2; i++)
+    {
+        textRenderer.BeginFrame(Math::Size2I(800, 600));
+    }
+    REQUIRE(textRenderer.GetCachedLayoutsCount() == 0);
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("TextRenderer batch vertices by atlas page", "[graphics][text_renderer][font]")
+{
+    UPtr<Assets::FontAssetManager> fontAssetManager;
+    REQUIRE_NOTHROW(fontAssetManager.reset(new Assets::FontAssetManager()));
+    REQUIRE(fontAssetManager);
+
+    auto& font = fontAssetManager->GetAsset(Assets::FontAssetManager::DefaultFontSID).GetFont();
+    GlyphAtlas glyphAtlas(font, GlyphAtlas::Parameters{ .pageSize = 128, .maxPages = 16 });
+    TextRenderer textRenderer(glyphAtlas);
+
+    textRenderer.BeginFrame(Math::Size2I(1024, 768));
+    textRenderer.AddText("ABCDEFGHIJKLM", Math::Vec2F(20.0f, 100.0f), 48);
+    textRenderer.AddText("abcdefghijklm\nNOPQRSTUVWXYZ", Math::Vec2F(20.0f, 200.0f), 48);
+    textRenderer.AddText("ABCDEFGHIJKLM", Math::Vec2F(20.0f, 400.0f), 48);
+    REQUIRE(glyphAtlas.GetPagesCount() > 1);
+
+    Vector<FontCharacterVertex> tooSmall(textRenderer.GetVerticesCount() - 1);
+    REQUIRE(textRenderer.WriteVertices(Span<FontCharacterVertex>(tooSmall)) == 0);
+    REQUIRE(textRenderer.GetBatches().empty());
+
+    Vector<FontCharacterVertex> vertices(textRenderer.GetVerticesCount());
+    REQUIRE(textRenderer.WriteVertices(Span<FontCharacterVertex>(vertices)) == vertices.size());
+
+    // one batch per page, every page appears once and batches cover all the vertices contiguously
+    const auto& batches = textRenderer.GetBatches();
+    REQUIRE(batches.size() == glyphAtlas.GetPagesCount());
+
+    UInt32 nextVertex = 0;
+    for (UInt64 i = 0; i < batches.size(); i++)
+    {
+        REQUIRE(batches[i].firstVertex == nextVertex);
+        REQUIRE(batches[i].vertexCount % TextRenderer::VerticesPerGlyph == 0);
+        REQUIRE((i == 0 || batches[i - 1].page < batches[i].page));
+        nextVertex += batches[i].vertexCount;
+    }
+    REQUIRE(nextVertex == vertices.size());
+
+    for (const auto& vertex : vertices)
+    {
+        REQUIRE(vertex.position.x >= -1.0f);
+        REQUIRE(vertex.position.x <= 1.0f);
+        REQUIRE(vertex.position.y >= -1.0f);
+        REQUIRE(vertex.position.y <= 1.0f);
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
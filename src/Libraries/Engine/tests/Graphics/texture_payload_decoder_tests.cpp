@@ -0,0 +1,205 @@
+#include "Kmplete/Graphics/texture_payload_decoder.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+
+
+static BinaryBuffer CreateTexturePayload(Assets::TexturePayloadFormat format, UInt32 width, UInt32 height, UInt32 mipLevels, const BinaryBuffer& block)
+{
+    BinaryBuffer payload(Assets::GetTexturePayloadSize(format, width, height, mipLevels), 0);
+
+    const Assets::TexturePayloadHeader header{
+        .format = static_cast<UByte>(format),
+        .mipLevels = static_cast<UByte>(mipLevels),
+        .reserved = 0,
+        .width = width,
+        .height = height
+    };
+    std::memcpy(payload.data(), &header, Assets::TexturePayloadHeaderStructSize);
+
+    for (UInt32 mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+    {
+        auto* destination = payload.data() + Assets::GetTexturePayloadMipLevelOffset(format, width, height, mipLevel);
+        const auto levelSize = Assets::GetTexturePayloadMipLevelSize(format, width, height, mipLevel);
+        for (UInt64 offset = 0; offset < levelSize; offset += block.size())
+        {
+            std::memcpy(destination + offset, block.data(), block.size());
+        }
+    }
+
+    return payload;
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("DecodeTextureBlock BC1", "[graphics][texture][decoder]")
+{
+    Array<UByte, TextureBlockPixelsCount * 4> pixels{};
+
+    SECTION("four colors block")
+    {
+        // color0 - pure red, color1 - pure blue, pixel 0 uses color1, pixel 1 uses 2/3 red + 1/3 blue
+        const BinaryBuffer block = { 0x00, 0xF8, 0x1F, 0x00, 0x09, 0x00, 0x00, 0x00 };
+        REQUIRE(DecodeTextureBlock(Assets::TexturePayloadFormat::BC1, block.data(), pixels.data()));
+
+        REQUIRE(pixels[0] == 0);
+        REQUIRE(pixels[2] == 255);
+        REQUIRE(pixels[3] == 255);
+
+        REQUIRE(pixels[4] == 170);
+        REQUIRE(pixels[6] == 85);
+
+        for (UInt32 pixel = 2; pixel < TextureBlockPixelsCount; pixel++)
+        {
+            REQUIRE(pixels[pixel * 4 + 0] == 255);
+            REQUIRE(pixels[pixel * 4 + 1] == 0);
+            REQUIRE(pixels[pixel * 4 + 2] == 0);
+            REQUIRE(pixels[pixel * 4 + 3] == 255);
+        }
+    }
+
+    SECTION("three colors block with transparency")
+    {
+        // color0 <= color1, so index 3 stands for transparent black
+        const BinaryBuffer block = { 0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF };
+        REQUIRE(DecodeTextureBlock(Assets::TexturePayloadFormat::BC1, block.data(), pixels.data()));
+
+        for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+        {
+            REQUIRE(pixels[pixel * 4 + 0] == 0);
+            REQUIRE(pixels[pixel * 4 + 3] == 0);
+        }
+    }
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("DecodeTextureBlock BC4 and BC5", "[graphics][texture][decoder]")
+{
+    Array<UByte, TextureBlockPixelsCount * 4> pixels{};
+
+    // eight values mode: pixel 1 uses value1, pixel 2 uses 6/7 value0 + 1/7 value1
+    const BinaryBuffer block = { 0xFF, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    REQUIRE(DecodeTextureBlock(Assets::TexturePayloadFormat::BC4, block.data(), pixels.data()));
+    REQUIRE(pixels[0] == 255);
+    REQUIRE(pixels[1] == 0);
+    REQUIRE(pixels[2] == 219);
+    REQUIRE(pixels[3] == 255);
+
+    // six values mode keeps explicit 0 and 255
+    const BinaryBuffer sixValuesBlock = { 0x00, 0xFF, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    REQUIRE(DecodeTextureBlock(Assets::TexturePayloadFormat::BC4, sixValuesBlock.data(), pixels.data()));
+    REQUIRE(pixels[0] == 0);
+    REQUIRE(pixels[1] == 0);
+
+    BinaryBuffer twoChannelsBlock(block);
+    twoChannelsBlock.insert(twoChannelsBlock.end(), { 0x40, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 });
+    REQUIRE(DecodeTextureBlock(Assets::TexturePayloadFormat::BC5, twoChannelsBlock.data(), pixels.data()));
+    REQUIRE(pixels[0] == 255);
+    REQUIRE(pixels[1] == 0x40);
+    REQUIRE(pixels[2] == 0);
+    REQUIRE(pixels[3] == 0x40);
+    REQUIRE(pixels[4] == 219);
+    REQUIRE(pixels[5] == 0x40);
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("DecodeTextureBlock BC7", "[graphics][texture][decoder]")
+{
+    Array<UByte, TextureBlockPixelsCount * 4> pixels{};
+
+    SECTION("mode 6 block")
+    {
+        BinaryBuffer block(16, 0);
+        UInt32 position = 0;
+        const auto write = [&](UInt32 value, UInt32 bitsCount) {
+            for (UInt32 bit = 0; bit < bitsCount; bit++, position++)
+            {
+                block[position / 8] |= UByte(((value >> bit) & 1) << (position % 8));
+            }
+        };
+
+        write(0x40, 7);
+        for (UInt32 channel = 0; channel < 4; channel++)
+        {
+            write(0x7F, 7);
+            write(0x00, 7);
+        }
+        write(1, 1);
+        write(0, 1);
+        write(0, 3);
+        write(15, 4);
+
+        REQUIRE(DecodeTextureBlock(Assets::TexturePayloadFormat::BC7, block.data(), pixels.data()));
+        for (UInt32 channel = 0; channel < 4; channel++)
+        {
+            REQUIRE(pixels[channel] == 255);
+            REQUIRE(pixels[4 + channel] == 0);
+            REQUIRE(pixels[8 + channel] == 255);
+        }
+    }
+
+    SECTION("other modes are rejected")
+    {
+        BinaryBuffer block(16, 0);
+        block[0] = 0x01;
+        REQUIRE_FALSE(DecodeTextureBlock(Assets::TexturePayloadFormat::BC7, block.data(), pixels.data()));
+    }
+
+    SECTION("uncompressed formats are rejected")
+    {
+        BinaryBuffer block(16, 0);
+        REQUIRE_FALSE(DecodeTextureBlock(Assets::TexturePayloadFormat::RGBA8, block.data(), pixels.data()));
+    }
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("DecompressTexturePayload", "[graphics][texture][decoder]")
+{
+    SECTION("partial blocks and mip levels")
+    {
+        const auto payload = CreateTexturePayload(Assets::TexturePayloadFormat::BC4, 6, 6, 2, { 200, 200, 0, 0, 0, 0, 0, 0 });
+        const auto result = DecompressTexturePayload(payload);
+
+        Assets::TexturePayloadHeader header{};
+        REQUIRE(Assets::ReadTexturePayloadHeader(result, header));
+        REQUIRE(header.format == static_cast<UByte>(Assets::TexturePayloadFormat::R8));
+        REQUIRE(header.mipLevels == 2);
+        REQUIRE(header.width == 6);
+        REQUIRE(header.height == 6);
+        REQUIRE(result.size() == Assets::GetTexturePayloadSize(Assets::TexturePayloadFormat::R8, 6, 6, 2));
+
+        for (UInt32 mipLevel = 0; mipLevel < 2; mipLevel++)
+        {
+            const auto* level = result.data() + Assets::GetTexturePayloadMipLevelOffset(Assets::TexturePayloadFormat::R8, 6, 6, mipLevel);
+            const auto levelSize = Assets::GetTexturePayloadMipLevelSize(Assets::TexturePayloadFormat::R8, 6, 6, mipLevel);
+            for (UInt64 index = 0; index < levelSize; index++)
+            {
+                REQUIRE(level[index] == 200);
+            }
+        }
+    }
+
+    SECTION("uncompressed payload is returned as is")
+    {
+        const auto payload = CreateTexturePayload(Assets::TexturePayloadFormat::RGBA8, 4, 4, 1, { 1, 2, 3, 4 });
+        REQUIRE(DecompressTexturePayload(payload) == payload);
+    }
+
+    SECTION("malformed payloads")
+    {
+        REQUIRE(DecompressTexturePayload(BinaryBuffer(4, 0)).empty());
+
+        auto truncated = CreateTexturePayload(Assets::TexturePayloadFormat::BC1, 8, 8, 1, { 0, 0, 0, 0, 0, 0, 0, 0 });
+        truncated.pop_back();
+        REQUIRE(DecompressTexturePayload(truncated).empty());
+
+        auto unsupportedMode = CreateTexturePayload(Assets::TexturePayloadFormat::BC7, 4, 4, 1, BinaryBuffer(16, 0));
+        REQUIRE(DecompressTexturePayload(unsupportedMode).empty());
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_descriptor_set_manager.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_descriptor_writer.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
+#include "Kmplete/Window/window_backend.h"
+#include "Kmplete/Window/window.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+using namespace VKBits;
+
+
+static constexpr auto UniformBufferLayoutSID = "DescriptorWriterTestsLayout"_sid;
+static constexpr auto UniformBufferTemplateSID = "DescriptorWriterTestsTemplate"_sid;
+static constexpr auto DescriptorsPoolSID = "DescriptorWriterTestsPool"_sid;
+static constexpr UInt32 UniformBufferBinding = 0;
+
+
+static Vector<VkDescriptorSet> AllocateUniformBufferSets(VulkanLogicalDevice& logicalDevice, UInt32 setsCount)
+{
+    auto& descriptorSetManager = logicalDevice.GetDescriptorSetManager();
+
+    const auto layoutBinding = VkDescriptorSetLayoutBinding{ UniformBufferBinding, VK_DescriptorType_UniformBuffer, 1, VK_ShaderStage_AllGraphics };
+    const auto layout = descriptorSetManager.AddDescriptorSetLayout(UniformBufferLayoutSID, { layoutBinding });
+    descriptorSetManager.AllocateAuxDescriptorPool(DescriptorsPoolSID, setsCount, { { VK_DescriptorType_UniformBuffer, setsCount } });
+
+    const Vector<VkDescriptorSetLayout> layouts(setsCount, layout);
+    auto allocateInfo = VKUtils::InitVkDescriptorSetAllocateInfo();
+    allocateInfo.descriptorPool = descriptorSetManager.GetAuxDescriptorPool(DescriptorsPoolSID);
+    allocateInfo.descriptorSetCount = setsCount;
+    allocateInfo.pSetLayouts = layouts.data();
+
+    Vector<VkDescriptorSet> descriptorSets(setsCount, VK_NULL_HANDLE);
+    if (vkAllocateDescriptorSets(logicalDevice.GetVkDevice(), &allocateInfo, descriptorSets.data()) != VK_SUCCESS)
+    {
+        return {};
+    }
+
+    return descriptorSets;
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("VulkanDescriptorWriter batched writes and update templates", "[graphics][vulkan][descriptor]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& logicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice();
+    auto& descriptorSetManager = logicalDevice.GetDescriptorSetManager();
+
+    constexpr UInt32 SetsCount = 8;
+    const auto descriptorSets = AllocateUniformBufferSets(logicalDevice, SetsCount);
+    REQUIRE(descriptorSets.size() == SetsCount);
+
+    auto uniformBuffer = logicalDevice.GetBufferManager().CreateUniformBuffer({ 0, VK_Memory_HostVisible | VK_Memory_HostCoherent, 256 });
+    const auto vkBuffer = uniformBuffer.GetVkBuffer();
+
+    SECTION("Writes to many sets are flushed at once")
+    {
+        auto writer = descriptorSetManager.CreateDescriptorWriter();
+        REQUIRE(writer.IsEmpty());
+
+        for (const auto descriptorSet : descriptorSets)
+        {
+            REQUIRE(writer.WriteBuffer(descriptorSet, UniformBufferBinding, VK_DescriptorType_UniformBuffer, vkBuffer, 64));
+        }
+        REQUIRE(writer.GetWritesCount() == SetsCount);
+
+        REQUIRE(writer.Flush() == SetsCount);
+        REQUIRE(writer.IsEmpty());
+        REQUIRE(writer.Flush() == 0);
+    }
+
+    SECTION("Invalid writes are rejected")
+    {
+        auto writer = descriptorSetManager.CreateDescriptorWriter();
+        REQUIRE_FALSE(writer.WriteBuffer(VK_NULL_HANDLE, UniformBufferBinding, VK_DescriptorType_UniformBuffer, vkBuffer, 64));
+        REQUIRE_FALSE(writer.WriteBuffer(descriptorSets[0], UniformBufferBinding, VK_DescriptorType_UniformBuffer, VK_NULL_HANDLE, 64));
+        REQUIRE_FALSE(writer.WriteBuffer(descriptorSets[0], UniformBufferBinding, VK_DescriptorType_SampledImage, vkBuffer, 64));
+        REQUIRE_FALSE(writer.WriteImage(descriptorSets[0], UniformBufferBinding, VK_DescriptorType_UniformBuffer, VK_NULL_HANDLE, VK_NULL_HANDLE));
+        REQUIRE_FALSE(writer.WriteImage(descriptorSets[0], UniformBufferBinding, VK_DescriptorType_CombinedImageSampler, VK_NULL_HANDLE, VK_NULL_HANDLE));
+        REQUIRE(writer.IsEmpty());
+    }
+
+    SECTION("Update template writes a set from user data")
+    {
+        REQUIRE(descriptorSetManager.GetDescriptorUpdateTemplate(UniformBufferTemplateSID) == VK_NULL_HANDLE);
+        REQUIRE(descriptorSetManager.AddDescriptorUpdateTemplate(UniformBufferTemplateSID, UniformBufferLayoutSID, {
+            { UniformBufferBinding, 0, 1, VK_DescriptorType_UniformBuffer, 0, sizeof(VkDescriptorBufferInfo) }
+        }));
+        REQUIRE(descriptorSetManager.GetDescriptorUpdateTemplate(UniformBufferTemplateSID) != VK_NULL_HANDLE);
+
+        const auto bufferInfo = VkDescriptorBufferInfo{ vkBuffer, 0, 64 };
+        for (const auto descriptorSet : descriptorSets)
+        {
+            REQUIRE(descriptorSetManager.UpdateDescriptorSetWithTemplate(descriptorSet, UniformBufferTemplateSID, &bufferInfo));
+        }
+
+        REQUIRE_FALSE(descriptorSetManager.UpdateDescriptorSetWithTemplate(descriptorSets[0], "UnknownTemplate"_sid, &bufferInfo));
+        REQUIRE_FALSE(descriptorSetManager.UpdateDescriptorSetWithTemplate(descriptorSets[0], UniformBufferTemplateSID, nullptr));
+        REQUIRE_FALSE(descriptorSetManager.AddDescriptorUpdateTemplate("OtherTemplate"_sid, "UnknownLayout"_sid, {
+            { UniformBufferBinding, 0, 1, VK_DescriptorType_UniformBuffer, 0, sizeof(VkDescriptorBufferInfo) }
+        }));
+    }
+}
+//--------------------------------------------------------------------------
+
+// Hidden from the default run, e.g.: Kmplete_WindowApplicationTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("VulkanDescriptorWriter 10k descriptor writes", "[.][benchmark][graphics][vulkan][descriptor]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& logicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice();
+    auto& descriptorSetManager = logicalDevice.GetDescriptorSetManager();
+
+    constexpr UInt32 DescriptorsCount = 10000;
+    const auto descriptorSets = AllocateUniformBufferSets(logicalDevice, DescriptorsCount);
+    REQUIRE(descriptorSets.size() == DescriptorsCount);
+    REQUIRE(descriptorSetManager.AddDescriptorUpdateTemplate(UniformBufferTemplateSID, UniformBufferLayoutSID, {
+        { UniformBufferBinding, 0, 1, VK_DescriptorType_UniformBuffer, 0, sizeof(VkDescriptorBufferInfo) }
+    }));
+
+    auto uniformBuffer = logicalDevice.GetBufferManager().CreateUniformBuffer({ 0, VK_Memory_HostVisible | VK_Memory_HostCoherent, 256 });
+    const auto vkBuffer = uniformBuffer.GetVkBuffer();
+    auto writer = descriptorSetManager.CreateDescriptorWriter();
+    writer.Reserve(DescriptorsCount);
+
+    BENCHMARK("Single write per call")
+    {
+        for (const auto descriptorSet : descriptorSets)
+        {
+            descriptorSetManager.SetUniformBufferDescriptor(descriptorSet, vkBuffer, 64, 0, UniformBufferBinding);
+        }
+        return DescriptorsCount;
+    };
+
+    BENCHMARK("Batched writer")
+    {
+        for (const auto descriptorSet : descriptorSets)
+        {
+            writer.WriteBuffer(descriptorSet, UniformBufferBinding, VK_DescriptorType_UniformBuffer, vkBuffer, 64);
+        }
+        return writer.Flush();
+    };
+
+    BENCHMARK("Update template")
+    {
+        const auto bufferInfo = VkDescriptorBufferInfo{ vkBuffer, 0, 64 };
+        for (const auto descriptorSet : descriptorSets)
+        {
+            descriptorSetManager.UpdateDescriptorSetWithTemplate(descriptorSet, UniformBufferTemplateSID, &bufferInfo);
+        }
+        return DescriptorsCount;
+    };
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_allocator.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Window/window_backend.h"
+#include "Kmplete/Window/window.h"
+#include "Kmplete/Base/pointers.h"
+#include "Kmplete/Base/named_bool.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+using namespace VKBits;
+
+
+static UInt64 SumSubAllocations(const Vector<VulkanMemoryAllocator::HeapStatistics>& statistics)
+{
+    UInt64 count = 0ULL;
+    for (const auto& heapStatistics : statistics)
+    {
+        count += heapStatistics.subAllocationsCount;
+    }
+
+    return count;
+}
+//--------------------------------------------------------------------------
+
+static UInt64 SumDedicatedAllocations(const Vector<VulkanMemoryAllocator::HeapStatistics>& statistics)
+{
+    UInt64 count = 0ULL;
+    for (const auto& heapStatistics : statistics)
+    {
+        count += heapStatistics.dedicatedAllocationsCount;
+    }
+
+    return count;
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("VulkanMemoryAllocator buffers sub-allocation", "[graphics][vulkan][memory]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& logicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice();
+    auto& bufferManager = logicalDevice.GetBufferManager();
+    auto& metricsManager = logicalDevice.GetMetricsManager();
+
+    const auto subAllocationsBefore = SumSubAllocations(metricsManager.QueryMetrics().allocatorHeapStatistics);
+    const auto dedicatedAllocationsBefore = SumDedicatedAllocations(metricsManager.QueryMetrics().allocatorHeapStatistics);
+
+    {
+        Vector<VulkanBuffer> buffers;
+        for (const auto strategy : { VulkanMemoryStrategy::Linear, VulkanMemoryStrategy::Buddy, VulkanMemoryStrategy::FreeList })
+        {
+            for (auto i = 0; i < 16; i++)
+            {
+                buffers.push_back(bufferManager.CreateUniformBuffer({ 0, VK_Memory_HostVisible, 256, strategy }));
+            }
+        }
+        buffers.push_back(bufferManager.CreateUniformBuffer({ 0, VK_Memory_HostVisible, 256, VulkanMemoryStrategy::Dedicated }));
+
+        const auto& statistics = metricsManager.QueryMetrics().allocatorHeapStatistics;
+        REQUIRE(SumSubAllocations(statistics) == subAllocationsBefore + 48);
+        REQUIRE(SumDedicatedAllocations(statistics) == dedicatedAllocationsBefore + 1);
+
+        for (auto& buffer : buffers)
+        {
+            UInt32 value = 42;
+            REQUIRE(buffer.Map() == VK_SUCCESS);
+            REQUIRE(buffer.GetMappedPtr());
+            REQUIRE_NOTHROW(buffer.CopyToMappedMemory(0, &value, sizeof(value)));
+            REQUIRE(buffer.Unmap("flush"_true) == VK_SUCCESS);
+        }
+    }
+
+    const auto& statistics = metricsManager.QueryMetrics().allocatorHeapStatistics;
+    REQUIRE(SumSubAllocations(statistics) == subAllocationsBefore);
+    REQUIRE(SumDedicatedAllocations(statistics) == dedicatedAllocationsBefore);
+}
+//--------------------------------------------------------------------------
+
+
+// Hidden from the default run, e.g.: Kmplete_WindowApplicationTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("VulkanMemoryAllocator create/destroy 100k buffers", "[.][benchmark][graphics][vulkan][memory]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& bufferManager = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice().GetBufferManager();
+    constexpr auto BuffersCount = 100000;
+
+    BENCHMARK("Dedicated")
+    {
+        for (auto i = 0; i < BuffersCount; i++)
+        {
+            auto buffer = bufferManager.CreateUniformBuffer({ 0, VK_Memory_HostVisible, 256, VulkanMemoryStrategy::Dedicated });
+        }
+    };
+
+    BENCHMARK("Linear")
+    {
+        for (auto i = 0; i < BuffersCount; i++)
+        {
+            auto buffer = bufferManager.CreateUniformBuffer({ 0, VK_Memory_HostVisible, 256, VulkanMemoryStrategy::Linear });
+        }
+    };
+
+    BENCHMARK("Buddy")
+    {
+        for (auto i = 0; i < BuffersCount; i++)
+        {
+            auto buffer = bufferManager.CreateUniformBuffer({ 0, VK_Memory_HostVisible, 256, VulkanMemoryStrategy::Buddy });
+        }
+    };
+
+    BENCHMARK("FreeList")
+    {
+        for (auto i = 0; i < BuffersCount; i++)
+        {
+            auto buffer = bufferManager.CreateUniformBuffer({ 0, VK_Memory_HostVisible, 256, VulkanMemoryStrategy::FreeList });
+        }
+    };
+
+    BENCHMARK("FreeList - all alive")
+    {
+        Vector<VulkanBuffer> buffers;
+        buffers.reserve(BuffersCount);
+        for (auto i = 0; i < BuffersCount; i++)
+        {
+            buffers.push_back(bufferManager.CreateUniformBuffer({ 0, VK_Memory_HostVisible, 256, VulkanMemoryStrategy::FreeList }));
+        }
+
+        return buffers.size();
+    };
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
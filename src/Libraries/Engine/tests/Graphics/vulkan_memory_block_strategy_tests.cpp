@@ -0,0 +1,188 @@
+#include "Kmplete/Graphics/Vulkan/Memory/vulkan_memory_block_strategy.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+
+
+TEST_CASE("VulkanMemoryBlockStrategy creation", "[graphics][vulkan][memory]")
+{
+    REQUIRE(VulkanMemoryBlockStrategy::Create(VulkanMemoryStrategy::Dedicated, 1024) == nullptr);
+
+    auto linear = VulkanMemoryBlockStrategy::Create(VulkanMemoryStrategy::Linear, 1024);
+    REQUIRE(linear);
+    REQUIRE(linear->GetBlockSize() == 1024);
+    REQUIRE(linear->IsEmpty());
+
+    auto buddy = VulkanMemoryBlockStrategy::Create(VulkanMemoryStrategy::Buddy, 1024);
+    REQUIRE(buddy);
+    REQUIRE(buddy->GetBlockSize() == 1024);
+    REQUIRE(buddy->IsEmpty());
+
+    auto freeList = VulkanMemoryBlockStrategy::Create(VulkanMemoryStrategy::FreeList, 1024);
+    REQUIRE(freeList);
+    REQUIRE(freeList->GetBlockSize() == 1024);
+    REQUIRE(freeList->IsEmpty());
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("VulkanMemoryLinearStrategy allocation", "[graphics][vulkan][memory]")
+{
+    VulkanMemoryLinearStrategy strategy(1024);
+
+    const auto first = strategy.Allocate(100, 1);
+    REQUIRE(first);
+    REQUIRE(first.value() == 0);
+
+    const auto second = strategy.Allocate(100, 256);
+    REQUIRE(second);
+    REQUIRE(second.value() == 256);
+    REQUIRE(strategy.GetAllocationsCount() == 2);
+    REQUIRE(strategy.GetUsedSize() == 200);
+
+    REQUIRE_FALSE(strategy.Allocate(1024, 1));
+    REQUIRE_FALSE(strategy.Allocate(0, 1));
+
+    SECTION("Freeing the last allocation rolls the head back")
+    {
+        REQUIRE(strategy.Free(second.value()));
+
+        const auto third = strategy.Allocate(100, 128);
+        REQUIRE(third);
+        REQUIRE(third.value() == 128);
+    }
+
+    SECTION("Freeing every allocation resets the block")
+    {
+        REQUIRE(strategy.Free(first.value()));
+        REQUIRE_FALSE(strategy.IsEmpty());
+        REQUIRE(strategy.Free(second.value()));
+        REQUIRE(strategy.IsEmpty());
+        REQUIRE(strategy.GetUsedSize() == 0);
+
+        const auto whole = strategy.Allocate(1024, 1);
+        REQUIRE(whole);
+        REQUIRE(whole.value() == 0);
+    }
+
+    SECTION("Freeing unknown offset fails")
+    {
+        REQUIRE_FALSE(strategy.Free(13));
+        REQUIRE(strategy.GetAllocationsCount() == 2);
+    }
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("VulkanMemoryBuddyStrategy allocation", "[graphics][vulkan][memory]")
+{
+    constexpr auto blockSize = VulkanMemoryBuddyStrategy::MinAllocationSize * 16;
+    VulkanMemoryBuddyStrategy strategy(blockSize);
+
+    const auto small = strategy.Allocate(1, 1);
+    REQUIRE(small);
+    REQUIRE(small.value() == 0);
+    REQUIRE(strategy.GetUsedSize() == VulkanMemoryBuddyStrategy::MinAllocationSize);
+
+    const auto medium = strategy.Allocate(VulkanMemoryBuddyStrategy::MinAllocationSize + 1, 1);
+    REQUIRE(medium);
+    REQUIRE(medium.value() % (VulkanMemoryBuddyStrategy::MinAllocationSize * 2) == 0);
+
+    const auto aligned = strategy.Allocate(16, 1024);
+    REQUIRE(aligned);
+    REQUIRE(aligned.value() % 1024 == 0);
+
+    REQUIRE_FALSE(strategy.Allocate(blockSize, 1));
+    REQUIRE_FALSE(strategy.Allocate(blockSize * 2, 1));
+    REQUIRE(strategy.GetAllocationsCount() == 3);
+
+    REQUIRE(strategy.Free(small.value()));
+    REQUIRE(strategy.Free(medium.value()));
+    REQUIRE(strategy.Free(aligned.value()));
+    REQUIRE_FALSE(strategy.Free(aligned.value()));
+    REQUIRE(strategy.IsEmpty());
+    REQUIRE(strategy.GetUsedSize() == 0);
+
+    // every buddy must have been merged back into a single block
+    const auto whole = strategy.Allocate(blockSize, 1);
+    REQUIRE(whole);
+    REQUIRE(whole.value() == 0);
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("VulkanMemoryBuddyStrategy exhaustion", "[graphics][vulkan][memory]")
+{
+    constexpr auto minSize = VulkanMemoryBuddyStrategy::MinAllocationSize;
+    VulkanMemoryBuddyStrategy strategy(minSize * 8);
+
+    Vector<VkDeviceSize> offsets;
+    for (auto i = 0; i < 8; i++)
+    {
+        const auto offset = strategy.Allocate(minSize, 1);
+        REQUIRE(offset);
+        offsets.push_back(offset.value());
+    }
+
+    REQUIRE_FALSE(strategy.Allocate(1, 1));
+    REQUIRE(strategy.GetUsedSize() == minSize * 8);
+
+    for (auto offset : offsets)
+    {
+        REQUIRE(strategy.Free(offset));
+    }
+
+    REQUIRE(strategy.Allocate(minSize * 8, 1));
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("VulkanMemoryFreeListStrategy allocation", "[graphics][vulkan][memory]")
+{
+    VulkanMemoryFreeListStrategy strategy(1024);
+    REQUIRE(strategy.GetFreeRangesCount() == 1);
+
+    const auto first = strategy.Allocate(100, 1);
+    const auto second = strategy.Allocate(100, 64);
+    const auto third = strategy.Allocate(100, 1);
+    REQUIRE((first && second && third));
+    REQUIRE(first.value() == 0);
+    REQUIRE(second.value() == 128);
+    REQUIRE(third.value() == 228);
+    REQUIRE(strategy.GetUsedSize() == 328);
+
+    REQUIRE_FALSE(strategy.Allocate(1024, 1));
+    REQUIRE_FALSE(strategy.Allocate(0, 1));
+
+    SECTION("Freed ranges are coalesced")
+    {
+        REQUIRE(strategy.Free(second.value()));
+        REQUIRE(strategy.GetFreeRangesCount() == 2);
+        REQUIRE(strategy.Free(first.value()));
+        REQUIRE(strategy.GetFreeRangesCount() == 2);
+        REQUIRE(strategy.Free(third.value()));
+        REQUIRE(strategy.GetFreeRangesCount() == 1);
+        REQUIRE(strategy.IsEmpty());
+
+        const auto whole = strategy.Allocate(1024, 1);
+        REQUIRE(whole);
+        REQUIRE(whole.value() == 0);
+    }
+
+    SECTION("Best fitting range is reused")
+    {
+        REQUIRE(strategy.Free(second.value()));
+
+        const auto reused = strategy.Allocate(128, 1);
+        REQUIRE(reused);
+        REQUIRE(reused.value() == 100);
+        REQUIRE(strategy.GetFreeRangesCount() == 1);
+    }
+
+    SECTION("Freeing unknown offset fails")
+    {
+        REQUIRE_FALSE(strategy.Free(1));
+        REQUIRE(strategy.GetAllocationsCount() == 3);
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
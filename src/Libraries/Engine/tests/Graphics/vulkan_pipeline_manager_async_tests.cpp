@@ -0,0 +1,264 @@
+#include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_renderer.h"
+#include "Kmplete/Graphics/Vulkan/Pipeline/vulkan_pipeline_manager.h"
+#include "Kmplete/Graphics/Vulkan/Shader/vulkan_shader_manager.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Graphics/Vulkan/Utils/presets.h"
+#include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
+#include "Kmplete/Window/window_backend.h"
+#include "Kmplete/Window/window.h"
+#include "Kmplete/Filesystem/filesystem.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+using namespace VKBits;
+
+
+static constexpr auto PipelineLayoutSID = "PipelineManagerAsyncTestsLayout"_sid;
+static constexpr auto VertexShaderSID = "PipelineManagerAsyncTestsVertex"_sid;
+static constexpr auto FragmentShaderSID = "PipelineManagerAsyncTestsFragment"_sid;
+static constexpr auto FragmentShaderCopySID = "PipelineManagerAsyncTestsFragmentCopy"_sid;
+static constexpr auto PipelineCacheFilename = "vulkan_pipeline_manager_async_tests_cache.bin";
+
+static constexpr auto VertexShaderSource = R"(
+#version 450
+
+void main()
+{
+    const vec2 positions[3] = vec2[](vec2(0.0, -0.5), vec2(0.5, 0.5), vec2(-0.5, 0.5));
+    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+}
+)";
+
+static constexpr auto FragmentShaderSource = R"(
+#version 450
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    outColor = vec4(1.0);
+}
+)";
+
+
+static void FillPipelineParameters(VulkanGraphicsPipelineParameters& parameters, VulkanLogicalDevice& logicalDevice, const VulkanContext& context)
+{
+    auto& shaderManager = logicalDevice.GetShaderManager();
+    shaderManager.AddShaderModules({
+        { VertexShaderSID, String(VertexShaderSource), ShaderSourceType::SourceCode, ShaderCompiler::ShaderType::Vertex },
+        { FragmentShaderSID, String(FragmentShaderSource), ShaderSourceType::SourceCode, ShaderCompiler::ShaderType::Fragment }
+    });
+
+    parameters.AddColorAttachmentInfo(context.surfaceFormatLinear.format, VKPresets::ColorBlendAttachmentState_NoBlend);
+    parameters.AddShaderStages(shaderManager.GetShaderStages({
+        { VertexShaderSID, VK_ShaderStage_Vertex, "main" },
+        { FragmentShaderSID, VK_ShaderStage_Fragment, "main" }
+    }));
+    parameters.AddDynamicStates({ VK_Dynamic_Viewport, VK_Dynamic_Scissor });
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("VulkanPipelineManager asynchronous pipelines compilation", "[graphics][vulkan][pipeline]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& physicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice());
+    auto& logicalDevice = physicalDevice.GetLogicalDevice();
+    auto& pipelineManager = logicalDevice.GetPipelineManager();
+    REQUIRE(pipelineManager.AddPipelineLayout(PipelineLayoutSID, {}));
+
+    auto parameters = VulkanGraphicsPipelineParameters();
+    FillPipelineParameters(parameters, logicalDevice, physicalDevice.GetVulkanContext());
+    const Vector<StringID> pipelinesSids = { "AsyncPipeline0"_sid, "AsyncPipeline1"_sid, "AsyncPipeline2"_sid, "AsyncPipeline3"_sid,
+                                             "AsyncPipeline4"_sid, "AsyncPipeline5"_sid, "AsyncPipeline6"_sid, "AsyncPipeline7"_sid };
+
+    Vector<VulkanPipelineManager::GraphicsPipelineCompileInfo> compileInfos;
+    for (const auto sid : pipelinesSids)
+    {
+        compileInfos.push_back({ sid, PipelineLayoutSID, parameters });
+    }
+
+    REQUIRE(pipelineManager.CompileGraphicsPipelinesAsync(compileInfos) == UInt32(pipelinesSids.size()));
+    REQUIRE(pipelineManager.GetPendingPipelinesCount() == UInt32(pipelinesSids.size()));
+    REQUIRE_FALSE(pipelineManager.AddGraphicsPipeline(pipelinesSids[0], PipelineLayoutSID, parameters));
+
+    SECTION("Compiled pipelines are swapped in")
+    {
+        REQUIRE(pipelineManager.WaitCompiledPipelines() == UInt32(pipelinesSids.size()));
+        REQUIRE(pipelineManager.GetPendingPipelinesCount() == 0);
+
+        // the pipelines share the same state, so they are compiled once
+        const auto vkPipeline = pipelineManager.GetGraphicsPipeline(pipelinesSids[0]).value().get().GetVkPipeline();
+        for (const auto sid : pipelinesSids)
+        {
+            REQUIRE(pipelineManager.IsGraphicsPipelineReady(sid));
+            REQUIRE(pipelineManager.GetGraphicsPipeline(sid).has_value());
+            REQUIRE(pipelineManager.GetGraphicsPipeline(sid).value().get().GetVkPipeline() == vkPipeline);
+        }
+    }
+
+    SECTION("Compiled or pending pipelines are not submitted again")
+    {
+        REQUIRE(pipelineManager.CompileGraphicsPipelinesAsync(compileInfos) == 0);
+        REQUIRE(pipelineManager.WaitCompiledPipelines() == UInt32(pipelinesSids.size()));
+        REQUIRE(pipelineManager.CompileGraphicsPipelinesAsync(compileInfos) == 0);
+        REQUIRE(pipelineManager.ProcessCompiledPipelines() == 0);
+    }
+
+    SECTION("Pipelines with unknown layout are rejected")
+    {
+        REQUIRE(pipelineManager.CompileGraphicsPipelinesAsync({ { "AsyncPipelineUnknownLayout"_sid, "UnknownLayout"_sid, parameters } }) == 0);
+        REQUIRE(pipelineManager.WaitCompiledPipelines() == UInt32(pipelinesSids.size()));
+        REQUIRE_FALSE(pipelineManager.IsGraphicsPipelineReady("AsyncPipelineUnknownLayout"_sid));
+    }
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("VulkanPipelineManager deduplication of identical pipeline states", "[graphics][vulkan][pipeline]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& physicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice());
+    auto& logicalDevice = physicalDevice.GetLogicalDevice();
+    auto& pipelineManager = logicalDevice.GetPipelineManager();
+    REQUIRE(pipelineManager.AddPipelineLayout(PipelineLayoutSID, {}));
+    REQUIRE(pipelineManager.AddPipelineLayout("PipelineManagerAsyncTestsPushLayout"_sid, {}, { { VK_ShaderStage_Vertex, 0, 16 } }));
+
+    auto parameters = VulkanGraphicsPipelineParameters();
+    FillPipelineParameters(parameters, logicalDevice, physicalDevice.GetVulkanContext());
+    auto sameParameters = VulkanGraphicsPipelineParameters::CopyFrom(parameters, VulkanGraphicsPipelineParameters::All);
+    auto lineParameters = VulkanGraphicsPipelineParameters::CopyFrom(parameters, VulkanGraphicsPipelineParameters::All);
+    lineParameters.SetPolygonMode(VK_Polygon_Line);
+
+    REQUIRE(parameters.GetHash() == parameters.GetHash());
+    REQUIRE(sameParameters.GetHash() == parameters.GetHash());
+    REQUIRE(lineParameters.GetHash() != parameters.GetHash());
+    REQUIRE(sameParameters.GetStateKey() == parameters.GetStateKey());
+    REQUIRE(lineParameters.GetStateKey() != parameters.GetStateKey());
+
+    // same SPIR-V code in another shader module is the same pipeline state
+    auto& shaderManager = logicalDevice.GetShaderManager();
+    REQUIRE(shaderManager.AddShaderModules({
+        { FragmentShaderCopySID, String(FragmentShaderSource), ShaderSourceType::SourceCode, ShaderCompiler::ShaderType::Fragment }
+    }));
+    const auto& fragmentModule = shaderManager.GetShaderModule(FragmentShaderSID).value().get();
+    const auto& fragmentCopyModule = shaderManager.GetShaderModule(FragmentShaderCopySID).value().get();
+    REQUIRE(fragmentModule.GetShaderStageCreateInfo(VK_ShaderStage_Fragment).module != fragmentCopyModule.GetShaderStageCreateInfo(VK_ShaderStage_Fragment).module);
+    REQUIRE(fragmentModule.GetCodeHash() == fragmentCopyModule.GetCodeHash());
+
+    auto copyShaderParameters = VulkanGraphicsPipelineParameters::CopyFrom(parameters, VulkanGraphicsPipelineParameters::All & ~VulkanGraphicsPipelineParameters::ShaderStages);
+    copyShaderParameters.AddShaderStages(shaderManager.GetShaderStages({
+        { VertexShaderSID, VK_ShaderStage_Vertex, "main" },
+        { FragmentShaderCopySID, VK_ShaderStage_Fragment, "main" }
+    }));
+    REQUIRE(copyShaderParameters.GetStateKey() == parameters.GetStateKey());
+
+    REQUIRE(pipelineManager.AddGraphicsPipeline("FillPipeline"_sid, PipelineLayoutSID, parameters));
+    REQUIRE(pipelineManager.AddGraphicsPipeline("SameFillPipeline"_sid, PipelineLayoutSID, sameParameters));
+    REQUIRE(pipelineManager.AddGraphicsPipeline("LinePipeline"_sid, PipelineLayoutSID, lineParameters));
+    REQUIRE(pipelineManager.AddGraphicsPipeline("PushFillPipeline"_sid, "PipelineManagerAsyncTestsPushLayout"_sid, parameters));
+    REQUIRE(pipelineManager.AddGraphicsPipeline("CopyShaderFillPipeline"_sid, PipelineLayoutSID, copyShaderParameters));
+
+    const auto getVkPipeline = [&](StringID sid) { return pipelineManager.GetGraphicsPipeline(sid).value().get().GetVkPipeline(); };
+    REQUIRE(getVkPipeline("FillPipeline"_sid) == getVkPipeline("SameFillPipeline"_sid));
+    REQUIRE(getVkPipeline("FillPipeline"_sid) == getVkPipeline("CopyShaderFillPipeline"_sid));
+    REQUIRE(getVkPipeline("FillPipeline"_sid) != getVkPipeline("LinePipeline"_sid));
+    REQUIRE(getVkPipeline("FillPipeline"_sid) != getVkPipeline("PushFillPipeline"_sid));
+
+    // the manager's layout given by handle is still shared, a caller-owned layout is not
+    REQUIRE(pipelineManager.AddGraphicsPipeline("HandleFillPipeline"_sid, pipelineManager.GetPipelineLayout(PipelineLayoutSID), parameters));
+    REQUIRE(getVkPipeline("FillPipeline"_sid) == getVkPipeline("HandleFillPipeline"_sid));
+
+    const auto layoutCreateInfo = VKUtils::InitVkPipelineLayoutCreateInfo();
+    VkPipelineLayout externalLayout = VK_NULL_HANDLE;
+    REQUIRE(vkCreatePipelineLayout(logicalDevice.GetVkDevice(), &layoutCreateInfo, nullptr, &externalLayout) == VK_SUCCESS);
+    REQUIRE(pipelineManager.AddGraphicsPipeline("ExternalFillPipeline"_sid, externalLayout, parameters));
+    REQUIRE(pipelineManager.AddGraphicsPipeline("SameExternalFillPipeline"_sid, externalLayout, parameters));
+    REQUIRE(getVkPipeline("ExternalFillPipeline"_sid) != getVkPipeline("SameExternalFillPipeline"_sid));
+    REQUIRE(getVkPipeline("ExternalFillPipeline"_sid) != getVkPipeline("FillPipeline"_sid));
+    vkDestroyPipelineLayout(logicalDevice.GetVkDevice(), externalLayout, nullptr);
+
+    REQUIRE(pipelineManager.CompileGraphicsPipelinesAsync({ { "AsyncSameFillPipeline"_sid, PipelineLayoutSID, parameters } }) == 1);
+    REQUIRE(pipelineManager.IsGraphicsPipelineReady("AsyncSameFillPipeline"_sid));
+    REQUIRE(pipelineManager.GetPendingPipelinesCount() == 0);
+
+    const auto& renderer = logicalDevice.GetRenderer();
+    REQUIRE(backend->StartFrame(0.0f));
+    REQUIRE(renderer.BindGraphicsPipeline("FillPipeline"_sid));
+    REQUIRE(renderer.BindGraphicsPipeline("SameFillPipeline"_sid));
+    REQUIRE(renderer.BindGraphicsPipeline("LinePipeline"_sid));
+    renderer.InvalidateBoundPipeline();
+    REQUIRE(renderer.BindGraphicsPipeline("LinePipeline"_sid));
+    REQUIRE_FALSE(renderer.BindGraphicsPipeline("UnknownPipeline"_sid));
+    backend->EndFrame();
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("VulkanPipelineManager device-wide pipeline cache", "[graphics][vulkan][pipeline]")
+{
+    const auto cachePath = Filesystem::GetCurrentFilepath().append(PipelineCacheFilename);
+    auto temporaryCachePath = cachePath;
+    temporaryCachePath += ".tmp";
+    if (Filesystem::FilepathExists(cachePath))
+    {
+        REQUIRE(Filesystem::RemoveFile(cachePath));
+    }
+
+    {
+        auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+        auto& mainWindow = windowBackend->CreateMainWindow();
+        const auto backend = GraphicsBackend::Create(mainWindow);
+        REQUIRE(backend);
+
+        auto& physicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice());
+        auto& logicalDevice = physicalDevice.GetLogicalDevice();
+        auto& pipelineManager = logicalDevice.GetPipelineManager();
+        REQUIRE(pipelineManager.GetDevicePipelineCache() != VK_NULL_HANDLE);
+        REQUIRE_FALSE(pipelineManager.SaveDevicePipelineCacheAsync());
+        REQUIRE_FALSE(pipelineManager.SetDevicePipelineCachePath(Filepath()));
+
+        REQUIRE(pipelineManager.SetDevicePipelineCachePath(cachePath));
+        REQUIRE(pipelineManager.GetDevicePipelineCache() != VK_NULL_HANDLE);
+        REQUIRE(pipelineManager.AddPipelineLayout(PipelineLayoutSID, {}));
+
+        auto parameters = VulkanGraphicsPipelineParameters();
+        FillPipelineParameters(parameters, logicalDevice, physicalDevice.GetVulkanContext());
+        REQUIRE(pipelineManager.CompileGraphicsPipelinesAsync({ { "CachedPipeline"_sid, PipelineLayoutSID, parameters } }) == 1);
+        REQUIRE(pipelineManager.WaitCompiledPipelines() == 1);
+    }
+
+    REQUIRE(Filesystem::FilepathExists(cachePath));
+    REQUIRE_FALSE(Filesystem::FilepathExists(temporaryCachePath));
+    REQUIRE_FALSE(Filesystem::ReadFileAsBinary(cachePath).empty());
+
+    {
+        auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+        auto& mainWindow = windowBackend->CreateMainWindow();
+        const auto backend = GraphicsBackend::Create(mainWindow);
+        REQUIRE(backend);
+
+        // the per-pipeline cache file is merged into the in-memory device cache and is not written back
+        auto& pipelineManager = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice().GetPipelineManager();
+        REQUIRE(pipelineManager.AddPipelineCache("LegacyPipeline"_sid, cachePath));
+        REQUIRE(pipelineManager.AddPipelineCache("LegacyPipeline"_sid, cachePath));
+    }
+
+    REQUIRE(Filesystem::RemoveFile(cachePath));
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
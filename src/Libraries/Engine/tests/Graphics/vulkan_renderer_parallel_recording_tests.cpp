@@ -0,0 +1,83 @@
+#include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_renderer.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Graphics/Vulkan/Utils/initializers.h"
+#include "Kmplete/Window/window_backend.h"
+#include "Kmplete/Window/window.h"
+#include "Kmplete/Core/thread_pool.h"
+#include "Kmplete/Base/named_bool.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+using namespace VKBits;
+
+
+TEST_CASE("VulkanRenderer parallel recording of secondary command buffers", "[graphics][vulkan][renderer]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& physicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice());
+    auto& logicalDevice = physicalDevice.GetLogicalDevice();
+    const auto& renderer = logicalDevice.GetRenderer();
+    const auto extent = logicalDevice.GetCurrentExtent();
+    const auto drawArea = VkRect2D{ VkOffset2D{ .x = 0, .y = 0 }, extent };
+    const auto viewport = VkViewport{ 0.0f, 0.0f, float(extent.width), float(extent.height), 0.0f, 1.0f };
+
+    constexpr UInt32 ThreadsCount = 4;
+    ThreadPool threadPool(ThreadsCount);
+
+    for (auto frame = 0; frame < 2 * NumConcurrentFrames; frame++)
+    {
+        REQUIRE(backend->StartFrame(0.0f));
+        const auto primaryCommandBuffer = renderer.GetCurrentCommandBuffer();
+
+        auto colorAttachmentInfo = VKUtils::InitVkRenderingAttachmentInfo();
+        colorAttachmentInfo.imageView = logicalDevice.GetSwapchain().GetCurrentImageViewLinear();
+        colorAttachmentInfo.imageLayout = VK_ImageLayout_AttachmentOptimal;
+        colorAttachmentInfo.loadOp = VK_AttachmentLoad_Clear;
+        colorAttachmentInfo.storeOp = VK_AttachmentStore_Store;
+
+        renderer.BeginParallelRecording(ThreadsCount, { .colorAttachmentFormats = { physicalDevice.GetVulkanContext().surfaceFormatLinear.format } });
+        REQUIRE(renderer.GetParallelRecordingCount() == ThreadsCount);
+
+        renderer.BeginRendering(drawArea, { colorAttachmentInfo }, "secondary contents"_true);
+
+        Vector<VkCommandBuffer> recordedCommandBuffers(ThreadsCount, VK_NULL_HANDLE);
+        threadPool.ParallelFor(ThreadsCount, [&](UInt64 index) {
+            renderer.BeginSecondaryRecording(UInt32(index));
+            recordedCommandBuffers[index] = renderer.GetCurrentCommandBuffer();
+            renderer.SetViewport(viewport);
+            renderer.SetScissor(drawArea);
+            renderer.EndSecondaryRecording();
+        });
+
+        REQUIRE(renderer.GetCurrentCommandBuffer() == primaryCommandBuffer);
+        for (UInt32 i = 0; i < ThreadsCount; i++)
+        {
+            REQUIRE(recordedCommandBuffers[i] != VK_NULL_HANDLE);
+            REQUIRE(recordedCommandBuffers[i] != primaryCommandBuffer);
+            for (UInt32 j = i + 1; j < ThreadsCount; j++)
+            {
+                REQUIRE(recordedCommandBuffers[i] != recordedCommandBuffers[j]);
+            }
+        }
+
+        renderer.ExecuteSecondaries();
+        REQUIRE(renderer.GetParallelRecordingCount() == 0);
+        renderer.EndRendering();
+
+        backend->EndFrame();
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
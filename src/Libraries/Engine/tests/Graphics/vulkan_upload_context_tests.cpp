@@ -0,0 +1,131 @@
+#include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_logical_device.h"
+#include "Kmplete/Graphics/Vulkan/Buffer/vulkan_upload_context.h"
+#include "Kmplete/Graphics/Vulkan/Utils/bits_aliases.h"
+#include "Kmplete/Graphics/image.h"
+#include "Kmplete/Assets/assets_interface.h"
+#include "Kmplete/Window/window_backend.h"
+#include "Kmplete/Window/window.h"
+#include "Kmplete/Base/pointers.h"
+
+#include <catch2/catch_test_macros.hpp>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+
+
+using namespace Kmplete;
+using namespace Kmplete::Graphics;
+using namespace VKBits;
+
+
+TEST_CASE("VulkanUploadContext batched buffer uploads", "[graphics][vulkan][upload]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& logicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice();
+    auto& bufferManager = logicalDevice.GetBufferManager();
+    auto& uploadContext = logicalDevice.GetUploadContext();
+
+    constexpr auto ValuesCount = 1024;
+    Vector<UInt32> values(ValuesCount);
+    for (auto i = 0; i < ValuesCount; i++)
+    {
+        values[i] = UInt32(i * 3);
+    }
+
+    const auto submittedBefore = uploadContext.GetSubmittedBatchesCount();
+    auto destination = bufferManager.CreateBuffer({ VK_BufferUsage_TransferDst, VK_Memory_HostVisible | VK_Memory_HostCoherent, sizeof(UInt32) * ValuesCount * 2, VulkanMemoryStrategy::FreeList });
+
+    SECTION("Uploads recorded in a row share a single batch")
+    {
+        const auto firstTicket = uploadContext.UploadBuffer(destination, values.data(), sizeof(UInt32) * ValuesCount);
+        const auto secondTicket = uploadContext.UploadBuffer(destination, values.data(), sizeof(UInt32) * ValuesCount, sizeof(UInt32) * ValuesCount);
+        REQUIRE(firstTicket.IsValid());
+        REQUIRE(firstTicket.value == secondTicket.value);
+        REQUIRE_FALSE(uploadContext.IsComplete(secondTicket));
+
+        uploadContext.Wait(secondTicket);
+        REQUIRE(uploadContext.IsComplete(firstTicket));
+        REQUIRE(uploadContext.GetSubmittedBatchesCount() == submittedBefore + 1);
+
+        REQUIRE(destination.Map() == VK_SUCCESS);
+        const auto* mapped = static_cast<const UInt32*>(destination.GetMappedPtr());
+        REQUIRE(std::memcmp(mapped, values.data(), sizeof(UInt32) * ValuesCount) == 0);
+        REQUIRE(std::memcmp(mapped + ValuesCount, values.data(), sizeof(UInt32) * ValuesCount) == 0);
+        REQUIRE(destination.Unmap() == VK_SUCCESS);
+    }
+
+    SECTION("Flush submits pending uploads without waiting")
+    {
+        const auto ticket = uploadContext.UploadBuffer(destination, values.data(), sizeof(UInt32) * ValuesCount);
+        const auto flushedTicket = uploadContext.Flush();
+        REQUIRE(flushedTicket.value == ticket.value);
+        REQUIRE(uploadContext.GetSubmittedBatchesCount() == submittedBefore + 1);
+
+        uploadContext.Wait(flushedTicket);
+        REQUIRE(uploadContext.IsComplete(ticket));
+    }
+
+    SECTION("Upload larger than the staging ring uses temporary staging buffer")
+    {
+        const auto bigSize = uploadContext.GetRingSize() + 1024;
+        auto bigDestination = bufferManager.CreateBuffer({ VK_BufferUsage_TransferDst, VK_Memory_DeviceLocal, bigSize, VulkanMemoryStrategy::Dedicated });
+
+        const auto ticket = uploadContext.UploadBuffer(bigDestination, nullptr, bigSize);
+        REQUIRE(ticket.IsValid());
+
+        uploadContext.Wait(ticket);
+        REQUIRE(uploadContext.IsComplete(ticket));
+    }
+
+    SECTION("Empty ticket is always complete")
+    {
+        REQUIRE(uploadContext.IsComplete(VulkanUploadTicket{}));
+        REQUIRE_NOTHROW(uploadContext.Wait(VulkanUploadTicket{}));
+    }
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("VulkanUploadContext texture destroyed before its upload batch is submitted", "[graphics][vulkan][upload]")
+{
+    auto windowBackend = Kmplete::WindowBackend::Create(GraphicsBackendType::Vulkan);
+    auto& mainWindow = windowBackend->CreateMainWindow();
+    const auto backend = GraphicsBackend::Create(mainWindow);
+    REQUIRE(backend);
+
+    auto& logicalDevice = dynamic_cast<VulkanPhysicalDevice&>(backend->GetPhysicalDevice()).GetLogicalDevice();
+    auto& uploadContext = logicalDevice.GetUploadContext();
+
+    constexpr auto PixelsCount = 16 * 16;
+    const Vector<UByte> pixels(PixelsCount * 4, UByte(0x7F));
+    const auto image = Image(pixels.data(), int(pixels.size()), Math::Size2I(16, 16), ImageChannels::RGBAlpha);
+
+    const auto submittedBefore = uploadContext.GetSubmittedBatchesCount();
+    auto texture = UPtr<VulkanTexture>(logicalDevice.CreateTexture(image, Assets::TextureSubTypeMaskBits::NoMipmap));
+    REQUIRE(texture);
+
+    SECTION("Created texture")
+    {
+        REQUIRE(uploadContext.GetSubmittedBatchesCount() == submittedBefore);
+        texture.reset();
+        REQUIRE(uploadContext.GetSubmittedBatchesCount() == submittedBefore + 1);
+        REQUIRE(uploadContext.IsComplete(VulkanUploadTicket{ submittedBefore + 1 }));
+    }
+
+    SECTION("Updated texture")
+    {
+        uploadContext.Wait(uploadContext.Flush());
+        REQUIRE(logicalDevice.UpdateTexture(*texture.get(), BinaryView(pixels.data(), 8 * 8 * 4), TextureRegion{ .x = 4, .y = 4, .width = 8, .height = 8 }));
+
+        texture.reset();
+        REQUIRE(uploadContext.GetSubmittedBatchesCount() == submittedBefore + 2);
+        REQUIRE(uploadContext.IsComplete(VulkanUploadTicket{ submittedBefore + 2 }));
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
@@ -1037,6 +1037,7 @@ namespace Kmplete
             vulkanRenderer.BeginRendering(drawArea, { colorAttachmentInfo }, depthStencilAttachmentInfo);
             vulkanImGuiImpl->SetCommandBuffer(commandBuffer);
             vulkanImGuiImpl->Render();
+            vulkanRenderer.InvalidateBoundPipeline();
             vulkanRenderer.EndRendering();
         }
         else
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Profile/profiler_fwd.h"
+#include "Kmplete/Log/log_class_macro.h"
+
+
+namespace Kmplete
+{
+    namespace Filesystem
+    {
+        //! Read-only memory mapping of a whole file. The file stays mapped for the lifetime of the object,
+        //! pages are brought into memory by the OS only when they are actually accessed, so taking a view
+        //! of a small region of a huge file touches only the pages of that region. Empty files are valid
+        //! and produce an empty mapping
+        class KMP_API MappedFile
+        {
+            KMP_LOG_CLASSNAME(MappedFile)
+            KMP_PROFILE_CONSTRUCTOR_DECLARE()
+            KMP_DISABLE_COPY_MOVE(MappedFile)
+
+        public:
+            explicit MappedFile(const Filepath& filepath);
+            ~MappedFile();
+
+            KMP_NODISCARD const Filepath& GetFilepath() const noexcept;
+            KMP_NODISCARD const UByte* GetData() const noexcept;
+            KMP_NODISCARD UInt64 GetSize() const noexcept;
+
+            KMP_NODISCARD BinaryView GetView() const noexcept;
+            KMP_NODISCARD BinaryView GetView(UInt64 offset, UInt64 size) const noexcept;
+
+        private:
+            void _Map();
+            void _Unmap() noexcept;
+
+        private:
+            const Filepath _filepath;
+            const UByte* _data;
+            UInt64 _size;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "Kmplete/Filesystem/mapped_file.h"
+#include "Kmplete/Base/platform.h"
+#include "Kmplete/Base/exception.h"
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Profile/profiler.h"
+
+#if defined (KMP_PLATFORM_WINDOWS)
+    #include <Windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+namespace Kmplete
+{
+    namespace Filesystem
+    {
+        MappedFile::MappedFile(const Filepath& filepath)
+            : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+              _filepath(filepath)
+            , _data(nullptr)
+            , _size(0)
+        {
+            _Map();
+
+            KMP_PROFILE_CONSTRUCTOR_END()
+        }
+        //--------------------------------------------------------------------------
+
+        MappedFile::~MappedFile() KMP_PROFILING(ProfileLevelMinor)
+        {
+            _Unmap();
+        }}
+        //--------------------------------------------------------------------------
+
+        const Filepath& MappedFile::GetFilepath() const noexcept
+        {
+            return _filepath;
+        }
+        //--------------------------------------------------------------------------
+
+        const UByte* MappedFile::GetData() const noexcept
+        {
+            return _data;
+        }
+        //--------------------------------------------------------------------------
+
+        UInt64 MappedFile::GetSize() const noexcept
+        {
+            return _size;
+        }
+        //--------------------------------------------------------------------------
+
+        BinaryView MappedFile::GetView() const noexcept
+        {
+            return BinaryView(_data, static_cast<size_t>(_size));
+        }
+        //--------------------------------------------------------------------------
+
+        BinaryView MappedFile::GetView(UInt64 offset, UInt64 size) const noexcept
+        {
+            if (offset > _size || size > _size - offset)
+            {
+                return BinaryView();
+            }
+
+            return BinaryView(_data + offset, static_cast<size_t>(size));
+        }
+        //--------------------------------------------------------------------------
+
+#if defined (KMP_PLATFORM_WINDOWS)
+        void MappedFile::_Map() KMP_PROFILING(ProfileLevelMinor)
+        {
+            const auto fileHandle = CreateFileW(_filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (fileHandle == INVALID_HANDLE_VALUE)
+            {
+                KMP_LOG_ERROR("cannot open '{}' for mapping", _filepath);
+                throw RuntimeError("MappedFile: failed to open file");
+            }
+
+            LARGE_INTEGER fileSize{};
+            if (not GetFileSizeEx(fileHandle, &fileSize))
+            {
+                CloseHandle(fileHandle);
+                KMP_LOG_ERROR("cannot get size of '{}'", _filepath);
+                throw RuntimeError("MappedFile: failed to get file size");
+            }
+
+            _size = static_cast<UInt64>(fileSize.QuadPart);
+            if (_size == 0)
+            {
+                CloseHandle(fileHandle);
+                return;
+            }
+
+            const auto mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            CloseHandle(fileHandle);
+            if (mappingHandle == nullptr)
+            {
+                KMP_LOG_ERROR("cannot create mapping of '{}'", _filepath);
+                throw RuntimeError("MappedFile: failed to create file mapping");
+            }
+
+            // The view keeps the mapping object alive, so both handles can be released right away
+            _data = static_cast<const UByte*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mappingHandle);
+            if (_data == nullptr)
+            {
+                KMP_LOG_ERROR("cannot map view of '{}'", _filepath);
+                throw RuntimeError("MappedFile: failed to map file view");
+            }
+        }}
+        //--------------------------------------------------------------------------
+
+        void MappedFile::_Unmap() noexcept
+        {
+            if (_data)
+            {
+                UnmapViewOfFile(_data);
+                _data = nullptr;
+            }
+
+            _size = 0;
+        }
+        //--------------------------------------------------------------------------
+#else
+        void MappedFile::_Map() KMP_PROFILING(ProfileLevelMinor)
+        {
+            const auto fileDescriptor = open(_filepath.c_str(), O_RDONLY);
+            if (fileDescriptor == -1)
+            {
+                KMP_LOG_ERROR("cannot open '{}' for mapping", _filepath);
+                throw RuntimeError("MappedFile: failed to open file");
+            }
+
+            struct stat fileStat{};
+            if (fstat(fileDescriptor, &fileStat) == -1)
+            {
+                close(fileDescriptor);
+                KMP_LOG_ERROR("cannot get size of '{}'", _filepath);
+                throw RuntimeError("MappedFile: failed to get file size");
+            }
+
+            _size = static_cast<UInt64>(fileStat.st_size);
+            if (_size == 0)
+            {
+                close(fileDescriptor);
+                return;
+            }
+
+            // The mapping holds its own reference to the file, so the descriptor can be closed right away
+            const auto mapped = mmap(nullptr, static_cast<size_t>(_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            close(fileDescriptor);
+            if (mapped == MAP_FAILED)
+            {
+                _size = 0;
+                KMP_LOG_ERROR("cannot map '{}'", _filepath);
+                throw RuntimeError("MappedFile: failed to map file");
+            }
+
+            _data = static_cast<const UByte*>(mapped);
+        }}
+        //--------------------------------------------------------------------------
+
+        void MappedFile::_Unmap() noexcept
+        {
+            if (_data)
+            {
+                munmap(const_cast<UByte*>(_data), static_cast<size_t>(_size));
+                _data = nullptr;
+            }
+
+            _size = 0;
+        }
+        //--------------------------------------------------------------------------
+#endif
+    }
+}
\ No newline at end of file
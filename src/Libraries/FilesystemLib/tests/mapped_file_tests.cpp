@@ -0,0 +1,63 @@
+#include "Kmplete/Filesystem/mapped_file.h"
+#include "Kmplete/Filesystem/filesystem.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+
+TEST_CASE("Filesystem MappedFile", "[core][filesystem][mapped_file]")
+{
+    SECTION("MappedFile non-existing file")
+    {
+        const auto path = Kmplete::Filesystem::GetCurrentFilepath() / "this_file_do_not_exist.bin";
+        REQUIRE_FALSE(Kmplete::Filesystem::FilepathExists(path));
+
+        REQUIRE_THROWS(Kmplete::Filesystem::MappedFile(path));
+    }
+
+    SECTION("MappedFile empty file")
+    {
+        const auto path = Kmplete::Filesystem::GetCurrentFilepath() / "this_file_is_empty_mapped.bin";
+        REQUIRE(Kmplete::Filesystem::CreateFile(path));
+
+        {
+            const Kmplete::Filesystem::MappedFile mappedFile(path);
+            REQUIRE(mappedFile.GetSize() == 0);
+            REQUIRE(mappedFile.GetView().empty());
+            REQUIRE(mappedFile.GetView(0, 1).empty());
+        }
+
+        REQUIRE(Kmplete::Filesystem::RemoveFile(path));
+    }
+
+    SECTION("MappedFile regular binary file")
+    {
+        const auto path = Kmplete::Filesystem::GetCurrentFilepath() / "this_file_contains_mapped_binary.bin";
+        const auto contentToWrite = Kmplete::BinaryBuffer{ 10, 11, 12, 13, 14, 15, 16, 17 };
+        REQUIRE(Kmplete::Filesystem::CreateFile(path));
+        REQUIRE(Kmplete::Filesystem::WriteFile(path, contentToWrite, false));
+
+        {
+            const Kmplete::Filesystem::MappedFile mappedFile(path);
+            REQUIRE(mappedFile.GetFilepath() == path);
+            REQUIRE(mappedFile.GetSize() == contentToWrite.size());
+            REQUIRE(mappedFile.GetData() != nullptr);
+
+            const auto fullView = mappedFile.GetView();
+            REQUIRE(Kmplete::BinaryBuffer(fullView.begin(), fullView.end()) == contentToWrite);
+
+            const auto entryView = mappedFile.GetView(2, 3);
+            REQUIRE(entryView.size() == 3);
+            REQUIRE(entryView.data() == mappedFile.GetData() + 2);
+            REQUIRE(entryView[0] == 12);
+            REQUIRE(entryView[2] == 14);
+
+            REQUIRE(mappedFile.GetView(8, 0).empty());
+            REQUIRE(mappedFile.GetView(6, 3).empty());
+            REQUIRE(mappedFile.GetView(9, 0).empty());
+            REQUIRE(mappedFile.GetView(1, Kmplete::UInt64(-1)).empty());
+        }
+
+        REQUIRE(Kmplete::Filesystem::RemoveFile(path));
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
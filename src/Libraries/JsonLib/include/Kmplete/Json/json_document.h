@@ -5,6 +5,7 @@
 #include "Kmplete/Base/types_aliases.h"
 #include "Kmplete/Json/json_reader.h"
 #include "Kmplete/Json/json_writer.h"
+#include "Kmplete/Json/json_view.h"
 #include "Kmplete/Profile/profiler.h"
 #include "Kmplete/Log/log_class_macro.h"
 
@@ -14,11 +15,30 @@
 
 namespace Kmplete
 {
+    //! Way JsonDocument reads a file
+    enum class JsonLoadMode
+    {
+        //! File is parsed from a stream, every string is copied into the document's allocator
+        Stream,
+
+        //! File is read at once into a buffer owned by the document and parsed in-situ, strings of
+        //! the document point directly into that buffer. Intended for large read-mostly files.
+        //! Reloading reuses the buffer and the allocator of the previous in-situ load when no other document
+        //! references them, the previous content is dropped first in that case, so a failed reload leaves the document empty
+        InSitu
+    };
+    //--------------------------------------------------------------------------
+
+
     //! Wrapper for a JSON document that uses RapidJSON as backend, responsible for storing state of
     //! a document, reading/writing operations, merging several json nodes, saving/loading to/from a file.
-    //! Reading and writing operations are delegated to separate JsonReader/JsonWriter objects
+    //! Reading and writing operations are delegated to separate JsonReader/JsonWriter objects.
+    //! Children can be copied (GetChildren/AddChildDocument with a const reference), referenced in place
+    //! via JsonView, or moved between documents (ExtractChildren/AddChildDocument with an rvalue reference),
+    //! in the latter case the memory of the source document stays alive while moved values reference it
     //! @see JsonReader
     //! @see JsonWriter
+    //! @see JsonView
     class KMP_API JsonDocument
     {
         KMP_LOG_CLASSNAME(JsonDocument)
@@ -28,14 +48,14 @@ namespace Kmplete
     public:
         JsonDocument();
         explicit JsonDocument(rapidjson::Document&& document);
-        explicit JsonDocument(const Filepath& filepath);
+        explicit JsonDocument(const Filepath& filepath, JsonLoadMode loadMode = JsonLoadMode::Stream);
         ~JsonDocument() = default;
 
         void SetFilepath(const Filepath& filepath) noexcept;
         KMP_NODISCARD const Filepath& GetFilepath() const noexcept;
 
-        KMP_NODISCARD bool Load(const Filepath& filepath);
-        KMP_NODISCARD bool Load();
+        KMP_NODISCARD bool Load(const Filepath& filepath, JsonLoadMode loadMode = JsonLoadMode::Stream);
+        KMP_NODISCARD bool Load(JsonLoadMode loadMode = JsonLoadMode::Stream);
         KMP_NODISCARD bool Save(const Filepath& filepath, bool pretty = true);
         KMP_NODISCARD bool Save(bool pretty = true);
         KMP_NODISCARD String ToString(bool pretty = true);
@@ -44,7 +64,12 @@ namespace Kmplete
         KMP_NODISCARD String ErrorDescription() const noexcept;
 
         bool AddChildDocument(const String& name, const JsonDocument& child, bool overwrite = true);
+        bool AddChildDocument(const String& name, JsonDocument&& child, bool overwrite = true);
         KMP_NODISCARD Vector<Pair<String, Ptr<JsonDocument>>> GetChildren(bool onlyObjects = true) const;
+        KMP_NODISCARD Vector<Pair<String, Ptr<JsonDocument>>> ExtractChildren(bool onlyObjects = true);
+        KMP_NODISCARD JsonView GetView() const noexcept;
+
+        KMP_NODISCARD static bool SaveComposite(const Filepath& filepath, const Vector<Pair<String, JsonView>>& children, bool pretty = true);
 
 
         bool StartSetObject(const char* objectName);
@@ -95,10 +120,30 @@ namespace Kmplete
         KMP_NODISCARD String GetString(const char* name, const String& defaultValue = "");
 
     private:
+        //! Memory of another document that values moved into this document may still reference:
+        //! the allocator copy shares (and keeps alive) chunks of the source allocator
+        struct ExternalMemory
+        {
+            rapidjson::MemoryPoolAllocator<> allocator;
+            Ptr<Vector<char>> inSituBuffer;
+        };
+
+    private:
+        JsonDocument(rapidjson::Value&& value, Vector<ExternalMemory>&& externalMemory);
+
+        KMP_NODISCARD Vector<ExternalMemory> _GetReferencedMemory() const;
+        void _AddExternalMemory(Vector<ExternalMemory>&& externalMemory);
+
+        KMP_NODISCARD bool _LoadStream();
+        KMP_NODISCARD bool _LoadInSitu();
+        void _ResetReaderWriter();
         KMP_NODISCARD bool _SaveToFile(const rapidjson::StringBuffer& buffer);
 
     private:
         Filepath _filepath;
+        Ptr<Vector<char>> _inSituBuffer;
+        UPtr<rapidjson::MemoryPoolAllocator<>> _inSituAllocator;
+        Vector<ExternalMemory> _externalMemory;
         rapidjson::Document _document;
         bool _error;
         UPtr<JsonReader> _reader;
@@ -2,23 +2,44 @@
 
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/nullability.h"
 #include "Kmplete/Log/log_class_macro.h"
 
+#include <rapidjson/document.h>
+
 
 namespace Kmplete
 {
     //! Utility struct to keep track which node is currently used for
-    //! reading or writing
+    //! reading or writing. Every entry caches a pointer to its value, so descending
+    //! and ascending don't resolve the path again, the path string itself is built
+    //! only on demand (e.g. for log messages)
     struct KMP_API JsonScope
     {
         KMP_LOG_CLASSNAME(JsonScope)
 
     public:
-        void Push(const String& entry);
+        //! Single step of the path, either a member of an object (name is set)
+        //! or an element of an array (index is set)
+        struct Entry
+        {
+            Nullable<rapidjson::Value*> value = nullptr;
+            Nullable<const char*> name = nullptr;
+            int index = -1;
+        };
+
+    public:
+        explicit JsonScope(Nullable<rapidjson::Value*> root);
+
+        void Push(rapidjson::Value& value, const char* name);
+        void Push(rapidjson::Value& value, int index);
         KMP_NODISCARD bool Pop();
 
-        StringVector scope;
-        String scopeString;
+        KMP_NODISCARD Nullable<rapidjson::Value*> GetCurrent() const noexcept;
+        KMP_NODISCARD String GetScopeString() const;
+
+        Nullable<rapidjson::Value*> root;
+        Vector<Entry> scope;
     };
     //--------------------------------------------------------------------------
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/nullability.h"
+
+#include <rapidjson/document.h>
+
+
+namespace Kmplete
+{
+    //! Non-owning read-only view of a JSON value, references the value in place instead of copying it,
+    //! so it stays valid only while the owning document is alive and its structure is not modified
+    //! @see JsonDocument
+    class KMP_API JsonView
+    {
+    public:
+        JsonView() noexcept;
+        explicit JsonView(const rapidjson::Value& value) noexcept;
+
+        KMP_NODISCARD bool IsValid() const noexcept;
+        KMP_NODISCARD bool IsObject() const noexcept;
+
+        KMP_NODISCARD JsonView GetChild(const char* name) const;
+        KMP_NODISCARD Vector<Pair<String, JsonView>> GetChildren(bool onlyObjects = true) const;
+
+        KMP_NODISCARD String ToString(bool pretty = true) const;
+
+        KMP_NODISCARD Nullable<const rapidjson::Value*> GetValue() const noexcept;
+
+    private:
+        Nullable<const rapidjson::Value*> _value;
+    };
+    //--------------------------------------------------------------------------
+}
\ No newline at end of file
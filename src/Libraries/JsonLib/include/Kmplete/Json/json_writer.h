@@ -48,6 +48,10 @@ namespace Kmplete
         bool SetString(int index, const String& value);
         bool SetString(const char* name, const String& value);
 
+    private:
+        KMP_NODISCARD rapidjson::Value::MemberIterator _GetOrCreateMember(const char* name);
+        KMP_NODISCARD rapidjson::Value& _GetOrCreateElement(int index);
+
     private:
         rapidjson::Document& _document;
         JsonScope _scope;
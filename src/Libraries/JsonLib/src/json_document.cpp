@@ -9,6 +9,7 @@
 #include <rapidjson/error/en.h>
 
 #include <fstream>
+#include <algorithm>
 
 
 #if defined (GetObject)
@@ -22,6 +23,9 @@ namespace Kmplete
     JsonDocument::JsonDocument()
         : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
           _filepath()
+        , _inSituBuffer(nullptr)
+        , _inSituAllocator(nullptr)
+        , _externalMemory()
         , _document()
         , _error(false)
         , _reader(new JsonReader(_document))
@@ -36,6 +40,9 @@ namespace Kmplete
     JsonDocument::JsonDocument(rapidjson::Document&& document)
         : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
           _filepath()
+        , _inSituBuffer(nullptr)
+        , _inSituAllocator(nullptr)
+        , _externalMemory()
         , _document(std::move(document))
         , _error(_document.HasParseError())
         , _reader(new JsonReader(_document))
@@ -45,15 +52,18 @@ namespace Kmplete
     }
     //--------------------------------------------------------------------------
 
-    JsonDocument::JsonDocument(const Filepath& filepath)
+    JsonDocument::JsonDocument(const Filepath& filepath, JsonLoadMode loadMode /*= JsonLoadMode::Stream*/)
         : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
           _filepath(filepath)
+        , _inSituBuffer(nullptr)
+        , _inSituAllocator(nullptr)
+        , _externalMemory()
         , _document()
         , _error(false)
         , _reader(new JsonReader(_document))
         , _writer(new JsonWriter(_document))
     {
-        if (not Load(_filepath))
+        if (not Load(_filepath, loadMode))
         {
             KMP_LOG_ERROR("creation from '{}' failed", _filepath);
         }
@@ -62,6 +72,24 @@ namespace Kmplete
     }
     //--------------------------------------------------------------------------
 
+    JsonDocument::JsonDocument(rapidjson::Value&& value, Vector<ExternalMemory>&& externalMemory)
+        : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
+          _filepath()
+        , _inSituBuffer(nullptr)
+        , _inSituAllocator(nullptr)
+        , _externalMemory(std::move(externalMemory))
+        , _document()
+        , _error(false)
+        , _reader(nullptr)
+        , _writer(nullptr)
+    {
+        static_cast<rapidjson::Value&>(_document).Swap(value);
+        _ResetReaderWriter();
+
+        KMP_PROFILE_CONSTRUCTOR_END()
+    }
+    //--------------------------------------------------------------------------
+
     void JsonDocument::SetFilepath(const Filepath& filepath) noexcept KMP_PROFILING(ProfileLevelMinorVerbose)
     {
         _filepath = filepath;
@@ -79,14 +107,14 @@ namespace Kmplete
     }
     //--------------------------------------------------------------------------
 
-    bool JsonDocument::Load(const Filepath& filepath) KMP_PROFILING(ProfileLevelImportantVerbose)
+    bool JsonDocument::Load(const Filepath& filepath, JsonLoadMode loadMode /*= JsonLoadMode::Stream*/) KMP_PROFILING(ProfileLevelImportantVerbose)
     {
         SetFilepath(filepath);
-        return Load();
+        return Load(loadMode);
     }}
     //--------------------------------------------------------------------------
 
-    bool JsonDocument::Load() KMP_PROFILING(ProfileLevelImportantVerbose)
+    bool JsonDocument::Load(JsonLoadMode loadMode /*= JsonLoadMode::Stream*/) KMP_PROFILING(ProfileLevelImportantVerbose)
     {
         _error = false;
         if (not Filesystem::FilepathExists(_filepath))
@@ -98,31 +126,10 @@ namespace Kmplete
 
         KMP_LOG_INFO("loading from '{}'", _filepath);
 
-        std::ifstream inputStream(_filepath);
-        if (not inputStream.is_open() || not inputStream.good())
-        {
-            _error = true;
-            return false;
-        }
-
-        rapidjson::Document newDocument;
-        rapidjson::IStreamWrapper jsonStream(inputStream);
-        newDocument.ParseStream(jsonStream);
-        inputStream.close();
-
-        if (newDocument.HasParseError())
-        {
-            KMP_LOG_ERROR("failed to load from '{}', JSON parsing error '{}'", _filepath, rapidjson::GetParseError_En(newDocument.GetParseError()));
-            _error = true;
-            return false;
-        }
+        const auto loaded = (loadMode == JsonLoadMode::InSitu) ? _LoadInSitu() : _LoadStream();
+        _error = not loaded;
 
-        _document.Swap(newDocument);
-        _reader.reset(new JsonReader(_document));
-        _writer.reset(new JsonWriter(_document));
-
-        _error = false;
-        return true;
+        return loaded;
     }}
     //--------------------------------------------------------------------------
 
@@ -237,7 +244,7 @@ namespace Kmplete
         }
 
         auto& thisAllocator = _document.GetAllocator();
-        rapidjson::Value childDeepCopy(childDocument, thisAllocator);
+        rapidjson::Value childDeepCopy(childDocument, thisAllocator, "copy const strings"_true);
         _document.AddMember(rapidjson::Value(name.c_str(), static_cast<rapidjson::SizeType>(name.length()), thisAllocator).Move(), childDeepCopy, thisAllocator);
 
         return true;
@@ -257,7 +264,7 @@ namespace Kmplete
 
             const auto childName = child->name.GetString();
             rapidjson::Document childDocument;
-            childDocument.CopyFrom(child->value, childDocument.GetAllocator());
+            childDocument.CopyFrom(child->value, childDocument.GetAllocator(), "copy const strings"_true);
 
             children.emplace_back(childName, CreatePtr<JsonDocument>(std::move(childDocument)));
         }
@@ -266,6 +273,140 @@ namespace Kmplete
     }}
     //--------------------------------------------------------------------------
 
+    bool JsonDocument::AddChildDocument(const String& name, JsonDocument&& child, bool overwrite /*= true*/) KMP_PROFILING(ProfileLevelImportantVerbose)
+    {
+        if (name.empty())
+        {
+            KMP_LOG_ERROR("cannot add child document - name is empty");
+            return false;
+        }
+
+        if (&child == this)
+        {
+            KMP_LOG_ERROR("cannot add document '{}' as a child of itself", name);
+            return false;
+        }
+
+        auto& childDocument = child._document;
+        if (not childDocument.IsObject() || childDocument.HasParseError())
+        {
+            KMP_LOG_ERROR("cannot add '{}' child document - not an object or has errors", name);
+            return false;
+        }
+
+        if (_document.HasMember(name.c_str()))
+        {
+            if (overwrite)
+            {
+                _document.RemoveMember(name.c_str());
+            }
+            else
+            {
+                KMP_LOG_WARN("already contains member '{}' and overwrite set to false", name);
+                return false;
+            }
+        }
+
+        // the moved value keeps pointing into the child's memory, so the memory is shared instead of copying the value
+        _AddExternalMemory(child._GetReferencedMemory());
+
+        auto& thisAllocator = _document.GetAllocator();
+        rapidjson::Value childValue(rapidjson::kObjectType);
+        static_cast<rapidjson::Value&>(childDocument).Swap(childValue);
+        _document.AddMember(rapidjson::Value(name.c_str(), static_cast<rapidjson::SizeType>(name.length()), thisAllocator).Move(), childValue, thisAllocator);
+
+        child._ResetReaderWriter();
+
+        return true;
+    }}
+    //--------------------------------------------------------------------------
+
+    Vector<Pair<String, Ptr<JsonDocument>>> JsonDocument::ExtractChildren(bool onlyObjects /*= true*/) KMP_PROFILING(ProfileLevelImportantVerbose)
+    {
+        Vector<Pair<String, Ptr<JsonDocument>>> children;
+        if (not _document.IsObject())
+        {
+            return children;
+        }
+
+        const auto referencedMemory = _GetReferencedMemory();
+        auto& thisAllocator = _document.GetAllocator();
+        rapidjson::Value remainingMembers(rapidjson::kObjectType);
+
+        children.reserve(_document.MemberCount());
+        for (auto child = _document.MemberBegin(); child != _document.MemberEnd(); child++)
+        {
+            if (onlyObjects && not child->value.IsObject())
+            {
+                remainingMembers.AddMember(child->name, child->value, thisAllocator);
+                continue;
+            }
+
+            auto childMemory = referencedMemory;
+            children.emplace_back(String(child->name.GetString(), child->name.GetStringLength()),
+                                  Ptr<JsonDocument>(new JsonDocument(std::move(child->value), std::move(childMemory))));
+        }
+
+        static_cast<rapidjson::Value&>(_document).Swap(remainingMembers);
+        _ResetReaderWriter();
+
+        return children;
+    }}
+    //--------------------------------------------------------------------------
+
+    JsonView JsonDocument::GetView() const noexcept
+    {
+        return JsonView(_document);
+    }
+    //--------------------------------------------------------------------------
+
+    bool JsonDocument::SaveComposite(const Filepath& filepath, const Vector<Pair<String, JsonView>>& children, bool pretty /*= true*/) KMP_PROFILING(ProfileLevelImportantVerbose)
+    {
+        rapidjson::StringBuffer buffer;
+
+        const auto writeChildren = [&children](auto& writer) {
+            writer.StartObject();
+            for (const auto& [name, view] : children)
+            {
+                if (not view.IsValid())
+                {
+                    KMP_LOG_WARN("child view '{}' is invalid and will be skipped", name);
+                    continue;
+                }
+
+                writer.Key(name.c_str(), static_cast<rapidjson::SizeType>(name.length()));
+                if (not view.GetValue()->Accept(writer))
+                {
+                    return false;
+                }
+            }
+            return writer.EndObject();
+        };
+
+        auto written = false;
+        if (pretty)
+        {
+            rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+            written = writeChildren(writer);
+        }
+        else
+        {
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            written = writeChildren(writer);
+        }
+
+        if (not written)
+        {
+            KMP_LOG_WARN("failed to write composite document in '{}'", filepath);
+            return false;
+        }
+
+        JsonDocument document;
+        document.SetFilepath(filepath);
+        return document._SaveToFile(buffer);
+    }}
+    //--------------------------------------------------------------------------
+
     bool JsonDocument::StartSetObject(const char* objectName)
     {
         return _writer->StartObject(objectName);
@@ -507,6 +648,149 @@ namespace Kmplete
     }
     //--------------------------------------------------------------------------
 
+    bool JsonDocument::_LoadStream() KMP_PROFILING(ProfileLevelImportantVerbose)
+    {
+        std::ifstream inputStream(_filepath);
+        if (not inputStream.is_open() || not inputStream.good())
+        {
+            return false;
+        }
+
+        {
+            rapidjson::Document newDocument;
+            rapidjson::IStreamWrapper jsonStream(inputStream);
+            newDocument.ParseStream(jsonStream);
+            inputStream.close();
+
+            if (newDocument.HasParseError())
+            {
+                KMP_LOG_ERROR("failed to load from '{}', JSON parsing error '{}'", _filepath, rapidjson::GetParseError_En(newDocument.GetParseError()));
+                return false;
+            }
+
+            _document.Swap(newDocument);
+            _ResetReaderWriter();
+        }
+
+        // previous content is destroyed already, so the in-situ and external storage it might have referenced can be released
+        _inSituBuffer.reset();
+        _inSituAllocator.reset();
+        _externalMemory.clear();
+
+        return true;
+    }}
+    //--------------------------------------------------------------------------
+
+    bool JsonDocument::_LoadInSitu() KMP_PROFILING(ProfileLevelImportantVerbose)
+    {
+        std::ifstream inputStream(_filepath, std::ios::binary | std::ios::ate);
+        if (not inputStream.is_open() || not inputStream.good())
+        {
+            return false;
+        }
+
+        const auto fileSize = static_cast<size_t>(inputStream.tellg());
+        inputStream.seekg(0, std::ios::beg);
+
+        // DOM size is proportional to the file size, so a chunk of the same size makes the arena
+        // grow in a few big steps instead of many default 64 KB ones
+        constexpr size_t MinChunkCapacity = 64 * 1024;
+
+        Ptr<Vector<char>> buffer;
+        UPtr<rapidjson::MemoryPoolAllocator<>> allocator;
+
+        // storage of the previous in-situ load is reused unless values moved to other documents still reference it,
+        // the previous content lives in that storage, so it is dropped before the storage is overwritten
+        if (_inSituBuffer && _inSituBuffer.use_count() == 1 && _inSituAllocator)
+        {
+            {
+                rapidjson::Document emptyDocument;
+                emptyDocument.SetObject();
+                _document.Swap(emptyDocument);
+                _ResetReaderWriter();
+            }
+            _externalMemory.clear();
+
+            std::swap(buffer, _inSituBuffer);
+            std::swap(allocator, _inSituAllocator);
+            allocator->Clear();
+            buffer->resize(fileSize + 1);
+        }
+        else
+        {
+            buffer = CreatePtr<Vector<char>>(fileSize + 1);
+            allocator = CreateUPtr<rapidjson::MemoryPoolAllocator<>>(std::max(fileSize, MinChunkCapacity));
+        }
+
+        // in-situ parsing requires null-terminated mutable buffer
+        if (not inputStream.read(buffer->data(), std::streamsize(fileSize)))
+        {
+            KMP_LOG_ERROR("failed to read '{}'", _filepath);
+            return false;
+        }
+        (*buffer)[fileSize] = '\0';
+        inputStream.close();
+
+        {
+            rapidjson::Document newDocument(allocator.get());
+            newDocument.ParseInsitu(buffer->data());
+
+            if (newDocument.HasParseError())
+            {
+                KMP_LOG_ERROR("failed to load from '{}', JSON parsing error '{}'", _filepath, rapidjson::GetParseError_En(newDocument.GetParseError()));
+                return false;
+            }
+
+            _document.Swap(newDocument);
+            _ResetReaderWriter();
+        }
+
+        // previous content is destroyed already, previous in-situ storage goes away with the locals
+        std::swap(_inSituBuffer, buffer);
+        std::swap(_inSituAllocator, allocator);
+        _externalMemory.clear();
+
+        return true;
+    }}
+    //--------------------------------------------------------------------------
+
+    Vector<JsonDocument::ExternalMemory> JsonDocument::_GetReferencedMemory() const
+    {
+        Vector<ExternalMemory> referencedMemory;
+        referencedMemory.reserve(_externalMemory.size() + 1);
+        referencedMemory.push_back(ExternalMemory{ .allocator = _document.GetAllocator(), .inSituBuffer = _inSituBuffer });
+        for (const auto& memory : _externalMemory)
+        {
+            referencedMemory.push_back(memory);
+        }
+
+        return referencedMemory;
+    }
+    //--------------------------------------------------------------------------
+
+    void JsonDocument::_AddExternalMemory(Vector<ExternalMemory>&& externalMemory)
+    {
+        for (auto& memory : externalMemory)
+        {
+            const auto alreadyReferenced = std::any_of(_externalMemory.begin(), _externalMemory.end(), [&memory](const ExternalMemory& existing) {
+                return existing.allocator == memory.allocator;
+            });
+
+            if (not alreadyReferenced && not (memory.allocator == _document.GetAllocator()))
+            {
+                _externalMemory.push_back(std::move(memory));
+            }
+        }
+    }
+    //--------------------------------------------------------------------------
+
+    void JsonDocument::_ResetReaderWriter()
+    {
+        _reader.reset(new JsonReader(_document));
+        _writer.reset(new JsonWriter(_document));
+    }
+    //--------------------------------------------------------------------------
+
     bool JsonDocument::_SaveToFile(const rapidjson::StringBuffer& buffer) KMP_PROFILING(ProfileLevelImportantVerbose)
     {
         if (not Filesystem::CreateDirectories(_filepath, "is file"_true))
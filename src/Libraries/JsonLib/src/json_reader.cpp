@@ -2,16 +2,14 @@
 #include "Kmplete/Log/log.h"
 #include "Kmplete/Profile/profiler.h"
 
-#include <rapidjson/pointer.h>
-
 
 namespace Kmplete
 {
     JsonReader::JsonReader(rapidjson::Document& document)
         : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
           _document(document)
-        , _scope()
-        , _currentObject(rapidjson::Pointer("").Get(_document))
+        , _scope(&_document)
+        , _currentObject(&_document)
     {
         KMP_PROFILE_CONSTRUCTOR_END()
     }
@@ -33,18 +31,19 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot start object '{}' - current object '{}' is not of object type", objectName, _scope.scopeString);
+            KMP_LOG_ERROR("cannot start object '{}' - current object '{}' is not of object type", objectName, _scope.GetScopeString());
             return false;
         }
 
-        if (not _currentObject->HasMember(objectName) || not (*_currentObject)[objectName].IsObject())
+        const auto member = _currentObject->FindMember(objectName);
+        if (member == _currentObject->MemberEnd() || not member->value.IsObject())
         {
             KMP_LOG_ERROR("cannot find member '{}', or the member is not an object type", objectName);
             return false;
         }
 
-        _scope.Push(objectName);
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        _scope.Push(member->value, member->name.GetString());
+        _currentObject = &member->value;
 
         return true;
     }}
@@ -57,14 +56,15 @@ namespace Kmplete
             return false;
         }
 
-        if (not (*_currentObject)[index].IsObject())
+        auto& element = (*_currentObject)[index];
+        if (not element.IsObject())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not of object type", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not of object type", _scope.GetScopeString(), index);
             return false;
         }
 
-        _scope.Push(std::to_string(index));
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        _scope.Push(element, index);
+        _currentObject = &element;
 
         return true;
     }}
@@ -74,7 +74,7 @@ namespace Kmplete
     {
         if (_scope.Pop())
         {
-            _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+            _currentObject = _scope.GetCurrent();
             return true;
         }
 
@@ -98,20 +98,21 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot start array '{}' - current object '{}' is not of object type", arrayName, _scope.scopeString);
+            KMP_LOG_ERROR("cannot start array '{}' - current object '{}' is not of object type", arrayName, _scope.GetScopeString());
             return 0;
         }
 
-        if (not _currentObject->HasMember(arrayName) || not (*_currentObject)[arrayName].IsArray())
+        const auto member = _currentObject->FindMember(arrayName);
+        if (member == _currentObject->MemberEnd() || not member->value.IsArray())
         {
             KMP_LOG_ERROR("cannot find member '{}', or the member is not an array type", arrayName);
             return 0;
         }
 
-        _scope.Push(arrayName);
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        _scope.Push(member->value, member->name.GetString());
+        _currentObject = &member->value;
 
-        return (*_currentObject).GetArray().Size();
+        return _currentObject->Size();
     }}
     //--------------------------------------------------------------------------
 
@@ -122,16 +123,17 @@ namespace Kmplete
             return 0;
         }
 
-        if (not (*_currentObject)[index].IsArray())
+        auto& element = (*_currentObject)[index];
+        if (not element.IsArray())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not of array type", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not of array type", _scope.GetScopeString(), index);
             return 0;
         }
 
-        _scope.Push(std::to_string(index));
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        _scope.Push(element, index);
+        _currentObject = &element;
 
-        return (*_currentObject).GetArray().Size();
+        return _currentObject->Size();
     }}
     //--------------------------------------------------------------------------
 
@@ -145,7 +147,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot end array - current object '{}' is not of array type", _scope.scopeString);
+            KMP_LOG_ERROR("cannot end array - current object '{}' is not of array type", _scope.GetScopeString());
             return false;
         }
 
@@ -160,13 +162,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not (*_currentObject)[index].IsBool())
+        const auto& element = (*_currentObject)[index];
+        if (not element.IsBool())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not a bool", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not a bool", _scope.GetScopeString(), index);
             return defaultValue;
         }
 
-        return (*_currentObject)[index].GetBool();
+        return element.GetBool();
     }}
     //--------------------------------------------------------------------------
 
@@ -178,13 +181,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsBool())
+        const auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd() || not member->value.IsBool())
         {
-            KMP_LOG_ERROR("cannot find bool for '{}/{}'", _scope.scopeString, name);
+            KMP_LOG_ERROR("cannot find bool for '{}/{}'", _scope.GetScopeString(), name);
             return defaultValue;
         }
 
-        return (*_currentObject)[name].GetBool();
+        return member->value.GetBool();
     }}
     //--------------------------------------------------------------------------
 
@@ -195,13 +199,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not (*_currentObject)[index].IsInt())
+        const auto& element = (*_currentObject)[index];
+        if (not element.IsInt())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not an int", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not an int", _scope.GetScopeString(), index);
             return defaultValue;
         }
 
-        return (*_currentObject)[index].GetInt();
+        return element.GetInt();
     }}
     //--------------------------------------------------------------------------
 
@@ -213,13 +218,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsInt())
+        const auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd() || not member->value.IsInt())
         {
-            KMP_LOG_ERROR("cannot find int for '{}/{}'", _scope.scopeString, name);
+            KMP_LOG_ERROR("cannot find int for '{}/{}'", _scope.GetScopeString(), name);
             return defaultValue;
         }
 
-        return (*_currentObject)[name].GetInt();
+        return member->value.GetInt();
     }}
     //--------------------------------------------------------------------------
 
@@ -230,13 +236,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not (*_currentObject)[index].IsUint())
+        const auto& element = (*_currentObject)[index];
+        if (not element.IsUint())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not an unsigned int", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not an unsigned int", _scope.GetScopeString(), index);
             return defaultValue;
         }
 
-        return (*_currentObject)[index].GetUint();
+        return element.GetUint();
     }}
     //--------------------------------------------------------------------------
 
@@ -248,13 +255,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsUint())
+        const auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd() || not member->value.IsUint())
         {
-            KMP_LOG_ERROR("cannot find unsigned int for '{}/{}'", _scope.scopeString, name);
+            KMP_LOG_ERROR("cannot find unsigned int for '{}/{}'", _scope.GetScopeString(), name);
             return defaultValue;
         }
 
-        return (*_currentObject)[name].GetUint();
+        return member->value.GetUint();
     }}
     //--------------------------------------------------------------------------
 
@@ -265,13 +273,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not (*_currentObject)[index].IsInt64())
+        const auto& element = (*_currentObject)[index];
+        if (not element.IsInt64())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not an int64", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not an int64", _scope.GetScopeString(), index);
             return defaultValue;
         }
 
-        return (*_currentObject)[index].GetInt64();
+        return element.GetInt64();
     }}
     //--------------------------------------------------------------------------
 
@@ -283,13 +292,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsInt64())
+        const auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd() || not member->value.IsInt64())
         {
-            KMP_LOG_ERROR("cannot find int64 for '{}/{}'", _scope.scopeString, name);
+            KMP_LOG_ERROR("cannot find int64 for '{}/{}'", _scope.GetScopeString(), name);
             return defaultValue;
         }
 
-        return (*_currentObject)[name].GetInt64();
+        return member->value.GetInt64();
     }}
     //--------------------------------------------------------------------------
 
@@ -300,13 +310,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not (*_currentObject)[index].IsUint64())
+        const auto& element = (*_currentObject)[index];
+        if (not element.IsUint64())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not an unsigned int64", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not an unsigned int64", _scope.GetScopeString(), index);
             return defaultValue;
         }
 
-        return (*_currentObject)[index].GetUint64();
+        return element.GetUint64();
     }}
     //--------------------------------------------------------------------------
 
@@ -318,13 +329,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsUint64())
+        const auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd() || not member->value.IsUint64())
         {
-            KMP_LOG_ERROR("cannot find unsigned int64 for '{}/{}'", _scope.scopeString, name);
+            KMP_LOG_ERROR("cannot find unsigned int64 for '{}/{}'", _scope.GetScopeString(), name);
             return defaultValue;
         }
 
-        return (*_currentObject)[name].GetUint64();
+        return member->value.GetUint64();
     }}
     //--------------------------------------------------------------------------
 
@@ -335,13 +347,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not (*_currentObject)[index].IsDouble())
+        const auto& element = (*_currentObject)[index];
+        if (not element.IsDouble())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not a double", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not a double", _scope.GetScopeString(), index);
             return defaultValue;
         }
 
-        return (*_currentObject)[index].GetDouble();
+        return element.GetDouble();
     }}
     //--------------------------------------------------------------------------
 
@@ -353,13 +366,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsDouble())
+        const auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd() || not member->value.IsDouble())
         {
-            KMP_LOG_ERROR("cannot find double for '{}/{}'", _scope.scopeString, name);
+            KMP_LOG_ERROR("cannot find double for '{}/{}'", _scope.GetScopeString(), name);
             return defaultValue;
         }
 
-        return (*_currentObject)[name].GetDouble();
+        return member->value.GetDouble();
     }}
     //--------------------------------------------------------------------------
 
@@ -370,13 +384,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not (*_currentObject)[index].IsString())
+        const auto& element = (*_currentObject)[index];
+        if (not element.IsString())
         {
-            KMP_LOG_ERROR("'{}[{}]' is not a string", _scope.scopeString, index);
+            KMP_LOG_ERROR("'{}[{}]' is not a string", _scope.GetScopeString(), index);
             return defaultValue;
         }
 
-        return (*_currentObject)[index].GetString();
+        return element.GetString();
     }}
     //--------------------------------------------------------------------------
 
@@ -388,13 +403,14 @@ namespace Kmplete
             return defaultValue;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsString())
+        const auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd() || not member->value.IsString())
         {
-            KMP_LOG_ERROR("cannot find string for '{}/{}'", _scope.scopeString, name);
+            KMP_LOG_ERROR("cannot find string for '{}/{}'", _scope.GetScopeString(), name);
             return defaultValue;
         }
 
-        return (*_currentObject)[name].GetString();
+        return member->value.GetString();
     }}
     //--------------------------------------------------------------------------
 
@@ -407,13 +423,13 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("current object '{}' is not an array", _scope.scopeString);
+            KMP_LOG_ERROR("current object '{}' is not an array", _scope.GetScopeString());
             return false;
         }
 
         if (index >= static_cast<int>(_currentObject->Size()) || index < 0)
         {
-            KMP_LOG_ERROR("invalid index [{}] for '{}'", index, _scope.scopeString);
+            KMP_LOG_ERROR("invalid index [{}] for '{}'", index, _scope.GetScopeString());
             return false;
         }
 
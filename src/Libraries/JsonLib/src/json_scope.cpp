@@ -1,15 +1,27 @@
 #include "Kmplete/Json/json_scope.h"
 #include "Kmplete/Log/log.h"
-#include "Kmplete/Utils/string_utils.h"
 #include "Kmplete/Profile/profiler.h"
 
 
 namespace Kmplete
 {
-    void JsonScope::Push(const String& entry) KMP_PROFILING(ProfileLevelMinorVerbose)
+    JsonScope::JsonScope(Nullable<rapidjson::Value*> root)
+        : root(root)
+        , scope()
     {
-        scope.push_back(entry);
-        scopeString = Utils::StringVectorToString(scope, '/');
+        scope.reserve(16);
+    }
+    //--------------------------------------------------------------------------
+
+    void JsonScope::Push(rapidjson::Value& value, const char* name) KMP_PROFILING(ProfileLevelMinorVerbose)
+    {
+        scope.push_back(Entry{ .value = &value, .name = name, .index = -1 });
+    }}
+    //--------------------------------------------------------------------------
+
+    void JsonScope::Push(rapidjson::Value& value, int index) KMP_PROFILING(ProfileLevelMinorVerbose)
+    {
+        scope.push_back(Entry{ .value = &value, .name = nullptr, .index = index });
     }}
     //--------------------------------------------------------------------------
 
@@ -18,7 +30,6 @@ namespace Kmplete
         if (not scope.empty())
         {
             scope.pop_back();
-            scopeString = scope.empty() ? "" : Utils::StringVectorToString(scope, '/');
             return true;
         }
 
@@ -26,4 +37,23 @@ namespace Kmplete
         return false;
     }}
     //--------------------------------------------------------------------------
+
+    Nullable<rapidjson::Value*> JsonScope::GetCurrent() const noexcept
+    {
+        return scope.empty() ? root : scope.back().value;
+    }
+    //--------------------------------------------------------------------------
+
+    String JsonScope::GetScopeString() const KMP_PROFILING(ProfileLevelMinorVerbose)
+    {
+        String scopeString;
+        for (const auto& entry : scope)
+        {
+            scopeString += '/';
+            scopeString += entry.name ? String(entry.name) : std::to_string(entry.index);
+        }
+
+        return scopeString;
+    }}
+    //--------------------------------------------------------------------------
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "Kmplete/Json/json_view.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+
+namespace Kmplete
+{
+    JsonView::JsonView() noexcept
+        : _value(nullptr)
+    {}
+    //--------------------------------------------------------------------------
+
+    JsonView::JsonView(const rapidjson::Value& value) noexcept
+        : _value(&value)
+    {}
+    //--------------------------------------------------------------------------
+
+    bool JsonView::IsValid() const noexcept
+    {
+        return _value != nullptr;
+    }
+    //--------------------------------------------------------------------------
+
+    bool JsonView::IsObject() const noexcept
+    {
+        return _value != nullptr && _value->IsObject();
+    }
+    //--------------------------------------------------------------------------
+
+    JsonView JsonView::GetChild(const char* name) const KMP_PROFILING(ProfileLevelMinorVerbose)
+    {
+        if (not IsObject())
+        {
+            return JsonView();
+        }
+
+        const auto member = _value->FindMember(name);
+        if (member == _value->MemberEnd())
+        {
+            return JsonView();
+        }
+
+        return JsonView(member->value);
+    }}
+    //--------------------------------------------------------------------------
+
+    Vector<Pair<String, JsonView>> JsonView::GetChildren(bool onlyObjects /*= true*/) const KMP_PROFILING(ProfileLevelMinor)
+    {
+        Vector<Pair<String, JsonView>> children;
+        if (not IsObject())
+        {
+            return children;
+        }
+
+        children.reserve(_value->MemberCount());
+        for (auto child = _value->MemberBegin(); child != _value->MemberEnd(); child++)
+        {
+            if (onlyObjects && not child->value.IsObject())
+            {
+                continue;
+            }
+
+            children.emplace_back(String(child->name.GetString(), child->name.GetStringLength()), JsonView(child->value));
+        }
+
+        return children;
+    }}
+    //--------------------------------------------------------------------------
+
+    String JsonView::ToString(bool pretty /*= true*/) const KMP_PROFILING(ProfileLevelMinor)
+    {
+        if (not IsValid())
+        {
+            return String("");
+        }
+
+        rapidjson::StringBuffer buffer;
+
+        if (pretty)
+        {
+            rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+            if (_value->Accept(writer))
+            {
+                return String(buffer.GetString());
+            }
+        }
+        else
+        {
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+            if (_value->Accept(writer))
+            {
+                return String(buffer.GetString());
+            }
+        }
+
+        return String("");
+    }}
+    //--------------------------------------------------------------------------
+
+    Nullable<const rapidjson::Value*> JsonView::GetValue() const noexcept
+    {
+        return _value;
+    }
+    //--------------------------------------------------------------------------
+}
\ No newline at end of file
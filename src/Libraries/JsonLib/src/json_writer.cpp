@@ -2,16 +2,14 @@
 #include "Kmplete/Log/log.h"
 #include "Kmplete/Profile/profiler.h"
 
-#include <rapidjson/pointer.h>
-
 
 namespace Kmplete
 {
     JsonWriter::JsonWriter(rapidjson::Document& document)
         : KMP_PROFILE_CONSTRUCTOR_START_BASE_CLASS()
           _document(document)
-        , _scope()
-        , _currentObject(rapidjson::Pointer("").Get(_document))
+        , _scope(&_document)
+        , _currentObject(&_document)
     {
         if (not _currentObject->IsObject())
         {
@@ -38,19 +36,19 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot start object '{}' - current object '{}' is not of object type", objectName, _scope.scopeString);
+            KMP_LOG_ERROR("cannot start object '{}' - current object '{}' is not of object type", objectName, _scope.GetScopeString());
             return false;
         }
 
-        _scope.Push(objectName);
-
-        if (not _currentObject->HasMember(objectName) || not (*_currentObject)[objectName].IsObject())
+        const auto member = _GetOrCreateMember(objectName);
+        if (not member->value.IsObject())
         {
-            KMP_LOG_DEBUG("creating new object '{}' in '{}'", objectName, _scope.scopeString);
-            rapidjson::Pointer(_scope.scopeString.c_str()).Create(_document).SetObject();
+            KMP_LOG_DEBUG("creating new object '{}' in '{}'", objectName, _scope.GetScopeString());
+            member->value.SetObject();
         }
 
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        _scope.Push(member->value, member->name.GetString());
+        _currentObject = &member->value;
 
         return true;
     }}
@@ -66,7 +64,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot start object '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot start object '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -76,15 +74,15 @@ namespace Kmplete
             return false;
         }
 
-        _scope.Push(std::to_string(index));
-
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new object '{}' in '{}'", index, _scope.scopeString);
-            rapidjson::Pointer(_scope.scopeString.c_str()).Create(_document).SetObject();
+            KMP_LOG_DEBUG("creating new object '{}' in '{}'", index, _scope.GetScopeString());
+            _GetOrCreateElement(index).SetObject();
         }
 
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        auto& element = (*_currentObject)[index];
+        _scope.Push(element, index);
+        _currentObject = &element;
 
         return true;
     }}
@@ -94,7 +92,7 @@ namespace Kmplete
     {
         if (_scope.Pop())
         {
-            _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+            _currentObject = _scope.GetCurrent();
             return true;
         }
 
@@ -118,19 +116,19 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot start array '{}' - current object '{}' is not of object type", arrayName, _scope.scopeString);
+            KMP_LOG_ERROR("cannot start array '{}' - current object '{}' is not of object type", arrayName, _scope.GetScopeString());
             return false;
         }
 
-        _scope.Push(arrayName);
-
-        if (not _currentObject->HasMember(arrayName) || not (*_currentObject)[arrayName].IsArray() || overwrite)
+        const auto member = _GetOrCreateMember(arrayName);
+        if (not member->value.IsArray() || overwrite)
         {
-            KMP_LOG_DEBUG("creating new array '{}' in '{}'", arrayName, _scope.scopeString);
-            rapidjson::Pointer(_scope.scopeString.c_str()).Create(_document).SetArray();
+            KMP_LOG_DEBUG("creating new array '{}' in '{}'", arrayName, _scope.GetScopeString());
+            member->value.SetArray();
         }
 
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        _scope.Push(member->value, member->name.GetString());
+        _currentObject = &member->value;
 
         return true;
     }}
@@ -146,7 +144,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot start array '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot start array '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -156,15 +154,15 @@ namespace Kmplete
             return false;
         }
 
-        _scope.Push(std::to_string(index));
-
         if (index >= static_cast<int>(_currentObject->Size()) || overwrite)
         {
-            KMP_LOG_DEBUG("creating new array '{}' in '{}'", index, _scope.scopeString);
-            rapidjson::Pointer(_scope.scopeString.c_str()).Create(_document).SetArray();
+            KMP_LOG_DEBUG("creating new array '{}' in '{}'", index, _scope.GetScopeString());
+            _GetOrCreateElement(index).SetArray();
         }
 
-        _currentObject = rapidjson::Pointer(_scope.scopeString.c_str()).Get(_document);
+        auto& element = (*_currentObject)[index];
+        _scope.Push(element, index);
+        _currentObject = &element;
 
         return true;
     }}
@@ -180,7 +178,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot end array - current object '{}' is not of array type", _scope.scopeString);
+            KMP_LOG_ERROR("cannot end array - current object '{}' is not of array type", _scope.GetScopeString());
             return false;
         }
 
@@ -198,7 +196,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot set bool '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set bool '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -210,7 +208,7 @@ namespace Kmplete
 
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new bool '{}' in '{}'", index, _scope.scopeString);
+            KMP_LOG_DEBUG("creating new bool '{}' in '{}'", index, _scope.GetScopeString());
             _currentObject->PushBack(rapidjson::Value(value), _document.GetAllocator());
         }
         else
@@ -238,21 +236,18 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot set bool '{}' - current object '{}' is not of object type", name, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set bool '{}' - current object '{}' is not of object type", name, _scope.GetScopeString());
             return false;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsBool())
-        {
-            const auto newScope = _scope.scopeString + "/" + name;
-            KMP_LOG_DEBUG("creating new bool '{}' in '{}'", name, _scope.scopeString);
-            rapidjson::Pointer(newScope.c_str()).Create(_document).SetBool(value);
-        }
-        else
+        const auto member = _GetOrCreateMember(name);
+        if (not member->value.IsBool())
         {
-            (*_currentObject)[name].SetBool(value);
+            KMP_LOG_DEBUG("creating new bool '{}' in '{}'", name, _scope.GetScopeString());
         }
 
+        member->value.SetBool(value);
+
         return true;
     }}
     //--------------------------------------------------------------------------
@@ -267,7 +262,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot set int '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set int '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -279,7 +274,7 @@ namespace Kmplete
 
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new int '{}' in '{}'", index, _scope.scopeString);
+            KMP_LOG_DEBUG("creating new int '{}' in '{}'", index, _scope.GetScopeString());
             _currentObject->PushBack(rapidjson::Value(value), _document.GetAllocator());
         }
         else
@@ -307,21 +302,18 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot set int '{}' - current object '{}' is not of object type", name, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set int '{}' - current object '{}' is not of object type", name, _scope.GetScopeString());
             return false;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsInt())
-        {
-            const auto newScope = _scope.scopeString + "/" + name;
-            KMP_LOG_DEBUG("creating new int '{}' in '{}'", name, _scope.scopeString);
-            rapidjson::Pointer(newScope.c_str()).Create(_document).SetInt(value);
-        }
-        else
+        const auto member = _GetOrCreateMember(name);
+        if (not member->value.IsInt())
         {
-            (*_currentObject)[name].SetInt(value);
+            KMP_LOG_DEBUG("creating new int '{}' in '{}'", name, _scope.GetScopeString());
         }
 
+        member->value.SetInt(value);
+
         return true;
     }}
     //--------------------------------------------------------------------------
@@ -336,7 +328,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot set unsigned int '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set unsigned int '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -348,7 +340,7 @@ namespace Kmplete
 
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new unsigned int '{}' in '{}'", index, _scope.scopeString);
+            KMP_LOG_DEBUG("creating new unsigned int '{}' in '{}'", index, _scope.GetScopeString());
             _currentObject->PushBack(rapidjson::Value(value), _document.GetAllocator());
         }
         else
@@ -376,21 +368,18 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot set unsigned int '{}' - current object '{}' is not of object type", name, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set unsigned int '{}' - current object '{}' is not of object type", name, _scope.GetScopeString());
             return false;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsUint())
-        {
-            const auto newScope = _scope.scopeString + "/" + name;
-            KMP_LOG_DEBUG("creating new unsigned int '{}' in '{}'", name, _scope.scopeString);
-            rapidjson::Pointer(newScope.c_str()).Create(_document).SetUint(value);
-        }
-        else
+        const auto member = _GetOrCreateMember(name);
+        if (not member->value.IsUint())
         {
-            (*_currentObject)[name].SetUint(value);
+            KMP_LOG_DEBUG("creating new unsigned int '{}' in '{}'", name, _scope.GetScopeString());
         }
 
+        member->value.SetUint(value);
+
         return true;
     }}
     //--------------------------------------------------------------------------
@@ -405,7 +394,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot set int64 '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set int64 '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -417,7 +406,7 @@ namespace Kmplete
 
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new int64 '{}' in '{}'", index, _scope.scopeString);
+            KMP_LOG_DEBUG("creating new int64 '{}' in '{}'", index, _scope.GetScopeString());
             _currentObject->PushBack(rapidjson::Value(value), _document.GetAllocator());
         }
         else
@@ -445,21 +434,18 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot set int64 '{}' - current object '{}' is not of object type", name, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set int64 '{}' - current object '{}' is not of object type", name, _scope.GetScopeString());
             return false;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsInt64())
+        const auto member = _GetOrCreateMember(name);
+        if (not member->value.IsInt64())
         {
-            const auto newScope = _scope.scopeString + "/" + name;
-            KMP_LOG_DEBUG("creating new int64 '{}' in '{}'", name, _scope.scopeString);
-            rapidjson::Pointer(newScope.c_str()).Create(_document).SetInt64(value);
-        }
-        else
-        {
-            (*_currentObject)[name].SetInt64(value);
+            KMP_LOG_DEBUG("creating new int64 '{}' in '{}'", name, _scope.GetScopeString());
         }
 
+        member->value.SetInt64(value);
+
         return true;
     }}
     //--------------------------------------------------------------------------
@@ -474,7 +460,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot set unsigned int64 '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set unsigned int64 '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -486,7 +472,7 @@ namespace Kmplete
 
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new unsigned int64 '{}' in '{}'", index, _scope.scopeString);
+            KMP_LOG_DEBUG("creating new unsigned int64 '{}' in '{}'", index, _scope.GetScopeString());
             _currentObject->PushBack(rapidjson::Value(value), _document.GetAllocator());
         }
         else
@@ -514,21 +500,18 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot set unsigned int64 '{}' - current object '{}' is not of object type", name, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set unsigned int64 '{}' - current object '{}' is not of object type", name, _scope.GetScopeString());
             return false;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsUint64())
+        const auto member = _GetOrCreateMember(name);
+        if (not member->value.IsUint64())
         {
-            const auto newScope = _scope.scopeString + "/" + name;
-            KMP_LOG_DEBUG("creating new unsigned int64 '{}' in '{}'", name, _scope.scopeString);
-            rapidjson::Pointer(newScope.c_str()).Create(_document).SetUint64(value);
-        }
-        else
-        {
-            (*_currentObject)[name].SetUint64(value);
+            KMP_LOG_DEBUG("creating new unsigned int64 '{}' in '{}'", name, _scope.GetScopeString());
         }
 
+        member->value.SetUint64(value);
+
         return true;
     }}
     //--------------------------------------------------------------------------
@@ -543,7 +526,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot set double '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set double '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -555,7 +538,7 @@ namespace Kmplete
 
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new double '{}' in '{}'", index, _scope.scopeString);
+            KMP_LOG_DEBUG("creating new double '{}' in '{}'", index, _scope.GetScopeString());
             _currentObject->PushBack(rapidjson::Value(value), _document.GetAllocator());
         }
         else
@@ -583,21 +566,18 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot set double '{}' - current object '{}' is not of object type", name, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set double '{}' - current object '{}' is not of object type", name, _scope.GetScopeString());
             return false;
         }
 
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsDouble())
-        {
-            const auto newScope = _scope.scopeString + "/" + name;
-            KMP_LOG_DEBUG("creating new double '{}' in '{}'", name, _scope.scopeString);
-            rapidjson::Pointer(newScope.c_str()).Create(_document).SetDouble(value);
-        }
-        else
+        const auto member = _GetOrCreateMember(name);
+        if (not member->value.IsDouble())
         {
-            (*_currentObject)[name].SetDouble(value);
+            KMP_LOG_DEBUG("creating new double '{}' in '{}'", name, _scope.GetScopeString());
         }
 
+        member->value.SetDouble(value);
+
         return true;
     }}
     //--------------------------------------------------------------------------
@@ -612,7 +592,7 @@ namespace Kmplete
 
         if (not _currentObject->IsArray())
         {
-            KMP_LOG_ERROR("cannot set string '{}' - current object '{}' is not of array type", index, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set string '{}' - current object '{}' is not of array type", index, _scope.GetScopeString());
             return false;
         }
 
@@ -625,7 +605,7 @@ namespace Kmplete
         const auto size = static_cast<rapidjson::SizeType>(value.length());
         if (index >= static_cast<int>(_currentObject->Size()))
         {
-            KMP_LOG_DEBUG("creating new string '{}' in '{}'", index, _scope.scopeString);
+            KMP_LOG_DEBUG("creating new string '{}' in '{}'", index, _scope.GetScopeString());
             _currentObject->PushBack(rapidjson::Value(value.c_str(), size, _document.GetAllocator()), _document.GetAllocator());
         }
         else
@@ -653,23 +633,49 @@ namespace Kmplete
 
         if (not _currentObject->IsObject())
         {
-            KMP_LOG_ERROR("cannot set string '{}' - current object '{}' is not of object type", name, _scope.scopeString);
+            KMP_LOG_ERROR("cannot set string '{}' - current object '{}' is not of object type", name, _scope.GetScopeString());
             return false;
         }
 
         const auto size = static_cast<rapidjson::SizeType>(value.length());
-        if (not _currentObject->HasMember(name) || not (*_currentObject)[name].IsString())
+        const auto member = _GetOrCreateMember(name);
+        if (not member->value.IsString())
         {
-            const auto newScope = _scope.scopeString + "/" + name;
-            KMP_LOG_DEBUG("creating new string '{}' in '{}'", name, _scope.scopeString);
-            rapidjson::Pointer(newScope.c_str()).Create(_document).SetString(value.c_str(), size, _document.GetAllocator());
+            KMP_LOG_DEBUG("creating new string '{}' in '{}'", name, _scope.GetScopeString());
         }
-        else
+
+        member->value.SetString(value.c_str(), size, _document.GetAllocator());
+
+        return true;
+    }}
+    //--------------------------------------------------------------------------
+
+    rapidjson::Value::MemberIterator JsonWriter::_GetOrCreateMember(const char* name) KMP_PROFILING(ProfileLevelMinorVerbose)
+    {
+        auto member = _currentObject->FindMember(name);
+        if (member == _currentObject->MemberEnd())
         {
-            (*_currentObject)[name].SetString(value.c_str(), size, _document.GetAllocator());
+            _currentObject->AddMember(rapidjson::Value(name, _document.GetAllocator()), rapidjson::Value(), _document.GetAllocator());
+            member = _currentObject->MemberEnd() - 1;
         }
 
-        return true;
+        return member;
+    }}
+    //--------------------------------------------------------------------------
+
+    rapidjson::Value& JsonWriter::_GetOrCreateElement(int index) KMP_PROFILING(ProfileLevelMinorVerbose)
+    {
+        const auto size = static_cast<rapidjson::SizeType>(index) + 1;
+        if (_currentObject->Size() < size)
+        {
+            _currentObject->Reserve(size, _document.GetAllocator());
+            while (_currentObject->Size() < size)
+            {
+                _currentObject->PushBack(rapidjson::Value(), _document.GetAllocator());
+            }
+        }
+
+        return (*_currentObject)[index];
     }}
     //--------------------------------------------------------------------------
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "Kmplete/Profile/profiler.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <fstream>
 
 
 TEST_CASE("Json document from empty rapidjson document", "[json][reader][writer][document]")
@@ -391,6 +393,254 @@ TEST_CASE("Json document save to file and read from file", "[json][reader][write
 //--------------------------------------------------------------------------
 
 
+TEST_CASE("Json document in-situ load", "[json][reader][writer][document]")
+{
+    const auto settingsFilepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_test_temp_insitu.json");
+
+    Kmplete::JsonDocument rootDoc;
+    REQUIRE(rootDoc.StartSetObject("Obj1"));
+        REQUIRE(rootDoc.SetInt("Int", 33));
+        REQUIRE(rootDoc.SetString("String", "some string"));
+        REQUIRE(rootDoc.SetString("StringWithEsc", "\"Quote\" \\\\"));
+        REQUIRE(rootDoc.StartSetArray("Array"));
+            REQUIRE(rootDoc.SetString(0, "first"));
+            REQUIRE(rootDoc.SetString(1, "second"));
+        REQUIRE(rootDoc.EndSetArray());
+    REQUIRE(rootDoc.EndSetObject());
+    REQUIRE(rootDoc.Save(settingsFilepath));
+
+    Kmplete::Vector<Kmplete::Pair<Kmplete::String, Kmplete::Ptr<Kmplete::JsonDocument>>> childrenDocuments;
+    {
+        Kmplete::JsonDocument loadedDoc(settingsFilepath, Kmplete::JsonLoadMode::InSitu);
+        REQUIRE_FALSE(loadedDoc.HasError());
+
+        REQUIRE(loadedDoc.StartGetObject("Obj1"));
+            REQUIRE(loadedDoc.GetInt("Int") == 33);
+            REQUIRE(loadedDoc.GetString("String") == "some string");
+            REQUIRE(loadedDoc.GetString("StringWithEsc") == "\"Quote\" \\\\");
+            REQUIRE(loadedDoc.StartGetArray("Array") == 2);
+                REQUIRE(loadedDoc.GetString(1) == "second");
+            REQUIRE(loadedDoc.EndGetArray());
+        REQUIRE(loadedDoc.EndGetObject());
+
+        REQUIRE(loadedDoc.StartSetObject("Obj1"));
+            REQUIRE(loadedDoc.SetString("String", "another string"));
+        REQUIRE(loadedDoc.EndSetObject());
+
+        childrenDocuments = loadedDoc.GetChildren();
+
+        // reloading drops the modification and the previous in-situ buffer
+        REQUIRE(loadedDoc.Load(Kmplete::JsonLoadMode::InSitu));
+        REQUIRE(loadedDoc.StartGetObject("Obj1"));
+            REQUIRE(loadedDoc.GetString("String") == "some string");
+        REQUIRE(loadedDoc.EndGetObject());
+    }
+
+    // children must not reference the buffer of the destroyed document
+    REQUIRE(childrenDocuments.size() == size_t(1));
+    auto& childDoc = childrenDocuments.front().second;
+    REQUIRE(childDoc->GetString("String") == "another string");
+    REQUIRE(childDoc->StartGetArray("Array") == 2);
+        REQUIRE(childDoc->GetString(0) == "first");
+    REQUIRE(childDoc->EndGetArray());
+
+    Kmplete::JsonDocument invalidPathDoc;
+    REQUIRE_FALSE(invalidPathDoc.Load(Kmplete::Filesystem::GetCurrentFilepath().append("non-exist.json"), Kmplete::JsonLoadMode::InSitu));
+    REQUIRE(invalidPathDoc.HasError());
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Json document in-situ reload", "[json][reader][writer][document]")
+{
+    const auto filepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_test_temp_insitu_reload.json");
+
+    const auto saveDocument = [&filepath](const Kmplete::String& value) {
+        Kmplete::JsonDocument rootDoc;
+        REQUIRE(rootDoc.SetString("TopLevelString", value));
+        REQUIRE(rootDoc.StartSetObject("Obj1"));
+            REQUIRE(rootDoc.SetString("String", value));
+        REQUIRE(rootDoc.EndSetObject());
+        REQUIRE(rootDoc.Save(filepath));
+    };
+
+    saveDocument("short");
+    Kmplete::JsonDocument loadedDoc(filepath, Kmplete::JsonLoadMode::InSitu);
+    REQUIRE_FALSE(loadedDoc.HasError());
+    REQUIRE(loadedDoc.GetString("TopLevelString") == "short");
+
+    // storage of the previous load is not referenced by anyone, so the reload reuses it, growing the buffer
+    saveDocument("a considerably longer string than the previous one");
+    REQUIRE(loadedDoc.Load(Kmplete::JsonLoadMode::InSitu));
+    REQUIRE(loadedDoc.GetString("TopLevelString") == "a considerably longer string than the previous one");
+
+    // extracted children reference the storage, so the next reload must not overwrite it
+    auto childrenDocuments = loadedDoc.ExtractChildren();
+    REQUIRE(childrenDocuments.size() == size_t(1));
+
+    saveDocument("shrunk");
+    REQUIRE(loadedDoc.Load(Kmplete::JsonLoadMode::InSitu));
+    REQUIRE(loadedDoc.GetString("TopLevelString") == "shrunk");
+    REQUIRE(loadedDoc.StartGetObject("Obj1"));
+        REQUIRE(loadedDoc.GetString("String") == "shrunk");
+    REQUIRE(loadedDoc.EndGetObject());
+    REQUIRE(childrenDocuments.front().second->GetString("String") == "a considerably longer string than the previous one");
+
+    // reused storage held the previous content, so a failed reload leaves the document empty
+    {
+        std::ofstream brokenFile(filepath, std::ios::trunc);
+        brokenFile << "{ \"TopLevelString\": ";
+    }
+    REQUIRE_FALSE(loadedDoc.Load(Kmplete::JsonLoadMode::InSitu));
+    REQUIRE(loadedDoc.HasError());
+    REQUIRE(loadedDoc.GetString("TopLevelString", "default") == "default");
+
+    saveDocument("restored");
+    REQUIRE(loadedDoc.Load(Kmplete::JsonLoadMode::InSitu));
+    REQUIRE_FALSE(loadedDoc.HasError());
+    REQUIRE(loadedDoc.GetString("TopLevelString") == "restored");
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Json document extract children", "[json][reader][writer][document]")
+{
+    const auto filepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_test_temp_extract.json");
+
+    {
+        Kmplete::JsonDocument rootDoc;
+        REQUIRE(rootDoc.SetInt("TopLevelInt", 5));
+        REQUIRE(rootDoc.StartSetObject("Obj1"));
+            REQUIRE(rootDoc.SetString("String", "first string"));
+        REQUIRE(rootDoc.EndSetObject());
+        REQUIRE(rootDoc.StartSetObject("Obj2"));
+            REQUIRE(rootDoc.SetString("String", "second string"));
+            REQUIRE(rootDoc.StartSetArray("Array"));
+                REQUIRE(rootDoc.SetInt(0, 1));
+                REQUIRE(rootDoc.SetInt(1, 2));
+            REQUIRE(rootDoc.EndSetArray());
+        REQUIRE(rootDoc.EndSetObject());
+        REQUIRE(rootDoc.Save(filepath));
+    }
+
+    Kmplete::Vector<Kmplete::Pair<Kmplete::String, Kmplete::Ptr<Kmplete::JsonDocument>>> childrenDocuments;
+
+    {
+        Kmplete::JsonDocument loadedDoc(filepath, Kmplete::JsonLoadMode::InSitu);
+        REQUIRE_FALSE(loadedDoc.HasError());
+
+        childrenDocuments = loadedDoc.ExtractChildren();
+        REQUIRE(childrenDocuments.size() == size_t(2));
+
+        // non-object members stay in the document, extracted ones are gone
+        REQUIRE(loadedDoc.GetInt("TopLevelInt") == 5);
+        REQUIRE_FALSE(loadedDoc.StartGetObject("Obj1"));
+        REQUIRE(loadedDoc.GetChildren().empty());
+        REQUIRE(loadedDoc.GetChildren(false).size() == size_t(1));
+    }
+
+    // extracted children keep the memory of the destroyed document alive
+    REQUIRE(childrenDocuments[0].first == "Obj1");
+    REQUIRE(childrenDocuments[0].second->GetString("String") == "first string");
+    REQUIRE(childrenDocuments[1].first == "Obj2");
+    auto& secondChild = childrenDocuments[1].second;
+    REQUIRE(secondChild->GetString("String") == "second string");
+    REQUIRE(secondChild->StartSetArray("Array", false));
+        REQUIRE(secondChild->SetInt(2, 3));
+    REQUIRE(secondChild->EndSetArray());
+    REQUIRE(secondChild->StartGetArray("Array") == 3);
+        REQUIRE(secondChild->GetInt(0) == 1);
+        REQUIRE(secondChild->GetInt(2) == 3);
+    REQUIRE(secondChild->EndGetArray());
+
+    Kmplete::JsonDocument everythingDoc(filepath);
+    childrenDocuments = everythingDoc.ExtractChildren(false);
+    REQUIRE(childrenDocuments.size() == size_t(3));
+    REQUIRE(everythingDoc.GetView().GetChildren(false).empty());
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Json document add children by move", "[json][reader][writer][document]")
+{
+    Kmplete::JsonDocument rootDoc;
+
+    {
+        Kmplete::JsonDocument childDoc;
+        REQUIRE(childDoc.SetString("String", "moved string"));
+        REQUIRE(rootDoc.AddChildDocument("Child", std::move(childDoc)));
+        REQUIRE(childDoc.GetChildren(false).empty());
+
+        Kmplete::JsonDocument anotherChildDoc;
+        REQUIRE(anotherChildDoc.SetInt("Int", 7));
+        REQUIRE_FALSE(rootDoc.AddChildDocument("Child", std::move(anotherChildDoc), false));
+        REQUIRE_FALSE(rootDoc.AddChildDocument("", std::move(anotherChildDoc)));
+        REQUIRE_FALSE(rootDoc.AddChildDocument("Self", std::move(rootDoc)));
+        REQUIRE(anotherChildDoc.GetInt("Int") == 7);
+    }
+
+    REQUIRE(rootDoc.StartGetObject("Child"));
+        REQUIRE(rootDoc.GetString("String") == "moved string");
+    REQUIRE(rootDoc.EndGetObject());
+
+    // moving extracted children back and forth doesn't copy them
+    auto childrenDocuments = rootDoc.ExtractChildren();
+    REQUIRE(childrenDocuments.size() == size_t(1));
+    REQUIRE(rootDoc.AddChildDocument("ChildAgain", std::move(*childrenDocuments.front().second)));
+    childrenDocuments.clear();
+
+    REQUIRE(rootDoc.StartGetObject("ChildAgain"));
+        REQUIRE(rootDoc.GetString("String") == "moved string");
+    REQUIRE(rootDoc.EndGetObject());
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Json document views and composite save", "[json][reader][writer][document]")
+{
+    const auto filepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_test_temp_composite.json");
+
+    Kmplete::JsonDocument firstDoc;
+    REQUIRE(firstDoc.SetInt("Int", 1));
+    REQUIRE(firstDoc.StartSetObject("Nested"));
+        REQUIRE(firstDoc.SetString("String", "nested string"));
+    REQUIRE(firstDoc.EndSetObject());
+
+    Kmplete::JsonDocument secondDoc;
+    REQUIRE(secondDoc.SetDouble("Double", 2.5));
+
+    const auto firstView = firstDoc.GetView();
+    REQUIRE(firstView.IsValid());
+    REQUIRE(firstView.IsObject());
+    REQUIRE(firstView.GetChildren().size() == size_t(1));
+    REQUIRE(firstView.GetChildren(false).size() == size_t(2));
+    REQUIRE(firstView.GetChild("Nested").IsObject());
+    REQUIRE_FALSE(firstView.GetChild("NonExisting").IsValid());
+    REQUIRE(firstView.ToString(false) == firstDoc.ToString(false));
+
+    const Kmplete::JsonView invalidView;
+    REQUIRE_FALSE(invalidView.IsValid());
+    REQUIRE(invalidView.GetChildren().empty());
+    REQUIRE(invalidView.ToString().empty());
+
+    REQUIRE(Kmplete::JsonDocument::SaveComposite(filepath, { {"First", firstView}, {"Second", secondDoc.GetView()}, {"Invalid", invalidView} }));
+
+    Kmplete::JsonDocument loadedDoc(filepath);
+    REQUIRE_FALSE(loadedDoc.HasError());
+    REQUIRE(loadedDoc.GetChildren().size() == size_t(2));
+    REQUIRE(loadedDoc.StartGetObject("First"));
+        REQUIRE(loadedDoc.GetInt("Int") == 1);
+        REQUIRE(loadedDoc.StartGetObject("Nested"));
+            REQUIRE(loadedDoc.GetString("String") == "nested string");
+        REQUIRE(loadedDoc.EndGetObject());
+    REQUIRE(loadedDoc.EndGetObject());
+    REQUIRE(loadedDoc.StartGetObject("Second"));
+        REQUIRE(loadedDoc.GetDouble("Double") == 2.5);
+    REQUIRE(loadedDoc.EndGetObject());
+}
+//--------------------------------------------------------------------------
+
+
 TEST_CASE("Json document save with unescaped quotes", "[json][reader][writer][document]")
 {
     const auto settingsFilepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_test_temp_unescaped.json");
@@ -429,3 +679,98 @@ TEST_CASE("Json document save/load with cyrillic path", "[json][reader][writer][
     REQUIRE(loadedDoc.GetInt("AnInt") == 13);
 }
 //--------------------------------------------------------------------------
+
+
+
+// Hidden from the default run, e.g.: JsonLib_UnitTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("Json document load modes", "[.][benchmark][json][document]")
+{
+    const auto filepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_benchmark_temp.json");
+
+    {
+        Kmplete::JsonDocument rootDoc;
+        REQUIRE(rootDoc.StartSetArray("Assets"));
+        for (auto i = 0; i < 200000; i++)
+        {
+            REQUIRE(rootDoc.StartSetObject(i));
+                REQUIRE(rootDoc.SetString("Name", "SomeAssetName_" + std::to_string(i)));
+                REQUIRE(rootDoc.SetString("Path", "Assets/Textures/Environment/some_asset_texture_" + std::to_string(i) + ".png"));
+                REQUIRE(rootDoc.SetUInt64("Sid", Kmplete::UInt64(i) * 2654435761ULL));
+                REQUIRE(rootDoc.SetDouble("Scale", 0.5 * i));
+            REQUIRE(rootDoc.EndSetObject());
+        }
+        REQUIRE(rootDoc.EndSetArray());
+        REQUIRE(rootDoc.Save(filepath, false));
+    }
+
+    BENCHMARK("Stream")
+    {
+        Kmplete::JsonDocument document;
+        return document.Load(filepath, Kmplete::JsonLoadMode::Stream);
+    };
+
+    BENCHMARK("InSitu")
+    {
+        Kmplete::JsonDocument document;
+        return document.Load(filepath, Kmplete::JsonLoadMode::InSitu);
+    };
+}
+//--------------------------------------------------------------------------
+
+
+
+// Hidden from the default run, e.g.: JsonLib_UnitTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("Json document children round-trip", "[.][benchmark][json][document]")
+{
+    const auto filepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_benchmark_children_temp.json");
+    const auto savedFilepath = Kmplete::Filesystem::GetCurrentFilepath().append("json_document_benchmark_children_saved_temp.json");
+
+    {
+        // settings-like file of several megabytes: a few subsystems with many entries each
+        Kmplete::JsonDocument rootDoc;
+        for (auto subsystem = 0; subsystem < 16; subsystem++)
+        {
+            REQUIRE(rootDoc.StartSetObject(("Subsystem_" + std::to_string(subsystem)).c_str()));
+                REQUIRE(rootDoc.StartSetArray("Entries"));
+                for (auto i = 0; i < 5000; i++)
+                {
+                    REQUIRE(rootDoc.StartSetObject(i));
+                        REQUIRE(rootDoc.SetString("Name", "SomeEntryName_" + std::to_string(i)));
+                        REQUIRE(rootDoc.SetString("Value", "Some/Longer/Entry/Value/" + std::to_string(i)));
+                        REQUIRE(rootDoc.SetInt("Index", i));
+                    REQUIRE(rootDoc.EndSetObject());
+                }
+                REQUIRE(rootDoc.EndSetArray());
+            REQUIRE(rootDoc.EndSetObject());
+        }
+        REQUIRE(rootDoc.Save(filepath, false));
+    }
+
+    BENCHMARK("Copy children")
+    {
+        Kmplete::JsonDocument document(filepath, Kmplete::JsonLoadMode::InSitu);
+        const auto children = document.GetChildren();
+
+        Kmplete::JsonDocument summaryDocument;
+        for (const auto& [name, child] : children)
+        {
+            summaryDocument.AddChildDocument(name, *child);
+        }
+        return summaryDocument.Save(savedFilepath, false);
+    };
+
+    BENCHMARK("Move children and save views")
+    {
+        Kmplete::JsonDocument document(filepath, Kmplete::JsonLoadMode::InSitu);
+        const auto children = document.ExtractChildren();
+
+        Kmplete::Vector<Kmplete::Pair<Kmplete::String, Kmplete::JsonView>> views;
+        views.reserve(children.size());
+        for (const auto& [name, child] : children)
+        {
+            views.emplace_back(name, child->GetView());
+        }
+        return Kmplete::JsonDocument::SaveComposite(savedFilepath, views, false);
+    };
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "Kmplete/Profile/profiler.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <rapidjson/pointer.h>
 
 
 TEST_CASE("Rapidjson empty string", "[json][reader]")
@@ -522,4 +524,115 @@ TEST_CASE("Json reader negative", "[json][reader]")
         REQUIRE(reader.GetUInt64(-1) == 0u);
     REQUIRE(reader.EndArray()); // Group2
 }
+//--------------------------------------------------------------------------
+
+
+namespace
+{
+    constexpr auto BenchmarkNestingDepth = 16;
+    constexpr auto BenchmarkEntriesCount = 40000;
+
+
+    //! Builds ~50 MB settings-like json: an array of entries, each entry has a chain of nested objects
+    //! ending with a couple of plain values and an array
+    Kmplete::String CreateDeeplyNestedJson()
+    {
+        Kmplete::String json;
+        json.reserve(52 * 1024 * 1024);
+        json += R"rjs({"Entries":[)rjs";
+
+        for (auto entry = 0; entry < BenchmarkEntriesCount; entry++)
+        {
+            json += entry == 0 ? "{" : ",{";
+            json += R"rjs("Name":"AssetDescriptionEntry_)rjs" + std::to_string(entry) + R"rjs(",)rjs";
+            for (auto depth = 0; depth < BenchmarkNestingDepth; depth++)
+            {
+                json += R"rjs("NestedSettingsLevel_)rjs" + std::to_string(depth) + R"rjs(":{"Enabled":true,"Padding":"lorem ipsum dolor sit amet",)rjs";
+            }
+            json += R"rjs("Value":)rjs" + std::to_string(entry) + R"rjs(,"Scale":1.5,"Flags":[true,false,true,false])rjs";
+            json.append(BenchmarkNestingDepth, '}');
+            json += "}";
+        }
+
+        json += "]}";
+        return json;
+    }
+    //--------------------------------------------------------------------------
+}
+
+
+// Hidden from the default run, e.g.: JsonLib_UnitTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("Json reader deep nesting traversal", "[.][benchmark][json][reader]")
+{
+    const auto json = CreateDeeplyNestedJson();
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    REQUIRE_FALSE(document.HasParseError());
+
+    Kmplete::Array<Kmplete::String, BenchmarkNestingDepth> levelNames;
+    for (auto depth = 0; depth < BenchmarkNestingDepth; depth++)
+    {
+        levelNames[depth] = "NestedSettingsLevel_" + std::to_string(depth);
+    }
+
+    BENCHMARK("JsonReader")
+    {
+        Kmplete::JsonReader reader(document);
+        Kmplete::Int64 sum = 0;
+
+        const auto entriesCount = reader.StartArray("Entries");
+        for (auto entry = 0; entry < entriesCount; entry++)
+        {
+            reader.StartObject(entry);
+            for (auto depth = 0; depth < BenchmarkNestingDepth; depth++)
+            {
+                reader.StartObject(levelNames[depth].c_str());
+                sum += reader.GetBool("Enabled");
+            }
+
+            sum += reader.GetInt("Value");
+            const auto flagsCount = reader.StartArray("Flags");
+            for (auto flag = 0; flag < flagsCount; flag++)
+            {
+                sum += reader.GetBool(flag);
+            }
+            reader.EndArray();
+
+            for (auto depth = 0; depth < BenchmarkNestingDepth; depth++)
+            {
+                reader.EndObject();
+            }
+            reader.EndObject();
+        }
+        reader.EndArray();
+
+        return sum;
+    };
+
+    // the way the reader used to work: every step re-resolves the whole path from the root
+    BENCHMARK("JSON Pointer path re-resolution")
+    {
+        Kmplete::Int64 sum = 0;
+
+        const auto entriesCount = int(document["Entries"].Size());
+        for (auto entry = 0; entry < entriesCount; entry++)
+        {
+            auto path = "/Entries/" + std::to_string(entry);
+            for (auto depth = 0; depth < BenchmarkNestingDepth; depth++)
+            {
+                path += "/" + levelNames[depth];
+                sum += rapidjson::Pointer((path + "/Enabled").c_str()).Get(document)->GetBool();
+            }
+
+            sum += rapidjson::Pointer((path + "/Value").c_str()).Get(document)->GetInt();
+            const auto* flags = rapidjson::Pointer((path + "/Flags").c_str()).Get(document);
+            for (const auto& flag : flags->GetArray())
+            {
+                sum += flag.GetBool();
+            }
+        }
+
+        return sum;
+    };
+}
 //--------------------------------------------------------------------------
\ No newline at end of file
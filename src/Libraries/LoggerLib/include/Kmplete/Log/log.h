@@ -44,9 +44,22 @@ namespace Kmplete
     //! when an application loads its settings (including logger settings) all messages
     //! from that storage moved to sinks according to those settings.
     //! Filtering of messages is done by a levels mechanism (from 0 to 5): level 0 keeps
-    //! all the messages while level 5 keeps only critical ones.
+    //! all the messages while level 5 keeps only critical ones. The level is checked by
+    //! the logging macros before their arguments are evaluated and formatted.
+    //! After initialization messages are written by a background thread through a queue
+    //! of a configurable size, when the queue is full the overflow policy decides whether
+    //! the logging thread waits, the oldest queued message is overwritten or the new one
+    //! is discarded, overwritten and discarded messages are counted.
     class KMP_LOG_API Log
     {
+    public:
+        enum OverflowPolicy : int
+        {
+            OverflowPolicyBlock = 0,
+            OverflowPolicyOverrunOldest = 1,
+            OverflowPolicyDiscardNew = 2
+        };
+
     public:
         static constexpr auto SettingsEntryName = "Log";
         static constexpr auto FilenameStr = "Filename";
@@ -57,6 +70,8 @@ namespace Kmplete
         static constexpr auto OutputStringBufferStr = "OutputStringBuffer";
         static constexpr auto LevelStr = "Level";
         static constexpr auto LevelFlushStr = "LevelFlush";
+        static constexpr auto QueueSizeStr = "QueueSize";
+        static constexpr auto OverflowPolicyStr = "OverflowPolicy";
 
         struct LogSettings
         {
@@ -68,6 +83,8 @@ namespace Kmplete
             bool outputStringBuffer = false;
             int level = spdlog::level::trace;
             int levelFlush = spdlog::level::trace;
+            int queueSize = 8192;
+            int overflowPolicy = OverflowPolicyBlock;
         };
 
     public:
@@ -80,6 +97,32 @@ namespace Kmplete
 
         KMP_NODISCARD static std::stringstream& StringLogOutput();
 
+        KMP_NODISCARD static UInt64 GetOverrunMessagesCount();
+        KMP_NODISCARD static UInt64 GetDiscardedMessagesCount();
+        KMP_NODISCARD static UInt64 GetDroppedMessagesCount();
+
+        KMP_NODISCARD static bool ShouldLog(spdlog::level::level_enum level) noexcept { return _logger && _logger->should_log(level); }
+
+        //! Formats a class function message prefixed with the class name in a single pass
+        //! into a stack buffer, used by the class logging macros after the level check
+        template <typename... Args>
+        static void ClassMessage(spdlog::level::level_enum level, const char* className, spdlog::format_string_t<Args...> fmt, Args&&... args)
+        {
+            if (not _logger)
+            {
+                return;
+            }
+
+            spdlog::memory_buf_t buffer;
+            buffer.append(std::string_view(className));
+            buffer.append(std::string_view(": "));
+            fmt::format_to(fmt::appender(buffer), fmt, std::forward<Args>(args)...);
+            _logger->log(level, spdlog::string_view_t(buffer.data(), buffer.size()));
+        }
+
+        template <typename... Args>
+        static void Message(spdlog::level::level_enum level, spdlog::format_string_t<Args...> fmt, Args&&... args) { if (_logger) _logger->log(level, fmt, std::forward<Args>(args)...); }
+
         template <typename... Args>
         static void Trace(spdlog::format_string_t<Args...> fmt, Args&&... args) { if (_logger) _logger->trace(fmt, std::forward<Args>(args)...); }
 
@@ -118,21 +161,24 @@ struct fmt::formatter<Kmplete::Filepath> : fmt::formatter<Kmplete::String>
 
 
 //! Two sets of logging macros for all levels: the first set is used for a class functions (with class name printed first),
-//! while the second one is used for any other parts of code
+//! while the second one is used for any other parts of code. Arguments are not evaluated for filtered out levels.
 //! @see log_class_macro.h
 
-#define KMP_LOG_TRACE(...)          ::Kmplete::Log::Trace("{}: {}", GetLogClassName(), fmt::format(__VA_ARGS__))
-#define KMP_LOG_DEBUG(...)          ::Kmplete::Log::Debug("{}: {}", GetLogClassName(), fmt::format(__VA_ARGS__))
-#define KMP_LOG_INFO(...)           ::Kmplete::Log::Info("{}: {}", GetLogClassName(), fmt::format(__VA_ARGS__))
-#define KMP_LOG_WARN(...)           ::Kmplete::Log::Warn("{}: {}", GetLogClassName(), fmt::format(__VA_ARGS__))
-#define KMP_LOG_ERROR(...)          ::Kmplete::Log::Error("{}: {}", GetLogClassName(), fmt::format(__VA_ARGS__))
-#define KMP_LOG_CRITICAL(...)       ::Kmplete::Log::Critical("{}: {}", GetLogClassName(), fmt::format(__VA_ARGS__)); KMP_DEBUGBREAK
-
-#define KMP_LOG_TRACE_FN(...)       ::Kmplete::Log::Trace(__VA_ARGS__)
-#define KMP_LOG_DEBUG_FN(...)       ::Kmplete::Log::Debug(__VA_ARGS__)
-#define KMP_LOG_INFO_FN(...)        ::Kmplete::Log::Info(__VA_ARGS__)
-#define KMP_LOG_WARN_FN(...)        ::Kmplete::Log::Warn(__VA_ARGS__)
-#define KMP_LOG_ERROR_FN(...)       ::Kmplete::Log::Error(__VA_ARGS__)
-#define KMP_LOG_CRITICAL_FN(...)    ::Kmplete::Log::Critical(__VA_ARGS__); KMP_DEBUGBREAK
+#define _KMP_LOG_CLASS(level, ...)  (::Kmplete::Log::ShouldLog(level) ? ::Kmplete::Log::ClassMessage(level, GetLogClassName(), __VA_ARGS__) : void())
+#define _KMP_LOG_FN(level, ...)     (::Kmplete::Log::ShouldLog(level) ? ::Kmplete::Log::Message(level, __VA_ARGS__) : void())
+
+#define KMP_LOG_TRACE(...)          _KMP_LOG_CLASS(spdlog::level::trace, __VA_ARGS__)
+#define KMP_LOG_DEBUG(...)          _KMP_LOG_CLASS(spdlog::level::debug, __VA_ARGS__)
+#define KMP_LOG_INFO(...)           _KMP_LOG_CLASS(spdlog::level::info, __VA_ARGS__)
+#define KMP_LOG_WARN(...)           _KMP_LOG_CLASS(spdlog::level::warn, __VA_ARGS__)
+#define KMP_LOG_ERROR(...)          _KMP_LOG_CLASS(spdlog::level::err, __VA_ARGS__)
+#define KMP_LOG_CRITICAL(...)       _KMP_LOG_CLASS(spdlog::level::critical, __VA_ARGS__); KMP_DEBUGBREAK
+
+#define KMP_LOG_TRACE_FN(...)       _KMP_LOG_FN(spdlog::level::trace, __VA_ARGS__)
+#define KMP_LOG_DEBUG_FN(...)       _KMP_LOG_FN(spdlog::level::debug, __VA_ARGS__)
+#define KMP_LOG_INFO_FN(...)        _KMP_LOG_FN(spdlog::level::info, __VA_ARGS__)
+#define KMP_LOG_WARN_FN(...)        _KMP_LOG_FN(spdlog::level::warn, __VA_ARGS__)
+#define KMP_LOG_ERROR_FN(...)       _KMP_LOG_FN(spdlog::level::err, __VA_ARGS__)
+#define KMP_LOG_CRITICAL_FN(...)    _KMP_LOG_FN(spdlog::level::critical, __VA_ARGS__); KMP_DEBUGBREAK
 
 #endif
@@ -39,6 +39,23 @@ namespace Kmplete
         };
 
         static Vector<BootMessage> bootMessages;
+
+
+        spdlog::async_overflow_policy ToSpdlogOverflowPolicy(int overflowPolicy)
+        {
+            switch (overflowPolicy)
+            {
+            case Log::OverflowPolicyOverrunOldest:
+                return spdlog::async_overflow_policy::overrun_oldest;
+
+            case Log::OverflowPolicyDiscardNew:
+                return spdlog::async_overflow_policy::discard_new;
+
+            default:
+                return spdlog::async_overflow_policy::block;
+            }
+        }
+        //--------------------------------------------------------------------------
     }
     //--------------------------------------------------------------------------
     
@@ -80,7 +97,9 @@ namespace Kmplete
     void Log::Initialize(const String& programName, const Filepath& logsDirectory)
     {
         spdlog::drop_all();
-        spdlog::init_thread_pool(1024, 1);
+        spdlog::init_thread_pool(static_cast<size_t>(std::max(logSettings.queueSize, 1)), 1);
+
+        const auto overflowPolicy = ToSpdlogOverflowPolicy(logSettings.overflowPolicy);
 
         if (logSettings.enabled)
         {
@@ -127,14 +146,14 @@ namespace Kmplete
                 sink->flush();
             });
 
-            _logger = CreatePtr<spdlog::async_logger>(programName, begin(logSinks), end(logSinks), spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+            _logger = CreatePtr<spdlog::async_logger>(programName, begin(logSinks), end(logSinks), spdlog::thread_pool(), overflowPolicy);
             _logger->set_level(coreLevel);
             _logger->flush_on(coreLevelFlush);
         }
         else
         {
             const auto nullSink = CreatePtr<spdlog::sinks::null_sink_mt>();
-            _logger = CreatePtr<spdlog::async_logger>(programName, nullSink, spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+            _logger = CreatePtr<spdlog::async_logger>(programName, nullSink, spdlog::thread_pool(), overflowPolicy);
         }
 
         spdlog::register_logger(_logger);
@@ -175,5 +194,25 @@ namespace Kmplete
         return stringStream;
     }
     //--------------------------------------------------------------------------
+
+    UInt64 Log::GetOverrunMessagesCount()
+    {
+        const auto threadPool = spdlog::thread_pool();
+        return threadPool ? static_cast<UInt64>(threadPool->overrun_counter()) : 0ULL;
+    }
+    //--------------------------------------------------------------------------
+
+    UInt64 Log::GetDiscardedMessagesCount()
+    {
+        const auto threadPool = spdlog::thread_pool();
+        return threadPool ? static_cast<UInt64>(threadPool->discard_counter()) : 0ULL;
+    }
+    //--------------------------------------------------------------------------
+
+    UInt64 Log::GetDroppedMessagesCount()
+    {
+        return GetOverrunMessagesCount() + GetDiscardedMessagesCount();
+    }
+    //--------------------------------------------------------------------------
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Log/log_class_macro.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <filesystem>
+
+using namespace Kmplete;
+
+
+static void InitializeTestLog(int level, int queueSize = 8192, int overflowPolicy = Log::OverflowPolicyBlock, bool outputStringBuffer = true)
+{
+    Log::LogSettings settings;
+    settings.outputConsole = false;
+    settings.outputFile = false;
+    settings.outputStringBuffer = outputStringBuffer;
+    settings.level = level;
+    settings.levelFlush = spdlog::level::critical;
+    settings.queueSize = queueSize;
+    settings.overflowPolicy = overflowPolicy;
+    Log::SetSettings(settings);
+
+    Log::StringLogOutput().str("");
+    Log::Initialize("LogTests", std::filesystem::current_path());
+}
+//--------------------------------------------------------------------------
+
+static size_t CountOccurrences(const String& text, const String& pattern)
+{
+    size_t count = 0;
+    for (auto position = text.find(pattern); position != String::npos; position = text.find(pattern, position + pattern.size()))
+    {
+        count++;
+    }
+
+    return count;
+}
+//--------------------------------------------------------------------------
+
+
+namespace
+{
+    class LogTestsClass
+    {
+        KMP_LOG_CLASSNAME(LogTestsClass)
+
+    public:
+        void LogWarning(int value) const
+        {
+            KMP_LOG_WARN("class message {}", value);
+        }
+
+        void LogTrace(int& evaluationsCount) const
+        {
+            KMP_LOG_TRACE("filtered class message {}", ++evaluationsCount);
+        }
+
+        void LogInfoThroughput(int value) const
+        {
+            KMP_LOG_INFO("benchmark class message {} '{}'", value, "text");
+        }
+
+        void LogTraceThroughput(int value) const
+        {
+            KMP_LOG_TRACE("benchmark class message {} '{}'", value, "text");
+        }
+    };
+    //--------------------------------------------------------------------------
+}
+
+
+TEST_CASE("Log filters levels before evaluating arguments", "[log]")
+{
+    InitializeTestLog(spdlog::level::warn);
+
+    const LogTestsClass logTestsClass;
+    auto evaluationsCount = 0;
+
+    KMP_LOG_INFO_FN("filtered message {}", ++evaluationsCount);
+    logTestsClass.LogTrace(evaluationsCount);
+    REQUIRE(evaluationsCount == 0);
+
+    KMP_LOG_WARN_FN("free message {}", ++evaluationsCount);
+    logTestsClass.LogWarning(42);
+    REQUIRE(evaluationsCount == 1);
+
+    Log::Finalize();
+
+    const auto output = Log::StringLogOutput().str();
+    REQUIRE(output.find("filtered") == String::npos);
+    REQUIRE(output.find("| free message 1") != String::npos);
+    REQUIRE(output.find("| LogTestsClass: class message 42") != String::npos);
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Log counts messages discarded on queue overflow", "[log]")
+{
+    constexpr auto messagesCount = 10'000;
+
+    InitializeTestLog(spdlog::level::trace, 4, Log::OverflowPolicyDiscardNew);
+
+    for (auto i = 0; i < messagesCount; i++)
+    {
+        KMP_LOG_INFO_FN("overflow message {}", i);
+    }
+
+    const auto discardedCount = Log::GetDiscardedMessagesCount();
+    REQUIRE(Log::GetOverrunMessagesCount() == 0);
+    REQUIRE(Log::GetDroppedMessagesCount() == discardedCount);
+
+    Log::Finalize();
+
+    // every message is either written or counted as discarded
+    const auto writtenCount = CountOccurrences(Log::StringLogOutput().str(), "overflow message");
+    REQUIRE(writtenCount + discardedCount == messagesCount);
+    REQUIRE(Log::GetDroppedMessagesCount() == 0);
+}
+//--------------------------------------------------------------------------
+
+
+// Hidden from the default run, e.g.: LoggerLib_UnitTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("Log throughput", "[.][benchmark][log]")
+{
+    constexpr auto messagesCount = 1000;
+    const LogTestsClass logTestsClass;
+
+    // no sinks, so only the caller's side (level check, formatting, enqueueing) is measured
+    InitializeTestLog(spdlog::level::info, 8192, Log::OverflowPolicyBlock, false);
+
+    BENCHMARK("Disabled level, class macro x1000")
+    {
+        for (auto i = 0; i < messagesCount; i++)
+        {
+            logTestsClass.LogTraceThroughput(i);
+        }
+    };
+
+    BENCHMARK("Disabled level, function macro x1000")
+    {
+        for (auto i = 0; i < messagesCount; i++)
+        {
+            KMP_LOG_TRACE_FN("benchmark message {} '{}'", i, "text");
+        }
+    };
+
+    BENCHMARK("Enabled level, class macro x1000")
+    {
+        for (auto i = 0; i < messagesCount; i++)
+        {
+            logTestsClass.LogInfoThroughput(i);
+        }
+    };
+
+    BENCHMARK("Enabled level, function macro x1000")
+    {
+        for (auto i = 0; i < messagesCount; i++)
+        {
+            KMP_LOG_INFO_FN("benchmark message {} '{}'", i, "text");
+        }
+    };
+
+    Log::Finalize();
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
@@ -85,5 +85,18 @@ namespace Kmplete
             return (value - lower < higher - value) ? lower : higher;
         }
         //--------------------------------------------------------------------------
+
+        //! Rounds the value up to the nearest multiple of the alignment, alignment must be a power of 2
+        template<typename ValueType> requires (IsUnsigned<ValueType>::value)
+        KMP_NODISCARD constexpr ValueType AlignUp(ValueType value, ValueType alignment)
+        {
+            if (alignment == 0)
+            {
+                return value;
+            }
+
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
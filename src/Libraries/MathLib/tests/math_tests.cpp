@@ -139,3 +139,31 @@ TEST_CASE("Math Log2", "[math]")
     REQUIRE_FALSE(hasValue);
 }
 //--------------------------------------------------------------------------
+
+
+
+TEST_CASE("Math AlignUp", "[math]")
+{
+    using namespace Kmplete::Math;
+
+    unsigned int result = 0;
+    REQUIRE_NOTHROW(result = AlignUp(0u, 256u));
+    REQUIRE(result == 0u);
+
+    REQUIRE_NOTHROW(result = AlignUp(1u, 256u));
+    REQUIRE(result == 256u);
+
+    REQUIRE_NOTHROW(result = AlignUp(256u, 256u));
+    REQUIRE(result == 256u);
+
+    REQUIRE_NOTHROW(result = AlignUp(257u, 4u));
+    REQUIRE(result == 260u);
+
+    REQUIRE_NOTHROW(result = AlignUp(13u, 0u));
+    REQUIRE(result == 13u);
+
+    uint64_t result64 = 0;
+    REQUIRE_NOTHROW(result64 = AlignUp(uint64_t(65537), uint64_t(65536)));
+    REQUIRE(result64 == uint64_t(131072));
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
@@ -8,28 +8,21 @@
 #include "Kmplete/Base/type_traits.h"
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/macro.h"
+#include "Kmplete/Base/platform.h"
+#include "Kmplete/Base/nullability.h"
 #include "Kmplete/Log/log_class_macro.h"
+#include "Kmplete/Profile/profiler_trace.h"
 
 #include <fstream>
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 
 namespace Kmplete
 {
-    //! Single profiling metrics unit
-    struct ProfileResult
-    {
-        String name;
-        std::chrono::high_resolution_clock::time_point start;
-        std::chrono::high_resolution_clock::time_point end;
-        std::thread::id threadId;
-    };
-    static_assert(IsMoveConstructible<ProfileResult>::value);
-    //--------------------------------------------------------------------------
-
-
     //! A scope-like object for profiling sessions, each such object represents
     //! some stage of the application (initialization, runtime, finalization)
     //! @see main.h in Kmplete engine library - function named "Main"
@@ -37,30 +30,86 @@ namespace Kmplete
     {
         String name;
         int profilesCount;
+        int droppedCount;
     };
     //--------------------------------------------------------------------------
 
 
+#if defined (KMP_COMPILER_MSVC)
+    #pragma warning(push)
+    #pragma warning(disable : 4324) // structure was padded due to alignment specifier
+#endif
+    //! Single-producer single-consumer ring of profiling results owned by one instrumented thread.
+    //! The owning thread pushes results without any locking, the profiler's writer thread drains them.
+    //! If the writer lags behind and the ring is full, results are dropped and counted instead of
+    //! blocking the instrumented thread. Once the owning thread exits, the buffer is marked retired
+    //! and gets released by the writer thread after the final drain
+    //! @see Profiler
+    class KMP_API ProfilerThreadBuffer
+    {
+        KMP_DISABLE_COPY_MOVE(ProfilerThreadBuffer)
+
+    public:
+        static constexpr UInt64 Capacity = 1ULL << 14;
+
+    public:
+        explicit ProfilerThreadBuffer(UInt32 threadIndex) noexcept;
+        ~ProfilerThreadBuffer() = default;
+
+        bool Push(const ProfileResult& result) noexcept;
+        UInt64 Drain(Vector<ProfileResult>& results);
+        void Discard() noexcept;
+
+        void Retire() noexcept;
+        KMP_NODISCARD bool IsRetired() const noexcept;
+
+        KMP_NODISCARD UInt32 GetThreadIndex() const noexcept;
+        KMP_NODISCARD UInt64 ExchangeDroppedCount() noexcept;
+
+    private:
+        static_assert((Capacity & (Capacity - 1)) == 0, "ProfilerThreadBuffer capacity must be a power of two");
+
+        const UInt32 _threadIndex;
+        alignas(64) std::atomic<UInt64> _head;
+        alignas(64) std::atomic<UInt64> _tail;
+        alignas(64) std::atomic<UInt64> _droppedCount;
+        std::atomic<bool> _retired;
+        Array<ProfileResult, Capacity> _results;
+    };
+    //--------------------------------------------------------------------------
+#if defined (KMP_COMPILER_MSVC)
+    #pragma warning(pop)
+#endif
+
+
     //! Global handler of profiling applications' and libraries' functions performance,
     //! responsible for collecting profiling metrics results, writing them in files
     //! according to the current session. All the profiling split to several levels
     //! (similar to levels of Log class) from level 0 (always profile - most important) 
     //! to level 4 (least important), level is defined in the "--profile_level" argument.
-    //! In order to mitigate number of accesses to a disk, profiling units are stored 
-    //! in a temporary storage (whose capacity is set when starting a session)
-    //! that flushes to a file when: 1) the number of profiling
-    //! units exceeds storage's capacity 2) the current session ends.
+    //! Every instrumented thread pushes its results into its own lock-free ring buffer,
+    //! a background writer thread (running while a session is active) drains the rings
+    //! periodically, encodes the results in the compact binary trace format and writes them
+    //! to the session file in batches whose capacity is set when starting a session,
+    //! so instrumented threads never wait for a lock or a disk.
+    //! Besides scope timings, counters (e.g. memory usage), frame marks and flow/async events
+    //! are recorded into the same session timeline, their names must have static storage too.
     //! This profiler is capable of turning profiling on/off at runtime (by default with
     //! an Alt+F11 shortcut). Initial activation flag is defined in the "--profile_on_demand" argument
     //! (false by default - profiler is active from the beginning, otherwise - activate manually).
     //! @see ProfilingSession
     //! @see ProfileResult
+    //! @see ProfilerThreadBuffer
+    //! @see ProfilerTrace
     //! @see ProfilerTimer
     class KMP_API Profiler
     {
         KMP_LOG_CLASSNAME(Profiler)
         KMP_DISABLE_COPY_MOVE(Profiler)
 
+    public:
+        static constexpr std::chrono::milliseconds WriterFlushInterval = std::chrono::milliseconds(10);
+
     public:
         KMP_NODISCARD static Profiler& Get();
 
@@ -73,6 +122,13 @@ namespace Kmplete
         void BeginSession(const String& name, const Filepath& filepath, int storageSize);
         void EndSession();
 
+        void RecordCounter(const char* name, double value, unsigned int level = ProfileLevelAlways);
+        void RecordFrameMark(const char* name = "Frame");
+        void RecordEvent(ProfileEventType type, const char* name, UInt64 id, unsigned int level = ProfileLevelAlways);
+
+        //! @return number of buffers of the instrumented threads that are alive or not released yet
+        KMP_NODISCARD size_t GetThreadBuffersCount();
+
     private:
         Profiler() noexcept;
         ~Profiler();
@@ -80,26 +136,46 @@ namespace Kmplete
         void _BeginSessionInternal(const String& name, const Filepath& filepath, int storageSize);
         void _EndSessionInternal();
 
-        void _WriteProfileHeader(std::ofstream& outputFileStream) const;
-        void _WriteProfileResults(std::ofstream& outputFileStream) const;
-        void _WriteProfileResultsToIntermediate() const;
-        void _WriteProfileResultsFromIntermediate(std::ofstream& outputFileStream) const;
-        void _WriteProfileFooter(std::ofstream& outputFileStream) const;
-        Filepath _CreateIntermediateFilepath(int intermediateCount) const;
-        void _BeginNewCycle();
+        KMP_NODISCARD bool _IsRecording(unsigned int level) const noexcept;
+        void _Record(ProfileResult result);
+
+        //! @return buffer of the calling thread or nullptr if the thread is exiting and its buffer has been retired
+        KMP_NODISCARD Nullable<ProfilerThreadBuffer*> _GetThreadBuffer();
+        KMP_NODISCARD Vector<ProfilerThreadBuffer*> _GetThreadBuffers();
+        void _DiscardThreadBuffers();
+        void _ReleaseRetiredThreadBuffers(const Vector<ProfilerThreadBuffer*>& retiredBuffers);
+
+        void _StartWriter();
+        void _StopWriter();
+        void _WriterLoop();
+        void _DrainThreadBuffers();
+        void _FlushTraceBuffer();
 
     private:
         friend class ProfilerTimer;
 
     private:
-        unsigned int _level;
-        bool _active;
+        std::atomic<unsigned int> _level;
+        std::atomic<bool> _active;
+        std::atomic<bool> _sessionActive;
         std::mutex _mutex;
         UPtr<ProfilingSession> _currentSession;
         Filepath _outputFilepath;
-        Vector<ProfileResult> _profileResults;
+        std::ofstream _outputFileStream;
         int _storageSize;
-        int _storeCycles;
+
+        std::mutex _threadBuffersMutex;
+        Vector<UPtr<ProfilerThreadBuffer>> _threadBuffers;
+        UInt32 _nextThreadIndex;
+
+        std::thread _writerThread;
+        std::mutex _writerMutex;
+        std::condition_variable _writerCondition;
+        bool _writerStopRequested;
+        ProfilerTrace::Encoder _traceEncoder;
+        Vector<ProfileResult> _drainedResults;
+        Vector<ProfilerThreadBuffer*> _retiredThreadBuffers;
+        int _pendingResultsCount;
     };
     //--------------------------------------------------------------------------
 
@@ -107,7 +183,8 @@ namespace Kmplete
     //! A timer for a single profiling metrics unit whose timing is defined
     //! by the lifetime of this object. If the level is of this timer is higher
     //! than the level set for profiling or the profiler is currently inactive,
-    //! this object's timing is skipped.
+    //! this object's timing is skipped. The name must outlive the profiling session
+    //! (profiling macros keep it in static storage), since only the pointer is recorded.
     //! @see Profiler
     class KMP_API ProfilerTimer
     {
@@ -122,7 +199,7 @@ namespace Kmplete
     private:
         const char* _name;
         const bool _skip;
-        std::chrono::high_resolution_clock::time_point _start;
+        Int64 _start;
     };
     //--------------------------------------------------------------------------
 
@@ -179,7 +256,18 @@ namespace Kmplete
 #define KMP_PROFILE_BEGIN_SESSION(name, filepath, storageSize) ::Kmplete::Profiler::Get().BeginSession(name, filepath, storageSize)
 #define KMP_PROFILE_END_SESSION() ::Kmplete::Profiler::Get().EndSession()
 
-//! The "meat" macro that formats metrics unit name
+//! Shortcut macros for recording counters, frame boundaries and flow/async events (relations between
+//! scopes across threads and operations spanning several frames, matched by id within the same name)
+#define KMP_PROFILE_COUNTER(name, value) ::Kmplete::Profiler::Get().RecordCounter(name, static_cast<double>(value))
+#define KMP_PROFILE_FRAME_MARK() ::Kmplete::Profiler::Get().RecordFrameMark()
+#define KMP_PROFILE_FLOW_BEGIN(name, id) ::Kmplete::Profiler::Get().RecordEvent(::Kmplete::ProfileEventType::FlowBegin, name, static_cast<::Kmplete::UInt64>(id))
+#define KMP_PROFILE_FLOW_STEP(name, id) ::Kmplete::Profiler::Get().RecordEvent(::Kmplete::ProfileEventType::FlowStep, name, static_cast<::Kmplete::UInt64>(id))
+#define KMP_PROFILE_FLOW_END(name, id) ::Kmplete::Profiler::Get().RecordEvent(::Kmplete::ProfileEventType::FlowEnd, name, static_cast<::Kmplete::UInt64>(id))
+#define KMP_PROFILE_ASYNC_BEGIN(name, id) ::Kmplete::Profiler::Get().RecordEvent(::Kmplete::ProfileEventType::AsyncBegin, name, static_cast<::Kmplete::UInt64>(id))
+#define KMP_PROFILE_ASYNC_END(name, id) ::Kmplete::Profiler::Get().RecordEvent(::Kmplete::ProfileEventType::AsyncEnd, name, static_cast<::Kmplete::UInt64>(id))
+
+//! The "meat" macro that formats metrics unit name, the final name has static storage
+//! since profiling results keep only a pointer to it
 #define _KMP_PROFILE_SCOPE_LINE2(name, line, level) \
     constexpr auto fixedNameCdecl##line      = ::Kmplete::ProfilerUtils::ReplaceString(name, "__cdecl ", "");\
     constexpr auto fixedNameKmplete##line    = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameCdecl##line.data, "Kmplete::", "");\
@@ -196,7 +284,7 @@ namespace Kmplete
     constexpr auto fixedNameVoidParams##line = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameVector##line.data, "(void)", "()");\
     constexpr auto fixedNameRapidjson##line  = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameVoidParams##line.data, "rapidjson::GenericDocument<rapidjson::UTF8<char>,rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>,rapidjson::CrtAllocator>", "rapidjson::Document");\
     constexpr auto fixedName_T##line         = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameRapidjson##line.data, "_T *", "");\
-    constexpr auto fixedNameKHR_T##line      = ::Kmplete::ProfilerUtils::ReplaceString(fixedName_T##line.data, "KHR_T *", "");\
+    static constexpr auto fixedNameKHR_T##line = ::Kmplete::ProfilerUtils::ReplaceString(fixedName_T##line.data, "KHR_T *", "");\
     ::Kmplete::ProfilerTimer timer##line(fixedNameKHR_T##line.data, level)
 #define _KMP_PROFILE_SCOPE_LINE(name, line, level) _KMP_PROFILE_SCOPE_LINE2(name, line, level)
 #define KMP_PROFILE_SCOPE(name, level) _KMP_PROFILE_SCOPE_LINE(name, __LINE__, level)
@@ -242,7 +330,7 @@ namespace Kmplete
     constexpr auto fixedNameVoidParams##line = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameVector##line.data, "(void)", "()");\
     constexpr auto fixedNameRapidjson##line  = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameVoidParams##line.data, "rapidjson::GenericDocument<rapidjson::UTF8<char>,rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>,rapidjson::CrtAllocator>", "rapidjson::Document");\
     constexpr auto fixedName_T##line         = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameRapidjson##line.data, "_T *", "");\
-    constexpr auto fixedNameKHR_T##line      = ::Kmplete::ProfilerUtils::ReplaceString(fixedName_T##line.data, "KHR_T *", "");\
+    static constexpr auto fixedNameKHR_T##line = ::Kmplete::ProfilerUtils::ReplaceString(fixedName_T##line.data, "KHR_T *", "");\
     _constructorProfilerTimer->SetName(fixedNameKHR_T##line.data);\
     _constructorProfilerTimer.reset(nullptr);
 
@@ -263,7 +351,7 @@ namespace Kmplete
     constexpr auto fixedNameVoidParams##line = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameVector##line.data, "(void)", "()");\
     constexpr auto fixedNameRapidjson##line  = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameVoidParams##line.data, "rapidjson::GenericDocument<rapidjson::UTF8<char>,rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator>,rapidjson::CrtAllocator>", "rapidjson::Document");\
     constexpr auto fixedName_T##line         = ::Kmplete::ProfilerUtils::ReplaceString(fixedNameRapidjson##line.data, "_T *", "");\
-    constexpr auto fixedNameKHR_T##line      = ::Kmplete::ProfilerUtils::ReplaceString(fixedName_T##line.data, "KHR_T *", "");\
+    static constexpr auto fixedNameKHR_T##line = ::Kmplete::ProfilerUtils::ReplaceString(fixedName_T##line.data, "KHR_T *", "");\
     _constructorProfilerTimer->SetName(fixedNameKHR_T##line.data);\
     _constructorProfilerTimer.reset();
 
@@ -271,6 +359,14 @@ namespace Kmplete
 #define KMP_PROFILE_BEGIN_SESSION(name, filepath, storageSize)
 #define KMP_PROFILE_END_SESSION()
 
+#define KMP_PROFILE_COUNTER(name, value)
+#define KMP_PROFILE_FRAME_MARK()
+#define KMP_PROFILE_FLOW_BEGIN(name, id)
+#define KMP_PROFILE_FLOW_STEP(name, id)
+#define KMP_PROFILE_FLOW_END(name, id)
+#define KMP_PROFILE_ASYNC_BEGIN(name, id)
+#define KMP_PROFILE_ASYNC_END(name, id)
+
 #define KMP_PROFILE_SCOPE(name, level)
 #define KMP_PROFILE_FUNCTION(level)
 #define KMP_PROFILING(level) {
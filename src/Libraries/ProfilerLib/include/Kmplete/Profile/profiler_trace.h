@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Base/type_traits.h"
+#include "Kmplete/Base/macro.h"
+
+
+namespace Kmplete
+{
+    //! Kinds of profiling events sharing the same session timeline
+    enum class ProfileEventType : UInt32
+    {
+        Scope = 0,
+        Counter,
+        FrameMark,
+        FlowBegin,
+        FlowStep,
+        FlowEnd,
+        AsyncBegin,
+        AsyncEnd
+    };
+    //--------------------------------------------------------------------------
+
+
+    //! Single profiling metrics unit, a fixed-size trivially copyable record so that it can be
+    //! pushed into a per-thread ring without allocations. Name points to the static storage of
+    //! the profiling macro, timestamps are steady clock nanoseconds. The meaning of "end" depends
+    //! on the type: end timestamp for scopes, bit-casted double value for counters, event id for
+    //! flow and async events, unused for frame marks
+    struct ProfileResult
+    {
+        const char* name;
+        Int64 start;
+        Int64 end;
+        UInt32 threadIndex;
+        ProfileEventType type = ProfileEventType::Scope;
+    };
+    static_assert(IsTriviallyCopyable<ProfileResult>::value);
+    static_assert(sizeof(ProfileResult) == 32);
+    //--------------------------------------------------------------------------
+
+
+    //! Compact binary profiling trace format. A trace starts with the magic bytes and the version,
+    //! followed by a stream of chunks, each chunk is a type (UInt32), a payload size (UInt32) and the payload:
+    //! Session - session name (UInt32 length + characters);
+    //! String - entry of the string table: id (varint), length (varint) + characters, written once per name;
+    //! Events - results of a single thread: thread index (varint), events count (varint), base timestamp (Int64)
+    //!          and per event: name id (varint), event type (varint), start delta to the previous start (zigzag varint)
+    //!          and the type-specific payload - duration (varint) for scopes, value (Int64 bits of a double) for counters,
+    //!          id (varint) for flow and async events, nothing for frame marks;
+    //! Summary - total results count (varint) and dropped results count (varint), ends the trace.
+    //! Integers are written in little-endian byte order, timestamps are nanoseconds.
+    //! Traces are converted to Chrome/Perfetto JSON offline by the ProfileConverter tool
+    namespace ProfilerTrace
+    {
+        static constexpr Array<char, 8> Magic = { 'K', 'M', 'P', 'T', 'R', 'A', 'C', 'E' };
+        static constexpr UInt32 Version = 2;
+        static constexpr auto FileExtension = ".kmptrace";
+
+        enum class ChunkType : UInt32
+        {
+            Session = 1,
+            String = 2,
+            Events = 3,
+            Summary = 4
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Encoder of the binary trace, accumulates encoded chunks in memory until they are taken
+        //! by the owner (normally profiler's writer thread). The string table maps name pointers
+        //! to ids, so every name is stored once per session. Not thread-safe
+        class KMP_API Encoder
+        {
+            KMP_DISABLE_COPY_MOVE(Encoder)
+
+        public:
+            Encoder();
+            ~Encoder() = default;
+
+            void BeginSession(const String& sessionName);
+            void AddEvents(UInt32 threadIndex, const Vector<ProfileResult>& results);
+            void EndSession(UInt64 profilesCount, UInt64 droppedCount);
+
+            KMP_NODISCARD const BinaryBuffer& GetBuffer() const noexcept;
+            void ClearBuffer() noexcept;
+
+        private:
+            KMP_NODISCARD UInt32 _GetStringId(const char* string);
+            void _BeginChunk(ChunkType type);
+            void _EndChunk();
+
+        private:
+            BinaryBuffer _buffer;
+            HashMap<const char*, UInt32> _stringIds;
+            Vector<UInt32> _nameIds;
+            size_t _chunkStart;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Converts binary trace to Chrome trace event JSON (loadable by chrome://tracing and Perfetto UI)
+        KMP_NODISCARD KMP_API bool ConvertToChromeJson(const Filepath& tracePath, const Filepath& jsonPath);
+    }
+}
\ No newline at end of file
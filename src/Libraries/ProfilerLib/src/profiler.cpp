@@ -4,17 +4,133 @@
 
 #include "Kmplete/Log/log.h"
 
-#include <iomanip>
+#include <bit>
+#include <algorithm>
 
 
 namespace Kmplete
 {
+    namespace
+    {
+        Int64 ProfilerNow() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+        //--------------------------------------------------------------------------
+
+        //! Marks the buffer of the instrumented thread retired when the thread exits, the buffer itself
+        //! is owned by the profiler, since its last results may not be drained yet. Results recorded later
+        //! in the thread teardown (e.g. by other thread_local destructors) are dropped, "exited" is trivially
+        //! destructible, so it stays valid after the owner is destroyed
+        struct ThreadBufferOwner
+        {
+            static inline thread_local bool exited = false;
+
+            ProfilerThreadBuffer* buffer = nullptr;
+
+            ~ThreadBufferOwner()
+            {
+                exited = true;
+
+                if (buffer)
+                {
+                    buffer->Retire();
+                    buffer = nullptr;
+                }
+            }
+        };
+        //--------------------------------------------------------------------------
+    }
+
+
+    ProfilerThreadBuffer::ProfilerThreadBuffer(UInt32 threadIndex) noexcept
+        : _threadIndex(threadIndex)
+        , _head(0)
+        , _tail(0)
+        , _droppedCount(0)
+        , _retired(false)
+        , _results()
+    {}
+    //--------------------------------------------------------------------------
+
+    bool ProfilerThreadBuffer::Push(const ProfileResult& result) noexcept
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        const auto tail = _tail.load(std::memory_order_acquire);
+
+        if (head - tail >= Capacity)
+        {
+            _droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        _results[head & (Capacity - 1)] = result;
+        _head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+    //--------------------------------------------------------------------------
+
+    UInt64 ProfilerThreadBuffer::Drain(Vector<ProfileResult>& results)
+    {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        const auto head = _head.load(std::memory_order_acquire);
+
+        for (auto index = tail; index != head; ++index)
+        {
+            results.push_back(_results[index & (Capacity - 1)]);
+        }
+
+        _tail.store(head, std::memory_order_release);
+
+        return head - tail;
+    }
+    //--------------------------------------------------------------------------
+
+    void ProfilerThreadBuffer::Discard() noexcept
+    {
+        _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+        _droppedCount.store(0, std::memory_order_relaxed);
+    }
+    //--------------------------------------------------------------------------
+
+    void ProfilerThreadBuffer::Retire() noexcept
+    {
+        _retired.store(true, std::memory_order_release);
+    }
+    //--------------------------------------------------------------------------
+
+    bool ProfilerThreadBuffer::IsRetired() const noexcept
+    {
+        return _retired.load(std::memory_order_acquire);
+    }
+    //--------------------------------------------------------------------------
+
+    UInt32 ProfilerThreadBuffer::GetThreadIndex() const noexcept
+    {
+        return _threadIndex;
+    }
+    //--------------------------------------------------------------------------
+
+    UInt64 ProfilerThreadBuffer::ExchangeDroppedCount() noexcept
+    {
+        return _droppedCount.exchange(0, std::memory_order_relaxed);
+    }
+    //--------------------------------------------------------------------------
+
+
     Profiler::Profiler() noexcept
         : _level(0)
         , _active(true)
+        , _sessionActive(false)
         , _currentSession(nullptr)
         , _storageSize(0)
-        , _storeCycles(0)
+        , _nextThreadIndex(0)
+        , _writerStopRequested(false)
+        , _traceEncoder()
+        , _drainedResults()
+        , _retiredThreadBuffers()
+        , _pendingResultsCount(0)
     {}
     //--------------------------------------------------------------------------
 
@@ -33,26 +149,26 @@ namespace Kmplete
 
     void Profiler::SetLevel(unsigned int level)
     {
-        _level = level;
+        _level.store(level, std::memory_order_relaxed);
     }
     //--------------------------------------------------------------------------
 
     unsigned int Profiler::GetLevel() const
     {
-        return _level;
+        return _level.load(std::memory_order_relaxed);
     }
     //--------------------------------------------------------------------------
 
     void Profiler::SetActive(bool active)
     {
-        _active = active;
-        KMP_LOG_INFO("activated: {}", _active);
+        _active.store(active, std::memory_order_relaxed);
+        KMP_LOG_INFO("activated: {}", active);
     }
     //--------------------------------------------------------------------------
 
     bool Profiler::IsActive() const
     {
-        return _active;
+        return _active.load(std::memory_order_relaxed);
     }
     //--------------------------------------------------------------------------
 
@@ -78,11 +194,27 @@ namespace Kmplete
             _EndSessionInternal();
         }
 
-        _storageSize = storageSize;
-        _storeCycles = 0;
-        _profileResults.reserve(storageSize);
         _outputFilepath = filepath;
-        _currentSession.reset(new ProfilingSession({ name, 0 }));
+        _outputFileStream.open(_outputFilepath, std::ios::binary);
+        if (not _outputFileStream.is_open())
+        {
+            KMP_LOG_ERROR("failed to open profiling session '{}' file '{}'", name, _outputFilepath);
+            return;
+        }
+
+        _storageSize = std::max(storageSize, 1);
+        _pendingResultsCount = 0;
+        _drainedResults.reserve(ProfilerThreadBuffer::Capacity);
+        _currentSession.reset(new ProfilingSession({ name, 0, 0 }));
+
+        _traceEncoder.ClearBuffer();
+        _traceEncoder.BeginSession(name);
+
+        // results recorded outside of any session must not leak into this one
+        _DiscardThreadBuffers();
+        _StartWriter();
+
+        _sessionActive.store(true, std::memory_order_release);
     }
     //--------------------------------------------------------------------------
 
@@ -90,136 +222,226 @@ namespace Kmplete
     {
         if (_currentSession)
         {
-            std::ofstream outputFileStream(_outputFilepath);
-            if (outputFileStream.is_open())
-            {
-                _WriteProfileHeader(outputFileStream);
-                if (_storeCycles > 0)
-                {
-                    _WriteProfileResultsFromIntermediate(outputFileStream);
-                }
-                _WriteProfileResults(outputFileStream);
-                _WriteProfileFooter(outputFileStream);
+            _sessionActive.store(false, std::memory_order_release);
+            _StopWriter();
 
-                outputFileStream.flush();
-                outputFileStream.close();
-            }
-            else
+            _traceEncoder.EndSession(static_cast<UInt64>(_currentSession->profilesCount), static_cast<UInt64>(_currentSession->droppedCount));
+            _FlushTraceBuffer();
+            _outputFileStream.flush();
+            _outputFileStream.close();
+
+            if (_currentSession->droppedCount > 0)
             {
-                KMP_LOG_ERROR("failed to open profiling session '{}' file '{}'", _currentSession->name, _outputFilepath);
-            }            
+                KMP_LOG_WARN("profiling session '{}' dropped {} results due to full thread buffers", _currentSession->name, _currentSession->droppedCount);
+            }
         }
 
         _currentSession.reset(nullptr);
-        _profileResults.clear();
+        _traceEncoder.ClearBuffer();
+    }
+    //--------------------------------------------------------------------------
+
+    void Profiler::RecordCounter(const char* name, double value, unsigned int level /*= ProfileLevelAlways*/)
+    {
+        if (_IsRecording(level))
+        {
+            _Record(ProfileResult{ .name = name, .start = ProfilerNow(), .end = std::bit_cast<Int64>(value), .threadIndex = 0, .type = ProfileEventType::Counter });
+        }
     }
     //--------------------------------------------------------------------------
 
-    void Profiler::_WriteProfileHeader(std::ofstream& outputFileStream) const
+    void Profiler::RecordFrameMark(const char* name /*= "Frame"*/)
     {
-        outputFileStream
-            << R"rjs({"otherData":{"profileCount":")rjs"
-            << _currentSession->profilesCount
-            << R"rjs("},"traceEvents":[{})rjs";
+        if (_IsRecording(ProfileLevelAlways))
+        {
+            _Record(ProfileResult{ .name = name, .start = ProfilerNow(), .end = 0, .threadIndex = 0, .type = ProfileEventType::FrameMark });
+        }
     }
     //--------------------------------------------------------------------------
 
-    void Profiler::_WriteProfileResults(std::ofstream& outputFileStream) const
+    void Profiler::RecordEvent(ProfileEventType type, const char* name, UInt64 id, unsigned int level /*= ProfileLevelAlways*/)
     {
-        for (const auto& profileResult : _profileResults)
+        if (_IsRecording(level))
         {
-            const auto elapsedMicroseconds = std::chrono::duration<float, std::micro>(profileResult.end - profileResult.start).count();
-            const auto start = std::chrono::duration<double, std::micro>(profileResult.start.time_since_epoch()).count();
-
-            outputFileStream
-                << std::setprecision(3) << std::fixed
-                << R"rjs(,{"dur":)rjs"
-                << elapsedMicroseconds
-                << R"rjs(,"name":")rjs"
-                << profileResult.name
-                << R"rjs(","ph":"X","pid":0,"tid":)rjs"
-                << profileResult.threadId
-                << R"rjs(,"ts":)rjs"
-                << start
-                << "}";
+            _Record(ProfileResult{ .name = name, .start = ProfilerNow(), .end = static_cast<Int64>(id), .threadIndex = 0, .type = type });
         }
     }
     //--------------------------------------------------------------------------
 
-    void Profiler::_WriteProfileResultsToIntermediate() const
+    size_t Profiler::GetThreadBuffersCount()
+    {
+        std::lock_guard lock(_threadBuffersMutex);
+        return _threadBuffers.size();
+    }
+    //--------------------------------------------------------------------------
+
+    bool Profiler::_IsRecording(unsigned int level) const noexcept
     {
-        const auto intermediateStoragePath = _CreateIntermediateFilepath(_storeCycles);
+        return _sessionActive.load(std::memory_order_relaxed) && GetLevel() >= level && IsActive();
+    }
+    //--------------------------------------------------------------------------
 
-        std::ofstream intermediateFileStream(intermediateStoragePath);
-        if (intermediateFileStream.is_open())
+    void Profiler::_Record(ProfileResult result)
+    {
+        const auto threadBuffer = _GetThreadBuffer();
+        if (not threadBuffer)
         {
-            _WriteProfileResults(intermediateFileStream);
+            return;
+        }
 
-            intermediateFileStream.flush();
-            intermediateFileStream.close();
+        result.threadIndex = threadBuffer->GetThreadIndex();
+        threadBuffer->Push(result);
+    }
+    //--------------------------------------------------------------------------
 
-            KMP_LOG_INFO("write to intermediate file '{}'", intermediateStoragePath);
+    Nullable<ProfilerThreadBuffer*> Profiler::_GetThreadBuffer()
+    {
+        // the buffer might already be released, and the owner must not be touched after its destruction
+        if (ThreadBufferOwner::exited)
+        {
+            return nullptr;
         }
-        else
+
+        thread_local ThreadBufferOwner threadBufferOwner;
+
+        if (not threadBufferOwner.buffer)
         {
-            KMP_LOG_ERROR("failed to write to intermediate file '{}'", intermediateStoragePath);
+            // indices are not reused, so the threads stay distinguishable within the trace
+            std::lock_guard lock(_threadBuffersMutex);
+            _threadBuffers.push_back(CreateUPtr<ProfilerThreadBuffer>(_nextThreadIndex++));
+            threadBufferOwner.buffer = _threadBuffers.back().get();
         }
+
+        return threadBufferOwner.buffer;
     }
     //--------------------------------------------------------------------------
 
-    void Profiler::_WriteProfileResultsFromIntermediate(std::ofstream& outputFileStream) const
+    Vector<ProfilerThreadBuffer*> Profiler::_GetThreadBuffers()
     {
-        int storeCycle = 0;
-        while (storeCycle < _storeCycles)
-        {
-            const auto intermediateStoragePath = _CreateIntermediateFilepath(storeCycle);
+        std::lock_guard lock(_threadBuffersMutex);
 
-            std::ifstream intermediateFileInputStream(intermediateStoragePath);
-            if (intermediateFileInputStream.is_open())
-            {
-                std::stringstream intermediateBuffer;
-                intermediateBuffer << intermediateFileInputStream.rdbuf();
-                intermediateFileInputStream.close();
+        Vector<ProfilerThreadBuffer*> threadBuffers;
+        threadBuffers.reserve(_threadBuffers.size());
+        for (const auto& threadBuffer : _threadBuffers)
+        {
+            threadBuffers.push_back(threadBuffer.get());
+        }
 
-                outputFileStream << intermediateBuffer.str();
+        return threadBuffers;
+    }
+    //--------------------------------------------------------------------------
 
-                if (not std::filesystem::remove(intermediateStoragePath))
-                {
-                    KMP_LOG_WARN("failed to remove temporary intermediate file '{}'", intermediateStoragePath);
-                }
-            }
-            else
+    void Profiler::_DiscardThreadBuffers()
+    {
+        for (auto threadBuffer : _GetThreadBuffers())
+        {
+            if (threadBuffer->IsRetired())
             {
-                KMP_LOG_ERROR("failed to write from intermediate file '{}'", intermediateStoragePath);
+                _retiredThreadBuffers.push_back(threadBuffer);
             }
 
-            outputFileStream.flush();
+            threadBuffer->Discard();
+        }
 
-            KMP_LOG_INFO("write from intermediate file '{}'", intermediateStoragePath);
+        _ReleaseRetiredThreadBuffers(_retiredThreadBuffers);
+        _retiredThreadBuffers.clear();
+    }
+    //--------------------------------------------------------------------------
 
-            ++storeCycle;
+    void Profiler::_ReleaseRetiredThreadBuffers(const Vector<ProfilerThreadBuffer*>& retiredBuffers)
+    {
+        if (retiredBuffers.empty())
+        {
+            return;
         }
+
+        std::lock_guard lock(_threadBuffersMutex);
+        std::erase_if(_threadBuffers, [&retiredBuffers](const UPtr<ProfilerThreadBuffer>& threadBuffer) {
+            return std::find(retiredBuffers.begin(), retiredBuffers.end(), threadBuffer.get()) != retiredBuffers.end();
+        });
     }
     //--------------------------------------------------------------------------
 
-    void Profiler::_WriteProfileFooter(std::ofstream& outputFileStream) const
+    void Profiler::_StartWriter()
     {
-        outputFileStream << "]}";
+        {
+            std::lock_guard lock(_writerMutex);
+            _writerStopRequested = false;
+        }
+
+        _writerThread = std::thread(&Profiler::_WriterLoop, this);
     }
     //--------------------------------------------------------------------------
 
-    Filepath Profiler::_CreateIntermediateFilepath(int intermediateCount) const
+    void Profiler::_StopWriter()
     {
-        const auto intermediateStorageFilename = _outputFilepath.stem().generic_u8string().append(std::to_string(intermediateCount));
-        return _outputFilepath.parent_path() / intermediateStorageFilename;
+        {
+            std::lock_guard lock(_writerMutex);
+            _writerStopRequested = true;
+        }
+        _writerCondition.notify_one();
+
+        if (_writerThread.joinable())
+        {
+            _writerThread.join();
+        }
     }
     //--------------------------------------------------------------------------
 
-    void Profiler::_BeginNewCycle()
+    void Profiler::_WriterLoop()
     {
-        ++_storeCycles;
-        _profileResults.clear();
-        _profileResults.reserve(_storageSize);
+        std::unique_lock lock(_writerMutex);
+        while (not _writerStopRequested)
+        {
+            _writerCondition.wait_for(lock, WriterFlushInterval, [this]() { return _writerStopRequested; });
+
+            lock.unlock();
+            _DrainThreadBuffers();
+            lock.lock();
+        }
+        lock.unlock();
+
+        // results pushed between the last periodic drain and the stop request
+        _DrainThreadBuffers();
+    }
+    //--------------------------------------------------------------------------
+
+    void Profiler::_DrainThreadBuffers()
+    {
+        for (auto threadBuffer : _GetThreadBuffers())
+        {
+            // checked before draining, so the final drain sees everything the exited thread has pushed
+            if (threadBuffer->IsRetired())
+            {
+                _retiredThreadBuffers.push_back(threadBuffer);
+            }
+
+            const auto drainedCount = static_cast<int>(threadBuffer->Drain(_drainedResults));
+            _currentSession->profilesCount += drainedCount;
+            _currentSession->droppedCount += static_cast<int>(threadBuffer->ExchangeDroppedCount());
+
+            _traceEncoder.AddEvents(threadBuffer->GetThreadIndex(), _drainedResults);
+            _drainedResults.clear();
+
+            _pendingResultsCount += drainedCount;
+            if (_pendingResultsCount >= _storageSize)
+            {
+                _FlushTraceBuffer();
+            }
+        }
+
+        _ReleaseRetiredThreadBuffers(_retiredThreadBuffers);
+        _retiredThreadBuffers.clear();
+    }
+    //--------------------------------------------------------------------------
+
+    void Profiler::_FlushTraceBuffer()
+    {
+        const auto& traceBuffer = _traceEncoder.GetBuffer();
+        _outputFileStream.write(reinterpret_cast<const char*>(traceBuffer.data()), static_cast<std::streamsize>(traceBuffer.size()));
+
+        _traceEncoder.ClearBuffer();
+        _pendingResultsCount = 0;
     }
     //--------------------------------------------------------------------------
 
@@ -227,7 +449,7 @@ namespace Kmplete
     ProfilerTimer::ProfilerTimer(const char* name, unsigned int level /*= ProfileLevelAlways*/)
         : _name(name)
         , _skip(Profiler::Get().GetLevel() < level || not Profiler::Get().IsActive())
-        , _start(_skip ? std::chrono::high_resolution_clock::time_point() : std::chrono::high_resolution_clock::now())
+        , _start(_skip ? 0 : ProfilerNow())
     {}
     //--------------------------------------------------------------------------
 
@@ -238,28 +460,15 @@ namespace Kmplete
             return;
         }
 
-        const auto end = std::chrono::high_resolution_clock::now();
+        const auto end = ProfilerNow();
 
         auto& profiler = Profiler::Get();
-
-        if (not profiler._currentSession)
+        if (not profiler._sessionActive.load(std::memory_order_relaxed))
         {
             return;
         }
 
-        {
-            std::lock_guard lock(profiler._mutex);
-            ++profiler._currentSession->profilesCount;
-            profiler._profileResults.emplace_back(_name, _start, end, std::this_thread::get_id());
-
-            if (profiler._profileResults.size() < static_cast<size_t>(profiler._storageSize))
-            {
-                return;
-            }
-
-            profiler._WriteProfileResultsToIntermediate();
-            profiler._BeginNewCycle();
-        }
+        profiler._Record(ProfileResult{ .name = _name, .start = _start, .end = end, .threadIndex = 0, .type = ProfileEventType::Scope });
     }
     //--------------------------------------------------------------------------
 
@@ -0,0 +1,564 @@
+#include "Kmplete/Profile/profiler_trace.h"
+#include "Kmplete/Base/nullability.h"
+#include "Kmplete/Log/log.h"
+
+#include <fstream>
+#include <charconv>
+#include <cmath>
+#include <bit>
+
+
+namespace Kmplete
+{
+    namespace ProfilerTrace
+    {
+        namespace
+        {
+            void WriteUInt32(BinaryBuffer& buffer, UInt32 value)
+            {
+                for (auto byte = 0; byte < 4; byte++)
+                {
+                    buffer.push_back(static_cast<UByte>(value >> (byte * 8)));
+                }
+            }
+            //--------------------------------------------------------------------------
+
+            void WriteInt64(BinaryBuffer& buffer, Int64 value)
+            {
+                const auto unsignedValue = static_cast<UInt64>(value);
+                for (auto byte = 0; byte < 8; byte++)
+                {
+                    buffer.push_back(static_cast<UByte>(unsignedValue >> (byte * 8)));
+                }
+            }
+            //--------------------------------------------------------------------------
+
+            void WriteVarint(BinaryBuffer& buffer, UInt64 value)
+            {
+                while (value >= 0x80)
+                {
+                    buffer.push_back(static_cast<UByte>(value | 0x80));
+                    value >>= 7;
+                }
+                buffer.push_back(static_cast<UByte>(value));
+            }
+            //--------------------------------------------------------------------------
+
+            void WriteZigZag(BinaryBuffer& buffer, Int64 value)
+            {
+                WriteVarint(buffer, (static_cast<UInt64>(value) << 1) ^ static_cast<UInt64>(value >> 63));
+            }
+            //--------------------------------------------------------------------------
+
+
+            //! Bounds-checked reader of a single chunk payload
+            class PayloadReader
+            {
+            public:
+                PayloadReader(const BinaryBuffer& payload) noexcept
+                    : _payload(payload)
+                    , _position(0)
+                    , _valid(true)
+                {}
+
+                KMP_NODISCARD bool IsValid() const noexcept
+                {
+                    return _valid;
+                }
+
+                KMP_NODISCARD UInt32 ReadUInt32()
+                {
+                    if (not _Require(4))
+                    {
+                        return 0;
+                    }
+
+                    UInt32 value = 0;
+                    for (auto byte = 0; byte < 4; byte++)
+                    {
+                        value |= UInt32(_payload[_position++]) << (byte * 8);
+                    }
+                    return value;
+                }
+
+                KMP_NODISCARD Int64 ReadInt64()
+                {
+                    if (not _Require(8))
+                    {
+                        return 0;
+                    }
+
+                    UInt64 value = 0;
+                    for (auto byte = 0; byte < 8; byte++)
+                    {
+                        value |= UInt64(_payload[_position++]) << (byte * 8);
+                    }
+                    return static_cast<Int64>(value);
+                }
+
+                KMP_NODISCARD UInt64 ReadVarint()
+                {
+                    UInt64 value = 0;
+                    for (auto shift = 0; shift < 64; shift += 7)
+                    {
+                        if (not _Require(1))
+                        {
+                            return 0;
+                        }
+
+                        const auto byte = _payload[_position++];
+                        value |= UInt64(byte & 0x7F) << shift;
+                        if ((byte & 0x80) == 0)
+                        {
+                            return value;
+                        }
+                    }
+
+                    _valid = false;
+                    return 0;
+                }
+
+                KMP_NODISCARD Int64 ReadZigZag()
+                {
+                    const auto value = ReadVarint();
+                    return static_cast<Int64>(value >> 1) ^ -static_cast<Int64>(value & 1);
+                }
+
+                KMP_NODISCARD String ReadString(size_t length)
+                {
+                    if (not _Require(length))
+                    {
+                        return String();
+                    }
+
+                    String value(reinterpret_cast<const char*>(_payload.data() + _position), length);
+                    _position += length;
+                    return value;
+                }
+
+            private:
+                KMP_NODISCARD bool _Require(size_t size)
+                {
+                    _valid = _valid && (_position + size <= _payload.size());
+                    return _valid;
+                }
+
+            private:
+                const BinaryBuffer& _payload;
+                size_t _position;
+                bool _valid;
+            };
+            //--------------------------------------------------------------------------
+
+
+            String EscapeJsonString(const String& string)
+            {
+                String escaped;
+                escaped.reserve(string.size());
+                for (const auto character : string)
+                {
+                    if (character == '"' || character == '\\')
+                    {
+                        escaped.push_back('\\');
+                        escaped.push_back(character);
+                    }
+                    else if (static_cast<UByte>(character) < 0x20)
+                    {
+                        escaped.push_back(' ');
+                    }
+                    else
+                    {
+                        escaped.push_back(character);
+                    }
+                }
+
+                return escaped;
+            }
+            //--------------------------------------------------------------------------
+
+            void AppendInteger(String& output, UInt64 value)
+            {
+                char digits[24];
+                const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+                output.append(digits, result.ptr);
+            }
+            //--------------------------------------------------------------------------
+
+            void AppendDouble(String& output, double value)
+            {
+                if (not std::isfinite(value))
+                {
+                    value = 0.0;
+                }
+
+                char digits[32];
+                const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+                output.append(digits, result.ptr);
+            }
+            //--------------------------------------------------------------------------
+
+            Nullable<const char*> EventPhase(ProfileEventType type)
+            {
+                switch (type)
+                {
+                case ProfileEventType::FlowBegin:   return "s";
+                case ProfileEventType::FlowStep:    return "t";
+                case ProfileEventType::FlowEnd:     return "f";
+                case ProfileEventType::AsyncBegin:  return "b";
+                case ProfileEventType::AsyncEnd:    return "e";
+                default:                            return nullptr;
+                }
+            }
+            //--------------------------------------------------------------------------
+
+            //! Nanoseconds to microseconds with 3 decimal places as Chrome trace expects
+            void AppendMicroseconds(String& output, Int64 nanoseconds)
+            {
+                const auto value = static_cast<UInt64>(std::max(nanoseconds, Int64(0)));
+                const auto fraction = value % 1000;
+
+                AppendInteger(output, value / 1000);
+                output.push_back('.');
+                output.push_back(char('0' + fraction / 100));
+                output.push_back(char('0' + (fraction / 10) % 10));
+                output.push_back(char('0' + fraction % 10));
+            }
+            //--------------------------------------------------------------------------
+        }
+
+
+        Encoder::Encoder()
+            : _buffer()
+            , _stringIds()
+            , _nameIds()
+            , _chunkStart(0)
+        {}
+        //--------------------------------------------------------------------------
+
+        void Encoder::BeginSession(const String& sessionName)
+        {
+            _stringIds.clear();
+
+            _buffer.insert(_buffer.end(), Magic.begin(), Magic.end());
+            WriteUInt32(_buffer, Version);
+
+            _BeginChunk(ChunkType::Session);
+            WriteUInt32(_buffer, static_cast<UInt32>(sessionName.size()));
+            _buffer.insert(_buffer.end(), sessionName.begin(), sessionName.end());
+            _EndChunk();
+        }
+        //--------------------------------------------------------------------------
+
+        void Encoder::AddEvents(UInt32 threadIndex, const Vector<ProfileResult>& results)
+        {
+            if (results.empty())
+            {
+                return;
+            }
+
+            // string chunks of new names must precede the events chunk referencing them
+            _nameIds.clear();
+            _nameIds.reserve(results.size());
+            for (const auto& result : results)
+            {
+                _nameIds.push_back(_GetStringId(result.name));
+            }
+
+            const auto baseTimestamp = results.front().start;
+
+            _BeginChunk(ChunkType::Events);
+            WriteVarint(_buffer, threadIndex);
+            WriteVarint(_buffer, results.size());
+            WriteInt64(_buffer, baseTimestamp);
+
+            auto previousStart = baseTimestamp;
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                const auto& result = results[i];
+                WriteVarint(_buffer, _nameIds[i]);
+                WriteVarint(_buffer, static_cast<UInt32>(result.type));
+                WriteZigZag(_buffer, result.start - previousStart);
+                previousStart = result.start;
+
+                switch (result.type)
+                {
+                case ProfileEventType::Scope:
+                    WriteVarint(_buffer, static_cast<UInt64>(std::max(result.end - result.start, Int64(0))));
+                    break;
+
+                case ProfileEventType::Counter:
+                    WriteInt64(_buffer, result.end);
+                    break;
+
+                case ProfileEventType::FrameMark:
+                    break;
+
+                default:
+                    WriteVarint(_buffer, static_cast<UInt64>(result.end));
+                    break;
+                }
+            }
+            _EndChunk();
+        }
+        //--------------------------------------------------------------------------
+
+        void Encoder::EndSession(UInt64 profilesCount, UInt64 droppedCount)
+        {
+            _BeginChunk(ChunkType::Summary);
+            WriteVarint(_buffer, profilesCount);
+            WriteVarint(_buffer, droppedCount);
+            _EndChunk();
+        }
+        //--------------------------------------------------------------------------
+
+        const BinaryBuffer& Encoder::GetBuffer() const noexcept
+        {
+            return _buffer;
+        }
+        //--------------------------------------------------------------------------
+
+        void Encoder::ClearBuffer() noexcept
+        {
+            _buffer.clear();
+        }
+        //--------------------------------------------------------------------------
+
+        UInt32 Encoder::_GetStringId(const char* string)
+        {
+            const auto stringIdIt = _stringIds.find(string);
+            if (stringIdIt != _stringIds.end())
+            {
+                return stringIdIt->second;
+            }
+
+            const auto stringId = static_cast<UInt32>(_stringIds.size());
+            _stringIds.emplace(string, stringId);
+
+            const auto length = string ? std::char_traits<char>::length(string) : 0;
+
+            _BeginChunk(ChunkType::String);
+            WriteVarint(_buffer, stringId);
+            WriteVarint(_buffer, length);
+            _buffer.insert(_buffer.end(), string, string + length);
+            _EndChunk();
+
+            return stringId;
+        }
+        //--------------------------------------------------------------------------
+
+        void Encoder::_BeginChunk(ChunkType type)
+        {
+            WriteUInt32(_buffer, static_cast<UInt32>(type));
+            _chunkStart = _buffer.size();
+            WriteUInt32(_buffer, 0); // payload size, patched in _EndChunk
+        }
+        //--------------------------------------------------------------------------
+
+        void Encoder::_EndChunk()
+        {
+            const auto payloadSize = static_cast<UInt32>(_buffer.size() - _chunkStart - 4);
+            for (auto byte = 0; byte < 4; byte++)
+            {
+                _buffer[_chunkStart + byte] = static_cast<UByte>(payloadSize >> (byte * 8));
+            }
+        }
+        //--------------------------------------------------------------------------
+
+
+        bool ConvertToChromeJson(const Filepath& tracePath, const Filepath& jsonPath)
+        {
+            std::ifstream traceStream(tracePath, std::ios::binary);
+            if (not traceStream.is_open())
+            {
+                KMP_LOG_ERROR_FN("ProfilerTrace: failed to open trace '{}'", tracePath);
+                return false;
+            }
+
+            BinaryBuffer header(Magic.size() + 4);
+            if (not traceStream.read(reinterpret_cast<char*>(header.data()), std::streamsize(header.size())) ||
+                not std::equal(Magic.begin(), Magic.end(), header.begin()))
+            {
+                KMP_LOG_ERROR_FN("ProfilerTrace: '{}' is not a profiling trace", tracePath);
+                return false;
+            }
+
+            PayloadReader headerReader(header);
+            KMP_MB_UNUSED const auto magic = headerReader.ReadInt64();
+            const auto version = headerReader.ReadUInt32();
+            if (version != Version)
+            {
+                KMP_LOG_ERROR_FN("ProfilerTrace: '{}' has unsupported version {}", tracePath, version);
+                return false;
+            }
+
+            // chunk sizes come from the file, so they are checked against the bytes actually left in it
+            const auto payloadStart = traceStream.tellg();
+            traceStream.seekg(0, std::ios::end);
+            const auto traceSize = traceStream.tellg();
+            traceStream.seekg(payloadStart);
+
+            std::ofstream jsonStream(jsonPath, std::ios::binary);
+            if (not jsonStream.is_open())
+            {
+                KMP_LOG_ERROR_FN("ProfilerTrace: failed to open output '{}'", jsonPath);
+                return false;
+            }
+
+            constexpr size_t OutputFlushSize = 1 << 20;
+
+            String sessionName;
+            UInt64 profilesCount = 0;
+            UInt64 droppedCount = 0;
+            Vector<String> strings;
+            String output = R"rjs({"traceEvents":[{})rjs";
+            output.reserve(OutputFlushSize + 4096);
+
+            BinaryBuffer chunkHeader(8);
+            BinaryBuffer payload;
+            while (traceStream.read(reinterpret_cast<char*>(chunkHeader.data()), std::streamsize(chunkHeader.size())))
+            {
+                PayloadReader chunkHeaderReader(chunkHeader);
+                const auto chunkType = static_cast<ChunkType>(chunkHeaderReader.ReadUInt32());
+                const auto payloadSize = chunkHeaderReader.ReadUInt32();
+
+                if (std::streamoff(payloadSize) > traceSize - traceStream.tellg())
+                {
+                    KMP_LOG_WARN_FN("ProfilerTrace: '{}' is truncated, converting the complete part only", tracePath);
+                    break;
+                }
+
+                payload.resize(payloadSize);
+                if (not traceStream.read(reinterpret_cast<char*>(payload.data()), std::streamsize(payloadSize)))
+                {
+                    KMP_LOG_WARN_FN("ProfilerTrace: '{}' is truncated, converting the complete part only", tracePath);
+                    break;
+                }
+
+                PayloadReader reader(payload);
+                switch (chunkType)
+                {
+                case ChunkType::Session:
+                    sessionName = EscapeJsonString(reader.ReadString(reader.ReadUInt32()));
+                    break;
+
+                case ChunkType::String:
+                {
+                    const auto stringId = reader.ReadVarint();
+                    const auto string = reader.ReadString(reader.ReadVarint());
+
+                    // the encoder assigns ids sequentially, so a new string always gets the next one
+                    if (stringId > strings.size())
+                    {
+                        KMP_LOG_ERROR_FN("ProfilerTrace: '{}' has string with out of order id {}", tracePath, stringId);
+                        return false;
+                    }
+
+                    if (stringId == strings.size())
+                    {
+                        strings.emplace_back();
+                    }
+                    strings[stringId] = EscapeJsonString(string);
+                    break;
+                }
+
+                case ChunkType::Events:
+                {
+                    const auto threadIndex = reader.ReadVarint();
+                    const auto eventsCount = reader.ReadVarint();
+                    auto start = reader.ReadInt64();
+
+                    for (UInt64 i = 0; i < eventsCount && reader.IsValid(); i++)
+                    {
+                        const auto nameId = reader.ReadVarint();
+                        const auto type = static_cast<ProfileEventType>(reader.ReadVarint());
+                        start += reader.ReadZigZag();
+
+                        output.append(R"rjs(,{"name":")rjs");
+                        output.append(nameId < strings.size() ? strings[nameId] : String("Unknown"));
+                        output.append(R"rjs(","pid":0,"tid":)rjs");
+                        AppendInteger(output, threadIndex);
+                        output.append(R"rjs(,"ts":)rjs");
+                        AppendMicroseconds(output, start);
+
+                        switch (type)
+                        {
+                        case ProfileEventType::Scope:
+                            output.append(R"rjs(,"ph":"X","dur":)rjs");
+                            AppendMicroseconds(output, Int64(reader.ReadVarint()));
+                            break;
+
+                        case ProfileEventType::Counter:
+                            output.append(R"rjs(,"ph":"C","args":{"value":)rjs");
+                            AppendDouble(output, std::bit_cast<double>(reader.ReadInt64()));
+                            output.push_back('}');
+                            break;
+
+                        case ProfileEventType::FrameMark:
+                            output.append(R"rjs(,"ph":"i","s":"g")rjs");
+                            break;
+
+                        default:
+                        {
+                            const auto phase = EventPhase(type);
+                            if (not phase)
+                            {
+                                KMP_LOG_ERROR_FN("ProfilerTrace: '{}' has unknown event type {}", tracePath, static_cast<UInt32>(type));
+                                return false;
+                            }
+
+                            output.append(R"rjs(,"ph":")rjs");
+                            output.append(phase);
+                            output.append(type == ProfileEventType::AsyncBegin || type == ProfileEventType::AsyncEnd
+                                ? R"rjs(","cat":"async","id":)rjs"
+                                : R"rjs(","cat":"flow","id":)rjs");
+                            AppendInteger(output, reader.ReadVarint());
+                            if (type == ProfileEventType::FlowEnd)
+                            {
+                                // binds the flow end to the enclosing slice rather than the next one
+                                output.append(R"rjs(,"bp":"e")rjs");
+                            }
+                            break;
+                        }
+                        }
+                        output.push_back('}');
+
+                        if (output.size() >= OutputFlushSize)
+                        {
+                            jsonStream.write(output.data(), std::streamsize(output.size()));
+                            output.clear();
+                        }
+                    }
+                    break;
+                }
+
+                case ChunkType::Summary:
+                    profilesCount = reader.ReadVarint();
+                    droppedCount = reader.ReadVarint();
+                    break;
+
+                default:
+                    // unknown chunks are skipped, so newer traces stay readable
+                    break;
+                }
+
+                if (not reader.IsValid())
+                {
+                    KMP_LOG_ERROR_FN("ProfilerTrace: '{}' has malformed chunk of type {}", tracePath, static_cast<UInt32>(chunkType));
+                    return false;
+                }
+            }
+
+            output.append(R"rjs(],"otherData":{"session":")rjs");
+            output.append(sessionName);
+            output.append(R"rjs(","profileCount":")rjs");
+            AppendInteger(output, profilesCount);
+            output.append(R"rjs(","droppedCount":")rjs");
+            AppendInteger(output, droppedCount);
+            output.append(R"rjs("}})rjs");
+            jsonStream.write(output.data(), std::streamsize(output.size()));
+
+            return jsonStream.good();
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
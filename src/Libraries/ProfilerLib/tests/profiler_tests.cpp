@@ -0,0 +1,394 @@
+#include "Kmplete/Profile/profiler.h"
+#include "Kmplete/Profile/profiler_trace.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <fstream>
+#include <thread>
+#include <bit>
+
+using namespace Kmplete;
+
+
+static Filepath ProfilerTestFilepath(const char* filename)
+{
+    return std::filesystem::current_path() / filename;
+}
+//--------------------------------------------------------------------------
+
+static String ReadProfilerTestFile(const Filepath& filepath)
+{
+    std::ifstream inputStream(filepath, std::ios::binary);
+    return String(std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>());
+}
+//--------------------------------------------------------------------------
+
+static void WriteProfilerTestFile(const Filepath& filepath, const BinaryBuffer& buffer)
+{
+    std::ofstream outputStream(filepath, std::ios::binary);
+    outputStream.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Profiler trace encoder and converter round-trip", "[profiler][trace]")
+{
+    const auto tracePath = ProfilerTestFilepath("profiler_trace_test_temp.kmptrace");
+    const auto jsonPath = ProfilerTestFilepath("profiler_trace_test_temp.json");
+
+    const char* outerName = "void Outer(\"quoted\")";
+    const char* innerName = "Inner";
+
+    ProfilerTrace::Encoder encoder;
+    encoder.BeginSession("Trace session");
+    encoder.AddEvents(0, {
+        ProfileResult{ .name = innerName, .start = 2'000'500, .end = 2'001'000, .threadIndex = 0 },
+        ProfileResult{ .name = outerName, .start = 1'000'000, .end = 3'500'250, .threadIndex = 0 }
+    });
+    encoder.AddEvents(7, {
+        ProfileResult{ .name = innerName, .start = 5'000'000, .end = 5'000'001, .threadIndex = 7 }
+    });
+    encoder.EndSession(3, 2);
+
+    // every name is stored once per session
+    const auto buffer = encoder.GetBuffer();
+    const auto bufferString = String(buffer.begin(), buffer.end());
+    REQUIRE(bufferString.starts_with("KMPTRACE"));
+    REQUIRE(bufferString.find(innerName) == bufferString.rfind(innerName));
+    REQUIRE(buffer.size() < 3 * sizeof(ProfileResult) + 128);
+
+    WriteProfilerTestFile(tracePath, buffer);
+    encoder.ClearBuffer();
+    REQUIRE(encoder.GetBuffer().empty());
+
+    REQUIRE(ProfilerTrace::ConvertToChromeJson(tracePath, jsonPath));
+    const auto json = ReadProfilerTestFile(jsonPath);
+
+    REQUIRE(json.starts_with(R"rjs({"traceEvents":[{})rjs"));
+    REQUIRE(json.find(R"rjs({"name":"Inner","pid":0,"tid":0,"ts":2000.500,"ph":"X","dur":0.500})rjs") != String::npos);
+    REQUIRE(json.find(R"rjs({"name":"void Outer(\"quoted\")","pid":0,"tid":0,"ts":1000.000,"ph":"X","dur":2500.250})rjs") != String::npos);
+    REQUIRE(json.find(R"rjs({"name":"Inner","pid":0,"tid":7,"ts":5000.000,"ph":"X","dur":0.001})rjs") != String::npos);
+    REQUIRE(json.ends_with(R"rjs(],"otherData":{"session":"Trace session","profileCount":"3","droppedCount":"2"}})rjs"));
+
+    SECTION("Not a trace")
+    {
+        WriteProfilerTestFile(tracePath, BinaryBuffer{ '{', '}' });
+        REQUIRE_FALSE(ProfilerTrace::ConvertToChromeJson(tracePath, jsonPath));
+    }
+
+    SECTION("Truncated trace keeps the complete chunks")
+    {
+        WriteProfilerTestFile(tracePath, BinaryBuffer(buffer.begin(), buffer.end() - 3));
+        REQUIRE(ProfilerTrace::ConvertToChromeJson(tracePath, jsonPath));
+        REQUIRE(ReadProfilerTestFile(jsonPath).find(R"rjs("tid":7)rjs") != String::npos);
+    }
+
+    SECTION("Chunk larger than the rest of the trace is treated as truncation")
+    {
+        auto oversizedBuffer = BinaryBuffer(buffer.begin(), buffer.end());
+        oversizedBuffer.insert(oversizedBuffer.end(), { UByte(ProfilerTrace::ChunkType::Events), 0, 0, 0, 0xF0, 0xFF, 0xFF, 0xFF });
+        oversizedBuffer.insert(oversizedBuffer.end(), { 0, 1, 0 });
+
+        WriteProfilerTestFile(tracePath, oversizedBuffer);
+        REQUIRE(ProfilerTrace::ConvertToChromeJson(tracePath, jsonPath));
+        REQUIRE(ReadProfilerTestFile(jsonPath).find(R"rjs("tid":7)rjs") != String::npos);
+    }
+
+    SECTION("String with out of order id is rejected")
+    {
+        auto corruptBuffer = BinaryBuffer(ProfilerTrace::Magic.begin(), ProfilerTrace::Magic.end());
+        corruptBuffer.insert(corruptBuffer.end(), { UByte(ProfilerTrace::Version), 0, 0, 0 });
+        corruptBuffer.insert(corruptBuffer.end(), { UByte(ProfilerTrace::ChunkType::String), 0, 0, 0, 7, 0, 0, 0 });
+        corruptBuffer.insert(corruptBuffer.end(), { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 1, 'A' });
+
+        WriteProfilerTestFile(tracePath, corruptBuffer);
+        REQUIRE_FALSE(ProfilerTrace::ConvertToChromeJson(tracePath, jsonPath));
+    }
+
+    std::filesystem::remove(tracePath);
+    std::filesystem::remove(jsonPath);
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("Profiler trace counters, frame marks and flows", "[profiler][trace]")
+{
+    const auto tracePath = ProfilerTestFilepath("profiler_trace_events_test_temp.kmptrace");
+    const auto jsonPath = ProfilerTestFilepath("profiler_trace_events_test_temp.json");
+
+    ProfilerTrace::Encoder encoder;
+    encoder.BeginSession("Events session");
+    encoder.AddEvents(1, {
+        ProfileResult{ .name = "Frame", .start = 1'000, .end = 0, .threadIndex = 1, .type = ProfileEventType::FrameMark },
+        ProfileResult{ .name = "Memory (MiB)", .start = 1'500, .end = std::bit_cast<Int64>(12.5), .threadIndex = 1, .type = ProfileEventType::Counter },
+        ProfileResult{ .name = "Upload", .start = 2'000, .end = 42, .threadIndex = 1, .type = ProfileEventType::FlowBegin },
+        ProfileResult{ .name = "Upload", .start = 3'000, .end = 42, .threadIndex = 1, .type = ProfileEventType::FlowEnd },
+        ProfileResult{ .name = "Batch", .start = 4'000, .end = 7, .threadIndex = 1, .type = ProfileEventType::AsyncBegin },
+        ProfileResult{ .name = "Batch", .start = 5'000, .end = 7, .threadIndex = 1, .type = ProfileEventType::AsyncEnd }
+    });
+    encoder.EndSession(6, 0);
+    WriteProfilerTestFile(tracePath, encoder.GetBuffer());
+
+    REQUIRE(ProfilerTrace::ConvertToChromeJson(tracePath, jsonPath));
+    const auto json = ReadProfilerTestFile(jsonPath);
+
+    REQUIRE(json.find(R"rjs({"name":"Frame","pid":0,"tid":1,"ts":1.000,"ph":"i","s":"g"})rjs") != String::npos);
+    REQUIRE(json.find(R"rjs({"name":"Memory (MiB)","pid":0,"tid":1,"ts":1.500,"ph":"C","args":{"value":12.5}})rjs") != String::npos);
+    REQUIRE(json.find(R"rjs({"name":"Upload","pid":0,"tid":1,"ts":2.000,"ph":"s","cat":"flow","id":42})rjs") != String::npos);
+    REQUIRE(json.find(R"rjs({"name":"Upload","pid":0,"tid":1,"ts":3.000,"ph":"f","cat":"flow","id":42,"bp":"e"})rjs") != String::npos);
+    REQUIRE(json.find(R"rjs({"name":"Batch","pid":0,"tid":1,"ts":4.000,"ph":"b","cat":"async","id":7})rjs") != String::npos);
+    REQUIRE(json.find(R"rjs({"name":"Batch","pid":0,"tid":1,"ts":5.000,"ph":"e","cat":"async","id":7})rjs") != String::npos);
+
+    std::filesystem::remove(tracePath);
+    std::filesystem::remove(jsonPath);
+}
+//--------------------------------------------------------------------------
+
+#if defined(KMP_PROFILE)
+
+
+TEST_CASE("Profiler thread buffer push and drain", "[profiler]")
+{
+    const auto buffer = CreateUPtr<ProfilerThreadBuffer>(3);
+    REQUIRE(buffer->GetThreadIndex() == 3);
+
+    Vector<ProfileResult> results;
+    REQUIRE(buffer->Drain(results) == 0);
+    REQUIRE(results.empty());
+
+    REQUIRE(buffer->Push(ProfileResult{ .name = "First", .start = 1, .end = 2, .threadIndex = 3 }));
+    REQUIRE(buffer->Push(ProfileResult{ .name = "Second", .start = 3, .end = 4, .threadIndex = 3 }));
+    REQUIRE(buffer->Drain(results) == 2);
+    REQUIRE(results.size() == 2);
+    REQUIRE(String(results[0].name) == "First");
+    REQUIRE(results[1].start == 3);
+    REQUIRE(results[1].end == 4);
+
+    REQUIRE(buffer->Drain(results) == 0);
+    REQUIRE(buffer->ExchangeDroppedCount() == 0);
+
+    REQUIRE_FALSE(buffer->IsRetired());
+    buffer->Retire();
+    REQUIRE(buffer->IsRetired());
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Profiler thread buffer drops results when full", "[profiler]")
+{
+    const auto buffer = CreateUPtr<ProfilerThreadBuffer>(0);
+
+    for (UInt64 i = 0; i < ProfilerThreadBuffer::Capacity; i++)
+    {
+        REQUIRE(buffer->Push(ProfileResult{ .name = "Result", .start = Int64(i), .end = Int64(i), .threadIndex = 0 }));
+    }
+
+    REQUIRE_FALSE(buffer->Push(ProfileResult{ .name = "Dropped", .start = 0, .end = 0, .threadIndex = 0 }));
+    REQUIRE(buffer->ExchangeDroppedCount() == 1);
+    REQUIRE(buffer->ExchangeDroppedCount() == 0);
+
+    Vector<ProfileResult> results;
+    REQUIRE(buffer->Drain(results) == ProfilerThreadBuffer::Capacity);
+    REQUIRE(results.back().start == Int64(ProfilerThreadBuffer::Capacity - 1));
+
+    // wrapped around the ring
+    REQUIRE(buffer->Push(ProfileResult{ .name = "Wrapped", .start = 42, .end = 42, .threadIndex = 0 }));
+    results.clear();
+    REQUIRE(buffer->Drain(results) == 1);
+    REQUIRE(results.front().start == 42);
+
+    REQUIRE(buffer->Push(ProfileResult{ .name = "Discarded", .start = 0, .end = 0, .threadIndex = 0 }));
+    buffer->Discard();
+    REQUIRE(buffer->Drain(results) == 0);
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Profiler session collects results from several threads", "[profiler]")
+{
+    const auto filepath = ProfilerTestFilepath("profiler_test_temp.kmptrace");
+    const auto jsonPath = ProfilerTestFilepath("profiler_test_temp.json");
+    auto& profiler = Profiler::Get();
+    profiler.SetLevel(ProfileLevelMinorVerbose);
+
+    profiler.BeginSession("Test", filepath, 16);
+    {
+        KMP_PROFILE_SCOPE("Main thread scope", ProfileLevelAlways);
+        KMP_PROFILE_FRAME_MARK();
+        KMP_PROFILE_COUNTER("Test counter", 3);
+        KMP_PROFILE_FLOW_BEGIN("Test flow", 1);
+
+        std::thread worker([]() {
+            for (auto i = 0; i < 100; i++)
+            {
+                KMP_PROFILE_SCOPE("Worker thread scope", ProfileLevelMinorVerbose);
+            }
+            KMP_PROFILE_FLOW_END("Test flow", 1);
+        });
+        worker.join();
+    }
+    profiler.EndSession();
+
+    REQUIRE(ProfilerTrace::ConvertToChromeJson(filepath, jsonPath));
+    const auto trace = ReadProfilerTestFile(jsonPath);
+    REQUIRE(trace.starts_with(R"rjs({"traceEvents":[{})rjs"));
+    REQUIRE(trace.find("Main thread scope") != String::npos);
+    REQUIRE(trace.find("Worker thread scope") != String::npos);
+    REQUIRE(trace.find(R"rjs("name":"Test counter","pid":0,"tid":0)rjs") != String::npos);
+    REQUIRE(trace.find(R"rjs("ph":"C","args":{"value":3})rjs") != String::npos);
+    REQUIRE(trace.find(R"rjs("ph":"i","s":"g")rjs") != String::npos);
+    REQUIRE(trace.find(R"rjs("ph":"f","cat":"flow","id":1,"bp":"e")rjs") != String::npos);
+    REQUIRE(trace.find(R"rjs("profileCount":"105")rjs") != String::npos);
+    REQUIRE(trace.ends_with("}}"));
+
+    // results outside of a session are not recorded
+    {
+        KMP_PROFILE_SCOPE("Outside of session scope", ProfileLevelAlways);
+    }
+    profiler.BeginSession("Test", filepath, 16);
+    profiler.EndSession();
+    REQUIRE(ReadProfilerTestFile(filepath).find("Outside of session scope") == String::npos);
+
+    std::filesystem::remove(filepath);
+    std::filesystem::remove(jsonPath);
+    profiler.SetLevel(ProfileLevelAlways);
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Profiler releases buffers of exited threads", "[profiler]")
+{
+    const auto filepath = ProfilerTestFilepath("profiler_test_temp.kmptrace");
+    const auto jsonPath = ProfilerTestFilepath("profiler_test_temp.json");
+    auto& profiler = Profiler::Get();
+
+    constexpr auto ThreadsCount = 32;
+    constexpr auto ScopesCount = 10;
+
+    profiler.BeginSession("Test", filepath, 16);
+    {
+        KMP_PROFILE_SCOPE("Main thread scope", ProfileLevelAlways);
+    }
+    const auto buffersCount = profiler.GetThreadBuffersCount();
+
+    for (auto threadIndex = 0; threadIndex < ThreadsCount; threadIndex++)
+    {
+        std::thread worker([]() {
+            for (auto i = 0; i < ScopesCount; i++)
+            {
+                KMP_PROFILE_SCOPE("Short-lived thread scope", ProfileLevelAlways);
+            }
+        });
+        worker.join();
+    }
+    profiler.EndSession();
+
+    // the final drain has written the results of every exited thread and released their buffers
+    REQUIRE(profiler.GetThreadBuffersCount() == buffersCount);
+    REQUIRE(ProfilerTrace::ConvertToChromeJson(filepath, jsonPath));
+    const auto trace = ReadProfilerTestFile(jsonPath);
+    REQUIRE(trace.find(R"rjs("profileCount":"321")rjs") != String::npos);
+
+    std::filesystem::remove(filepath);
+    std::filesystem::remove(jsonPath);
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("Profiler drops results recorded after the thread buffer is released", "[profiler]")
+{
+    const auto filepath = ProfilerTestFilepath("profiler_test_temp.kmptrace");
+    const auto jsonPath = ProfilerTestFilepath("profiler_test_temp.json");
+    auto& profiler = Profiler::Get();
+
+    // constructed before the profiler buffer owner of the thread, so destroyed after it
+    struct ThreadTeardownScope
+    {
+        ~ThreadTeardownScope()
+        {
+            KMP_PROFILE_SCOPE("Thread teardown scope", ProfileLevelAlways);
+        }
+    };
+
+    profiler.BeginSession("Test", filepath, 16);
+    {
+        KMP_PROFILE_SCOPE("Main thread scope", ProfileLevelAlways);
+    }
+    const auto buffersCount = profiler.GetThreadBuffersCount();
+
+    std::thread worker([]() {
+        KMP_MB_UNUSED thread_local ThreadTeardownScope teardownScope;
+
+        KMP_PROFILE_SCOPE("Worker thread scope", ProfileLevelAlways);
+    });
+    worker.join();
+    profiler.EndSession();
+
+    // the teardown scope neither used the released buffer nor registered a new one
+    REQUIRE(profiler.GetThreadBuffersCount() == buffersCount);
+    REQUIRE(ProfilerTrace::ConvertToChromeJson(filepath, jsonPath));
+    const auto trace = ReadProfilerTestFile(jsonPath);
+    REQUIRE(trace.find("Worker thread scope") != String::npos);
+    REQUIRE(trace.find("Thread teardown scope") == String::npos);
+
+    std::filesystem::remove(filepath);
+    std::filesystem::remove(jsonPath);
+}
+//--------------------------------------------------------------------------
+
+
+// Hidden from the default run, e.g.: ProfilerLib_UnitTests "[benchmark]" --benchmark-samples 5
+TEST_CASE("Profiler scope overhead", "[.][benchmark][profiler]")
+{
+    const auto filepath = ProfilerTestFilepath("profiler_benchmark_temp.kmptrace");
+    auto& profiler = Profiler::Get();
+    profiler.SetLevel(ProfileLevelMinor);
+
+    constexpr auto scopesCount = 1000;
+    constexpr auto threadsCount = 4;
+
+    profiler.BeginSession("Benchmark", filepath, 10'000);
+
+    BENCHMARK("Skipped scope (level too high) x1000")
+    {
+        for (auto i = 0; i < scopesCount; i++)
+        {
+            KMP_PROFILE_SCOPE("Benchmark skipped scope", ProfileLevelMinorVerbose);
+        }
+    };
+
+    BENCHMARK("Recorded scope, single thread x1000")
+    {
+        for (auto i = 0; i < scopesCount; i++)
+        {
+            KMP_PROFILE_SCOPE("Benchmark scope", ProfileLevelMinor);
+        }
+    };
+
+    BENCHMARK("Recorded scope, 4 threads x1000 each")
+    {
+        Vector<std::thread> threads;
+        for (auto threadIndex = 0; threadIndex < threadsCount; threadIndex++)
+        {
+            threads.emplace_back([]() {
+                for (auto i = 0; i < scopesCount; i++)
+                {
+                    KMP_PROFILE_SCOPE("Benchmark threaded scope", ProfileLevelMinor);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    profiler.EndSession();
+
+    std::filesystem::remove(filepath);
+    profiler.SetLevel(ProfileLevelAlways);
+}
+//--------------------------------------------------------------------------
+
+#endif
\ No newline at end of file
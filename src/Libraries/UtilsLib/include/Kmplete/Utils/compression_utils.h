@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+
+
+namespace Kmplete
+{
+    //! Fast general purpose byte compression, the stream layout follows the LZ4 block format
+    //! (sequences of literals followed by back references within the last 64 KiB) so the data
+    //! can also be inspected or produced by external LZ4 tools. Compression is a single greedy pass
+    //! over a hash table of 4-byte sequences, decompression is a bounds-checked copy loop
+    namespace Utils
+    {
+        //! @return compressed data, empty buffer for empty source
+        KMP_NODISCARD KMP_API BinaryBuffer CompressLZ(BinaryView source);
+
+        //! @param decompressedSize exact size of the original data, stored by the caller alongside the compressed data
+        //! @return decompressed data or empty buffer if the source is malformed or does not match decompressedSize
+        KMP_NODISCARD KMP_API BinaryBuffer DecompressLZ(BinaryView source, UInt64 decompressedSize);
+
+        //! Decompresses into caller-provided memory of exactly "destination.size()" bytes
+        //! @return false if the source is malformed or does not fill the destination exactly
+        KMP_NODISCARD KMP_API bool DecompressLZ(BinaryView source, Span<UByte> destination) noexcept;
+    }
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
 
 #include <cstddef>
 
@@ -14,5 +15,11 @@ namespace Kmplete
 
         //! Platform abstraction for aligned memory deallocation, use only for AlignedAlloc-ed memory
         KMP_API void AlignedFree(void* data);
+
+        static constexpr UInt64 HashBytesSeed = 14695981039346656037ULL;
+
+        //! 64-bit FNV-1a hash of a memory block, stable between runs and platforms (for the same bytes).
+        //! Blocks may be hashed in several calls by passing the previous result as a seed
+        KMP_NODISCARD KMP_API UInt64 HashBytes(const void* data, size_t size, UInt64 seed = HashBytesSeed) noexcept;
     }
 }
\ No newline at end of file
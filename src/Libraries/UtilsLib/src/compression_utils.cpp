@@ -0,0 +1,278 @@
+#include "Kmplete/Utils/compression_utils.h"
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Profile/profiler.h"
+
+#include <cstring>
+
+
+namespace Kmplete
+{
+    namespace Utils
+    {
+        static constexpr UInt32 LZMinMatch = 4;
+        static constexpr UInt32 LZLastLiterals = 5;
+        static constexpr UInt32 LZMatchFindLimit = 12;
+        static constexpr UInt32 LZMaxOffset = 65535;
+        static constexpr UInt32 LZHashLog = 14;
+        static constexpr UInt32 LZRunMask = 15;
+        static constexpr UInt32 LZSkipTrigger = 6;
+        static constexpr UInt64 LZMaxCompressionRatio = 255;
+        static constexpr Int64 LZCopyChunk = 16;
+
+
+        static UInt32 Read32(const UByte* data) noexcept
+        {
+            UInt32 value = 0;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+        //--------------------------------------------------------------------------
+
+        static UInt32 HashLZSequence(UInt32 sequence) noexcept
+        {
+            return (sequence * 2654435761U) >> (32 - LZHashLog);
+        }
+        //--------------------------------------------------------------------------
+
+        static void WriteLZLength(BinaryBuffer& destination, UInt64 length)
+        {
+            for (; length >= 255; length -= 255)
+            {
+                destination.push_back(255);
+            }
+            destination.push_back(UByte(length));
+        }
+        //--------------------------------------------------------------------------
+
+        static bool ReadLZLength(const UByte*& input, const UByte* inputEnd, UInt64& length) noexcept
+        {
+            UByte value = 255;
+            while (value == 255)
+            {
+                if (input == inputEnd)
+                {
+                    return false;
+                }
+
+                value = *input++;
+                length += value;
+            }
+
+            return true;
+        }
+        //--------------------------------------------------------------------------
+
+        static void WriteLZSequence(BinaryBuffer& destination, const UByte* literals, UInt64 literalsLength, UInt32 offset, UInt64 matchLength)
+        {
+            const auto literalsToken = UByte(std::min<UInt64>(literalsLength, LZRunMask));
+            const auto matchToken = UByte(offset == 0 ? 0 : std::min<UInt64>(matchLength - LZMinMatch, LZRunMask));
+            destination.push_back(UByte((literalsToken << 4) | matchToken));
+
+            if (literalsToken == LZRunMask)
+            {
+                WriteLZLength(destination, literalsLength - LZRunMask);
+            }
+
+            destination.insert(destination.end(), literals, literals + literalsLength);
+
+            // the last sequence of the block has literals only
+            if (offset == 0)
+            {
+                return;
+            }
+
+            destination.push_back(UByte(offset & 0xFF));
+            destination.push_back(UByte(offset >> 8));
+
+            if (matchToken == LZRunMask)
+            {
+                WriteLZLength(destination, matchLength - LZMinMatch - LZRunMask);
+            }
+        }
+        //--------------------------------------------------------------------------
+
+
+        BinaryBuffer CompressLZ(BinaryView source) KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            BinaryBuffer destination;
+            if (source.empty())
+            {
+                return destination;
+            }
+
+            const auto* data = source.data();
+            const auto size = UInt64(source.size());
+            destination.reserve(size + size / 255 + 16);
+
+            UInt64 anchor = 0;
+            if (size > LZMatchFindLimit)
+            {
+                // positions are stored incremented by one, so zero marks an empty slot
+                Vector<UInt32> hashTable(1ULL << LZHashLog, 0);
+
+                const auto matchFindLimit = size - LZMatchFindLimit;
+                const auto matchEndLimit = size - LZLastLiterals;
+                auto position = UInt64(0);
+
+                while (position < matchFindLimit)
+                {
+                    const auto sequence = Read32(data + position);
+                    auto& slot = hashTable[HashLZSequence(sequence)];
+                    const auto candidateSlot = slot;
+                    slot = UInt32(position + 1);
+
+                    auto candidate = UInt64(candidateSlot) - 1;
+                    if (candidateSlot == 0 || position - candidate > LZMaxOffset || Read32(data + candidate) != sequence)
+                    {
+                        // the longer nothing matches, the faster the incompressible data is skipped
+                        position += 1 + ((position - anchor) >> LZSkipTrigger);
+                        continue;
+                    }
+
+                    while (position > anchor && candidate > 0 && data[position - 1] == data[candidate - 1])
+                    {
+                        position--;
+                        candidate--;
+                    }
+
+                    auto matchLength = UInt64(LZMinMatch);
+                    while (position + matchLength < matchEndLimit && data[candidate + matchLength] == data[position + matchLength])
+                    {
+                        matchLength++;
+                    }
+
+                    WriteLZSequence(destination, data + anchor, position - anchor, UInt32(position - candidate), matchLength);
+
+                    position += matchLength;
+                    anchor = position;
+
+                    if (position < matchFindLimit)
+                    {
+                        hashTable[HashLZSequence(Read32(data + position - 2))] = UInt32(position - 2 + 1);
+                    }
+                }
+            }
+
+            WriteLZSequence(destination, data + anchor, size - anchor, 0, 0);
+
+            return destination;
+        }}
+        //--------------------------------------------------------------------------
+
+        BinaryBuffer DecompressLZ(BinaryView source, UInt64 decompressedSize) KMP_PROFILING(ProfileLevelImportantVerbose)
+        {
+            if (decompressedSize > UInt64(source.size()) * LZMaxCompressionRatio + LZRunMask)
+            {
+                KMP_LOG_ERROR_FN("Utils: DecompressLZ - declared size {} is impossible for {} bytes of compressed data", decompressedSize, source.size());
+                return BinaryBuffer();
+            }
+
+            BinaryBuffer destination(decompressedSize);
+            if (not DecompressLZ(source, Span<UByte>(destination)))
+            {
+                KMP_LOG_ERROR_FN("Utils: DecompressLZ - malformed compressed data");
+                return BinaryBuffer();
+            }
+
+            return destination;
+        }}
+        //--------------------------------------------------------------------------
+
+        bool DecompressLZ(BinaryView source, Span<UByte> destination) noexcept
+        {
+            const auto* input = source.data();
+            const auto* const inputEnd = input + source.size();
+            auto* output = destination.data();
+            auto* const outputBegin = output;
+            auto* const outputEnd = output + destination.size();
+
+            while (input < inputEnd)
+            {
+                const auto token = *input++;
+
+                auto literalsLength = UInt64(token >> 4);
+                if (literalsLength == LZRunMask && not ReadLZLength(input, inputEnd, literalsLength))
+                {
+                    return false;
+                }
+
+                if (literalsLength > UInt64(inputEnd - input) || literalsLength > UInt64(outputEnd - output))
+                {
+                    return false;
+                }
+
+                // short literals far enough from both ends are copied with a single fixed-size chunk
+                if (literalsLength <= UInt64(LZCopyChunk) && inputEnd - input >= LZCopyChunk && outputEnd - output >= LZCopyChunk)
+                {
+                    std::memcpy(output, input, LZCopyChunk);
+                }
+                else if (literalsLength > 0)
+                {
+                    std::memcpy(output, input, literalsLength);
+                }
+                input += literalsLength;
+                output += literalsLength;
+
+                if (input == inputEnd)
+                {
+                    break;
+                }
+
+                if (inputEnd - input < 2)
+                {
+                    return false;
+                }
+
+                const auto offset = UInt64(input[0]) | (UInt64(input[1]) << 8);
+                input += 2;
+                if (offset == 0 || offset > UInt64(output - outputBegin))
+                {
+                    return false;
+                }
+
+                auto matchLength = UInt64(token & LZRunMask);
+                if (matchLength == LZRunMask && not ReadLZLength(input, inputEnd, matchLength))
+                {
+                    return false;
+                }
+
+                matchLength += LZMinMatch;
+                if (matchLength > UInt64(outputEnd - output))
+                {
+                    return false;
+                }
+
+                const auto* match = output - offset;
+                auto* const matchEnd = output + matchLength;
+
+                // with the distance of at least one chunk every chunk is free of overlapping, bytes written past
+                // the match end are overwritten by the next sequence, so chunks may overrun it while there is room
+                if (offset >= LZCopyChunk)
+                {
+                    if (outputEnd - matchEnd >= LZCopyChunk)
+                    {
+                        for (; output < matchEnd; output += LZCopyChunk, match += LZCopyChunk)
+                        {
+                            std::memcpy(output, match, LZCopyChunk);
+                        }
+                        output = matchEnd;
+                        continue;
+                    }
+
+                    for (; matchEnd - output >= LZCopyChunk; output += LZCopyChunk, match += LZCopyChunk)
+                    {
+                        std::memcpy(output, match, LZCopyChunk);
+                    }
+                }
+
+                while (output < matchEnd)
+                {
+                    *output++ = *match++;
+                }
+            }
+
+            return output == outputEnd;
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
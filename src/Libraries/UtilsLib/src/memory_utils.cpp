@@ -45,5 +45,19 @@ namespace Kmplete
 #endif
         }
         //--------------------------------------------------------------------------
+
+        UInt64 HashBytes(const void* data, size_t size, UInt64 seed /*= HashBytesSeed*/) noexcept
+        {
+            const auto bytes = static_cast<const UByte*>(data);
+
+            auto hash = seed;
+            for (size_t i = 0; i < size; i++)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ULL;
+            }
+
+            return hash;
+        }
+        //--------------------------------------------------------------------------
     }
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Utils/compression_utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+
+using namespace Kmplete;
+
+
+static BinaryBuffer CreateRandomBuffer(UInt64 size, UInt32 alphabetSize, unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<UInt32> distribution(0, alphabetSize - 1);
+
+    BinaryBuffer buffer(size);
+    for (auto& value : buffer)
+    {
+        value = UByte(distribution(generator));
+    }
+
+    return buffer;
+}
+//--------------------------------------------------------------------------
+
+static void RequireRoundTrip(const BinaryBuffer& source)
+{
+    const auto compressed = Utils::CompressLZ(source);
+    const auto decompressed = Utils::DecompressLZ(compressed, source.size());
+    REQUIRE(decompressed == source);
+}
+//--------------------------------------------------------------------------
+
+
+TEST_CASE("CompressLZ and DecompressLZ round trip", "[utils][compression]")
+{
+    SECTION("empty source")
+    {
+        REQUIRE(Utils::CompressLZ(BinaryBuffer()).empty());
+        REQUIRE(Utils::DecompressLZ(BinaryBuffer(), 0).empty());
+    }
+
+    SECTION("sources shorter than the minimal match")
+    {
+        for (UInt64 size = 1; size < 20; size++)
+        {
+            RequireRoundTrip(BinaryBuffer(size, 42));
+        }
+    }
+
+    SECTION("single value run")
+    {
+        const auto source = BinaryBuffer(100000, 7);
+        const auto compressed = Utils::CompressLZ(source);
+        REQUIRE(compressed.size() < source.size() / 100);
+        REQUIRE(Utils::DecompressLZ(compressed, source.size()) == source);
+    }
+
+    SECTION("short repeated patterns")
+    {
+        for (UInt64 period = 1; period <= 16; period++)
+        {
+            BinaryBuffer source(5000);
+            for (UInt64 i = 0; i < source.size(); i++)
+            {
+                source[i] = UByte(i % period);
+            }
+
+            RequireRoundTrip(source);
+        }
+    }
+
+    SECTION("low entropy data")
+    {
+        const auto source = CreateRandomBuffer(1 << 20, 4, 1);
+        const auto compressed = Utils::CompressLZ(source);
+        REQUIRE(compressed.size() < source.size());
+        REQUIRE(Utils::DecompressLZ(compressed, source.size()) == source);
+    }
+
+    SECTION("incompressible data")
+    {
+        const auto source = CreateRandomBuffer(300000, 256, 2);
+        const auto compressed = Utils::CompressLZ(source);
+        REQUIRE(compressed.size() <= source.size() + source.size() / 255 + 16);
+        REQUIRE(Utils::DecompressLZ(compressed, source.size()) == source);
+    }
+
+    SECTION("matches farther than the maximal offset")
+    {
+        auto source = CreateRandomBuffer(200000, 256, 3);
+        std::copy(source.begin(), source.begin() + 1000, source.begin() + 150000);
+        RequireRoundTrip(source);
+    }
+
+    SECTION("decompression into caller memory")
+    {
+        const auto source = CreateRandomBuffer(10000, 8, 4);
+        const auto compressed = Utils::CompressLZ(source);
+
+        BinaryBuffer destination(source.size());
+        REQUIRE(Utils::DecompressLZ(compressed, Span<UByte>(destination)));
+        REQUIRE(destination == source);
+
+        BinaryBuffer smallDestination(source.size() - 1);
+        REQUIRE_FALSE(Utils::DecompressLZ(compressed, Span<UByte>(smallDestination)));
+    }
+}
+//--------------------------------------------------------------------------
+
+TEST_CASE("DecompressLZ malformed data", "[utils][compression]")
+{
+    const auto source = CreateRandomBuffer(10000, 8, 5);
+    const auto compressed = Utils::CompressLZ(source);
+
+    REQUIRE(Utils::DecompressLZ(compressed, source.size() + 1).empty());
+    REQUIRE(Utils::DecompressLZ(compressed, source.size() - 1).empty());
+    REQUIRE(Utils::DecompressLZ(BinaryView(compressed).first(compressed.size() / 2), source.size()).empty());
+    REQUIRE(Utils::DecompressLZ(compressed, UInt64(compressed.size()) * 1000).empty());
+
+    // match referencing data before the beginning of the output
+    const BinaryBuffer invalidOffset = { 0x10, 0xAA, 0x05, 0x00, 0x00 };
+    REQUIRE(Utils::DecompressLZ(invalidOffset, 5).empty());
+
+    // literals length runs out of the input
+    const BinaryBuffer truncatedLiterals = { 0xF0, 0xFF };
+    REQUIRE(Utils::DecompressLZ(truncatedLiterals, 300).empty());
+
+    // zero offset is never produced
+    const BinaryBuffer zeroOffset = { 0x10, 0xAA, 0x00, 0x00, 0x00 };
+    REQUIRE(Utils::DecompressLZ(zeroOffset, 5).empty());
+
+    for (UInt64 position = 0; position < compressed.size(); position += 97)
+    {
+        auto corrupted = compressed;
+        corrupted[position] ^= 0xFF;
+        const auto decompressed = Utils::DecompressLZ(corrupted, source.size());
+        REQUIRE((decompressed.empty() || decompressed.size() == source.size()));
+    }
+}
+//--------------------------------------------------------------------------
\ No newline at end of file
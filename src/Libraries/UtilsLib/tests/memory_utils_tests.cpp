@@ -97,4 +97,19 @@ TEST_CASE("AlignedAlloc and AlignedFree double tests", "[utils][memory]")
         REQUIRE(alignedDouble != nullptr);
     }
 }
+//--------------------------------------------------------------------------
+
+TEST_CASE("HashBytes tests", "[utils][memory]")
+{
+    using namespace Kmplete::Utils;
+
+    const char data[] = "Kmplete";
+    const auto hash = HashBytes(data, sizeof(data) - 1);
+
+    REQUIRE(HashBytes(nullptr, 0) == HashBytesSeed);
+    REQUIRE(HashBytes("a", 1) == 0xAF63DC4C8601EC8CULL); // FNV-1a reference value
+    REQUIRE(hash == HashBytes(data, sizeof(data) - 1));
+    REQUIRE(hash != HashBytes(data, sizeof(data) - 2));
+    REQUIRE(hash == HashBytes(data + 3, 4, HashBytes(data, 3)));
+}
 //--------------------------------------------------------------------------
\ No newline at end of file
@@ -174,7 +174,7 @@ namespace Kmplete
             { *indexBuffer, vertexBufferSize + instanceBufferSize, 0, indexBufferSize },
             { *indirectBuffer, vertexBufferSize + instanceBufferSize + indexBufferSize, 0, drawInstancedBufferSize },
             { *indirectBuffer, vertexBufferSize + instanceBufferSize + indexBufferSize + drawInstancedBufferSize, drawInstancedBufferSize, drawIndexedInstanceBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -201,7 +201,7 @@ namespace Kmplete
             { FragmentShaderModule_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("draw_indirect.frag"), Graphics::ShaderSourceType::SourceFile, ShaderCompiler::ShaderType::Fragment }
         });
 #endif
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShaderModule_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShaderModule_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -217,7 +217,8 @@ namespace Kmplete
         });
         pipelineParams.AddDynamicStates({ VK_Dynamic_Viewport, VK_Dynamic_Scissor, VK_Dynamic_RasterizationSamples });
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "draw_indirect_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "draw_indirect_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
     }
     //--------------------------------------------------------------------------
 
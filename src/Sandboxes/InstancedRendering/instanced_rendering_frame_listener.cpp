@@ -152,7 +152,7 @@ namespace Kmplete
             { *vertexBufferPosInstanced, vertexBufferSize, 0, vertexInstancedBufferSize },
             { *vertexBufferColorsInstanced, vertexBufferSize + vertexInstancedBufferSize, 0, vertexColorsInstancedBufferSize },
             { *indexBuffer, vertexBufferSize + vertexInstancedBufferSize + vertexColorsInstancedBufferSize, 0, indexBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -170,7 +170,7 @@ namespace Kmplete
             { VertexShaderModule_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/instanced_rendering.vert.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShaderModule_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/instanced_rendering.frag.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShaderModule_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShaderModule_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -185,7 +185,8 @@ namespace Kmplete
         pipelineParams.AddVertexInputBindingsDivisors({ { InstanceColorBufferBinding, 2 } }); // only color divisor set to 2, position divisor default 1 is ok
         pipelineParams.AddDynamicStates({ VK_Dynamic_Viewport, VK_Dynamic_Scissor, VK_Dynamic_RasterizationSamples });
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "instanced_rendering_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "instanced_rendering_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
     }
     //--------------------------------------------------------------------------
 
@@ -120,7 +120,7 @@ namespace Kmplete
         renderer.CopyBuffers(stagingBuffer, {
             { *vertexBufferFixedColor, 0, 0, fixedColorBufferSize },
             { *vertexBufferBufferedColor, fixedColorBufferSize, 0, bufferedColorBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -142,11 +142,11 @@ namespace Kmplete
             { VertexShader_BufferedColor_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/multiple_pipelines_buffered_color.vert.spv"),  Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShader_BufferedColor_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/multiple_pipelines_buffered_color.frag.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto fixedColorShaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto fixedColorShaderStages = shaderManager.GetShaderStages({
             { VertexShader_FixedColor_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShader_FixedColor_SID, VK_ShaderStage_Fragment, "main" }
         });
-        const auto bufferedColorShaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto bufferedColorShaderStages = shaderManager.GetShaderStages({
             { VertexShader_BufferedColor_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShader_BufferedColor_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -178,11 +178,14 @@ namespace Kmplete
         pipelineBufferedColorLineParams.SetLineWidth(8.0f);
         pipelineBufferedColorLineParams.SetLineStipple(true, 1, 1);
 
-        const auto& applicationDataPath = ApplicationContext::GetApplicationDataPath();
-        pipelineManager.AddGraphicsPipeline(Pipeline_FixedColor_Fill_SID, PipelineLayout_SID, pipelineFixedColorFillParams, applicationDataPath / "multiple_pipelines_fixed_color_fill_pipeline_cache.bin");
-        pipelineManager.AddGraphicsPipeline(Pipeline_FixedColor_Line_SID, PipelineLayout_SID, pipelineFixedColorLineParams, applicationDataPath / "multiple_pipelines_fixed_color_line_pipeline_cache.bin");
-        pipelineManager.AddGraphicsPipeline(Pipeline_BufferedColor_Fill_SID, PipelineLayout_SID, pipelineBufferedColorFillParams, applicationDataPath / "multiple_pipelines_buffered_color_fill_pipeline_cache.bin");
-        pipelineManager.AddGraphicsPipeline(Pipeline_BufferedColor_Line_SID, PipelineLayout_SID, pipelineBufferedColorLineParams, applicationDataPath / "multiple_pipelines_buffered_color_line_pipeline_cache.bin");
+        // all four pipelines are compiled in parallel on worker threads and are drawn as soon as they are ready
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "multiple_pipelines_pipeline_cache.bin");
+        pipelineManager.CompileGraphicsPipelinesAsync({
+            { Pipeline_FixedColor_Fill_SID, PipelineLayout_SID, pipelineFixedColorFillParams },
+            { Pipeline_FixedColor_Line_SID, PipelineLayout_SID, pipelineFixedColorLineParams },
+            { Pipeline_BufferedColor_Fill_SID, PipelineLayout_SID, pipelineBufferedColorFillParams },
+            { Pipeline_BufferedColor_Line_SID, PipelineLayout_SID, pipelineBufferedColorLineParams }
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -193,6 +196,7 @@ namespace Kmplete
         const auto& vulkanBufferManager = vulkanDevice.GetBufferManager();
         const auto& vulkanTextureAttachmentManager = vulkanDevice.GetTextureAttachmentManager();
         const auto& renderer = vulkanDevice.GetRenderer();
+        const auto& pipelineManager = vulkanDevice.GetPipelineManager();
         const auto drawArea = VkRect2D{ VkOffset2D{ .x = 0, .y = 0 }, vulkanDevice.GetCurrentExtent() };
         const auto viewport = Graphics::VKUtils::CreateViewport(_mainWindow);
 
@@ -219,17 +223,29 @@ namespace Kmplete
 
         // fixed color drawing
         renderer.BindVertexBuffers(VertexBufferBinding, { vulkanBufferManager.GetVertexBuffer(VertexBufferFixed_SID)->GetVkBuffer()}, {0});
-        renderer.BindGraphicsPipeline(Pipeline_FixedColor_Fill_SID);
-        renderer.Draw(3, 1, 0, 0);
-        renderer.BindGraphicsPipeline(Pipeline_FixedColor_Line_SID);
-        renderer.Draw(3, 1, 3, 0);
+        if (pipelineManager.IsGraphicsPipelineReady(Pipeline_FixedColor_Fill_SID))
+        {
+            renderer.BindGraphicsPipeline(Pipeline_FixedColor_Fill_SID);
+            renderer.Draw(3, 1, 0, 0);
+        }
+        if (pipelineManager.IsGraphicsPipelineReady(Pipeline_FixedColor_Line_SID))
+        {
+            renderer.BindGraphicsPipeline(Pipeline_FixedColor_Line_SID);
+            renderer.Draw(3, 1, 3, 0);
+        }
 
         // buffered color drawing
         renderer.BindVertexBuffers(VertexBufferBinding, { vulkanBufferManager.GetVertexBuffer(VertexBufferBuffered_SID)->GetVkBuffer() }, { 0 });
-        renderer.BindGraphicsPipeline(Pipeline_BufferedColor_Fill_SID);
-        renderer.Draw(3, 1, 0, 0);
-        renderer.BindGraphicsPipeline(Pipeline_BufferedColor_Line_SID);
-        renderer.Draw(3, 1, 3, 0);
+        if (pipelineManager.IsGraphicsPipelineReady(Pipeline_BufferedColor_Fill_SID))
+        {
+            renderer.BindGraphicsPipeline(Pipeline_BufferedColor_Fill_SID);
+            renderer.Draw(3, 1, 0, 0);
+        }
+        if (pipelineManager.IsGraphicsPipelineReady(Pipeline_BufferedColor_Line_SID))
+        {
+            renderer.BindGraphicsPipeline(Pipeline_BufferedColor_Line_SID);
+            renderer.Draw(3, 1, 3, 0);
+        }
 
         renderer.EndRendering();
     }
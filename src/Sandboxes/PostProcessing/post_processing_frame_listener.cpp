@@ -23,6 +23,7 @@ namespace Kmplete
 {
     static constexpr auto PostProcessingDSLayout_SID = "PostProcessingDSLayout"_sid;
     static constexpr auto PostProcessingSet_SID = "PostProcessingSet"_sid;
+    static constexpr auto PostProcessingUpdateTemplate_SID = "PostProcessingUpdateTemplate"_sid;
 
     static constexpr auto PipelineLayout_SID = "PipelineLayout"_sid;
     static constexpr auto Pipeline_SID = "Pipeline"_sid;
@@ -64,6 +65,14 @@ namespace Kmplete
             float position[2];
             float texCoord[2];
         };
+
+        // The whole post processing set is rewritten every frame with a single descriptor update template
+        struct PostProcessingDescriptors
+        {
+            VkDescriptorImageInfo texture;
+            VkDescriptorImageInfo sampler;
+            VkDescriptorBufferInfo uniformBuffer;
+        };
     }
 
     using namespace Graphics::VKBits;
@@ -140,7 +149,7 @@ namespace Kmplete
         renderer.CopyBuffers(stagingBuffer, {
             { *vertexBuffer, 0, 0, vertexBufferSize },
             { *vertexBufferResolve, vertexBufferSize, 0, verticesResolveBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -148,7 +157,6 @@ namespace Kmplete
     {
         auto& vulkanBufferManager = vulkanDevice.GetBufferManager();
         auto& descriptorSetManager = vulkanDevice.GetDescriptorSetManager();
-        const auto& samplersStorage = vulkanDevice.GetSamplersStorage();
 
         VkDescriptorSetLayoutBinding textureLayoutBinding{ TextureBindingIndex, VK_DescriptorType_SampledImage, 1, VK_ShaderStage_Fragment };
         VkDescriptorSetLayoutBinding samplerLayoutBinding{ SamplerBindingIndex, VK_DescriptorType_Sampler, 1, VK_ShaderStage_Fragment };
@@ -156,14 +164,16 @@ namespace Kmplete
         const auto postProcessingUniformsLayout = descriptorSetManager.AddDescriptorSetLayout(PostProcessingDSLayout_SID, { textureLayoutBinding, samplerLayoutBinding, uboLayoutBinding });
         descriptorSetManager.AllocateDescriptorSets(postProcessingUniformsLayout, PostProcessingSet_SID, 1, "per frame"_true);
 
+        descriptorSetManager.AddDescriptorUpdateTemplate(PostProcessingUpdateTemplate_SID, PostProcessingDSLayout_SID, {
+            { TextureBindingIndex, 0, 1, VK_DescriptorType_SampledImage, offsetof(PostProcessingDescriptors, texture), 0 },
+            { SamplerBindingIndex, 0, 1, VK_DescriptorType_Sampler, offsetof(PostProcessingDescriptors, sampler), 0 },
+            { UniformBufferIndex, 0, 1, VK_DescriptorType_UniformBuffer, offsetof(PostProcessingDescriptors, uniformBuffer), 0 }
+        });
+
         vulkanBufferManager.CreateUniformBuffer(UniformBuffersResolve_SID, { 0, VK_Memory_HostVisible | VK_Memory_HostCoherent, sizeof(VkExtent2D) }, "per frame"_true);
         for (auto i = 0; i < Graphics::NumConcurrentFrames; i++)
         {
-            auto uniformBuffer = vulkanBufferManager.GetBuffer(UniformBuffersResolve_SID, i);
-            uniformBuffer->Map();
-
-            descriptorSetManager.SetSamplerDescriptor(PostProcessingSet_SID, 0, "per frame"_true, i, samplersStorage.GetSampler(Graphics::SamplerDefaultNearestSid), SamplerBindingIndex);
-            descriptorSetManager.SetUniformBufferDescriptor(PostProcessingSet_SID, 0, "per frame"_true, i, *uniformBuffer, uniformBuffer->GetSize(), 0, UniformBufferIndex);
+            vulkanBufferManager.GetBuffer(UniformBuffersResolve_SID, i)->Map();
         }
     }
     //--------------------------------------------------------------------------
@@ -185,11 +195,11 @@ namespace Kmplete
             { VertexShaderResolveModule_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/post_processing_post.vert.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShaderResolveModule_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/post_processing_post.frag.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShaderModule_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShaderModule_SID, VK_ShaderStage_Fragment, "main" }
         });
-        const auto shaderPostStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderPostStages = shaderManager.GetShaderStages({
             { VertexShaderResolveModule_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShaderResolveModule_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -206,7 +216,8 @@ namespace Kmplete
         pipelineParams.AddDynamicState(VK_Dynamic_Scissor);
         pipelineParams.AddDynamicState(VK_Dynamic_RasterizationSamples);
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "post_processing_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "post_processing_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
 
 
         auto pipelinePostParams = Graphics::VulkanGraphicsPipelineParameters();
@@ -218,7 +229,7 @@ namespace Kmplete
         pipelinePostParams.AddDynamicState(VK_Dynamic_Scissor);
         pipelinePostParams.AddDynamicState(VK_Dynamic_RasterizationSamples);
 
-        pipelineManager.AddGraphicsPipeline(PipelineResolve_SID, PipelineLayout_SID, pipelinePostParams, ApplicationContext::GetApplicationDataPath() / "post_processing_post_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(PipelineResolve_SID, PipelineLayout_SID, pipelinePostParams);
     }
     //--------------------------------------------------------------------------
 
@@ -350,6 +361,7 @@ namespace Kmplete
 
         // 2.2 Prepare color attachments and insert memory barriers for reading previously written image from shader (use resolve texture when MSAA > 1)
         VkRenderingAttachmentInfo colorAttachmentResolveInfo{};
+        VkImageView sampledImageView = VK_NULL_HANDLE;
         auto colorShaderReadMemoryBarrierParameters = Graphics::VKPresets::MemoryBarrierParameters_ColorAttachment_PrepareReadFromShader;
         if (currentMSAA == VK_SampleCount_1)
         {
@@ -358,7 +370,7 @@ namespace Kmplete
                 Graphics::VKPresets::RenderingAttachmentInfo_Color_ClearStore,
                 MS_ColorAttachment, 0ULL, VK_Resolve_Average, VK_ImageLayout_AttachmentOptimal, "swapchain image for non-MSAA"_true
             );
-            descriptorSetManager.SetSampledImageDescriptor(PostProcessingSet_SID, 0, "per frame"_true, currentBufferIndex, colorAttachmentMS->get().GetVkImageView(), TextureBindingIndex);
+            sampledImageView = colorAttachmentMS->get().GetVkImageView();
         }
         else
         {
@@ -367,12 +379,20 @@ namespace Kmplete
                 Graphics::VKPresets::RenderingAttachmentInfo_Color_ClearStore,
                 ColorAttachmentResolve, 0ULL, VK_Resolve_None, VK_ImageLayout_AttachmentOptimal, "swapchain image for non-MSAA"_true
             );
-            descriptorSetManager.SetSampledImageDescriptor(PostProcessingSet_SID, 0, "per frame"_true, currentBufferIndex, colorAttachmentResolve->get().GetVkImageView(), TextureBindingIndex);
+            sampledImageView = colorAttachmentResolve->get().GetVkImageView();
         }
 
-        // 2.3 Update uniform buffer data
+        // 2.3 Update uniform buffer data and rewrite the whole descriptor set of the current frame at once
+        const auto uniformBuffer = vulkanBufferManager.GetBuffer(UniformBuffersResolve_SID, currentBufferIndex);
         Vector<float> uboData = { float(currentExtent.width), float(currentExtent.height) };
-        vulkanBufferManager.GetBuffer(UniformBuffersResolve_SID, currentBufferIndex)->CopyToMappedMemory(0, uboData.data(), sizeof(VkExtent2D));
+        uniformBuffer->CopyToMappedMemory(0, uboData.data(), sizeof(VkExtent2D));
+
+        const PostProcessingDescriptors descriptors{
+            .texture = { VK_NULL_HANDLE, sampledImageView, VK_ImageLayout_ShaderReadOnlyOptimal },
+            .sampler = { vulkanDevice.GetSamplersStorage().GetSampler(Graphics::SamplerDefaultNearestSid), VK_NULL_HANDLE, VK_ImageLayout_Undefined },
+            .uniformBuffer = { uniformBuffer->GetVkBuffer(), 0, uniformBuffer->GetSize() }
+        };
+        descriptorSetManager.UpdateDescriptorSetWithTemplate(PostProcessingSet_SID, 0, "per frame"_true, currentBufferIndex, PostProcessingUpdateTemplate_SID, &descriptors);
 
         // 2.4 Render screen quad with an offscreen attachment as texture
         renderer.BeginRendering(drawArea, { colorAttachmentResolveInfo });
@@ -442,6 +462,7 @@ namespace Kmplete
         renderer.BeginRendering(drawArea, { colorAttachmentInfo } );
         vulkanImGuiUtils->SetCommandBuffer(commandBuffer);
         vulkanImGuiUtils->Render();
+        renderer.InvalidateBoundPipeline();
         renderer.EndRendering();
 
         ImGui::EndFrame();
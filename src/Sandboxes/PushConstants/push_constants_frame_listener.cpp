@@ -82,7 +82,7 @@ namespace Kmplete
 
         renderer.CopyBuffers(stagingBuffer, {
             { *vertexBuffer, 0, 0, vertexBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
 
         for (auto i = 0; i < InstancesCount; i++)
         {
@@ -107,7 +107,7 @@ namespace Kmplete
             { VertexShaderModule_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/push_constants.vert.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShaderModule_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/push_constants.frag.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShaderModule_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShaderModule_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -119,7 +119,8 @@ namespace Kmplete
         pipelineParams.AddVertexBufferAttributesBindings(*vulkanDevice.GetBufferManager().GetVertexBuffer(VertexBuffer_SID), VertexBufferBinding);
         pipelineParams.AddDynamicStates({ VK_Dynamic_Viewport, VK_Dynamic_Scissor, VK_Dynamic_RasterizationSamples });
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "push_constants_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "push_constants_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
     }
     //--------------------------------------------------------------------------
 
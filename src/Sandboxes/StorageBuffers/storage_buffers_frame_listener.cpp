@@ -208,7 +208,7 @@ namespace Kmplete
         vulkanRenderer.CopyBuffers(stagingBuffer, {
             { *vertexBuffer, 0, 0, vertexBufferSize },
             { *indexBuffer, vertexBufferSize, 0, indexBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -279,7 +279,7 @@ namespace Kmplete
             { VertexShader_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/storage_buffers.vert.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShader_SID, Filepath(KMP_SANDBOX_RESOURCES_FOLDER).append("spv/storage_buffers.frag.spv"), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShader_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShader_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -292,7 +292,8 @@ namespace Kmplete
         pipelineParams.AddVertexBufferAttributesBindings(*vulkanDevice.GetBufferManager().GetVertexBuffer(VertexBuffer_SID), VertexBufferBinding);
         pipelineParams.AddDynamicStates({ VK_Dynamic_Viewport, VK_Dynamic_Scissor, VK_Dynamic_RasterizationSamples });
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "storage_buffers_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "storage_buffers_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
     }
     //--------------------------------------------------------------------------
 
@@ -8,7 +8,8 @@
 #include "Kmplete/Core/assertion.h"
 #include "Kmplete/Graphics/font.h"
 #include "Kmplete/Graphics/font_character.h"
-#include "Kmplete/Graphics/image.h"
+#include "Kmplete/Graphics/glyph_atlas.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_text_renderer.h"
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_graphics_base.h"
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_graphics_backend.h"
 #include "Kmplete/Graphics/Vulkan/Core/vulkan_physical_device.h"
@@ -34,9 +35,6 @@
 #include "Kmplete/Assets/font_asset_manager.h"
 #include "Kmplete/Assets/font_asset.h"
 
-#include <ft2build.h>
-#include FT_FREETYPE_H
-
 
 namespace Kmplete
 {
@@ -49,27 +47,22 @@ namespace Kmplete
     static constexpr auto VertexShader_SID = "TextRendering_vertex"_sid;
     static constexpr auto FragmentShader_SID = "TextRendering_fragment"_sid;
 
-    static constexpr auto TextureFontAtlas_SID = "texture_font_atlas"_sid;
+    static constexpr auto FontPixelSize = UInt8(Graphics::Font::DefaultFontPixelSize);
 
     static constexpr auto SamplerBindingIndex = 0;
     static constexpr auto TextureBindingIndex = 1;
 
     static constexpr auto VertexBufferBinding = 0;
 
-    static constexpr auto VertexPositionAttributeIndex = 0;
-    static constexpr auto VertexUVAttributeIndex = 1;
-
     static constexpr auto MS_ColorAttachment = "color_attachment_ms"_sid;
     static constexpr auto MS_DepthStencilAttachment = "depth_attachment_ms"_sid;
 
-    static constexpr auto VertexBuffer_SID = "vertex_buffer"_sid;
     static constexpr auto UniformBuffers_SID = "uniform_buffers"_sid;
 
 
     using namespace Graphics::VKBits;
 
-    Map<wchar_t, Graphics::FontCharacter> cyrillicLocaleCharactersMap;
-    Vector<wchar_t> cyrillicLocaleCodes;
+    Vector<UInt32> cyrillicLocaleCodes;
 
     void InitializeCyrillicLocaleCodes()
     {
@@ -119,113 +112,6 @@ namespace Kmplete
     }
     //--------------------------------------------------------------------------
 
-    void CalculateAtlasSize(FT_FaceRec_* ftFace, unsigned int& atlasWidth, unsigned int& atlasHeight)
-    {
-        for (const auto& c : cyrillicLocaleCodes)
-        {
-            if ((FT_Load_Char(ftFace, c, FT_LOAD_RENDER) != FT_Err_Ok) || (FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_SDF) != FT_Err_Ok))
-            {
-                continue;
-            }
-
-            atlasWidth += ftFace->glyph->bitmap.width + 1;
-            atlasHeight = std::max(atlasHeight, ftFace->glyph->bitmap.rows);
-        }
-    }
-    //--------------------------------------------------------------------------
-
-    BinaryBuffer CalculateAtlasData(FT_FaceRec_* ftFace, unsigned int atlasWidth, unsigned int atlasHeight)
-    {
-        BinaryBuffer atlasData(atlasWidth * atlasHeight, 0);
-        unsigned int offsetX = 0;
-
-        for (const auto& c : cyrillicLocaleCodes)
-        {
-            if ((FT_Load_Char(ftFace, c, FT_LOAD_RENDER) != FT_Err_Ok) || (FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_SDF) != FT_Err_Ok))
-            {
-                continue;
-            }
-
-            FT_Bitmap& bitmap = ftFace->glyph->bitmap;
-            for (unsigned int y = 0; y < bitmap.rows; y++)
-            {
-                for (unsigned int x = 0; x < bitmap.width; x++)
-                {
-                    unsigned int atlasIndex = y * atlasWidth + (offsetX + x);
-                    unsigned int glyphIndex = y * bitmap.width + x;
-                    atlasData[atlasIndex] = bitmap.buffer[glyphIndex];
-                }
-            }
-
-            Graphics::FontCharacter character = {
-                .uvMin = { float(offsetX) / float(atlasWidth), 0.0f },
-                .uvMax = { float(offsetX + bitmap.width) / float(atlasWidth), float(bitmap.rows) / float(atlasHeight) },
-                .size = { int(bitmap.width), int(bitmap.rows) },
-                .bearing = { ftFace->glyph->bitmap_left, ftFace->glyph->bitmap_top },
-                .advance = (unsigned int)ftFace->glyph->advance.x
-            };
-
-            cyrillicLocaleCharactersMap[c] = character;
-            offsetX += bitmap.width + 1;
-        }
-
-        return atlasData;
-    }
-    //--------------------------------------------------------------------------
-
-    Graphics::Image GenerateTextureAtlas(FT_FaceRec_* ftFace)
-    {
-        unsigned int atlasWidth = 0;
-        unsigned int atlasHeight = 0;
-        CalculateAtlasSize(ftFace, atlasWidth, atlasHeight);
-        const auto atlasData = CalculateAtlasData(ftFace, atlasWidth, atlasHeight);
-
-        return Graphics::Image(atlasData.data(), int(atlasData.size()), { atlasWidth, atlasHeight }, Graphics::ImageChannels::Grey);
-    }
-    //--------------------------------------------------------------------------
-
-    Vector<Graphics::FontCharacterVertex> GenerateTextVertices(const WString& text, float x, float y, float scale, float screenWidth, float screenHeight)
-    {
-        Vector<Graphics::FontCharacterVertex> vertices;
-        vertices.reserve(6);
-
-        for (const auto& c : text)
-        {
-            if (cyrillicLocaleCharactersMap.find(c) == cyrillicLocaleCharactersMap.end())
-            {
-                continue;
-            }
-
-            const auto& ch = cyrillicLocaleCharactersMap[c];
-            float xpos = x + ch.bearing.x * scale;
-            float ypos = y + (ch.size.y - ch.bearing.y) * scale;
-            float w = ch.size.x * scale;
-            float h = ch.size.y * scale;
-
-            auto toNDC = [&](float px, float py) {
-                return Math::Vec2F((px / screenWidth) * 2.0f - 1.0f, (py / screenHeight) * 2.0f - 1.0f);
-            };
-
-            const auto p1 = toNDC(xpos, ypos - h);
-            const auto p2 = toNDC(xpos, ypos);
-            const auto p3 = toNDC(xpos + w, ypos);
-            const auto p4 = toNDC(xpos + w, ypos - h);
-
-            vertices.push_back({ p1, Math::Vec2F(ch.uvMin.x, ch.uvMin.y) });
-            vertices.push_back({ p2, Math::Vec2F(ch.uvMin.x, ch.uvMax.y) });
-            vertices.push_back({ p3, Math::Vec2F(ch.uvMax.x, ch.uvMax.y) });
-
-            vertices.push_back({ p1, Math::Vec2F(ch.uvMin.x, ch.uvMin.y) });
-            vertices.push_back({ p3, Math::Vec2F(ch.uvMax.x, ch.uvMax.y) });
-            vertices.push_back({ p4, Math::Vec2F(ch.uvMax.x, ch.uvMin.y) });
-
-            x += (ch.advance >> 6) * scale;
-        }
-
-        return vertices;
-    }
-    //--------------------------------------------------------------------------
-
 
     TextRenderingFrameListener::TextRenderingFrameListener(FrameListenerManager& frameListenerManager, Window& mainWindow, Graphics::GraphicsBackend& graphicsBackend, 
                                                            Assets::AssetsManager& assetsManager, LocalizationManager& localizationManager)
@@ -235,7 +121,8 @@ namespace Kmplete
         , _assetsManager(assetsManager)
         , _localizationManager(localizationManager)
         , _imguiImpl(nullptr)
-        , _verticesCount(0)
+        , _glyphAtlas(nullptr)
+        , _textRenderer(nullptr)
         , _windowContentScaleHandler(_eventDispatcher, KMP_BIND(TextRenderingFrameListener::_OnWindowContentScaleEvent))
     {
         _FillDictionary();
@@ -252,7 +139,6 @@ namespace Kmplete
 
         InitializeCyrillicLocaleCodes();
         _TestCreateFontAtlas();
-        _InitializeBuffers(vulkanDevice);
         _InitializeUniformBuffers(vulkanDevice);
         _InitializePipeline(vulkanDevice, vulkanPhysicalDevice.GetVulkanContext());
         _InitializeImGui();
@@ -261,49 +147,20 @@ namespace Kmplete
 
     void TextRenderingFrameListener::_TestCreateFontAtlas()
     {
-        const auto& defaultFontAsset = _assetsManager.GetFontAssetManager().GetAsset(Assets::FontAssetManager::DefaultFontSID);
-        Graphics::Image atlasImage = GenerateTextureAtlas(defaultFontAsset.GetFont().GetFtFace());
-        const auto subTypeMask = Assets::TextureSubTypeMaskBits(Assets::TextureSubTypeMaskBits::RGB | Assets::TextureSubTypeMaskBits::NoMipmap);
-        const auto atlasTextureCreated = _assetsManager.GetTextureAssetManager().CreateAsset(TextureFontAtlas_SID, atlasImage, subTypeMask);
-        KMP_ASSERT(atlasTextureCreated);
-    }
-    //--------------------------------------------------------------------------
+        // the sampled image descriptor refers to the first page only
+        auto& defaultFontAsset = _assetsManager.GetFontAssetManager().GetAsset(Assets::FontAssetManager::DefaultFontSID);
+        _glyphAtlas.reset(new Graphics::GlyphAtlas(defaultFontAsset.GetFont(), Graphics::GlyphAtlas::Parameters{ .pageSize = 1024, .maxPages = 1 }));
 
-    void TextRenderingFrameListener::_InitializeBuffers(Graphics::VulkanLogicalDevice& vulkanDevice)
-    {
-        const auto domainSid = ToStringID(KMP_TR_DOMAIN_TEXT_RENDERING);
-        const auto& alphabet = _localizationManager.Translation(domainSid, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"_sid);
-        const auto wideAlphabet = Utils::NarrowToWide(Utils::Utf8ToNarrow(alphabet));
-
-        auto& vulkanBufferManager = vulkanDevice.GetBufferManager();
-        const auto& vulkanRenderer = vulkanDevice.GetRenderer();
-
-        const auto windowFramebufferSize = _mainWindow.GetFramebufferSize();
-        const auto vertices = GenerateTextVertices(wideAlphabet, 100.0f, 100.0f, 1.0f, float(windowFramebufferSize.x), float(windowFramebufferSize.y));
-        const auto vertexBufferSize = UInt32(vertices.size() * sizeof(Graphics::FontCharacterVertex));
-        _verticesCount = UInt32(vertices.size());
-
-        Graphics::VulkanBuffer stagingBuffer = vulkanBufferManager.CreateBuffer({ VK_BufferUsage_TransferSrc, VK_Memory_HostVisible, vertexBufferSize });
-        stagingBuffer.Map();
-        stagingBuffer.CopyToMappedMemory(0, (char*)vertices.data(), vertexBufferSize);
-        stagingBuffer.Unmap("flush"_true);
-
-        vulkanBufferManager.CreateVertexBuffer(VertexBuffer_SID, { VK_BufferUsage_TransferDst, VK_Memory_DeviceLocal, vertexBufferSize });
-        auto vertexBuffer = vulkanBufferManager.GetVertexBuffer(VertexBuffer_SID);
-        vertexBuffer->AddLayout(Graphics::BufferLayout{
-            Graphics::BufferElement{ Graphics::ShaderDataType::Float2, VertexPositionAttributeIndex },
-            Graphics::BufferElement{ Graphics::ShaderDataType::Float2, VertexUVAttributeIndex }
-        });
+        KMP_MB_UNUSED const auto glyphsCount = _glyphAtlas->AddGlyphs(Span<const UInt32>(cyrillicLocaleCodes), FontPixelSize);
+        const auto atlasUploaded = _glyphAtlas->Upload(_graphicsBackend);
+        KMP_ASSERT(atlasUploaded && _glyphAtlas->GetPagesCount() == 1);
 
-        vulkanRenderer.CopyBuffers(stagingBuffer, {
-            { *vertexBuffer, 0, 0, vertexBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        _textRenderer.reset(new Graphics::VulkanTextRenderer(dynamic_cast<Graphics::VulkanGraphicsBackend&>(_graphicsBackend), *_glyphAtlas));
     }
     //--------------------------------------------------------------------------
 
     void TextRenderingFrameListener::_InitializeUniformBuffers(Graphics::VulkanLogicalDevice& vulkanDevice)
     {
-        auto& textureAssetManager = _assetsManager.GetTextureAssetManager();
         auto& descriptorSetManager = vulkanDevice.GetDescriptorSetManager();
         const auto& samplersStorage = vulkanDevice.GetSamplersStorage();
 
@@ -317,7 +174,7 @@ namespace Kmplete
             descriptorSetManager.SetSamplerDescriptor(FontDS_SID, 0, "per frame"_true, i, samplersStorage.GetSampler(Graphics::SamplerDefaultLinearSid), SamplerBindingIndex);
             descriptorSetManager.SetSampledImageDescriptor(
                 FontDS_SID, 0, "per frame"_true, i,
-                dynamic_cast<Graphics::VulkanTexture&>(textureAssetManager.GetAsset(TextureFontAtlas_SID).GetTexture()).GetVkImageView(), TextureBindingIndex
+                dynamic_cast<Graphics::VulkanTexture&>(*_glyphAtlas->GetPageTexture(0)).GetVkImageView(), TextureBindingIndex
             );
         }
     }
@@ -339,7 +196,7 @@ namespace Kmplete
             { VertexShader_SID, vertexShaderPath, Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShader_SID, fragmentShaderPath, Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShader_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShader_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -348,10 +205,11 @@ namespace Kmplete
         pipelineParams.SetRenderingDepthStencilFormats(vulkanContext.defaultDepthFormat, vulkanContext.defaultDepthFormat);
         pipelineParams.AddColorAttachmentInfo(vulkanContext.surfaceFormatLinear.format, Graphics::VKPresets::ColorBlendAttachmentState_AlphaBlending);
         pipelineParams.AddShaderStages(shaderStages);
-        pipelineParams.AddVertexBufferAttributesBindings(*vulkanDevice.GetBufferManager().GetVertexBuffer(VertexBuffer_SID), VertexBufferBinding);
+        pipelineParams.AddVertexBufferAttributesBindings(_textRenderer->GetVertexBuffer(), VertexBufferBinding);
         pipelineParams.AddDynamicStates({ VK_Dynamic_Viewport, VK_Dynamic_Scissor, VK_Dynamic_RasterizationSamples });
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "text_rendering_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "text_rendering_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
     }
     //--------------------------------------------------------------------------
 
@@ -434,7 +292,16 @@ namespace Kmplete
         renderer.SetScissor(drawArea);
         renderer.SetRasterizationSamples(vulkanDevice.GetMultisampling());
         renderer.BindGraphicsPipeline(Pipeline_SID);
-        renderer.BindVertexBuffers(VertexBufferBinding, { vulkanDevice.GetBufferManager().GetVertexBuffer(VertexBuffer_SID)->GetVkBuffer() }, { 0 });
+
+        const auto domainSid = ToStringID(KMP_TR_DOMAIN_TEXT_RENDERING);
+        const auto& alphabet = _localizationManager.Translation(domainSid, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"_sid);
+        const auto& symbols = _localizationManager.Translation(domainSid, "0123456789!@#$%^&*()'~`,./<>+-_=;:?"_sid);
+
+        _textRenderer->BeginFrame(_mainWindow.GetFramebufferSize());
+        _textRenderer->AddText(alphabet, Math::Vec2F(100.0f, 100.0f), FontPixelSize);
+        _textRenderer->AddText(symbols, Math::Vec2F(100.0f, 200.0f), FontPixelSize);
+        _textRenderer->AddText(alphabet + "\n" + symbols, Math::Vec2F(100.0f, 300.0f), FontPixelSize, 0.5f);
+        _textRenderer->Prepare();
 
         auto colorImageBarrierParameters = Graphics::VKPresets::MemoryBarrierParameters_ColorAttachment_PrepareWriting;
         renderer.InsertImageMemoryBarrier(vulkanTextureAttachmentManager.GetTextureAttachment(MS_ColorAttachment), colorImageBarrierParameters);
@@ -452,10 +319,12 @@ namespace Kmplete
         );
 
         renderer.BeginRendering(drawArea, { colorAttachmentInfo }, depthStencilAttachmentInfo);
-        renderer.BindDescriptorSets(PipelineLayout_SID, 0, {
-            descriptorSetManager.GetDescriptorSet(FontDS_SID, 0, "per frame"_true)
+        // the atlas has a single page, so there is nothing to rebind between the batches
+        _textRenderer->Render(VertexBufferBinding, [&](UInt32) {
+            renderer.BindDescriptorSets(PipelineLayout_SID, 0, {
+                descriptorSetManager.GetDescriptorSet(FontDS_SID, 0, "per frame"_true)
+            });
         });
-        renderer.Draw(_verticesCount, 1, 0, 0);
         renderer.EndRendering();
     }
     //--------------------------------------------------------------------------
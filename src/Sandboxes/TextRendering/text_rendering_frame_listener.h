@@ -4,6 +4,8 @@
 #include "Kmplete/Application/frame_listener.h"
 #include "Kmplete/Window/window.h"
 #include "Kmplete/Graphics/graphics_backend.h"
+#include "Kmplete/Graphics/glyph_atlas.h"
+#include "Kmplete/Graphics/Vulkan/Core/vulkan_text_renderer.h"
 #include "Kmplete/ImGui/implementation.h"
 #include "Kmplete/Event/event_handler_guard.h"
 #include "Kmplete/Event/window_events.h"
@@ -39,7 +41,6 @@ namespace Kmplete
     private:
         void _Initialize();
         void _TestCreateFontAtlas();
-        void _InitializeBuffers(Graphics::VulkanLogicalDevice& vulkanDevice);
         void _InitializeUniformBuffers(Graphics::VulkanLogicalDevice& vulkanDevice);
         void _InitializePipeline(Graphics::VulkanLogicalDevice& vulkanDevice, const Graphics::VulkanContext& vulkanContext);
         void _InitializeImGui();
@@ -57,7 +58,8 @@ namespace Kmplete
         Assets::AssetsManager& _assetsManager;
         LocalizationManager& _localizationManager;
         UPtr<ImGuiUtils::ImGuiImplementation> _imguiImpl;
-        UInt32 _verticesCount;
+        UPtr<Graphics::GlyphAtlas> _glyphAtlas;
+        UPtr<Graphics::VulkanTextRenderer> _textRenderer;
 
         Events::EventHandlerGuard<Events::WindowContentScaleEvent> _windowContentScaleHandler;
     };
@@ -225,7 +225,7 @@ namespace Kmplete
         vulkanRenderer.CopyBuffers(stagingBuffer, {
             { *vertexBuffer, 0, 0, vertexBufferSize },
             { *indexBuffer, vertexBufferSize, 0, indexBufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -245,19 +245,24 @@ namespace Kmplete
         const auto samplerLayout = descriptorSetManager.AddDescriptorSetLayout(SamplerDSLayout_SID, { samplerLayoutBinding });
         descriptorSetManager.AllocateDescriptorSets(samplerLayout, SamplerDS_SID, 1, "per frame"_true);
 
+        const auto textureImageView = dynamic_cast<Graphics::VulkanTexture&>(textureAssetManager.GetAsset(TextureMetal_SID).GetTexture()).GetVkImageView();
+        const auto sampler = samplersStorage.GetSampler(Graphics::SamplerDefaultNearestSid);
+
+        auto descriptorWriter = descriptorSetManager.CreateDescriptorWriter();
+        descriptorWriter.Reserve(3 * Graphics::NumConcurrentFrames);
+
         vulkanBufferManager.CreateUniformBuffer(UniformBuffers_SID, { 0, VK_Memory_HostVisible | VK_Memory_HostCoherent, sizeof(MatrixShaderData) }, "per frame"_true);
         for (auto i = 0; i < Graphics::NumConcurrentFrames; i++)
         {
             auto uniformBuffer = vulkanBufferManager.GetBuffer(UniformBuffers_SID, i);
             uniformBuffer->Map();
 
-            descriptorSetManager.SetUniformBufferDescriptor(MatricesAndTextureDS_SID, 0, "per frame"_true, i, *uniformBuffer, uniformBuffer->GetSize(), 0, MatricesBindingIndex);
-            descriptorSetManager.SetSampledImageDescriptor(
-                MatricesAndTextureDS_SID, 0, "per frame"_true, i,
-                dynamic_cast<Graphics::VulkanTexture&>(textureAssetManager.GetAsset(TextureMetal_SID).GetTexture()).GetVkImageView(), TextureBindingIndex
-            );
-            descriptorSetManager.SetSamplerDescriptor(SamplerDS_SID, 0, "per frame"_true, i, samplersStorage.GetSampler(Graphics::SamplerDefaultNearestSid), SamplerBindingIndex);
+            const auto matricesAndTextureSet = descriptorSetManager.GetDescriptorSet(MatricesAndTextureDS_SID, 0, "per frame"_true, i);
+            descriptorWriter.WriteBuffer(matricesAndTextureSet, MatricesBindingIndex, VK_DescriptorType_UniformBuffer, uniformBuffer->GetVkBuffer(), uniformBuffer->GetSize());
+            descriptorWriter.WriteImage(matricesAndTextureSet, TextureBindingIndex, VK_DescriptorType_SampledImage, textureImageView, VK_NULL_HANDLE);
+            descriptorWriter.WriteImage(descriptorSetManager.GetDescriptorSet(SamplerDS_SID, 0, "per frame"_true, i), SamplerBindingIndex, VK_DescriptorType_Sampler, VK_NULL_HANDLE, sampler);
         }
+        descriptorWriter.Flush();
     }
     //--------------------------------------------------------------------------
 
@@ -277,7 +282,7 @@ namespace Kmplete
             { VertexShader_SID, vertexShaderPath, Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShader_SID, fragmentShaderPath, Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShader_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShader_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -338,7 +343,8 @@ namespace Kmplete
         shaderManager.AddShaderObject(VertexShader_SID, vertexShaderPath, VK_ShaderStage_Vertex, VK_ShaderStage_Fragment, "linked"_true, descriptorSetsLayoutsSids);
         shaderManager.AddShaderObject(FragmentShader_SID, fragmentShaderPath, VK_ShaderStage_Fragment, 0, "linked"_true, descriptorSetsLayoutsSids);
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "texture_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "texture_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
     }
     //--------------------------------------------------------------------------
 
@@ -588,6 +594,7 @@ namespace Kmplete
         renderer.BeginRendering(drawArea, { colorAttachmentInfo }, depthStencilAttachmentInfo);
         vulkanImGuiUtils->SetCommandBuffer(commandBuffer);
         vulkanImGuiUtils->Render();
+        renderer.InvalidateBoundPipeline();
         renderer.EndRendering();
 
         ImGui::EndFrame();
@@ -255,7 +255,7 @@ namespace Kmplete
             { *vertexBuffer, 0, 0, vertexBufferSize },
             { *indexBuffer, vertexBufferSize, 0, indexBufferSize },
             { *vertexBuffer, vertexBufferSize + indexBufferSize, vertexBufferSize, vertex2BufferSize }
-        }, vulkanDevice.GetGraphicsQueue());
+        });
     }
     //--------------------------------------------------------------------------
 
@@ -303,7 +303,7 @@ namespace Kmplete
             { VertexShader_SID, Filepath(vertexShaderPath), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Vertex },
             { FragmentShader_SID, Filepath(fragmentShaderPath), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }
         });
-        const auto shaderStages = shaderManager.GetShaderStageCreateInfos({
+        const auto shaderStages = shaderManager.GetShaderStages({
             { VertexShader_SID, VK_ShaderStage_Vertex, "main" },
             { FragmentShader_SID, VK_ShaderStage_Fragment, "main" }
         });
@@ -379,7 +379,8 @@ namespace Kmplete
         shaderManager.AddShaderObject({ FragmentShader_SID, Filepath(fragmentShaderPath), Graphics::ShaderSourceType::BinaryFile, ShaderCompiler::ShaderType::Fragment }, VK_ShaderStage_Fragment, 0, "linked"_true, descriptorSetsLayoutsSids);
 #endif
 
-        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams, ApplicationContext::GetApplicationDataPath() / "triangle_pipeline_cache.bin");
+        pipelineManager.SetDevicePipelineCachePath(ApplicationContext::GetApplicationDataPath() / "triangle_pipeline_cache.bin");
+        pipelineManager.AddGraphicsPipeline(Pipeline_SID, PipelineLayout_SID, pipelineParams);
     }
     //--------------------------------------------------------------------------
 
@@ -617,6 +618,7 @@ namespace Kmplete
         renderer.BeginRendering(drawArea, { colorAttachmentInfo }, depthStencilAttachmentInfo);
         vulkanImGuiUtils->SetCommandBuffer(commandBuffer);
         vulkanImGuiUtils->Render();
+        renderer.InvalidateBoundPipeline();
         renderer.EndRendering();
 
         ImGui::EndFrame();
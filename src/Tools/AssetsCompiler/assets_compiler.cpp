@@ -1,6 +1,8 @@
 #include "assets_compiler.h"
+#include "texture_encoder.h"
 
 #include "Kmplete/Json/json_document.h"
+#include "Kmplete/Utils/compression_utils.h"
 #include "Kmplete/Filesystem/filesystem.h"
 #include "Kmplete/Base/exception.h"
 #include "Kmplete/Log/log.h"
@@ -44,10 +46,8 @@ namespace Kmplete
                     return ReturnCode::OutputFileOpeningFailed;
                 }
 
-                FilepathVector assetsFilepaths;
-                BinaryBuffer assetsTypes;
-                assetsFilepaths.reserve(assetCount);
-                assetsTypes.reserve(assetCount);
+                Vector<AssetSource> assetsSources;
+                assetsSources.reserve(assetCount);
 
                 auto cleanup = [&]() {
                     outputFile.close();
@@ -57,7 +57,7 @@ namespace Kmplete
                     }
                 };
 
-                const auto writeHeadersResult = _WriteHeaders(sourceJson, assetCount, outputFile, assetsFilepaths, assetsTypes);
+                const auto writeHeadersResult = _WriteHeaders(sourceJson, assetCount, outputFile, assetsSources);
                 if (writeHeadersResult != ReturnCode::Ok)
                 {
                     KMP_LOG_ERROR("failed to write assets headers data");
@@ -72,7 +72,7 @@ namespace Kmplete
                     return ReturnCode::InputFileFormatError;
                 }
 
-                const auto writeDataResult = _WriteBinaries(assetCount, outputFile, assetsFilepaths, assetsTypes);
+                const auto writeDataResult = _WriteBinaries(assetCount, outputFile, assetsSources);
                 if (writeDataResult != ReturnCode::Ok)
                 {
                     KMP_LOG_ERROR("failed to write assets buffers data");
@@ -80,11 +80,19 @@ namespace Kmplete
                     return writeDataResult;
                 }
 
+                const auto writeIndexResult = _WriteIndex(outputFile, assetsSources);
+                if (writeIndexResult != ReturnCode::Ok)
+                {
+                    KMP_LOG_ERROR("failed to write assets index");
+                    cleanup();
+                    return writeIndexResult;
+                }
+
                 return ReturnCode::Ok;
             }
             //--------------------------------------------------------------------------
 
-            ReturnCode AssetsCompiler::_WriteHeaders(JsonDocument& sourceJson, AssetCount assetCount, std::ofstream& outputFile, FilepathVector& assetsFilepaths, BinaryBuffer& assetsTypes) const
+            ReturnCode AssetsCompiler::_WriteHeaders(JsonDocument& sourceJson, AssetCount assetCount, std::ofstream& outputFile, Vector<AssetSource>& assetsSources) const
             {
                 KMP_LOG_INFO("start writing header data...");
 
@@ -92,7 +100,7 @@ namespace Kmplete
 
                 for (UInt32 assetIndex = 0; assetIndex < assetCount; assetIndex++)
                 {
-                    const auto writeHeaderResult = _WriteHeader(assetIndex, sourceJson, outputFile, assetsFilepaths, assetsTypes);
+                    const auto writeHeaderResult = _WriteHeader(assetIndex, sourceJson, outputFile, assetsSources);
                     if (writeHeaderResult != ReturnCode::Ok)
                     {
                         return writeHeaderResult;
@@ -105,7 +113,7 @@ namespace Kmplete
             }
             //--------------------------------------------------------------------------
 
-            ReturnCode AssetsCompiler::_WriteHeader(UInt32 assetIndex, JsonDocument& sourceJson, std::ofstream& outputFile, FilepathVector& assetsFilepaths, BinaryBuffer& assetsTypes) const
+            ReturnCode AssetsCompiler::_WriteHeader(UInt32 assetIndex, JsonDocument& sourceJson, std::ofstream& outputFile, Vector<AssetSource>& assetsSources) const
             {
                 if (not sourceJson.StartGetObject(assetIndex))
                 {
@@ -136,6 +144,32 @@ namespace Kmplete
 
                 const auto assetSubTypeMask = static_cast<AssetSubTypeMask>(sourceJson.GetUInt(JsonConfigurationSubTypeMaskStr));
 
+                const auto isTexture = assetType == static_cast<UByte>(AssetType::Texture);
+                const auto isFontAtlas = assetType == static_cast<UByte>(AssetType::FontAtlas);
+                const auto defaultEncoding = (isTexture || isFontAtlas) ? AssetEncoding::Raw : AssetEncoding::Source;
+                const auto assetEncoding = static_cast<UByte>(sourceJson.GetUInt(JsonConfigurationEncodingStr, static_cast<UByte>(defaultEncoding)));
+                const auto isRaw = assetEncoding == static_cast<UByte>(AssetEncoding::Raw);
+                if (isFontAtlas ? not isRaw : (assetEncoding != static_cast<UByte>(AssetEncoding::Source) && not (isTexture && isRaw)))
+                {
+                    KMP_LOG_ERROR("unsupported asset's encoding '{}' at index {}", assetEncoding, assetIndex);
+                    return ReturnCode::InputFileFormatError;
+                }
+
+                const auto defaultTextureFormat = GetDefaultTexturePayloadFormat(assetSubTypeMask);
+                const auto textureFormat = static_cast<TexturePayloadFormat>(sourceJson.GetUInt(JsonConfigurationFormatStr, static_cast<UByte>(defaultTextureFormat)));
+                if (isTexture && GetTexturePayloadBlockSize(textureFormat) == 0)
+                {
+                    KMP_LOG_ERROR("unsupported texture's format '{}' at index {}", static_cast<UByte>(textureFormat), assetIndex);
+                    return ReturnCode::InputFileFormatError;
+                }
+
+                const auto assetCompression = static_cast<UByte>(sourceJson.GetUInt(JsonConfigurationCompressionStr, static_cast<UByte>(AssetCompression::None)));
+                if (assetCompression != static_cast<UByte>(AssetCompression::None) && assetCompression != static_cast<UByte>(AssetCompression::LZ))
+                {
+                    KMP_LOG_ERROR("unsupported asset's compression '{}' at index {}", assetCompression, assetIndex);
+                    return ReturnCode::InputFileFormatError;
+                }
+
                 const auto assetName = sourceJson.GetString(JsonConfigurationNameStr);
                 if (assetName.empty())
                 {
@@ -157,6 +191,23 @@ namespace Kmplete
                     return ReturnCode::InputFileDuplicationsError;
                 }
 
+                auto assetSource = AssetSource{
+                    .filepath = assetFilepath,
+                    .header = {},
+                    .textureFormat = textureFormat,
+                    .fontAtlasParameters = {},
+                    .fontAtlasCodepoints = {}
+                };
+
+                if (isFontAtlas)
+                {
+                    const auto readFontAtlasResult = _ReadFontAtlasSource(assetIndex, sourceJson, assetSource);
+                    if (readFontAtlasResult != ReturnCode::Ok)
+                    {
+                        return readFontAtlasResult;
+                    }
+                }
+
                 if (not sourceJson.EndGetObject())
                 {
                     KMP_LOG_ERROR("failed to end asset json object at index {}", assetIndex);
@@ -165,39 +216,84 @@ namespace Kmplete
 
                 AssetEntryHeader header{
                     .type = assetType,
+                    .encoding = assetEncoding,
+                    .compression = assetCompression,
                     .subTypeMask = assetSubTypeMask,
                     .sid = assetSid,
                     .bufferSize = 0,
+                    .uncompressedSize = 0,
                     .bufferOffset = 0
                 };
                 outputFile.write(reinterpret_cast<const char*>(&header), AssetEntryHeaderStructSize);
 
-                assetsFilepaths.push_back(assetFilepath);
-                assetsTypes.push_back(assetType);
+                assetSource.header = header;
+                assetsSources.push_back(std::move(assetSource));
+
+                return ReturnCode::Ok;
+            }
+            //--------------------------------------------------------------------------
+
+            ReturnCode AssetsCompiler::_ReadFontAtlasSource(UInt32 assetIndex, JsonDocument& sourceJson, AssetSource& assetSource) const
+            {
+                const auto defaultParameters = FontAtlasBaker::Parameters();
+                assetSource.fontAtlasParameters.pixelSize = sourceJson.GetUInt(JsonConfigurationPixelSizeStr, defaultParameters.pixelSize);
+                assetSource.fontAtlasParameters.pageSize = sourceJson.GetUInt(JsonConfigurationPageSizeStr, defaultParameters.pageSize);
+
+                const auto localesCount = sourceJson.StartGetArray(JsonConfigurationLocalesStr);
+                if (localesCount == 0)
+                {
+                    KMP_LOG_ERROR("failed to get font atlas locales at index {}", assetIndex);
+                    return ReturnCode::InputFileFormatError;
+                }
+
+                auto& codepoints = assetSource.fontAtlasCodepoints;
+                for (int localeIndex = 0; localeIndex < localesCount; localeIndex++)
+                {
+                    const auto locale = sourceJson.GetString(localeIndex);
+                    const auto ranges = GetLocaleCodepointRanges(locale);
+                    if (ranges.empty())
+                    {
+                        KMP_LOG_ERROR("unsupported font atlas locale '{}' at index {}", locale, assetIndex);
+                        return ReturnCode::InputFileFormatError;
+                    }
+
+                    for (const auto& range : ranges)
+                    {
+                        for (auto codepoint = range.first; codepoint <= range.last; codepoint++)
+                        {
+                            codepoints.push_back(codepoint);
+                        }
+                    }
+                }
+
+                if (not sourceJson.EndGetArray())
+                {
+                    KMP_LOG_ERROR("failed to end font atlas locales array at index {}", assetIndex);
+                    return ReturnCode::InputFileFormatError;
+                }
 
                 return ReturnCode::Ok;
             }
             //--------------------------------------------------------------------------
 
-            ReturnCode AssetsCompiler::_WriteBinaries(AssetCount assetCount, std::ofstream& outputFile, FilepathVector& assetsFilepaths, BinaryBuffer& assetsTypes) const
+            ReturnCode AssetsCompiler::_WriteBinaries(AssetCount assetCount, std::ofstream& outputFile, const Vector<AssetSource>& assetsSources) const
             {
                 KMP_LOG_INFO("start writing assets data...");
 
                 const auto headersOffset = sizeof(assetCount);
                 WriteBufferState writeState{
                     .assetDataBufferOffset = assetCount * AssetEntryHeaderStructSize + headersOffset,
-                    .assetBufferSizeCurrentOffset = headersOffset + AssetEntryHeaderOffsetOfBufferSize,
-                    .assetBufferOffsetCurrentOffset = headersOffset + AssetEntryHeaderOffsetOfBufferOffset
+                    .assetHeaderCurrentOffset = headersOffset
                 };
 
                 for (UInt32 assetIndex = 0; assetIndex < assetCount; assetIndex++)
                 {
-                    const auto& assetType = assetsTypes[assetIndex];
-                    const auto& assetPath = assetsFilepaths[assetIndex];
+                    const auto& assetSource = assetsSources[assetIndex];
+                    const auto& assetType = assetSource.header.type;
 
                     if (assetType == static_cast<UByte>(AssetType::Texture))
                     {
-                        const auto writeResult = _WriteBinary(outputFile, assetPath, writeState, "Texture");
+                        const auto writeResult = _WriteBinary(outputFile, _ReadBinary(assetSource, "Texture"), assetSource, writeState, "Texture");
                         if (writeResult != ReturnCode::Ok)
                         {
                             return writeResult;
@@ -205,7 +301,15 @@ namespace Kmplete
                     }
                     else if (assetType == static_cast<UByte>(AssetType::Font))
                     {
-                        const auto writeResult = _WriteBinary(outputFile, assetPath, writeState, "Font");
+                        const auto writeResult = _WriteBinary(outputFile, _ReadBinary(assetSource, "Font"), assetSource, writeState, "Font");
+                        if (writeResult != ReturnCode::Ok)
+                        {
+                            return writeResult;
+                        }
+                    }
+                    else if (assetType == static_cast<UByte>(AssetType::FontAtlas))
+                    {
+                        const auto writeResult = _WriteBinary(outputFile, _ReadBinary(assetSource, "FontAtlas"), assetSource, writeState, "FontAtlas");
                         if (writeResult != ReturnCode::Ok)
                         {
                             return writeResult;
@@ -217,33 +321,47 @@ namespace Kmplete
             }
             //--------------------------------------------------------------------------
 
-            ReturnCode AssetsCompiler::_WriteBinary(std::ofstream& outputFile, const Filepath& filepath, WriteBufferState& writeState, KMP_MB_UNUSED const String& assetTypeName) const
+            ReturnCode AssetsCompiler::_WriteBinary(std::ofstream& outputFile, const BinaryBuffer& binaryBuffer, const AssetSource& assetSource, WriteBufferState& writeState, KMP_MB_UNUSED const String& assetTypeName) const
             {
-                const auto binaryBuffer = Filesystem::ReadFileAsBinary(filepath);
+                const auto& filepath = assetSource.filepath;
+
                 if (binaryBuffer.empty())
                 {
-                    KMP_LOG_ERROR("failed to read '{}' data from '{}'", assetTypeName, filepath);
+                    KMP_LOG_ERROR("failed to process '{}' data from '{}'", assetTypeName, filepath);
                     return ReturnCode::InputFileProcessingError;
                 }
 
-                const auto binaryBufferSize = static_cast<UInt64>(binaryBuffer.size());
+                auto header = assetSource.header;
+                header.uncompressedSize = static_cast<UInt64>(binaryBuffer.size());
+
+                BinaryBuffer compressedBuffer;
+                if (header.compression == static_cast<UByte>(AssetCompression::LZ))
+                {
+                    compressedBuffer = Utils::CompressLZ(binaryBuffer);
+                    if (compressedBuffer.size() >= binaryBuffer.size())
+                    {
+                        KMP_LOG_INFO("'{}' data from '{}' is not compressible, it is stored uncompressed", assetTypeName, filepath);
+                        header.compression = static_cast<UByte>(AssetCompression::None);
+                        compressedBuffer.clear();
+                    }
+                }
+
+                const auto& storedBuffer = header.compression == static_cast<UByte>(AssetCompression::None) ? binaryBuffer : compressedBuffer;
+                header.bufferSize = static_cast<UInt64>(storedBuffer.size());
+                header.bufferOffset = writeState.assetDataBufferOffset;
 
                 try
                 {
-                    outputFile.write(reinterpret_cast<const char*>(binaryBuffer.data()), binaryBufferSize);
+                    outputFile.write(reinterpret_cast<const char*>(storedBuffer.data()), header.bufferSize);
                     const auto fileEndPosition = outputFile.tellp();
     
-                    outputFile.seekp(writeState.assetBufferSizeCurrentOffset);
-                    outputFile.write(reinterpret_cast<const char*>(&binaryBufferSize), sizeof(binaryBufferSize));
-    
-                    outputFile.seekp(writeState.assetBufferOffsetCurrentOffset);
-                    outputFile.write(reinterpret_cast<char*>(&writeState.assetDataBufferOffset), sizeof(writeState.assetDataBufferOffset));
+                    outputFile.seekp(writeState.assetHeaderCurrentOffset);
+                    outputFile.write(reinterpret_cast<const char*>(&header), AssetEntryHeaderStructSize);
     
-                    KMP_LOG_INFO("write '{}' {}\tbytes at offset {}\t from '{}'", assetTypeName, binaryBufferSize, writeState.assetDataBufferOffset, filepath);
+                    KMP_LOG_INFO("write '{}' {}\tbytes ({} uncompressed) at offset {}\t from '{}'", assetTypeName, UInt64(header.bufferSize), UInt64(header.uncompressedSize), writeState.assetDataBufferOffset, filepath);
     
-                    writeState.assetBufferSizeCurrentOffset += AssetEntryHeaderStructSize;
-                    writeState.assetBufferOffsetCurrentOffset += AssetEntryHeaderStructSize;
-                    writeState.assetDataBufferOffset += binaryBufferSize;
+                    writeState.assetHeaderCurrentOffset += AssetEntryHeaderStructSize;
+                    writeState.assetDataBufferOffset += header.bufferSize;
     
                     outputFile.seekp(fileEndPosition);
     
@@ -256,6 +374,69 @@ namespace Kmplete
                 }
             }
             //--------------------------------------------------------------------------
+
+            ReturnCode AssetsCompiler::_WriteIndex(std::ofstream& outputFile, const Vector<AssetSource>& assetsSources) const
+            {
+                KMP_LOG_INFO("start writing assets index...");
+
+                Vector<AssetIndexEntry> index;
+                index.reserve(assetsSources.size());
+                for (UInt64 headerIndex = 0; headerIndex < assetsSources.size(); headerIndex++)
+                {
+                    index.push_back(AssetIndexEntry{
+                        .sid = assetsSources[headerIndex].header.sid,
+                        .headerIndex = static_cast<AssetCount>(headerIndex)
+                    });
+                }
+
+                std::sort(index.begin(), index.end(), [](const AssetIndexEntry& entry1, const AssetIndexEntry& entry2) { return entry1.sid < entry2.sid; });
+
+                try
+                {
+                    const AssetIndexFooter footer{
+                        .indexOffset = static_cast<UInt64>(outputFile.tellp()),
+                        .signature = AssetIndexFooterSignature
+                    };
+
+                    outputFile.write(reinterpret_cast<const char*>(index.data()), index.size() * AssetIndexEntryStructSize);
+                    outputFile.write(reinterpret_cast<const char*>(&footer), AssetIndexFooterStructSize);
+
+                    KMP_LOG_INFO("write index of {} entries at offset {}", index.size(), UInt64(footer.indexOffset));
+
+                    return ReturnCode::Ok;
+                }
+                catch (KMP_MB_UNUSED const Exception& e)
+                {
+                    KMP_LOG_ERROR("failed to write assets index: {}", e.what());
+                    return ReturnCode::OutputFileWritingFailed;
+                }
+            }
+            //--------------------------------------------------------------------------
+
+            BinaryBuffer AssetsCompiler::_ReadBinary(const AssetSource& assetSource, KMP_MB_UNUSED const String& assetTypeName) const
+            {
+                auto binaryBuffer = Filesystem::ReadFileAsBinary(assetSource.filepath);
+                if (binaryBuffer.empty())
+                {
+                    KMP_LOG_ERROR("failed to read '{}' data from '{}'", assetTypeName, assetSource.filepath);
+                    return binaryBuffer;
+                }
+
+                if (assetSource.header.type == static_cast<UByte>(AssetType::Texture) && assetSource.header.encoding == static_cast<UByte>(AssetEncoding::Raw))
+                {
+                    const auto encoder = TextureEncoder(assetSource.textureFormat, TextureSubTypeMaskBits(assetSource.header.subTypeMask));
+                    return encoder.Encode(binaryBuffer);
+                }
+
+                if (assetSource.header.type == static_cast<UByte>(AssetType::FontAtlas))
+                {
+                    const auto baker = FontAtlasBaker(assetSource.fontAtlasParameters);
+                    return baker.Bake(binaryBuffer, assetSource.fontAtlasCodepoints);
+                }
+
+                return binaryBuffer;
+            }
+            //--------------------------------------------------------------------------
         }
     }
 }
\ No newline at end of file
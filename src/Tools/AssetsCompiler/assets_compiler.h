@@ -1,5 +1,7 @@
 #pragma once
 
+#include "font_atlas_baker.h"
+
 #include "Kmplete/Base/kmplete_api.h"
 #include "Kmplete/Base/types_aliases.h"
 #include "Kmplete/Base/string_id.h"
@@ -33,7 +35,17 @@ namespace Kmplete
             //! The processor class for gathering assets from files and compiling them.
             //! The compiler takes json file that contains information of assets to compile
             //! such as filepath, name (converted to StringID) and type of a single asset. Then it processses all the
-            //! metadata and put both assets headers and its binaries to the output file.
+            //! metadata and put both assets headers and its binaries to the output file, followed by the index of
+            //! all assets sorted by StringID (see AssetIndexEntry, AssetIndexFooter).
+            //! Textures are encoded as raw payloads by default ("Encoding": 1) - decoded, converted to "Format"
+            //! (0 - RGBA8, 1 - R8, 2 - RG8, 3 - BC1, 4 - BC3, 5 - BC4, 6 - BC5, 7 - BC7) and stored with all their
+            //! mip levels, "Encoding": 0 keeps the source file as is. If "Format" is omitted it is chosen by the
+            //! Compressed/NormalMap/SingleChannel bits of "SubTypeMask" (e.g. Compressed alone gives BC7).
+            //! Font atlases ("Type": 3) are always raw - glyphs of the codepoints of every locale listed in "Locales"
+            //! are baked from the font file as signed distance fields of "PixelSize" (48 by default) into pages
+            //! of "PageSize" (1024 by default) along with their metrics, so no glyph is rasterized at runtime.
+            //! Any asset binary can be additionally compressed with "Compression": 1 (LZ, fast to decompress),
+            //! binaries that do not get smaller are stored uncompressed.
             //! At the moment this class only capable of parsing single input file and writing
             //! single output file. Duplication of StringIDs leads to an error and stops further processing.
             //! example source json:
@@ -43,13 +55,25 @@ namespace Kmplete
             //!             "File": "texture1.png",
             //!             "Type": 0,
             //!             "SubTypeMask": 0,
+            //!             "Encoding": 1,
+            //!             "Format": 0,
             //!             "Name": "texture1"
             //!         },
             //!         {
             //!             "File": "font.ttf",
             //!             "Type": 1,
             //!             "SubTypeMask": 0,
+            //!             "Compression": 1,
             //!             "Name": "font1.ttf"
+            //!         },
+            //!         {
+            //!             "File": "font.ttf",
+            //!             "Type": 3,
+            //!             "Locales": [ "en_US.UTF-8", "ru_RU.UTF-8" ],
+            //!             "PixelSize": 48,
+            //!             "PageSize": 1024,
+            //!             "Compression": 1,
+            //!             "Name": "font1_atlas"
             //!         }
             //!     ]
             //! }
@@ -64,18 +88,30 @@ namespace Kmplete
                 KMP_NODISCARD ReturnCode Run() const;
 
             private:
+                //! Asset description gathered from the source json
+                struct AssetSource
+                {
+                    Filepath filepath;
+                    AssetEntryHeader header;
+                    TexturePayloadFormat textureFormat;
+                    FontAtlasBaker::Parameters fontAtlasParameters;
+                    Vector<UInt32> fontAtlasCodepoints;
+                };
+
                 struct WriteBufferState
                 {
                     UInt64 assetDataBufferOffset;
-                    UInt64 assetBufferSizeCurrentOffset;
-                    UInt64 assetBufferOffsetCurrentOffset;
+                    UInt64 assetHeaderCurrentOffset;
                 };
 
             private:
-                KMP_NODISCARD ReturnCode _WriteHeaders(JsonDocument& sourceJson, AssetCount assetCount, std::ofstream& outputFile, FilepathVector& assetsFilepaths, BinaryBuffer& assetsTypes) const;
-                KMP_NODISCARD ReturnCode _WriteHeader(UInt32 assetIndex, JsonDocument& sourceJson, std::ofstream& outputFile, FilepathVector& assetsFilepaths, BinaryBuffer& assetsTypes) const;
-                KMP_NODISCARD ReturnCode _WriteBinaries(AssetCount assetCount, std::ofstream& outputFile, FilepathVector& assetsFilepaths, BinaryBuffer& assetsTypes) const;
-                KMP_NODISCARD ReturnCode _WriteBinary(std::ofstream& outputFile, const Filepath& filepath, WriteBufferState& writeState, const String& assetTypeName) const;
+                KMP_NODISCARD ReturnCode _WriteHeaders(JsonDocument& sourceJson, AssetCount assetCount, std::ofstream& outputFile, Vector<AssetSource>& assetsSources) const;
+                KMP_NODISCARD ReturnCode _WriteHeader(UInt32 assetIndex, JsonDocument& sourceJson, std::ofstream& outputFile, Vector<AssetSource>& assetsSources) const;
+                KMP_NODISCARD ReturnCode _ReadFontAtlasSource(UInt32 assetIndex, JsonDocument& sourceJson, AssetSource& assetSource) const;
+                KMP_NODISCARD ReturnCode _WriteBinaries(AssetCount assetCount, std::ofstream& outputFile, const Vector<AssetSource>& assetsSources) const;
+                KMP_NODISCARD ReturnCode _WriteBinary(std::ofstream& outputFile, const BinaryBuffer& binaryBuffer, const AssetSource& assetSource, WriteBufferState& writeState, const String& assetTypeName) const;
+                KMP_NODISCARD ReturnCode _WriteIndex(std::ofstream& outputFile, const Vector<AssetSource>& assetsSources) const;
+                KMP_NODISCARD BinaryBuffer _ReadBinary(const AssetSource& assetSource, const String& assetTypeName) const;
 
             private:
                 const CompilerParameters _parameters;
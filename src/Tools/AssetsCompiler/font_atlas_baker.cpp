@@ -0,0 +1,231 @@
+#include "font_atlas_baker.h"
+
+#include "Kmplete/Log/log.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        namespace Compiler
+        {
+            FontAtlasBaker::FontAtlasBaker(const Parameters& parameters) noexcept
+                : _parameters(parameters)
+            {}
+            //--------------------------------------------------------------------------
+
+            BinaryBuffer FontAtlasBaker::Bake(const BinaryBuffer& fontBuffer, const Vector<UInt32>& codepoints) const
+            {
+                if (_parameters.pixelSize == 0 || _parameters.pixelSize > 255)
+                {
+                    KMP_LOG_ERROR("unsupported pixel size {}, it should be in range [1, 255]", _parameters.pixelSize);
+                    return BinaryBuffer();
+                }
+
+                if (not std::has_single_bit(_parameters.pageSize) || _parameters.pageSize > FontAtlasPayloadMaxPageSize)
+                {
+                    KMP_LOG_ERROR("unsupported page size {}, it should be a power of two up to {}", _parameters.pageSize, FontAtlasPayloadMaxPageSize);
+                    return BinaryBuffer();
+                }
+
+                FT_Library library = nullptr;
+                if (FT_Init_FreeType(&library) != FT_Err_Ok)
+                {
+                    KMP_LOG_ERROR("failed to initialize FreeType library instance");
+                    return BinaryBuffer();
+                }
+
+                FT_Face face = nullptr;
+                if (FT_New_Memory_Face(library, fontBuffer.data(), FT_Long(fontBuffer.size()), 0, &face) != FT_Err_Ok ||
+                    FT_Set_Pixel_Sizes(face, 0, _parameters.pixelSize) != FT_Err_Ok)
+                {
+                    KMP_LOG_ERROR("failed to load font face of size {}", _parameters.pixelSize);
+                    if (face)
+                    {
+                        FT_Done_Face(face);
+                    }
+                    FT_Done_FreeType(library);
+                    return BinaryBuffer();
+                }
+
+                auto sortedCodepoints = codepoints;
+                std::sort(sortedCodepoints.begin(), sortedCodepoints.end());
+                sortedCodepoints.erase(std::unique(sortedCodepoints.begin(), sortedCodepoints.end()), sortedCodepoints.end());
+
+                Vector<BakedGlyph> glyphs;
+                glyphs.reserve(sortedCodepoints.size());
+                for (const auto codepoint : sortedCodepoints)
+                {
+                    BakedGlyph glyph;
+                    if (_Rasterize(*face, codepoint, glyph))
+                    {
+                        glyphs.push_back(std::move(glyph));
+                    }
+                }
+
+                FT_Done_Face(face);
+                FT_Done_FreeType(library);
+
+                if (glyphs.empty())
+                {
+                    KMP_LOG_ERROR("none of {} codepoints were rasterized", sortedCodepoints.size());
+                    return BinaryBuffer();
+                }
+
+                const auto pagesCount = _Pack(glyphs);
+
+                KMP_LOG_INFO("baked {} glyphs of size {} into {} pages of {}x{}", glyphs.size(), _parameters.pixelSize, pagesCount, _parameters.pageSize, _parameters.pageSize);
+
+                return _Write(glyphs, pagesCount);
+            }
+            //--------------------------------------------------------------------------
+
+            bool FontAtlasBaker::_Rasterize(FT_FaceRec_& face, UInt32 codepoint, BakedGlyph& glyph) const
+            {
+                if (FT_Get_Char_Index(&face, codepoint) == 0)
+                {
+                    KMP_LOG_WARN("font has no glyph for codepoint {:#x}, it is skipped", codepoint);
+                    return false;
+                }
+
+                // loading without FT_LOAD_RENDER, so the glyph is rasterized only once and as a distance field
+                if (FT_Load_Char(&face, codepoint, FT_LOAD_DEFAULT) != FT_Err_Ok || FT_Render_Glyph(face.glyph, FT_RENDER_MODE_SDF) != FT_Err_Ok)
+                {
+                    KMP_LOG_WARN("failed to rasterize codepoint {:#x}, it is skipped", codepoint);
+                    return false;
+                }
+
+                const auto& glyphSlot = *face.glyph;
+                const auto& bitmap = glyphSlot.bitmap;
+                if (bitmap.width + _parameters.padding > _parameters.pageSize || bitmap.rows + _parameters.padding > _parameters.pageSize)
+                {
+                    KMP_LOG_WARN("codepoint {:#x} ({}x{}) does not fit a page, it is skipped", codepoint, bitmap.width, bitmap.rows);
+                    return false;
+                }
+
+                glyph.entry = FontAtlasGlyphEntry{
+                    .codepoint = codepoint,
+                    .page = 0,
+                    .x = 0,
+                    .y = 0,
+                    .width = UInt16(bitmap.width),
+                    .height = UInt16(bitmap.rows),
+                    .bearingX = Int16(glyphSlot.bitmap_left),
+                    .bearingY = Int16(glyphSlot.bitmap_top),
+                    .advance = UInt32(glyphSlot.advance.x)
+                };
+
+                glyph.pixels.resize(UInt64(bitmap.width) * bitmap.rows);
+                for (UInt32 row = 0; row < bitmap.rows; row++)
+                {
+                    std::memcpy(glyph.pixels.data() + UInt64(row) * bitmap.width, bitmap.buffer + Int64(row) * bitmap.pitch, bitmap.width);
+                }
+
+                return true;
+            }
+            //--------------------------------------------------------------------------
+
+            UInt32 FontAtlasBaker::_Pack(Vector<BakedGlyph>& glyphs) const
+            {
+                const auto pageSize = _parameters.pageSize;
+                const auto padding = _parameters.padding;
+
+                // glyphs keep their codepoint order, only the packing goes from the tallest to the shortest one,
+                // so every shelf is filled with glyphs of nearly the same height
+                Vector<UInt64> order(glyphs.size());
+                for (UInt64 i = 0; i < order.size(); i++)
+                {
+                    order[i] = i;
+                }
+                std::stable_sort(order.begin(), order.end(), [&glyphs](UInt64 left, UInt64 right) {
+                    return glyphs[left].entry.height > glyphs[right].entry.height;
+                });
+
+                UInt32 page = 0;
+                UInt32 shelfY = 0;
+                UInt32 shelfHeight = 0;
+                UInt32 shelfWidth = 0;
+                auto pageUsed = false;
+                for (const auto index : order)
+                {
+                    auto& entry = glyphs[index].entry;
+
+                    // whitespaces have metrics only and take no room in the pages
+                    if (entry.width == 0 || entry.height == 0)
+                    {
+                        continue;
+                    }
+
+                    const auto width = UInt32(entry.width) + padding;
+                    const auto height = UInt32(entry.height) + padding;
+                    if (shelfWidth + width > pageSize)
+                    {
+                        shelfY += shelfHeight;
+                        shelfHeight = 0;
+                        shelfWidth = 0;
+                    }
+
+                    if (shelfY + height > pageSize)
+                    {
+                        page++;
+                        shelfY = 0;
+                        shelfHeight = 0;
+                        shelfWidth = 0;
+                    }
+
+                    entry.page = page;
+                    entry.x = UInt16(shelfWidth);
+                    entry.y = UInt16(shelfY);
+
+                    shelfWidth += width;
+                    shelfHeight = std::max(shelfHeight, height);
+                    pageUsed = true;
+                }
+
+                // an atlas of whitespaces only still gets a page, so it is never empty
+                return pageUsed ? page + 1 : 1;
+            }
+            //--------------------------------------------------------------------------
+
+            BinaryBuffer FontAtlasBaker::_Write(const Vector<BakedGlyph>& glyphs, UInt32 pagesCount) const
+            {
+                const auto pageSize = _parameters.pageSize;
+                const auto glyphsCount = UInt32(glyphs.size());
+
+                BinaryBuffer payload(GetFontAtlasPayloadSize(pageSize, pagesCount, glyphsCount), 0);
+
+                const FontAtlasPayloadHeader header{
+                    .pageSize = pageSize,
+                    .pagesCount = pagesCount,
+                    .glyphsCount = glyphsCount,
+                    .pixelSize = UByte(_parameters.pixelSize),
+                    .reserved1 = 0,
+                    .reserved2 = 0
+                };
+                std::memcpy(payload.data(), &header, FontAtlasPayloadHeaderStructSize);
+
+                for (UInt32 i = 0; i < glyphsCount; i++)
+                {
+                    const auto& glyph = glyphs[i];
+                    const auto& entry = glyph.entry;
+                    std::memcpy(payload.data() + FontAtlasPayloadHeaderStructSize + UInt64(i) * FontAtlasGlyphEntryStructSize, &entry, FontAtlasGlyphEntryStructSize);
+
+                    auto pagePixels = payload.data() + GetFontAtlasPayloadPageOffset(pageSize, glyphsCount, entry.page);
+                    for (UInt32 row = 0; row < entry.height; row++)
+                    {
+                        std::memcpy(pagePixels + UInt64(entry.y + row) * pageSize + entry.x, glyph.pixels.data() + UInt64(row) * entry.width, entry.width);
+                    }
+                }
+
+                return payload;
+            }
+            //--------------------------------------------------------------------------
+        }
+    }
+}
\ No newline at end of file
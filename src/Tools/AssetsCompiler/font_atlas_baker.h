@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Assets/assets_interface.h"
+#include "Kmplete/Log/log_class_macro.h"
+
+
+struct FT_FaceRec_;
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        namespace Compiler
+        {
+            //! Baker of font atlas payloads (AssetType::FontAtlas) from source font files (ttf, otf, etc.).
+            //! Glyphs of the requested codepoints are rasterized by FreeType as single-channel signed distance fields,
+            //! so the text rendered with them stays sharp when scaled. Knowing all the glyphs up front, the baker
+            //! packs them tallest first into shelves of square pages, which wastes less room than the packing
+            //! of glyphs in the order of their requests at runtime. Codepoints missing in the font are skipped.
+            //! The resulting buffer is laid out as described by FontAtlasPayloadHeader
+            //! @see FontAtlasPayloadHeader, FontAtlasGlyphEntry, Graphics::GlyphAtlas
+            class FontAtlasBaker
+            {
+                KMP_LOG_CLASSNAME(FontAtlasBaker)
+
+            public:
+                struct Parameters
+                {
+                    UInt32 pixelSize = 48;
+                    UInt32 pageSize = 1024;
+                    UInt32 padding = 1;
+                };
+
+            public:
+                explicit FontAtlasBaker(const Parameters& parameters) noexcept;
+                ~FontAtlasBaker() = default;
+
+                KMP_NODISCARD BinaryBuffer Bake(const BinaryBuffer& fontBuffer, const Vector<UInt32>& codepoints) const;
+
+            private:
+                struct BakedGlyph
+                {
+                    FontAtlasGlyphEntry entry;
+                    BinaryBuffer pixels;
+                };
+
+            private:
+                KMP_NODISCARD bool _Rasterize(FT_FaceRec_& face, UInt32 codepoint, BakedGlyph& glyph) const;
+                //! @return number of pages the glyphs were packed into
+                KMP_NODISCARD UInt32 _Pack(Vector<BakedGlyph>& glyphs) const;
+                KMP_NODISCARD BinaryBuffer _Write(const Vector<BakedGlyph>& glyphs, UInt32 pagesCount) const;
+
+            private:
+                const Parameters _parameters;
+            };
+            //--------------------------------------------------------------------------
+        }
+    }
+}
\ No newline at end of file
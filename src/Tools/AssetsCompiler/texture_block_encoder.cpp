@@ -0,0 +1,510 @@
+#include "texture_block_encoder.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        namespace Compiler
+        {
+            template <UInt32 Channels>
+            using BlockColor = Array<float, Channels>;
+
+            static constexpr Array<UInt32, 16> BC7Weights4 = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+            static constexpr auto RefinementIterations = 2;
+
+
+            //! Sequential writer of the little-endian bit stream of a 128-bit block
+            class BlockBitWriter
+            {
+            public:
+                explicit BlockBitWriter(UByte* block) noexcept
+                    : _block(block)
+                    , _position(0)
+                {
+                    std::memset(_block, 0, 16);
+                }
+
+                void Write(UInt32 value, UInt32 bitsCount) noexcept
+                {
+                    for (UInt32 bit = 0; bit < bitsCount; bit++, _position++)
+                    {
+                        _block[_position / 8] |= UByte(((value >> bit) & 1) << (_position % 8));
+                    }
+                }
+
+            private:
+                UByte* _block;
+                UInt32 _position;
+            };
+            //--------------------------------------------------------------------------
+
+
+            //! Finds the line that fits the block colors best (mean color and the principal axis of the
+            //! covariance matrix found by power iteration) and returns the extreme projections on it
+            template <UInt32 Channels>
+            static void ComputeEndpoints(const UByte* pixels, UInt32 pixelStride, BlockColor<Channels>& endpoint0, BlockColor<Channels>& endpoint1) noexcept
+            {
+                BlockColor<Channels> mean{};
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    for (UInt32 channel = 0; channel < Channels; channel++)
+                    {
+                        mean[channel] += float(pixels[pixel * pixelStride + channel]) / float(TextureBlockPixelsCount);
+                    }
+                }
+
+                Array<BlockColor<Channels>, Channels> covariance{};
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    for (UInt32 row = 0; row < Channels; row++)
+                    {
+                        const auto deltaRow = float(pixels[pixel * pixelStride + row]) - mean[row];
+                        for (UInt32 column = 0; column < Channels; column++)
+                        {
+                            covariance[row][column] += deltaRow * (float(pixels[pixel * pixelStride + column]) - mean[column]);
+                        }
+                    }
+                }
+
+                BlockColor<Channels> axis{};
+                axis.fill(1.0f);
+                for (auto iteration = 0; iteration < 8; iteration++)
+                {
+                    BlockColor<Channels> product{};
+                    auto length = 0.0f;
+                    for (UInt32 row = 0; row < Channels; row++)
+                    {
+                        for (UInt32 column = 0; column < Channels; column++)
+                        {
+                            product[row] += covariance[row][column] * axis[column];
+                        }
+                        length += product[row] * product[row];
+                    }
+
+                    if (length < 1e-6f)
+                    {
+                        break;
+                    }
+
+                    length = std::sqrt(length);
+                    for (UInt32 channel = 0; channel < Channels; channel++)
+                    {
+                        axis[channel] = product[channel] / length;
+                    }
+                }
+
+                auto minProjection = std::numeric_limits<float>::max();
+                auto maxProjection = std::numeric_limits<float>::lowest();
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    auto projection = 0.0f;
+                    for (UInt32 channel = 0; channel < Channels; channel++)
+                    {
+                        projection += (float(pixels[pixel * pixelStride + channel]) - mean[channel]) * axis[channel];
+                    }
+
+                    minProjection = std::min(minProjection, projection);
+                    maxProjection = std::max(maxProjection, projection);
+                }
+
+                for (UInt32 channel = 0; channel < Channels; channel++)
+                {
+                    endpoint0[channel] = std::clamp(mean[channel] + axis[channel] * maxProjection, 0.0f, 255.0f);
+                    endpoint1[channel] = std::clamp(mean[channel] + axis[channel] * minProjection, 0.0f, 255.0f);
+                }
+            }
+            //--------------------------------------------------------------------------
+
+            //! Solves least squares for the endpoints given every pixel's interpolation weight towards endpoint1
+            template <UInt32 Channels>
+            static bool RefineEndpoints(const UByte* pixels, UInt32 pixelStride, const Array<float, TextureBlockPixelsCount>& weights,
+                                        BlockColor<Channels>& endpoint0, BlockColor<Channels>& endpoint1) noexcept
+            {
+                auto alpha2Sum = 0.0f;
+                auto beta2Sum = 0.0f;
+                auto alphaBetaSum = 0.0f;
+                BlockColor<Channels> alphaColorSum{};
+                BlockColor<Channels> betaColorSum{};
+
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    const auto beta = weights[pixel];
+                    const auto alpha = 1.0f - beta;
+
+                    alpha2Sum += alpha * alpha;
+                    beta2Sum += beta * beta;
+                    alphaBetaSum += alpha * beta;
+
+                    for (UInt32 channel = 0; channel < Channels; channel++)
+                    {
+                        alphaColorSum[channel] += alpha * float(pixels[pixel * pixelStride + channel]);
+                        betaColorSum[channel] += beta * float(pixels[pixel * pixelStride + channel]);
+                    }
+                }
+
+                const auto determinant = alpha2Sum * beta2Sum - alphaBetaSum * alphaBetaSum;
+                if (std::abs(determinant) < 1e-6f)
+                {
+                    return false;
+                }
+
+                for (UInt32 channel = 0; channel < Channels; channel++)
+                {
+                    endpoint0[channel] = std::clamp((alphaColorSum[channel] * beta2Sum - betaColorSum[channel] * alphaBetaSum) / determinant, 0.0f, 255.0f);
+                    endpoint1[channel] = std::clamp((betaColorSum[channel] * alpha2Sum - alphaColorSum[channel] * alphaBetaSum) / determinant, 0.0f, 255.0f);
+                }
+
+                return true;
+            }
+            //--------------------------------------------------------------------------
+
+            static UInt16 QuantizeTo565(const BlockColor<3>& color) noexcept
+            {
+                const auto r = UInt32(std::lround(color[0] * 31.0f / 255.0f));
+                const auto g = UInt32(std::lround(color[1] * 63.0f / 255.0f));
+                const auto b = UInt32(std::lround(color[2] * 31.0f / 255.0f));
+
+                return UInt16((r << 11) | (g << 5) | b);
+            }
+            //--------------------------------------------------------------------------
+
+            static void Expand565(UInt16 color, UInt32* rgb) noexcept
+            {
+                const auto r = UInt32(color >> 11) & 31;
+                const auto g = UInt32(color >> 5) & 63;
+                const auto b = UInt32(color) & 31;
+
+                rgb[0] = (r << 3) | (r >> 2);
+                rgb[1] = (g << 2) | (g >> 4);
+                rgb[2] = (b << 3) | (b >> 2);
+            }
+            //--------------------------------------------------------------------------
+
+            //! Picks the nearest 4-color palette entry for every pixel, the palette matches the runtime decoder
+            static UInt32 ChooseColorIndices(const UByte* rgbaPixels, UInt16 color0, UInt16 color1, UInt32& indices) noexcept
+            {
+                Array<Array<UInt32, 3>, 4> palette{};
+                Expand565(color0, palette[0].data());
+                Expand565(color1, palette[1].data());
+                for (UInt32 channel = 0; channel < 3; channel++)
+                {
+                    palette[2][channel] = (2 * palette[0][channel] + palette[1][channel] + 1) / 3;
+                    palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel] + 1) / 3;
+                }
+
+                auto totalError = 0U;
+                indices = 0;
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    auto bestError = std::numeric_limits<UInt32>::max();
+                    auto bestIndex = 0U;
+                    for (UInt32 index = 0; index < 4; index++)
+                    {
+                        auto error = 0U;
+                        for (UInt32 channel = 0; channel < 3; channel++)
+                        {
+                            const auto delta = Int32(rgbaPixels[pixel * 4 + channel]) - Int32(palette[index][channel]);
+                            error += UInt32(delta * delta);
+                        }
+
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            bestIndex = index;
+                        }
+                    }
+
+                    indices |= bestIndex << (pixel * 2);
+                    totalError += bestError;
+                }
+
+                return totalError;
+            }
+            //--------------------------------------------------------------------------
+
+            static void EncodeColorBlock(const UByte* rgbaPixels, UByte* block) noexcept
+            {
+                static constexpr Array<float, 4> IndexWeights = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+                BlockColor<3> endpoint0{};
+                BlockColor<3> endpoint1{};
+                ComputeEndpoints<3>(rgbaPixels, 4, endpoint0, endpoint1);
+
+                auto bestError = std::numeric_limits<UInt32>::max();
+                UInt16 bestColor0 = 0;
+                UInt16 bestColor1 = 0;
+                UInt32 bestIndices = 0;
+
+                for (auto iteration = 0; iteration <= RefinementIterations; iteration++)
+                {
+                    auto color0 = QuantizeTo565(endpoint0);
+                    auto color1 = QuantizeTo565(endpoint1);
+                    if (color0 < color1)
+                    {
+                        std::swap(color0, color1);
+                    }
+
+                    UInt32 indices = 0;
+                    const auto error = ChooseColorIndices(rgbaPixels, color0, color1, indices);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestColor0 = color0;
+                        bestColor1 = color1;
+                        bestIndices = indices;
+                    }
+
+                    if (error == 0 || color0 == color1)
+                    {
+                        break;
+                    }
+
+                    Array<float, TextureBlockPixelsCount> weights{};
+                    for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                    {
+                        weights[pixel] = IndexWeights[(indices >> (pixel * 2)) & 3];
+                    }
+
+                    if (not RefineEndpoints<3>(rgbaPixels, 4, weights, endpoint0, endpoint1))
+                    {
+                        break;
+                    }
+                }
+
+                std::memcpy(block, &bestColor0, sizeof(bestColor0));
+                std::memcpy(block + 2, &bestColor1, sizeof(bestColor1));
+                std::memcpy(block + 4, &bestIndices, sizeof(bestIndices));
+            }
+            //--------------------------------------------------------------------------
+
+            static void EncodeSingleChannelBlock(const UByte* pixels, UInt32 pixelStride, UByte* block) noexcept
+            {
+                auto minValue = UInt32(255);
+                auto maxValue = UInt32(0);
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    minValue = std::min(minValue, UInt32(pixels[pixel * pixelStride]));
+                    maxValue = std::max(maxValue, UInt32(pixels[pixel * pixelStride]));
+                }
+
+                // value0 > value1 selects the 8 values mode, equal values decode to value0 with zero indices
+                Array<UInt32, 8> palette{};
+                palette[0] = maxValue;
+                palette[1] = minValue;
+                for (UInt32 i = 1; i < 7; i++)
+                {
+                    palette[i + 1] = ((7 - i) * maxValue + i * minValue + 3) / 7;
+                }
+
+                UInt64 indices = 0;
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    const auto value = Int32(pixels[pixel * pixelStride]);
+                    auto bestError = std::numeric_limits<Int32>::max();
+                    auto bestIndex = 0ULL;
+                    for (UInt32 index = 0; index < 8; index++)
+                    {
+                        const auto error = std::abs(value - Int32(palette[index]));
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            bestIndex = index;
+                        }
+                    }
+
+                    indices |= bestIndex << (pixel * 3);
+                }
+
+                block[0] = UByte(maxValue);
+                block[1] = UByte(minValue);
+                std::memcpy(block + 2, &indices, 6);
+            }
+            //--------------------------------------------------------------------------
+
+            //! Quantizes an RGBA endpoint to 7 bits per channel plus the shared p-bit which gives the smaller error
+            static UInt32 QuantizeBC7Endpoint(const BlockColor<4>& endpoint, Array<UInt32, 4>& quantized) noexcept
+            {
+                auto bestError = std::numeric_limits<float>::max();
+                auto bestPBit = 0U;
+
+                for (UInt32 pBit = 0; pBit < 2; pBit++)
+                {
+                    Array<UInt32, 4> candidate{};
+                    auto error = 0.0f;
+                    for (UInt32 channel = 0; channel < 4; channel++)
+                    {
+                        candidate[channel] = UInt32(std::clamp(std::lround((endpoint[channel] - float(pBit)) / 2.0f), 0L, 127L));
+                        const auto delta = float((candidate[channel] << 1) | pBit) - endpoint[channel];
+                        error += delta * delta;
+                    }
+
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestPBit = pBit;
+                        quantized = candidate;
+                    }
+                }
+
+                return bestPBit;
+            }
+            //--------------------------------------------------------------------------
+
+            static UInt32 ChooseBC7Indices(const UByte* rgbaPixels, const Array<UInt32, 4>& endpoint0, const Array<UInt32, 4>& endpoint1, Array<UInt32, TextureBlockPixelsCount>& indices) noexcept
+            {
+                Array<Array<UInt32, 4>, 16> palette{};
+                for (UInt32 index = 0; index < 16; index++)
+                {
+                    const auto weight = BC7Weights4[index];
+                    for (UInt32 channel = 0; channel < 4; channel++)
+                    {
+                        palette[index][channel] = ((64 - weight) * endpoint0[channel] + weight * endpoint1[channel] + 32) >> 6;
+                    }
+                }
+
+                auto totalError = 0U;
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    auto bestError = std::numeric_limits<UInt32>::max();
+                    for (UInt32 index = 0; index < 16; index++)
+                    {
+                        auto error = 0U;
+                        for (UInt32 channel = 0; channel < 4; channel++)
+                        {
+                            const auto delta = Int32(rgbaPixels[pixel * 4 + channel]) - Int32(palette[index][channel]);
+                            error += UInt32(delta * delta);
+                        }
+
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            indices[pixel] = index;
+                        }
+                    }
+
+                    totalError += bestError;
+                }
+
+                return totalError;
+            }
+            //--------------------------------------------------------------------------
+
+            static void EncodeBC7Block(const UByte* rgbaPixels, UByte* block) noexcept
+            {
+                BlockColor<4> endpoint0{};
+                BlockColor<4> endpoint1{};
+                ComputeEndpoints<4>(rgbaPixels, 4, endpoint0, endpoint1);
+
+                auto bestError = std::numeric_limits<UInt32>::max();
+                Array<UInt32, 4> bestQuantized0{};
+                Array<UInt32, 4> bestQuantized1{};
+                auto bestPBit0 = 0U;
+                auto bestPBit1 = 0U;
+                Array<UInt32, TextureBlockPixelsCount> bestIndices{};
+
+                for (auto iteration = 0; iteration <= RefinementIterations; iteration++)
+                {
+                    Array<UInt32, 4> quantized0{};
+                    Array<UInt32, 4> quantized1{};
+                    const auto pBit0 = QuantizeBC7Endpoint(endpoint0, quantized0);
+                    const auto pBit1 = QuantizeBC7Endpoint(endpoint1, quantized1);
+
+                    Array<UInt32, 4> unquantized0{};
+                    Array<UInt32, 4> unquantized1{};
+                    for (UInt32 channel = 0; channel < 4; channel++)
+                    {
+                        unquantized0[channel] = (quantized0[channel] << 1) | pBit0;
+                        unquantized1[channel] = (quantized1[channel] << 1) | pBit1;
+                    }
+
+                    Array<UInt32, TextureBlockPixelsCount> indices{};
+                    const auto error = ChooseBC7Indices(rgbaPixels, unquantized0, unquantized1, indices);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestQuantized0 = quantized0;
+                        bestQuantized1 = quantized1;
+                        bestPBit0 = pBit0;
+                        bestPBit1 = pBit1;
+                        bestIndices = indices;
+                    }
+
+                    if (error == 0)
+                    {
+                        break;
+                    }
+
+                    Array<float, TextureBlockPixelsCount> weights{};
+                    for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                    {
+                        weights[pixel] = float(BC7Weights4[indices[pixel]]) / 64.0f;
+                    }
+
+                    if (not RefineEndpoints<4>(rgbaPixels, 4, weights, endpoint0, endpoint1))
+                    {
+                        break;
+                    }
+                }
+
+                // the first index is stored without its most significant bit, which is implied to be zero
+                if (bestIndices[0] >= 8)
+                {
+                    std::swap(bestQuantized0, bestQuantized1);
+                    std::swap(bestPBit0, bestPBit1);
+                    for (auto& index : bestIndices)
+                    {
+                        index = 15 - index;
+                    }
+                }
+
+                auto writer = BlockBitWriter(block);
+                writer.Write(1 << 6, 7);
+                for (UInt32 channel = 0; channel < 4; channel++)
+                {
+                    writer.Write(bestQuantized0[channel], 7);
+                    writer.Write(bestQuantized1[channel], 7);
+                }
+                writer.Write(bestPBit0, 1);
+                writer.Write(bestPBit1, 1);
+                for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                {
+                    writer.Write(bestIndices[pixel], pixel == 0 ? 3 : 4);
+                }
+            }
+            //--------------------------------------------------------------------------
+
+
+            void EncodeTextureBlock(TexturePayloadFormat format, const UByte* pixels, UByte* block) noexcept
+            {
+                switch (format)
+                {
+                case TexturePayloadFormat::BC1:
+                    EncodeColorBlock(pixels, block);
+                    break;
+                case TexturePayloadFormat::BC3:
+                    EncodeSingleChannelBlock(pixels + 3, 4, block);
+                    EncodeColorBlock(pixels, block + 8);
+                    break;
+                case TexturePayloadFormat::BC4:
+                    EncodeSingleChannelBlock(pixels, 1, block);
+                    break;
+                case TexturePayloadFormat::BC5:
+                    EncodeSingleChannelBlock(pixels, 2, block);
+                    EncodeSingleChannelBlock(pixels + 1, 2, block + 8);
+                    break;
+                case TexturePayloadFormat::BC7:
+                    EncodeBC7Block(pixels, block);
+                    break;
+                default:
+                    break;
+                }
+            }
+            //--------------------------------------------------------------------------
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Assets/assets_interface.h"
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        namespace Compiler
+        {
+            static constexpr UInt32 TextureBlockPixelsCount = 16;
+
+            //! Compresses 16 pixels of a 4x4 block (stored row by row, GetTexturePayloadChannelsCount(format) channels each)
+            //! into a single block of the given block-compressed format. Endpoints are found along the principal axis of
+            //! the block colors and refined by least squares, BC7 blocks are always encoded in mode 6 (single subset, RGBA)
+            void EncodeTextureBlock(TexturePayloadFormat format, const UByte* pixels, UByte* block) noexcept;
+        }
+    }
+}
\ No newline at end of file
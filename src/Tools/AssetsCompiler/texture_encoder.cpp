@@ -0,0 +1,324 @@
+#include "texture_encoder.h"
+#include "texture_block_encoder.h"
+
+#include "Kmplete/Log/log.h"
+
+#include <stb_image.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <thread>
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        namespace Compiler
+        {
+            static constexpr auto LanczosRadius = 3.0f;
+
+
+            static float Sinc(float x) noexcept
+            {
+                if (std::abs(x) < 1e-6f)
+                {
+                    return 1.0f;
+                }
+
+                const auto piX = std::numbers::pi_v<float> * x;
+                return std::sin(piX) / piX;
+            }
+            //--------------------------------------------------------------------------
+
+            static float Lanczos(float x) noexcept
+            {
+                if (std::abs(x) >= LanczosRadius)
+                {
+                    return 0.0f;
+                }
+
+                return Sinc(x) * Sinc(x / LanczosRadius);
+            }
+            //--------------------------------------------------------------------------
+
+            static float SRGBToLinear(UByte value) noexcept
+            {
+                static const auto table = []() {
+                    Array<float, 256> result{};
+                    for (UInt32 i = 0; i < 256; i++)
+                    {
+                        const auto normalized = float(i) / 255.0f;
+                        result[i] = normalized <= 0.04045f ? normalized / 12.92f : std::pow((normalized + 0.055f) / 1.055f, 2.4f);
+                    }
+                    return result;
+                }();
+
+                return table[value];
+            }
+            //--------------------------------------------------------------------------
+
+            static float LinearToSRGB(float value) noexcept
+            {
+                return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+            }
+            //--------------------------------------------------------------------------
+
+
+            TextureEncoder::TextureEncoder(TexturePayloadFormat format, TextureSubTypeMaskBits subTypeMask) noexcept
+                : _format(format)
+                , _channels(GetTexturePayloadChannelsCount(format))
+                , _srgb((subTypeMask & TextureSubTypeMaskBits::SRGB) && IsTexturePayloadFormatSRGBCompatible(format))
+                , _mipmaps(not (subTypeMask & TextureSubTypeMaskBits::NoMipmap))
+            {}
+            //--------------------------------------------------------------------------
+
+            BinaryBuffer TextureEncoder::Encode(const BinaryBuffer& sourceBuffer) const
+            {
+                if (_channels == 0)
+                {
+                    KMP_LOG_ERROR("unsupported texture payload format '{}'", static_cast<UByte>(_format));
+                    return BinaryBuffer();
+                }
+
+                auto image = FloatImage();
+                if (not _Decode(sourceBuffer, image))
+                {
+                    return BinaryBuffer();
+                }
+
+                const auto width = image.width;
+                const auto height = image.height;
+                const auto mipLevels = _mipmaps ? GetTexturePayloadMaxMipLevels(width, height) : 1U;
+
+                BinaryBuffer payload(GetTexturePayloadSize(_format, width, height, mipLevels), 0);
+
+                const TexturePayloadHeader header{
+                    .format = static_cast<UByte>(_format),
+                    .mipLevels = static_cast<UByte>(mipLevels),
+                    .reserved = 0,
+                    .width = width,
+                    .height = height
+                };
+                std::memcpy(payload.data(), &header, TexturePayloadHeaderStructSize);
+
+                for (UInt32 mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+                {
+                    if (mipLevel > 0)
+                    {
+                        image = _Downsample(image);
+                    }
+
+                    _Store(image, payload.data() + GetTexturePayloadMipLevelOffset(_format, width, height, mipLevel));
+                }
+
+                KMP_LOG_INFO("encoded [{}x{}] texture with {} mip levels, payload size {}", width, height, mipLevels, payload.size());
+
+                return payload;
+            }
+            //--------------------------------------------------------------------------
+
+            bool TextureEncoder::_Decode(const BinaryBuffer& sourceBuffer, FloatImage& image) const
+            {
+                auto width = 0;
+                auto height = 0;
+                auto channelsInFile = 0;
+                // two channels are requested as RGBA since stb_image treats them as grey + alpha, not as red + green
+                const auto loadedChannels = _channels == 2 ? 4 : _channels;
+                auto* pixels = stbi_load_from_memory(sourceBuffer.data(), static_cast<int>(sourceBuffer.size()), &width, &height, &channelsInFile, static_cast<int>(loadedChannels));
+                if (not pixels)
+                {
+                    KMP_LOG_ERROR("failed to decode source image - {}", stbi_failure_reason());
+                    return false;
+                }
+
+                image.width = static_cast<UInt32>(width);
+                image.height = static_cast<UInt32>(height);
+                image.pixels.resize(UInt64(image.width) * image.height * _channels);
+
+                for (UInt64 index = 0; index < image.pixels.size(); index++)
+                {
+                    const auto channel = UInt32(index % _channels);
+                    const auto value = pixels[(index / _channels) * loadedChannels + channel];
+                    image.pixels[index] = _IsLinearChannel(channel)
+                        ? float(value) / 255.0f
+                        : SRGBToLinear(value);
+                }
+
+                stbi_image_free(pixels);
+
+                return true;
+            }
+            //--------------------------------------------------------------------------
+
+            TextureEncoder::FloatImage TextureEncoder::_Downsample(const FloatImage& source) const
+            {
+                auto intermediate = FloatImage{
+                    .width = std::max(source.width / 2, 1U),
+                    .height = source.height,
+                    .pixels = {}
+                };
+                intermediate.pixels.resize(UInt64(intermediate.width) * intermediate.height * _channels);
+
+                const auto horizontalContributions = _ComputeContributions(source.width, intermediate.width);
+                for (UInt32 y = 0; y < intermediate.height; y++)
+                {
+                    const auto* sourceRow = source.pixels.data() + UInt64(y) * source.width * _channels;
+                    auto* destinationRow = intermediate.pixels.data() + UInt64(y) * intermediate.width * _channels;
+
+                    for (UInt32 x = 0; x < intermediate.width; x++)
+                    {
+                        const auto& contribution = horizontalContributions[x];
+                        for (UInt64 tap = 0; tap < contribution.weights.size(); tap++)
+                        {
+                            const auto* sourcePixel = sourceRow + (contribution.first + tap) * _channels;
+                            for (UInt32 channel = 0; channel < _channels; channel++)
+                            {
+                                destinationRow[x * _channels + channel] += sourcePixel[channel] * contribution.weights[tap];
+                            }
+                        }
+                    }
+                }
+
+                auto destination = FloatImage{
+                    .width = intermediate.width,
+                    .height = std::max(source.height / 2, 1U),
+                    .pixels = {}
+                };
+                destination.pixels.resize(UInt64(destination.width) * destination.height * _channels);
+
+                const auto rowSize = UInt64(destination.width) * _channels;
+                const auto verticalContributions = _ComputeContributions(intermediate.height, destination.height);
+                for (UInt32 y = 0; y < destination.height; y++)
+                {
+                    const auto& contribution = verticalContributions[y];
+                    auto* destinationRow = destination.pixels.data() + y * rowSize;
+
+                    for (UInt64 tap = 0; tap < contribution.weights.size(); tap++)
+                    {
+                        const auto* sourceRow = intermediate.pixels.data() + (contribution.first + tap) * rowSize;
+                        for (UInt64 index = 0; index < rowSize; index++)
+                        {
+                            destinationRow[index] += sourceRow[index] * contribution.weights[tap];
+                        }
+                    }
+                }
+
+                return destination;
+            }
+            //--------------------------------------------------------------------------
+
+            Vector<TextureEncoder::FilterContribution> TextureEncoder::_ComputeContributions(UInt32 sourceSize, UInt32 destinationSize) const
+            {
+                Vector<FilterContribution> contributions(destinationSize);
+
+                const auto scale = float(sourceSize) / float(destinationSize);
+                const auto support = LanczosRadius * scale;
+
+                for (UInt32 destinationIndex = 0; destinationIndex < destinationSize; destinationIndex++)
+                {
+                    const auto center = (float(destinationIndex) + 0.5f) * scale;
+                    const auto first = static_cast<UInt32>(std::max(std::floor(center - support), 0.0f));
+                    const auto last = std::min(static_cast<UInt32>(std::ceil(center + support)), sourceSize - 1);
+
+                    auto& contribution = contributions[destinationIndex];
+                    contribution.first = first;
+                    contribution.weights.reserve(last - first + 1);
+
+                    auto weightsSum = 0.0f;
+                    for (UInt32 sourceIndex = first; sourceIndex <= last; sourceIndex++)
+                    {
+                        const auto weight = Lanczos((float(sourceIndex) + 0.5f - center) / scale);
+                        contribution.weights.push_back(weight);
+                        weightsSum += weight;
+                    }
+
+                    for (auto& weight : contribution.weights)
+                    {
+                        weight /= weightsSum;
+                    }
+                }
+
+                return contributions;
+            }
+            //--------------------------------------------------------------------------
+
+            void TextureEncoder::_Store(const FloatImage& image, UByte* destination) const
+            {
+                if (not IsTexturePayloadFormatCompressed(_format))
+                {
+                    _Quantize(image, destination);
+                    return;
+                }
+
+                BinaryBuffer pixels(image.pixels.size());
+                _Quantize(image, pixels.data());
+                _Compress(pixels, image.width, image.height, destination);
+            }
+            //--------------------------------------------------------------------------
+
+            void TextureEncoder::_Quantize(const FloatImage& image, UByte* destination) const
+            {
+                for (UInt64 index = 0; index < image.pixels.size(); index++)
+                {
+                    auto value = std::clamp(image.pixels[index], 0.0f, 1.0f);
+                    if (not _IsLinearChannel(UInt32(index % _channels)))
+                    {
+                        value = LinearToSRGB(value);
+                    }
+
+                    destination[index] = static_cast<UByte>(value * 255.0f + 0.5f);
+                }
+            }
+            //--------------------------------------------------------------------------
+
+            void TextureEncoder::_Compress(const BinaryBuffer& pixels, UInt32 width, UInt32 height, UByte* destination) const
+            {
+                const auto blocksX = (width + 3) / 4;
+                const auto blocksY = (height + 3) / 4;
+                const auto blockSize = GetTexturePayloadBlockSize(_format);
+
+                std::atomic<UInt32> nextBlockRow = 0;
+                const auto compressBlockRows = [&]() {
+                    Array<UByte, TextureBlockPixelsCount * 4> blockPixels{};
+
+                    for (auto blockY = nextBlockRow.fetch_add(1); blockY < blocksY; blockY = nextBlockRow.fetch_add(1))
+                    {
+                        for (UInt32 blockX = 0; blockX < blocksX; blockX++)
+                        {
+                            // pixels outside of the image (partial blocks at the edges) replicate the last row/column
+                            for (UInt32 pixel = 0; pixel < TextureBlockPixelsCount; pixel++)
+                            {
+                                const auto x = std::min(blockX * 4 + pixel % 4, width - 1);
+                                const auto y = std::min(blockY * 4 + pixel / 4, height - 1);
+                                std::memcpy(blockPixels.data() + pixel * _channels, pixels.data() + (UInt64(y) * width + x) * _channels, _channels);
+                            }
+
+                            EncodeTextureBlock(_format, blockPixels.data(), destination + (UInt64(blockY) * blocksX + blockX) * blockSize);
+                        }
+                    }
+                };
+
+                const auto threadsCount = std::min(std::max(std::thread::hardware_concurrency(), 1U), blocksY);
+                Vector<std::jthread> workers;
+                workers.reserve(threadsCount - 1);
+                for (UInt32 i = 1; i < threadsCount; i++)
+                {
+                    workers.emplace_back(compressBlockRows);
+                }
+
+                compressBlockRows();
+            }
+            //--------------------------------------------------------------------------
+
+            bool TextureEncoder::_IsLinearChannel(UInt32 channel) const noexcept
+            {
+                // alpha is never gamma-encoded
+                return not _srgb || channel == 3;
+            }
+            //--------------------------------------------------------------------------
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Assets/assets_interface.h"
+#include "Kmplete/Log/log_class_macro.h"
+
+
+namespace Kmplete
+{
+    namespace Assets
+    {
+        namespace Compiler
+        {
+            //! Converter of source image files (png, jpg, etc.) to raw GPU-ready texture payloads (AssetEncoding::Raw).
+            //! The source image is decoded once, converted to linear floating point values (color channels of sRGB
+            //! textures are linearized, alpha is always linear) and the whole mip chain is produced with a separable
+            //! Lanczos-3 filter, every level is built from the previous one without intermediate quantization.
+            //! Levels of block-compressed formats are quantized first and then compressed block by block, rows
+            //! of blocks are spread between hardware threads. The resulting buffer is laid out as described by TexturePayloadHeader.
+            //! @see TexturePayloadHeader, TexturePayloadFormat
+            class TextureEncoder
+            {
+                KMP_LOG_CLASSNAME(TextureEncoder)
+
+            public:
+                TextureEncoder(TexturePayloadFormat format, TextureSubTypeMaskBits subTypeMask) noexcept;
+                ~TextureEncoder() = default;
+
+                KMP_NODISCARD BinaryBuffer Encode(const BinaryBuffer& sourceBuffer) const;
+
+            private:
+                //! Image with linear floating point channels stored interleaved row by row
+                struct FloatImage
+                {
+                    UInt32 width = 0;
+                    UInt32 height = 0;
+                    Vector<float> pixels;
+                };
+
+                //! Source pixels contributing to a single destination pixel during resampling
+                struct FilterContribution
+                {
+                    UInt32 first = 0;
+                    Vector<float> weights;
+                };
+
+            private:
+                KMP_NODISCARD bool _Decode(const BinaryBuffer& sourceBuffer, FloatImage& image) const;
+                KMP_NODISCARD FloatImage _Downsample(const FloatImage& source) const;
+                KMP_NODISCARD Vector<FilterContribution> _ComputeContributions(UInt32 sourceSize, UInt32 destinationSize) const;
+                void _Store(const FloatImage& image, UByte* destination) const;
+                void _Quantize(const FloatImage& image, UByte* destination) const;
+                void _Compress(const BinaryBuffer& pixels, UInt32 width, UInt32 height, UByte* destination) const;
+
+                KMP_NODISCARD bool _IsLinearChannel(UInt32 channel) const noexcept;
+
+            private:
+                const TexturePayloadFormat _format;
+                const UInt32 _channels;
+                const bool _srgb;
+                const bool _mipmaps;
+            };
+            //--------------------------------------------------------------------------
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "profile_converter.h"
+
+#include "Kmplete/Log/log.h"
+#include "Kmplete/Filesystem/filesystem.h"
+#include "Kmplete/Utils/string_utils.h"
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+
+
+namespace bpo = boost::program_options;
+
+namespace Kmplete
+{
+    namespace ProfileConverter
+    {
+        void PrintUsage(const bpo::options_description& description);
+        bpo::options_description CreateOptionsDescription();
+        int ParseParameters(const bpo::options_description& optionsDescription, bpo::variables_map& vm, ConverterParameters& converterParameters);
+    }
+}
+//--------------------------------------------------------------------------
+
+
+//! The entry point of ProfileConverter program:
+//! Stage 1 - fetch and process command line arguments
+//! Stage 2 - parse those arguments to converter-specific parameters
+//! Stage 3 - create and run the converter with parameters from stage 2
+int main(int argc, char** argv)
+{
+    using namespace Kmplete::ProfileConverter;
+
+    // Stage 1
+
+    auto optionsDescription = CreateOptionsDescription();
+
+    if (argc < 2)
+    {
+        std::cerr << "ProfileConverter: invalid argument count\n";
+        PrintUsage(optionsDescription);
+        return ReturnCode::InvalidArgumentCount;
+    }
+
+    auto cmdParser = bpo::command_line_parser(argc, argv);
+    bpo::variables_map vm;
+    bpo::store(cmdParser.options(optionsDescription).run(), vm);
+    bpo::notify(vm);
+
+
+    // Stage 2
+
+    ConverterParameters converterParameters;
+    const auto parseParametersResult = ParseParameters(optionsDescription, vm, converterParameters);
+    if (parseParametersResult != ReturnCode::Ok)
+    {
+        std::cerr << "ProfileConverter: failed to parse parameters\n";
+
+#if not defined (KMP_CONFIG_TYPE_PRODUCTION)
+        if (vm.count(ConverterArgumentLogging))
+        {
+            Kmplete::Log::Finalize();
+        }
+#endif
+
+        return parseParametersResult;
+    }
+
+
+    // Stage 3
+
+    ProfileConverterProcessor processor(std::move(converterParameters));
+    const auto processorResultCode = processor.Run();
+
+#if not defined (KMP_CONFIG_TYPE_PRODUCTION)
+    if (vm.count(ConverterArgumentLogging))
+    {
+        Kmplete::Log::Finalize();
+    }
+#endif
+
+    return processorResultCode;
+}
+//--------------------------------------------------------------------------
+
+
+namespace Kmplete
+{
+    namespace ProfileConverter
+    {
+        bpo::options_description CreateOptionsDescription()
+        {
+            const auto loggingArgument =            Utils::Concatenate(ConverterArgumentLogging, ",", ConverterArgumentLoggingShort);
+            const auto inputFilesArgument =         Utils::Concatenate(ConverterArgumentInputFiles, ",", ConverterArgumentInputFilesShort);
+            const auto outputDirectoryArgument =    Utils::Concatenate(ConverterArgumentOutputDirectory, ",", ConverterArgumentOutputDirectoryShort);
+
+            bpo::options_description optionsDescription("ProfileConverter options");
+            optionsDescription.add_options()
+                (loggingArgument.c_str(),                                                       "Is logging enabled")
+                (inputFilesArgument.c_str(),        bpo::value<StringVector>()->multitoken(),   "Binary profiling trace file(s)")
+                (outputDirectoryArgument.c_str(),   bpo::value<String>(),                       "Output directory for converted JSON files");
+
+            return optionsDescription;
+        }
+        //--------------------------------------------------------------------------
+
+        void PrintUsage(const bpo::options_description& description)
+        {
+            std::cout << description << std::endl;
+        }
+        //--------------------------------------------------------------------------
+
+        int ParseParameters(const bpo::options_description& optionsDescription, bpo::variables_map& vm, ConverterParameters& converterParameters)
+        {
+#if not defined (KMP_CONFIG_TYPE_PRODUCTION)
+            // logging parsing
+            const bool loggingEnabled = vm.count(ConverterArgumentLogging);
+            converterParameters.logging = loggingEnabled;
+            if (loggingEnabled)
+            {
+                Log::LogSettings logSettings;
+                logSettings.outputFile = false;
+                logSettings.outputConsole = true;
+                logSettings.outputStringBuffer = false;
+                logSettings.level = 0;
+                logSettings.levelFlush = 0;
+                Log::SetSettings(logSettings);
+                Log::Initialize("Kmplete Profile converter", Filesystem::GetCurrentFilepath() / "Logs");
+            }
+#endif
+
+            // Input files parsing
+            const auto inputFileStrings = vm.count(ConverterArgumentInputFiles) ? vm[ConverterArgumentInputFiles].as<StringVector>() : StringVector();
+            if (inputFileStrings.empty())
+            {
+                KMP_LOG_ERROR_FN("ProfileConverter: input files are not set");
+                PrintUsage(optionsDescription);
+                return ReturnCode::InputFilesAreNotSet;
+            }
+            FilepathVector inputFilePaths;
+            inputFilePaths.reserve(inputFileStrings.size());
+            for (const auto& inputFileStr : inputFileStrings)
+            {
+                const auto inputFilePath = Filepath(inputFileStr);
+                if (not Filesystem::FilepathExists(inputFilePath) || not Filesystem::IsFile(inputFilePath))
+                {
+                    KMP_LOG_ERROR_FN("ProfileConverter: one of input files '{}' does not exist or is not of a file type", inputFilePath);
+                    PrintUsage(optionsDescription);
+                    return ReturnCode::InputFilesAreNotValid;
+                }
+
+                inputFilePaths.push_back(inputFilePath);
+            }
+
+            converterParameters.inputFiles = inputFilePaths;
+
+            // Output directory parsing
+            if (vm.count(ConverterArgumentOutputDirectory))
+            {
+                const auto outputDirectory = Filepath(vm[ConverterArgumentOutputDirectory].as<String>());
+                if (not Filesystem::CreateDirectories(outputDirectory))
+                {
+                    KMP_LOG_ERROR_FN("ProfileConverter: output directory '{}' is not valid", outputDirectory);
+                    PrintUsage(optionsDescription);
+                    return ReturnCode::OutputDirectoryIsNotValid;
+                }
+
+                converterParameters.outputDirectory = outputDirectory;
+            }
+
+            return ReturnCode::Ok;
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "profile_converter.h"
+
+#include "Kmplete/Profile/profiler_trace.h"
+#include "Kmplete/Log/log.h"
+
+
+namespace Kmplete
+{
+    namespace ProfileConverter
+    {
+        ProfileConverterProcessor::ProfileConverterProcessor(ConverterParameters&& parameters) noexcept
+            : _parameters(parameters)
+        {}
+        //--------------------------------------------------------------------------
+
+        ReturnCode ProfileConverterProcessor::Run() const
+        {
+            for (const auto& inputFile : _parameters.inputFiles)
+            {
+                const auto outputFile = _GetOutputFilepath(inputFile);
+                KMP_LOG_INFO("converting '{}' to '{}'...", inputFile, outputFile);
+
+                if (not ProfilerTrace::ConvertToChromeJson(inputFile, outputFile))
+                {
+                    KMP_LOG_ERROR("failed to convert profiling trace '{}'", inputFile);
+                    return ReturnCode::ConversionFailed;
+                }
+            }
+
+            return ReturnCode::Ok;
+        }
+        //--------------------------------------------------------------------------
+
+        Filepath ProfileConverterProcessor::_GetOutputFilepath(const Filepath& inputFile) const
+        {
+            auto outputFile = _parameters.outputDirectory.empty()
+                ? inputFile
+                : _parameters.outputDirectory / inputFile.filename();
+
+            return outputFile.replace_extension(".json");
+        }
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file
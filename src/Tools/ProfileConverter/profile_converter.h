@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Kmplete/Base/kmplete_api.h"
+#include "Kmplete/Base/types_aliases.h"
+#include "Kmplete/Log/log_class_macro.h"
+
+
+namespace Kmplete
+{
+    namespace ProfileConverter
+    {
+        static constexpr auto ConverterArgumentLogging = "logging";
+        static constexpr auto ConverterArgumentLoggingShort = "L";
+        static constexpr auto ConverterArgumentInputFiles = "input_files";
+        static constexpr auto ConverterArgumentInputFilesShort = "I";
+        static constexpr auto ConverterArgumentOutputDirectory = "output_directory";
+        static constexpr auto ConverterArgumentOutputDirectoryShort = "O";
+
+
+        enum ReturnCode
+        {
+            Ok = 0,
+            InvalidArgumentCount = -1,
+            InputFilesAreNotSet = -2,
+            InputFilesAreNotValid = -21,
+            OutputDirectoryIsNotValid = -3,
+
+            ConversionFailed = -70
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! Representation of the ProfileConverter program arguments:
+        //! --input_files
+        //! --output_directory (optional, the directory of each input file by default)
+        //! --logging
+        struct ConverterParameters
+        {
+            FilepathVector inputFiles;
+            Filepath outputDirectory;
+            bool logging = false;
+        };
+        //--------------------------------------------------------------------------
+
+
+        //! The processor converting binary profiling traces (.kmptrace files written by Profiler)
+        //! to Chrome trace event JSON files loadable by chrome://tracing and Perfetto UI.
+        //! Every output file has the input file's name with the .json extension, e.g.:
+        //! --input_files "App-Profile-Startup.kmptrace" "App-Profile-Runtime.kmptrace" --output_directory "path/to/outputDir"
+        //! @see ProfilerTrace
+        class ProfileConverterProcessor
+        {
+            KMP_LOG_CLASSNAME(ProfileConverterProcessor)
+
+        public:
+            explicit ProfileConverterProcessor(ConverterParameters&& parameters) noexcept;
+            ~ProfileConverterProcessor() = default;
+
+            KMP_NODISCARD ReturnCode Run() const;
+
+        private:
+            KMP_NODISCARD Filepath _GetOutputFilepath(const Filepath& inputFile) const;
+
+        private:
+            const ConverterParameters _parameters;
+        };
+        //--------------------------------------------------------------------------
+    }
+}
\ No newline at end of file